@@ -183,4 +183,12 @@ to all Cortex-M ports, and do not rely on any particular library functions. */
 See http://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html. */
 #define configMAX_SYSCALL_INTERRUPT_PRIORITY (configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY << (8 - configPRIO_BITS))
 
+/* Task switches in the application event trace ring, see app_trace.h */
+#if defined(gAppTrace_d) && (gAppTrace_d == 1)
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+extern void App_TraceTaskSwitchedIn(uint32_t taskNumber);
+#endif
+#define traceTASK_SWITCHED_IN() App_TraceTaskSwitchedIn((uint32_t)pxCurrentTCB->uxTaskNumber)
+#endif
+
 #endif /* FREERTOS_CONFIG_H */
@@ -19,6 +19,8 @@
 #include "fsl_component_mem_manager.h"
 #include "fsl_component_timer_manager.h"
 #include "fsl_component_messaging.h"
+#include "FunctionLib.h"
+#include "app_trace.h"
 #include "fsl_adapter_flash.h"
 #include "fsl_component_panic.h"
 #include "fsl_component_led.h"
@@ -80,6 +82,7 @@ typedef struct appMsgCallback_tag
 {
     appCallbackHandler_t   handler;
     appCallbackParam_t     param;
+    uint32_t               timestamp;
 } appMsgCallback_t;
 
 /************************************************************************************
@@ -145,6 +148,16 @@ STATIC void App_L2caLeControlCallback
 (
     l2capControlMessage_t* pMessage
 );
+static void App_QueueStatsEnqueue
+(
+    appQueueId_t queueId
+);
+static void App_QueueStatsDequeue
+(
+    appQueueId_t queueId,
+    uint32_t     timestamp
+);
+static appQueueId_t App_SelectCallbackQueue(void);
 
 /*! *********************************************************************************
 *************************************************************************************
@@ -168,7 +181,13 @@ static l2caLeCbDataCallback_t               pfL2caLeCbDataCallback    = NULL;
 static l2caLeCbControlCallback_t            pfL2caLeCbControlCallback = NULL;
 
 /* Application input queues */
-static messaging_t mAppCbInputQueue;
+static messaging_t maAppCbInputQueue[gAppCallbackQueues_c];
+static appQueueStats_t maAppQueueStats[gAppQueueCount_c];
+/* Higher class callbacks dispatched while each callback queue waited */
+static uint16_t maAppCbPassedOver[gAppCallbackQueues_c];
+
+static appCallbackHandler_t    mpfClassifiedHandler = NULL;
+static appCallbackClassifier_t mpfCallbackClassifier = NULL;
 
 /************************************************************************************
 *************************************************************************************
@@ -241,8 +260,11 @@ void BluetoothLEHost_Init
         /* Prepare application input queue.*/
         MSG_QueueInit(&mHostAppInputQueue);
 
-        /* Prepare callback input queue.*/
-        MSG_QueueInit(&mAppCbInputQueue);
+        /* Prepare callback input queues.*/
+        for (uint32_t i = 0U; i < gAppCallbackQueues_c; i++)
+        {
+            MSG_QueueInit(&maAppCbInputQueue[i]);
+        }
 
         /* BLE common part */
         mpfInitDoneCallback = pCallback;
@@ -283,6 +305,12 @@ void BluetoothLEHost_Init
 ********************************************************************************** */
 void BluetoothLEHost_HandleMessages(void)
 {
+    uint32_t hostCount = 0U;
+    uint32_t callbackCount = 0U;
+    uint32_t servedMask = 0U;
+    appQueueId_t queueId;
+    bool_t progress;
+
 #ifdef SDK_OS_FREE_RTOS
     osa_event_flags_t event = 0U;
     (void)OSA_EventWait((osa_event_handle_t)mAppEvent,
@@ -292,46 +320,66 @@ void BluetoothLEHost_HandleMessages(void)
                         &event);
 #endif /* SDK_OS_FREE_RTOS */
 
-    /* Check for existing messages in queue */
-    if (MSG_QueueGetHead(&mHostAppInputQueue) != NULL)
+    /* Host queue and callback classes in turn, at most gAppMsgBatchBudget_c
+       messages of each per wake: a burst costs one wake per budget, not one per
+       message. The callback class is chosen by App_SelectCallbackQueue */
+    do
     {
-        /* Pointer for storing the messages from host. */
-        appMsgFromHost_t *pMsgIn = MSG_QueueRemoveHead(&mHostAppInputQueue);
+        progress = FALSE;
 
-        if (pMsgIn != NULL)
+        if ((hostCount < gAppMsgBatchBudget_c) && (MSG_QueueGetHead(&mHostAppInputQueue) != NULL))
         {
-            /* Process it */
-            App_HandleHostMessageInput(pMsgIn);
+            /* Pointer for storing the messages from host. */
+            appMsgFromHost_t *pMsgIn = MSG_QueueRemoveHead(&mHostAppInputQueue);
 
-            /* Messages must always be freed. */
-            (void)MSG_Free(pMsgIn);
-        }
-    }
+            if (pMsgIn != NULL)
+            {
+                App_QueueStatsDequeue(gAppQueueHost_c, pMsgIn->timestamp);
 
-    /* Check for existing messages in queue */
-    if (MSG_QueueGetHead(&mAppCbInputQueue) != NULL)
-    {
-        /* Pointer for storing the callback messages. */
-        appMsgCallback_t *pMsgIn = MSG_QueueGetHead(&mAppCbInputQueue);
+                /* Process it */
+                App_HandleHostMessageInput(pMsgIn);
+
+                /* Messages must always be freed. */
+                (void)MSG_Free(pMsgIn);
+                hostCount++;
+                servedMask |= 1UL << (uint32_t)gAppQueueHost_c;
+                progress = TRUE;
+            }
+        }
 
-        if (pMsgIn != NULL)
+        queueId = (callbackCount < gAppMsgBatchBudget_c) ? App_SelectCallbackQueue() : gAppQueueCount_c;
+        if (queueId != gAppQueueCount_c)
         {
-            /* Execute callback handler */
-            if (pMsgIn->handler != NULL)
+            /* Pointer for storing the callback messages. */
+            appMsgCallback_t *pMsgIn = MSG_QueueGetHead(&maAppCbInputQueue[(uint32_t)queueId - (uint32_t)gAppQueueControl_c]);
+
+            if (pMsgIn != NULL)
             {
-                pMsgIn->handler(pMsgIn->param);
+                App_QueueStatsDequeue(queueId, pMsgIn->timestamp);
+
+                /* Execute callback handler */
+                if (pMsgIn->handler != NULL)
+                {
+                    pMsgIn->handler(pMsgIn->param);
+                }
+
+                /* Messages must always be freed. */
+                (void)MSG_Free(pMsgIn);
+                callbackCount++;
+                servedMask |= 1UL << (uint32_t)queueId;
+                progress = TRUE;
             }
-
-            /* Messages must always be freed. */
-            (void)MSG_Free(pMsgIn);
         }
+    } while (progress == TRUE);
+
+    for (uint32_t i = 0U; i < (uint32_t)gAppQueueCount_c; i++)
+    {
+        maAppQueueStats[i].wakes += ((servedMask & (1UL << i)) != 0U) ? 1U : 0U;
     }
 
 #ifdef SDK_OS_FREE_RTOS
     /* Signal the main_thread again if there are more messages pending */
-    event = (MSG_QueueGetHead(&mHostAppInputQueue) != NULL) ? gAppEvtMsgFromHostStack_c : 0U;
-    event |= (MSG_QueueGetHead(&mAppCbInputQueue) != NULL) ? gAppEvtAppCallback_c : 0U;
-    if (event != 0U)
+    if (BluetoothLEHost_IsMessagePending() == TRUE)
     {
         (void)OSA_EventSet((osa_event_handle_t)mAppEvent, gAppEvtAppCallback_c);
     }
@@ -351,10 +399,17 @@ bool BluetoothLEHost_IsMessagePending(void)
 {
     bool ret = FALSE;
      /* Check for existing messages in queue */
-    if ( (MSG_QueueGetHead(&mHostAppInputQueue) != NULL) || (MSG_QueueGetHead(&mAppCbInputQueue) != NULL) )
+    if (MSG_QueueGetHead(&mHostAppInputQueue) != NULL)
     {
         ret = TRUE;
     }
+    for (uint32_t i = 0U; i < gAppCallbackQueues_c; i++)
+    {
+        if (MSG_QueueGetHead(&maAppCbInputQueue[i]) != NULL)
+        {
+            ret = TRUE;
+        }
+    }
     return ret;
 }
 
@@ -505,9 +560,47 @@ bleResult_t App_PostCallbackMessage
     appCallbackHandler_t   handler,
     appCallbackParam_t     param
 )
+{
+    appQueueId_t queueId = gAppQueueConnection_c;
+
+    if ((mpfCallbackClassifier != NULL) && (handler == mpfClassifiedHandler))
+    {
+        queueId = mpfCallbackClassifier(param);
+    }
+
+    return App_PostCallbackMessageToQueue(handler, param, queueId);
+}
+
+/*! *********************************************************************************
+\fn            bleResult_t App_PostCallbackMessageToQueue(
+*                  appCallbackHandler_t   handler,
+*                  appCallbackParam_t     param,
+*                  appQueueId_t           queueId
+               )
+*\brief        Store a callback message in a callback priority class and signal
+*              application.
+*
+*\param  [in]  handler              Callback handler.
+*\param  [in]  param                Callback parameter.
+*\param  [in]  queueId              Callback queue, connection management if invalid.
+*
+*\retval       gBleOutOfMemory_c    Message allocation fail.
+*\retval       gBleSuccess_c        Successful addition to the Cb App queue.
+********************************************************************************** */
+bleResult_t App_PostCallbackMessageToQueue
+(
+    appCallbackHandler_t   handler,
+    appCallbackParam_t     param,
+    appQueueId_t           queueId
+)
 {
     appMsgCallback_t *pMsgIn = NULL;
 
+    if ((queueId < gAppQueueControl_c) || (queueId >= gAppQueueCount_c))
+    {
+        queueId = gAppQueueConnection_c;
+    }
+
     /* Allocate a buffer with enough space to store the packet */
     pMsgIn = MSG_Alloc(sizeof (appMsgCallback_t));
 
@@ -518,9 +611,11 @@ bleResult_t App_PostCallbackMessage
 
     pMsgIn->handler = handler;
     pMsgIn->param = param;
+    pMsgIn->timestamp = (uint32_t)TM_GetTimestamp();
 
     /* Put message in the Cb App queue */
-    (void)MSG_QueueAddTail(&mAppCbInputQueue, pMsgIn);
+    App_QueueStatsEnqueue(queueId);
+    (void)MSG_QueueAddTail(&maAppCbInputQueue[(uint32_t)queueId - (uint32_t)gAppQueueControl_c], pMsgIn);
 
     /* Signal application */
     (void)OSA_EventSet(mAppEvent, gAppEvtAppCallback_c);
@@ -528,6 +623,31 @@ bleResult_t App_PostCallbackMessage
     return gBleSuccess_c;
 }
 
+/*! *********************************************************************************
+\fn            void App_RegisterCallbackClassifier(
+*                  appCallbackHandler_t     handler,
+*                  appCallbackClassifier_t  pfClassifier
+               )
+*\brief        Sets the function that picks the callback queue of the messages
+*              posted for a handler.
+*
+*\param  [in]  handler              Callback handler.
+*\param  [in]  pfClassifier         Classifier, NULL to remove it.
+*
+*\retval       void.
+********************************************************************************** */
+void App_RegisterCallbackClassifier
+(
+    appCallbackHandler_t     handler,
+    appCallbackClassifier_t  pfClassifier
+)
+{
+    OSA_InterruptDisable();
+    mpfClassifiedHandler = handler;
+    mpfCallbackClassifier = pfClassifier;
+    OSA_InterruptEnable();
+}
+
 /*! *********************************************************************************
 \fn            bleResult_t App_GenericCallback(gapGenericEvent_t* pGenericEvent)
 *\brief        Callback used by the Host Stack to propagate GAP generic
@@ -557,17 +677,200 @@ void App_GenericCallback
                 sizeof(gapGenericEvent_t));
 
     /* Put message in the Host Stack to App queue */
+    App_PostHostMessage(pMsgIn);
+}
+
+/*! *********************************************************************************
+\fn            void App_PostHostMessage(appMsgFromHost_t* pMsgIn)
+*\brief        Time stamps a message from the host stack, puts it in the Host Stack
+*              to App queue and signals the application.
+*
+*\param  [in]  pMsgIn               Message allocated with MSG_Alloc.
+*
+*\retval       void.
+********************************************************************************** */
+void App_PostHostMessage
+(
+    appMsgFromHost_t* pMsgIn
+)
+{
+    pMsgIn->timestamp = (uint32_t)TM_GetTimestamp();
+    App_QueueStatsEnqueue(gAppQueueHost_c);
     (void)MSG_QueueAddTail(&mHostAppInputQueue, pMsgIn);
 
     /* Signal application */
     (void)OSA_EventSet(mAppEvent, gAppEvtMsgFromHostStack_c);
 }
 
+/*! *********************************************************************************
+\fn            const appQueueStats_t* App_GetQueueStats(appQueueId_t queueId)
+*\brief        Depth, wake and queueing latency counters of an input queue.
+*
+*\param  [in]  queueId              Queue.
+*
+*\return       Counters, NULL for an unknown queue.
+********************************************************************************** */
+const appQueueStats_t* App_GetQueueStats
+(
+    appQueueId_t queueId
+)
+{
+    return (queueId < gAppQueueCount_c) ? &maAppQueueStats[queueId] : NULL;
+}
+
+/*! *********************************************************************************
+\fn            void App_ResetQueueStats(void)
+*\brief        Clears the input queue counters, the current depths are kept.
+*
+*\retval       void.
+********************************************************************************** */
+void App_ResetQueueStats(void)
+{
+    uint16_t depth;
+    uint32_t i;
+
+    for (i = 0U; i < (uint32_t)gAppQueueCount_c; i++)
+    {
+        OSA_InterruptDisable();
+        depth = maAppQueueStats[i].depth;
+        FLib_MemSet(&maAppQueueStats[i], 0x00, sizeof(appQueueStats_t));
+        maAppQueueStats[i].depth = depth;
+        maAppQueueStats[i].maxDepth = depth;
+        OSA_InterruptEnable();
+    }
+}
+
 /************************************************************************************
 *************************************************************************************
 * Private functions
 *************************************************************************************
 ************************************************************************************/
+/*! *********************************************************************************
+\fn            static appQueueId_t App_SelectCallbackQueue(void)
+*\brief        Strict priority between the callback classes: the highest pending
+*              class is served, unless a lower class has been passed over
+*              gAppMsgStarvationLimit_c times, which is then served once.
+*
+*\retval       Queue to serve, gAppQueueCount_c if all are empty.
+********************************************************************************** */
+static appQueueId_t App_SelectCallbackQueue(void)
+{
+    uint32_t selected = gAppCallbackQueues_c;
+    uint32_t starved = gAppCallbackQueues_c;
+    bool_t aPending[gAppCallbackQueues_c];
+    uint32_t i;
+
+    for (i = 0U; i < gAppCallbackQueues_c; i++)
+    {
+        aPending[i] = (MSG_QueueGetHead(&maAppCbInputQueue[i]) != NULL) ? TRUE : FALSE;
+        if (aPending[i] == TRUE)
+        {
+            if (selected == gAppCallbackQueues_c)
+            {
+                selected = i;
+            }
+            else if ((starved == gAppCallbackQueues_c) && (maAppCbPassedOver[i] >= gAppMsgStarvationLimit_c))
+            {
+                starved = i;
+            }
+            else
+            {
+                ; /* For MISRA compliance */
+            }
+        }
+    }
+
+    if (starved != gAppCallbackQueues_c)
+    {
+        selected = starved;
+        maAppQueueStats[starved + (uint32_t)gAppQueueControl_c].promoted++;
+    }
+
+    for (i = 0U; i < gAppCallbackQueues_c; i++)
+    {
+        if ((aPending[i] == TRUE) && (i != selected))
+        {
+            if (maAppCbPassedOver[i] < 0xFFFFU)
+            {
+                maAppCbPassedOver[i]++;
+            }
+        }
+        else
+        {
+            maAppCbPassedOver[i] = 0U;
+        }
+    }
+
+    return (selected != gAppCallbackQueues_c) ? (appQueueId_t)(selected + (uint32_t)gAppQueueControl_c) : gAppQueueCount_c;
+}
+
+/*! *********************************************************************************
+\fn            static void App_QueueStatsEnqueue(appQueueId_t queueId)
+*\brief        Counts a message put in an input queue. Called from the producer task.
+*
+*\param  [in]  queueId              Queue.
+*
+*\retval       void.
+********************************************************************************** */
+static void App_QueueStatsEnqueue
+(
+    appQueueId_t queueId
+)
+{
+    appQueueStats_t *pStats = &maAppQueueStats[queueId];
+
+    OSA_InterruptDisable();
+    pStats->depth++;
+    if (pStats->depth > pStats->maxDepth)
+    {
+        pStats->maxDepth = pStats->depth;
+    }
+    OSA_InterruptEnable();
+
+    App_TraceEvent(gAppTraceQueuePost_c, (uint32_t)queueId, pStats->depth);
+}
+
+/*! *********************************************************************************
+\fn            static void App_QueueStatsDequeue(appQueueId_t queueId, uint32_t timestamp)
+*\brief        Counts a message taken from an input queue and the time it waited.
+*
+*\param  [in]  queueId              Queue.
+*\param  [in]  timestamp            Enqueue time, us.
+*
+*\retval       void.
+********************************************************************************** */
+static void App_QueueStatsDequeue
+(
+    appQueueId_t queueId,
+    uint32_t     timestamp
+)
+{
+    appQueueStats_t *pStats = &maAppQueueStats[queueId];
+    uint32_t latencyUs = (uint32_t)TM_GetTimestamp() - timestamp;
+    uint32_t bucket = 0U;
+
+    while ((bucket < (gAppQueueLatencyBuckets_c - 1U)) && (latencyUs >= (gAppQueueLatencyFirstUs_c << bucket)))
+    {
+        bucket++;
+    }
+
+    OSA_InterruptDisable();
+    if (pStats->depth > 0U)
+    {
+        pStats->depth--;
+    }
+    OSA_InterruptEnable();
+
+    App_TraceEvent(gAppTraceQueueGet_c, (uint32_t)queueId, latencyUs);
+
+    pStats->messages++;
+    pStats->aLatency[bucket]++;
+    if (latencyUs > pStats->maxLatencyUs)
+    {
+        pStats->maxLatencyUs = latencyUs;
+    }
+}
+
 
 /*! *********************************************************************************
 *\private
@@ -837,10 +1140,7 @@ STATIC void App_GattServerCallback
     }
 
     /* Put message in the Host Stack to App queue */
-    (void)MSG_QueueAddTail(&mHostAppInputQueue, pMsgIn);
-
-    /* Signal application */
-    (void)OSA_EventSet(mAppEvent, gAppEvtMsgFromHostStack_c);
+    App_PostHostMessage(pMsgIn);
 }
 
 /*! *********************************************************************************
@@ -884,10 +1184,7 @@ STATIC void App_GattClientProcedureCallback
     pMsgIn->msgData.gattClientProcMsg.procedureResult = procedureResult;
 
     /* Put message in the Host Stack to App queue */
-    (void)MSG_QueueAddTail(&mHostAppInputQueue, pMsgIn);
-
-    /* Signal application */
-    (void)OSA_EventSet(mAppEvent, gAppEvtMsgFromHostStack_c);
+    App_PostHostMessage(pMsgIn);
 }
 
 /*! *********************************************************************************
@@ -947,10 +1244,7 @@ STATIC void App_GattClientNotificationCallback
                 valueLength);
 
     /* Put message in the Host Stack to App queue */
-    (void)MSG_QueueAddTail(&mHostAppInputQueue, pMsgIn);
-
-    /* Signal application */
-    (void)OSA_EventSet(mAppEvent, gAppEvtMsgFromHostStack_c);
+    App_PostHostMessage(pMsgIn);
 }
 
 /*! *********************************************************************************
@@ -1010,10 +1304,7 @@ STATIC void App_GattClientIndicationCallback
                 valueLength);
 
     /* Put message in the Host Stack to App queue */
-    (void)MSG_QueueAddTail(&mHostAppInputQueue, pMsgIn);
-
-    /* Signal application */
-    (void)OSA_EventSet(mAppEvent, gAppEvtMsgFromHostStack_c);
+    App_PostHostMessage(pMsgIn);
 }
 
 /*! *********************************************************************************
@@ -1063,10 +1354,7 @@ STATIC void App_L2caLeDataCallback
                 packetLength);
 
     /* Put message in the Host Stack to App queue */
-    (void)MSG_QueueAddTail(&mHostAppInputQueue, pMsgIn);
-
-    /* Signal application */
-    (void)OSA_EventSet(mAppEvent, gAppEvtMsgFromHostStack_c);
+    App_PostHostMessage(pMsgIn);
 }
 
 /*! *********************************************************************************
@@ -1158,10 +1446,7 @@ STATIC void App_L2caLeControlCallback
                 messageLength);
 
     /* Put message in the Host Stack to App queue */
-    (void)MSG_QueueAddTail(&mHostAppInputQueue, pMsgIn);
-
-    /* Signal application */
-    (void)OSA_EventSet(mAppEvent, gAppEvtMsgFromHostStack_c);
+    App_PostHostMessage(pMsgIn);
 }
 
 
@@ -141,6 +141,7 @@ typedef struct secLibMsgData_tag
 typedef struct appMsgFromHost_tag
 {
     uint32_t    msgType;
+    uint32_t    timestamp;      /* Enqueue time, us, set by App_PostHostMessage */
     union {
         gapGenericEvent_t       genericMsg;
         gapAdvertisingEvent_t   advMsg;
@@ -155,6 +156,20 @@ typedef struct appMsgFromHost_tag
     } msgData;
 } appMsgFromHost_t;
 
+/*! Application task input queues. The callback queues are priority classes,
+    highest first */
+typedef enum appQueueId_tag
+{
+    gAppQueueHost_c = 0,        /* Host stack to application */
+    gAppQueueControl_c,         /* CCC / ranging control callbacks */
+    gAppQueueConnection_c,      /* Connection management callbacks, the default class */
+    gAppQueueHousekeeping_c,    /* Periodic, telemetry and diagnostic callbacks */
+    gAppQueueCount_c
+} appQueueId_t;
+
+/*! Selects the callback queue of a parameter posted with App_PostCallbackMessage */
+typedef appQueueId_t (*appCallbackClassifier_t)(appCallbackParam_t param);
+
 /*! Callback for notifying application upon Bluetooth LE stack initialization */
 typedef void (*appBluetoothLEInitCompleteCallback_t)(void);
 
@@ -174,6 +189,37 @@ typedef void (*appBluetoothLEInitCompleteCallback_t)(void);
 #define gAppEvtMsgFromHostStack_c       (1U << 0U)
 #define gAppEvtAppCallback_c            (1U << 1U)
 
+/*! Messages taken from the host queue, and from the callback queues together,
+    per application task wake. Redefine it in the app_preinclude.h file */
+#ifndef gAppMsgBatchBudget_c
+#define gAppMsgBatchBudget_c            (8U)
+#endif
+
+/*! Callbacks of higher classes dispatched while a lower class waits, before
+    that class is served once ahead of them. Redefine it in the app_preinclude.h file */
+#ifndef gAppMsgStarvationLimit_c
+#define gAppMsgStarvationLimit_c        (16U)
+#endif
+
+#define gAppCallbackQueues_c            ((uint32_t)gAppQueueCount_c - (uint32_t)gAppQueueControl_c)
+
+/*! Queueing latency histogram: bucket i counts latencies below
+    (gAppQueueLatencyFirstUs_c << i) us, the last bucket everything above */
+#define gAppQueueLatencyFirstUs_c       (32U)
+#define gAppQueueLatencyBuckets_c       (12U)
+
+/*! Counters of one application input queue */
+typedef struct appQueueStats_tag
+{
+    uint32_t    messages;
+    uint32_t    wakes;          /* Wakes that handled at least one message of the queue */
+    uint16_t    depth;
+    uint16_t    maxDepth;
+    uint32_t    maxLatencyUs;
+    uint32_t    promoted;       /* Served ahead of higher classes by starvation protection */
+    uint32_t    aLatency[gAppQueueLatencyBuckets_c];
+} appQueueStats_t;
+
 #if (defined(gAppSecureMode_d) && (gAppSecureMode_d > 0U))
 #define App_NvmWriteLocalIRK(pLocalKey)   App_NvmWriteLocalKeys(0U, pLocalKey)
 #define App_NvmWriteLocalCSRK(pLocalKey)  App_NvmWriteLocalKeys(1U, pLocalKey)
@@ -523,7 +569,9 @@ bleResult_t App_RegisterLeCbCallbacks
 *\return       bleResult_t     Result of the operation.
 *
 *\remarks      This function should be used by the application if a callback must
-*              be executed in the context of the Application Task.
+*              be executed in the context of the Application Task. The queue is
+*              chosen by the classifier registered for the handler, connection
+*              management when there is none.
 ********************************************************************************** */
 bleResult_t App_PostCallbackMessage
 (
@@ -531,6 +579,84 @@ bleResult_t App_PostCallbackMessage
     appCallbackParam_t     param
 );
 
+/*! *********************************************************************************
+*\fn           bleResult_t App_PostCallbackMessageToQueue(
+*                  appCallbackHandler_t   handler
+*                  appCallbackParam_t     param
+*                  appQueueId_t           queueId
+*              )
+*\brief        Posts an application event to a given callback priority class.
+*
+*\param  [in]  handler         Handler function.
+*\param  [in]  param           Parameter for the handler function.
+*\param  [in]  queueId         gAppQueueControl_c, gAppQueueConnection_c or
+*                              gAppQueueHousekeeping_c.
+*
+*\return       bleResult_t     Result of the operation.
+********************************************************************************** */
+bleResult_t App_PostCallbackMessageToQueue
+(
+    appCallbackHandler_t   handler,
+    appCallbackParam_t     param,
+    appQueueId_t           queueId
+);
+
+/*! *********************************************************************************
+*\fn           void App_RegisterCallbackClassifier(
+*                  appCallbackHandler_t     handler
+*                  appCallbackClassifier_t  pfClassifier
+*              )
+*\brief        Sets the function that picks the callback queue of the messages
+*              posted for a handler. One handler can be classified.
+*
+*\param  [in]  handler         Handler function.
+*\param  [in]  pfClassifier    Classifier, NULL to remove it.
+*
+*\retval       void.
+********************************************************************************** */
+void App_RegisterCallbackClassifier
+(
+    appCallbackHandler_t     handler,
+    appCallbackClassifier_t  pfClassifier
+);
+
+/*! *********************************************************************************
+*\fn           void App_PostHostMessage(appMsgFromHost_t* pMsgIn)
+*\brief        Time stamps a message from the host stack, puts it in the Host Stack
+*              to App queue and signals the application.
+*
+*\param  [in]  pMsgIn          Message allocated with MSG_Alloc.
+*
+*\retval       void.
+********************************************************************************** */
+void App_PostHostMessage
+(
+    appMsgFromHost_t* pMsgIn
+);
+
+/*! *********************************************************************************
+*\fn           const appQueueStats_t* App_GetQueueStats(appQueueId_t queueId)
+*\brief        Depth, wake and queueing latency counters of an input queue.
+*
+*\param  [in]  queueId         Queue.
+*
+*\return       Counters, NULL for an unknown queue.
+********************************************************************************** */
+const appQueueStats_t* App_GetQueueStats
+(
+    appQueueId_t queueId
+);
+
+/*! *********************************************************************************
+*\fn           void App_ResetQueueStats(void)
+*\brief        Clears the input queue counters, the current depths are kept.
+*
+*\param  [in]  none.
+*
+*\retval       void.
+********************************************************************************** */
+void App_ResetQueueStats(void);
+
 /*! *********************************************************************************
 *\fn           bleResult_t App_NvmErase(uint8_t mEntryIdx)
 *\brief        This function erases the data corresponding to an entry.
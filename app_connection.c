@@ -80,14 +80,14 @@ void App_ConnectionCallback
 {
     appMsgFromHost_t *pMsgIn = NULL;
 
-    uint32_t msgLen = sizeof(uint32_t) + sizeof(connectionMsg_t);
+    uint32_t msgLen = (uint32_t)&(pMsgIn->msgData) + sizeof(connectionMsg_t);
 
     if(pConnectionEvent->eventType == gConnEvtKeysReceived_c)
     {
         gapSmpKeys_t    *pKeys = pConnectionEvent->eventData.keysReceivedEvent.pKeys;
 
-        /* add room for pMsgIn->msgType */
-        msgLen = sizeof(uint32_t);
+        /* add room for pMsgIn->msgType and pMsgIn->timestamp */
+        msgLen = (uint32_t)&(pMsgIn->msgData);
         /* add room for pMsgIn->msgData.connMsg.deviceId */
         msgLen += sizeof(uint32_t);
         /* add room for pMsgIn->msgData.connMsg.connEvent.eventType */
@@ -225,10 +225,7 @@ void App_ConnectionCallback
     }
 
     /* Put message in the Host Stack to App queue */
-    (void)MSG_QueueAddTail(&mHostAppInputQueue, pMsgIn);
-
-    /* Signal application */
-    (void)OSA_EventSet(mAppEvent, gAppEvtMsgFromHostStack_c);
+    App_PostHostMessage(pMsgIn);
 }
 
 /************************************************************************************
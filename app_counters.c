@@ -0,0 +1,294 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_counters.c
+*
+* Lifetime counters, journaled to NVM. The journal is one base record and
+* gAppCounterJournalSlots_c delta records, each stamped with a sequence
+* number: delta seq s lives in slot s % gAppCounterJournalSlots_c. Boot reads
+* the base and applies the deltas seq base + 1, base + 2, ... up to the first
+* one missing. A compaction writes a base holding all counts under a new
+* sequence number, so the deltas it replaces are skipped from then on and
+* their slots reused.
+*
+* Counters are incremented from any context. Checkpoints (timer task) and
+* compactions (any task) are serialized by a mutex.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "fsl_os_abstraction.h"
+#include "fsl_component_timer_manager.h"
+#include "ble_general.h"
+#include "app_conn.h"
+#include "app_counters.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+/* Current values */
+static volatile uint32_t maCounterValues[gAppCounterCount_c];
+
+/* Values as held by the journal, base + deltas up to mCounterSeq */
+static uint32_t maCounterJournaled[gAppCounterCount_c];
+
+static uint32_t mCounterSeq = 0U;
+static uint32_t mCounterBaseSeq = 0U;
+static appCounterStats_t mCounterStats;
+static bool_t mCounterTimerOpen = FALSE;
+static TIMER_MANAGER_HANDLE_DEFINE(mCounterTmrId);
+static OSA_MUTEX_HANDLE_DEFINE(mCounterMutexId);
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static void App_CountersTimerCallback(void *pParam);
+static void App_CountersCheckpointHandler(appCallbackParam_t param);
+static void App_CountersCompactLocked(appCounterCompactReason_t reason);
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Rebuilds the counters from the journal and starts the checkpoint
+*               timer. Called once NVM is initialized.
+********************************************************************************** */
+void App_CountersInit(void)
+{
+    appCounterBase_t base;
+    appCounterDelta_t delta;
+    uint32_t seq;
+    uint8_t i;
+
+    mCounterBaseSeq = 0U;
+    mCounterStats.replayed = 0U;
+    if (App_NvmReadCounterBase(&base) == TRUE)
+    {
+        mCounterBaseSeq = base.seq;
+        for (i = 0U; i < (uint8_t)gAppCounterCount_c; i++)
+        {
+            maCounterJournaled[i] = base.values[i];
+        }
+    }
+    else
+    {
+        for (i = 0U; i < (uint8_t)gAppCounterCount_c; i++)
+        {
+            maCounterJournaled[i] = 0U;
+        }
+    }
+
+    /* Deltas after the base, in sequence. Older ones left in the slots are
+       already counted by the base. */
+    seq = mCounterBaseSeq;
+    while ((App_NvmReadCounterDelta((uint8_t)((seq + 1U) % gAppCounterJournalSlots_c), &delta) == TRUE) &&
+           (delta.seq == (seq + 1U)))
+    {
+        for (i = 0U; i < (uint8_t)gAppCounterCount_c; i++)
+        {
+            maCounterJournaled[i] += delta.deltas[i];
+        }
+        seq++;
+        mCounterStats.replayed++;
+    }
+    mCounterSeq = seq;
+
+    OSA_InterruptDisable();
+    for (i = 0U; i < (uint8_t)gAppCounterCount_c; i++)
+    {
+        maCounterValues[i] = maCounterJournaled[i];
+    }
+    OSA_InterruptEnable();
+
+    if (mCounterTimerOpen == FALSE)
+    {
+        (void)OSA_MutexCreate((osa_mutex_handle_t)mCounterMutexId);
+        if (kStatus_TimerSuccess == TM_Open((timer_handle_t)mCounterTmrId))
+        {
+            (void)TM_InstallCallback((timer_handle_t)mCounterTmrId, App_CountersTimerCallback, NULL);
+            /* Not a low power timer: counts made while the device sleeps wait
+               for the next wake up */
+            (void)TM_Start((timer_handle_t)mCounterTmrId, (uint8_t)kTimerModeIntervalTimer, gAppCounterCheckpointMs_c);
+            mCounterTimerOpen = TRUE;
+        }
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Adds to a counter. Callable from any context.
+*
+* \param[in]    id              Counter.
+* \param[in]    increment       Amount to add.
+********************************************************************************** */
+void App_CounterAdd(appCounterId_t id, uint32_t increment)
+{
+    if (id < gAppCounterCount_c)
+    {
+        OSA_InterruptDisable();
+        maCounterValues[id] += increment;
+        OSA_InterruptEnable();
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Current value of a counter, 0 for an unknown one.
+********************************************************************************** */
+uint32_t App_CounterGet(appCounterId_t id)
+{
+    return (id < gAppCounterCount_c) ? maCounterValues[id] : 0U;
+}
+
+/*! *********************************************************************************
+* \brief        Writes the counts made since the last record as a delta record,
+*               or compacts when the journal is full. Nothing is written when
+*               the counters did not change. Called from a task.
+********************************************************************************** */
+void App_CountersCheckpoint(void)
+{
+    appCounterDelta_t delta;
+    uint32_t pending;
+    bool_t changed = FALSE;
+    uint8_t i;
+
+    (void)OSA_MutexLock((osa_mutex_handle_t)mCounterMutexId, osaWaitForever_c);
+    if ((mCounterSeq - mCounterBaseSeq) >= gAppCounterJournalSlots_c)
+    {
+        App_CountersCompactLocked(gAppCounterCompactJournalFull_c);
+    }
+    else
+    {
+        delta.seq = mCounterSeq + 1U;
+        for (i = 0U; i < (uint8_t)gAppCounterCount_c; i++)
+        {
+            pending = maCounterValues[i] - maCounterJournaled[i];
+            delta.deltas[i] = (uint16_t)((pending < gAppCounterMaxDelta_c) ? pending : gAppCounterMaxDelta_c);
+            if (delta.deltas[i] != 0U)
+            {
+                changed = TRUE;
+            }
+        }
+
+        if (changed == TRUE)
+        {
+            if (App_NvmWriteCounterDelta((uint8_t)(delta.seq % gAppCounterJournalSlots_c), &delta) == TRUE)
+            {
+                for (i = 0U; i < (uint8_t)gAppCounterCount_c; i++)
+                {
+                    maCounterJournaled[i] += delta.deltas[i];
+                }
+                mCounterSeq = delta.seq;
+                mCounterStats.checkpoints++;
+            }
+            else
+            {
+                /* Counts stay pending for the next checkpoint */
+                mCounterStats.errors++;
+            }
+        }
+    }
+    (void)OSA_MutexUnlock((osa_mutex_handle_t)mCounterMutexId);
+}
+
+/*! *********************************************************************************
+* \brief        Folds the journal and the pending counts into the base record,
+*               written before returning. Called from a task, e.g. before a
+*               reset.
+*
+* \param[in]    reason          Reported by the shell.
+********************************************************************************** */
+void App_CountersCompact(appCounterCompactReason_t reason)
+{
+    (void)OSA_MutexLock((osa_mutex_handle_t)mCounterMutexId, osaWaitForever_c);
+    App_CountersCompactLocked(reason);
+    (void)OSA_MutexUnlock((osa_mutex_handle_t)mCounterMutexId);
+}
+
+/*! *********************************************************************************
+* \brief        Journal counters.
+********************************************************************************** */
+const appCounterStats_t *App_CountersGetStats(void)
+{
+    return &mCounterStats;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Checkpoint period elapsed, timer task: checkpoint from the
+*               application task, the record write is synchronous.
+********************************************************************************** */
+static void App_CountersTimerCallback(void *pParam)
+{
+    (void)pParam;
+    /* Out of messages: the counts go with the next period */
+    (void)App_PostCallbackMessageToQueue(App_CountersCheckpointHandler, NULL, gAppQueueHousekeeping_c);
+}
+
+static void App_CountersCheckpointHandler(appCallbackParam_t param)
+{
+    (void)param;
+    App_CountersCheckpoint();
+}
+
+/*! *********************************************************************************
+* \brief        Writes the base record if it would change, mutex held.
+********************************************************************************** */
+static void App_CountersCompactLocked(appCounterCompactReason_t reason)
+{
+    appCounterBase_t base;
+    bool_t changed = (mCounterSeq != mCounterBaseSeq) ? TRUE : FALSE;
+    uint8_t i;
+
+    base.seq = mCounterSeq + 1U;
+    OSA_InterruptDisable();
+    for (i = 0U; i < (uint8_t)gAppCounterCount_c; i++)
+    {
+        base.values[i] = maCounterValues[i];
+        if (base.values[i] != maCounterJournaled[i])
+        {
+            changed = TRUE;
+        }
+    }
+    OSA_InterruptEnable();
+
+    if (changed == FALSE)
+    {
+        ; /* Base record up to date, e.g. repeated low battery checks */
+    }
+    else if (App_NvmWriteCounterBase(&base) == TRUE)
+    {
+        for (i = 0U; i < (uint8_t)gAppCounterCount_c; i++)
+        {
+            maCounterJournaled[i] = base.values[i];
+        }
+        mCounterSeq = base.seq;
+        mCounterBaseSeq = base.seq;
+        mCounterStats.compactions++;
+        mCounterStats.lastCompactReason = (uint16_t)reason;
+    }
+    else
+    {
+        mCounterStats.errors++;
+    }
+}
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
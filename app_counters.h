@@ -0,0 +1,127 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_counters.h
+*
+* Lifetime counters (steps, RKE actions, connections, ranging sessions). They
+* are counted in RAM and checkpointed to NVM as delta records in a small
+* journal, folded into a base record when the journal is full, on low battery
+* and before a reset. A power loss loses at most the counts of one checkpoint
+* period.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef APP_COUNTERS_H
+#define APP_COUNTERS_H
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+/*! Checkpoint period, ms: the most counting a power loss can lose.
+    Redefine it in the app_preinclude.h file */
+#ifndef gAppCounterCheckpointMs_c
+#define gAppCounterCheckpointMs_c            (60000U)
+#endif
+
+/*! Delta records between two compactions.
+    Redefine it in the app_preinclude.h file */
+#ifndef gAppCounterJournalSlots_c
+#define gAppCounterJournalSlots_c            (8U)
+#endif
+
+/*! Largest increment one delta record holds, the rest goes with the next one */
+#define gAppCounterMaxDelta_c                (0xFFFFU)
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+/*! \brief  Counter IDs. Append only: the NVM records are indexed by them. */
+typedef enum appCounterId_tag
+{
+    gAppCounterSteps_c = 0,         /*!< Steps from the motion sensor */
+    gAppCounterRke_c,               /*!< RKE actions acknowledged by a vehicle */
+    gAppCounterConnections_c,       /*!< BLE connections established */
+    gAppCounterRanging_c,           /*!< UWB ranging sessions started */
+    gAppCounterCount_c
+}appCounterId_t;
+
+/*! \brief  Base record: counter values up to and including sequence seq. */
+typedef PACKED_STRUCT appCounterBase_tag
+{
+    uint32_t    seq;
+    uint32_t    values[gAppCounterCount_c];
+}appCounterBase_t;
+
+/*! \brief  Delta record: increments since the record of sequence seq - 1. */
+typedef PACKED_STRUCT appCounterDelta_tag
+{
+    uint32_t    seq;
+    uint16_t    deltas[gAppCounterCount_c];
+}appCounterDelta_t;
+
+/*! \brief  Journal counters. */
+typedef struct appCounterStats_tag
+{
+    uint32_t    checkpoints;        /*!< Delta records written */
+    uint32_t    compactions;        /*!< Base records written */
+    uint32_t    errors;             /*!< Record writes that failed, retried later */
+    uint16_t    replayed;           /*!< Delta records applied at boot */
+    uint16_t    lastCompactReason;  /*!< appCounterCompactReason_t */
+}appCounterStats_t;
+
+/*! \brief  Why the journal was folded into the base record. */
+typedef enum appCounterCompactReason_tag
+{
+    gAppCounterCompactNone_c = 0,
+    gAppCounterCompactJournalFull_c,
+    gAppCounterCompactLowBattery_c,
+    gAppCounterCompactShutdown_c,
+    gAppCounterCompactUser_c
+}appCounterCompactReason_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void App_CountersInit(void);
+void App_CounterAdd(appCounterId_t id, uint32_t increment);
+uint32_t App_CounterGet(appCounterId_t id);
+void App_CountersCheckpoint(void);
+void App_CountersCompact(appCounterCompactReason_t reason);
+const appCounterStats_t *App_CountersGetStats(void);
+
+/* Record storage, app_nvm.c. A record write is atomic: after a power loss the
+   slot holds the old record or the new one. */
+bool_t App_NvmReadCounterBase(appCounterBase_t *pBase);
+bool_t App_NvmWriteCounterBase(const appCounterBase_t *pBase);
+bool_t App_NvmReadCounterDelta(uint8_t slot, appCounterDelta_t *pDelta);
+bool_t App_NvmWriteCounterDelta(uint8_t slot, const appCounterDelta_t *pDelta);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_COUNTERS_H */
+
+/*! *********************************************************************************
+ * @}
+ ********************************************************************************** */
@@ -0,0 +1,339 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_diag.c
+*
+* Diagnostics stream. Producers hand their values to App_DiagUpdate from any
+* task; a value that moved from the one last notified by at least its
+* threshold marks its field pending. The pending fields go in one frame from
+* the housekeeping queue, right away when the last frame is older than
+* diag_min_interval, else when the timer started for the rest of it expires:
+* changes in between are folded into that frame. The frame is notified to
+* every peer that enabled notifications; a peer enabling them gets a frame
+* of every field.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "fsl_os_abstraction.h"
+#include "fsl_component_timer_manager.h"
+#include "ble_general.h"
+#include "gap_interface.h"
+#include "gatt_server_interface.h"
+#include "gatt_db_app_interface.h"
+#include "gatt_db_handles.h"
+#include "app_conn.h"
+#include "app_nvm.h"
+#include "app_diag.h"
+
+#if defined(gAppDiagStream_d) && (gAppDiagStream_d == 1)
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mcDiagAllFields_c           ((uint8_t)((1U << (uint32_t)gAppDiagFieldCount_c) - 1U))
+#define mcDiagFrameMaxSize_c        (gAppDiagHeaderSize_c + 11U)
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+/* Frame width of each field, bytes */
+static const uint8_t maDiagWidth[gAppDiagFieldCount_c] = {1U, 1U, 1U, 1U, 1U, 1U, 1U, 4U};
+
+/* Latest values and the values last put in a frame */
+static int32_t maDiagValue[gAppDiagFieldCount_c];
+static int32_t maDiagSent[gAppDiagFieldCount_c];
+
+static uint8_t mDiagPending = 0U;
+static uint8_t mDiagSeq = 0U;
+static bool_t mDiagScheduled = FALSE;
+static uint64_t mDiagLastFrameTs = 0U;
+static appDiagStats_t mDiagStats;
+static bool_t mDiagTimerOpen = FALSE;
+static TIMER_MANAGER_HANDLE_DEFINE(mDiagTmrId);
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static int32_t App_DiagThreshold(appDiagField_t field);
+static void App_DiagSchedule(void);
+static void App_DiagTimerCallback(void *pParam);
+static void App_DiagFlushHandler(appCallbackParam_t param);
+static uint8_t App_DiagBuildFrame(uint8_t mask, const int32_t *aValues, uint8_t *pFrame);
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Latest value of a field. Marks it pending when it moved from
+*               the value last notified by its threshold. Callable from any task.
+*
+* \param[in]    field           Field.
+* \param[in]    value           Its value.
+********************************************************************************** */
+void App_DiagUpdate(appDiagField_t field, int32_t value)
+{
+    int32_t delta;
+    bool_t schedule = FALSE;
+
+    if (field < gAppDiagFieldCount_c)
+    {
+        OSA_InterruptDisable();
+        maDiagValue[field] = value;
+        mDiagStats.updates++;
+        delta = value - maDiagSent[field];
+        if ((delta >= App_DiagThreshold(field)) || (-delta >= App_DiagThreshold(field)))
+        {
+            if ((mDiagPending & (1U << (uint32_t)field)) == 0U)
+            {
+                mDiagPending |= (uint8_t)(1U << (uint32_t)field);
+                mDiagStats.changes++;
+            }
+            if (mDiagScheduled == FALSE)
+            {
+                mDiagScheduled = TRUE;
+                schedule = TRUE;
+            }
+        }
+        OSA_InterruptEnable();
+
+        if (schedule == TRUE)
+        {
+            App_DiagSchedule();
+        }
+    }
+}
+
+/*! *********************************************************************************
+* \brief        A peer enabled notifications: the next frame carries every field.
+********************************************************************************** */
+void App_DiagSubscribed(deviceId_t deviceId)
+{
+    bool_t schedule = FALSE;
+
+    (void)deviceId;
+    OSA_InterruptDisable();
+    mDiagPending = mcDiagAllFields_c;
+    if (mDiagScheduled == FALSE)
+    {
+        mDiagScheduled = TRUE;
+        schedule = TRUE;
+    }
+    OSA_InterruptEnable();
+
+    if (schedule == TRUE)
+    {
+        App_DiagSchedule();
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Diagnostics stream counters.
+********************************************************************************** */
+const appDiagStats_t *App_DiagGetStats(void)
+{
+    return &mDiagStats;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Smallest change notified. 0 in diag_rssi_delta: every change.
+********************************************************************************** */
+static int32_t App_DiagThreshold(appDiagField_t field)
+{
+    systemParameters_t *pSysParams = NULL;
+    int32_t threshold = 1;
+
+    switch (field)
+    {
+        case gAppDiagRssi_c:
+        case gAppDiagFilteredRssi_c:
+        {
+            (void)App_NvmReadSystemParams(&pSysParams);
+            threshold = (int32_t)(pSysParams->system_params).fields.diag_rssi_delta;
+        }
+        break;
+
+        case gAppDiagBattery_c:
+        {
+            threshold = gAppDiagBatteryDelta_c;
+        }
+        break;
+
+        case gAppDiagTemperature_c:
+        {
+            threshold = gAppDiagTemperatureDelta_c;
+        }
+        break;
+
+        case gAppDiagStepCount_c:
+        {
+            threshold = gAppDiagStepDelta_c;
+        }
+        break;
+
+        default:
+        {
+            ; /* States: every change */
+        }
+        break;
+    }
+    return (threshold > 0) ? threshold : 1;
+}
+
+/*! *********************************************************************************
+* \brief        Sends the pending fields now, or once diag_min_interval has
+*               passed since the last frame.
+********************************************************************************** */
+static void App_DiagSchedule(void)
+{
+    systemParameters_t *pSysParams = NULL;
+    uint64_t elapsedMs = (TM_GetTimestamp() - mDiagLastFrameTs) / 1000U;
+    uint32_t intervalMs;
+
+    (void)App_NvmReadSystemParams(&pSysParams);
+    intervalMs = (pSysParams->system_params).fields.diag_min_interval;
+
+    if (mDiagTimerOpen == FALSE)
+    {
+        if (kStatus_TimerSuccess == TM_Open((timer_handle_t)mDiagTmrId))
+        {
+            (void)TM_InstallCallback((timer_handle_t)mDiagTmrId, App_DiagTimerCallback, NULL);
+            mDiagTimerOpen = TRUE;
+        }
+    }
+
+    if ((elapsedMs < intervalMs) && (mDiagTimerOpen == TRUE))
+    {
+        mDiagStats.deferred++;
+        (void)TM_Start((timer_handle_t)mDiagTmrId, (uint8_t)kTimerModeSingleShot, intervalMs - (uint32_t)elapsedMs);
+    }
+    else if (gBleSuccess_c != App_PostCallbackMessageToQueue(App_DiagFlushHandler, NULL, gAppQueueHousekeeping_c))
+    {
+        /* Out of messages: the next change schedules again */
+        mDiagScheduled = FALSE;
+    }
+    else
+    {
+        ; /* Sent from the housekeeping queue */
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Rate limit elapsed, timer task: send from the application task.
+********************************************************************************** */
+static void App_DiagTimerCallback(void *pParam)
+{
+    (void)pParam;
+    if (gBleSuccess_c != App_PostCallbackMessageToQueue(App_DiagFlushHandler, NULL, gAppQueueHousekeeping_c))
+    {
+        mDiagScheduled = FALSE;
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Notifies the pending fields to the subscribed peers, and keeps
+*               the frame of every field as the characteristic value.
+********************************************************************************** */
+static void App_DiagFlushHandler(appCallbackParam_t param)
+{
+    int32_t aValues[gAppDiagFieldCount_c];
+    uint8_t aFrame[mcDiagFrameMaxSize_c];
+    uint8_t length;
+    uint8_t mask;
+    uint8_t i;
+    deviceId_t deviceId;
+    bool_t active;
+
+    (void)param;
+    OSA_InterruptDisable();
+    mask = mDiagPending;
+    mDiagPending = 0U;
+    mDiagScheduled = FALSE;
+    for (i = 0U; i < (uint8_t)gAppDiagFieldCount_c; i++)
+    {
+        aValues[i] = maDiagValue[i];
+        if ((mask & (1U << i)) != 0U)
+        {
+            maDiagSent[i] = maDiagValue[i];
+        }
+    }
+    OSA_InterruptEnable();
+
+    if (mask != 0U)
+    {
+        mDiagLastFrameTs = TM_GetTimestamp();
+        mDiagSeq++;
+        mDiagStats.frames++;
+
+        length = App_DiagBuildFrame(mcDiagAllFields_c, aValues, aFrame);
+        (void)GattDb_WriteAttribute((uint16_t)value_diagnostics, length, aFrame);
+
+        length = App_DiagBuildFrame(mask, aValues, aFrame);
+        for (deviceId = 0U; deviceId < (deviceId_t)gAppMaxConnections_c; deviceId++)
+        {
+            /* Fails for a peer not connected */
+            active = FALSE;
+            if ((gBleSuccess_c == Gap_CheckNotificationStatus(deviceId, (uint16_t)cccd_diagnostics, &active)) &&
+                (active == TRUE) &&
+                (gBleSuccess_c == GattServer_SendInstantValueNotification(deviceId, (uint16_t)value_diagnostics,
+                                                                          length, aFrame)))
+            {
+                mDiagStats.notifications++;
+                mDiagStats.bytes += length;
+            }
+        }
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Sequence number, mask, then the fields of the mask.
+*
+* \return       Frame length.
+********************************************************************************** */
+static uint8_t App_DiagBuildFrame(uint8_t mask, const int32_t *aValues, uint8_t *pFrame)
+{
+    uint8_t length = gAppDiagHeaderSize_c;
+    uint8_t i;
+    uint8_t b;
+
+    pFrame[0] = mDiagSeq;
+    pFrame[1] = mask;
+    for (i = 0U; i < (uint8_t)gAppDiagFieldCount_c; i++)
+    {
+        if ((mask & (1U << i)) != 0U)
+        {
+            for (b = 0U; b < maDiagWidth[i]; b++)
+            {
+                pFrame[length] = (uint8_t)((uint32_t)aValues[i] >> (8U * b));
+                length++;
+            }
+        }
+    }
+    return length;
+}
+
+#endif /* gAppDiagStream_d */
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
@@ -0,0 +1,118 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_diag.h
+*
+* Diagnostics stream: operational values notified on the diagnostics
+* characteristic of the commands service when they change beyond a
+* threshold, at most once per diag_min_interval.
+*
+* Frame: sequence number, mask of the fields it carries (bit n: field n of
+* appDiagField_t), then the value of each of them in field order, least
+* significant byte first, on the width given with the field. A read of the
+* characteristic gives the last frame with every field.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef APP_DIAG_H
+#define APP_DIAG_H
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "ble_general.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+/*! Enable/disable the diagnostics stream. Disabled, the values go every 10 s
+    in a log message on the DK L2CAP channel instead.
+    Redefine it in the app_preinclude.h file */
+#ifndef gAppDiagStream_d
+#define gAppDiagStream_d                     1
+#endif
+
+/*! Change notified, in degrees Celsius. The RSSI ones are the
+    diag_rssi_delta system parameter. Redefine it in the app_preinclude.h file */
+#ifndef gAppDiagTemperatureDelta_c
+#define gAppDiagTemperatureDelta_c           (1)
+#endif
+
+/*! Change notified, in percent. Redefine it in the app_preinclude.h file */
+#ifndef gAppDiagBatteryDelta_c
+#define gAppDiagBatteryDelta_c               (1)
+#endif
+
+/*! Change notified, in steps. Redefine it in the app_preinclude.h file */
+#ifndef gAppDiagStepDelta_c
+#define gAppDiagStepDelta_c                  (10)
+#endif
+
+/*! Frame header: sequence number, field mask */
+#define gAppDiagHeaderSize_c                 (2U)
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+/*! \brief  Fields of the stream, in frame order. */
+typedef enum appDiagField_tag
+{
+    gAppDiagRssi_c = 0,             /*!< Last RSSI sample, dBm, 1 byte */
+    gAppDiagFilteredRssi_c,         /*!< Filtered RSSI, dBm, 1 byte */
+    gAppDiagIntent_c,               /*!< Last intent decided, appIntent_t, 1 byte */
+    gAppDiagVehicleState_c,         /*!< gVehicleState_t, 1 byte */
+    gAppDiagUwbState_c,             /*!< gUWBState_t, 1 byte */
+    gAppDiagBattery_c,              /*!< Battery level, %, 1 byte */
+    gAppDiagTemperature_c,          /*!< Temperature, degrees Celsius, 1 byte */
+    gAppDiagStepCount_c,            /*!< Total steps, 4 bytes */
+    gAppDiagFieldCount_c
+}appDiagField_t;
+
+/*! \brief  Diagnostics stream counters. */
+typedef struct appDiagStats_tag
+{
+    uint32_t    updates;            /*!< Values given to App_DiagUpdate */
+    uint32_t    changes;            /*!< Fields that changed beyond their threshold */
+    uint32_t    frames;             /*!< Frames built */
+    uint32_t    deferred;           /*!< Frames held back by the rate limit */
+    uint32_t    notifications;      /*!< Notifications sent, one per subscriber */
+    uint32_t    bytes;              /*!< Their payload bytes */
+}appDiagStats_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(gAppDiagStream_d) && (gAppDiagStream_d == 1)
+void App_DiagUpdate(appDiagField_t field, int32_t value);
+void App_DiagSubscribed(deviceId_t deviceId);
+const appDiagStats_t *App_DiagGetStats(void);
+#else
+#define App_DiagUpdate(field, value)
+#define App_DiagSubscribed(deviceId)
+#endif /* gAppDiagStream_d */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_DIAG_H */
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
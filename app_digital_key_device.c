@@ -75,6 +75,19 @@
 
 #include "uwb_manager.h"
 
+#include "app_latency.h"
+#include "ccc_spake2p.h"
+#include "ccc_ecdsa.h"
+#include "ccc_credentials.h"
+#include "app_rke.h"
+#include "app_counters.h"
+#include "app_dk_channels.h"
+#include "app_event_pool.h"
+#include "app_trace.h"
+#include "app_rssi_filter.h"
+#include "app_rssi_intent.h"
+#include "app_diag.h"
+
 #include <phscaEseUtils.h>
 #include <phscaEseHal.h>
 #include <phscaEseLog.h>
@@ -95,12 +108,9 @@
 #define mcScanAfterSwitchToCentralRole      0
 #define mcEncryptionKeySize_c              16
 #define mcPacketMaxPayloadSize             64
-#define mcRssiMaxCounter                   10
-#define mcRssiCorrection                   20
 #define mcRssiTimeoutInMicroseconds    30000U
 #define mcLogTimeoutInSeconds             10U
 #define mcTemperatureTimeout               10
-#define mcCalculateNewFilteredRssi(rssi_sum)   ((rssi_sum)/(mcRssiMaxCounter))
 #define mcMaxSameIntentsCount(timeout_between_same_intents_ms, connection_interval_ms, rssi_max_counter)  (((timeout_between_same_intents_ms) / ((connection_interval_ms) * (rssi_max_counter))))
 #define mcMaxTemperatureCount(temprature_count_ms, connection_interval_ms)  ((temprature_count_ms) / (connection_interval_ms))
 
@@ -121,6 +131,7 @@ uint8_t mCurrentCharReadingIndex;
 
 TIMER_MANAGER_HANDLE_DEFINE(rssiTmrId);
 TIMER_MANAGER_HANDLE_DEFINE(logTmrId);
+TIMER_MANAGER_HANDLE_DEFINE(rkeTmrId);
 
 /* Which peer are we doing OOB pairing with? */
 deviceId_t mCurrentPeerId = gInvalidDeviceId_c;
@@ -134,19 +145,12 @@ extern volatile uint32_t step_without_scan;
 extern volatile uint32_t step_while_scan;
 extern uint32_t total_step_count;
 extern uint32_t still_detected_count;
+extern bool_t in_motion;
 /************************************************************************************
 *************************************************************************************
 * Private type definitions
 *************************************************************************************
 ************************************************************************************/
-typedef enum appIntent_tag
-{
-    App_LowIntent = 0,
-    App_MediumIntent,
-    App_HighIntent,
-    App_Undefined
-}appIntent_t;
-
 typedef enum apppacketId_tag
 {
     App_Rssi0Id = 0,
@@ -184,6 +188,11 @@ static const apduItem_t ApduRegistry[] =
     {CreateRangingKey_ApduId,           gCreateRangingKeyRespPayloadLength  },
     {ControlFlow_ApduId,                gControlFlowRespPayloadLength       },
 };
+#if defined(gAppUseBonding_d) && (gAppUseBonding_d)
+/* The host stack saves gcReservedFlashSizeForCustomInformation_c bytes per bond */
+_Static_assert(sizeof(appCustomInfo_t) <= gcReservedFlashSizeForCustomInformation_c,
+               "appCustomInfo_t does not fit in the custom peer information of a bond");
+#endif
 /************************************************************************************
 *************************************************************************************
 * Private memory declarations
@@ -192,15 +201,6 @@ static const apduItem_t ApduRegistry[] =
 static gVehicleState_t mVehicleState = gStatusLocked_c;
 static gUWBState_t mUWBState = gUWBNoRanging_c;
 
-static int8_t mRssi0 = 0;
-static int8_t mNewFilteredRssi = 0;
-static appIntent_t mLastIntent = App_Undefined;
-static uint8_t mRssiCounter = 0;
-static int32_t mRssiSum = 0;
-static bool_t mValidRssi0 = false;
-static uint32_t mSameIntentCount = 0;
-static uint32_t mTemperatureCount = 0;
-static uint32_t mRssiActiveCount = 0;
 
 #if defined(gAppUseBonding_d) && (gAppUseBonding_d)
 static bool_t mRestoringBondedLink = FALSE;
@@ -343,7 +343,7 @@ static bleResult_t CCC_SendAPDUResp
 );
 
 static void CCC_DeriveArbitraryData(uintn8_t *pRkeChallenge, uintn8_t RkeChallengeLen, uint16_t function, uintn8_t action, uintn8_t *pHashOut, uintn8_t hashOutLen);
-static void CCC_SignArbitraryData(uintn8_t *pArbitraryData, uintn8_t arbitraryDataLen, uintn8_t *pAttestationOut);
+static bleResult_t CCC_SignArbitraryData(uintn8_t *pArbitraryData, uintn8_t arbitraryDataLen, uintn8_t *pAttestationOut);
 static void App_HandleKeys(appEventData_t *pEventData);
 static void App_HandleRKECommands(appEventData_t *pEventData);
 static void App_HandleGattClientCallback(appEventData_t *pEventData);
@@ -356,15 +356,29 @@ static void BleApp_HandlePreIdleState(deviceId_t peerDeviceId, appEvent_t event)
 static void BleApp_HandleIdleState(deviceId_t peerDeviceId, appEvent_t event);
 static void BleApp_HandleServiceDiscState(deviceId_t peerDeviceId, appEvent_t event);
 static void BleApp_HandlePairState(deviceId_t peerDeviceId, appEvent_t event);
+static void BleApp_ReadDatabaseHash(deviceId_t peerDeviceId);
+static void BleApp_HandleDatabaseHash(deviceId_t peerDeviceId, const uint8_t *pHash);
+#if defined(gAppUseBonding_d) && (gAppUseBonding_d)
+static void BleApp_SaveCustomInfo(deviceId_t peerDeviceId);
+#endif
+static void BleApp_ReadPsmUsingUuid(deviceId_t peerDeviceId);
 
-static void BleApp_StartRssiSensing(void);
+static void BleApp_StartRssiSensing(deviceId_t peerDeviceId);
+static void BleApp_StopRssiSensing(deviceId_t peerDeviceId);
+static void BleApp_HandleRssiSample(deviceId_t peerDeviceId, int8_t rssi);
 static void BleApp_RssiTimeoutTimerCallback(void* pParam);
-static appIntent_t BleApp_DecideIntentFromRSSI(int8_t newFilteredRssi, int8_t rssi0);
+static void BleApp_RkeRequest(deviceId_t deviceId, gDkRKEFunctionId_t function, uint8_t action);
+static void BleApp_RkeSendInFlight(deviceId_t deviceId);
+static void BleApp_RkeTimeoutTimerCallback(void* pParam);
+static void BleApp_RkeHandleTimeout(void);
+static void BleApp_GetRssiIntentParams(appRssiIntentParams_t *pParams);
 
 static void BleApp_StartLogTimer(void);
 static void BleApp_LogTimeoutTimerCallback(void* pParam);
 
+#if !defined(gAppDiagStream_d) || (gAppDiagStream_d == 0)
 static void BleApp_SendPacketToCarAnchor(deviceId_t deviceId);
+#endif
 
 static void BleApp_SwitchGapRole(appEventData_t *pEventData);
 static void Array_hex_string(uint8_t* array_hex, int len, char array_string[]);
@@ -417,14 +431,11 @@ void BleApp_StateMachineHandler(deviceId_t peerDeviceId, appEvent_t event)
         {
             if (event == mAppEvt_GattProcComplete_c)
             {
-                bleUuid_t dkServiceUuid;
-
                 /* Moving to Service Discovery State */
                 maPeerInformation[peerDeviceId].appState = mAppServiceDisc_c;
 
-                /* Start Service Discovery */
-                dkServiceUuid.uuid16 = gBleSig_CCC_DK_UUID_d;
-                (void)BleServDisc_FindService(peerDeviceId, gBleUuidType16_c, &dkServiceUuid);
+                /* Database Hash first, discovery starts when it is read */
+                BleApp_ReadDatabaseHash(peerDeviceId);
             }
             else if (event == mAppEvt_GattProcError_c)
             {
@@ -433,16 +444,15 @@ void BleApp_StateMachineHandler(deviceId_t peerDeviceId, appEvent_t event)
             }
             else if ( event == mAppEvt_PeerDisconnected_c )
             {
+                /* Before the device ID is invalidated: it turns the notification off */
+                BleApp_StopRssiSensing(peerDeviceId);
                 maPeerInformation[peerDeviceId].deviceId = gInvalidDeviceId_c;
                 maPeerInformation[peerDeviceId].appState = mAppIdle_c;
-                mRssi0 = 0;
-                mValidRssi0 = false;
-                mRssiCounter = 0;
-                mRssiSum = 0;
-                mLastIntent = App_Undefined;
-                mSameIntentCount = 0;
+                App_RssiIntentReset(&maPeerInformation[peerDeviceId].rssiIntent, gAppRssiFilterKind_c);
                 mVehicleState = gStatusLocked_c;
                 mUWBState = gUWBNoRanging_c;
+                App_DiagUpdate(gAppDiagVehicleState_c, (int32_t)mVehicleState);
+                App_DiagUpdate(gAppDiagUwbState_c, (int32_t)mUWBState);
                 KEYFOB_MGR_notify(KEYFOB_EVENT_BLE_DISCONNECTED);
             }
         }
@@ -458,14 +468,11 @@ void BleApp_StateMachineHandler(deviceId_t peerDeviceId, appEvent_t event)
         {
             if ( event == mAppEvt_PeerDisconnected_c )
             {
+                /* Before the device ID is invalidated: it turns the notification off */
+                BleApp_StopRssiSensing(peerDeviceId);
                 maPeerInformation[peerDeviceId].deviceId = gInvalidDeviceId_c;
                 maPeerInformation[peerDeviceId].appState = mAppIdle_c;
-                mRssi0 = 0;
-                mValidRssi0 = false;
-                mRssiCounter = 0;
-                mRssiSum = 0;
-                mLastIntent = App_Undefined;
-                mSameIntentCount = 0;
+                App_RssiIntentReset(&maPeerInformation[peerDeviceId].rssiIntent, gAppRssiFilterKind_c);
                 KEYFOB_MGR_notify(KEYFOB_EVENT_BLE_DISCONNECTED);
             }
 
@@ -485,11 +492,14 @@ void BleApp_StateMachineHandler(deviceId_t peerDeviceId, appEvent_t event)
             {
                 if(mGapRole == gGapCentral_c)
                 {
+                    (void)App_NvmFlushSystemParams(TRUE);
+                    App_CountersCompact(gAppCounterCompactShutdown_c);
                     HAL_ResetMCU();
                 }
                 else
                 {
                     TRACE_INFO("Reset GAP context");
+                    BleApp_StopRssiSensing(peerDeviceId);
                     maPeerInformation[peerDeviceId].deviceId = gInvalidDeviceId_c;
                     maPeerInformation[peerDeviceId].appState = mAppIdle_c;
                 }
@@ -544,6 +554,8 @@ void BleApp_StateMachineHandler(deviceId_t peerDeviceId, appEvent_t event)
         }
         break;
     }
+
+    App_TraceEvent(gAppTraceFsm_c, ((uint32_t)peerDeviceId << 16) | (uint32_t)maPeerInformation[peerDeviceId].appState, (uint32_t)event);
 }
 
 /*!*************************************************************************************************
@@ -562,6 +574,8 @@ void APP_BleEventHandler(void *pData)
     {
         case mAppEvt_Shell_Reset_Command_c:
         {
+            (void)App_NvmFlushSystemParams(TRUE);
+            App_CountersCompact(gAppCounterCompactShutdown_c);
             HAL_ResetMCU();
         }
         break;
@@ -624,6 +638,22 @@ void APP_BleEventHandler(void *pData)
         }
         break;
 
+        case mAppEvt_Shell_SetCredential_Command_c:
+        {
+            cccCredentialData_t *pCredential = (cccCredentialData_t *)pEventData->eventData.pData;
+
+            if (CCC_CredentialsSet((cccCredentialId_t)pCredential->id, pCredential->aValue) == TRUE)
+            {
+                TRACE_INFO("CCC credential %u provisioned, 0x%x", pCredential->id, CCC_CredentialsPresent());
+            }
+            else
+            {
+                TRACE_ERROR("CCC credential %u not valid or not saved", pCredential->id);
+            }
+            FLib_MemSet(pCredential->aValue, 0x00, sizeof(pCredential->aValue));
+        }
+        break;
+
 #endif /* gAppUseShellInApplication_d */
 
         case mAppEvt_KBD_EventPressPB1_c:
@@ -711,7 +741,21 @@ void APP_BleEventHandler(void *pData)
 
         case mAppEvt_Read_Rssi_c:
         {
-            BleApp_StateMachineHandler(pEventData->eventData.peerDeviceId, mAppEvt_Read_Rssi_c);
+            /* One tick samples every connected vehicle */
+            for (uint8_t peerId = 0U; peerId < (uint8_t)gAppMaxConnections_c; peerId++)
+            {
+                if ((maPeerInformation[peerId].deviceId != gInvalidDeviceId_c) &&
+                    (maPeerInformation[peerId].rssiSource == mAppRssiTimer_c))
+                {
+                    BleApp_StateMachineHandler(peerId, mAppEvt_Read_Rssi_c);
+                }
+            }
+            break;
+        }
+
+        case mAppEvt_Rke_Timeout_c:
+        {
+            BleApp_RkeHandleTimeout();
             break;
         }
 
@@ -722,7 +766,7 @@ void APP_BleEventHandler(void *pData)
         break;
     }
     
-    (void)MEM_BufferFree(pData);
+    App_EventFree(pData);
     pData = NULL;
     
 }
@@ -773,19 +817,299 @@ gUWBState_t GetUWBState(void)
 *************************************************************************************
 ************************************************************************************/
 /*! *********************************************************************************
-* \brief        Start RSSI reading.
+* \brief        Reads the vehicle Database Hash characteristic.
 *
+* \param[in]    peerDeviceId        Peer device ID.
 ************************************************************************************/
-static void BleApp_StartRssiSensing(void)
+static void BleApp_ReadDatabaseHash(deviceId_t peerDeviceId)
+{
+    bleUuid_t hashCharUuid;
+    gattHandleRange_t handleRange;
+
+    hashCharUuid.uuid16 = (uint16_t)gBleSig_GattDatabaseHash_d;
+    handleRange.startHandle = 0x0001U;
+    handleRange.endHandle = 0xFFFFU;
+    mCurrentCharReadingIndex = mcCharDatabaseHashIndex_c;
+    (void)GattClient_ReadUsingCharacteristicUuid(peerDeviceId,
+                                                 gBleUuidType16_c,
+                                                 &hashCharUuid,
+                                                 &handleRange,
+                                                 maOutCharReadBuffer,
+                                                 mCharReadBufferLength_c,
+                                                 &mOutCharReadByteCount);
+}
+
+/*! *********************************************************************************
+* \brief        Uses the DK handles cached for this bond if the vehicle Database Hash
+*               still matches, otherwise discovers the DK service again.
+*
+* \param[in]    peerDeviceId        Peer device ID.
+* \param[in]    pHash               Database Hash read from the vehicle, NULL if the
+*                                   vehicle does not expose it.
+************************************************************************************/
+static void BleApp_HandleDatabaseHash(deviceId_t peerDeviceId, const uint8_t *pHash)
+{
+    appCustomInfo_t *pInfo = &maPeerInformation[peerDeviceId].customInfo;
+    bleUuid_t dkServiceUuid;
+
+    mCurrentCharReadingIndex = mcCharVehiclePsmIndex_c;
+
+    if ((pHash != NULL) && (pInfo->dbHashValid == TRUE) &&
+        (pInfo->hPsmChannelChar != gGattDbInvalidHandle_d) &&
+        FLib_MemCmp(pHash, pInfo->aDbHash, gGattDatabaseHashSize_c))
+    {
+        TRACE_INFO("DK handle cache hit");
+        App_LatencyMark(peerDeviceId, mLatencyDkHandles_c);
+
+        maCharacteristics[mcCharVehiclePsmIndex_c].value.handle = pInfo->hPsmChannelChar;
+        maCharacteristics[mcCharVehiclePsmIndex_c].value.maxValueLength = mcCharVehiclePsmLength_c;
+        maCharacteristics[mcCharVehiclePsmIndex_c].value.paValue = mValVehiclePsm;
+        maCharacteristics[mcCharVehicleAntennaIdIndex_c].value.handle = pInfo->hAntennaIdChar;
+        maCharacteristics[mcCharVehicleAntennaIdIndex_c].value.maxValueLength = mcCharVehicleAntennaIdLength_c;
+        maCharacteristics[mcCharVehicleAntennaIdIndex_c].value.paValue = (uint8_t *)&mValVehicleAntennaId;
+        maCharacteristics[mcCharTxPowerLevelIndex_c].value.handle = pInfo->hTxPowerChar;
+        maCharacteristics[mcCharTxPowerLevelIndex_c].value.maxValueLength = mcCharTxPowerLevelLength_c;
+        maCharacteristics[mcCharTxPowerLevelIndex_c].value.paValue = (uint8_t *)&mValTxPower;
+
+        /* Read SPSM from vehicle, by handle */
+        (void)GattClient_ReadCharacteristicValue(peerDeviceId, &maCharacteristics[mcCharVehiclePsmIndex_c], mcCharVehiclePsmLength_c);
+    }
+    else if ((pHash == NULL) && (pInfo->hPsmChannelChar != gGattDbInvalidHandle_d))
+    {
+        /* Nothing to validate the cache against, locate the SPSM by UUID */
+        pInfo->dbHashValid = FALSE;
+        BleApp_ReadPsmUsingUuid(peerDeviceId);
+    }
+    else
+    {
+        if (pHash != NULL)
+        {
+            FLib_MemCpy(pInfo->aDbHash, pHash, gGattDatabaseHashSize_c);
+            pInfo->dbHashValid = TRUE;
+        }
+        else
+        {
+            pInfo->dbHashValid = FALSE;
+        }
+
+        if (pInfo->hPsmChannelChar != gGattDbInvalidHandle_d)
+        {
+            TRACE_INFO("DK handle cache stale, discovering");
+        }
+        pInfo->hDkService = gGattDbInvalidHandle_d;
+        pInfo->hPsmChannelChar = gGattDbInvalidHandle_d;
+        pInfo->hAntennaIdChar = gGattDbInvalidHandle_d;
+        pInfo->hTxPowerChar = gGattDbInvalidHandle_d;
+
+        /* Start Service Discovery */
+        dkServiceUuid.uuid16 = gBleSig_CCC_DK_UUID_d;
+        (void)BleServDisc_FindService(peerDeviceId, gBleUuidType16_c, &dkServiceUuid);
+    }
+}
+
+#if defined(gAppUseBonding_d) && (gAppUseBonding_d)
+/*! *********************************************************************************
+* \brief        Saves the DK handle cache and its Database Hash with the bond.
+*
+* \details      On failure the bond keeps its previous record, or none: it is
+*               checked against the vehicle Database Hash on the next connection
+*               like any other, and the DK service is discovered again if stale.
+*
+* \param[in]    peerDeviceId        Peer device ID.
+************************************************************************************/
+static void BleApp_SaveCustomInfo(deviceId_t peerDeviceId)
+{
+    bleResult_t status;
+
+    status = Gap_SaveCustomPeerInformation(peerDeviceId,
+                                           (void *)&maPeerInformation[peerDeviceId].customInfo, 0,
+                                           (uint16_t)sizeof(appCustomInfo_t));
+    if (status != gBleSuccess_c)
+    {
+        TRACE_ERROR("DK handle cache not saved: 0x%04x", status);
+    }
+}
+#endif
+
+/*! *********************************************************************************
+* \brief        Reads the vehicle SPSM characteristic by UUID.
+*
+* \param[in]    peerDeviceId        Peer device ID.
+************************************************************************************/
+static void BleApp_ReadPsmUsingUuid(deviceId_t peerDeviceId)
+{
+    bleUuid_t psmCharUuid;
+    gattHandleRange_t handleRange;
+
+    FLib_MemCpy(psmCharUuid.uuid128, uuid_char_vehicle_psm, gcBleLongUuidSize_c);
+    handleRange.startHandle = 0x0001U;
+    handleRange.endHandle = 0xFFFFU;
+    mCurrentCharReadingIndex = mcCharVehiclePsmIndex_c;
+    (void)GattClient_ReadUsingCharacteristicUuid(peerDeviceId,
+                                                 gBleUuidType128_c,
+                                                 &psmCharUuid,
+                                                 &handleRange,
+                                                 maOutCharReadBuffer,
+                                                 mCharReadBufferLength_c,
+                                                 &mOutCharReadByteCount);
+}
+
+/*! *********************************************************************************
+* \brief        Start RSSI reading of a vehicle. The controller reports the RSSI of
+*               the packets received in each connection event; the RSSI timer and
+*               Gap_ReadRssi are only used if it refuses the notification.
+*
+* \param[in]    peerDeviceId        Peer device ID.
+************************************************************************************/
+static void BleApp_StartRssiSensing(deviceId_t peerDeviceId)
 {
     timer_status_t tmrStatus;
 
-    TM_Close(rssiTmrId);
-    tmrStatus = TM_Open(rssiTmrId);
-    if (tmrStatus == kStatus_TimerSuccess)
+    maPeerInformation[peerDeviceId].rssiActiveCount = 0U;
+#if defined(gAppRssiFromConnEvents_d) && (gAppRssiFromConnEvents_d == 1)
+    if (gBleSuccess_c == Gap_ControllerEnhancedNotification(gAppCtrlNotifDefault_c | (uint32_t)gNotifConnRxPdu_c,
+                                                            maPeerInformation[peerDeviceId].deviceId))
     {
-        (void)TM_InstallCallback((timer_handle_t)rssiTmrId, BleApp_RssiTimeoutTimerCallback, NULL);
-        (void)TM_Start((timer_handle_t)rssiTmrId, (uint8_t)kTimerModeSetMicrosTimer, mcRssiTimeoutInMicroseconds);
+        maPeerInformation[peerDeviceId].rssiEventCounter = 0xFFFFU;
+        maPeerInformation[peerDeviceId].rssiSource = mAppRssiConnEvent_c;
+    }
+    else
+#endif /* gAppRssiFromConnEvents_d */
+    {
+        maPeerInformation[peerDeviceId].rssiSource = mAppRssiTimer_c;
+        TM_Close(rssiTmrId);
+        tmrStatus = TM_Open(rssiTmrId);
+        if (tmrStatus == kStatus_TimerSuccess)
+        {
+            (void)TM_InstallCallback((timer_handle_t)rssiTmrId, BleApp_RssiTimeoutTimerCallback, NULL);
+            (void)TM_Start((timer_handle_t)rssiTmrId, (uint8_t)kTimerModeSetMicrosTimer, mcRssiTimeoutInMicroseconds);
+        }
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Stop RSSI reading of a vehicle.
+*
+* \param[in]    peerDeviceId        Peer device ID.
+************************************************************************************/
+static void BleApp_StopRssiSensing(deviceId_t peerDeviceId)
+{
+    bool_t timerInUse = FALSE;
+
+    if ((maPeerInformation[peerDeviceId].rssiSource == mAppRssiConnEvent_c) &&
+        (maPeerInformation[peerDeviceId].deviceId != gInvalidDeviceId_c))
+    {
+        (void)Gap_ControllerEnhancedNotification(gAppCtrlNotifDefault_c, maPeerInformation[peerDeviceId].deviceId);
+    }
+    maPeerInformation[peerDeviceId].rssiSource = mAppRssiOff_c;
+
+    /* The RSSI timer is shared, stopped with its last vehicle */
+    for (uint8_t peerId = 0U; peerId < (uint8_t)gAppMaxConnections_c; peerId++)
+    {
+        if (maPeerInformation[peerId].rssiSource == mAppRssiTimer_c)
+        {
+            timerInUse = TRUE;
+        }
+    }
+    if (timerInUse == FALSE)
+    {
+        TM_Close(rssiTmrId);
+    }
+}
+
+/*! *********************************************************************************
+* \brief        RSSI of a packet received from a vehicle, from the controller
+*               connection event notification. Called on the application task.
+*
+* \param[in]    peerDeviceId        Peer device ID.
+* \param[in]    rssi                RSSI of the packet, dBm.
+* \param[in]    eventCounter        Connection event counter.
+********************************************************************************** */
+void BleApp_HandleConnEventRssi(deviceId_t peerDeviceId, int8_t rssi, uint16_t eventCounter)
+{
+    if ((peerDeviceId < gAppMaxConnections_c) &&
+        (maPeerInformation[peerDeviceId].rssiSource == mAppRssiConnEvent_c) &&
+        (maPeerInformation[peerDeviceId].rssiEventCounter != eventCounter))
+    {
+        /* One sample per connection event, the filter and the intent timings
+           count connection intervals */
+        maPeerInformation[peerDeviceId].rssiEventCounter = eventCounter;
+        BleApp_HandleRssiSample(peerDeviceId, rssi);
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Feeds an RSSI sample to the intent state of a vehicle. No buffer is
+*               allocated, only an intent change sends a message.
+*
+* \param[in]    peerDeviceId        Peer device ID.
+* \param[in]    rssi                RSSI, dBm.
+********************************************************************************** */
+static void BleApp_HandleRssiSample(deviceId_t peerDeviceId, int8_t rssi)
+{
+    appRssiIntent_t *pRssiIntent = &maPeerInformation[peerDeviceId].rssiIntent;
+    systemParameters_t *pSysParams = NULL;
+    dkSubEventDeviceRangingIntentType_t eRangingType;
+    appRssiIntentParams_t params;
+#if (defined(gAppRssiMotionFusion_d) && (gAppRssiMotionFusion_d == 1)) && !defined(BMW_KEYFOB_EVK_BOARD)
+    appRssiMotionInput_t motion;
+#endif
+    appIntent_t intent;
+
+    App_NvmReadSystemParams(&pSysParams);
+    maPeerInformation[peerDeviceId].temperatureCount++;
+    maPeerInformation[peerDeviceId].rssiActiveCount++;
+    if((maPeerInformation[peerDeviceId].rssiActiveCount >= mcMaxTemperatureCount((pSysParams->system_params).fields.rssi_on_duration * 1000,
+       (pSysParams->system_params).fields.connection_interval)))
+    {
+        BleApp_StopRssiSensing(peerDeviceId);
+    }
+    /* Filtered value and intent are updated on every sample of this
+       vehicle, the first gAppRssiSettleSamples_c settle the filter */
+    if(rssi != gGapRssiNotAvailable_d)
+    {
+        BleApp_GetRssiIntentParams(&params);
+#if (defined(gAppRssiMotionFusion_d) && (gAppRssiMotionFusion_d == 1)) && !defined(BMW_KEYFOB_EVK_BOARD)
+        /* Written by the motion sensor interrupts, single word reads */
+        motion.walking = in_motion;
+        motion.stepCount = total_step_count;
+        intent = App_RssiIntentUpdate(pRssiIntent, rssi, &params, &motion);
+#else
+        intent = App_RssiIntentUpdate(pRssiIntent, rssi, &params, NULL);
+#endif
+        App_DiagUpdate(gAppDiagRssi_c, (int32_t)rssi);
+        App_DiagUpdate(gAppDiagFilteredRssi_c, (int32_t)pRssiIntent->filteredRssi);
+        if(intent != App_Undefined)
+        {
+            App_DiagUpdate(gAppDiagIntent_c, (int32_t)intent);
+            switch(intent)
+            {
+            case App_LowIntent:
+                eRangingType = gLowApproachConfidence_c;
+                break;
+
+            case App_MediumIntent:
+                eRangingType = gMediumApproachConfidence_c;
+                break;
+
+            default:
+                eRangingType = gHighApproachConfidence_c;
+                break;
+            }
+            CCC_SendRangingIntentSubEvent(peerDeviceId,
+                                          gDeviceRangingIntent_c,
+                                          eRangingType);
+            TRACE_DEBUG("RSSI_0 = %d dBm", pRssiIntent->rssi0);
+            TRACE_DEBUG("RSSI Measured = %d dBm", pRssiIntent->filteredRssi);
+        }
+        else
+        {
+            /* For MISRA compliance */
+        }
+    }
+    else
+    {
+        /* For MISRA compliance */
     }
 }
 
@@ -799,47 +1123,159 @@ static void BleApp_RssiTimeoutTimerCallback(void* pParam)
 {
     if(mpfBleEventHandler != NULL)
     {
-        appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+        appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
         if(pEventData != NULL)
         {
             pEventData->appEvent = mAppEvt_Read_Rssi_c;
             if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
             {
-                (void)MEM_BufferFree(pEventData);
+                App_EventFree(pEventData);
             }
         }
     }
 }
 
 /*! *********************************************************************************
-* \brief        Decide new intent according to new rssi, old rssi and old intent.
+* \brief        Queues an RKE action for a vehicle and sends it if none is in flight.
 *
-* \param[in]    newFilteredRssi      new filtered rssi value
-* \param[in]    Rssi0                first filtered rssi value
+* \param[in]    deviceId            vehicle device ID
+* \param[in]    function            RKE function
+* \param[in]    action              RKE action
 ********************************************************************************** */
-static appIntent_t BleApp_DecideIntentFromRSSI(int8_t newFilteredRssi, int8_t rssi0)
+static void BleApp_RkeRequest(deviceId_t deviceId, gDkRKEFunctionId_t function, uint8_t action)
 {
-    appIntent_t intent;
-    systemParameters_t *pSysParams = NULL;
+    appRkeStatus_t status = App_RkePress(deviceId, (uint16_t)function, action);
 
-    App_NvmReadSystemParams(&pSysParams);
-    if(newFilteredRssi >= (rssi0 + (pSysParams->system_params).fields.delta_rssi_high))
+    if (status == gAppRkeDispatch_c)
     {
-        intent = App_HighIntent;
+        BleApp_RkeSendInFlight(deviceId);
     }
-    else if(newFilteredRssi >= (rssi0 + (pSysParams->system_params).fields.delta_rssi_medium))
+    else if (status == gAppRkeQueued_c)
     {
-        intent = App_MediumIntent;
+        TRACE_INFO("RKE action queued");
     }
-    else if(newFilteredRssi >= (rssi0 + (pSysParams->system_params).fields.delta_rssi_low))
+    else if (status == gAppRkeCoalesced_c)
     {
-        intent = App_LowIntent;
+        TRACE_INFO("RKE action already pending");
+    }
+    else if (status == gAppRkeQueueFull_c)
+    {
+        TRACE_ERROR("RKE queue full, action dropped");
     }
     else
     {
-        intent = App_Undefined;
+        ; /* For MISRA compliance */
     }
-    return intent;
+}
+
+/*! *********************************************************************************
+* \brief        Sends the RKE Request SubEvent of the action in flight and starts
+*               the timeout supervision.
+*
+* \param[in]    deviceId            vehicle device ID
+********************************************************************************** */
+static void BleApp_RkeSendInFlight(deviceId_t deviceId)
+{
+    uint16_t function;
+    uint8_t action;
+    timer_status_t tmrStatus;
+
+    if (App_RkeGetInFlight(deviceId, &function, &action) == TRUE)
+    {
+        /* Remembered for the RKE_Auth_RQ signature */
+        maPeerInformation[deviceId].customInfo.functionId = function;
+        maPeerInformation[deviceId].customInfo.actionId = action;
+        if (CCC_SendRKERequestSubEvent(deviceId, (gDkRKEFunctionId_t)function, action) == gBleSuccess_c)
+        {
+            App_RkeMarkSent(deviceId);
+        }
+
+        /* A failed send leaves the deadline unset: App_RkeCheckTimeout() resends on the next tick */
+        TM_Close(rkeTmrId);
+        tmrStatus = TM_Open(rkeTmrId);
+        if (tmrStatus == kStatus_TimerSuccess)
+        {
+            (void)TM_InstallCallback((timer_handle_t)rkeTmrId, BleApp_RkeTimeoutTimerCallback, NULL);
+            (void)TM_Start((timer_handle_t)rkeTmrId, (uint8_t)kTimerModeIntervalTimer, gAppRkeTickMs_c);
+        }
+    }
+}
+
+/*! *********************************************************************************
+* \brief        RKE supervision timer callback.
+                Called on timer task.
+*
+* \param[in]    pParam              not used
+********************************************************************************** */
+static void BleApp_RkeTimeoutTimerCallback(void* pParam)
+{
+    if(mpfBleEventHandler != NULL)
+    {
+        appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
+        if(pEventData != NULL)
+        {
+            pEventData->appEvent = mAppEvt_Rke_Timeout_c;
+            if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
+            {
+                App_EventFree(pEventData);
+            }
+        }
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Resends or drops the RKE actions whose acknowledgement is late.
+*
+********************************************************************************** */
+static void BleApp_RkeHandleTimeout(void)
+{
+    deviceId_t deviceId;
+    appRkeStatus_t status;
+
+    for (deviceId = 0U; deviceId < (deviceId_t)gAppMaxConnections_c; deviceId++)
+    {
+        status = App_RkeCheckTimeout(deviceId);
+        if (status == gAppRkeResend_c)
+        {
+            TRACE_INFO("RKE acknowledgement timeout, resending");
+            BleApp_RkeSendInFlight(deviceId);
+        }
+        else if (status == gAppRkeDispatch_c)
+        {
+            TRACE_ERROR("RKE action dropped after retries");
+            BleApp_RkeSendInFlight(deviceId);
+        }
+        else
+        {
+            ; /* For MISRA compliance */
+        }
+    }
+
+    if (App_RkeIsBusy() == FALSE)
+    {
+        TM_Close(rkeTmrId);
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Fills the intent thresholds from the system parameters.
+*
+* \param[out]   pParams              intent thresholds
+********************************************************************************** */
+static void BleApp_GetRssiIntentParams(appRssiIntentParams_t *pParams)
+{
+    systemParameters_t *pSysParams = NULL;
+
+    App_NvmReadSystemParams(&pSysParams);
+    pParams->rssiIntentHigh = (pSysParams->system_params).fields.rssi_intent_high;
+    pParams->deltaLow = (pSysParams->system_params).fields.delta_rssi_low;
+    pParams->deltaMedium = (pSysParams->system_params).fields.delta_rssi_medium;
+    pParams->deltaHigh = (pSysParams->system_params).fields.delta_rssi_high;
+    /* timeout_between_same_intents = 0: an unchanged intent is sent once */
+    pParams->repeatSameIntent = ((pSysParams->system_params).fields.timeout_between_same_intents != 0U) ? TRUE : FALSE;
+    pParams->sameIntentSamples = mcMaxSameIntentsCount((pSysParams->system_params).fields.timeout_between_same_intents * 1000,
+                                                       (pSysParams->system_params).fields.connection_interval,
+                                                       1U);
 }
 
 /*! *********************************************************************************
@@ -869,12 +1305,20 @@ static void BleApp_LogTimeoutTimerCallback(void* pParam)
 {
 	temperature_value = Get_Ms_Temp_Value();
 	battery_level = SENSORS_GetBatteryLevel();
+#if defined(gAppDiagStream_d) && (gAppDiagStream_d == 1)
+    (void)pParam;
+    App_DiagUpdate(gAppDiagTemperature_c, (int32_t)temperature_value);
+    App_DiagUpdate(gAppDiagBattery_c, (int32_t)battery_level);
+    App_DiagUpdate(gAppDiagStepCount_c, (int32_t)total_step_count);
+#else
 	/************************ONLY FOR TESTING PURPOSES: IT VIOLATES THE CCC STANDARD***********************/
     /* Sending the temperature value */
     BleApp_SendPacketToCarAnchor(mCurrentPeerId);
     /******************************************************************************************************/
+#endif /* gAppDiagStream_d */
 }
 
+#if !defined(gAppDiagStream_d) || (gAppDiagStream_d == 0)
 /*! *********************************************************************************
 * \brief        Sends packet to car anchor.
 *
@@ -891,11 +1335,11 @@ static void BleApp_SendPacketToCarAnchor(deviceId_t deviceId)
     App_NvmReadSystemParams(&pSysParams);
     pPacket[packetLength++] = gDKMessageTypeLogMessage_c;
     pPacket[packetLength++] = App_Rssi0Id;
-    pPacket[packetLength++] = sizeof(mRssi0);
-    pPacket[packetLength++] = mRssi0;
+    pPacket[packetLength++] = sizeof(int8_t);
+    pPacket[packetLength++] = (uint8_t)maPeerInformation[deviceId].rssiIntent.rssi0;
     pPacket[packetLength++] = App_FilteredRssiId;
-    pPacket[packetLength++] = sizeof(mNewFilteredRssi);
-    pPacket[packetLength++] = mNewFilteredRssi;
+    pPacket[packetLength++] = sizeof(int8_t);
+    pPacket[packetLength++] = (uint8_t)maPeerInformation[deviceId].rssiIntent.filteredRssi;
     pPacket[packetLength++] = App_TemperatureId;
     pPacket[packetLength++] = sizeof(temperature_value);
     pPacket[packetLength++] = temperature_value;
@@ -915,10 +1359,11 @@ static void BleApp_SendPacketToCarAnchor(deviceId_t deviceId)
     pPacket[packetLength++] = sizeof(uint32_t);
     memcpy(&pPacket[packetLength++], pSysParams->system_params.buffer, 40);
     L2ca_SendLeCbData(deviceId,
-                      maPeerInformation[deviceId].customInfo.psmChannelId,
+                      App_DkChannelFor(deviceId, gDKMessageTypeLogMessage_c, mcPacketMaxPayloadSize),
 					  pPacket,
 					  mcPacketMaxPayloadSize);
 }
+#endif /* gAppDiagStream_d */
 
 /*! *********************************************************************************
 * \brief        Switch GAP Role.
@@ -931,7 +1376,6 @@ static void BleApp_SwitchGapRole(appEventData_t *pEventData)
     {
     	App_NvmWriteSystemParam(MsStepInScanID, step_while_scan);
     	App_NvmWriteSystemParam(MsStepOutScanID, step_without_scan);
-    	App_NvmWriteSystemParam(MsTotalStepID, total_step_count);
     	App_NvmWriteSystemParam(MsStillDetectedID, still_detected_count);
     	App_NvmWriteSystemParam(TemperatureID, Get_Ms_Temp_Value());
     	App_NvmWriteSystemParam(BatteryLevelID, SENSORS_GetBatteryLevel());
@@ -1044,13 +1488,9 @@ static void BleApp_HandlePreIdleState(deviceId_t peerDeviceId, appEvent_t event)
         }
         if(event == mAppEvt_PeerDisconnected_c)
         {
+            BleApp_StopRssiSensing(peerDeviceId);
             maPeerInformation[peerDeviceId].deviceId = gInvalidDeviceId_c;
-            mRssi0 = 0;
-            mValidRssi0 = false;
-            mRssiCounter = 0;
-            mRssiSum = 0;
-            mLastIntent = App_Undefined;
-            mSameIntentCount = 0;
+            App_RssiIntentReset(&maPeerInformation[peerDeviceId].rssiIntent, gAppRssiFilterKind_c);
         }
         /* Re-initialise the ble state machine in the mAppIdle_c state */
         maPeerInformation[peerDeviceId].appState = mAppIdle_c;
@@ -1103,24 +1543,12 @@ static void BleApp_HandleIdleState(deviceId_t peerDeviceId, appEvent_t event)
     else if ( event == mAppEvt_EncryptionChanged_c )
     {
     	TRACE_INFO("------------------------> mAppEvt_EncryptionChanged_c");
-        bleUuid_t psmCharUuid;
-        gattHandleRange_t handleRange;
         
         /* Moving to Service Discovery State*/
         maPeerInformation[peerDeviceId].appState = mAppServiceDisc_c;
         
-        /* Read SPSM from vehicle. */
-        FLib_MemCpy(psmCharUuid.uuid128, uuid_char_vehicle_psm, gcBleLongUuidSize_c);
-        handleRange.startHandle = 0x0001U;
-        handleRange.endHandle = 0xFFFFU;
-        mCurrentCharReadingIndex = mcCharVehiclePsmIndex_c;
-        (void)GattClient_ReadUsingCharacteristicUuid(peerDeviceId,
-                                                    gBleUuidType128_c,
-                                                    &psmCharUuid,
-                                                    &handleRange,
-                                                    maOutCharReadBuffer,
-                                                    mCharReadBufferLength_c,
-                                                    &mOutCharReadByteCount);
+        /* Handles of this bond are reused if the vehicle database did not change */
+        BleApp_ReadDatabaseHash(peerDeviceId);
     }
     else if ( event == mAppEvt_AuthenticationRejected_c )
     {
@@ -1147,12 +1575,14 @@ static void BleApp_HandleServiceDiscState(deviceId_t peerDeviceId, appEvent_t ev
 {
     if (event == mAppEvt_ReadCharacteristicValueComplete_c)
     {
-        (void)L2ca_ConnectLePsm((uint16_t)Utils_BeExtractTwoByteValue(maCharacteristics[mcCharVehiclePsmIndex_c].value.paValue),
-                                peerDeviceId, mAppLeCbInitialCredits_c);
+        (void)App_DkChannelsOpen(peerDeviceId,
+                                 (uint16_t)Utils_BeExtractTwoByteValue(maCharacteristics[mcCharVehiclePsmIndex_c].value.paValue),
+                                 mAppLeCbInitialCredits_c);
     }
 
     if (event == mAppEvt_PsmChannelCreated_c)
     {
+        App_LatencyMark(peerDeviceId, mLatencyPsmChannel_c);
 /*#if defined(mcConnectionwithRealVehicle) && (mcConnectionwithRealVehicle == 1)
     	maPeerInformation[peerDeviceId].isBonded = TRUE;
 #endif*/
@@ -1191,7 +1621,7 @@ static void BleApp_HandleServiceDiscState(deviceId_t peerDeviceId, appEvent_t ev
             doCommands();
             if((pSysParams->system_params).fields.rssi_on_duration != 0)
             {
-                BleApp_StartRssiSensing();
+                BleApp_StartRssiSensing(peerDeviceId);
             }
         }
         else
@@ -1211,6 +1641,14 @@ static void BleApp_HandleServiceDiscState(deviceId_t peerDeviceId, appEvent_t ev
         if(mGapRole == gGapCentral_c)
         {
             maPeerInformation[peerDeviceId].appState = mAppServiceDisc_c;
+            App_LatencyMark(peerDeviceId, mLatencyDkHandles_c);
+#if defined(gAppUseBonding_d) && (gAppUseBonding_d)
+            if (maPeerInformation[peerDeviceId].isBonded)
+            {
+                /* Handle cache of an existing bond, new bonds are saved on pairing */
+                BleApp_SaveCustomInfo(peerDeviceId);
+            }
+#endif
         }
         else
         {
@@ -1253,13 +1691,14 @@ static void BleApp_HandlePairState(deviceId_t peerDeviceId, appEvent_t event)
     {
         uint64_t devEvtCnt = 0U;
         systemParameters_t *pSysParams = NULL;
+        App_LatencyMark(peerDeviceId, mLatencyPairingComplete_c);
         App_NvmReadSystemParams(&pSysParams);
         FLib_MemSet(&maPeerInformation[peerDeviceId].oobData, 0x00, sizeof(gapLeScOobData_t));
         FLib_MemSet(&maPeerInformation[peerDeviceId].peerOobData, 0x00, sizeof(gapLeScOobData_t));
         maPeerInformation[peerDeviceId].appState = mAppRunning_c;
         if((pSysParams->system_params).fields.rssi_on_duration != 0)
         {
-            BleApp_StartRssiSensing();
+            BleApp_StartRssiSensing(peerDeviceId);
         }
         TRACE_INFO("Pairing successful.");
         /* Update UI */
@@ -1274,9 +1713,7 @@ static void BleApp_HandlePairState(deviceId_t peerDeviceId, appEvent_t event)
         TRACE_DEBUG("Battery level : %d%%",SENSORS_GetBatteryLevel());
 #if defined(gAppUseBonding_d) && (gAppUseBonding_d)
         /* Write data in NVM */
-        (void)Gap_SaveCustomPeerInformation(peerDeviceId,
-                                            (void *)&maPeerInformation[peerDeviceId].customInfo, 0,
-                                            (uint16_t)sizeof(appCustomInfo_t));
+        BleApp_SaveCustomInfo(peerDeviceId);
 #endif
         /* Update connection interval to CCC recommended value */
         (void)Gap_UpdateConnectionParameters(peerDeviceId,
@@ -1305,8 +1742,10 @@ static void App_HandleL2capPsmControlCallback(appEventData_t *pEventData)
         case mAppEvt_L2capPsmControlCallback_LePsmConnectionComplete_c:
         {
             l2caLeCbConnectionComplete_t *pConnComplete = pEventData->eventData.pData;
+            uint8_t slot = App_DkChannelsConnected(pConnComplete->deviceId, pConnComplete->cId,
+                                                   (pConnComplete->result == gSuccessful_c) ? TRUE : FALSE);
 
-            if (pConnComplete->result == gSuccessful_c)
+            if ((pConnComplete->result == gSuccessful_c) && (slot == 0U))
             {
                 /* Handle Conn Complete */
                 TRACE_INFO("L2CAP PSM Connection Complete.");
@@ -1315,14 +1754,24 @@ static void App_HandleL2capPsmControlCallback(appEventData_t *pEventData)
                 /* Move to Time Sync */
                 BleApp_StateMachineHandler(maPeerInformation[pConnComplete->deviceId].deviceId, mAppEvt_PsmChannelCreated_c);
             }
+            else if (pConnComplete->result == gSuccessful_c)
+            {
+                TRACE_INFO("L2CAP PSM channel %d open.", slot);
+            }
+            else
+            {
+                TRACE_INFO("L2CAP PSM channel %d refused.", slot);
+            }
             break;
         }
 
         case mAppEvt_L2capPsmControlCallback_LePsmDisconnectNotification_c:
         {
-            TRACE_INFO("L2CAP PSM disconnected. Reconnecting...");
-            (void)L2ca_ConnectLePsm((uint16_t)Utils_BeExtractTwoByteValue(maCharacteristics[mcCharVehiclePsmIndex_c].value.paValue),
-                                        pEventData->eventData.peerDeviceId, mAppLeCbInitialCredits_c);
+            l2caLeCbDisconnection_t *pDisconnection = pEventData->eventData.pData;
+
+            /* The channel is requested again by App_DkChannelsDisconnected */
+            TRACE_INFO("L2CAP PSM channel %d disconnected. Reconnecting...",
+                       App_DkChannelsDisconnected(pDisconnection->deviceId, pDisconnection->cId));
             break;
         }
 
@@ -1360,9 +1809,7 @@ static void App_HandleKeys(appEventData_t *pEventData)
                 if (maPeerInformation[pEventData->eventData.peerDeviceId].appState == mAppRunning_c)
                 {
                     TRACE_INFO("Locking ...");
-                    maPeerInformation[pEventData->eventData.peerDeviceId].customInfo.functionId = gCentralLocking_c;
-                    maPeerInformation[pEventData->eventData.peerDeviceId].customInfo.actionId = gLock_c;
-                    CCC_SendRKERequestSubEvent(pEventData->eventData.peerDeviceId, gCentralLocking_c, gLock_c);
+                    BleApp_RkeRequest(pEventData->eventData.peerDeviceId, gCentralLocking_c, gLock_c);
                 }
                 else
                 {
@@ -1404,9 +1851,7 @@ static void App_HandleKeys(appEventData_t *pEventData)
                 if (maPeerInformation[pEventData->eventData.peerDeviceId].appState == mAppRunning_c)
                 {
                     TRACE_INFO("Unlocking ...");
-                    maPeerInformation[pEventData->eventData.peerDeviceId].customInfo.functionId = gCentralLocking_c;
-                    maPeerInformation[pEventData->eventData.peerDeviceId].customInfo.actionId = gUnlock_c;
-                    CCC_SendRKERequestSubEvent(pEventData->eventData.peerDeviceId, gCentralLocking_c, gUnlock_c);
+                    BleApp_RkeRequest(pEventData->eventData.peerDeviceId, gCentralLocking_c, gUnlock_c);
                 }
                 else
                 {
@@ -1433,9 +1878,7 @@ static void App_HandleKeys(appEventData_t *pEventData)
                 if (maPeerInformation[pEventData->eventData.peerDeviceId].appState == mAppRunning_c)
                 {
                     TRACE_INFO("Releasing ...");
-                    maPeerInformation[pEventData->eventData.peerDeviceId].customInfo.functionId = gManualTrunkControl_c;
-                    maPeerInformation[pEventData->eventData.peerDeviceId].customInfo.actionId = gRelease_c;
-                    CCC_SendRKERequestSubEvent(pEventData->eventData.peerDeviceId, gManualTrunkControl_c, gRelease_c);
+                    BleApp_RkeRequest(pEventData->eventData.peerDeviceId, gManualTrunkControl_c, gRelease_c);
                 }
                 else
                 {
@@ -1473,9 +1916,7 @@ static void App_HandleRKECommands(appEventData_t *pEventData)
                 if (maPeerInformation[pEventData->eventData.peerDeviceId].appState == mAppRunning_c)
                 {
                     TRACE_INFO("Locking ...");
-                    maPeerInformation[pEventData->eventData.peerDeviceId].customInfo.functionId = gCentralLocking_c;
-                    maPeerInformation[pEventData->eventData.peerDeviceId].customInfo.actionId = gLock_c;
-                    CCC_SendRKERequestSubEvent(pEventData->eventData.peerDeviceId, gCentralLocking_c, gLock_c);
+                    BleApp_RkeRequest(pEventData->eventData.peerDeviceId, gCentralLocking_c, gLock_c);
                 }
                 else
                 {
@@ -1496,9 +1937,7 @@ static void App_HandleRKECommands(appEventData_t *pEventData)
                 if (maPeerInformation[pEventData->eventData.peerDeviceId].appState == mAppRunning_c)
                 {
                     TRACE_INFO("Unlocking ...");
-                    maPeerInformation[pEventData->eventData.peerDeviceId].customInfo.functionId = gCentralLocking_c;
-                    maPeerInformation[pEventData->eventData.peerDeviceId].customInfo.actionId = gUnlock_c;
-                    CCC_SendRKERequestSubEvent(pEventData->eventData.peerDeviceId, gCentralLocking_c, gUnlock_c);
+                    BleApp_RkeRequest(pEventData->eventData.peerDeviceId, gCentralLocking_c, gUnlock_c);
                 }
                 else
                 {
@@ -1520,9 +1959,7 @@ static void App_HandleRKECommands(appEventData_t *pEventData)
                 if (maPeerInformation[pEventData->eventData.peerDeviceId].appState == mAppRunning_c)
                 {
                     TRACE_INFO("Releasing ...");
-                    maPeerInformation[pEventData->eventData.peerDeviceId].customInfo.functionId = gManualTrunkControl_c;
-                    maPeerInformation[pEventData->eventData.peerDeviceId].customInfo.actionId = gRelease_c;
-                    CCC_SendRKERequestSubEvent(pEventData->eventData.peerDeviceId, gManualTrunkControl_c, gRelease_c);
+                    BleApp_RkeRequest(pEventData->eventData.peerDeviceId, gManualTrunkControl_c, gRelease_c);
                 }
                 else
                 {
@@ -1556,7 +1993,15 @@ static void App_HandleGattClientCallback(appEventData_t *pEventData)
 
         case mAppEvt_GattClientCallback_GattProcError_c:
         {
-            BleApp_StateMachineHandler(pEventData->eventData.peerDeviceId, mAppEvt_GattProcError_c);
+            if (mCurrentCharReadingIndex == mcCharDatabaseHashIndex_c)
+            {
+                /* Database Hash not supported by the vehicle */
+                BleApp_HandleDatabaseHash(pEventData->eventData.peerDeviceId, NULL);
+            }
+            else
+            {
+                BleApp_StateMachineHandler(pEventData->eventData.peerDeviceId, mAppEvt_GattProcError_c);
+            }
             break;
         }
 
@@ -1595,7 +2040,13 @@ static void App_HandleGattClientCallback(appEventData_t *pEventData)
             handleRange.startHandle = 0x0001U;
             handleRange.endHandle = 0xFFFFU;
 
-            if (mCurrentCharReadingIndex == mcCharVehiclePsmIndex_c)
+            if (mCurrentCharReadingIndex == mcCharDatabaseHashIndex_c)
+            {
+                /* length 1 octet, handle 2 octets, value 16 octets */
+                BleApp_HandleDatabaseHash(pEventData->eventData.peerDeviceId,
+                                          (mOutCharReadByteCount >= (3U + gGattDatabaseHashSize_c)) ? &maOutCharReadBuffer[3] : NULL);
+            }
+            else if (mCurrentCharReadingIndex == mcCharVehiclePsmIndex_c)
             {
                 maCharacteristics[mcCharVehiclePsmIndex_c].value.paValue = mValVehiclePsm;
                 /* length 1 octet, handle 2 octets, value(psm) 2 octets */
@@ -1818,8 +2269,6 @@ static void App_HandleGenericCallback(appEventData_t *pEventData)
 ********************************************************************************** */
 static void App_HandleConnectionCallback(appEventData_t *pEventData)
 {
-    appIntent_t intent;
-
     switch(pEventData->appEvent)
     {
         case mAppEvt_ConnectionCallback_ConnEvtConnected_c:
@@ -1831,7 +2280,12 @@ static void App_HandleConnectionCallback(appEventData_t *pEventData)
                  /* peerDeviceId bigger then gAppMaxConnections_c */ 
                  panic(0, (uint32_t)App_HandleConnectionCallback, 0, 0);
             }
-            
+            App_LatencyMark(pConnectedEventData->peerDeviceId, mLatencyConnected_c);
+            App_CounterAdd(gAppCounterConnections_c, 1U);
+            App_DkChannelsReset(pConnectedEventData->peerDeviceId);
+            App_RssiIntentReset(&maPeerInformation[pConnectedEventData->peerDeviceId].rssiIntent, gAppRssiFilterKind_c);
+            maPeerInformation[pConnectedEventData->peerDeviceId].temperatureCount = 0U;
+
             /* Save address used during discovery if controller privacy was used. */
             if (pConnectedEventData->pConnectedEvent.localRpaUsed)
             {
@@ -1872,10 +2326,15 @@ static void App_HandleConnectionCallback(appEventData_t *pEventData)
 
 #if defined(gAppUseBonding_d) && (gAppUseBonding_d)
             (void)Gap_CheckIfBonded(pConnectedEventData->peerDeviceId, &maPeerInformation[pConnectedEventData->peerDeviceId].isBonded, NULL);
-            if (maPeerInformation[pConnectedEventData->peerDeviceId].isBonded) /*&&
-                (gBleSuccess_c == Gap_LoadCustomPeerInformation(pConnectedEventData->peerDeviceId,
-                (void*)&maPeerInformation[pConnectedEventData->peerDeviceId].customInfo, 0, (uint16_t)sizeof (appCustomInfo_t))))*/
+            if (maPeerInformation[pConnectedEventData->peerDeviceId].isBonded)
             {
+                /* Handle cache of this bond, validated against the Database Hash once encrypted */
+                if (gBleSuccess_c != Gap_LoadCustomPeerInformation(pConnectedEventData->peerDeviceId,
+                                                                   (void*)&maPeerInformation[pConnectedEventData->peerDeviceId].customInfo, 0,
+                                                                   (uint16_t)sizeof(appCustomInfo_t)))
+                {
+                    maPeerInformation[pConnectedEventData->peerDeviceId].customInfo.dbHashValid = FALSE;
+                }
                 mRestoringBondedLink = TRUE;
                 volatile bleResult_t result1 = gBleSuccess_c;
                 /* Restored custom connection information. Encrypt link */
@@ -1889,6 +2348,10 @@ static void App_HandleConnectionCallback(appEventData_t *pEventData)
         case mAppEvt_ConnectionCallback_ConnEvtDisconnected_c:
         {
         	TM_Close(logTmrId);
+            App_LatencyClose(pEventData->eventData.peerDeviceId);
+            CCC_Spake2pReset(pEventData->eventData.peerDeviceId);
+            App_RkeReset(pEventData->eventData.peerDeviceId);
+            App_DkChannelsReset(pEventData->eventData.peerDeviceId);
             /* Reset Service Discovery to be sure*/
             BleServDisc_Stop(pEventData->eventData.peerDeviceId);
             mCurrentPeerId = gInvalidDeviceId_c;
@@ -1941,128 +2404,11 @@ static void App_HandleConnectionCallback(appEventData_t *pEventData)
         case mAppEvt_ConnectionCallback_ReadRssiEvtConnected_c:
         {
             appRssiReadCallbackEventData_t *pReadRssiCallbackEventData = (appRssiReadCallbackEventData_t *)pEventData->eventData.pData;
-            systemParameters_t *pSysParams = NULL;
-            dkSubEventDeviceRangingIntentType_t eRangingType;
-            bool_t bSendIntent = false;
 
-            App_NvmReadSystemParams(&pSysParams);
-            mTemperatureCount++;
-            mRssiActiveCount++;
-            if((mRssiActiveCount >= mcMaxTemperatureCount((pSysParams->system_params).fields.rssi_on_duration * 1000,
-               (pSysParams->system_params).fields.connection_interval)))
-            {
-            	TM_Close(rssiTmrId);
-            	mRssiActiveCount = 0;
-            }
-            if(pReadRssiCallbackEventData->rssi_dBm != gGapRssiNotAvailable_d)
+            if((pReadRssiCallbackEventData->peerDeviceId < gAppMaxConnections_c) &&
+               (maPeerInformation[pReadRssiCallbackEventData->peerDeviceId].rssiSource == mAppRssiTimer_c))
             {
-                mRssiSum = mRssiSum + (pReadRssiCallbackEventData->rssi_dBm);
-                mRssiCounter++;
-            }
-            else
-            {
-                /* For MISRA compliance */
-            }
-
-            if(mRssiCounter == mcRssiMaxCounter)
-            {
-                mNewFilteredRssi = mcCalculateNewFilteredRssi(mRssiSum);
-                if(!mValidRssi0)
-                {
-                    if(mNewFilteredRssi >= (pSysParams->system_params).fields.rssi_intent_high)
-                    {
-                        mRssi0 = (pSysParams->system_params).fields.rssi_intent_high - mcRssiCorrection;
-                        CCC_SendRangingIntentSubEvent(pReadRssiCallbackEventData->peerDeviceId,
-                                                      gDeviceRangingIntent_c,
-                                                      gHighApproachConfidence_c);
-                        intent = App_HighIntent;
-                        mSameIntentCount = 0;
-                        TRACE_DEBUG("RSSI_0 = %d dBm", mRssi0);
-                    }
-                    else
-                    {
-                        mRssi0 = mNewFilteredRssi;
-                    }
-                    mValidRssi0 = true;
-                }
-                else
-                {
-                    intent = BleApp_DecideIntentFromRSSI(mNewFilteredRssi, mRssi0);
-                    if(intent != App_Undefined)
-                    {
-                        /* Check wether we have to send the intent according to intent, mLastIntent and timeout_between_same_intents */
-                        if(0 == (pSysParams->system_params).fields.timeout_between_same_intents)
-                        {
-                            /* timeout_between_same_intents = 0 */
-                            bSendIntent = (intent != mLastIntent);
-                        }
-                        else
-                        {
-                            /* timeout_between_same_intents != 0 */
-                            if(intent != mLastIntent)
-                            {
-                                bSendIntent = true;
-                                mSameIntentCount = 0;
-                            }
-                            else
-                            {
-                                if(mSameIntentCount >= mcMaxSameIntentsCount((pSysParams->system_params).fields.timeout_between_same_intents * 1000,
-                                                                             (pSysParams->system_params).fields.connection_interval,
-                                                                              mcRssiMaxCounter))
-                                {
-                                    bSendIntent = true;
-                                    mSameIntentCount = 0;
-                                }
-                                else
-                                {
-                                    bSendIntent = false;
-                                    mSameIntentCount++;
-                                }
-                            }
-                        }
-                        if(bSendIntent)
-                        {
-                            switch(intent)
-                            {
-                            case App_LowIntent:
-                                eRangingType = gLowApproachConfidence_c;
-                                break;
-
-                            case App_MediumIntent:
-                                eRangingType = gMediumApproachConfidence_c;
-                                break;
-
-                            case App_HighIntent:
-                                eRangingType = gHighApproachConfidence_c;
-                                break;
-
-                            default:
-                                /* No action required */
-                                break;
-                            }
-                            CCC_SendRangingIntentSubEvent(pReadRssiCallbackEventData->peerDeviceId,
-                                                          gDeviceRangingIntent_c,
-                                                          eRangingType);
-                            TRACE_DEBUG("RSSI_0 = %d dBm", mRssi0);
-                            TRACE_DEBUG("RSSI Measured = %d dBm", mNewFilteredRssi);
-                        }
-                        else
-                        {
-                            /* For MISRA compliance */
-                        }
-                    }
-                    else
-                    {
-                        /* For MISRA compliance */
-                    }
-                }
-                mLastIntent = intent;
-                mRssiCounter = 0;
-                mRssiSum = 0;
-            }
-            else
-            {
-                /* For MISRA compliance */
+                BleApp_HandleRssiSample(pReadRssiCallbackEventData->peerDeviceId, pReadRssiCallbackEventData->rssi_dBm);
             }
             break;
         }
@@ -2094,6 +2440,8 @@ static void App_HandleL2capPsmDataCallback(appEventData_t *pEventData)
         rangingMsgId_t msgId = (rangingMsgId_t)pPacket[1];
         uint16_t length = 0;
         FLib_MemCpyReverseOrder(&length, &pPacket[2], gLengthFieldSize_c);
+        /* lePsm holds the channel ID the packet came in on */
+        App_DkChannelReceived(deviceId, l2capDataEvent->lePsm, protocol);
 
         switch (protocol)
         {
@@ -2107,6 +2455,7 @@ static void App_HandleL2capPsmDataCallback(appEventData_t *pEventData)
                         bleResult_t result = CCCPhase2_SendSPAKEResponse(deviceId, &pPacket[4], length);
                         if (result == gBleSuccess_c)
                         {
+                            App_LatencyMark(deviceId, mLatencySpakeRequest_c);
                             BleApp_StateMachineHandler(deviceId, mAppEvt_SentSPAKEResponse_c);
                         }
                     }
@@ -2116,6 +2465,7 @@ static void App_HandleL2capPsmDataCallback(appEventData_t *pEventData)
                         bleResult_t result = CCCPhase2_SendSPAKEVerify(deviceId, &pPacket[4], length);
                         if (result == gBleSuccess_c)
                         {
+                            App_LatencyMark(deviceId, mLatencySpakeVerify_c);
                             BleApp_StateMachineHandler(deviceId, mAppEvt_ReceivedSPAKEVerify_c);
                         }
                     }
@@ -2142,7 +2492,8 @@ static void App_HandleL2capPsmDataCallback(appEventData_t *pEventData)
                         pData += gSmpLeScRandomConfirmValueSize_c;
                         /* Random Value */
                         FLib_MemCpy(&maPeerInformation[deviceId].peerOobData.randomValue, pData, gSmpLeScRandomValueSize_c);
-                        
+                        App_LatencyMark(deviceId, mLatencyFirstApproach_c);
+
 #if defined(mcConnectionwithRealVehicle) && (mcConnectionwithRealVehicle == 1)
                             /* send standard transaction request */
                             TRACE_INFO("Received First_Approach_RS.");
@@ -2162,11 +2513,12 @@ static void App_HandleL2capPsmDataCallback(appEventData_t *pEventData)
                 {
                     uint8_t RkeChallengeTab[gRKEChallengeLength_c] = {0};
                     uint8_t hashBuffer[SHA256_HASH_SIZE] = {0};
-                    uint8_t attestationData[SHA256_HASH_SIZE] = {0};
+                    uint8_t attestationData[gEcdsaSignatureSize_c] = {0};
                     bool_t dataToBeSigned = FALSE;
 
                     TRACE_HEX("Received RKE_Auth_RQ", pPacket, packetLength);
                     BleApp_ParsingRKEAuthentication(pPacket, packetLength, RkeChallengeTab, gRKEChallengeLength_c);
+                    App_RkeChallengeReceived(deviceId);
                     if((gCentralLocking_c == maPeerInformation[deviceId].customInfo.functionId) && 
                        (gLock_c == maPeerInformation[deviceId].customInfo.actionId))
                     {
@@ -2206,8 +2558,15 @@ static void App_HandleL2capPsmDataCallback(appEventData_t *pEventData)
                     }
                     if(dataToBeSigned)
                     {
-                        CCC_SignArbitraryData(hashBuffer, sizeof(hashBuffer), attestationData);
-                        CCC_SendRKEAuthResponse(deviceId, attestationData, sizeof(attestationData));
+                        if (CCC_SignArbitraryData(hashBuffer, sizeof(hashBuffer), attestationData) == gBleSuccess_c)
+                        {
+                            CCC_SendRKEAuthResponse(deviceId, attestationData, sizeof(attestationData));
+                        }
+                        else
+                        {
+                            /* No attestation: the exchange is abandoned, the actions of the vehicle dropped */
+                            App_RkeReset(deviceId);
+                        }
                     }
                 }
             }
@@ -2259,6 +2618,12 @@ static void App_HandleL2capPsmDataCallback(appEventData_t *pEventData)
 
                         /* parsing */
                         BleApp_ParsingVehicleStatusChangedSubEvent(pPacket,packetLength);
+
+                        /* Completes the RKE action in flight, next queued one goes out */
+                        if (App_RkeAcknowledge(deviceId, (uint16_t)Utils_BeExtractTwoByteValue(&pPacket[10])) == gAppRkeDispatch_c)
+                        {
+                            BleApp_RkeSendInFlight(deviceId);
+                        }
                     }
                 }
             }
@@ -2271,7 +2636,9 @@ static void App_HandleL2capPsmDataCallback(appEventData_t *pEventData)
                     BleApp_ParsingRangingSessionRequest(pPacket);
                     CCC_SendRangingSessionRS(deviceId);
                     UWB_MGR_notify(UWB_EVENT_START_RANGING);
+                    App_LatencyMark(deviceId, mLatencyRangingSession_c);
                     mUWBState = gUWBRanging_c;
+                    App_DiagUpdate(gAppDiagUwbState_c, (int32_t)mUWBState);
                 }
                 else if(msgId == gRangingRecoveryRQ_c)
                 {
@@ -2280,6 +2647,7 @@ static void App_HandleL2capPsmDataCallback(appEventData_t *pEventData)
                     CCC_SendRangingRecoveryRS(deviceId);
                     UWB_MGR_notify(UWB_EVENT_RECOVER_RANGING);
                     mUWBState = gUWBRanging_c;
+                    App_DiagUpdate(gAppDiagUwbState_c, (int32_t)mUWBState);
                 }
                 else if(msgId == gRangingSuspendRQ_c)
                 {
@@ -2288,6 +2656,7 @@ static void App_HandleL2capPsmDataCallback(appEventData_t *pEventData)
                     CCC_SendRangingSuspendRS(deviceId);
                     UWB_MGR_notify(UWB_EVENT_STOP_RANGING);
                     mUWBState = gUWBNoRanging_c;
+                    App_DiagUpdate(gAppDiagUwbState_c, (int32_t)mUWBState);
                 }
                 else if(msgId == gRangingCapabilityRQ_c)
                 {
@@ -2492,6 +2861,7 @@ static void BleApp_ParsingVehicleStatusChangedSubEvent(uint8_t *pPacket, uint16_
     {
         mVehicleState = gStatusUnlocked_c;
     }
+    App_DiagUpdate(gAppDiagVehicleState_c, (int32_t)mVehicleState);
 }
 
 /*! *********************************************************************************
@@ -2783,18 +3153,33 @@ static void PrintLePhyEvent(gapPhyEvent_t* pPhyEvent)
 static bleResult_t CCCPhase2_SendSPAKEResponse(deviceId_t deviceId, uint8_t *pData, uint16_t dataLen)
 {
     bleResult_t result = gBleSuccess_c;
+    uint16_t payloadLen = 0U;
+    uint8_t payload[gSpake2pResponseSize_c];
 
-    /* Dummy data - replace with calls to get actual data */
-    uint16_t payloadLen = gDummyPayloadLength_c;
-    uint8_t payload[gDummyPayloadLength_c] = gDummyPayload_c;
-
-    result = DK_SendMessage(deviceId,
-                            maPeerInformation[deviceId].customInfo.psmChannelId,
-                            gDKMessageTypeFrameworkMessage_c,
-                            gDkApduRS_c,
-                            payloadLen,
-                            payload);
-    TRACE_INFO("SPAKE Response sent.");
+    if (CCC_Spake2pHandleRequest(deviceId, pData, dataLen, payload, &payloadLen) != gSpake2pSuccess_c)
+    {
+        /* No verifier provisioned or bad Request: answer with SW 6A80 */
+        TRACE_ERROR("SPAKE Request rejected.");
+        payload[0] = 0x6AU;
+        payload[1] = 0x80U;
+        (void)DK_SendMessage(deviceId,
+                             App_DkChannelFor(deviceId, gDKMessageTypeFrameworkMessage_c, 2U),
+                             gDKMessageTypeFrameworkMessage_c,
+                             gDkApduRS_c,
+                             2U,
+                             payload);
+        result = gBleInvalidParameter_c;
+    }
+    else
+    {
+        result = DK_SendMessage(deviceId,
+                                App_DkChannelFor(deviceId, gDKMessageTypeFrameworkMessage_c, payloadLen),
+                                gDKMessageTypeFrameworkMessage_c,
+                                gDkApduRS_c,
+                                payloadLen,
+                                payload);
+        TRACE_INFO("SPAKE Response sent.");
+    }
     return result;
 }
 
@@ -2805,18 +3190,33 @@ static bleResult_t CCCPhase2_SendSPAKEResponse(deviceId_t deviceId, uint8_t *pDa
 static bleResult_t CCCPhase2_SendSPAKEVerify(deviceId_t deviceId, uint8_t *pData, uint16_t dataLen)
 {
     bleResult_t result = gBleSuccess_c;
+    uint16_t payloadLen = 0U;
+    uint8_t payload[gSpake2pVerifyRspSize_c];
 
-    /* Dummy data - replace with calls to get actual data */
-    uint16_t payloadLen = gDummyPayloadLength_c;
-    uint8_t payload[gDummyPayloadLength_c] = gDummyPayload_c;
-
-    result = DK_SendMessage(deviceId,
-                            maPeerInformation[deviceId].customInfo.psmChannelId,
-                            gDKMessageTypeFrameworkMessage_c,
-                            gDkApduRS_c,
-                            payloadLen,
-                            payload);
-    TRACE_INFO("SPAKE Verify sent.");
+    if (CCC_Spake2pHandleVerify(deviceId, pData, dataLen, payload, &payloadLen) != gSpake2pSuccess_c)
+    {
+        /* Verification failed: answer with SW 6A80, the pairing does not progress */
+        TRACE_ERROR("SPAKE Verify failed.");
+        payload[0] = 0x6AU;
+        payload[1] = 0x80U;
+        (void)DK_SendMessage(deviceId,
+                             App_DkChannelFor(deviceId, gDKMessageTypeFrameworkMessage_c, 2U),
+                             gDKMessageTypeFrameworkMessage_c,
+                             gDkApduRS_c,
+                             2U,
+                             payload);
+        result = gBleInvalidParameter_c;
+    }
+    else
+    {
+        result = DK_SendMessage(deviceId,
+                                App_DkChannelFor(deviceId, gDKMessageTypeFrameworkMessage_c, payloadLen),
+                                gDKMessageTypeFrameworkMessage_c,
+                                gDkApduRS_c,
+                                payloadLen,
+                                payload);
+        TRACE_INFO("SPAKE Verify sent.");
+    }
     return result;
 }
 
@@ -2835,7 +3235,7 @@ static bleResult_t CCC_SendCommandCompleteSubEvent(deviceId_t deviceId,
     payload[1] = (uint8_t)type;
 
     result = DK_SendMessage(deviceId,
-                            maPeerInformation[deviceId].customInfo.psmChannelId,
+                            App_DkChannelFor(deviceId, gDKMessageTypeDKEventNotification_c, gCommandCompleteSubEventPayloadLength_c),
                             gDKMessageTypeDKEventNotification_c,
                             gDkEventNotification_c,
                             gCommandCompleteSubEventPayloadLength_c,
@@ -2861,7 +3261,7 @@ static bleResult_t CCC_SendRangingIntentSubEvent(deviceId_t deviceId,
     payload[1] = (uint8_t)type;
 
     result = DK_SendMessage(deviceId,
-                            maPeerInformation[deviceId].customInfo.psmChannelId,
+                            App_DkChannelFor(deviceId, MessageType, gRangingIntentSubEventPayloadLength_c),
                             MessageType,
                             MessageId,
                             gRangingIntentSubEventPayloadLength_c,
@@ -2879,7 +3279,7 @@ static bleResult_t CCC_SendRangingIntentSubEvent(deviceId_t deviceId,
  ********************************************************************************** */
 static bleResult_t CCC_SendRKERequestSubEvent(deviceId_t deviceId, gDkRKEFunctionId_t function, uint8_t action)
 {
-    bleResult_t result;
+    bleResult_t result = gBleInvalidParameter_c;
     bool Sanity_check = false;
     uint8_t payload[gCommandRKERequestSubEventPayloadLength_c] = {0};
     uint8_t len = 0;
@@ -2934,7 +3334,7 @@ static bleResult_t CCC_SendRKERequestSubEvent(deviceId_t deviceId, gDkRKEFunctio
         payload[len++] = action;
 
         result = DK_SendMessage(deviceId,
-                                maPeerInformation[deviceId].customInfo.psmChannelId,
+                                App_DkChannelFor(deviceId, MessageType, len),
                                 MessageType,
                                 MessageId,
                                 len,
@@ -2964,7 +3364,7 @@ bleResult_t CCC_SendRKEAuthResponse(deviceId_t deviceId, uintn8_t *pAttestation,
     bleResult_t result;
 
     result = DK_SendMessage(deviceId,
-                            maPeerInformation[deviceId].customInfo.psmChannelId,
+                            App_DkChannelFor(deviceId, MessageType, attestationLen),
                             MessageType,
                             MessageId,
                             attestationLen,
@@ -2997,7 +3397,7 @@ static bleResult_t CCC_SendRangingSessionRS(deviceId_t deviceId)
     /* TODO: payload fill */
 
     result = DK_SendMessage(deviceId,
-                            maPeerInformation[deviceId].customInfo.psmChannelId,
+                            App_DkChannelFor(deviceId, MessageType, gRangingSessionResponsePayloadLength_c),
                             MessageType,
                             MessageId,
                             gRangingSessionResponsePayloadLength_c,
@@ -3023,7 +3423,7 @@ static bleResult_t CCC_SendRangingRecoveryRS(deviceId_t deviceId)
     /* TODO: payload fill */
 
     result = DK_SendMessage(deviceId,
-                            maPeerInformation[deviceId].customInfo.psmChannelId,
+                            App_DkChannelFor(deviceId, MessageType, gRangingRecoveryResponsePayloadLength_c),
                             MessageType,
                             MessageId,
                             gRangingRecoveryResponsePayloadLength_c,
@@ -3049,7 +3449,7 @@ static bleResult_t CCC_SendRangingSuspendRS(deviceId_t deviceId)
     /* TODO: payload fill */
 
     result = DK_SendMessage(deviceId,
-                            maPeerInformation[deviceId].customInfo.psmChannelId,
+                            App_DkChannelFor(deviceId, MessageType, gRangingSuspendResponsePayloadLength_c),
                             MessageType,
                             MessageId,
                             gRangingSuspendResponsePayloadLength_c,
@@ -3080,7 +3480,7 @@ static bleResult_t CCC_SendRangingCapabilityRS(deviceId_t deviceId)
     payload[len++]=0x00;
 
     result = DK_SendMessage(deviceId,
-                            maPeerInformation[deviceId].customInfo.psmChannelId,
+                            App_DkChannelFor(deviceId, MessageType, gRangingCapabilityResponsePayloadLength_c),
                             MessageType,
                             MessageId,
                             gRangingCapabilityResponsePayloadLength_c,
@@ -3119,18 +3519,36 @@ static void CCC_DeriveArbitraryData(uintn8_t *pRkeChallenge,
 }
 
 /*! *********************************************************************************
- * \brief        Sign the arbitraryData with private key
+ * \brief        Sign the arbitraryData (SHA-256 digest) with the RKE private key,
+ *               ECDSA P-256. pAttestationOut receives r || s (gEcdsaSignatureSize_c).
  *
+ * \return       gBleSuccess_c, or an error if no key is provisioned or the
+ *               signature failed: pAttestationOut must not be sent.
  ********************************************************************************** */
-static void CCC_SignArbitraryData(uintn8_t *pArbitraryData, uintn8_t arbitraryDataLen, uintn8_t *pAttestationOut)
+static bleResult_t CCC_SignArbitraryData(uintn8_t *pArbitraryData, uintn8_t arbitraryDataLen, uintn8_t *pAttestationOut)
 {
-    /* TODO: How to sign the arbitrary data? */
-    uint8_t pKey[16] = {0};
-    if(pArbitraryData && arbitraryDataLen && pAttestationOut)
+    bleResult_t result = gBleInvalidParameter_c;
+#if defined(gAppCccStepTimes_d) && (gAppCccStepTimes_d == 1)
+    uint64_t startTs = TM_GetTimestamp();
+#endif
+
+    if(pArbitraryData && (gEcdsaHashSize_c == arbitraryDataLen) && pAttestationOut)
     {
-        AES_128_ECB_Encrypt(pArbitraryData, arbitraryDataLen, pKey, pAttestationOut);
-        TRACE_HEX("Arbitrary Data signed", pAttestationOut, arbitraryDataLen);
+        if (CCC_EcdsaSign(pArbitraryData, pAttestationOut) == TRUE)
+        {
+#if defined(gAppCccStepTimes_d) && (gAppCccStepTimes_d == 1)
+            TRACE_DEBUG("RKE signature: %u us", (uint32_t)(TM_GetTimestamp() - startTs));
+#endif
+            TRACE_HEX("Arbitrary Data signed", pAttestationOut, gEcdsaSignatureSize_c);
+            result = gBleSuccess_c;
+        }
+        else
+        {
+            TRACE_ERROR("RKE signature failed.");
+            result = gBleUnexpectedError_c;
+        }
     }
+    return result;
 }
 
 /*! *********************************************************************************
@@ -3165,7 +3583,7 @@ static bleResult_t CCC_SendTimeSync(deviceId_t deviceId,
     pPtr += sizeof(uint16_t);
     
     result = DK_SendMessage(deviceId,
-                            maPeerInformation[deviceId].customInfo.psmChannelId,
+                            App_DkChannelFor(deviceId, gDKMessageTypeSupplementaryServiceMessage_c, gTimeSyncPayloadLength_c),
                             gDKMessageTypeSupplementaryServiceMessage_c,
                             gTimeSync_c,
                             gTimeSyncPayloadLength_c,
@@ -3202,7 +3620,7 @@ static bleResult_t CCC_FirstApproachReq(deviceId_t deviceId, uint8_t* pBdAddr, g
         TRACE_HEX("Confirm", pOobData->confirmValue, gSmpLeScRandomConfirmValueSize_c);
         TRACE_HEX("Random", pOobData->randomValue, gSmpLeScRandomConfirmValueSize_c);
         result = DK_SendMessage(deviceId,
-                                maPeerInformation[deviceId].customInfo.psmChannelId,
+                                App_DkChannelFor(deviceId, gDKMessageTypeSupplementaryServiceMessage_c, gFirstApproachReqRspPayloadLength),
                                 gDKMessageTypeSupplementaryServiceMessage_c,
                                 gFirstApproachRQ_c,
                                 gFirstApproachReqRspPayloadLength,
@@ -3227,11 +3645,12 @@ static bleResult_t CCC_StandardTransactionReq(deviceId_t deviceId)
     aPayload[len++] = gCommandComplete_c;
     aPayload[len++] = gRequestStandardTransaction_c;
     result = DK_SendMessage(deviceId,
-                            maPeerInformation[deviceId].customInfo.psmChannelId,
+                            App_DkChannelFor(deviceId, MessageType, gStandardTransactionReqPayloadLength),
 							MessageType,
 							MessageId,
 							gStandardTransactionReqPayloadLength,
                             aPayload);
+    App_LatencyMark(deviceId, mLatencyStdTransaction_c);
 
     TRACE_INFO("Request_Standard_Transaction sent");
     TRACE_DEBUG("Message type : 0x%02x", MessageType);
@@ -3265,7 +3684,7 @@ static bleResult_t CCC_SendAPDUResp(deviceId_t deviceId, apduId_t Id)
     Array_string_hex(buf, 2*ApduLength, aPayload);
 
     result = DK_SendMessage(deviceId,
-                            maPeerInformation[deviceId].customInfo.psmChannelId,
+                            App_DkChannelFor(deviceId, MessageType, ApduLength),
 							MessageType,
 							MessageId,
 							ApduLength,
@@ -30,6 +30,7 @@
 #include "uwb_params_interface.h"
 #include "commands_interface.h"
 #include "digital_key_interface.h"
+#include "app_rssi_intent.h"
 
 /************************************************************************************
 *************************************************************************************
@@ -40,11 +41,12 @@
 #define mcCharVehiclePsmIndex_c              (0U)
 #define mcCharVehicleAntennaIdIndex_c        (1U)
 #define mcCharTxPowerLevelIndex_c            (2U)
+#define mcCharDatabaseHashIndex_c            (3U)            /* read state only, not in maCharacteristics */
 
 #define mcCharVehiclePsmLength_c             (2U)
 #define mcCharTxPowerLevelLength_c           (1U)
 #define mcCharVehicleAntennaIdLength_c       (2U)
-#define mCharReadBufferLength_c              (13U)           /* length of the buffer */
+#define mCharReadBufferLength_c              (19U)           /* length of the buffer: length 1, handle 2, Database Hash 16 */
 /************************************************************************************
 *************************************************************************************
 * Public type definitions
@@ -64,6 +66,12 @@ typedef enum appBLEState_tag{
     mAppPreIdle_c
 }appBLEState_t;
 
+typedef enum appRssiSource_tag{
+    mAppRssiOff_c,
+    mAppRssiConnEvent_c,        /* connection event notifications */
+    mAppRssiTimer_c             /* Gap_ReadRssi on the RSSI timer */
+}appRssiSource_t;
+
 typedef enum appSePowerState_tag{
     mAppSePoweredOn_c,
     mAppSePoweredOff_c,
@@ -78,6 +86,8 @@ typedef struct appCustomInfo_tag
     uint16_t     lePsmValue;
     uint16_t     psmChannelId;
     /* Add persistent information here */
+    uint8_t      aDbHash[gGattDatabaseHashSize_c];   /* Vehicle Database Hash the handles above belong to */
+    bool_t       dbHashValid;
     uint16_t     functionId;
     uintn8_t     actionId;
 }appCustomInfo_t;
@@ -91,6 +101,11 @@ typedef struct appPeerInfo_tag
     gapLeScOobData_t    oobData;
     gapLeScOobData_t    peerOobData;
     gapRole_t           gapRole;
+    appRssiIntent_t     rssiIntent;
+    appRssiSource_t     rssiSource;
+    uint32_t            rssiActiveCount;    /* samples since RSSI sensing started */
+    uint32_t            temperatureCount;   /* RSSI samples of this peer since it connected */
+    uint16_t            rssiEventCounter;   /* connection event of the last sample */
 }appPeerInfo_t;
 
 typedef struct advState_tag
@@ -125,6 +140,7 @@ void BleApp_StateMachineHandler
     appEvent_t event
 );
 void BleApp_SetBondingDataOfBMWVehicle(void);
+void BleApp_HandleConnEventRssi(deviceId_t peerDeviceId, int8_t rssi, uint16_t eventCounter);
 gVehicleState_t GetVehicleState(void);
 gUWBState_t GetUWBState(void);
 void SetSePower(appSePowerState_t se_power_state);
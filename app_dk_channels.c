@@ -0,0 +1,369 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_dk_channels.c
+*
+* DK L2CAP channels per vehicle. Channels to the vehicle SPSM are opened one at
+* a time: slot 0 first (it starts the CCC flow), then the next slot once the
+* previous one is connected. A refused slot is not requested again on this
+* connection. Messages are sent on the channel the vehicle last sent a message
+* of their class on, else on the slot of their class, or on slot 0 while that
+* slot is not open.
+*
+* All functions are called from the application task.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "FunctionLib.h"
+#include "ble_general.h"
+#include "l2ca_cb_interface.h"
+#include "app_dk_channels.h"
+#include "app_trace.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mcDkChannelNone_c                   (0x0000U)
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+typedef struct appDkChannels_tag
+{
+    uint16_t            aCid[gAppDkChannelsPerPeer_c];
+    appDkChannelStats_t aStats[gAppDkClassCount_c];
+    uint16_t            aRxCid[gAppDkClassCount_c]; /* Channel of the last received message, per class */
+    uint16_t            lePsm;
+    uint16_t            initialCredits;
+    uint8_t             pendingSlot;        /* Slot of the connection request in progress */
+    uint8_t             refusedMask;        /* Slots the vehicle did not accept */
+}appDkChannels_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static appDkChannels_t maDkChannels[gAppMaxConnections_c];
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static void App_DkChannelsOpenNext(deviceId_t deviceId);
+static appDkChannelClass_t App_DkChannelClassOf(dkMessageType_t messageType);
+static bool_t App_DkChannelIsOpen(const appDkChannels_t *pChannels, uint16_t cId);
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Opens the DK channels of a vehicle, slot 0 first.
+*
+* \param[in]    deviceId            Vehicle device ID.
+* \param[in]    lePsm               Vehicle SPSM.
+* \param[in]    initialCredits      Credits given to the vehicle on each channel.
+*
+* \return       Result of the slot 0 connection request.
+********************************************************************************** */
+bleResult_t App_DkChannelsOpen(deviceId_t deviceId, uint16_t lePsm, uint16_t initialCredits)
+{
+    bleResult_t result = gBleInvalidParameter_c;
+
+    if (deviceId < (deviceId_t)gAppMaxConnections_c)
+    {
+        appDkChannels_t *pChannels = &maDkChannels[deviceId];
+
+        pChannels->lePsm = lePsm;
+        pChannels->initialCredits = initialCredits;
+        pChannels->pendingSlot = 0U;
+        result = L2ca_ConnectLePsm(lePsm, deviceId, initialCredits);
+    }
+    return result;
+}
+
+/*! *********************************************************************************
+* \brief        L2CAP connection complete for the pending slot. Requests the next
+*               slot if any.
+*
+* \param[in]    deviceId            Vehicle device ID.
+* \param[in]    cId                 Channel ID.
+* \param[in]    success             FALSE if the vehicle refused the channel.
+*
+* \return       Slot of the channel, gAppDkChannelInvalidSlot_c if unexpected.
+********************************************************************************** */
+uint8_t App_DkChannelsConnected(deviceId_t deviceId, uint16_t cId, bool_t success)
+{
+    uint8_t slot = gAppDkChannelInvalidSlot_c;
+
+    if ((deviceId < (deviceId_t)gAppMaxConnections_c) &&
+        (maDkChannels[deviceId].pendingSlot < gAppDkChannelsPerPeer_c))
+    {
+        appDkChannels_t *pChannels = &maDkChannels[deviceId];
+
+        slot = pChannels->pendingSlot;
+        pChannels->pendingSlot = gAppDkChannelInvalidSlot_c;
+        if (success == TRUE)
+        {
+            pChannels->aCid[slot] = cId;
+        }
+        else
+        {
+            pChannels->refusedMask |= (uint8_t)(1U << slot);
+        }
+
+        /* Additional slots only once slot 0 carries the CCC flow */
+        if (pChannels->aCid[0] != mcDkChannelNone_c)
+        {
+            App_DkChannelsOpenNext(deviceId);
+        }
+        else if (slot != 0U)
+        {
+            /* Slot 0 was lost while this slot was being opened */
+            pChannels->pendingSlot = 0U;
+            (void)L2ca_ConnectLePsm(pChannels->lePsm, deviceId, pChannels->initialCredits);
+        }
+        else
+        {
+            ; /* For MISRA compliance */
+        }
+    }
+    return slot;
+}
+
+/*! *********************************************************************************
+* \brief        L2CAP channel disconnected by the vehicle. The slot is requested
+*               again, its traffic goes to slot 0 meanwhile.
+*
+* \return       Slot of the channel, gAppDkChannelInvalidSlot_c if unknown.
+********************************************************************************** */
+uint8_t App_DkChannelsDisconnected(deviceId_t deviceId, uint16_t cId)
+{
+    uint8_t slot = gAppDkChannelInvalidSlot_c;
+    uint8_t i;
+
+    if (deviceId < (deviceId_t)gAppMaxConnections_c)
+    {
+        appDkChannels_t *pChannels = &maDkChannels[deviceId];
+
+        for (i = 0U; i < gAppDkChannelsPerPeer_c; i++)
+        {
+            if ((pChannels->aCid[i] != mcDkChannelNone_c) && (pChannels->aCid[i] == cId))
+            {
+                pChannels->aCid[i] = mcDkChannelNone_c;
+                slot = i;
+            }
+        }
+
+        if (slot == 0U)
+        {
+            /* Slot 0 first again, the others follow its connection */
+            if (pChannels->pendingSlot == gAppDkChannelInvalidSlot_c)
+            {
+                pChannels->pendingSlot = 0U;
+                (void)L2ca_ConnectLePsm(pChannels->lePsm, deviceId, pChannels->initialCredits);
+            }
+        }
+        else if ((slot != gAppDkChannelInvalidSlot_c) && (pChannels->aCid[0] != mcDkChannelNone_c))
+        {
+            App_DkChannelsOpenNext(deviceId);
+        }
+        else
+        {
+            ; /* For MISRA compliance */
+        }
+    }
+    return slot;
+}
+
+/*! *********************************************************************************
+* \brief        Forgets the channels of a vehicle (disconnection).
+********************************************************************************** */
+void App_DkChannelsReset(deviceId_t deviceId)
+{
+    if (deviceId < (deviceId_t)gAppMaxConnections_c)
+    {
+        FLib_MemSet(&maDkChannels[deviceId], 0x00, sizeof(appDkChannels_t));
+        maDkChannels[deviceId].pendingSlot = gAppDkChannelInvalidSlot_c;
+    }
+}
+
+/*! *********************************************************************************
+* \brief        A CCC message was received: messages of its class are answered on
+*               its channel while it is open.
+*
+* \param[in]    deviceId            Vehicle device ID.
+* \param[in]    cId                 Channel the message came in on.
+* \param[in]    messageType         CCC message type.
+********************************************************************************** */
+void App_DkChannelReceived(deviceId_t deviceId, uint16_t cId, dkMessageType_t messageType)
+{
+    if (deviceId < (deviceId_t)gAppMaxConnections_c)
+    {
+        maDkChannels[deviceId].aRxCid[App_DkChannelClassOf(messageType)] = cId;
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Selects the channel of a CCC message and accounts for it.
+*
+* \param[in]    deviceId            Vehicle device ID.
+* \param[in]    messageType         CCC message type.
+* \param[in]    length              Payload length.
+*
+* \return       Channel ID to send the message on.
+********************************************************************************** */
+uint16_t App_DkChannelFor(deviceId_t deviceId, dkMessageType_t messageType, uint16_t length)
+{
+    uint16_t cId = mcDkChannelNone_c;
+    appDkChannelClass_t channelClass = App_DkChannelClassOf(messageType);
+    uint8_t slot = ((uint8_t)channelClass < gAppDkChannelsPerPeer_c) ? (uint8_t)channelClass : (uint8_t)(gAppDkChannelsPerPeer_c - 1U);
+
+    if (deviceId < (deviceId_t)gAppMaxConnections_c)
+    {
+        appDkChannels_t *pChannels = &maDkChannels[deviceId];
+
+        if (App_DkChannelIsOpen(pChannels, pChannels->aRxCid[channelClass]) == TRUE)
+        {
+            /* Answer where the vehicle asked */
+            cId = pChannels->aRxCid[channelClass];
+        }
+        else
+        {
+            cId = pChannels->aCid[slot];
+        }
+        if (cId == mcDkChannelNone_c)
+        {
+            cId = pChannels->aCid[0];
+            if (slot != 0U)
+            {
+                pChannels->aStats[channelClass].fallbacks++;
+            }
+        }
+        pChannels->aStats[channelClass].messages++;
+        pChannels->aStats[channelClass].bytes += length;
+    }
+    App_TraceEvent(gAppTraceL2capTx_c,
+                   ((uint32_t)deviceId << 24) | ((uint32_t)messageType << 16) | (uint32_t)length, cId);
+    return cId;
+}
+
+/*! *********************************************************************************
+* \brief        Returns the channel ID of a slot, 0 if not open.
+********************************************************************************** */
+uint16_t App_DkChannelGetCid(deviceId_t deviceId, uint8_t slot)
+{
+    uint16_t cId = mcDkChannelNone_c;
+
+    if ((deviceId < (deviceId_t)gAppMaxConnections_c) && (slot < gAppDkChannelsPerPeer_c))
+    {
+        cId = maDkChannels[deviceId].aCid[slot];
+    }
+    return cId;
+}
+
+/*! *********************************************************************************
+* \brief        Returns the counters of a traffic class.
+********************************************************************************** */
+const appDkChannelStats_t* App_DkChannelGetStats(deviceId_t deviceId, appDkChannelClass_t channelClass)
+{
+    const appDkChannelStats_t *pStats = NULL;
+
+    if ((deviceId < (deviceId_t)gAppMaxConnections_c) && (channelClass < gAppDkClassCount_c))
+    {
+        pStats = &maDkChannels[deviceId].aStats[channelClass];
+    }
+    return pStats;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Requests the first slot that is neither open nor refused.
+********************************************************************************** */
+static void App_DkChannelsOpenNext(deviceId_t deviceId)
+{
+    appDkChannels_t *pChannels = &maDkChannels[deviceId];
+    uint8_t i;
+
+    for (i = 1U; (i < gAppDkChannelsPerPeer_c) && (pChannels->pendingSlot == gAppDkChannelInvalidSlot_c); i++)
+    {
+        if ((pChannels->aCid[i] == mcDkChannelNone_c) && ((pChannels->refusedMask & (1U << i)) == 0U))
+        {
+            if (L2ca_ConnectLePsm(pChannels->lePsm, deviceId, pChannels->initialCredits) == gBleSuccess_c)
+            {
+                pChannels->pendingSlot = i;
+            }
+            else
+            {
+                pChannels->refusedMask |= (uint8_t)(1U << i);
+            }
+        }
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Tells whether a channel ID is one of the open slots.
+********************************************************************************** */
+static bool_t App_DkChannelIsOpen(const appDkChannels_t *pChannels, uint16_t cId)
+{
+    bool_t isOpen = FALSE;
+    uint8_t i;
+
+    for (i = 0U; (i < gAppDkChannelsPerPeer_c) && (cId != mcDkChannelNone_c); i++)
+    {
+        if (pChannels->aCid[i] == cId)
+        {
+            isOpen = TRUE;
+        }
+    }
+    return isOpen;
+}
+
+/*! *********************************************************************************
+* \brief        Traffic class of a CCC message type.
+********************************************************************************** */
+static appDkChannelClass_t App_DkChannelClassOf(dkMessageType_t messageType)
+{
+    appDkChannelClass_t channelClass;
+
+    switch (messageType)
+    {
+        case gDKMessageTypeUWBRangingServiceMessage_c:
+        case gDKMessageTypeDKEventNotification_c:
+        {
+            channelClass = gAppDkClassControl_c;
+        }
+        break;
+
+        default:
+        {
+            channelClass = gAppDkClassBulk_c;
+        }
+        break;
+    }
+    return channelClass;
+}
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
@@ -0,0 +1,89 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_dk_channels.h
+*
+* DK L2CAP channels per vehicle: CCC messages are mapped to a channel by class
+* so that bulk transfers (SE APDUs, logs) do not delay ranging control. A
+* class the vehicle sends requests of is answered on the channel they came in.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef APP_DK_CHANNELS_H
+#define APP_DK_CHANNELS_H
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "ble_general.h"
+#include "digital_key_interface.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+/*! L2CAP credit based channels opened to the DK SPSM of each vehicle. Channel 0
+    carries everything until the others are open; a vehicle refusing a second
+    channel keeps all traffic on channel 0. A second channel is opt-in, for
+    vehicles known to accept it. Redefine it in the app_preinclude.h file */
+#ifndef gAppDkChannelsPerPeer_c
+#define gAppDkChannelsPerPeer_c              (1U)
+#endif
+
+#define gAppDkChannelInvalidSlot_c           (0xFFU)
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+/*! \brief  Traffic classes, one channel each when the vehicle allows it. */
+typedef enum appDkChannelClass_tag
+{
+    gAppDkClassControl_c = 0,   /*!< UWB ranging service, DK events: time critical */
+    gAppDkClassBulk_c,          /*!< Framework and SE APDUs, supplementary service, logs */
+    gAppDkClassCount_c
+}appDkChannelClass_t;
+
+/*! \brief  Per-class counters of one vehicle. */
+typedef struct appDkChannelStats_tag
+{
+    uint32_t    messages;
+    uint32_t    bytes;
+    uint32_t    fallbacks;      /*!< Sent on channel 0, class channel not open */
+}appDkChannelStats_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bleResult_t App_DkChannelsOpen(deviceId_t deviceId, uint16_t lePsm, uint16_t initialCredits);
+uint8_t App_DkChannelsConnected(deviceId_t deviceId, uint16_t cId, bool_t success);
+uint8_t App_DkChannelsDisconnected(deviceId_t deviceId, uint16_t cId);
+void App_DkChannelsReset(deviceId_t deviceId);
+void App_DkChannelReceived(deviceId_t deviceId, uint16_t cId, dkMessageType_t messageType);
+uint16_t App_DkChannelFor(deviceId_t deviceId, dkMessageType_t messageType, uint16_t length);
+uint16_t App_DkChannelGetCid(deviceId_t deviceId, uint8_t slot);
+const appDkChannelStats_t* App_DkChannelGetStats(deviceId_t deviceId, appDkChannelClass_t channelClass);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_DK_CHANNELS_H */
+
+/*! *********************************************************************************
+ * @}
+ ********************************************************************************** */
@@ -0,0 +1,226 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_event_pool.c
+*
+* Event block pools. Free blocks are linked through their first word; a block
+* is returned to its class by address, so App_EventFree also takes buffers
+* that came from the heap.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "fsl_os_abstraction.h"
+#include "fsl_component_mem_manager.h"
+#include "app_event_pool.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#if ((gAppEventPoolSmallSize_c % 8U) != 0U) || ((gAppEventPoolMediumSize_c % 8U) != 0U) || \
+    ((gAppEventPoolLargeSize_c % 8U) != 0U)
+#error "Event pool block sizes must be multiples of 8"
+#endif
+
+#if (gAppEventPoolSmallSize_c >= gAppEventPoolMediumSize_c) || (gAppEventPoolMediumSize_c >= gAppEventPoolLargeSize_c)
+#error "Event pool classes must be sorted by block size"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+typedef struct appEventBlock_tag
+{
+    struct appEventBlock_tag *pNext;
+}appEventBlock_t;
+
+typedef struct appEventPoolClass_tag
+{
+    uint8_t             *pStart;
+    uint8_t             *pEnd;
+    appEventBlock_t     *pFree;
+    appEventPoolStats_t stats;
+}appEventPoolClass_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+/* uint64_t storage: blocks 8 byte aligned */
+static uint64_t maEventPoolSmall[(gAppEventPoolSmallSize_c / 8U) * gAppEventPoolSmallCount_c];
+static uint64_t maEventPoolMedium[(gAppEventPoolMediumSize_c / 8U) * gAppEventPoolMediumCount_c];
+static uint64_t maEventPoolLarge[(gAppEventPoolLargeSize_c / 8U) * gAppEventPoolLargeCount_c];
+
+static appEventPoolClass_t maEventPoolClasses[gAppEventPoolClasses_c];
+static uint32_t mEventPoolHeapAllocs = 0U;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static void App_EventPoolInitClass(appEventPoolClass_t *pClass, uint64_t *pStorage, uint16_t blockSize, uint16_t blockCount);
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Builds the free lists. Called once, before any event is posted.
+********************************************************************************** */
+void App_EventPoolInit(void)
+{
+    App_EventPoolInitClass(&maEventPoolClasses[0], maEventPoolSmall, gAppEventPoolSmallSize_c, gAppEventPoolSmallCount_c);
+    App_EventPoolInitClass(&maEventPoolClasses[1], maEventPoolMedium, gAppEventPoolMediumSize_c, gAppEventPoolMediumCount_c);
+    App_EventPoolInitClass(&maEventPoolClasses[2], maEventPoolLarge, gAppEventPoolLargeSize_c, gAppEventPoolLargeCount_c);
+    mEventPoolHeapAllocs = 0U;
+}
+
+/*! *********************************************************************************
+* \brief        Allocates an event buffer. Callable from any task.
+*
+* \param[in]    size            Bytes.
+*
+* \return       Buffer, NULL if neither a block nor the heap has room.
+********************************************************************************** */
+void *App_EventAlloc(uint32_t size)
+{
+    appEventPoolClass_t *pClass = NULL;
+    appEventBlock_t *pBlock = NULL;
+    uint8_t i;
+
+    for (i = 0U; i < gAppEventPoolClasses_c; i++)
+    {
+        if (size <= maEventPoolClasses[i].stats.blockSize)
+        {
+            pClass = &maEventPoolClasses[i];
+            break;
+        }
+    }
+
+    OSA_InterruptDisable();
+    if (pClass != NULL)
+    {
+        pBlock = pClass->pFree;
+        if (pBlock != NULL)
+        {
+            pClass->pFree = pBlock->pNext;
+            pClass->stats.allocs++;
+            pClass->stats.inUse++;
+            if (pClass->stats.inUse > pClass->stats.highWater)
+            {
+                pClass->stats.highWater = pClass->stats.inUse;
+            }
+        }
+        else
+        {
+            pClass->stats.failures++;
+        }
+    }
+    if (pBlock == NULL)
+    {
+        mEventPoolHeapAllocs++;
+    }
+    OSA_InterruptEnable();
+
+    return (pBlock != NULL) ? (void *)pBlock : MEM_BufferAlloc(size);
+}
+
+/*! *********************************************************************************
+* \brief        Releases a buffer from App_EventAlloc. Callable from any task.
+*
+* \param[in]    pBuffer         Buffer, NULL is ignored.
+********************************************************************************** */
+void App_EventFree(void *pBuffer)
+{
+    appEventPoolClass_t *pClass = NULL;
+    uint8_t i;
+
+    for (i = 0U; i < gAppEventPoolClasses_c; i++)
+    {
+        if (((uint8_t *)pBuffer >= maEventPoolClasses[i].pStart) && ((uint8_t *)pBuffer < maEventPoolClasses[i].pEnd))
+        {
+            pClass = &maEventPoolClasses[i];
+            break;
+        }
+    }
+
+    if (pClass != NULL)
+    {
+        OSA_InterruptDisable();
+        ((appEventBlock_t *)pBuffer)->pNext = pClass->pFree;
+        pClass->pFree = (appEventBlock_t *)pBuffer;
+        pClass->stats.inUse--;
+        OSA_InterruptEnable();
+    }
+    else if (pBuffer != NULL)
+    {
+        (void)MEM_BufferFree(pBuffer);
+    }
+    else
+    {
+        ; /* For MISRA compliance */
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Counters of a class, NULL past the last one.
+********************************************************************************** */
+const appEventPoolStats_t *App_EventPoolGetStats(uint8_t classIdx)
+{
+    return (classIdx < gAppEventPoolClasses_c) ? &maEventPoolClasses[classIdx].stats : NULL;
+}
+
+/*! *********************************************************************************
+* \brief        Buffers served by the heap: larger than every class or class empty.
+********************************************************************************** */
+uint32_t App_EventPoolGetHeapAllocs(void)
+{
+    return mEventPoolHeapAllocs;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+static void App_EventPoolInitClass(appEventPoolClass_t *pClass, uint64_t *pStorage, uint16_t blockSize, uint16_t blockCount)
+{
+    uint16_t i;
+
+    pClass->pStart = (uint8_t *)pStorage;
+    pClass->pEnd = pClass->pStart + ((uint32_t)blockSize * blockCount);
+    pClass->pFree = NULL;
+    /* Linked backwards: the first block is handed out first */
+    for (i = blockCount; i > 0U; i--)
+    {
+        appEventBlock_t *pBlock = (appEventBlock_t *)(void *)(pClass->pStart + ((uint32_t)blockSize * (i - 1U)));
+
+        pBlock->pNext = pClass->pFree;
+        pClass->pFree = pBlock;
+    }
+    pClass->stats.blockSize = blockSize;
+    pClass->stats.blockCount = blockCount;
+    pClass->stats.inUse = 0U;
+    pClass->stats.highWater = 0U;
+    pClass->stats.allocs = 0U;
+    pClass->stats.failures = 0U;
+}
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
@@ -0,0 +1,93 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_event_pool.h
+*
+* Fixed-size block pools for the events posted to the application task
+* (appEventData_t and its payload). O(1) allocation and release from per-size
+* free lists; requests that do not fit, or find their class empty, are served
+* by the framework memory manager.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef APP_EVENT_POOL_H
+#define APP_EVENT_POOL_H
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+/*! Block size (multiple of 8) and count of each class, smallest first.
+    Redefine them in the app_preinclude.h file */
+#ifndef gAppEventPoolSmallSize_c
+#define gAppEventPoolSmallSize_c             (32U)   /* appEventData_t, small payloads */
+#endif
+#ifndef gAppEventPoolSmallCount_c
+#define gAppEventPoolSmallCount_c            (16U)
+#endif
+#ifndef gAppEventPoolMediumSize_c
+#define gAppEventPoolMediumSize_c            (64U)   /* connection, PHY, L2CAP control events */
+#endif
+#ifndef gAppEventPoolMediumCount_c
+#define gAppEventPoolMediumCount_c           (8U)
+#endif
+#ifndef gAppEventPoolLargeSize_c
+#define gAppEventPoolLargeSize_c             (160U)  /* bonding data, short L2CAP packets */
+#endif
+#ifndef gAppEventPoolLargeCount_c
+#define gAppEventPoolLargeCount_c            (4U)
+#endif
+
+#define gAppEventPoolClasses_c               (3U)
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+/*! \brief  Counters of one block class. */
+typedef struct appEventPoolStats_tag
+{
+    uint16_t    blockSize;
+    uint16_t    blockCount;
+    uint16_t    inUse;
+    uint16_t    highWater;
+    uint32_t    allocs;
+    uint32_t    failures;       /*!< Class empty, served by the heap */
+}appEventPoolStats_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void App_EventPoolInit(void);
+void *App_EventAlloc(uint32_t size);
+void App_EventFree(void *pBuffer);
+const appEventPoolStats_t *App_EventPoolGetStats(uint8_t classIdx);
+uint32_t App_EventPoolGetHeapAllocs(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_EVENT_POOL_H */
+
+/*! *********************************************************************************
+ * @}
+ ********************************************************************************** */
@@ -0,0 +1,253 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_gatt_cache.c
+*
+* Change-aware state of the bonded clients of the keyfob database, kept in
+* NVM with the Database Hash it refers to so that a bond that missed a
+* database change while disconnected, or across a reset, is still told of it.
+* The record is written only when the database changed or a bond became
+* change-aware.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "FunctionLib.h"
+#include "fsl_component_timer_manager.h"
+#include "ble_general.h"
+#include "gap_interface.h"
+#include "gatt_server_interface.h"
+#include "gatt_database.h"
+#include "gatt_db_app_interface.h"
+#include "gatt_db_handles.h"
+#include "trace.h"
+#include "app_gatt_cache.h"
+
+#if defined(gGattCaching_d) && (gGattCaching_d == 1)
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#if (gMaxBondedDevices_c > 32U)
+#error "appGattCacheRecord_t holds the change-aware state of 32 bonds"
+#endif
+
+#define mcGattCacheAllBonds_c       (0xFFFFFFFFU >> (32U - (uint32_t)gMaxBondedDevices_c))
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+/* Service Changed value: the whole handle range */
+static const uint8_t maGattCacheChangedRange[4] = {0x01U, 0x00U, 0xFFU, 0xFFU};
+
+static appGattCacheRecord_t mGattCacheRecord;
+static appGattCacheStats_t mGattCacheStats;
+
+/* Bond NVM index of each peer, gInvalidNvmIndex_c when it is not bonded */
+static uint8_t maGattCacheBond[gAppMaxConnections_c];
+static bool_t maGattCacheIndicated[gAppMaxConnections_c];
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static void App_GattCacheSetAware(uint8_t nvmIndex);
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Computes the Database Hash, after the GATT database is
+*               initialized. A hash other than the one saved makes every bond
+*               change-unaware.
+********************************************************************************** */
+void App_GattCacheInit(void)
+{
+    uint8_t aHash[gGattDatabaseHashSize_c] = {0U};
+    uint16_t length = 0U;
+    uint64_t start = TM_GetTimestamp();
+    uint8_t i;
+
+    for (i = 0U; i < (uint8_t)gAppMaxConnections_c; i++)
+    {
+        maGattCacheBond[i] = gInvalidNvmIndex_c;
+        maGattCacheIndicated[i] = FALSE;
+    }
+
+    (void)GattDb_ComputeDatabaseHash();
+    (void)GattDb_ReadAttribute((uint16_t)value_database_hash, (uint16_t)sizeof(aHash), aHash, &length);
+    mGattCacheStats.hashUs = (uint32_t)(TM_GetTimestamp() - start);
+
+    if ((App_NvmReadGattCache(&mGattCacheRecord) == FALSE) ||
+        (FLib_MemCmp(aHash, mGattCacheRecord.aDbHash, gGattDatabaseHashSize_c) == FALSE))
+    {
+        /* The bonds cached the database of the previous firmware */
+        mGattCacheStats.dbChanged = 1U;
+        FLib_MemCpy(mGattCacheRecord.aDbHash, aHash, gGattDatabaseHashSize_c);
+        mGattCacheRecord.changeUnaware = mcGattCacheAllBonds_c;
+        if (App_NvmWriteGattCache(&mGattCacheRecord) == FALSE)
+        {
+            mGattCacheStats.errors++;
+        }
+    }
+    TRACE_INFO("Database Hash in %u us, changed %u, change-unaware bonds 0x%x",
+               mGattCacheStats.hashUs, mGattCacheStats.dbChanged, mGattCacheRecord.changeUnaware);
+}
+
+/*! *********************************************************************************
+* \brief        Peer connected. A bonded peer, known by its address, is bound to
+*               its bond now: it may read the Database Hash before the link is
+*               encrypted, the characteristic does not require it.
+*
+* \param[in]    deviceId        Peer.
+********************************************************************************** */
+void App_GattCacheConnected(deviceId_t deviceId)
+{
+    bool_t isBonded = FALSE;
+    uint8_t nvmIndex = gInvalidNvmIndex_c;
+
+    if ((deviceId < (deviceId_t)gAppMaxConnections_c) &&
+        (gBleSuccess_c == Gap_CheckIfBonded(deviceId, &isBonded, &nvmIndex)) &&
+        (isBonded == TRUE) && (nvmIndex < (uint8_t)gMaxBondedDevices_c))
+    {
+        maGattCacheBond[deviceId] = nvmIndex;
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Link encrypted. A new bond discovers the current database; an
+*               existing change-unaware one is sent Service Changed if it
+*               enabled the indication.
+*
+* \param[in]    deviceId        Peer.
+* \param[in]    newBond         Encrypted by a pairing that bonded.
+********************************************************************************** */
+void App_GattCacheLinkSecured(deviceId_t deviceId, bool_t newBond)
+{
+    bool_t isBonded = FALSE;
+    bool_t active = FALSE;
+    uint8_t nvmIndex = gInvalidNvmIndex_c;
+
+    if ((deviceId < (deviceId_t)gAppMaxConnections_c) &&
+        (gBleSuccess_c == Gap_CheckIfBonded(deviceId, &isBonded, &nvmIndex)) &&
+        (isBonded == TRUE) && (nvmIndex < (uint8_t)gMaxBondedDevices_c))
+    {
+        maGattCacheBond[deviceId] = nvmIndex;
+        if (newBond == TRUE)
+        {
+            App_GattCacheSetAware(nvmIndex);
+        }
+        else if (((mGattCacheRecord.changeUnaware & (1U << nvmIndex)) != 0U) &&
+                 (maGattCacheIndicated[deviceId] == FALSE) &&
+                 (gBleSuccess_c == Gap_CheckIndicationStatus(deviceId, (uint16_t)cccd_service_changed, &active)) &&
+                 (active == TRUE) &&
+                 (gBleSuccess_c == GattServer_SendInstantValueIndication(deviceId, (uint16_t)value_service_changed,
+                                                                         (uint16_t)sizeof(maGattCacheChangedRange),
+                                                                         maGattCacheChangedRange)))
+        {
+            maGattCacheIndicated[deviceId] = TRUE;
+            mGattCacheStats.indications++;
+        }
+        else
+        {
+            ; /* Change-aware, or finds out through the Database Hash */
+        }
+    }
+}
+
+/*! *********************************************************************************
+* \brief        The peer read the Database Hash: it is change-aware.
+********************************************************************************** */
+void App_GattCacheHashRead(deviceId_t deviceId)
+{
+    if ((deviceId < (deviceId_t)gAppMaxConnections_c) && (maGattCacheBond[deviceId] != gInvalidNvmIndex_c) &&
+        ((mGattCacheRecord.changeUnaware & (1U << maGattCacheBond[deviceId])) != 0U))
+    {
+        mGattCacheStats.hashReads++;
+        App_GattCacheSetAware(maGattCacheBond[deviceId]);
+    }
+}
+
+/*! *********************************************************************************
+* \brief        The peer confirmed an indication: Service Changed, if one is
+*               outstanding, is the only one the keyfob sends.
+********************************************************************************** */
+void App_GattCacheConfirmed(deviceId_t deviceId)
+{
+    if ((deviceId < (deviceId_t)gAppMaxConnections_c) && (maGattCacheIndicated[deviceId] == TRUE))
+    {
+        maGattCacheIndicated[deviceId] = FALSE;
+        mGattCacheStats.confirmations++;
+        App_GattCacheSetAware(maGattCacheBond[deviceId]);
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Peer disconnected. An unconfirmed Service Changed is sent again
+*               on the next connection.
+********************************************************************************** */
+void App_GattCacheDisconnected(deviceId_t deviceId)
+{
+    if (deviceId < (deviceId_t)gAppMaxConnections_c)
+    {
+        maGattCacheBond[deviceId] = gInvalidNvmIndex_c;
+        maGattCacheIndicated[deviceId] = FALSE;
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Bonds not told of the last database change, bit n: NVM index n.
+********************************************************************************** */
+uint32_t App_GattCacheChangeUnaware(void)
+{
+    return mGattCacheRecord.changeUnaware;
+}
+
+/*! *********************************************************************************
+* \brief        GATT caching counters.
+********************************************************************************** */
+const appGattCacheStats_t *App_GattCacheGetStats(void)
+{
+    return &mGattCacheStats;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Saves a bond as change-aware, if it was not.
+********************************************************************************** */
+static void App_GattCacheSetAware(uint8_t nvmIndex)
+{
+    if ((nvmIndex < (uint8_t)gMaxBondedDevices_c) &&
+        ((mGattCacheRecord.changeUnaware & (1U << nvmIndex)) != 0U))
+    {
+        mGattCacheRecord.changeUnaware &= ~(1U << nvmIndex);
+        if (App_NvmWriteGattCache(&mGattCacheRecord) == FALSE)
+        {
+            mGattCacheStats.errors++;
+        }
+    }
+}
+
+#endif /* gGattCaching_d */
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
@@ -0,0 +1,96 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_gatt_cache.h
+*
+* GATT caching of the keyfob database by its clients. The Database Hash is
+* computed at boot and compared with the one saved in NVM: when the database
+* changed (new firmware), every bond becomes change-unaware. A change-unaware
+* bonded client gets a Service Changed indication of the whole handle range
+* once its link is encrypted, and becomes change-aware when it confirms it or
+* reads the Database Hash. Clients keep their cached discovery otherwise, a
+* reconnection then costs one Database Hash read instead of a full discovery.
+* Client Supported Features and the Database Out Of Sync errors of Robust
+* Caching are handled by the host stack.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef APP_GATT_CACHE_H
+#define APP_GATT_CACHE_H
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "ble_general.h"
+#include "gatt_types.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+/*! \brief  NVM record: the Database Hash and the bonds, by NVM index, not
+ *          told of the change to it yet. */
+typedef PACKED_STRUCT appGattCacheRecord_tag
+{
+    uint8_t     aDbHash[gGattDatabaseHashSize_c];
+    uint32_t    changeUnaware;
+}appGattCacheRecord_t;
+
+/*! \brief  GATT caching counters. */
+typedef struct appGattCacheStats_tag
+{
+    uint32_t    hashUs;             /*!< Database Hash computation at boot */
+    uint32_t    indications;        /*!< Service Changed indications sent */
+    uint32_t    confirmations;      /*!< Of them, confirmed */
+    uint32_t    hashReads;          /*!< Database Hash reads by change-unaware bonds */
+    uint32_t    errors;             /*!< Record writes that failed */
+    uint8_t     dbChanged;          /*!< Database changed since the last boot */
+}appGattCacheStats_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(gGattCaching_d) && (gGattCaching_d == 1)
+void App_GattCacheInit(void);
+void App_GattCacheConnected(deviceId_t deviceId);
+void App_GattCacheLinkSecured(deviceId_t deviceId, bool_t newBond);
+void App_GattCacheHashRead(deviceId_t deviceId);
+void App_GattCacheConfirmed(deviceId_t deviceId);
+void App_GattCacheDisconnected(deviceId_t deviceId);
+uint32_t App_GattCacheChangeUnaware(void);
+const appGattCacheStats_t *App_GattCacheGetStats(void);
+#else
+#define App_GattCacheInit()
+#define App_GattCacheConnected(deviceId)
+#define App_GattCacheLinkSecured(deviceId, newBond)
+#define App_GattCacheHashRead(deviceId)
+#define App_GattCacheConfirmed(deviceId)
+#define App_GattCacheDisconnected(deviceId)
+#endif /* gGattCaching_d */
+
+/* Record storage, app_nvm.c. */
+bool_t App_NvmReadGattCache(appGattCacheRecord_t *pRecord);
+bool_t App_NvmWriteGattCache(const appGattCacheRecord_t *pRecord);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_GATT_CACHE_H */
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
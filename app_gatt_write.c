@@ -0,0 +1,266 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_gatt_write.c
+*
+* Client writes of the application characteristic values. maGattWriteTable
+* holds one descriptor for each handle of the gatt_db.h enumeration up to the
+* last bound value, indexed by the handle, generated from the GATT_WRITE_*
+* bindings of gatt_db.h (gatt_write_x.h): a write finds what it does, the
+* parameter or key it sets, the value width and how the value is kept in the
+* GATT database with a single read, where the characteristic registries were
+* scanned one after the other. The bounds of a parameter are those of
+* SystemParamsRegistry, indexed by the parameter ID.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "FunctionLib.h"
+#include "fsl_adapter_reset.h"
+#include "ble_general.h"
+#include "gatt_db_app_interface.h"
+#include "gatt_db_handles.h"
+#include "app_nvm.h"
+#include "app_counters.h"
+#include "app_params_tlv.h"
+#include "app_gatt_write.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+/* gatt_write_x.h expansion of the gatt_db.h bindings */
+#define XWRITE_PARAM(name, id)          [name] = {(uint8_t)gAppGattWriteParam_c, (uint8_t)(id), \
+                                                  (uint8_t)sizeof(int32_t), gAppGattWriteBigEndian_c},
+#define XWRITE_COUNTER(name, id)        [name] = {(uint8_t)gAppGattWriteCounter_c, (uint8_t)(id), \
+                                                  (uint8_t)sizeof(uint32_t), gAppGattWriteBigEndian_c},
+#define XWRITE_KEY(name, id, size)      [name] = {(uint8_t)gAppGattWriteKey_c, (uint8_t)(id), (uint8_t)(size), 0U},
+#define XWRITE_RESET(name)              [name] = {(uint8_t)gAppGattWriteReset_c, 0U, (uint8_t)sizeof(int32_t), 0U},
+#define XWRITE_PARAMS_TLV(name)         [name] = {(uint8_t)gAppGattWriteParamsTlv_c, 0U, 0U, 0U},
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+/* Handles bound in gatt_db.h, the others are gAppGattWriteNone_c */
+static const appGattWrite_t maGattWriteTable[] =
+{
+#include "gatt_write_x.h"
+};
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static attErrorCode_t App_GattWriteParam(uint16_t handle, const appGattWrite_t *pWrite,
+                                         const uint8_t *pValue, uint16_t length);
+static attErrorCode_t App_GattWriteKey(uint16_t handle, const appGattWrite_t *pWrite,
+                                       const uint8_t *pValue, uint16_t length);
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Write descriptor of a handle.
+*
+* \return       The descriptor, NULL if a write of the handle is not the
+*               application's.
+********************************************************************************** */
+const appGattWrite_t *App_GattWriteLookup(uint16_t handle)
+{
+    const appGattWrite_t *pWrite = NULL;
+
+    if ((handle < NumberOfElements(maGattWriteTable)) &&
+        (maGattWriteTable[handle].kind != (uint8_t)gAppGattWriteNone_c))
+    {
+        pWrite = &maGattWriteTable[handle];
+    }
+    return pWrite;
+}
+
+/*! *********************************************************************************
+* \brief        Applies a client write of an application characteristic value:
+*               sets the parameter or key, then the value in the GATT database.
+*               A value out of bounds or of a wrong length changes nothing.
+*
+* \param[in]    handle          Handle written.
+* \param[in]    pValue          Value written.
+* \param[in]    length          Its length.
+*
+* \return       The ATT status to answer the write with.
+********************************************************************************** */
+attErrorCode_t App_GattWrite(uint16_t handle, const uint8_t *pValue, uint16_t length)
+{
+    const appGattWrite_t *pWrite = App_GattWriteLookup(handle);
+    attErrorCode_t status = gAttErrCodeInvalidHandle_c;
+
+    if (pWrite != NULL)
+    {
+        switch ((appGattWriteKind_t)pWrite->kind)
+        {
+            case gAppGattWriteParam_c:
+            {
+                status = App_GattWriteParam(handle, pWrite, pValue, length);
+            }
+            break;
+
+            case gAppGattWriteKey_c:
+            {
+                status = App_GattWriteKey(handle, pWrite, pValue, length);
+            }
+            break;
+
+            case gAppGattWriteReset_c:
+            {
+                (void)App_NvmFlushSystemParams(TRUE);
+                App_CountersCompact(gAppCounterCompactShutdown_c);
+                HAL_ResetMCU();
+                status = gAttErrCodeNoError_c;
+            }
+            break;
+
+            case gAppGattWriteParamsTlv_c:
+            {
+                status = App_ParamsTlvWrite(pValue, length);
+            }
+            break;
+
+            case gAppGattWriteCounter_c:
+            {
+                status = gAttErrCodeWriteNotPermitted_c;
+            }
+            break;
+
+            default:
+            {
+                ; /* No action required */
+            }
+            break;
+        }
+    }
+    return status;
+}
+
+/*! *********************************************************************************
+* \brief        Sets a value served on read to its current content, before the
+*               read: the count of a counter. Other handles are left as they are.
+*
+* \param[in]    handle          Handle read.
+********************************************************************************** */
+void App_GattWriteRefresh(uint16_t handle)
+{
+    const appGattWrite_t *pWrite = App_GattWriteLookup(handle);
+    uint8_t aValue[sizeof(uint32_t)];
+    uint32_t count;
+    uint8_t i;
+
+    if ((pWrite != NULL) && (pWrite->kind == (uint8_t)gAppGattWriteCounter_c))
+    {
+        count = App_CounterGet((appCounterId_t)pWrite->id);
+        for (i = 0U; i < (uint8_t)sizeof(aValue); i++)
+        {
+            aValue[i] = (uint8_t)(count >> (8U * ((uint32_t)sizeof(aValue) - 1U - i)));
+        }
+        (void)GattDb_WriteAttribute(handle, (uint16_t)sizeof(aValue), aValue);
+    }
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        System parameter written, signed, least significant byte first.
+********************************************************************************** */
+static attErrorCode_t App_GattWriteParam(uint16_t handle, const appGattWrite_t *pWrite,
+                                         const uint8_t *pValue, uint16_t length)
+{
+    const systemItem_t *pItem = &SystemParamsRegistry[pWrite->id];
+    attErrorCode_t status = gAttErrCodeNoError_c;
+    uint8_t aStored[sizeof(int32_t)];
+    uint32_t raw = 0U;
+    int32_t value;
+    uint16_t i;
+
+    if (((length != 1U) && (length != 2U) && (length != 4U)) || (length > pWrite->size))
+    {
+        status = gAttErrCodeInvalidAttributeValueLength_c;
+    }
+    else
+    {
+        for (i = length; i > 0U; i--)
+        {
+            raw = (raw << 8U) | pValue[i - 1U];
+        }
+        if ((length < sizeof(int32_t)) && (((raw >> ((8U * length) - 1U)) & 1U) != 0U))
+        {
+            raw |= 0xFFFFFFFFU << (8U * length);
+        }
+        value = (int32_t)raw;
+
+        if ((value < pItem->min_value) || (value > pItem->max_value))
+        {
+            status = gAttErrCodeOutOfRange_c;
+        }
+        else if (App_NvmWriteSystemParam((systemParamID_t)pWrite->id, value) != gBleSuccess_c)
+        {
+            status = gAttErrCodeUnlikelyError_c;
+        }
+        else
+        {
+            for (i = 0U; i < length; i++)
+            {
+                aStored[i] = ((pWrite->flags & gAppGattWriteBigEndian_c) != 0U) ?
+                             (uint8_t)(raw >> (8U * (length - 1U - i))) : pValue[i];
+            }
+            if (GattDb_WriteAttribute(handle, length, aStored) != gBleSuccess_c)
+            {
+                status = gAttErrCodeUnlikelyError_c;
+            }
+        }
+    }
+    return status;
+}
+
+/*! *********************************************************************************
+* \brief        BLE key or address written, as is.
+********************************************************************************** */
+static attErrorCode_t App_GattWriteKey(uint16_t handle, const appGattWrite_t *pWrite,
+                                       const uint8_t *pValue, uint16_t length)
+{
+    attErrorCode_t status = gAttErrCodeNoError_c;
+    uint8_t aKey[KEY_MAX_SIZE];
+
+    if ((length != pWrite->size) || (length > sizeof(aKey)))
+    {
+        status = gAttErrCodeInvalidAttributeValueLength_c;
+    }
+    else
+    {
+        FLib_MemCpy(aKey, pValue, length);
+        if ((App_NvmWriteBleKey((bleKeysID_t)pWrite->id, aKey, length) != gBleSuccess_c) ||
+            (GattDb_WriteAttribute(handle, length, aKey) != gBleSuccess_c))
+        {
+            status = gAttErrCodeUnlikelyError_c;
+        }
+    }
+    return status;
+}
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
@@ -0,0 +1,83 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_gatt_write.h
+*
+* Client writes of the application characteristic values (system parameters,
+* BLE keys, reset command), dispatched through a table indexed by attribute
+* handle.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef APP_GATT_WRITE_H
+#define APP_GATT_WRITE_H
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "att_errors.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+/*! The value is kept in the GATT database most significant byte first, it is
+    written least significant byte first */
+#define gAppGattWriteBigEndian_c             (0x01U)
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+/*! \brief  What a write of the characteristic value does. */
+typedef enum appGattWriteKind_tag
+{
+    gAppGattWriteNone_c = 0,        /*!< Not an application value, no descriptor */
+    gAppGattWriteParam_c,           /*!< System parameter, signed, 1, 2 or 4 bytes */
+    gAppGattWriteKey_c,             /*!< BLE key or address, exactly its size */
+    gAppGattWriteReset_c,           /*!< Any value resets the device */
+    gAppGattWriteParamsTlv_c,       /*!< All parameters TLV record, app_params_tlv.h */
+    gAppGattWriteCounter_c          /*!< Lifetime counter, app_counters.h: not written,
+                                         set to the current count before a read */
+}appGattWriteKind_t;
+
+/*! \brief  Write descriptor of a characteristic value, at the index of its handle. */
+typedef struct appGattWrite_tag
+{
+    uint8_t     kind;               /*!< appGattWriteKind_t */
+    uint8_t     id;                 /*!< systemParamID_t, its min/max in SystemParamsRegistry, bleKeysID_t
+                                         or appCounterId_t */
+    uint8_t     size;               /*!< Longest value, bytes */
+    uint8_t     flags;              /*!< gAppGattWriteBigEndian_c */
+}appGattWrite_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+const appGattWrite_t *App_GattWriteLookup(uint16_t handle);
+attErrorCode_t App_GattWrite(uint16_t handle, const uint8_t *pValue, uint16_t length);
+void App_GattWriteRefresh(uint16_t handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_GATT_WRITE_H */
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
@@ -0,0 +1,331 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_latency.c
+*
+* Per-peer timestamped milestone recorder for the CCC owner pairing and
+* passive entry flows. Timestamps come from the timer manager time base
+* (TM_GetTimestamp, microseconds). Each connection is one transaction; when
+* it ends the phase durations are folded into min/avg/max statistics and a
+* coarse histogram that can be dumped from the shell.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "fsl_component_timer_manager.h"
+#include "FunctionLib.h"
+#include "ble_general.h"
+#include "app_latency.h"
+
+#if defined(gAppLatencyRecorder_d) && (gAppLatencyRecorder_d == 1)
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mcLatencyMilestoneBit(milestone)     (1UL << (uint32_t)(milestone))
+#define mcLatencyUsToMs(us)                  ((us) / 1000U)
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static appLatencyRecord_t maLatencyRecord[gAppMaxConnections_c];
+static appLatencyStats_t maLatencyStats[mLatencyMilestoneMax_c];
+static appLatencyStats_t mLatencyTotalStats;
+
+/* Scan match happens before a device ID exists; kept until the connection */
+static uint64_t mLatencyPendingScanTs = 0U;
+
+/* Upper limit (ms, exclusive) of each histogram bucket; the last one is open */
+static const uint32_t maLatencyBucketLimitMs[gAppLatencyHistBuckets_c] =
+{
+    5U, 10U, 20U, 50U, 100U, 200U, 500U, 1000U, 0xFFFFFFFFU
+};
+
+static const char * const maLatencyName[mLatencyMilestoneMax_c] =
+{
+    "scan_match",
+    "connected",
+    "dk_handles",
+    "psm_channel",
+    "spake_request",
+    "spake_verify",
+    "first_approach",
+    "pairing_complete",
+    "std_transaction",
+    "ranging_session",
+};
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static void App_LatencyAddSample(appLatencyStats_t *pStats, uint32_t durationUs);
+static void App_LatencyCommit(appLatencyRecord_t *pRecord);
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Records that a milestone was reached for a peer.
+*
+*               mLatencyScanMatch_c may be marked with gInvalidDeviceId_c; it is then
+*               attached to the next connection. mLatencyConnected_c opens a new
+*               transaction. Only the first occurrence of a milestone is kept.
+*               mLatencyRangingSession_c closes the transaction.
+*
+* \param[in]    deviceId        Peer device ID.
+* \param[in]    milestone       Milestone reached.
+********************************************************************************** */
+void App_LatencyMark(deviceId_t deviceId, appLatencyMilestone_t milestone)
+{
+    uint64_t now = TM_GetTimestamp();
+
+    if (milestone == mLatencyScanMatch_c)
+    {
+        mLatencyPendingScanTs = now;
+    }
+    else if ((deviceId < (deviceId_t)gAppMaxConnections_c) && (milestone < mLatencyMilestoneMax_c))
+    {
+        appLatencyRecord_t *pRecord = &maLatencyRecord[deviceId];
+
+        if (milestone == mLatencyConnected_c)
+        {
+            FLib_MemSet(pRecord, 0x00, sizeof(appLatencyRecord_t));
+            if (mLatencyPendingScanTs != 0U)
+            {
+                pRecord->aTimestamp[mLatencyScanMatch_c] = mLatencyPendingScanTs;
+                pRecord->reachedMask |= mcLatencyMilestoneBit(mLatencyScanMatch_c);
+                mLatencyPendingScanTs = 0U;
+            }
+        }
+
+        if ((pRecord->reachedMask & mcLatencyMilestoneBit(milestone)) == 0U)
+        {
+            pRecord->aTimestamp[milestone] = now;
+            pRecord->reachedMask |= mcLatencyMilestoneBit(milestone);
+        }
+
+        if (milestone == mLatencyRangingSession_c)
+        {
+            App_LatencyCommit(pRecord);
+        }
+    }
+    else
+    {
+        /* For MISRA compliance */
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Closes the transaction of a peer (disconnection). Phases reached so
+*               far are folded into the statistics if not already done.
+*
+* \param[in]    deviceId        Peer device ID.
+********************************************************************************** */
+void App_LatencyClose(deviceId_t deviceId)
+{
+    if (deviceId < (deviceId_t)gAppMaxConnections_c)
+    {
+        App_LatencyCommit(&maLatencyRecord[deviceId]);
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Clears the aggregated statistics.
+********************************************************************************** */
+void App_LatencyResetStats(void)
+{
+    FLib_MemSet(maLatencyStats, 0x00, sizeof(maLatencyStats));
+    FLib_MemSet(&mLatencyTotalStats, 0x00, sizeof(mLatencyTotalStats));
+}
+
+/*! *********************************************************************************
+* \brief        Returns the current (or last) transaction of a peer.
+*
+* \param[in]    deviceId        Peer device ID.
+*
+* \return       Pointer to the record, NULL if deviceId is out of range.
+********************************************************************************** */
+const appLatencyRecord_t* App_LatencyGetRecord(deviceId_t deviceId)
+{
+    const appLatencyRecord_t *pRecord = NULL;
+
+    if (deviceId < (deviceId_t)gAppMaxConnections_c)
+    {
+        pRecord = &maLatencyRecord[deviceId];
+    }
+    return pRecord;
+}
+
+/*! *********************************************************************************
+* \brief        Walks the milestones of a transaction in the order they were
+*               reached, which is not the enum order on every flow (e.g. First
+*               Approach before pairing). Equal timestamps keep the enum order.
+*
+* \param[in]    pRecord         Transaction record.
+* \param[in]    milestone       Current milestone, mLatencyMilestoneMax_c to start.
+*
+* \return       The reached milestone following it in time, mLatencyMilestoneMax_c
+*               after the last one.
+********************************************************************************** */
+appLatencyMilestone_t App_LatencyGetNext(const appLatencyRecord_t *pRecord, appLatencyMilestone_t milestone)
+{
+    uint32_t next = (uint32_t)mLatencyMilestoneMax_c;
+    uint32_t m;
+
+    for (m = 0U; m < (uint32_t)mLatencyMilestoneMax_c; m++)
+    {
+        if (((pRecord->reachedMask & mcLatencyMilestoneBit(m)) != 0U) &&
+            ((milestone >= mLatencyMilestoneMax_c) ||
+             (pRecord->aTimestamp[m] > pRecord->aTimestamp[milestone]) ||
+             ((pRecord->aTimestamp[m] == pRecord->aTimestamp[milestone]) && (m > (uint32_t)milestone))) &&
+            ((next == (uint32_t)mLatencyMilestoneMax_c) ||
+             (pRecord->aTimestamp[m] < pRecord->aTimestamp[next])))
+        {
+            next = m;
+        }
+    }
+    return (appLatencyMilestone_t)next;
+}
+
+/*! *********************************************************************************
+* \brief        Returns the statistics of the phase ending at a milestone.
+*
+* \param[in]    milestone       Milestone ending the phase.
+*
+* \return       Pointer to the statistics, NULL if milestone is out of range.
+********************************************************************************** */
+const appLatencyStats_t* App_LatencyGetStats(appLatencyMilestone_t milestone)
+{
+    const appLatencyStats_t *pStats = NULL;
+
+    if (milestone < mLatencyMilestoneMax_c)
+    {
+        pStats = &maLatencyStats[milestone];
+    }
+    return pStats;
+}
+
+/*! *********************************************************************************
+* \brief        Returns the statistics of the whole transaction, from the first to
+*               the last milestone reached.
+********************************************************************************** */
+const appLatencyStats_t* App_LatencyGetTotalStats(void)
+{
+    return &mLatencyTotalStats;
+}
+
+/*! *********************************************************************************
+* \brief        Returns the printable name of a milestone.
+********************************************************************************** */
+const char* App_LatencyGetName(appLatencyMilestone_t milestone)
+{
+    const char *pName = "unknown";
+
+    if (milestone < mLatencyMilestoneMax_c)
+    {
+        pName = maLatencyName[milestone];
+    }
+    return pName;
+}
+
+/*! *********************************************************************************
+* \brief        Returns the upper limit (ms, exclusive) of a histogram bucket.
+********************************************************************************** */
+uint32_t App_LatencyGetBucketLimitMs(uint8_t bucket)
+{
+    uint32_t limit = 0U;
+
+    if (bucket < gAppLatencyHistBuckets_c)
+    {
+        limit = maLatencyBucketLimitMs[bucket];
+    }
+    return limit;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Adds one duration sample to a statistics entry.
+*
+* \param[in]    pStats          Statistics entry.
+* \param[in]    durationUs      Duration in microseconds.
+********************************************************************************** */
+static void App_LatencyAddSample(appLatencyStats_t *pStats, uint32_t durationUs)
+{
+    uint32_t durationMs = mcLatencyUsToMs(durationUs);
+    uint8_t bucket = 0U;
+
+    if ((pStats->count == 0U) || (durationUs < pStats->min))
+    {
+        pStats->min = durationUs;
+    }
+    if (durationUs > pStats->max)
+    {
+        pStats->max = durationUs;
+    }
+    pStats->sum += durationUs;
+    pStats->count++;
+
+    while ((bucket < (gAppLatencyHistBuckets_c - 1U)) && (durationMs >= maLatencyBucketLimitMs[bucket]))
+    {
+        bucket++;
+    }
+    if (pStats->aHistogram[bucket] < 0xFFFFU)
+    {
+        pStats->aHistogram[bucket]++;
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Folds the phases of a transaction into the statistics. Each phase
+*               ends at a milestone and starts at the one reached just before it;
+*               the total runs from the first to the last one reached.
+*
+* \param[in]    pRecord         Transaction record.
+********************************************************************************** */
+static void App_LatencyCommit(appLatencyRecord_t *pRecord)
+{
+    appLatencyMilestone_t first;
+    appLatencyMilestone_t prev;
+    appLatencyMilestone_t m;
+
+    if ((pRecord->committed == FALSE) && (pRecord->reachedMask != 0U))
+    {
+        first = App_LatencyGetNext(pRecord, mLatencyMilestoneMax_c);
+        prev = first;
+        for (m = App_LatencyGetNext(pRecord, first); m < mLatencyMilestoneMax_c; m = App_LatencyGetNext(pRecord, m))
+        {
+            App_LatencyAddSample(&maLatencyStats[m], (uint32_t)(pRecord->aTimestamp[m] - pRecord->aTimestamp[prev]));
+            prev = m;
+        }
+
+        if (prev != first)
+        {
+            App_LatencyAddSample(&mLatencyTotalStats, (uint32_t)(pRecord->aTimestamp[prev] - pRecord->aTimestamp[first]));
+        }
+        pRecord->committed = TRUE;
+    }
+}
+#endif /* gAppLatencyRecorder_d */
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
@@ -0,0 +1,115 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_latency.h
+*
+* Per-peer timestamped milestone recorder for the CCC owner pairing and
+* passive entry flows.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef APP_LATENCY_H
+#define APP_LATENCY_H
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "ble_general.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+/*! Enable/disable the CCC latency milestone recorder.
+    Redefine it in the app_preinclude.h file */
+#ifndef gAppLatencyRecorder_d
+#define gAppLatencyRecorder_d                0
+#endif
+
+/*! Number of histogram buckets kept for each phase */
+#define gAppLatencyHistBuckets_c             (9U)
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+/*! \brief  CCC flow milestones, in the order they are expected to be reached.
+ *
+ * The duration of a phase is the time between a milestone and the previous
+ * milestone reached in the same transaction.
+ */
+typedef enum appLatencyMilestone_tag
+{
+    mLatencyScanMatch_c = 0,        /*!< Vehicle advertising matched, connection requested */
+    mLatencyConnected_c,            /*!< Link layer connection established */
+    mLatencyDkHandles_c,            /*!< DK service handles known, from discovery or handle cache */
+    mLatencyPsmChannel_c,           /*!< DK L2CAP credit based channel created */
+    mLatencySpakeRequest_c,         /*!< SPAKE2+ Request received, Response sent */
+    mLatencySpakeVerify_c,          /*!< SPAKE2+ Verify received and answered */
+    mLatencyFirstApproach_c,        /*!< First_Approach_RQ/RS exchanged */
+    mLatencyPairingComplete_c,      /*!< LE Secure Connections pairing complete */
+    mLatencyStdTransaction_c,       /*!< Request_Standard_Transaction sent */
+    mLatencyRangingSession_c,       /*!< Ranging_Session_RQ received, UWB ranging started */
+    mLatencyMilestoneMax_c
+}appLatencyMilestone_t;
+
+/*! \brief  One transaction, i.e. the timestamps of the current connection of a peer. */
+typedef struct appLatencyRecord_tag
+{
+    uint64_t    aTimestamp[mLatencyMilestoneMax_c];  /*!< TM timestamp (us), 0 if not reached */
+    uint32_t    reachedMask;                         /*!< Bit n set when milestone n was reached */
+    bool_t      committed;                           /*!< Already aggregated in the statistics */
+}appLatencyRecord_t;
+
+/*! \brief  Aggregated statistics for one phase. Values are in microseconds. */
+typedef struct appLatencyStats_tag
+{
+    uint32_t    count;
+    uint32_t    min;
+    uint32_t    max;
+    uint64_t    sum;
+    uint16_t    aHistogram[gAppLatencyHistBuckets_c];
+}appLatencyStats_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(gAppLatencyRecorder_d) && (gAppLatencyRecorder_d == 1)
+void App_LatencyMark(deviceId_t deviceId, appLatencyMilestone_t milestone);
+void App_LatencyClose(deviceId_t deviceId);
+void App_LatencyResetStats(void);
+const appLatencyRecord_t* App_LatencyGetRecord(deviceId_t deviceId);
+appLatencyMilestone_t App_LatencyGetNext(const appLatencyRecord_t *pRecord, appLatencyMilestone_t milestone);
+const appLatencyStats_t* App_LatencyGetStats(appLatencyMilestone_t milestone);
+const appLatencyStats_t* App_LatencyGetTotalStats(void);
+const char* App_LatencyGetName(appLatencyMilestone_t milestone);
+uint32_t App_LatencyGetBucketLimitMs(uint8_t bucket);
+#else
+#define App_LatencyMark(deviceId, milestone)
+#define App_LatencyClose(deviceId)
+#define App_LatencyResetStats()
+#endif /* gAppLatencyRecorder_d */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_LATENCY_H */
+
+/*! *********************************************************************************
+ * @}
+ ********************************************************************************** */
@@ -17,6 +17,7 @@
 #include "EmbeddedTypes.h"
 #include "fsl_os_abstraction.h"
 #include "app_conn.h"
+#include "app_trace.h"
 
 #if defined(gAppLowpowerEnabled_d) && (gAppLowpowerEnabled_d>0)
 #include "PWR_Interface.h"
@@ -114,7 +115,9 @@ void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime)
         if (abortIdle == false)
         {
                 /* Enter low power with a maximal timeout */
+                App_TraceEvent(gAppTraceLowPowerEnter_c, (uint32_t)expectedIdleTimeUs, 0U);
                 actualIdleTimeUs = PWR_EnterLowPower(expectedIdleTimeUs);
+                App_TraceEvent(gAppTraceLowPowerExit_c, (uint32_t)actualIdleTimeUs, 0U);
 
                 /* Re enable systicks and compensate systick timebase */
                 PWR_SysticksPostProcess(expectedIdleTimeUs, actualIdleTimeUs);
@@ -20,7 +20,12 @@
 
 #include "ble_config.h"
 #include "ble_general.h"
+#include "fsl_os_abstraction.h"
+#include "fsl_component_timer_manager.h"
 #include "app_conn.h"
+#include "app_counters.h"
+#include "app_gatt_cache.h"
+#include "ccc_credentials.h"
 #include "trace.h"
 #include "motion_sensor.h"
 
@@ -47,6 +52,9 @@
 #define gIdentityHeaderOverhead_c       0U
 #endif /* gAppSecureMode_d */
 
+#define mcParamCrcInit_c                (0xFFFFFFFFU)
+#define mcParamCrcPolynomial_c          (0xEDB88320U)   /* CRC-32, reflected */
+
 /************************************************************************************
 *************************************************************************************
 * Private type definitions
@@ -63,6 +71,11 @@
 #define nvmId_BleLocalKeysId_c           0x4017
 #define nvmId_SystemParamsId_c           0x4018
 #define nvmId_BleKeysId_c                0x4019
+#define nvmId_SystemParamsBlobId_c       0x401A
+#define nvmId_CounterBaseId_c            0x401B
+#define nvmId_CounterJournalId_c         0x401C
+#define nvmId_GattCacheId_c              0x401D
+#define nvmId_CccCredentialsId_c         0x401E
 #endif /* gAppUseNvm_d */
 
 /************************************************************************************
@@ -73,6 +86,47 @@
 static systemParameters_t SystemParams;
 static IrkLtkKeys_t BleKeys;
 
+/* Parameters held by each layout version of the system parameter record.
+   Version 0 is one record per parameter, nvmId_SystemParamsId_c, read once
+   to migrate. The last entry is the current layout, every parameter. */
+#define mcSystemParamsLayoutCurrentCount_c  ((uint8_t)DiagMinIntervalID + 1U)
+
+static const uint8_t maSystemParamsLayoutCount[] =
+{
+    0U,                                 /* 0: per parameter records */
+    (uint8_t)FastScanWindowID + 1U,     /* 1 */
+    mcSystemParamsLayoutCurrentCount_c, /* 2: diagnostics stream */
+};
+
+/* A parameter appended without a version bump, or a bump without its table
+   entry, would load records of the previous layout as the current one */
+_Static_assert(sizeof(maSystemParamsLayoutCount) == (gAppNvmParamSchemaVersion_c + 1U),
+               "maSystemParamsLayoutCount needs one entry per layout version");
+_Static_assert(mcSystemParamsLayoutCurrentCount_c == (uint8_t)ParamMaxID,
+               "Parameters appended: bump gAppNvmParamSchemaVersion_c and add its layout count");
+_Static_assert((uint32_t)ParamMaxID <= gAppNvmParamBlobSlots_c,
+               "gAppNvmParamBlobSlots_c must hold every parameter");
+
+/* Record image built by the flush */
+static appNvmParamBlob_t mSystemParamsBlob;
+
+/* Counter journal images, saved from here */
+static appCounterBase_t mCounterBaseImage;
+static appCounterDelta_t maCounterJournalImage[gAppCounterJournalSlots_c];
+
+/* GATT caching record image, saved from here */
+static appGattCacheRecord_t mGattCacheImage;
+
+/* CCC credentials record image, saved from here */
+static cccCredentialsRecord_t mCccCredentialsImage;
+
+/* System parameter changes not saved yet */
+static uint32_t mSystemParamsPendingChanges = 0U;
+static uint64_t mSystemParamsFirstDirtyTs = 0U;
+static appNvmParamStats_t mSystemParamsStats;
+static bool_t mSystemParamsTimerOpen = FALSE;
+static TIMER_MANAGER_HANDLE_DEFINE(mSystemParamsTmrId);
+
 #if gAppUseNvm_d
 #if gUnmirroredFeatureSet_d == TRUE
 static bleBondIdentityHeaderBlob_t*  aBondingHeader[gMaxBondedDevices_c];
@@ -83,6 +137,11 @@ static bleBondDataDeviceInfoBlob_t*  aBondingDataDeviceInfo[gMaxBondedDevices_c]
 static bleBondDataDescriptorBlob_t*  aBondingDataDescriptor[gMaxBondedDevices_c *
                                         gcGapMaximumSavedCccds_c];
 static int32_t*                      aSystemParams[ParamMaxID];
+static appNvmParamBlob_t*            aSystemParamsBlob[1];
+static appCounterBase_t*             aCounterBase[1];
+static appCounterDelta_t*            aCounterJournal[gAppCounterJournalSlots_c];
+static appGattCacheRecord_t*         aGattCache[1];
+static cccCredentialsRecord_t*       aCccCredentials[1];
 static bleIrkLtkKeys_t*              aBleKeys[KeyMaxID];
 #if (defined(gAppSecureMode_d) && (gAppSecureMode_d > 0U))
 static bleLocalKeysBlob_t*           aBleLocalKeys[gcSecureModeSavedLocalKeysNo_c];
@@ -129,6 +188,31 @@ NVM_RegisterDataSet(aSystemParams,
                     (uint16_t)sizeof(int32_t) ,
                     nvmId_SystemParamsId_c,
                     (uint16_t)gNVM_NotMirroredInRamAutoRestore_c);
+NVM_RegisterDataSet(aSystemParamsBlob,
+                    1,
+                    (uint16_t)sizeof(appNvmParamBlob_t) ,
+                    nvmId_SystemParamsBlobId_c,
+                    (uint16_t)gNVM_NotMirroredInRamAutoRestore_c);
+NVM_RegisterDataSet(aCounterBase,
+                    1,
+                    (uint16_t)sizeof(appCounterBase_t) ,
+                    nvmId_CounterBaseId_c,
+                    (uint16_t)gNVM_NotMirroredInRamAutoRestore_c);
+NVM_RegisterDataSet(aCounterJournal,
+                    gAppCounterJournalSlots_c,
+                    (uint16_t)sizeof(appCounterDelta_t) ,
+                    nvmId_CounterJournalId_c,
+                    (uint16_t)gNVM_NotMirroredInRamAutoRestore_c);
+NVM_RegisterDataSet(aGattCache,
+                    1,
+                    (uint16_t)sizeof(appGattCacheRecord_t) ,
+                    nvmId_GattCacheId_c,
+                    (uint16_t)gNVM_NotMirroredInRamAutoRestore_c);
+NVM_RegisterDataSet(aCccCredentials,
+                    1,
+                    (uint16_t)sizeof(cccCredentialsRecord_t) ,
+                    nvmId_CccCredentialsId_c,
+                    (uint16_t)gNVM_NotMirroredInRamAutoRestore_c);
 NVM_RegisterDataSet(aBleKeys,
                     KeyMaxID,
                     (uint16_t)sizeof(bleIrkLtkKeys_t) ,
@@ -143,6 +227,11 @@ static bleBondDataDeviceInfoBlob_t  aBondingDataDeviceInfo[gMaxBondedDevices_c];
 static bleBondDataDescriptorBlob_t  aBondingDataDescriptor[gMaxBondedDevices_c *
                                         gcGapMaximumSavedCccds_c];
 static int32_t                      aSystemParams[ParamMaxID];
+static appNvmParamBlob_t            aSystemParamsBlob[1];
+static appCounterBase_t             aCounterBase[1];
+static appCounterDelta_t            aCounterJournal[gAppCounterJournalSlots_c];
+static appGattCacheRecord_t         aGattCache[1];
+static cccCredentialsRecord_t       aCccCredentials[1];
 static bleIrkLtkKeys_t              aBleKeys[KeyMaxID];
 #if (defined(gAppSecureMode_d) && (gAppSecureMode_d > 0U))
 static bleLocalKeysBlob_t           aBleLocalKeys[gcSecureModeSavedLocalKeysNo_c];
@@ -190,6 +279,31 @@ NVM_RegisterDataSet(aSystemParams,
                     (uint16_t)sizeof(int32_t) ,
                     nvmId_SystemParamsId_c,
                     (uint16_t)gNVM_MirroredInRam_c);
+NVM_RegisterDataSet(aSystemParamsBlob,
+                    1,
+                    (uint16_t)sizeof(appNvmParamBlob_t) ,
+                    nvmId_SystemParamsBlobId_c,
+                    (uint16_t)gNVM_MirroredInRam_c);
+NVM_RegisterDataSet(aCounterBase,
+                    1,
+                    (uint16_t)sizeof(appCounterBase_t) ,
+                    nvmId_CounterBaseId_c,
+                    (uint16_t)gNVM_MirroredInRam_c);
+NVM_RegisterDataSet(aCounterJournal,
+                    gAppCounterJournalSlots_c,
+                    (uint16_t)sizeof(appCounterDelta_t) ,
+                    nvmId_CounterJournalId_c,
+                    (uint16_t)gNVM_MirroredInRam_c);
+NVM_RegisterDataSet(aGattCache,
+                    1,
+                    (uint16_t)sizeof(appGattCacheRecord_t) ,
+                    nvmId_GattCacheId_c,
+                    (uint16_t)gNVM_MirroredInRam_c);
+NVM_RegisterDataSet(aCccCredentials,
+                    1,
+                    (uint16_t)sizeof(cccCredentialsRecord_t) ,
+                    nvmId_CccCredentialsId_c,
+                    (uint16_t)gNVM_MirroredInRam_c);
 NVM_RegisterDataSet(aBleKeys,
                     KeyMaxID,
                     (uint16_t)sizeof(bleIrkLtkKeys_t) ,
@@ -201,7 +315,7 @@ static bleBondDataBlob_t          maBondDataBlobs[gMaxBondedDevices_c] = {{{{0}}
 #if (defined(gAppSecureMode_d) && (gAppSecureMode_d > 0U))
 static bleLocalKeysBlob_t         aBleLocalKeys[gcSecureModeSavedLocalKeysNo_c]; 
 #endif
-static int32_t                    aSystemParams[ParamMaxID];
+static appNvmParamBlob_t          aSystemParamsBlob[1];
 static bleIrkLtkKeys_t            aBleKeys[KeyMaxID];
 #endif /* gAppUseNvm_d */
 
@@ -215,6 +329,20 @@ static bleIrkLtkKeys_t            aBleKeys[KeyMaxID];
 #else
 static void App_UpdateMsRegister(systemParamID_t id, int32_t value);
 #endif
+static void App_NvmMarkSystemParamDirty(systemParamID_t id);
+static void App_NvmSystemParamsTimerCallback(void *pParam);
+static void App_NvmSystemParamsFlushHandler(appCallbackParam_t param);
+static bleResult_t App_NvmSaveSystemParamsBlob(bool_t sync);
+static bool_t App_NvmSystemParamsBlobValid(const appNvmParamBlob_t *pBlob);
+static uint32_t App_NvmSystemParamsBlobCrc(const appNvmParamBlob_t *pBlob);
+static uint32_t App_NvmCrc32Update(uint32_t crc, const uint8_t *pData, uint32_t length);
+#if gAppUseNvm_d
+static bool_t App_NvmSaveRecord(void *pNvmData, const void *pImage, uint32_t size);
+static uint32_t App_NvmLoadLegacySystemParams(void);
+#if gUnmirroredFeatureSet_d == TRUE
+static void App_NvmEraseLegacySystemParams(void);
+#endif /* gUnmirroredFeatureSet_d */
+#endif /* gAppUseNvm_d */
 /*! *********************************************************************************
 *\fn           bleResult_t App_NvmErase(uint8_t mEntryIdx)
 *\brief        This function erases the data corresponding to an entry.
@@ -1065,66 +1193,71 @@ void*    pLocalKey
 #endif /* (defined(gAppSecureMode_d) && (gAppSecureMode_d > 0U)) */
 
 /*! *********************************************************************************
-*\fn           bleResult_t App_NvmWriteSystemParams()
+*\fn           bleResult_t App_NvmFlushSystemParams(bool_t sync)
+*
+*\brief        Write the system parameter record to NVM if a parameter changed.
 *
-*\brief        Write system parameters to NVM.
+*\param[in]    sync       TRUE to write before returning, e.g. before a reset,
+*                         FALSE to save on idle.
 *
 * \return    bleResult_t
 *
 ********************************************************************************** */
-bleResult_t App_NvmWriteSystemParams()
+bleResult_t App_NvmFlushSystemParams(bool_t sync)
 {
     bleResult_t status = gBleSuccess_c;
-    uint8_t mIdx;
-#if gAppUseNvm_d
-    NVM_Status_t nvmStatus = gNVM_OK_c;
-#endif /* gAppUseNvm_d */
+    uint32_t changes;
+    uint64_t firstDirtyTs;
 
-    for(mIdx=0; mIdx<ParamMaxID; mIdx++)
-    {
-#if gAppUseNvm_d
+    OSA_InterruptDisable();
+    changes = mSystemParamsPendingChanges;
+    firstDirtyTs = mSystemParamsFirstDirtyTs;
+    mSystemParamsPendingChanges = 0U;
+    OSA_InterruptEnable();
 
-#if gUnmirroredFeatureSet_d == TRUE
-        uint32_t mSize = 0;
-        void**   ppNvmData = (void**)&aSystemParams[mIdx];
-        mSize =  sizeof(int32_t);
+    if (mSystemParamsTimerOpen == TRUE)
+    {
+        (void)TM_Stop((timer_handle_t)mSystemParamsTmrId);
+    }
 
-        if(gNVM_OK_c == NvMoveToRam(ppNvmData))
+    if (changes != 0U)
+    {
+        status = App_NvmSaveSystemParamsBlob(sync);
+        mSystemParamsStats.flushes++;
+        if (status == gBleSuccess_c)
         {
-            FLib_MemCpy(*ppNvmData, &SystemParams.system_params.buffer[mIdx], mSize);
-            nvmStatus = NvSaveOnIdle(ppNvmData, FALSE);
+            mSystemParamsStats.recordsSaved++;
+            mSystemParamsStats.recordsAvoided += (changes * (uint32_t)ParamMaxID) - 1U;
         }
         else
         {
-            *ppNvmData = &SystemParams.system_params.buffer[mIdx];
-            nvmStatus = NvSyncSave(ppNvmData, FALSE);
-        }
-
-        if (nvmStatus != gNVM_OK_c)
-        {
-            /* An error occured, return error status. */
-            status = gBleNVMError_c;
-        }
-
-#else /* gUnmirroredFeatureSet_d */
-        FLib_MemCpy((void*)&aSystemParams[mIdx], &SystemParams->system_params.buffer[mIdx], sizeof(int32_t));
-        nvmStatus = NvSaveOnIdle((void*)&aSystemParams[mIdx], FALSE);
-
-        if (nvmStatus != gNVM_OK_c)
-        {
-            /* An error occured, return error status.*/
-            status = gBleNVMError_c;
+            /* Not saved: pending again, with changes made meanwhile, and
+               retried after another quiet window or by the next flush */
+            OSA_InterruptDisable();
+            mSystemParamsPendingChanges += changes;
+            mSystemParamsFirstDirtyTs = firstDirtyTs;
+            OSA_InterruptEnable();
+            mSystemParamsStats.errors++;
+            if (mSystemParamsTimerOpen == TRUE)
+            {
+                (void)TM_Start((timer_handle_t)mSystemParamsTmrId, (uint8_t)kTimerModeSingleShot, gAppNvmParamQuietWindowMs_c);
+            }
         }
-#endif /* gUnmirroredFeatureSet_d */
-
-#else /* gAppUseNvm_d */
-        FLib_MemCpy(&aSystemParams[mIdx], &SystemParams->system_params.buffer[mIdx], sizeof(int32_t));
-#endif /* gAppUseNvm_d */
     }
 
     return status;
 }
 
+/*! *********************************************************************************
+*\fn        const appNvmParamStats_t *App_NvmGetParamStats(void)
+*
+*\brief      System parameter persistence counters.
+********************************************************************************** */
+const appNvmParamStats_t *App_NvmGetParamStats(void)
+{
+    return &mSystemParamsStats;
+}
+
 /*! *********************************************************************************
 *\fn        bleResult_t App_NvmReadSystemParams(systemParameters_t **pSysParams)
 *
@@ -1141,6 +1274,8 @@ bleResult_t App_NvmReadSystemParams(systemParameters_t **pSysParams)
 
     if(pSysParams)
     {
+        /* Lifetime step count, kept by the counter journal */
+        SystemParams.system_params.fields.ms_total_step = App_CounterGet(gAppCounterSteps_c);
         *pSysParams = &SystemParams;
         status = gBleSuccess_c;
     }
@@ -1151,77 +1286,119 @@ bleResult_t App_NvmReadSystemParams(systemParameters_t **pSysParams)
     return status;
 }
 
+/*! *********************************************************************************
+*\fn        bleResult_t App_NvmLoadSystemParams(void)
+*
+*\brief      Load the system parameters from their NVM record, in one restore.
+*            Parameters added since the stored layout, and out of range ones,
+*            get their default. An older layout is written back as the current
+*            one.
+*
+* \return  bleResult_t
+********************************************************************************** */
 bleResult_t App_NvmLoadSystemParams(void)
 {
     bleResult_t status = gBleSuccess_c;
+    uint64_t startTs = TM_GetTimestamp();
+    const appNvmParamBlob_t *pBlob = NULL;
+    uint32_t loaded = 0U;
+    uint16_t version = 0U;
+    uint16_t defaults = 0U;
+    int32_t value;
     uint8_t mIdx;
-    for(mIdx=0; mIdx<ParamMaxID; mIdx++)
-    {
+
 #if gAppUseNvm_d
+    /* Called before the host init: restore the datasets now. The host init
+       call then finds the module initialized. */
+    (void)NvModuleInit();
 
 #if gUnmirroredFeatureSet_d == TRUE
-        uint32_t mSize = 0;
-        void**   ppNvmData = (void**)&aSystemParams[mIdx];
-        mSize     = sizeof(int32_t);
-        if(NULL != *ppNvmData)
-        {
-            FLib_MemCpy(&SystemParams.system_params.buffer[mIdx], *ppNvmData, mSize);
-        }
-        else
+    pBlob = aSystemParamsBlob[0];
+#else /* gUnmirroredFeatureSet_d */
+    if(gNVM_OK_c == NvRestoreDataSet((void*)aSystemParamsBlob, FALSE))
+    {
+        pBlob = &aSystemParamsBlob[0];
+    }
+#endif /* gUnmirroredFeatureSet_d */
+
+#else /* gAppUseNvm_d */
+    pBlob = &aSystemParamsBlob[0];
+#endif /* gAppUseNvm_d */
+
+    if((NULL != pBlob) && (TRUE == App_NvmSystemParamsBlobValid(pBlob)))
+    {
+        version = pBlob->version;
+        /* A newer layout only appended parameters: ignore them */
+        loaded = ((uint32_t)pBlob->count < (uint32_t)ParamMaxID) ? pBlob->count : (uint32_t)ParamMaxID;
+        FLib_MemCpy(SystemParams.system_params.buffer, (const void*)pBlob->values, loaded * sizeof(uint32_t));
+    }
+#if gAppUseNvm_d
+    else
+    {
+        /* Missing records already set to default */
+        loaded = App_NvmLoadLegacySystemParams();
+        if(loaded != 0U)
         {
-            FLib_MemCpy(&SystemParams.system_params.buffer[mIdx], &SystemParamsRegistry[mIdx].default_value, mSize);
+            defaults = (uint16_t)((uint32_t)ParamMaxID - loaded);
+            loaded = (uint32_t)ParamMaxID;
         }
+    }
+#endif /* gAppUseNvm_d */
 
-#else /* gUnmirroredFeatureSet_d */
-        if(gNVM_OK_c == NvRestoreDataSet((void*)&aSystemParams[mIdx], FALSE))
+    for(mIdx = 0U; mIdx < (uint8_t)ParamMaxID; mIdx++)
+    {
+        value = (int32_t)SystemParams.system_params.buffer[mIdx];
+        if((mIdx >= loaded) ||
+           (value < SystemParamsRegistry[mIdx].min_value) || (value > SystemParamsRegistry[mIdx].max_value))
         {
-            FLib_MemCpy(&SystemParams.system_params.buffer[mIdx], (void*)&aSystemParams[mIdx], sizeof(int32_t));
+            SystemParams.system_params.buffer[mIdx] = (uint32_t)SystemParamsRegistry[mIdx].default_value;
+            defaults++;
         }
-        else
+    }
+
+    if((loaded != 0U) && (version < gAppNvmParamSchemaVersion_c))
+    {
+        /* Migrate before the old records go */
+        status = App_NvmSaveSystemParamsBlob(TRUE);
+#if gAppUseNvm_d && (gUnmirroredFeatureSet_d == TRUE)
+        if((gBleSuccess_c == status) && (0U == version))
         {
-            status = gBleNVMError_c;
+            App_NvmEraseLegacySystemParams();
         }
-#endif /* gUnmirroredFeatureSet_d */
-
-#else /* gAppUseNvm_d */
-        FLib_MemCpy(&SystemParams.system_params.buffer[mIdx], &aSystemParams[mIdx], sizeof(int32_t));
-#endif /* gAppUseNvm_d */
+#endif
     }
+
+    mSystemParamsStats.loadVersion = version;
+    mSystemParamsStats.loadDefaults = defaults;
+    mSystemParamsStats.loadUs = (uint32_t)(TM_GetTimestamp() - startTs);
     return status;
 }
 
 bleResult_t App_NvmWriteSystemParam(systemParamID_t id, int32_t value)
 {
     bleResult_t status;
-    systemParamID_t eId;
 
     status = gBleNVMError_c;
-    for(eId = 0; eId < ParamMaxID; eId++)
+    if((id < ParamMaxID) &&
+       (value >= SystemParamsRegistry[id].min_value) && (value <= SystemParamsRegistry[id].max_value))
     {
-        if(eId == id)
+        /* Check if the value stored in argv[2] is different from current value */
+        if(SystemParams.system_params.buffer[id] != value)
         {
-            if((value >= SystemParamsRegistry[eId].min_value) && (value <= SystemParamsRegistry[eId].max_value))
-            {
-                /* Check if the value stored in argv[2] is different from current value */
-                if(SystemParams.system_params.buffer[eId] != value)
-                {
-                    /* Write new value */
-                    SystemParams.system_params.buffer[eId] = value;
-                    App_NvmWriteSystemParams();
-                	TRACE_DEBUG("Set %s to %d", SystemParamsRegistry[eId].name, value);
+            /* Write new value, saved once the parameters are quiet */
+            SystemParams.system_params.buffer[id] = value;
+            App_NvmMarkSystemParamDirty(id);
+            TRACE_DEBUG("Set %s to %d", SystemParamsRegistry[id].name, value);
 #ifdef BMW_KEYFOB_EVK_BOARD
     /* No functions required */
 #else
-                	if((eId >= MsThresholdNoMotionDetectionID) && (eId <= MsWristModeID))
-                    {
-                        App_UpdateMsRegister(eId,value);
-                    }
-#endif
-                }
-                status = gBleSuccess_c;
-                break;
+            if((id >= MsThresholdNoMotionDetectionID) && (id <= MsWristModeID))
+            {
+                App_UpdateMsRegister(id,value);
             }
+#endif
         }
+        status = gBleSuccess_c;
     }
     return status;
 }
@@ -1355,30 +1532,229 @@ bleResult_t App_NvmLoadBleKeys(void)
 bleResult_t App_NvmWriteBleKey(bleKeysID_t id, uint8_t *key_bytes, uint16_t key_size)
 {
     bleResult_t status;
-    bleKeysID_t eId;
 
     status = gBleNVMError_c;
-    for(eId = 0; eId < KeyMaxID; eId++)
+    if((id < KeyMaxID) && (key_size == BleKeysRegistry[id].max_size))
     {
-        if(eId == id)
+        /* Check if the value stored in argv[2] is different from current value */
+        if(!FLib_MemCmp(&BleKeys.ble_keys.keys[id], key_bytes, BleKeysRegistry[id].max_size))
         {
-            if((key_size == KEY_MAX_SIZE)||(key_size == BD_ADDR_MAX_SIZE))
-            {
-                /* Check if the value stored in argv[2] is different from current value */
-                if(!FLib_MemCmp(&BleKeys.ble_keys.keys[eId], key_bytes, BleKeysRegistry[eId].max_size))
-                {
-                    /* Write new value */
-                	FLib_MemCpy(&BleKeys.ble_keys.keys[eId], key_bytes, BleKeysRegistry[eId].max_size);
-                    App_NvmWriteBleKeys();
-                    TRACE_DEBUG("%s is set", BleKeysRegistry[id].name);
-                }
-                status = gBleSuccess_c;
-                break;
-        	}
+            /* Write new value */
+            FLib_MemCpy(&BleKeys.ble_keys.keys[id], key_bytes, BleKeysRegistry[id].max_size);
+            App_NvmWriteBleKeys();
+            TRACE_DEBUG("%s is set", BleKeysRegistry[id].name);
         }
+        status = gBleSuccess_c;
     }
     return status;
 }
+/*! *********************************************************************************
+*\fn        bool_t App_NvmReadCounterBase(appCounterBase_t *pBase)
+*
+*\brief      Read the counter journal base record.
+*
+* \return    TRUE if the record exists.
+********************************************************************************** */
+bool_t App_NvmReadCounterBase(appCounterBase_t *pBase)
+{
+    bool_t found = FALSE;
+
+#if gAppUseNvm_d
+#if gUnmirroredFeatureSet_d == TRUE
+    if(NULL != aCounterBase[0])
+    {
+        FLib_MemCpy(pBase, aCounterBase[0], sizeof(appCounterBase_t));
+        found = TRUE;
+    }
+#else /* gUnmirroredFeatureSet_d */
+    if(gNVM_OK_c == NvRestoreDataSet((void*)&aCounterBase[0], FALSE))
+    {
+        FLib_MemCpy(pBase, (void*)&aCounterBase[0], sizeof(appCounterBase_t));
+        found = TRUE;
+    }
+#endif /* gUnmirroredFeatureSet_d */
+#else /* gAppUseNvm_d */
+    (void)pBase;
+#endif /* gAppUseNvm_d */
+
+    return found;
+}
+
+/*! *********************************************************************************
+*\fn        bool_t App_NvmWriteCounterBase(const appCounterBase_t *pBase)
+*
+*\brief      Write the counter journal base record, before returning.
+*
+* \return    TRUE if written.
+********************************************************************************** */
+bool_t App_NvmWriteCounterBase(const appCounterBase_t *pBase)
+{
+    FLib_MemCpy(&mCounterBaseImage, (const void*)pBase, sizeof(appCounterBase_t));
+#if gAppUseNvm_d
+    return App_NvmSaveRecord((void*)&aCounterBase[0], &mCounterBaseImage, sizeof(appCounterBase_t));
+#else /* gAppUseNvm_d */
+    return TRUE;
+#endif /* gAppUseNvm_d */
+}
+
+/*! *********************************************************************************
+*\fn        bool_t App_NvmReadCounterDelta(uint8_t slot, appCounterDelta_t *pDelta)
+*
+*\brief      Read a counter journal delta record.
+*
+* \return    TRUE if the record exists.
+********************************************************************************** */
+bool_t App_NvmReadCounterDelta(uint8_t slot, appCounterDelta_t *pDelta)
+{
+    bool_t found = FALSE;
+
+    if(slot < (uint8_t)gAppCounterJournalSlots_c)
+    {
+#if gAppUseNvm_d
+#if gUnmirroredFeatureSet_d == TRUE
+        if(NULL != aCounterJournal[slot])
+        {
+            FLib_MemCpy(pDelta, aCounterJournal[slot], sizeof(appCounterDelta_t));
+            found = TRUE;
+        }
+#else /* gUnmirroredFeatureSet_d */
+        if(gNVM_OK_c == NvRestoreDataSet((void*)&aCounterJournal[slot], FALSE))
+        {
+            FLib_MemCpy(pDelta, (void*)&aCounterJournal[slot], sizeof(appCounterDelta_t));
+            found = TRUE;
+        }
+#endif /* gUnmirroredFeatureSet_d */
+#else /* gAppUseNvm_d */
+        (void)pDelta;
+#endif /* gAppUseNvm_d */
+    }
+
+    return found;
+}
+
+/*! *********************************************************************************
+*\fn        bool_t App_NvmWriteCounterDelta(uint8_t slot, const appCounterDelta_t *pDelta)
+*
+*\brief      Write a counter journal delta record, before returning: a record
+*            must not reach flash after a later one.
+*
+* \return    TRUE if written.
+********************************************************************************** */
+bool_t App_NvmWriteCounterDelta(uint8_t slot, const appCounterDelta_t *pDelta)
+{
+    bool_t written = FALSE;
+
+    if(slot < (uint8_t)gAppCounterJournalSlots_c)
+    {
+        FLib_MemCpy(&maCounterJournalImage[slot], (const void*)pDelta, sizeof(appCounterDelta_t));
+#if gAppUseNvm_d
+        written = App_NvmSaveRecord((void*)&aCounterJournal[slot], &maCounterJournalImage[slot], sizeof(appCounterDelta_t));
+#else /* gAppUseNvm_d */
+        written = TRUE;
+#endif /* gAppUseNvm_d */
+    }
+
+    return written;
+}
+
+/*! *********************************************************************************
+*\fn        bool_t App_NvmReadGattCache(appGattCacheRecord_t *pRecord)
+*
+*\brief      Read the GATT caching record.
+*
+* \return    TRUE if the record exists.
+********************************************************************************** */
+bool_t App_NvmReadGattCache(appGattCacheRecord_t *pRecord)
+{
+    bool_t found = FALSE;
+
+#if gAppUseNvm_d
+#if gUnmirroredFeatureSet_d == TRUE
+    if(NULL != aGattCache[0])
+    {
+        FLib_MemCpy(pRecord, aGattCache[0], sizeof(appGattCacheRecord_t));
+        found = TRUE;
+    }
+#else /* gUnmirroredFeatureSet_d */
+    if(gNVM_OK_c == NvRestoreDataSet((void*)&aGattCache[0], FALSE))
+    {
+        FLib_MemCpy(pRecord, (void*)&aGattCache[0], sizeof(appGattCacheRecord_t));
+        found = TRUE;
+    }
+#endif /* gUnmirroredFeatureSet_d */
+#else /* gAppUseNvm_d */
+    (void)pRecord;
+#endif /* gAppUseNvm_d */
+
+    return found;
+}
+
+/*! *********************************************************************************
+*\fn        bool_t App_NvmWriteGattCache(const appGattCacheRecord_t *pRecord)
+*
+*\brief      Write the GATT caching record, before returning.
+*
+* \return    TRUE if written.
+********************************************************************************** */
+bool_t App_NvmWriteGattCache(const appGattCacheRecord_t *pRecord)
+{
+    FLib_MemCpy(&mGattCacheImage, (const void*)pRecord, sizeof(appGattCacheRecord_t));
+#if gAppUseNvm_d
+    return App_NvmSaveRecord((void*)&aGattCache[0], &mGattCacheImage, sizeof(appGattCacheRecord_t));
+#else /* gAppUseNvm_d */
+    return TRUE;
+#endif /* gAppUseNvm_d */
+}
+
+/*! *********************************************************************************
+*\fn        bool_t App_NvmReadCccCredentials(cccCredentialsRecord_t *pRecord)
+*
+*\brief      Read the CCC credentials record.
+*
+* \return    TRUE if the record exists.
+********************************************************************************** */
+bool_t App_NvmReadCccCredentials(cccCredentialsRecord_t *pRecord)
+{
+    bool_t found = FALSE;
+
+#if gAppUseNvm_d
+#if gUnmirroredFeatureSet_d == TRUE
+    if(NULL != aCccCredentials[0])
+    {
+        FLib_MemCpy(pRecord, aCccCredentials[0], sizeof(cccCredentialsRecord_t));
+        found = TRUE;
+    }
+#else /* gUnmirroredFeatureSet_d */
+    if(gNVM_OK_c == NvRestoreDataSet((void*)&aCccCredentials[0], FALSE))
+    {
+        FLib_MemCpy(pRecord, (void*)&aCccCredentials[0], sizeof(cccCredentialsRecord_t));
+        found = TRUE;
+    }
+#endif /* gUnmirroredFeatureSet_d */
+#else /* gAppUseNvm_d */
+    (void)pRecord;
+#endif /* gAppUseNvm_d */
+
+    return found;
+}
+
+/*! *********************************************************************************
+*\fn        bool_t App_NvmWriteCccCredentials(const cccCredentialsRecord_t *pRecord)
+*
+*\brief      Write the CCC credentials record, before returning.
+*
+* \return    TRUE if written.
+********************************************************************************** */
+bool_t App_NvmWriteCccCredentials(const cccCredentialsRecord_t *pRecord)
+{
+    FLib_MemCpy(&mCccCredentialsImage, (const void*)pRecord, sizeof(cccCredentialsRecord_t));
+#if gAppUseNvm_d
+    return App_NvmSaveRecord((void*)&aCccCredentials[0], &mCccCredentialsImage, sizeof(cccCredentialsRecord_t));
+#else /* gAppUseNvm_d */
+    return TRUE;
+#endif /* gAppUseNvm_d */
+}
+
 #ifdef BMW_KEYFOB_EVK_BOARD
     /* No functions required */
 #else
@@ -1442,3 +1818,261 @@ static void App_UpdateMsRegister(systemParamID_t id, int32_t value)
     }
 }
 #endif
+
+/*! *********************************************************************************
+* \brief        Marks a changed parameter and restarts the quiet window, unless the
+*               oldest pending change already waited gAppNvmParamMaxDelayMs_c.
+********************************************************************************** */
+static void App_NvmMarkSystemParamDirty(systemParamID_t id)
+{
+    uint64_t now = TM_GetTimestamp();
+    bool_t restart;
+
+    (void)id;
+    OSA_InterruptDisable();
+    if (mSystemParamsPendingChanges == 0U)
+    {
+        mSystemParamsFirstDirtyTs = now;
+    }
+    mSystemParamsPendingChanges++;
+    mSystemParamsStats.changes++;
+    restart = ((now - mSystemParamsFirstDirtyTs) < ((uint64_t)gAppNvmParamMaxDelayMs_c * 1000U)) ? TRUE : FALSE;
+    OSA_InterruptEnable();
+
+    if (mSystemParamsTimerOpen == FALSE)
+    {
+        if (kStatus_TimerSuccess == TM_Open((timer_handle_t)mSystemParamsTmrId))
+        {
+            (void)TM_InstallCallback((timer_handle_t)mSystemParamsTmrId, App_NvmSystemParamsTimerCallback, NULL);
+            mSystemParamsTimerOpen = TRUE;
+        }
+        else
+        {
+            /* No timer, save now */
+            (void)App_NvmFlushSystemParams(FALSE);
+        }
+    }
+
+    if ((mSystemParamsTimerOpen == TRUE) && (restart == TRUE))
+    {
+        (void)TM_Stop((timer_handle_t)mSystemParamsTmrId);
+        (void)TM_Start((timer_handle_t)mSystemParamsTmrId, (uint8_t)kTimerModeSingleShot, gAppNvmParamQuietWindowMs_c);
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Quiet window elapsed, timer task: save from the application task.
+********************************************************************************** */
+static void App_NvmSystemParamsTimerCallback(void *pParam)
+{
+    (void)pParam;
+    /* Out of messages: the changes stay pending and go with the next flush */
+    (void)App_PostCallbackMessageToQueue(App_NvmSystemParamsFlushHandler, NULL, gAppQueueHousekeeping_c);
+}
+
+static void App_NvmSystemParamsFlushHandler(appCallbackParam_t param)
+{
+    (void)param;
+    (void)App_NvmFlushSystemParams(FALSE);
+}
+
+/*! *********************************************************************************
+* \brief        Builds the record from the RAM parameters and saves it.
+********************************************************************************** */
+static bleResult_t App_NvmSaveSystemParamsBlob(bool_t sync)
+{
+    bleResult_t status = gBleSuccess_c;
+#if gAppUseNvm_d
+    NVM_Status_t nvmStatus = gNVM_OK_c;
+#endif /* gAppUseNvm_d */
+
+    FLib_MemSet(&mSystemParamsBlob, 0x00, sizeof(mSystemParamsBlob));
+    mSystemParamsBlob.version = gAppNvmParamSchemaVersion_c;
+    mSystemParamsBlob.count = (uint16_t)ParamMaxID;
+    FLib_MemCpy((void*)mSystemParamsBlob.values, SystemParams.system_params.buffer, sizeof(SystemParams.system_params.buffer));
+    mSystemParamsBlob.crc = App_NvmSystemParamsBlobCrc(&mSystemParamsBlob);
+
+#if gAppUseNvm_d
+
+#if gUnmirroredFeatureSet_d == TRUE
+    void**   ppNvmData = (void**)&aSystemParamsBlob[0];
+
+    if(gNVM_OK_c == NvMoveToRam(ppNvmData))
+    {
+        FLib_MemCpy(*ppNvmData, &mSystemParamsBlob, sizeof(appNvmParamBlob_t));
+        nvmStatus = (sync == TRUE) ? NvSyncSave(ppNvmData, FALSE) : NvSaveOnIdle(ppNvmData, FALSE);
+    }
+    else
+    {
+        *ppNvmData = &mSystemParamsBlob;
+        nvmStatus = NvSyncSave(ppNvmData, FALSE);
+    }
+
+#else /* gUnmirroredFeatureSet_d */
+    FLib_MemCpy((void*)&aSystemParamsBlob[0], &mSystemParamsBlob, sizeof(appNvmParamBlob_t));
+    nvmStatus = (sync == TRUE) ? NvSyncSave((void*)&aSystemParamsBlob[0], FALSE) : NvSaveOnIdle((void*)&aSystemParamsBlob[0], FALSE);
+#endif /* gUnmirroredFeatureSet_d */
+
+    if (nvmStatus != gNVM_OK_c)
+    {
+        /* An error occured, return error status. */
+        status = gBleNVMError_c;
+    }
+
+#else /* gAppUseNvm_d */
+    (void)sync;
+    FLib_MemCpy(&aSystemParamsBlob[0], &mSystemParamsBlob, sizeof(appNvmParamBlob_t));
+#endif /* gAppUseNvm_d */
+
+    return status;
+}
+
+/*! *********************************************************************************
+* \brief        TRUE if the record has a known layout and a matching CRC.
+********************************************************************************** */
+static bool_t App_NvmSystemParamsBlobValid(const appNvmParamBlob_t *pBlob)
+{
+    bool_t valid = FALSE;
+
+    if((pBlob->version == 0U) || (pBlob->count > gAppNvmParamBlobSlots_c))
+    {
+        ; /* Erased or corrupt */
+    }
+    else if((pBlob->version <= gAppNvmParamSchemaVersion_c) &&
+            (pBlob->count != maSystemParamsLayoutCount[pBlob->version]))
+    {
+        ; /* Count not matching the layout */
+    }
+    else
+    {
+        valid = (pBlob->crc == App_NvmSystemParamsBlobCrc(pBlob)) ? TRUE : FALSE;
+    }
+    return valid;
+}
+
+/*! *********************************************************************************
+* \brief        CRC-32 of the version, count and the count values of a record.
+********************************************************************************** */
+static uint32_t App_NvmSystemParamsBlobCrc(const appNvmParamBlob_t *pBlob)
+{
+    uint32_t crc = mcParamCrcInit_c;
+
+    crc = App_NvmCrc32Update(crc, (const uint8_t*)pBlob, 4U);
+    crc = App_NvmCrc32Update(crc, (const uint8_t*)pBlob->values, (uint32_t)pBlob->count * sizeof(uint32_t));
+    return ~crc;
+}
+
+static uint32_t App_NvmCrc32Update(uint32_t crc, const uint8_t *pData, uint32_t length)
+{
+    uint32_t i;
+    uint8_t bit;
+
+    for(i = 0U; i < length; i++)
+    {
+        crc ^= pData[i];
+        for(bit = 0U; bit < 8U; bit++)
+        {
+            crc = ((crc & 1U) != 0U) ? ((crc >> 1) ^ mcParamCrcPolynomial_c) : (crc >> 1);
+        }
+    }
+    return crc;
+}
+
+#if gAppUseNvm_d
+/*! *********************************************************************************
+* \brief        Reads the layout 0 records, one per parameter. Missing ones get
+*               their default.
+*
+* \return       Records found.
+********************************************************************************** */
+static uint32_t App_NvmLoadLegacySystemParams(void)
+{
+    uint32_t found = 0U;
+    uint8_t mIdx;
+
+#if gUnmirroredFeatureSet_d == TRUE
+    for(mIdx = 0U; mIdx < (uint8_t)ParamMaxID; mIdx++)
+    {
+        if(NULL != aSystemParams[mIdx])
+        {
+            FLib_MemCpy(&SystemParams.system_params.buffer[mIdx], aSystemParams[mIdx], sizeof(int32_t));
+            found++;
+        }
+        else
+        {
+            SystemParams.system_params.buffer[mIdx] = (uint32_t)SystemParamsRegistry[mIdx].default_value;
+        }
+    }
+#else /* gUnmirroredFeatureSet_d */
+    if(gNVM_OK_c == NvRestoreDataSet((void*)aSystemParams, TRUE))
+    {
+        FLib_MemCpy(SystemParams.system_params.buffer, (void*)aSystemParams, sizeof(aSystemParams));
+        found = (uint32_t)ParamMaxID;
+    }
+    else
+    {
+        for(mIdx = 0U; mIdx < (uint8_t)ParamMaxID; mIdx++)
+        {
+            SystemParams.system_params.buffer[mIdx] = (uint32_t)SystemParamsRegistry[mIdx].default_value;
+        }
+    }
+#endif /* gUnmirroredFeatureSet_d */
+
+    return found;
+}
+
+#if gUnmirroredFeatureSet_d == TRUE
+/*! *********************************************************************************
+* \brief        Drops the layout 0 records once migrated. Mirrored datasets keep
+*               theirs, they are not read again.
+********************************************************************************** */
+static void App_NvmEraseLegacySystemParams(void)
+{
+    uint8_t mIdx;
+
+    for(mIdx = 0U; mIdx < (uint8_t)ParamMaxID; mIdx++)
+    {
+        if(NULL != aSystemParams[mIdx])
+        {
+            (void)NvErase((void**)&aSystemParams[mIdx]);
+        }
+    }
+}
+#endif /* gUnmirroredFeatureSet_d */
+#endif /* gAppUseNvm_d */
+
+#if gAppUseNvm_d
+/*! *********************************************************************************
+* \brief        Saves a counter or GATT caching record from its RAM image,
+*               before returning.
+*
+* \param[in]    pNvmData        Dataset element: the element pointer when
+*                               unmirrored, the element itself when mirrored.
+* \param[in]    pImage          Record image, static.
+* \param[in]    size            Record size.
+********************************************************************************** */
+static bool_t App_NvmSaveRecord(void *pNvmData, const void *pImage, uint32_t size)
+{
+    NVM_Status_t nvmStatus;
+
+#if gUnmirroredFeatureSet_d == TRUE
+    void**   ppNvmData = (void**)pNvmData;
+
+    if(gNVM_OK_c == NvMoveToRam(ppNvmData))
+    {
+        FLib_MemCpy(*ppNvmData, pImage, size);
+        nvmStatus = NvSyncSave(ppNvmData, FALSE);
+    }
+    else
+    {
+        *ppNvmData = (void*)pImage;
+        nvmStatus = NvSyncSave(ppNvmData, FALSE);
+    }
+#else /* gUnmirroredFeatureSet_d */
+    FLib_MemCpy(pNvmData, pImage, size);
+    nvmStatus = NvSyncSave(pNvmData, FALSE);
+#endif /* gUnmirroredFeatureSet_d */
+
+    return (nvmStatus == gNVM_OK_c) ? TRUE : FALSE;
+}
+#endif /* gAppUseNvm_d */
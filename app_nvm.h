@@ -26,6 +26,27 @@
 #define KEY_MAX_SIZE          16
 #define BD_ADDR_MAX_SIZE       6
 
+/*! System parameter changes are persisted once no parameter has changed for
+    this long, ms. Redefine it in the app_preinclude.h file */
+#ifndef gAppNvmParamQuietWindowMs_c
+#define gAppNvmParamQuietWindowMs_c     (2000U)
+#endif
+
+/*! Longest a changed system parameter waits for the quiet window, ms.
+    Redefine it in the app_preinclude.h file */
+#ifndef gAppNvmParamMaxDelayMs_c
+#define gAppNvmParamMaxDelayMs_c        (20000U)
+#endif
+
+/*! Layout version of the system parameter record. Parameters are only ever
+    appended to systemParamID_t: bump the version and add its parameter count
+    to the layout table of app_nvm.c when doing so. */
+#define gAppNvmParamSchemaVersion_c     (2U)
+
+/*! Parameter slots of the system parameter record, at least ParamMaxID. Spare
+    slots keep the record size when parameters are appended. */
+#define gAppNvmParamBlobSlots_c         (32U)
+
 /*****************************************************************************
  ******************************************************************************
  * Public memory declarations
@@ -87,6 +108,9 @@ typedef enum
     NumberOfAnchorsID,
     FastScanIntervalID,
     FastScanWindowID,
+    DiagRssiDeltaID,
+    DiagMinIntervalID,
+    /* Append new parameters here, see gAppNvmParamSchemaVersion_c */
     ParamMaxID,
 }systemParamID_t;
 
@@ -160,6 +184,8 @@ typedef PACKED_STRUCT systemParams_tag
     uint32_t number_of_anchors;
     uint32_t fast_scan_interval;
     uint32_t fast_scan_window;
+    uint32_t diag_rssi_delta;
+    uint32_t diag_min_interval;
 }systemParams_t;
 
 /*! \brief  ble key structure content.
@@ -201,13 +227,15 @@ static const systemItem_t SystemParamsRegistry[] =
     {MsWristModeID,                  "ms_wrist_mode",                     0,      0,      1},
     {MsStepInScanID,                 "ms_step_in_scan",                   0,      0, 200000},
     {MsStepOutScanID,                "ms_step_out_scan",                  0,      0, 200000},
-    {MsTotalStepID,                  "ms_total_step",                     0,      0, 200000},
+    {MsTotalStepID,                  "ms_total_step",                     0,      0, INT32_MAX}, /* Lifetime count, read only */
     {MsStillDetectedID,              "ms_still_detected",                 0,      0, 200000},
     {TemperatureID,                  "temperature",                       0,    -40,     80},// new
     {BatteryLevelID,                 "battery_level",                     0,      0,    100},// new
     {NumberOfAnchorsID,              "number_of_anchors",                 6,      1,     10},
     {FastScanIntervalID,             "fast_scan_interval",               60,     50,   3000},
     {FastScanWindowID,               "fast_scan_window",                 57,     40,    100},
+    {DiagRssiDeltaID,                "diag_rssi_delta",                   3,      0,     40},
+    {DiagMinIntervalID,              "diag_min_interval",               500,     50,  60000},
 };
 
 static const keysItem_t BleKeysRegistry[] =
@@ -247,6 +275,37 @@ typedef struct IrkLtkKeys_tag
     }ble_keys;
 }IrkLtkKeys_t;
 
+/*! \brief  System parameter NVM record, all parameters in one.
+ *
+ * values[0 .. count - 1] hold the first count systemParamID_t parameters of
+ * layout version. crc is the CRC-32 of version, count and these values.
+ */
+typedef PACKED_STRUCT appNvmParamBlob_tag
+{
+    uint16_t version;
+    uint16_t count;
+    uint32_t crc;
+    uint32_t values[gAppNvmParamBlobSlots_c];
+}appNvmParamBlob_t;
+
+/*! \brief  System parameter persistence counters.
+ *
+ * Records avoided: ParamMaxID records per change, as saved before write
+ * coalescing, minus the records actually saved.
+ */
+typedef struct appNvmParamStats_tag
+{
+    uint32_t changes;               /* App_NvmWriteSystemParam calls that changed a value */
+    uint32_t flushes;               /* Flushes that saved the record */
+    uint32_t recordsSaved;
+    uint32_t recordsAvoided;
+    uint32_t errors;
+    uint32_t loadUs;                /* App_NvmLoadSystemParams duration */
+    uint16_t loadVersion;           /* Layout found at boot, 0: one record per parameter */
+    uint16_t loadDefaults;          /* Parameters set to default at boot: added since
+                                       loadVersion, missing or out of range */
+}appNvmParamStats_t;
+
 /*****************************************************************************
  ******************************************************************************
  * Public functions
@@ -258,5 +317,7 @@ bleResult_t App_NvmWriteBleKey(bleKeysID_t id, uint8_t *key_bytes, uint16_t key_
 bleResult_t App_NvmLoadSystemParams(void);
 bleResult_t App_NvmReadSystemParams(systemParameters_t **pSysParams);
 bleResult_t App_NvmWriteSystemParam(systemParamID_t id, int32_t value);
+bleResult_t App_NvmFlushSystemParams(bool_t sync);
+const appNvmParamStats_t *App_NvmGetParamStats(void);
 
 #endif /* APP_NVM_H_ */
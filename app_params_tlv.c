@@ -0,0 +1,390 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_params_tlv.c
+*
+* System parameters TLV record of the params_tlv characteristic. The value
+* held by the GATT database is rebuilt from the parameters on the first read
+* of a long read (read notifications), never on its blob reads: they read the
+* rest of the record built for it, not of a newer one. A long read left
+* unfinished ends after gAppParamsTlvBlobTimeoutMs_c. A write, short or long
+* (prepare/execute), is checked
+* field by field first: one bad field and nothing is applied. Otherwise every
+* field is set and the parameter record saved once.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "ble_general.h"
+#include "gatt_interface.h"
+#include "gatt_db_app_interface.h"
+#include "gatt_db_handles.h"
+#include "fsl_component_timer_manager.h"
+#include "app_nvm.h"
+#include "app_params_tlv.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+/* A read gives every parameter but the read-only MsTotalStepID on 4 bytes */
+#define mcParamsTlvFieldSize_c      (gAppParamsTlvFieldHeaderSize_c + sizeof(int32_t))
+#define mcParamsTlvFieldCount_c     ((uint16_t)ParamMaxID - 1U)
+#define mcParamsTlvRecordSize_c     (gAppParamsTlvHeaderSize_c + (mcParamsTlvFieldCount_c * mcParamsTlvFieldSize_c))
+
+/* params_tlv_status: version, result, error count, then ID and result of
+   each rejected field */
+#define mcParamsTlvStatusHeaderSize_c   (3U)
+#define mcParamsTlvStatusSize_c     (mcParamsTlvStatusHeaderSize_c + ((uint16_t)ParamMaxID * 2U))
+
+#define mcParamsTlvBlobTimeoutUs_c  ((uint64_t)gAppParamsTlvBlobTimeoutMs_c * 1000U)
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static uint8_t maParamsTlvRecord[mcParamsTlvRecordSize_c];
+static uint8_t maParamsTlvStatus[mcParamsTlvStatusSize_c];
+
+/* Blob reads left in the long read of each peer, and the time of its last read */
+static uint8_t maParamsTlvBlobReads[gAppMaxConnections_c];
+static uint64_t maParamsTlvReadTs[gAppMaxConnections_c];
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static appParamsTlvResult_t App_ParamsTlvCheckField(const uint8_t *pField, const bool_t *aSeen, int32_t *aValues);
+static void App_ParamsTlvSetStatus(appParamsTlvResult_t result, uint16_t errors);
+static bool_t App_ParamsTlvLongReadInProgress(uint64_t now);
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Builds the record of all parameters a client writes, each on 4
+*               bytes: a record read can be written back as is.
+*
+* \param[out]   pOut            Record.
+* \param[in]    size            Room in pOut.
+*
+* \return       Record length, 0 if it does not fit.
+********************************************************************************** */
+uint16_t App_ParamsTlvEncode(uint8_t *pOut, uint16_t size)
+{
+    systemParameters_t *pSysParams = NULL;
+    uint16_t length = 0U;
+    uint32_t value;
+    uint8_t *pField;
+    uint8_t id;
+
+    if ((size >= mcParamsTlvRecordSize_c) && (App_NvmReadSystemParams(&pSysParams) == gBleSuccess_c))
+    {
+        pOut[0] = gAppParamsTlvVersion_c;
+        pOut[1] = (uint8_t)mcParamsTlvFieldCount_c;
+        pField = &pOut[gAppParamsTlvHeaderSize_c];
+        for (id = 0U; id < (uint8_t)ParamMaxID; id++)
+        {
+            if (id != (uint8_t)MsTotalStepID)
+            {
+                value = pSysParams->system_params.buffer[id];
+                pField[0] = id;
+                pField[1] = (uint8_t)sizeof(int32_t);
+                pField[2] = (uint8_t)value;
+                pField[3] = (uint8_t)(value >> 8U);
+                pField[4] = (uint8_t)(value >> 16U);
+                pField[5] = (uint8_t)(value >> 24U);
+                pField = &pField[mcParamsTlvFieldSize_c];
+            }
+        }
+        length = mcParamsTlvRecordSize_c;
+    }
+    return length;
+}
+
+/*! *********************************************************************************
+* \brief        Applies a params_tlv write, all fields or none, and sets
+*               params_tlv_status to the outcome.
+*
+* \param[in]    pRecord         Record written.
+* \param[in]    length          Its length.
+*
+* \return       The ATT status to answer the write with.
+********************************************************************************** */
+attErrorCode_t App_ParamsTlvWrite(const uint8_t *pRecord, uint16_t length)
+{
+    attErrorCode_t status = gAttErrCodeNoError_c;
+    appParamsTlvResult_t result = gAppParamsTlvOk_c;
+    appParamsTlvResult_t fieldResult;
+    bool_t aSeen[ParamMaxID];
+    int32_t aValues[ParamMaxID];
+    uint16_t errors = 0U;
+    uint16_t offset;
+    uint8_t count;
+    uint8_t i;
+
+    if ((length < gAppParamsTlvHeaderSize_c) || (pRecord[0] != gAppParamsTlvVersion_c))
+    {
+        result = gAppParamsTlvBadVersion_c;
+    }
+    else
+    {
+        /* The fields must end the record exactly: a long write cut short
+           is rejected as a whole */
+        count = pRecord[1];
+        offset = gAppParamsTlvHeaderSize_c;
+        for (i = 0U; (i < count) && (result == gAppParamsTlvOk_c); i++)
+        {
+            if (((offset + gAppParamsTlvFieldHeaderSize_c) > length) ||
+                ((offset + gAppParamsTlvFieldHeaderSize_c + pRecord[offset + 1U]) > length))
+            {
+                result = gAppParamsTlvBadFormat_c;
+            }
+            else
+            {
+                offset += gAppParamsTlvFieldHeaderSize_c + pRecord[offset + 1U];
+            }
+        }
+        if ((result == gAppParamsTlvOk_c) && (offset != length))
+        {
+            result = gAppParamsTlvBadFormat_c;
+        }
+    }
+
+    if (result == gAppParamsTlvOk_c)
+    {
+        for (i = 0U; i < (uint8_t)ParamMaxID; i++)
+        {
+            aSeen[i] = FALSE;
+        }
+        offset = gAppParamsTlvHeaderSize_c;
+        for (i = 0U; i < pRecord[1]; i++)
+        {
+            fieldResult = App_ParamsTlvCheckField(&pRecord[offset], aSeen, aValues);
+            if (fieldResult == gAppParamsTlvOk_c)
+            {
+                aSeen[pRecord[offset]] = TRUE;
+            }
+            else if (errors < (uint16_t)ParamMaxID)
+            {
+                maParamsTlvStatus[mcParamsTlvStatusHeaderSize_c + (2U * errors)] = pRecord[offset];
+                maParamsTlvStatus[mcParamsTlvStatusHeaderSize_c + (2U * errors) + 1U] = (uint8_t)fieldResult;
+                errors++;
+            }
+            else
+            {
+                ; /* Listed up to ParamMaxID errors */
+            }
+            offset += gAppParamsTlvFieldHeaderSize_c + pRecord[offset + 1U];
+        }
+        if (errors != 0U)
+        {
+            result = gAppParamsTlvFieldsRejected_c;
+        }
+    }
+
+    if (result == gAppParamsTlvOk_c)
+    {
+        for (i = 0U; i < (uint8_t)ParamMaxID; i++)
+        {
+            if (aSeen[i] == TRUE)
+            {
+                (void)App_NvmWriteSystemParam((systemParamID_t)i, aValues[i]);
+            }
+        }
+        /* One record save for all fields */
+        if (App_NvmFlushSystemParams(FALSE) != gBleSuccess_c)
+        {
+            result = gAppParamsTlvNvmError_c;
+        }
+    }
+    else
+    {
+        status = gAppParamsTlvAttError_c;
+    }
+
+    App_ParamsTlvSetStatus(result, errors);
+    /* A long read in progress keeps its record, the next read rebuilds it */
+    if (App_ParamsTlvLongReadInProgress(TM_GetTimestamp()) == FALSE)
+    {
+        App_ParamsTlvRefresh();
+    }
+    return status;
+}
+
+/*! *********************************************************************************
+* \brief        Sets the params_tlv value to the current parameters.
+********************************************************************************** */
+void App_ParamsTlvRefresh(void)
+{
+    uint16_t length = App_ParamsTlvEncode(maParamsTlvRecord, (uint16_t)sizeof(maParamsTlvRecord));
+
+    if (length != 0U)
+    {
+        (void)GattDb_WriteAttribute((uint16_t)value_params_tlv, length, maParamsTlvRecord);
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Read notification of params_tlv. The stack does not give the
+*               offset read: a read of a peer with no blob read left, or
+*               after gAppParamsTlvBlobTimeoutMs_c without read, is the first
+*               of a long read. The record is rebuilt then, unless another
+*               peer is within its own long read, and the blob reads
+*               that follow are counted from the record length and the MTU:
+*               the client reads on while the response is full, the last
+*               response is empty when the record fills the one before.
+*
+* \param[in]    deviceId        Peer reading.
+********************************************************************************** */
+void App_ParamsTlvRead(deviceId_t deviceId)
+{
+    uint64_t now = TM_GetTimestamp();
+    uint16_t mtu = gAttDefaultMtu_c;
+
+    if (deviceId < gAppMaxConnections_c)
+    {
+        if ((now - maParamsTlvReadTs[deviceId]) > mcParamsTlvBlobTimeoutUs_c)
+        {
+            /* The previous long read was given up */
+            maParamsTlvBlobReads[deviceId] = 0U;
+        }
+        maParamsTlvReadTs[deviceId] = now;
+
+        if (maParamsTlvBlobReads[deviceId] != 0U)
+        {
+            maParamsTlvBlobReads[deviceId]--;
+        }
+        else
+        {
+            if (App_ParamsTlvLongReadInProgress(now) == FALSE)
+            {
+                App_ParamsTlvRefresh();
+            }
+            if ((Gatt_GetMtu(deviceId, &mtu) != gBleSuccess_c) || (mtu < gAttDefaultMtu_c))
+            {
+                mtu = gAttDefaultMtu_c;
+            }
+            maParamsTlvBlobReads[deviceId] = (uint8_t)(mcParamsTlvRecordSize_c / gAttMaxReadDataSize_d(mtu));
+        }
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Drops the long read of a peer disconnected.
+*
+* \param[in]    deviceId        Peer.
+********************************************************************************** */
+void App_ParamsTlvDisconnected(deviceId_t deviceId)
+{
+    if (deviceId < gAppMaxConnections_c)
+    {
+        maParamsTlvBlobReads[deviceId] = 0U;
+    }
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Checks one field, its value in aValues at the parameter ID when
+*               valid.
+********************************************************************************** */
+static appParamsTlvResult_t App_ParamsTlvCheckField(const uint8_t *pField, const bool_t *aSeen, int32_t *aValues)
+{
+    appParamsTlvResult_t result = gAppParamsTlvOk_c;
+    uint8_t id = pField[0];
+    uint8_t length = pField[1];
+    const uint8_t *pValue = &pField[gAppParamsTlvFieldHeaderSize_c];
+    uint32_t raw = 0U;
+    int32_t value;
+    uint8_t i;
+
+    if (id >= (uint8_t)ParamMaxID)
+    {
+        result = gAppParamsTlvUnknownParam_c;
+    }
+    else if (id == (uint8_t)MsTotalStepID)
+    {
+        /* Lifetime step count, kept by app_counters */
+        result = gAppParamsTlvReadOnly_c;
+    }
+    else if ((length != 1U) && (length != 2U) && (length != 4U))
+    {
+        result = gAppParamsTlvBadLength_c;
+    }
+    else if (aSeen[id] == TRUE)
+    {
+        result = gAppParamsTlvDuplicate_c;
+    }
+    else
+    {
+        for (i = length; i > 0U; i--)
+        {
+            raw = (raw << 8U) | pValue[i - 1U];
+        }
+        if ((length < sizeof(int32_t)) && (((raw >> ((8U * length) - 1U)) & 1U) != 0U))
+        {
+            raw |= 0xFFFFFFFFU << (8U * length);
+        }
+        value = (int32_t)raw;
+        if ((value < SystemParamsRegistry[id].min_value) || (value > SystemParamsRegistry[id].max_value))
+        {
+            result = gAppParamsTlvOutOfRange_c;
+        }
+        else
+        {
+            aValues[id] = value;
+        }
+    }
+    return result;
+}
+
+/*! *********************************************************************************
+* \brief        Tells whether a peer is within a long read of params_tlv.
+********************************************************************************** */
+static bool_t App_ParamsTlvLongReadInProgress(uint64_t now)
+{
+    bool_t longRead = FALSE;
+    uint8_t i;
+
+    for (i = 0U; i < gAppMaxConnections_c; i++)
+    {
+        if ((maParamsTlvBlobReads[i] != 0U) && ((now - maParamsTlvReadTs[i]) <= mcParamsTlvBlobTimeoutUs_c))
+        {
+            longRead = TRUE;
+        }
+    }
+    return longRead;
+}
+
+/*! *********************************************************************************
+* \brief        Sets params_tlv_status, the rejected fields already in place.
+********************************************************************************** */
+static void App_ParamsTlvSetStatus(appParamsTlvResult_t result, uint16_t errors)
+{
+    maParamsTlvStatus[0] = gAppParamsTlvVersion_c;
+    maParamsTlvStatus[1] = (uint8_t)result;
+    maParamsTlvStatus[2] = (uint8_t)errors;
+    (void)GattDb_WriteAttribute((uint16_t)value_params_tlv_status,
+                                (uint16_t)(mcParamsTlvStatusHeaderSize_c + (2U * errors)), maParamsTlvStatus);
+}
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
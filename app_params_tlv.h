@@ -0,0 +1,107 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_params_tlv.h
+*
+* All system parameters in one TLV record, read and written through the
+* params_tlv characteristic of the commands service, so that a tuning tool
+* syncs the whole configuration in a few ATT exchanges instead of one per
+* parameter characteristic.
+*
+* Record: version (gAppParamsTlvVersion_c), field count, then the fields. A
+* field is its systemParamID_t, the value length (1, 2 or 4) and the value,
+* signed, least significant byte first. A read gives every parameter on 4
+* bytes but the read-only step count (MsTotalStepID), rejected in a write,
+* so that a record read can be written back. A write may carry any subset:
+* it is applied whole, with one NVM save, or not at all. The outcome, and why
+* each rejected field was rejected, is read from params_tlv_status: version,
+* appParamsTlvResult_t, error count, then the parameter ID and
+* appParamsTlvResult_t of each rejected field.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef APP_PARAMS_TLV_H
+#define APP_PARAMS_TLV_H
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "ble_general.h"
+#include "att_errors.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+/*! Record layout version. Parameters are identified by their ID: appending
+    parameters to systemParamID_t does not change it. */
+#define gAppParamsTlvVersion_c               (1U)
+
+/*! Record header: version, field count */
+#define gAppParamsTlvHeaderSize_c            (2U)
+
+/*! Field header: parameter ID, value length */
+#define gAppParamsTlvFieldHeaderSize_c       (2U)
+
+/*! ATT error of a params_tlv write that was not applied, the reasons are in
+    params_tlv_status (application error range) */
+#define gAppParamsTlvAttError_c              ((attErrorCode_t)0x80U)
+
+/*! A long read of params_tlv with no read for this long is over: the next
+    read starts a new one. Above two of the longest connection intervals.
+    Redefine it in the app_preinclude.h file */
+#ifndef gAppParamsTlvBlobTimeoutMs_c
+#define gAppParamsTlvBlobTimeoutMs_c         (6000U)
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+/*! \brief  Outcome of a params_tlv write, of the record or of one field. */
+typedef enum appParamsTlvResult_tag
+{
+    gAppParamsTlvOk_c = 0,              /*!< Applied */
+    gAppParamsTlvBadVersion_c,          /*!< Record version not supported */
+    gAppParamsTlvBadFormat_c,           /*!< Record shorter or longer than its field count */
+    gAppParamsTlvFieldsRejected_c,      /*!< Fields rejected, listed after */
+    gAppParamsTlvUnknownParam_c,        /*!< Field: no such parameter */
+    gAppParamsTlvBadLength_c,           /*!< Field: value length not 1, 2 or 4 */
+    gAppParamsTlvOutOfRange_c,          /*!< Field: value out of the parameter bounds */
+    gAppParamsTlvDuplicate_c,           /*!< Field: parameter already in the record */
+    gAppParamsTlvNvmError_c,            /*!< Applied, the NVM save failed */
+    gAppParamsTlvReadOnly_c             /*!< Field: parameter not written by a client */
+}appParamsTlvResult_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint16_t App_ParamsTlvEncode(uint8_t *pOut, uint16_t size);
+attErrorCode_t App_ParamsTlvWrite(const uint8_t *pRecord, uint16_t length);
+void App_ParamsTlvRefresh(void);
+void App_ParamsTlvRead(deviceId_t deviceId);
+void App_ParamsTlvDisconnected(deviceId_t deviceId);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_PARAMS_TLV_H */
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
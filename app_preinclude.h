@@ -62,6 +62,10 @@
 /*! Enable/disable use of bonding capability */
 #define gAppUseBonding_d                1
 
+/*! Custom peer information saved with each bond: appCustomInfo_t, the DK
+    handles and the vehicle Database Hash they belong to */
+#define gcReservedFlashSizeForCustomInformation_c   40U
+
 /*! Enable/disable use of pairing procedure */
 #define gAppUsePairing_d                1
 
@@ -80,8 +84,12 @@
 
 #define gAppMaxConnections_c            2U
 
-/* Must open an L2CAP channel for each CCC peer */
-#define gL2caMaxLeCbChannels_c          gAppMaxConnections_c
+/*! DK L2CAP channels per CCC peer. 2 opens a bulk channel (APDUs, logs) next
+    to ranging control, for vehicles known to accept it */
+#define gAppDkChannelsPerPeer_c         1U
+
+/* Must open the DK L2CAP channels of each CCC peer */
+#define gL2caMaxLeCbChannels_c          (gAppMaxConnections_c * gAppDkChannelsPerPeer_c)
 
 /*! BLE CCC Digital Key UUID */
 #define gBleSig_CCC_DK_UUID_d           0xFFF5U
@@ -89,6 +97,19 @@
 #define gAppUseShellInApplication_d     1
 
 #define gAppLowpowerEnabled_d           1
+
+/*! Enable/disable the CCC latency milestone recorder (shell "lat") */
+#define gAppLatencyRecorder_d           1
+
+/*! Enable/disable the event trace ring (shell "trace", tools/trace_decode) */
+#define gAppTrace_d                     0
+
+/*! Enable/disable the binary batch commands on the second serial manager
+    instance (shell "batch", tools/shell_batch). Test rig builds only: it
+    takes a second UART */
+#ifndef gAppShellBatch_d
+#define gAppShellBatch_d                0
+#endif
 /* Disable LEDs when enabling low power */
 #if (defined(gAppLowpowerEnabled_d) && (gAppLowpowerEnabled_d>0))
   #undef gAppLedCnt_c
@@ -104,10 +125,6 @@
 #define gDKMessageMaxLength_c           (255U)
 #define mAppLeCbInitialCredits_c        (32768U)
 
-#define gDummyPayload_c       {0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC}
-
-#define gDummyPayloadLength_c           16
-
 #define gRKEChallengeLength_c           16
 
 /*! *********************************************************************************
@@ -134,8 +151,13 @@
 /*! *********************************************************************************
  *     BLE Stack Configuration
  ********************************************************************************** */
- /* Enable Serial Manager interface */
+ /* Enable Serial Manager interface: a second instance carries the binary
+    batch commands of rig builds */
+#if (gAppShellBatch_d == 1)
+#define gAppUseSerialManager_c                2
+#else
 #define gAppUseSerialManager_c                1
+#endif
 
 /* Enable 5.0 optional features */
 #define gBLE50_d                              1
@@ -149,11 +171,14 @@
 /* Enable EATT */
 #define gEATT_d                               1
 
-/* Disable GATT caching */
-#define gGattCaching_d                        0
+/* Enable GATT caching: Database Hash and Client Supported Features */
+#define gGattCaching_d                        1
+
+/* Database Hash computed at boot over the static database */
+#define gGattDbComputeHash_d                  1
 
-/* Disable GATT automatic robust caching */
-#define gGattAutomaticRobustCachingSupport_d  0
+/* Enable GATT automatic robust caching */
+#define gGattAutomaticRobustCachingSupport_d  1
 
 /*! *********************************************************************************
  *  Auto Configuration
@@ -0,0 +1,365 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_rke.c
+*
+* RKE action queue. Button and shell presses are turned into actions; each
+* vehicle has at most one action in flight (RKE Request SubEvent sent, waiting
+* for RKE_Auth_RQ and then Vehicle Status Changed) and a short FIFO behind it.
+*
+*  - a press of a pending function replaces the pending action (lock then
+*    unlock): the last intent wins, a repeated press is dropped;
+*  - a press equal to the action in flight within gAppRkeCoalesceWindowMs_c of
+*    the previous press is dropped;
+*  - the in-flight action is retransmitted after gAppRkeAckTimeoutMs_c, up to
+*    gAppRkeMaxRetries_c times, then dropped. An action whose RKE Request could
+*    not be sent has no deadline: it is retransmitted on the next check, as a
+*    retry, so a send that keeps failing does not hold the queue either.
+*
+* The module only keeps state; the caller sends what it is told to send. All
+* functions are called from the application task.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "fsl_component_timer_manager.h"
+#include "FunctionLib.h"
+#include "ble_general.h"
+#include "app_rke.h"
+#include "app_counters.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mcRkeMsToUs(ms)                     ((uint64_t)(ms) * 1000U)
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+typedef struct appRkeAction_tag
+{
+    uint64_t    pressTs;        /* First press, latency reference */
+    uint64_t    lastPressTs;    /* Latest coalesced press */
+    uint16_t    functionId;
+    uint8_t     actionId;
+}appRkeAction_t;
+
+typedef struct appRkeVehicle_tag
+{
+    appRkeAction_t  inFlight;
+    appRkeAction_t  aPending[gAppRkeQueueDepth_c];
+    uint64_t        deadlineTs;
+    uint8_t         pendingCount;
+    uint8_t         retries;
+    bool_t          busy;
+}appRkeVehicle_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static appRkeVehicle_t maRkeVehicle[gAppMaxConnections_c];
+static appRkeStats_t mRkeStats;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static appRkeStatus_t App_RkeNext(appRkeVehicle_t *pVehicle);
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Registers an RKE press for a vehicle.
+*
+* \param[in]    deviceId        Vehicle device ID.
+* \param[in]    functionId      RKE function (central locking, trunk, ...).
+* \param[in]    actionId        RKE action (lock, unlock, release, ...).
+*
+* \return       gAppRkeDispatch_c if the caller must send the RKE Request now.
+********************************************************************************** */
+appRkeStatus_t App_RkePress(deviceId_t deviceId, uint16_t functionId, uint8_t actionId)
+{
+    appRkeStatus_t status = gAppRkeInvalid_c;
+    appRkeVehicle_t *pVehicle;
+    uint64_t now = TM_GetTimestamp();
+    uint8_t i;
+
+    if (deviceId < (deviceId_t)gAppMaxConnections_c)
+    {
+        pVehicle = &maRkeVehicle[deviceId];
+        mRkeStats.presses++;
+        status = gAppRkeNone_c;
+
+        /* A pending action of the same function takes the latest intent */
+        for (i = 0U; (i < pVehicle->pendingCount) && (status == gAppRkeNone_c); i++)
+        {
+            appRkeAction_t *pPending = &pVehicle->aPending[i];
+
+            if (pPending->functionId == functionId)
+            {
+                if (pPending->actionId == actionId)
+                {
+                    mRkeStats.coalesced++;
+                }
+                else
+                {
+                    pPending->actionId = actionId;
+                    pPending->pressTs = now;
+                    mRkeStats.superseded++;
+                }
+                pPending->lastPressTs = now;
+                status = gAppRkeCoalesced_c;
+            }
+        }
+
+        if ((status == gAppRkeNone_c) && (pVehicle->busy == TRUE) &&
+            (pVehicle->inFlight.functionId == functionId) && (pVehicle->inFlight.actionId == actionId) &&
+            ((now - pVehicle->inFlight.lastPressTs) < mcRkeMsToUs(gAppRkeCoalesceWindowMs_c)))
+        {
+            pVehicle->inFlight.lastPressTs = now;
+            mRkeStats.coalesced++;
+            status = gAppRkeCoalesced_c;
+        }
+
+        if (status == gAppRkeNone_c)
+        {
+            appRkeAction_t action = {.pressTs = now, .lastPressTs = now, .functionId = functionId, .actionId = actionId};
+
+            if (pVehicle->busy == FALSE)
+            {
+                pVehicle->inFlight = action;
+                pVehicle->retries = 0U;
+                pVehicle->busy = TRUE;
+                status = gAppRkeDispatch_c;
+            }
+            else if (pVehicle->pendingCount < gAppRkeQueueDepth_c)
+            {
+                pVehicle->aPending[pVehicle->pendingCount] = action;
+                pVehicle->pendingCount++;
+                status = gAppRkeQueued_c;
+            }
+            else
+            {
+                mRkeStats.dropped++;
+                status = gAppRkeQueueFull_c;
+            }
+        }
+    }
+    return status;
+}
+
+/*! *********************************************************************************
+* \brief        Returns the action in flight for a vehicle.
+*
+* \return       FALSE if no action is in flight.
+********************************************************************************** */
+bool_t App_RkeGetInFlight(deviceId_t deviceId, uint16_t *pFunctionId, uint8_t *pActionId)
+{
+    bool_t busy = FALSE;
+
+    if ((deviceId < (deviceId_t)gAppMaxConnections_c) && (maRkeVehicle[deviceId].busy == TRUE))
+    {
+        *pFunctionId = maRkeVehicle[deviceId].inFlight.functionId;
+        *pActionId = maRkeVehicle[deviceId].inFlight.actionId;
+        busy = TRUE;
+    }
+    return busy;
+}
+
+/*! *********************************************************************************
+* \brief        The RKE Request of the in-flight action was sent: arms its timeout.
+********************************************************************************** */
+void App_RkeMarkSent(deviceId_t deviceId)
+{
+    if ((deviceId < (deviceId_t)gAppMaxConnections_c) && (maRkeVehicle[deviceId].busy == TRUE))
+    {
+        maRkeVehicle[deviceId].deadlineTs = TM_GetTimestamp() + mcRkeMsToUs(gAppRkeAckTimeoutMs_c);
+        mRkeStats.sent++;
+    }
+}
+
+/*! *********************************************************************************
+* \brief        RKE_Auth_RQ received for the in-flight action: the vehicle is
+*               processing it, the timeout restarts for the status report.
+********************************************************************************** */
+void App_RkeChallengeReceived(deviceId_t deviceId)
+{
+    if ((deviceId < (deviceId_t)gAppMaxConnections_c) && (maRkeVehicle[deviceId].busy == TRUE))
+    {
+        maRkeVehicle[deviceId].deadlineTs = TM_GetTimestamp() + mcRkeMsToUs(gAppRkeAckTimeoutMs_c);
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Vehicle Status Changed received. Completes the in-flight action if it
+*               concerns the same function.
+*
+* \param[in]    deviceId        Vehicle device ID.
+* \param[in]    functionId      Function reported by the vehicle.
+*
+* \return       gAppRkeDispatch_c if the next pending action is now in flight.
+********************************************************************************** */
+appRkeStatus_t App_RkeAcknowledge(deviceId_t deviceId, uint16_t functionId)
+{
+    appRkeStatus_t status = gAppRkeNone_c;
+    appRkeVehicle_t *pVehicle;
+    uint32_t latency;
+
+    if ((deviceId < (deviceId_t)gAppMaxConnections_c) && (maRkeVehicle[deviceId].busy == TRUE) &&
+        (maRkeVehicle[deviceId].inFlight.functionId == functionId))
+    {
+        pVehicle = &maRkeVehicle[deviceId];
+        latency = (uint32_t)(TM_GetTimestamp() - pVehicle->inFlight.pressTs);
+
+        if ((mRkeStats.acked == 0U) || (latency < mRkeStats.latencyMin))
+        {
+            mRkeStats.latencyMin = latency;
+        }
+        if (latency > mRkeStats.latencyMax)
+        {
+            mRkeStats.latencyMax = latency;
+        }
+        mRkeStats.latencySum += latency;
+        mRkeStats.acked++;
+        App_CounterAdd(gAppCounterRke_c, 1U);
+
+        status = App_RkeNext(pVehicle);
+    }
+    return status;
+}
+
+/*! *********************************************************************************
+* \brief        Checks the in-flight action of a vehicle against its deadline. An
+*               action not sent yet (no deadline, the send failed) is due now.
+*
+* \return       gAppRkeResend_c or gAppRkeDispatch_c when the caller must send.
+********************************************************************************** */
+appRkeStatus_t App_RkeCheckTimeout(deviceId_t deviceId)
+{
+    appRkeStatus_t status = gAppRkeNone_c;
+    appRkeVehicle_t *pVehicle;
+
+    if ((deviceId < (deviceId_t)gAppMaxConnections_c) && (maRkeVehicle[deviceId].busy == TRUE))
+    {
+        pVehicle = &maRkeVehicle[deviceId];
+        if ((pVehicle->deadlineTs == 0U) || (TM_GetTimestamp() >= pVehicle->deadlineTs))
+        {
+            if (pVehicle->retries < gAppRkeMaxRetries_c)
+            {
+                pVehicle->retries++;
+                mRkeStats.retries++;
+                status = gAppRkeResend_c;
+            }
+            else
+            {
+                mRkeStats.timeouts++;
+                status = App_RkeNext(pVehicle);
+            }
+        }
+    }
+    return status;
+}
+
+/*! *********************************************************************************
+* \brief        Returns TRUE while any vehicle has an action in flight.
+********************************************************************************** */
+bool_t App_RkeIsBusy(void)
+{
+    bool_t busy = FALSE;
+    uint32_t i;
+
+    for (i = 0U; i < gAppMaxConnections_c; i++)
+    {
+        if (maRkeVehicle[i].busy == TRUE)
+        {
+            busy = TRUE;
+        }
+    }
+    return busy;
+}
+
+/*! *********************************************************************************
+* \brief        Drops every action of a vehicle (disconnection).
+********************************************************************************** */
+void App_RkeReset(deviceId_t deviceId)
+{
+    if (deviceId < (deviceId_t)gAppMaxConnections_c)
+    {
+        appRkeVehicle_t *pVehicle = &maRkeVehicle[deviceId];
+
+        mRkeStats.dropped += (uint32_t)pVehicle->pendingCount + ((pVehicle->busy == TRUE) ? 1U : 0U);
+        FLib_MemSet(pVehicle, 0x00, sizeof(appRkeVehicle_t));
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Returns the queue statistics.
+********************************************************************************** */
+const appRkeStats_t* App_RkeGetStats(void)
+{
+    return &mRkeStats;
+}
+
+/*! *********************************************************************************
+* \brief        Clears the queue statistics.
+********************************************************************************** */
+void App_RkeResetStats(void)
+{
+    FLib_MemSet(&mRkeStats, 0x00, sizeof(mRkeStats));
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Retires the in-flight action and moves the oldest pending one in.
+*
+* \return       gAppRkeDispatch_c if a pending action is now in flight.
+********************************************************************************** */
+static appRkeStatus_t App_RkeNext(appRkeVehicle_t *pVehicle)
+{
+    appRkeStatus_t status = gAppRkeNone_c;
+    uint8_t i;
+
+    pVehicle->deadlineTs = 0U;
+    pVehicle->retries = 0U;
+    if (pVehicle->pendingCount > 0U)
+    {
+        pVehicle->inFlight = pVehicle->aPending[0];
+        for (i = 1U; i < pVehicle->pendingCount; i++)
+        {
+            pVehicle->aPending[i - 1U] = pVehicle->aPending[i];
+        }
+        pVehicle->pendingCount--;
+        status = gAppRkeDispatch_c;
+    }
+    else
+    {
+        pVehicle->busy = FALSE;
+    }
+    return status;
+}
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
@@ -0,0 +1,115 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_rke.h
+*
+* RKE action queue: coalescing of repeated presses, one in-flight action per
+* vehicle, acknowledgement timeout and retries, press-to-acknowledgement latency.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef APP_RKE_H
+#define APP_RKE_H
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "ble_general.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+/*! Pending actions per vehicle, in-flight one excluded.
+    Redefine it in the app_preinclude.h file */
+#ifndef gAppRkeQueueDepth_c
+#define gAppRkeQueueDepth_c                  (3U)
+#endif
+
+/*! A repeated press of the action in flight within this window is dropped */
+#ifndef gAppRkeCoalesceWindowMs_c
+#define gAppRkeCoalesceWindowMs_c            (1000U)
+#endif
+
+/*! Time allowed from RKE Request SubEvent to Vehicle Status Changed */
+#ifndef gAppRkeAckTimeoutMs_c
+#define gAppRkeAckTimeoutMs_c                (1500U)
+#endif
+
+/*! RKE Request SubEvent retransmissions before the action is dropped */
+#ifndef gAppRkeMaxRetries_c
+#define gAppRkeMaxRetries_c                  (2U)
+#endif
+
+/*! Timeout supervision period, while an action is in flight */
+#define gAppRkeTickMs_c                      (100U)
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+/*! \brief  Outcome of a press or of a timeout check. */
+typedef enum appRkeStatus_tag
+{
+    gAppRkeNone_c = 0,          /*!< Nothing to do */
+    gAppRkeDispatch_c,          /*!< A new action is in flight: send its RKE Request */
+    gAppRkeResend_c,            /*!< The in-flight action timed out: send its RKE Request again */
+    gAppRkeQueued_c,            /*!< Queued behind the in-flight action */
+    gAppRkeCoalesced_c,         /*!< Merged with an in-flight or pending action */
+    gAppRkeQueueFull_c,         /*!< Dropped, no room */
+    gAppRkeInvalid_c,           /*!< Bad device ID */
+}appRkeStatus_t;
+
+/*! \brief  Queue counters and press-to-acknowledgement latency (us). */
+typedef struct appRkeStats_tag
+{
+    uint32_t    presses;
+    uint32_t    coalesced;
+    uint32_t    superseded;
+    uint32_t    dropped;
+    uint32_t    sent;
+    uint32_t    retries;
+    uint32_t    timeouts;
+    uint32_t    acked;
+    uint32_t    latencyMin;
+    uint32_t    latencyMax;
+    uint64_t    latencySum;
+}appRkeStats_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+appRkeStatus_t App_RkePress(deviceId_t deviceId, uint16_t functionId, uint8_t actionId);
+bool_t App_RkeGetInFlight(deviceId_t deviceId, uint16_t *pFunctionId, uint8_t *pActionId);
+void App_RkeMarkSent(deviceId_t deviceId);
+void App_RkeChallengeReceived(deviceId_t deviceId);
+appRkeStatus_t App_RkeAcknowledge(deviceId_t deviceId, uint16_t functionId);
+appRkeStatus_t App_RkeCheckTimeout(deviceId_t deviceId);
+bool_t App_RkeIsBusy(void);
+void App_RkeReset(deviceId_t deviceId);
+const appRkeStats_t* App_RkeGetStats(void);
+void App_RkeResetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_RKE_H */
+
+/*! *********************************************************************************
+ * @}
+ ********************************************************************************** */
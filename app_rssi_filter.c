@@ -0,0 +1,210 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_rssi_filter.c
+*
+* Integer streaming RSSI filters. Values are dBm in Q8, the output is rounded to
+* the nearest dBm. No dependency besides EmbeddedTypes.h.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "app_rssi_filter.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mcRssiQ8(dbm)                       ((int32_t)(dbm) * 256)
+
+#if (gAppRssiWindow_c > 15U) || ((gAppRssiWindow_c % 2U) == 0U)
+#error "gAppRssiWindow_c must be odd and at most 15"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static int32_t App_RssiFilterMedian(const int8_t *pSamples, uint8_t count);
+static int32_t App_RssiFilterEma(appRssiFilter_t *pFilter, int32_t sampleQ8);
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Resets a filter.
+*
+* \param[in]    pFilter         Filter state.
+* \param[in]    kind            Filter kind.
+********************************************************************************** */
+void App_RssiFilterInit(appRssiFilter_t *pFilter, appRssiFilterKind_t kind)
+{
+    uint8_t i;
+
+    pFilter->estimate = 0;
+    pFilter->variance = 0;
+    for (i = 0U; i < gAppRssiWindow_c; i++)
+    {
+        pFilter->aWindow[i] = 0;
+    }
+    pFilter->head = 0U;
+    pFilter->count = 0U;
+    pFilter->kind = (kind < gAppRssiFilterKindCount_c) ? kind : gAppRssiFilterEma_c;
+}
+
+/*! *********************************************************************************
+* \brief        Adds a sample.
+*
+* \param[in]    pFilter         Filter state.
+* \param[in]    rssi            Sample, dBm.
+*
+* \return       Filtered value, dBm.
+********************************************************************************** */
+int8_t App_RssiFilterUpdate(appRssiFilter_t *pFilter, int8_t rssi)
+{
+    int32_t sampleQ8 = mcRssiQ8(rssi);
+    bool_t first = (pFilter->count == 0U) ? TRUE : FALSE;
+    int32_t median;
+
+    pFilter->aWindow[pFilter->head] = rssi;
+    pFilter->head = (uint8_t)((pFilter->head + 1U) % gAppRssiWindow_c);
+    if (pFilter->count < gAppRssiWindow_c)
+    {
+        pFilter->count++;
+    }
+
+    switch (pFilter->kind)
+    {
+        case gAppRssiFilterMedian_c:
+        {
+            pFilter->estimate = App_RssiFilterMedian(pFilter->aWindow, pFilter->count);
+        }
+        break;
+
+        case gAppRssiFilterHampel_c:
+        {
+            int8_t aDeviation[gAppRssiWindow_c];
+            int32_t mad;
+            int32_t deviation;
+            uint8_t i;
+
+            median = App_RssiFilterMedian(pFilter->aWindow, pFilter->count);
+            for (i = 0U; i < pFilter->count; i++)
+            {
+                deviation = mcRssiQ8(pFilter->aWindow[i]) - median;
+                deviation = (deviation < 0) ? -deviation : deviation;
+                aDeviation[i] = (int8_t)((deviation > mcRssiQ8(127)) ? 127 : (deviation >> 8));
+            }
+            mad = App_RssiFilterMedian(aDeviation, pFilter->count);
+            mad = (mad < gAppRssiHampelMadFloorQ8_c) ? gAppRssiHampelMadFloorQ8_c : mad;
+            deviation = sampleQ8 - median;
+            deviation = (deviation < 0) ? -deviation : deviation;
+
+            /* |x - median| > k * 1.4826 * MAD: replaced by the median. The MAD
+               floor keeps the test on a steady window, where the MAD is 0 */
+            if ((deviation * 256) > (gAppRssiHampelThresholdQ8_c * mad))
+            {
+                sampleQ8 = median;
+            }
+            pFilter->estimate = (first == TRUE) ? sampleQ8 : App_RssiFilterEma(pFilter, sampleQ8);
+        }
+        break;
+
+        case gAppRssiFilterKalman_c:
+        {
+            int32_t gainQ15;
+
+            if (first == TRUE)
+            {
+                pFilter->estimate = sampleQ8;
+                pFilter->variance = gAppRssiKalmanMeasureNoiseQ8_c;
+            }
+            else
+            {
+                /* Predict: random walk. Update: K = P / (P + R) */
+                pFilter->variance += gAppRssiKalmanProcessNoiseQ8_c;
+                gainQ15 = (int32_t)(((int64_t)pFilter->variance << 15) / (pFilter->variance + gAppRssiKalmanMeasureNoiseQ8_c));
+                pFilter->estimate += (int32_t)(((int64_t)gainQ15 * (sampleQ8 - pFilter->estimate)) >> 15);
+                pFilter->variance = (int32_t)(((int64_t)(32768 - gainQ15) * pFilter->variance) >> 15);
+            }
+        }
+        break;
+
+        default:
+        {
+            pFilter->estimate = (first == TRUE) ? sampleQ8 : App_RssiFilterEma(pFilter, sampleQ8);
+        }
+        break;
+    }
+
+    return App_RssiFilterGet(pFilter);
+}
+
+/*! *********************************************************************************
+* \brief        Returns the filtered value, dBm.
+********************************************************************************** */
+int8_t App_RssiFilterGet(const appRssiFilter_t *pFilter)
+{
+    /* Round to nearest, arithmetic shift of a biased value */
+    return (int8_t)((pFilter->estimate + 128) >> 8);
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Median of up to gAppRssiWindow_c samples, Q8. Even counts (window
+*               not full yet) average the two middle samples.
+********************************************************************************** */
+static int32_t App_RssiFilterMedian(const int8_t *pSamples, uint8_t count)
+{
+    int8_t aSorted[gAppRssiWindow_c];
+    int8_t value;
+    uint8_t i;
+    uint8_t j;
+
+    /* Insertion sort, the window is small */
+    for (i = 0U; i < count; i++)
+    {
+        value = pSamples[i];
+        j = i;
+        while ((j > 0U) && (aSorted[j - 1U] > value))
+        {
+            aSorted[j] = aSorted[j - 1U];
+            j--;
+        }
+        aSorted[j] = value;
+    }
+
+    return ((count % 2U) != 0U) ? mcRssiQ8(aSorted[count / 2U]) :
+                                  ((mcRssiQ8(aSorted[(count / 2U) - 1U]) + mcRssiQ8(aSorted[count / 2U])) / 2);
+}
+
+/*! *********************************************************************************
+* \brief        One EMA step towards a Q8 sample.
+********************************************************************************** */
+static int32_t App_RssiFilterEma(appRssiFilter_t *pFilter, int32_t sampleQ8)
+{
+    int32_t delta = sampleQ8 - pFilter->estimate;
+
+    /* Division rather than shift: symmetric for negative deltas */
+    return pFilter->estimate + (delta / (int32_t)(1UL << gAppRssiEmaShift_c));
+}
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
@@ -0,0 +1,111 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_rssi_filter.h
+*
+* Integer streaming RSSI filters, updated once per sample: exponential moving
+* average, sliding median, Hampel outlier rejection and 1D Kalman.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef APP_RSSI_FILTER_H
+#define APP_RSSI_FILTER_H
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+/*! Filter used for the approach intent.
+    Redefine it in the app_preinclude.h file */
+#ifndef gAppRssiFilterKind_c
+#define gAppRssiFilterKind_c                 gAppRssiFilterHampel_c
+#endif
+
+/*! EMA weight of a new sample: 1 / 2^shift */
+#ifndef gAppRssiEmaShift_c
+#define gAppRssiEmaShift_c                   (2U)
+#endif
+
+/*! Sliding median and Hampel window, in samples (odd, at most 15) */
+#ifndef gAppRssiWindow_c
+#define gAppRssiWindow_c                     (5U)
+#endif
+
+/*! Hampel threshold k * 1.4826 in Q8 (k = 3) */
+#ifndef gAppRssiHampelThresholdQ8_c
+#define gAppRssiHampelThresholdQ8_c          (1139)
+#endif
+
+/*! Hampel MAD floor in Q8 (1 dB): a steady window still rejects a spike
+    above k * 1.4826 dB */
+#ifndef gAppRssiHampelMadFloorQ8_c
+#define gAppRssiHampelMadFloorQ8_c           (256)
+#endif
+
+/*! Kalman process and measurement noise, dB^2 in Q8 */
+#ifndef gAppRssiKalmanProcessNoiseQ8_c
+#define gAppRssiKalmanProcessNoiseQ8_c       (256)
+#endif
+#ifndef gAppRssiKalmanMeasureNoiseQ8_c
+#define gAppRssiKalmanMeasureNoiseQ8_c       (4096)
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+/*! \brief  Filter kinds. */
+typedef enum appRssiFilterKind_tag
+{
+    gAppRssiFilterEma_c = 0,    /*!< Exponential moving average */
+    gAppRssiFilterMedian_c,     /*!< Median of the last gAppRssiWindow_c samples */
+    gAppRssiFilterHampel_c,     /*!< Outliers replaced by the window median, then EMA */
+    gAppRssiFilterKalman_c,     /*!< Random walk Kalman filter */
+    gAppRssiFilterKindCount_c
+}appRssiFilterKind_t;
+
+/*! \brief  Filter state, same size for every kind. */
+typedef struct appRssiFilter_tag
+{
+    int32_t             estimate;                   /*!< dBm in Q8 */
+    int32_t             variance;                   /*!< Kalman error variance, dB^2 in Q8 */
+    int8_t              aWindow[gAppRssiWindow_c];  /*!< Last samples, circular */
+    uint8_t             head;
+    uint8_t             count;                      /*!< Samples in the window */
+    appRssiFilterKind_t kind;
+}appRssiFilter_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void App_RssiFilterInit(appRssiFilter_t *pFilter, appRssiFilterKind_t kind);
+int8_t App_RssiFilterUpdate(appRssiFilter_t *pFilter, int8_t rssi);
+int8_t App_RssiFilterGet(const appRssiFilter_t *pFilter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_RSSI_FILTER_H */
+
+/*! *********************************************************************************
+ * @}
+ ********************************************************************************** */
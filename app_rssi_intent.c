@@ -0,0 +1,196 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_rssi_intent.c
+*
+* Approach intent state machine of one vehicle. Pure computation on the state
+* passed in: no timer, no stack call, one instance per peer.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "app_rssi_filter.h"
+#include "app_rssi_motion.h"
+#include "app_rssi_intent.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static int8_t App_RssiIntentBoost(int8_t delta);
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Resets the intent state of a vehicle.
+*
+* \param[in]    pState          Intent state.
+* \param[in]    kind            RSSI filter kind.
+********************************************************************************** */
+void App_RssiIntentReset(appRssiIntent_t *pState, appRssiFilterKind_t kind)
+{
+    App_RssiFilterInit(&pState->filter, kind);
+    App_RssiMotionReset(&pState->motion);
+    pState->motionHint = gAppRssiMotionNeutral_c;
+    pState->sameIntentCount = 0U;
+    pState->lastIntent = App_Undefined;
+    pState->rssi0 = 0;
+    pState->filteredRssi = 0;
+    pState->sampleCount = 0U;
+    pState->validRssi0 = FALSE;
+}
+
+/*! *********************************************************************************
+* \brief        Adds an RSSI sample of the vehicle.
+*
+* \param[in]    pState          Intent state.
+* \param[in]    rssi            Sample, dBm.
+* \param[in]    pParams         Thresholds.
+* \param[in]    pMotion         Motion sensor state, NULL to decide on RSSI alone.
+*
+* \return       Intent to send to the vehicle, App_Undefined if none.
+********************************************************************************** */
+appIntent_t App_RssiIntentUpdate(appRssiIntent_t *pState, int8_t rssi, const appRssiIntentParams_t *pParams,
+                                 const appRssiMotionInput_t *pMotion)
+{
+    appIntent_t sendIntent = App_Undefined;
+    appIntent_t intent = pState->lastIntent;
+    appRssiIntentParams_t fused;
+
+    pState->filteredRssi = App_RssiFilterUpdate(&pState->filter, rssi);
+    if (pMotion != NULL)
+    {
+        pState->motionHint = App_RssiMotionUpdate(&pState->motion, pState->filteredRssi, pMotion);
+    }
+    if (pState->motionHint == gAppRssiMotionApproach_c)
+    {
+        /* Walking to the vehicle: every threshold closer to RSSI_0 */
+        fused = *pParams;
+        fused.deltaLow = App_RssiIntentBoost(pParams->deltaLow);
+        fused.deltaMedium = App_RssiIntentBoost(pParams->deltaMedium);
+        fused.deltaHigh = App_RssiIntentBoost(pParams->deltaHigh);
+        pParams = &fused;
+    }
+    if (pState->sampleCount < gAppRssiSettleSamples_c)
+    {
+        pState->sampleCount++;
+    }
+
+    if (pState->sampleCount == gAppRssiSettleSamples_c)
+    {
+        if (pState->validRssi0 == FALSE)
+        {
+            if (pState->filteredRssi >= pParams->rssiIntentHigh)
+            {
+                /* Already close: RSSI_0 assumed below, high intent right away */
+                pState->rssi0 = (int8_t)(pParams->rssiIntentHigh - gAppRssiIntentCorrection_c);
+                intent = App_HighIntent;
+                sendIntent = App_HighIntent;
+                pState->sameIntentCount = 0U;
+            }
+            else
+            {
+                pState->rssi0 = pState->filteredRssi;
+            }
+            pState->validRssi0 = TRUE;
+        }
+        else
+        {
+            intent = App_RssiIntentDecide(pState->filteredRssi, pState->rssi0, pParams);
+            if (intent != App_Undefined)
+            {
+                if (intent != pState->lastIntent)
+                {
+                    sendIntent = intent;
+                    pState->sameIntentCount = 0U;
+                }
+                else if (pParams->repeatSameIntent == FALSE)
+                {
+                    ; /* Unchanged intent, sent once */
+                }
+                else if (pState->sameIntentCount >= pParams->sameIntentSamples)
+                {
+                    sendIntent = intent;
+                    pState->sameIntentCount = 0U;
+                }
+                else
+                {
+                    pState->sameIntentCount++;
+                }
+            }
+        }
+        if ((pState->motionHint == gAppRssiMotionStationary_c) &&
+            (pState->filteredRssi >= pParams->rssiIntentHigh))
+        {
+            /* Standing near the vehicle: nothing sent, the intent is sent
+               as a change once the user moves. Further away, RSSI decides */
+            sendIntent = App_Undefined;
+        }
+        else
+        {
+            pState->lastIntent = intent;
+        }
+    }
+
+    return sendIntent;
+}
+
+/*! *********************************************************************************
+* \brief        Decide new intent according to new rssi and RSSI_0.
+*
+* \param[in]    filteredRssi    Filtered rssi value.
+* \param[in]    rssi0           First filtered rssi value.
+* \param[in]    pParams         Thresholds.
+********************************************************************************** */
+appIntent_t App_RssiIntentDecide(int8_t filteredRssi, int8_t rssi0, const appRssiIntentParams_t *pParams)
+{
+    appIntent_t intent;
+
+    if (filteredRssi >= (rssi0 + pParams->deltaHigh))
+    {
+        intent = App_HighIntent;
+    }
+    else if (filteredRssi >= (rssi0 + pParams->deltaMedium))
+    {
+        intent = App_MediumIntent;
+    }
+    else if (filteredRssi >= (rssi0 + pParams->deltaLow))
+    {
+        intent = App_LowIntent;
+    }
+    else
+    {
+        intent = App_Undefined;
+    }
+    return intent;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Threshold lowered by gAppRssiMotionBoostDb_c, at least 1 dB.
+********************************************************************************** */
+static int8_t App_RssiIntentBoost(int8_t delta)
+{
+    return (delta > (gAppRssiMotionBoostDb_c + 1)) ? (int8_t)(delta - gAppRssiMotionBoostDb_c) :
+           ((delta > 1) ? 1 : delta);
+}
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
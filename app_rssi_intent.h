@@ -0,0 +1,101 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_rssi_intent.h
+*
+* Approach intent from the RSSI of one vehicle: filtered RSSI against RSSI_0,
+* the filtered value taken once the filter has settled, optionally fused with
+* the motion sensor state.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef APP_RSSI_INTENT_H
+#define APP_RSSI_INTENT_H
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "app_rssi_filter.h"
+#include "app_rssi_motion.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+/*! Samples filtered before RSSI_0 is taken */
+#ifndef gAppRssiSettleSamples_c
+#define gAppRssiSettleSamples_c              (10U)
+#endif
+
+/*! RSSI_0 below rssi_intent_high when the first filtered value is already above it */
+#define gAppRssiIntentCorrection_c           (20)
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+typedef enum appIntent_tag
+{
+    App_LowIntent = 0,
+    App_MediumIntent,
+    App_HighIntent,
+    App_Undefined
+}appIntent_t;
+
+/*! \brief  Thresholds, from the system parameters. */
+typedef struct appRssiIntentParams_tag
+{
+    int8_t      rssiIntentHigh;     /*!< High intent right away if the first filtered value reaches it;
+                                         near the vehicle, intents held while stationary */
+    int8_t      deltaLow;           /*!< dB above RSSI_0 for each intent */
+    int8_t      deltaMedium;
+    int8_t      deltaHigh;
+    bool_t      repeatSameIntent;   /*!< An unchanged intent is sent again every sameIntentSamples */
+    uint32_t    sameIntentSamples;
+}appRssiIntentParams_t;
+
+/*! \brief  Intent state of one vehicle. */
+typedef struct appRssiIntent_tag
+{
+    appRssiFilter_t filter;
+    appRssiMotion_t motion;
+    appRssiMotionHint_t motionHint; /*!< Hint of the last sample */
+    uint32_t        sameIntentCount;
+    appIntent_t     lastIntent;
+    int8_t          rssi0;
+    int8_t          filteredRssi;
+    uint8_t         sampleCount;    /*!< Saturates at gAppRssiSettleSamples_c */
+    bool_t          validRssi0;
+}appRssiIntent_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void App_RssiIntentReset(appRssiIntent_t *pState, appRssiFilterKind_t kind);
+appIntent_t App_RssiIntentUpdate(appRssiIntent_t *pState, int8_t rssi, const appRssiIntentParams_t *pParams,
+                                 const appRssiMotionInput_t *pMotion);
+appIntent_t App_RssiIntentDecide(int8_t filteredRssi, int8_t rssi0, const appRssiIntentParams_t *pParams);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_RSSI_INTENT_H */
+
+/*! *********************************************************************************
+ * @}
+ ********************************************************************************** */
@@ -0,0 +1,118 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_rssi_motion.c
+*
+* RSSI trend and motion fusion, integer only: two EMAs and a counter per
+* sample.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "app_rssi_motion.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+/* Division rather than shift: symmetric for negative deltas. Kept in Q16:
+   the truncation leaves up to 2^shift - 1 in the average, under 1 in Q8 */
+#define mcMotionEma(avg, sample)            ((avg) + (((sample) - (avg)) / (int32_t)(1UL << gAppRssiMotionEmaShift_c)))
+#define mcMotionQ8ToQ16(q8)                 ((int32_t)(q8) * 256)
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Resets the estimator.
+*
+* \param[in]    pMotion         Estimator state.
+********************************************************************************** */
+void App_RssiMotionReset(appRssiMotion_t *pMotion)
+{
+    pMotion->slopeQ16 = 0;
+    pMotion->cadenceQ16 = 0;
+    pMotion->lastStepCount = 0U;
+    pMotion->stillSamples = 0U;
+    pMotion->lastRssi = 0;
+    pMotion->primed = FALSE;
+}
+
+/*! *********************************************************************************
+* \brief        Adds a filtered RSSI sample and the motion state at that time.
+*
+* \param[in]    pMotion         Estimator state.
+* \param[in]    filteredRssi    Filtered RSSI, dBm.
+* \param[in]    pInput          Motion sensor state.
+*
+* \return       Motion hint for the intent decision.
+********************************************************************************** */
+appRssiMotionHint_t App_RssiMotionUpdate(appRssiMotion_t *pMotion, int8_t filteredRssi, const appRssiMotionInput_t *pInput)
+{
+    appRssiMotionHint_t hint = gAppRssiMotionNeutral_c;
+    uint32_t steps;
+
+    if (pMotion->primed == FALSE)
+    {
+        pMotion->lastRssi = filteredRssi;
+        pMotion->lastStepCount = pInput->stepCount;
+        pMotion->primed = TRUE;
+    }
+
+    /* Unsigned difference: the step counter may wrap */
+    steps = pInput->stepCount - pMotion->lastStepCount;
+    pMotion->lastStepCount = pInput->stepCount;
+    if (steps > 255U)
+    {
+        steps = 255U;
+    }
+
+    pMotion->slopeQ16 = mcMotionEma(pMotion->slopeQ16, ((int32_t)filteredRssi - (int32_t)pMotion->lastRssi) * 65536);
+    pMotion->cadenceQ16 = mcMotionEma(pMotion->cadenceQ16, (int32_t)steps * 65536);
+    pMotion->lastRssi = filteredRssi;
+
+    if ((steps != 0U) || (pInput->walking == TRUE))
+    {
+        pMotion->stillSamples = 0U;
+    }
+    else if (pMotion->stillSamples < gAppRssiMotionStillSamples_c)
+    {
+        pMotion->stillSamples++;
+    }
+    else
+    {
+        ; /* For MISRA compliance */
+    }
+
+    if (pMotion->stillSamples >= gAppRssiMotionStillSamples_c)
+    {
+        hint = gAppRssiMotionStationary_c;
+    }
+    else if ((pInput->walking == TRUE) &&
+             (pMotion->cadenceQ16 >= mcMotionQ8ToQ16(gAppRssiMotionCadenceMinQ8_c)) &&
+             (pMotion->slopeQ16 >= mcMotionQ8ToQ16(gAppRssiMotionSlopeMinQ8_c)))
+    {
+        hint = gAppRssiMotionApproach_c;
+    }
+    else
+    {
+        ; /* For MISRA compliance */
+    }
+
+    return hint;
+}
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
@@ -0,0 +1,115 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_rssi_motion.h
+*
+* Fuses the filtered RSSI trend with the motion sensor walk / still state and
+* step cadence: approach while walking with a rising RSSI, stationary when no
+* step has been seen for a while. The intent logic holds intents only while
+* stationary near the vehicle.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef APP_RSSI_MOTION_H
+#define APP_RSSI_MOTION_H
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+/*! Motion fusion of the approach intent. Needs the motion sensor: without
+    step events the user is seen stationary and no intent is sent near the
+    vehicle.
+    Redefine it in the app_preinclude.h file */
+#ifndef gAppRssiMotionFusion_d
+#define gAppRssiMotionFusion_d               (1)
+#endif
+
+/*! RSSI slope and step cadence EMA weight of a new sample: 1 / 2^shift */
+#ifndef gAppRssiMotionEmaShift_c
+#define gAppRssiMotionEmaShift_c             (4U)
+#endif
+
+/*! Rising RSSI while walking, dB per sample in Q8 (8: ~1 dB/s at 30 ms) */
+#ifndef gAppRssiMotionSlopeMinQ8_c
+#define gAppRssiMotionSlopeMinQ8_c           (8)
+#endif
+
+/*! Walking cadence, steps per sample in Q8 (8: ~1 step/s at 30 ms) */
+#ifndef gAppRssiMotionCadenceMinQ8_c
+#define gAppRssiMotionCadenceMinQ8_c         (8)
+#endif
+
+/*! Samples without step and without walk state before the user is stationary */
+#ifndef gAppRssiMotionStillSamples_c
+#define gAppRssiMotionStillSamples_c         (100U)
+#endif
+
+/*! Intent thresholds lowered by this while approaching, dB */
+#ifndef gAppRssiMotionBoostDb_c
+#define gAppRssiMotionBoostDb_c              (3)
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+/*! \brief  Fused motion hint. */
+typedef enum appRssiMotionHint_tag
+{
+    gAppRssiMotionNeutral_c = 0,    /*!< RSSI alone decides */
+    gAppRssiMotionApproach_c,       /*!< Walking, RSSI rising: intent earlier */
+    gAppRssiMotionStationary_c      /*!< Not moving: intent held */
+}appRssiMotionHint_t;
+
+/*! \brief  Motion sensor state at the time of an RSSI sample. */
+typedef struct appRssiMotionInput_tag
+{
+    bool_t      walking;            /*!< Last sensor event was a walk, not a still */
+    uint32_t    stepCount;          /*!< Free running step counter */
+}appRssiMotionInput_t;
+
+/*! \brief  Estimator state of one vehicle. */
+typedef struct appRssiMotion_tag
+{
+    int32_t     slopeQ16;           /*!< Filtered RSSI slope, dB per sample in Q16 */
+    int32_t     cadenceQ16;         /*!< Steps per sample in Q16 */
+    uint32_t    lastStepCount;
+    uint16_t    stillSamples;       /*!< Samples since the last step, saturated */
+    int8_t      lastRssi;
+    bool_t      primed;
+}appRssiMotion_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void App_RssiMotionReset(appRssiMotion_t *pMotion);
+appRssiMotionHint_t App_RssiMotionUpdate(appRssiMotion_t *pMotion, int8_t filteredRssi, const appRssiMotionInput_t *pInput);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_RSSI_MOTION_H */
+
+/*! *********************************************************************************
+ * @}
+ ********************************************************************************** */
@@ -130,7 +130,7 @@ STATIC void App_ScanningCallback
 )
 {
     appMsgFromHost_t *pMsgIn = NULL;
-    uint32_t msgLen = sizeof(uint32_t) + sizeof(gapScanningEvent_t);
+    uint32_t msgLen = (uint32_t)&(pMsgIn->msgData) + sizeof(gapScanningEvent_t);
 
     if (pScanningEvent->eventType == gDeviceScanned_c)
     {
@@ -289,9 +289,6 @@ STATIC void App_ScanningCallback
     if (pMsgIn != NULL)
     {
         /* Put message in the Host Stack to App queue */
-        (void)MSG_QueueAddTail(&mHostAppInputQueue, pMsgIn);
-        
-        /* Signal application */
-        (void)OSA_EventSet(mAppEvent, gAppEvtMsgFromHostStack_c);
+        App_PostHostMessage(pMsgIn);
     }
 }
@@ -41,6 +41,7 @@
 #include "motion_sensor.h"
 #include "fsl_lpspi_cmsis.h"
 #include "app_nvm.h"
+#include "app_counters.h"
 
 #include "trace.h"
 
@@ -320,6 +321,7 @@ void APP_InitServices(void)
 #endif
     App_NvmLoadSystemParams();
     App_NvmLoadBleKeys();
+    App_CountersInit();
 #ifdef BMW_KEYFOB_EVK_BOARD
     /* No MS initialization required */
 #else
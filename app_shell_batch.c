@@ -0,0 +1,417 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_shell_batch.c
+*
+* Binary batch commands. The serial manager task assembles a frame; once its
+* CRC checks, the frame is run from the housekeeping queue, each command by
+* the handler registered for its opcode, and the response frame written. The
+* receiver drops bytes until the response is sent. The response is kept until
+* the next request runs: a request sent again is answered from it. The
+* commands themselves are registered with the text shell ones,
+* shell_digital_key_device.c.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "app_shell_batch.h"
+
+#if defined(gAppShellBatch_d) && (gAppShellBatch_d == 1)
+#include "fsl_component_serial_manager.h"
+#include "fsl_component_timer_manager.h"
+#include "ble_general.h"
+#include "app.h"
+#include "app_conn.h"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mcShellBatchCrcPoly_c       (0x1021U)
+#define mcShellBatchCrcInit_c       (0xFFFFU)
+#define mcShellBatchMaxValue_c      (0xFFU)
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+/* Command handlers, indexed by opcode */
+static pfShellBatchHandler_t maShellBatchHandlers[gAppShellBatchOpcodeCount_c];
+
+/* Sequence number and frame length of the last response, 0 before the first */
+static uint8_t mShellBatchLastSeq = 0U;
+static uint16_t mShellBatchLastLength = 0U;
+
+#if defined(gAppShellBatch_d) && (gAppShellBatch_d == 1)
+static uint8_t maShellBatchRxFrame[gAppShellBatchFrameSize_c];
+static uint8_t maShellBatchTxFrame[gAppShellBatchFrameSize_c];
+static appShellBatchRx_t mShellBatchRx = {maShellBatchRxFrame, 0U, 0U, 0U, 0U};
+static appShellBatchStats_t mShellBatchStats;
+
+/* Set once a request is complete, cleared once its response is sent */
+static volatile bool_t mShellBatchBusy = FALSE;
+static uint64_t mShellBatchLastByteTs = 0U;
+
+static SERIAL_MANAGER_WRITE_HANDLE_DEFINE(mShellBatchWriteHandle);
+static SERIAL_MANAGER_READ_HANDLE_DEFINE(mShellBatchReadHandle);
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static uint16_t App_ShellBatchRun(const uint8_t *pPayload, uint16_t length, uint8_t *pOut,
+                                  appShellBatchStats_t *pStats);
+#if defined(gAppShellBatch_d) && (gAppShellBatch_d == 1)
+static void App_ShellBatchRxCallback(void *pParam, serial_manager_callback_message_t *pMessage,
+                                     serial_manager_status_t status);
+static void App_ShellBatchTxCallback(void *pParam, serial_manager_callback_message_t *pMessage,
+                                     serial_manager_status_t status);
+static void App_ShellBatchHandler(appCallbackParam_t param);
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+#if defined(gAppShellBatch_d) && (gAppShellBatch_d == 1)
+/*! *********************************************************************************
+* \brief        Opens the second serial manager instance for the batch
+*               commands, after the serial managers are initialized.
+********************************************************************************** */
+void App_ShellBatchInit(void)
+{
+    if ((kStatus_SerialManager_Success ==
+         SerialManager_OpenWriteHandle((serial_handle_t)gSerMgrIf2, (serial_write_handle_t)mShellBatchWriteHandle)) &&
+        (kStatus_SerialManager_Success ==
+         SerialManager_OpenReadHandle((serial_handle_t)gSerMgrIf2, (serial_read_handle_t)mShellBatchReadHandle)))
+    {
+        (void)SerialManager_InstallTxCallback((serial_write_handle_t)mShellBatchWriteHandle,
+                                              App_ShellBatchTxCallback, NULL);
+        (void)SerialManager_InstallRxCallback((serial_read_handle_t)mShellBatchReadHandle,
+                                              App_ShellBatchRxCallback, NULL);
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Batch commands counters.
+********************************************************************************** */
+const appShellBatchStats_t *App_ShellBatchGetStats(void)
+{
+    mShellBatchStats.crcErrors = mShellBatchRx.crcErrors;
+    mShellBatchStats.badLengths = mShellBatchRx.badLengths;
+    return &mShellBatchStats;
+}
+#endif /* gAppShellBatch_d */
+
+/*! *********************************************************************************
+* \brief        CRC-16 CCITT, polynomial 0x1021, initial value 0xFFFF.
+********************************************************************************** */
+uint16_t App_ShellBatchCrc(const uint8_t *pData, uint32_t length)
+{
+    uint16_t crc = mcShellBatchCrcInit_c;
+    uint32_t i;
+    uint8_t bit;
+
+    for (i = 0U; i < length; i++)
+    {
+        crc ^= (uint16_t)((uint16_t)pData[i] << 8U);
+        for (bit = 0U; bit < 8U; bit++)
+        {
+            crc = ((crc & 0x8000U) != 0U) ? (uint16_t)((crc << 1U) ^ mcShellBatchCrcPoly_c) : (uint16_t)(crc << 1U);
+        }
+    }
+    return crc;
+}
+
+/*! *********************************************************************************
+* \brief        Adds the header and CRC around a payload.
+*
+* \param[in]    pFrame          Frame, the payload at gAppShellBatchHeaderSize_c.
+* \param[in]    payloadLength   Payload length.
+*
+* \return       Frame length.
+********************************************************************************** */
+uint16_t App_ShellBatchFrame(uint8_t *pFrame, uint16_t payloadLength)
+{
+    uint16_t crc;
+
+    pFrame[0] = gAppShellBatchSync_c;
+    pFrame[1] = (uint8_t)payloadLength;
+    pFrame[2] = (uint8_t)(payloadLength >> 8U);
+    crc = App_ShellBatchCrc(&pFrame[1], 2U + (uint32_t)payloadLength);
+    pFrame[gAppShellBatchHeaderSize_c + payloadLength] = (uint8_t)crc;
+    pFrame[gAppShellBatchHeaderSize_c + payloadLength + 1U] = (uint8_t)(crc >> 8U);
+    return (uint16_t)(gAppShellBatchHeaderSize_c + payloadLength + gAppShellBatchCrcSize_c);
+}
+
+/*! *********************************************************************************
+* \brief        Receives a byte. Bytes out of a frame are skipped up to the
+*               next sync, a frame with a bad length or CRC is dropped.
+*
+* \return       TRUE when the byte ends a frame with a good CRC: its payload is
+*               at gAppShellBatchHeaderSize_c, payloadLength bytes, until the
+*               next byte.
+********************************************************************************** */
+bool_t App_ShellBatchRxByte(appShellBatchRx_t *pRx, uint8_t byte)
+{
+    bool_t complete = FALSE;
+    uint16_t crc;
+    uint16_t end;
+
+    if ((pRx->received != 0U) || (byte == gAppShellBatchSync_c))
+    {
+        pRx->pFrame[pRx->received] = byte;
+        pRx->received++;
+        end = (uint16_t)(gAppShellBatchHeaderSize_c + pRx->payloadLength + gAppShellBatchCrcSize_c);
+
+        if (pRx->received == gAppShellBatchHeaderSize_c)
+        {
+            pRx->payloadLength = (uint16_t)pRx->pFrame[1] | (uint16_t)((uint16_t)pRx->pFrame[2] << 8U);
+            if ((pRx->payloadLength == 0U) || (pRx->payloadLength > gAppShellBatchMaxPayload_c))
+            {
+                pRx->badLengths++;
+                pRx->received = 0U;
+            }
+        }
+        else if ((pRx->received > gAppShellBatchHeaderSize_c) && (pRx->received == end))
+        {
+            crc = App_ShellBatchCrc(&pRx->pFrame[1], 2U + (uint32_t)pRx->payloadLength);
+            if ((pRx->pFrame[end - 2U] == (uint8_t)crc) && (pRx->pFrame[end - 1U] == (uint8_t)(crc >> 8U)))
+            {
+                complete = TRUE;
+            }
+            else
+            {
+                pRx->crcErrors++;
+            }
+            pRx->received = 0U;
+        }
+        else
+        {
+            ; /* No action required */
+        }
+    }
+    return complete;
+}
+
+/*! *********************************************************************************
+* \brief        Sets the handler of a command.
+********************************************************************************** */
+void App_ShellBatchRegister(uint8_t opcode, pfShellBatchHandler_t pfHandler)
+{
+    if (opcode < (uint8_t)gAppShellBatchOpcodeCount_c)
+    {
+        maShellBatchHandlers[opcode] = pfHandler;
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Runs the commands of a request and builds the response. A
+*               request of the sequence number of the last one is the host
+*               sending it again, its response late or lost: the last
+*               response, still in pFrame, is sent again and the commands are
+*               not run twice.
+*
+* \param[in]    pPayload        Request payload.
+* \param[in]    length          Its length, at least 1.
+* \param[out]   pFrame          Response frame, gAppShellBatchFrameSize_c bytes,
+*                               the same on every call.
+* \param[out]   pStats          Counters updated.
+*
+* \return       Response frame length.
+********************************************************************************** */
+uint16_t App_ShellBatchProcess(const uint8_t *pPayload, uint16_t length, uint8_t *pFrame,
+                               appShellBatchStats_t *pStats)
+{
+    uint16_t frameLength;
+
+    if ((mShellBatchLastLength != 0U) && (pPayload[0] == mShellBatchLastSeq))
+    {
+        pStats->replays++;
+        frameLength = mShellBatchLastLength;
+    }
+    else
+    {
+        frameLength = App_ShellBatchFrame(pFrame, App_ShellBatchRun(pPayload, length,
+                                                                    &pFrame[gAppShellBatchHeaderSize_c], pStats));
+        mShellBatchLastSeq = pPayload[0];
+        mShellBatchLastLength = frameLength;
+    }
+    return frameLength;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Runs the commands of a request, their results to the response
+*               payload.
+*
+* \return       Response payload length.
+********************************************************************************** */
+static uint16_t App_ShellBatchRun(const uint8_t *pPayload, uint16_t length, uint8_t *pOut,
+                                  appShellBatchStats_t *pStats)
+{
+    appShellBatchResult_t result;
+    appShellBatchStatus_t status;
+    uint16_t in = 1U;
+    uint16_t out = 1U;
+    uint16_t room;
+    uint8_t opcode;
+    uint8_t argsLength;
+    bool_t stop = FALSE;
+
+    /* Sequence number */
+    pOut[0] = pPayload[0];
+
+    while ((in < length) && (stop == FALSE) &&
+           ((gAppShellBatchMaxPayload_c - out) >= gAppShellBatchResultHeaderSize_c))
+    {
+        opcode = pPayload[in];
+        argsLength = ((in + 1U) < length) ? pPayload[in + 1U] : 0U;
+        room = (uint16_t)(gAppShellBatchMaxPayload_c - out - gAppShellBatchResultHeaderSize_c);
+        result.type = (uint8_t)gAppShellBatchNone_c;
+        result.length = 0U;
+        result.size = (room < mcShellBatchMaxValue_c) ? (uint8_t)room : (uint8_t)mcShellBatchMaxValue_c;
+        result.pValue = &pOut[out + gAppShellBatchResultHeaderSize_c];
+
+        if (((uint32_t)in + gAppShellBatchCmdHeaderSize_c + argsLength) > length)
+        {
+            /* Cut short: the commands after it cannot be found */
+            status = gAppShellBatchBadArgs_c;
+            stop = TRUE;
+        }
+        else if ((opcode >= (uint8_t)gAppShellBatchOpcodeCount_c) || (maShellBatchHandlers[opcode] == NULL))
+        {
+            status = gAppShellBatchUnknownCommand_c;
+        }
+        else
+        {
+            status = maShellBatchHandlers[opcode](&pPayload[in + gAppShellBatchCmdHeaderSize_c], argsLength, &result);
+        }
+
+        if (status == gAppShellBatchNoRoom_c)
+        {
+            result.type = (uint8_t)gAppShellBatchNone_c;
+            result.length = 0U;
+            stop = TRUE;
+        }
+        if (status != gAppShellBatchOk_c)
+        {
+            pStats->failed++;
+        }
+        pStats->commands++;
+
+        pOut[out] = opcode;
+        pOut[out + 1U] = (uint8_t)status;
+        pOut[out + 2U] = result.type;
+        pOut[out + 3U] = result.length;
+        out += (uint16_t)(gAppShellBatchResultHeaderSize_c + result.length);
+        in += (uint16_t)(gAppShellBatchCmdHeaderSize_c + argsLength);
+    }
+    pStats->frames++;
+
+    return out;
+}
+
+#if defined(gAppShellBatch_d) && (gAppShellBatch_d == 1)
+/*! *********************************************************************************
+* \brief        Bytes received, serial manager task: a complete request is run
+*               from the housekeeping queue.
+********************************************************************************** */
+static void App_ShellBatchRxCallback(void *pParam, serial_manager_callback_message_t *pMessage,
+                                     serial_manager_status_t status)
+{
+    uint8_t aBytes[16];
+    uint32_t count;
+    uint32_t i;
+    uint64_t now = TM_GetTimestamp();
+
+    (void)pParam;
+    (void)pMessage;
+    (void)status;
+
+    if ((mShellBatchRx.received != 0U) &&
+        ((now - mShellBatchLastByteTs) > ((uint64_t)gAppShellBatchRxTimeoutMs_c * 1000U)))
+    {
+        mShellBatchStats.timeouts++;
+        mShellBatchRx.received = 0U;
+    }
+    mShellBatchLastByteTs = now;
+
+    do
+    {
+        count = 0U;
+        (void)SerialManager_TryRead((serial_read_handle_t)mShellBatchReadHandle, aBytes, sizeof(aBytes), &count);
+        for (i = 0U; i < count; i++)
+        {
+            if (mShellBatchBusy == TRUE)
+            {
+                mShellBatchStats.busy++;
+            }
+            else if (App_ShellBatchRxByte(&mShellBatchRx, aBytes[i]) == TRUE)
+            {
+                mShellBatchBusy = TRUE;
+                if (gBleSuccess_c != App_PostCallbackMessageToQueue(App_ShellBatchHandler, NULL, gAppQueueHousekeeping_c))
+                {
+                    /* Out of messages: the host times out and sends again */
+                    mShellBatchBusy = FALSE;
+                }
+            }
+            else
+            {
+                ; /* No action required */
+            }
+        }
+    } while (count == sizeof(aBytes));
+}
+
+/*! *********************************************************************************
+* \brief        Response sent: the next request can be received.
+********************************************************************************** */
+static void App_ShellBatchTxCallback(void *pParam, serial_manager_callback_message_t *pMessage,
+                                     serial_manager_status_t status)
+{
+    (void)pParam;
+    (void)pMessage;
+    (void)status;
+    mShellBatchBusy = FALSE;
+}
+
+/*! *********************************************************************************
+* \brief        Runs a request, application task, and sends its response.
+********************************************************************************** */
+static void App_ShellBatchHandler(appCallbackParam_t param)
+{
+    uint16_t length;
+
+    (void)param;
+    length = App_ShellBatchProcess(&maShellBatchRxFrame[gAppShellBatchHeaderSize_c], mShellBatchRx.payloadLength,
+                                   maShellBatchTxFrame, &mShellBatchStats);
+    if (kStatus_SerialManager_Success !=
+        SerialManager_WriteNonBlocking((serial_write_handle_t)mShellBatchWriteHandle, maShellBatchTxFrame, length))
+    {
+        mShellBatchBusy = FALSE;
+    }
+}
+#endif /* gAppShellBatch_d */
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
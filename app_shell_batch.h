@@ -0,0 +1,193 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_shell_batch.h
+*
+* Binary batch commands, alongside the text shell, for test rigs driving many
+* commands per scenario. They come on the second serial manager instance in
+* frames carrying several commands each, and are answered in one frame of
+* typed results.
+*
+* Frame: gAppShellBatchSync_c, payload length (2 bytes), payload, CRC-16
+* CCITT (polynomial 0x1021, initial value 0xFFFF) of the length and payload
+* (2 bytes). Multi-byte values are least significant byte first.
+* Request payload: sequence number, then commands: opcode, argument length,
+* arguments. Response payload: the sequence number of the request, then a
+* result per command, in order: opcode, appShellBatchStatus_t,
+* appShellBatchType_t, value length, value. A command failing does not stop
+* the next ones; a result that does not fit in the response does, the
+* commands after it are not run.
+*
+* A request is answered before the next one is received: the host waits for
+* the response, or gAppShellBatchRxTimeoutMs_c after a frame dropped for its
+* CRC, before sending again. A request sent again keeps its sequence number:
+* it is answered with the last response, its commands not run twice. Each new
+* request takes another sequence number. The second instance does not wake the keyfob
+* from low power, as LPUART0 does: rigs keep it awake, or build it with
+* gAppLowpowerEnabled_d 0.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef APP_SHELL_BATCH_H
+#define APP_SHELL_BATCH_H
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+/*! Enable/disable the batch commands, on the second serial manager instance.
+    Redefine it in the app_preinclude.h file */
+#ifndef gAppShellBatch_d
+#define gAppShellBatch_d                     0
+#endif
+
+/*! Largest payload of a request or a response. Redefine it in the
+    app_preinclude.h file */
+#ifndef gAppShellBatchMaxPayload_c
+#define gAppShellBatchMaxPayload_c           (256U)
+#endif
+
+/*! Gap between two bytes of a frame that drops it. Redefine it in the
+    app_preinclude.h file */
+#ifndef gAppShellBatchRxTimeoutMs_c
+#define gAppShellBatchRxTimeoutMs_c          (50U)
+#endif
+
+#define gAppShellBatchSync_c                 (0xA5U)
+
+/*! Frame header: sync, payload length. CRC after the payload. */
+#define gAppShellBatchHeaderSize_c           (3U)
+#define gAppShellBatchCrcSize_c              (2U)
+#define gAppShellBatchFrameSize_c            (gAppShellBatchHeaderSize_c + gAppShellBatchMaxPayload_c + gAppShellBatchCrcSize_c)
+
+/*! Command header: opcode, argument length */
+#define gAppShellBatchCmdHeaderSize_c        (2U)
+
+/*! Result header: opcode, status, type, value length */
+#define gAppShellBatchResultHeaderSize_c     (4U)
+
+#if (gAppShellBatch_d == 1) && (!defined(gAppUseSerialManager_c) || (gAppUseSerialManager_c < 2))
+#error "gAppShellBatch_d needs the second serial manager instance, gAppUseSerialManager_c 2"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+/*! \brief  Commands. */
+typedef enum appShellBatchOpcode_tag
+{
+    gAppShellBatchVersion_c = 1,        /*!< Software version: string */
+    gAppShellBatchGetParam_c,           /*!< Parameter ID: its value, int32 */
+    gAppShellBatchSetParam_c,           /*!< Parameter ID, int32 value: set and saved */
+    gAppShellBatchGetParams_c,          /*!< Every parameter: the params_tlv record, bytes */
+    gAppShellBatchSetParams_c,          /*!< params_tlv record: applied whole or not at all,
+                                             the params_tlv_status record, bytes */
+    gAppShellBatchRkeLock_c,            /*!< As the lock shell command */
+    gAppShellBatchRkeUnlock_c,          /*!< As the unlock shell command */
+    gAppShellBatchRkeRelease_c,         /*!< As the release shell command */
+    gAppShellBatchDisconnect_c,         /*!< As the dcnt shell command */
+    gAppShellBatchOpcodeCount_c
+}appShellBatchOpcode_t;
+
+/*! \brief  Outcome of a command. */
+typedef enum appShellBatchStatus_tag
+{
+    gAppShellBatchOk_c = 0,
+    gAppShellBatchUnknownCommand_c,     /*!< No such opcode */
+    gAppShellBatchBadArgs_c,            /*!< Argument length or value not valid */
+    gAppShellBatchFailed_c,             /*!< Valid, not carried out */
+    gAppShellBatchNoRoom_c              /*!< Result too large for the rest of the response */
+}appShellBatchStatus_t;
+
+/*! \brief  Type of a result value. */
+typedef enum appShellBatchType_tag
+{
+    gAppShellBatchNone_c = 0,           /*!< No value */
+    gAppShellBatchInt32_c,              /*!< 4 bytes, signed */
+    gAppShellBatchBytes_c,              /*!< Record, see the command */
+    gAppShellBatchString_c              /*!< ASCII, not terminated */
+}appShellBatchType_t;
+
+/*! \brief  Value of a result, set by the command handler. */
+typedef struct appShellBatchResult_tag
+{
+    uint8_t     type;                   /*!< appShellBatchType_t */
+    uint8_t     length;                 /*!< Bytes written to pValue */
+    uint8_t     size;                   /*!< Room in pValue */
+    uint8_t     *pValue;
+}appShellBatchResult_t;
+
+/*! \brief  Command handler, run from the application task. The result is
+ *          gAppShellBatchNone_c, 0 bytes, on entry. */
+typedef appShellBatchStatus_t (*pfShellBatchHandler_t)(const uint8_t *pArgs, uint8_t argsLength,
+                                                       appShellBatchResult_t *pResult);
+
+/*! \brief  Frame receiver. */
+typedef struct appShellBatchRx_tag
+{
+    uint8_t     *pFrame;                /*!< gAppShellBatchFrameSize_c bytes */
+    uint16_t    received;               /*!< Bytes of the frame so far */
+    uint16_t    payloadLength;
+    uint32_t    crcErrors;
+    uint32_t    badLengths;             /*!< Payload length 0 or above gAppShellBatchMaxPayload_c */
+}appShellBatchRx_t;
+
+/*! \brief  Batch commands counters. */
+typedef struct appShellBatchStats_tag
+{
+    uint32_t    frames;                 /*!< Requests run */
+    uint32_t    replays;                /*!< Requests sent again, answered with the last response */
+    uint32_t    commands;
+    uint32_t    failed;                 /*!< Commands not Ok */
+    uint32_t    crcErrors;
+    uint32_t    badLengths;
+    uint32_t    timeouts;               /*!< Frames dropped for a gap between bytes */
+    uint32_t    busy;                   /*!< Bytes dropped while a request was pending */
+}appShellBatchStats_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(gAppShellBatch_d) && (gAppShellBatch_d == 1)
+void App_ShellBatchInit(void);
+const appShellBatchStats_t *App_ShellBatchGetStats(void);
+#else
+#define App_ShellBatchInit()
+#endif /* gAppShellBatch_d */
+
+/* Framing and dispatch, also built in the host client (tools/shell_batch). */
+uint16_t App_ShellBatchCrc(const uint8_t *pData, uint32_t length);
+uint16_t App_ShellBatchFrame(uint8_t *pFrame, uint16_t payloadLength);
+bool_t App_ShellBatchRxByte(appShellBatchRx_t *pRx, uint8_t byte);
+void App_ShellBatchRegister(uint8_t opcode, pfShellBatchHandler_t pfHandler);
+uint16_t App_ShellBatchProcess(const uint8_t *pPayload, uint16_t length, uint8_t *pFrame,
+                               appShellBatchStats_t *pStats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_SHELL_BATCH_H */
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
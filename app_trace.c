@@ -0,0 +1,188 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_trace.c
+*
+* Event trace ring. Writers reserve a slot with LDREX/STREX on the head index
+* and fill it without a critical section, so tasks and interrupts can trace at
+* any priority; an entry preempted while being filled may be stamped a few
+* cycles after the one that preempted it. The ring overwrites the oldest
+* entries.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "fsl_device_registers.h"
+#include "FunctionLib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "app_trace.h"
+
+#if defined(gAppTrace_d) && (gAppTrace_d == 1)
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#if ((gAppTraceEntries_c & (gAppTraceEntries_c - 1U)) != 0U)
+#error "gAppTraceEntries_c must be a power of 2"
+#endif
+
+#define mcTraceIndexMask_c                   (gAppTraceEntries_c - 1U)
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static appTraceEntry_t maTraceRing[gAppTraceEntries_c];
+
+/* Entries written since the last clear, free running */
+static volatile uint32_t mTraceHead = 0U;
+static volatile uint8_t mTraceCurrentTask = (uint8_t)gAppTraceTaskOther_c;
+static volatile bool_t mTraceEnabled = FALSE;
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Starts the DWT cycle counter and enables tracing. Called from main,
+*               before the tasks are created.
+********************************************************************************** */
+void App_TraceInit(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    mTraceHead = 0U;
+    mTraceEnabled = TRUE;
+}
+
+/*! *********************************************************************************
+* \brief        Appends an entry. Callable from any task or interrupt.
+*
+* \param[in]    event           Event ID.
+* \param[in]    arg0            First argument.
+* \param[in]    arg1            Second argument.
+********************************************************************************** */
+void App_TraceEvent(appTraceEvent_t event, uint32_t arg0, uint32_t arg1)
+{
+    appTraceEntry_t *pEntry;
+    uint32_t ipsr;
+    uint32_t index;
+
+    if (mTraceEnabled == TRUE)
+    {
+        do
+        {
+            index = __LDREXW(&mTraceHead);
+        } while (__STREXW(index + 1U, &mTraceHead) != 0U);
+
+        ipsr = __get_IPSR();
+        pEntry = &maTraceRing[index & mcTraceIndexMask_c];
+        pEntry->cycles = DWT->CYCCNT;
+        pEntry->task = (ipsr != 0U) ? (uint8_t)(gAppTraceTaskIsr_c | (ipsr & 0x7FU)) : mTraceCurrentTask;
+        pEntry->event = (uint16_t)event;
+        pEntry->arg0 = arg0;
+        pEntry->arg1 = arg1;
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Names the calling task in the trace. Called once at task start.
+*
+* \param[in]    task            Task ID.
+********************************************************************************** */
+void App_TraceSetTask(appTraceTask_t task)
+{
+    vTaskSetTaskNumber(xTaskGetCurrentTaskHandle(), (UBaseType_t)task);
+    mTraceCurrentTask = (uint8_t)task;
+}
+
+/*! *********************************************************************************
+* \brief        traceTASK_SWITCHED_IN hook, see FreeRTOSConfig.h.
+*
+* \param[in]    taskNumber      uxTaskNumber of the task switched in.
+********************************************************************************** */
+void App_TraceTaskSwitchedIn(uint32_t taskNumber)
+{
+    uint8_t task = (uint8_t)(taskNumber & 0x7FU);
+
+    if (task != mTraceCurrentTask)
+    {
+        mTraceCurrentTask = task;
+        App_TraceEvent(gAppTraceTaskSwitch_c, task, 0U);
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Pauses or resumes tracing, e.g. while the ring is dumped.
+********************************************************************************** */
+void App_TraceEnable(bool_t enable)
+{
+    mTraceEnabled = enable;
+}
+
+/*! *********************************************************************************
+* \brief        TRUE while entries are recorded.
+********************************************************************************** */
+bool_t App_TraceIsEnabled(void)
+{
+    return mTraceEnabled;
+}
+
+/*! *********************************************************************************
+* \brief        Drops all entries. Call with tracing paused.
+********************************************************************************** */
+void App_TraceClear(void)
+{
+    mTraceHead = 0U;
+    FLib_MemSet(maTraceRing, 0x00, sizeof(maTraceRing));
+}
+
+/*! *********************************************************************************
+* \brief        Entries held by the ring.
+********************************************************************************** */
+uint32_t App_TraceGetCount(void)
+{
+    uint32_t head = mTraceHead;
+
+    return (head < gAppTraceEntries_c) ? head : gAppTraceEntries_c;
+}
+
+/*! *********************************************************************************
+* \brief        Entry by age, 0 is the oldest held. Call with tracing paused.
+*
+* \param[in]    index           0 .. App_TraceGetCount() - 1.
+*
+* \return       Entry, NULL past the last one.
+********************************************************************************** */
+const appTraceEntry_t* App_TraceGetEntry(uint32_t index)
+{
+    uint32_t head = mTraceHead;
+    uint32_t count = (head < gAppTraceEntries_c) ? head : gAppTraceEntries_c;
+    const appTraceEntry_t *pEntry = NULL;
+
+    if (index < count)
+    {
+        pEntry = &maTraceRing[(head - count + index) & mcTraceIndexMask_c];
+    }
+    return pEntry;
+}
+
+#endif /* gAppTrace_d */
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
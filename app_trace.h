@@ -0,0 +1,120 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file app_trace.h
+*
+* Binary event trace ring shared by all firmware tasks and interrupts. Each
+* entry holds the DWT cycle counter, the task or exception that wrote it, an
+* event ID and two arguments. The ring is dumped with the shell "trace"
+* command and turned into a timeline by tools/trace_decode.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef APP_TRACE_H
+#define APP_TRACE_H
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+/*! Enable/disable the event trace ring (shell "trace").
+    Redefine it in the app_preinclude.h file */
+#ifndef gAppTrace_d
+#define gAppTrace_d                          0
+#endif
+
+/*! Entries in the ring, a power of 2. 16 bytes each.
+    Redefine it in the app_preinclude.h file */
+#ifndef gAppTraceEntries_c
+#define gAppTraceEntries_c                   (512U)
+#endif
+
+/*! Task field of entries written from an exception: this bit | exception number */
+#define gAppTraceTaskIsr_c                   (0x80U)
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+/*! \brief  Task field of the entries written from task context. */
+typedef enum appTraceTask_tag
+{
+    gAppTraceTaskOther_c = 0,       /*!< Host stack, timer, idle and other tasks */
+    gAppTraceTaskBle_c,             /*!< ble_task, application */
+    gAppTraceTaskKeyfob_c,          /*!< keyfob_task */
+    gAppTraceTaskUwb_c              /*!< uwb_task */
+}appTraceTask_t;
+
+/*! \brief  Event IDs. Keep tools/trace_decode in line. */
+typedef enum appTraceEvent_tag
+{
+    gAppTraceTaskSwitch_c = 1,      /*!< arg0: task switched in */
+    gAppTraceFsm_c,                 /*!< arg0: peer << 16 | new state, arg1: event */
+    gAppTraceQueuePost_c,           /*!< arg0: appQueueId_t, arg1: depth */
+    gAppTraceQueueGet_c,            /*!< arg0: appQueueId_t, arg1: queueing latency, us */
+    gAppTraceUciTx_c,               /*!< arg0: UCI header, arg1: payload length */
+    gAppTraceUciRx_c,               /*!< arg0: UCI header, arg1: payload length */
+    gAppTraceL2capTx_c,             /*!< arg0: peer << 24 | message type << 16 | length, arg1: CID */
+    gAppTraceL2capRx_c,             /*!< arg0: peer << 24 | length, arg1: first 4 payload bytes */
+    gAppTraceLowPowerEnter_c,       /*!< arg0: expected idle time, us */
+    gAppTraceLowPowerExit_c         /*!< arg0: actual idle time, us. The cycle counter
+                                         does not run in low power */
+}appTraceEvent_t;
+
+/*! \brief  One ring entry, as dumped. */
+typedef struct appTraceEntry_tag
+{
+    uint32_t    cycles;             /*!< DWT CYCCNT */
+    uint8_t     task;               /*!< appTraceTask_t, or gAppTraceTaskIsr_c | IPSR */
+    uint8_t     reserved;
+    uint16_t    event;              /*!< appTraceEvent_t */
+    uint32_t    arg0;
+    uint32_t    arg1;
+}appTraceEntry_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(gAppTrace_d) && (gAppTrace_d == 1)
+void App_TraceInit(void);
+void App_TraceEvent(appTraceEvent_t event, uint32_t arg0, uint32_t arg1);
+void App_TraceSetTask(appTraceTask_t task);
+void App_TraceTaskSwitchedIn(uint32_t taskNumber);
+void App_TraceEnable(bool_t enable);
+bool_t App_TraceIsEnabled(void);
+void App_TraceClear(void);
+uint32_t App_TraceGetCount(void);
+const appTraceEntry_t* App_TraceGetEntry(uint32_t index);
+#else
+#define App_TraceInit()
+#define App_TraceEvent(event, arg0, arg1)
+#define App_TraceSetTask(task)
+#endif /* gAppTrace_d */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_TRACE_H */
+
+/*! *********************************************************************************
+ * @}
+ ********************************************************************************** */
@@ -0,0 +1,132 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file ccc_credentials.c
+*
+* Keyfob CCC credentials, see ccc_credentials.h. A credential is checked to
+* be a valid scalar before it is saved; the SPAKE2+ verifier is loaded once
+* both its halves are provisioned.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "FunctionLib.h"
+#include "ble_general.h"
+#include "trace.h"
+#include "ccc_p256.h"
+#include "ccc_spake2p.h"
+#include "ccc_ecdsa.h"
+#include "ccc_credentials.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mcCccCredentialBit_c(id)    ((uint8_t)(1U << (uint8_t)(id)))
+#define mcCccCredentialsVerifier_c  (mcCccCredentialBit_c(gCccCredentialW0_c) | mcCccCredentialBit_c(gCccCredentialW1_c))
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+/* Record image, saved from here */
+static cccCredentialsRecord_t mCccCredentials;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static void CCC_CredentialsApply(void);
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Loads the credentials saved, at boot, after the NVM is
+*               initialized.
+********************************************************************************** */
+void CCC_CredentialsLoad(void)
+{
+    if (App_NvmReadCccCredentials(&mCccCredentials) == FALSE)
+    {
+        FLib_MemSet(&mCccCredentials, 0x00, sizeof(mCccCredentials));
+    }
+    CCC_CredentialsApply();
+    TRACE_INFO("CCC credentials provisioned 0x%x", mCccCredentials.present);
+}
+
+/*! *********************************************************************************
+* \brief        Provisions a credential: checked, saved, then used.
+*
+* \param[in]    id              Credential.
+* \param[in]    pValue          Its value, 32 bytes big-endian.
+*
+* \return       TRUE if saved, FALSE if not valid or the save failed.
+********************************************************************************** */
+bool_t CCC_CredentialsSet(cccCredentialId_t id, const uint8_t *pValue)
+{
+    bool_t result = FALSE;
+    p256Int_t k;
+
+    if ((id < gCccCredentialCount_c) && (pValue != NULL))
+    {
+        P256_ScalarFromBytes(&k, pValue);
+        if (P256_ScalarIsValid(&k) == TRUE)
+        {
+            FLib_MemCpy(mCccCredentials.aValue[id], pValue, gP256ScalarSize_c);
+            mCccCredentials.present |= mcCccCredentialBit_c(id);
+            result = App_NvmWriteCccCredentials(&mCccCredentials);
+            CCC_CredentialsApply();
+        }
+        FLib_MemSet(&k, 0x00, sizeof(k));
+    }
+    return result;
+}
+
+/*! *********************************************************************************
+* \brief        Credentials provisioned, bit n for cccCredentialId_t n.
+********************************************************************************** */
+uint8_t CCC_CredentialsPresent(void)
+{
+    return mCccCredentials.present;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Hands the credentials provisioned to SPAKE2+ and ECDSA.
+********************************************************************************** */
+static void CCC_CredentialsApply(void)
+{
+    if (((mCccCredentials.present & mcCccCredentialsVerifier_c) == mcCccCredentialsVerifier_c) &&
+        (CCC_Spake2pSetVerifier(mCccCredentials.aValue[gCccCredentialW0_c],
+                                mCccCredentials.aValue[gCccCredentialW1_c]) != gSpake2pSuccess_c))
+    {
+        TRACE_ERROR("CCC credentials: SPAKE2+ verifier not valid");
+    }
+    if (((mCccCredentials.present & mcCccCredentialBit_c(gCccCredentialRkeKey_c)) != 0U) &&
+        (CCC_EcdsaSetPrivateKey(mCccCredentials.aValue[gCccCredentialRkeKey_c]) == FALSE))
+    {
+        TRACE_ERROR("CCC credentials: RKE key not valid");
+    }
+}
+
+/*! *********************************************************************************
+ * @}
+ ********************************************************************************** */
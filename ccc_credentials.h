@@ -0,0 +1,82 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file ccc_credentials.h
+*
+* Keyfob credentials of the CCC owner pairing and RKE: the SPAKE2+ verifier
+* (w0, w1) and the RKE signing key. They are provisioned one by one at the
+* end of line, with the setcred shell command, kept in NVM and loaded into
+* ccc_spake2p.c and ccc_ecdsa.c at boot. A keyfob not provisioned rejects
+* the SPAKE2+ Request and does not sign RKE commands.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef CCC_CREDENTIALS_H
+#define CCC_CREDENTIALS_H
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "ccc_p256.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+/*! \brief  Credentials, each a P-256 scalar, 32 bytes big-endian. */
+typedef enum cccCredentialId_tag
+{
+    gCccCredentialW0_c = 0,             /*!< SPAKE2+ w0, reduced modulo the group order */
+    gCccCredentialW1_c,                 /*!< SPAKE2+ w1, reduced modulo the group order */
+    gCccCredentialRkeKey_c,             /*!< RKE ECDSA private key */
+    gCccCredentialCount_c
+}cccCredentialId_t;
+
+/*! \brief  NVM record: the credentials provisioned, bit n of present for
+ *          cccCredentialId_t n. */
+typedef PACKED_STRUCT cccCredentialsRecord_tag
+{
+    uint8_t     present;
+    uint8_t     aValue[gCccCredentialCount_c][gP256ScalarSize_c];
+}cccCredentialsRecord_t;
+
+/*! \brief  setcred shell command, run from the application task. */
+typedef struct cccCredentialData_tag
+{
+    uint8_t     id;                     /*!< cccCredentialId_t */
+    uint8_t     aValue[gP256ScalarSize_c];
+}cccCredentialData_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void CCC_CredentialsLoad(void);
+bool_t CCC_CredentialsSet(cccCredentialId_t id, const uint8_t *pValue);
+uint8_t CCC_CredentialsPresent(void);
+
+/* Record storage, app_nvm.c. */
+bool_t App_NvmReadCccCredentials(cccCredentialsRecord_t *pRecord);
+bool_t App_NvmWriteCccCredentials(const cccCredentialsRecord_t *pRecord);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CCC_CREDENTIALS_H */
+
+/*! *********************************************************************************
+ * @}
+ ********************************************************************************** */
@@ -0,0 +1,329 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file ccc_ecdsa.c
+*
+* ECDSA P-256 signing for the CCC RKE authentication.
+*
+* The nonce is derived deterministically from the key and the digest
+* (RFC 6979, HMAC-SHA256), so signing needs no RNG and a bad RNG cannot leak
+* the key. R = k*G uses the fixed-base comb of ccc_p256; k^-1 is computed in
+* constant time (Fermat).
+*
+* The key is provisioned in NVM with the "setcred rke" shell command and
+* applied by ccc_credentials; signing fails until it is
+* (gAppCccDevCredentials_d aside).
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "fsl_component_timer_manager.h"
+#include "FunctionLib.h"
+#include "SecLib.h"
+#include "trace.h"
+#include "ccc_p256.h"
+#include "ccc_ecdsa.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+/* V || tag || int2octets(d) || bits2octets(h) */
+#define mcEcdsaDrbgSeedSize_c           (SHA256_HASH_SIZE + 1U + (2U * gP256ScalarSize_c))
+#define mcEcdsaMaxNonceRetries_c        (8U)
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+/* RFC 6979 HMAC-DRBG state */
+typedef struct ecdsaDrbg_tag
+{
+    uint8_t K[SHA256_HASH_SIZE];
+    uint8_t V[SHA256_HASH_SIZE];
+}ecdsaDrbg_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static p256Int_t mEcdsaPrivateKey;
+static bool_t mEcdsaKeyLoaded = FALSE;
+
+#if (gAppCccDevCredentials_d == 1)
+/* Development RKE key, bench builds only */
+static const uint8_t maEcdsaDefaultKey[gP256ScalarSize_c] =
+{
+    0x4C, 0xE0, 0xB0, 0xF8, 0x2D, 0x89, 0x52, 0xA7, 0x7B, 0x9D, 0xAA, 0x97, 0x46, 0x09, 0xE8, 0xB7,
+    0x5C, 0xCA, 0x11, 0xD7, 0xE6, 0x6C, 0x65, 0xF3, 0x51, 0x42, 0x00, 0x25, 0xBC, 0x21, 0x1D, 0xE0,
+};
+#endif /* gAppCccDevCredentials_d */
+
+/* RFC 6979 A.2.5, P-256 / SHA-256, message "sample" */
+static const uint8_t maEcdsaKatKey[gP256ScalarSize_c] =
+{
+    0xC9, 0xAF, 0xA9, 0xD8, 0x45, 0xBA, 0x75, 0x16, 0x6B, 0x5C, 0x21, 0x57, 0x67, 0xB1, 0xD6, 0x93,
+    0x4E, 0x50, 0xC3, 0xDB, 0x36, 0xE8, 0x9B, 0x12, 0x7B, 0x8A, 0x62, 0x2B, 0x12, 0x0F, 0x67, 0x21,
+};
+
+static const uint8_t maEcdsaKatHash[gEcdsaHashSize_c] =
+{
+    0xAF, 0x2B, 0xDB, 0xE1, 0xAA, 0x9B, 0x6E, 0xC1, 0xE2, 0xAD, 0xE1, 0xD6, 0x94, 0xF4, 0x1F, 0xC7,
+    0x1A, 0x83, 0x1D, 0x02, 0x68, 0xE9, 0x89, 0x15, 0x62, 0x11, 0x3D, 0x8A, 0x62, 0xAD, 0xD1, 0xBF,
+};
+
+static const uint8_t maEcdsaKatSignature[gEcdsaSignatureSize_c] =
+{
+    0xEF, 0xD4, 0x8B, 0x2A, 0xAC, 0xB6, 0xA8, 0xFD, 0x11, 0x40, 0xDD, 0x9C, 0xD4, 0x5E, 0x81, 0xD6,
+    0x9D, 0x2C, 0x87, 0x7B, 0x56, 0xAA, 0xF9, 0x91, 0xC3, 0x4D, 0x0E, 0xA8, 0x4E, 0xAF, 0x37, 0x16,
+    0xF7, 0xCB, 0x1C, 0x94, 0x2D, 0x65, 0x7C, 0x41, 0xD4, 0x36, 0xC7, 0xA1, 0xB6, 0xE2, 0x9F, 0x65,
+    0xF3, 0xE9, 0x00, 0xDB, 0xB9, 0xAF, 0xF4, 0x06, 0x4D, 0xC4, 0xAB, 0x2F, 0x84, 0x3A, 0xCD, 0xA8,
+};
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static bool_t CCC_EcdsaKeyReady(void);
+static bool_t CCC_EcdsaSignWithKey(const p256Int_t *pKey, const uint8_t *pHash, uint8_t *pSignature);
+static void CCC_EcdsaDrbgUpdate(ecdsaDrbg_t *pDrbg, uint8_t tag, const uint8_t *pKey, const uint8_t *pHash);
+static void CCC_EcdsaDrbgNext(ecdsaDrbg_t *pDrbg, p256Int_t *pNonce);
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Provisions the RKE signing key. Called by CCC_CredentialsLoad() at
+*               boot and by CCC_CredentialsSet(): signing fails until then.
+*
+* \param[in]    pKey        Private key, 32 bytes big-endian, 0 < d < n.
+*
+* \return       TRUE if the key is valid.
+********************************************************************************** */
+bool_t CCC_EcdsaSetPrivateKey(const uint8_t *pKey)
+{
+    bool_t result = FALSE;
+    p256Int_t d;
+
+    if (pKey != NULL)
+    {
+        P256_ScalarFromBytes(&d, pKey);
+        if (P256_ScalarIsValid(&d) == TRUE)
+        {
+            mEcdsaPrivateKey = d;
+            mEcdsaKeyLoaded = TRUE;
+            result = TRUE;
+        }
+        FLib_MemSet(&d, 0x00, sizeof(d));
+    }
+    return result;
+}
+
+/*! *********************************************************************************
+* \brief        Returns the public key matching the RKE signing key.
+*
+* \param[out]   pPublicKey  gP256PointSize_c bytes, uncompressed SEC1.
+*
+* \return       TRUE on success, FALSE if no key is provisioned.
+********************************************************************************** */
+bool_t CCC_EcdsaGetPublicKey(uint8_t *pPublicKey)
+{
+    bool_t result = FALSE;
+    p256Point_t Q;
+
+    if ((pPublicKey != NULL) && (CCC_EcdsaKeyReady() == TRUE))
+    {
+        P256_MulBaseComb(&Q, &mEcdsaPrivateKey);
+        result = P256_PointEncode(pPublicKey, &Q);
+    }
+    return result;
+}
+
+/*! *********************************************************************************
+* \brief        Signs a SHA-256 digest with the RKE key.
+*
+* \param[in]    pHash       gEcdsaHashSize_c bytes.
+* \param[out]   pSignature  gEcdsaSignatureSize_c bytes, r || s.
+*
+* \return       TRUE on success, FALSE if no key is provisioned.
+********************************************************************************** */
+bool_t CCC_EcdsaSign(const uint8_t *pHash, uint8_t *pSignature)
+{
+    bool_t result = FALSE;
+
+    if ((pHash != NULL) && (pSignature != NULL) && (CCC_EcdsaKeyReady() == TRUE))
+    {
+        result = CCC_EcdsaSignWithKey(&mEcdsaPrivateKey, pHash, pSignature);
+    }
+    return result;
+}
+
+/*! *********************************************************************************
+* \brief        Known answer test (RFC 6979 A.2.5) and signing time measurement.
+*               Does not use the provisioned key.
+*
+* \param[out]   pSignDurationUs     Duration of one signature (us), may be NULL.
+*
+* \return       TRUE if the signature matches the reference.
+********************************************************************************** */
+bool_t CCC_EcdsaSelfTest(uint32_t *pSignDurationUs)
+{
+    uint8_t signature[gEcdsaSignatureSize_c];
+    p256Int_t d;
+    uint64_t startTs;
+    bool_t result;
+
+    P256_ScalarFromBytes(&d, maEcdsaKatKey);
+    startTs = TM_GetTimestamp();
+    result = CCC_EcdsaSignWithKey(&d, maEcdsaKatHash, signature);
+    if (pSignDurationUs != NULL)
+    {
+        *pSignDurationUs = (uint32_t)(TM_GetTimestamp() - startTs);
+    }
+
+    if ((result == TRUE) && (FLib_MemCmp(signature, maEcdsaKatSignature, gEcdsaSignatureSize_c) == FALSE))
+    {
+        result = FALSE;
+    }
+    return result;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Tells whether a key is provisioned, loading the development one in
+*               bench builds.
+********************************************************************************** */
+static bool_t CCC_EcdsaKeyReady(void)
+{
+#if (gAppCccDevCredentials_d == 1)
+    if (mEcdsaKeyLoaded == FALSE)
+    {
+        TRACE_WARNING("ECDSA: development RKE key in use.");
+        (void)CCC_EcdsaSetPrivateKey(maEcdsaDefaultKey);
+    }
+#endif /* gAppCccDevCredentials_d */
+    return mEcdsaKeyLoaded;
+}
+
+/*! *********************************************************************************
+* \brief        s = k^-1 * (e + r*d) mod n, r = x(k*G) mod n, k from RFC 6979.
+********************************************************************************** */
+static bool_t CCC_EcdsaSignWithKey(const p256Int_t *pKey, const uint8_t *pHash, uint8_t *pSignature)
+{
+    bool_t result = FALSE;
+    ecdsaDrbg_t drbg;
+    uint8_t keyBytes[gP256ScalarSize_c];
+    uint8_t hashBytes[gP256ScalarSize_c];
+    uint8_t point[gP256PointSize_c];
+    p256Int_t e, k, r, s;
+    p256Point_t R;
+    uint32_t retry;
+
+    /* e = bits2int(h) mod n; the digest is exactly 256 bits */
+    P256_ScalarFromBytes(&e, pHash);
+    P256_ScalarReduce(&e);
+    P256_ScalarToBytes(hashBytes, &e);
+    P256_ScalarToBytes(keyBytes, pKey);
+
+    FLib_MemSet(drbg.K, 0x00, sizeof(drbg.K));
+    FLib_MemSet(drbg.V, 0x01, sizeof(drbg.V));
+    CCC_EcdsaDrbgUpdate(&drbg, 0x00U, keyBytes, hashBytes);
+    CCC_EcdsaDrbgUpdate(&drbg, 0x01U, keyBytes, hashBytes);
+
+    for (retry = 0U; (retry < mcEcdsaMaxNonceRetries_c) && (result == FALSE); retry++)
+    {
+        CCC_EcdsaDrbgNext(&drbg, &k);
+        if (P256_ScalarIsValid(&k) == TRUE)
+        {
+            P256_MulBaseComb(&R, &k);
+            if (P256_PointEncode(point, &R) == TRUE)
+            {
+                P256_ScalarFromBytes(&r, &point[1]);
+                P256_ScalarReduce(&r);
+
+                P256_ScalarMulMod(&s, &r, pKey);
+                P256_ScalarAddMod(&s, &s, &e);
+                P256_ScalarInvMod(&k, &k);
+                P256_ScalarMulMod(&s, &s, &k);
+
+                if ((P256_ScalarIsValid(&r) == TRUE) && (P256_ScalarIsValid(&s) == TRUE))
+                {
+                    P256_ScalarToBytes(pSignature, &r);
+                    P256_ScalarToBytes(&pSignature[gP256ScalarSize_c], &s);
+                    result = TRUE;
+                }
+            }
+        }
+
+        if (result == FALSE)
+        {
+            /* RFC 6979 3.2.h.3: K = HMAC_K(V || 0x00), V = HMAC_K(V) */
+            CCC_EcdsaDrbgUpdate(&drbg, 0x00U, NULL, NULL);
+        }
+    }
+
+    FLib_MemSet(&drbg, 0x00, sizeof(drbg));
+    FLib_MemSet(keyBytes, 0x00, sizeof(keyBytes));
+    FLib_MemSet(&k, 0x00, sizeof(k));
+    return result;
+}
+
+/*! *********************************************************************************
+* \brief        K = HMAC_K(V || tag [|| key || hash]), V = HMAC_K(V).
+********************************************************************************** */
+static void CCC_EcdsaDrbgUpdate(ecdsaDrbg_t *pDrbg, uint8_t tag, const uint8_t *pKey, const uint8_t *pHash)
+{
+    uint8_t seed[mcEcdsaDrbgSeedSize_c];
+    uint32_t seedLen = SHA256_HASH_SIZE + 1U;
+    uint8_t mac[SHA256_HASH_SIZE];
+
+    FLib_MemCpy(seed, pDrbg->V, SHA256_HASH_SIZE);
+    seed[SHA256_HASH_SIZE] = tag;
+    if ((pKey != NULL) && (pHash != NULL))
+    {
+        FLib_MemCpy(&seed[seedLen], pKey, gP256ScalarSize_c);
+        FLib_MemCpy(&seed[seedLen + gP256ScalarSize_c], pHash, gP256ScalarSize_c);
+        seedLen += 2U * gP256ScalarSize_c;
+    }
+
+    /* HMAC output never aliases its key or message */
+    HMAC_SHA256(pDrbg->K, SHA256_HASH_SIZE, seed, seedLen, mac);
+    FLib_MemCpy(pDrbg->K, mac, SHA256_HASH_SIZE);
+    HMAC_SHA256(pDrbg->K, SHA256_HASH_SIZE, pDrbg->V, SHA256_HASH_SIZE, mac);
+    FLib_MemCpy(pDrbg->V, mac, SHA256_HASH_SIZE);
+    FLib_MemSet(seed, 0x00, sizeof(seed));
+}
+
+/*! *********************************************************************************
+* \brief        V = HMAC_K(V), k = bits2int(V).
+********************************************************************************** */
+static void CCC_EcdsaDrbgNext(ecdsaDrbg_t *pDrbg, p256Int_t *pNonce)
+{
+    uint8_t mac[SHA256_HASH_SIZE];
+
+    HMAC_SHA256(pDrbg->K, SHA256_HASH_SIZE, pDrbg->V, SHA256_HASH_SIZE, mac);
+    FLib_MemCpy(pDrbg->V, mac, SHA256_HASH_SIZE);
+    P256_ScalarFromBytes(pNonce, pDrbg->V);
+}
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
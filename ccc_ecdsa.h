@@ -0,0 +1,62 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file ccc_ecdsa.h
+*
+* ECDSA P-256 signing (deterministic nonces, RFC 6979) for the CCC RKE
+* authentication.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef CCC_ECDSA_H
+#define CCC_ECDSA_H
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "ccc_p256.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+/*! Use the development RKE key when none was provisioned with "setcred rke"
+    (see ccc_credentials.h), for bench builds only: signing fails otherwise.
+    Redefine it in the app_preinclude.h file */
+#ifndef gAppCccDevCredentials_d
+#define gAppCccDevCredentials_d         0
+#endif
+
+#define gEcdsaHashSize_c                (32U)                       /* SHA-256 digest */
+#define gEcdsaSignatureSize_c           (2U * gP256ScalarSize_c)    /* r || s, big-endian */
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool_t CCC_EcdsaSetPrivateKey(const uint8_t *pKey);
+bool_t CCC_EcdsaGetPublicKey(uint8_t *pPublicKey);
+bool_t CCC_EcdsaSign(const uint8_t *pHash, uint8_t *pSignature);
+bool_t CCC_EcdsaSelfTest(uint32_t *pSignDurationUs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CCC_ECDSA_H */
+
+/*! *********************************************************************************
+ * @}
+ ********************************************************************************** */
@@ -0,0 +1,744 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file ccc_p256.c
+*
+* NIST P-256 arithmetic for the CCC owner pairing and RKE signing.
+*
+* Field and scalar elements are 8 x 32-bit words. Multiplication is generic
+* Montgomery (CIOS) parameterised by the modulus, so the same code serves the
+* field (p) and the group order (n). Points are Jacobian with a = -3. Scalar
+* multiplication uses fixed 4-bit windows: every window does four doublings,
+* a full constant-time table scan and one addition, whatever the digit. k*G
+* for signing uses a 6-teeth comb instead (43 doublings and additions).
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "FunctionLib.h"
+#include "ccc_p256.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+/* All-ones mask when the condition (0 or 1) is set */
+#define mcP256Mask(cond)              ((uint32_t)0U - (uint32_t)(cond))
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+typedef struct p256Modulus_tag
+{
+    p256Int_t   m;          /* Modulus */
+    p256Int_t   rr;         /* R^2 mod m, R = 2^256 */
+    p256Int_t   one;        /* R mod m (1 in Montgomery domain) */
+    uint32_t    m0inv;      /* -m^-1 mod 2^32 */
+}p256Modulus_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static const p256Modulus_t mP256FieldP =
+{
+    .m     = {{0xFFFFFFFFU, 0xFFFFFFFFU, 0xFFFFFFFFU, 0x00000000U, 0x00000000U, 0x00000000U, 0x00000001U, 0xFFFFFFFFU}},
+    .rr    = {{0x00000003U, 0x00000000U, 0xFFFFFFFFU, 0xFFFFFFFBU, 0xFFFFFFFEU, 0xFFFFFFFFU, 0xFFFFFFFDU, 0x00000004U}},
+    .one   = {{0x00000001U, 0x00000000U, 0x00000000U, 0xFFFFFFFFU, 0xFFFFFFFFU, 0xFFFFFFFFU, 0xFFFFFFFEU, 0x00000000U}},
+    .m0inv = 0x00000001U,
+};
+
+static const p256Modulus_t mP256OrderN =
+{
+    .m     = {{0xFC632551U, 0xF3B9CAC2U, 0xA7179E84U, 0xBCE6FAADU, 0xFFFFFFFFU, 0xFFFFFFFFU, 0x00000000U, 0xFFFFFFFFU}},
+    .rr    = {{0xBE79EEA2U, 0x83244C95U, 0x49BD6FA6U, 0x4699799CU, 0x2B6BEC59U, 0x2845B239U, 0xF3D95620U, 0x66E12D94U}},
+    .one   = {{0x039CDAAFU, 0x0C46353DU, 0x58E8617BU, 0x43190552U, 0x00000000U, 0x00000000U, 0xFFFFFFFFU, 0x00000000U}},
+    .m0inv = 0xEE00BC4FU,
+};
+
+/* Curve coefficient b, Montgomery domain */
+static const p256Int_t mP256CurveB =
+{
+    {0x29C4BDDFU, 0xD89CDF62U, 0x78843090U, 0xACF005CDU, 0xF7212ED6U, 0xE5A220ABU, 0x04874834U, 0xDC30061DU}
+};
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static uint32_t P256_AddWords(p256Int_t *pR, const p256Int_t *pA, const p256Int_t *pB);
+static uint32_t P256_SubWords(p256Int_t *pR, const p256Int_t *pA, const p256Int_t *pB);
+static void P256_Select(p256Int_t *pR, const p256Int_t *pA, const p256Int_t *pB, uint32_t mask);
+static uint32_t P256_IsZeroMask(const p256Int_t *pA);
+static void P256_ModAdd(p256Int_t *pR, const p256Int_t *pA, const p256Int_t *pB, const p256Modulus_t *pMod);
+static void P256_ModSub(p256Int_t *pR, const p256Int_t *pA, const p256Int_t *pB, const p256Modulus_t *pMod);
+static void P256_MontMul(p256Int_t *pR, const p256Int_t *pA, const p256Int_t *pB, const p256Modulus_t *pMod);
+static void P256_ModInv(p256Int_t *pR, const p256Int_t *pA, const p256Modulus_t *pMod);
+static void P256_PointSelect(p256Point_t *pR, const p256Point_t *pA, const p256Point_t *pB, uint32_t mask);
+static void P256_PointDouble(p256Point_t *pR, const p256Point_t *pP);
+static void P256_PointAddUnchecked(p256Point_t *pR, const p256Point_t *pP, const p256Point_t *pQ, p256Int_t *pH, p256Int_t *pRr);
+static uint32_t P256_ScalarDigit(const p256Int_t *pK, uint32_t window);
+static uint32_t P256_CombDigit(const p256Int_t *pK, uint32_t column);
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Loads a 32-byte big-endian integer.
+*
+* \param[out]   pOut        Integer.
+* \param[in]    pIn         32 bytes, big-endian.
+********************************************************************************** */
+void P256_ScalarFromBytes(p256Int_t *pOut, const uint8_t *pIn)
+{
+    uint32_t i;
+
+    for (i = 0U; i < gP256Words_c; i++)
+    {
+        const uint8_t *pWord = &pIn[gP256ScalarSize_c - (4U * (i + 1U))];
+        pOut->w[i] = ((uint32_t)pWord[0] << 24) | ((uint32_t)pWord[1] << 16) |
+                     ((uint32_t)pWord[2] << 8)  |  (uint32_t)pWord[3];
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Stores an integer as 32 big-endian bytes.
+*
+* \param[out]   pOut        32 bytes, big-endian.
+* \param[in]    pIn         Integer.
+********************************************************************************** */
+void P256_ScalarToBytes(uint8_t *pOut, const p256Int_t *pIn)
+{
+    uint32_t i;
+
+    for (i = 0U; i < gP256Words_c; i++)
+    {
+        uint8_t *pWord = &pOut[gP256ScalarSize_c - (4U * (i + 1U))];
+        pWord[0] = (uint8_t)(pIn->w[i] >> 24);
+        pWord[1] = (uint8_t)(pIn->w[i] >> 16);
+        pWord[2] = (uint8_t)(pIn->w[i] >> 8);
+        pWord[3] = (uint8_t)(pIn->w[i]);
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Checks that 0 < k < n.
+********************************************************************************** */
+bool_t P256_ScalarIsValid(const p256Int_t *pK)
+{
+    p256Int_t tmp;
+    uint32_t borrow = P256_SubWords(&tmp, pK, &mP256OrderN.m);
+
+    return (bool_t)((borrow != 0U) && (P256_IsZeroMask(pK) == 0U));
+}
+
+/*! *********************************************************************************
+* \brief        Reduces an integer below 2^256 modulo n (one conditional subtraction).
+********************************************************************************** */
+void P256_ScalarReduce(p256Int_t *pK)
+{
+    p256Int_t tmp;
+    uint32_t borrow = P256_SubWords(&tmp, pK, &mP256OrderN.m);
+
+    P256_Select(pK, pK, &tmp, mcP256Mask(borrow));
+}
+
+/*! *********************************************************************************
+* \brief        R = A + B mod n, with A, B < n.
+********************************************************************************** */
+void P256_ScalarAddMod(p256Int_t *pOut, const p256Int_t *pA, const p256Int_t *pB)
+{
+    P256_ModAdd(pOut, pA, pB, &mP256OrderN);
+}
+
+/*! *********************************************************************************
+* \brief        R = A * B mod n, with A, B < n. Plain (not Montgomery) domain.
+********************************************************************************** */
+void P256_ScalarMulMod(p256Int_t *pOut, const p256Int_t *pA, const p256Int_t *pB)
+{
+    p256Int_t tmp;
+
+    /* (A * B / R) * R^2 / R */
+    P256_MontMul(&tmp, pA, pB, &mP256OrderN);
+    P256_MontMul(pOut, &tmp, &mP256OrderN.rr, &mP256OrderN);
+}
+
+/*! *********************************************************************************
+* \brief        R = A^-1 mod n, with 0 < A < n. Plain domain, constant time.
+********************************************************************************** */
+void P256_ScalarInvMod(p256Int_t *pOut, const p256Int_t *pA)
+{
+    const p256Int_t plainOne = {{1U, 0U, 0U, 0U, 0U, 0U, 0U, 0U}};
+    p256Int_t tmp;
+
+    P256_MontMul(&tmp, pA, &mP256OrderN.rr, &mP256OrderN);
+    P256_ModInv(&tmp, &tmp, &mP256OrderN);
+    P256_MontMul(pOut, &tmp, &plainOne, &mP256OrderN);
+}
+
+/*! *********************************************************************************
+* \brief        Decodes and validates an uncompressed SEC1 point.
+*
+* \param[out]   pOut        Point, Jacobian with Z = 1.
+* \param[in]    pIn         gP256PointSize_c bytes: 0x04 || X || Y.
+*
+* \return       TRUE if the encoding is valid and the point lies on the curve.
+********************************************************************************** */
+bool_t P256_PointDecode(p256Point_t *pOut, const uint8_t *pIn)
+{
+    bool_t valid = FALSE;
+    p256Int_t x, y, lhs, rhs, tmp;
+
+    if (pIn[0] == 0x04U)
+    {
+        P256_ScalarFromBytes(&x, &pIn[1]);
+        P256_ScalarFromBytes(&y, &pIn[1U + gP256ScalarSize_c]);
+
+        /* Coordinates must be reduced */
+        if ((P256_SubWords(&tmp, &x, &mP256FieldP.m) != 0U) &&
+            (P256_SubWords(&tmp, &y, &mP256FieldP.m) != 0U))
+        {
+            P256_MontMul(&pOut->x, &x, &mP256FieldP.rr, &mP256FieldP);
+            P256_MontMul(&pOut->y, &y, &mP256FieldP.rr, &mP256FieldP);
+            pOut->z = mP256FieldP.one;
+
+            /* y^2 == x^3 - 3x + b */
+            P256_MontMul(&lhs, &pOut->y, &pOut->y, &mP256FieldP);
+            P256_MontMul(&rhs, &pOut->x, &pOut->x, &mP256FieldP);
+            P256_MontMul(&rhs, &rhs, &pOut->x, &mP256FieldP);
+            P256_ModSub(&rhs, &rhs, &pOut->x, &mP256FieldP);
+            P256_ModSub(&rhs, &rhs, &pOut->x, &mP256FieldP);
+            P256_ModSub(&rhs, &rhs, &pOut->x, &mP256FieldP);
+            P256_ModAdd(&rhs, &rhs, &mP256CurveB, &mP256FieldP);
+            P256_ModSub(&tmp, &lhs, &rhs, &mP256FieldP);
+
+            valid = (bool_t)(P256_IsZeroMask(&tmp) != 0U);
+        }
+    }
+    return valid;
+}
+
+/*! *********************************************************************************
+* \brief        Encodes a point as uncompressed SEC1.
+*
+* \param[out]   pOut        gP256PointSize_c bytes: 0x04 || X || Y.
+* \param[in]    pIn         Point.
+*
+* \return       FALSE if the point is infinity.
+********************************************************************************** */
+bool_t P256_PointEncode(uint8_t *pOut, const p256Point_t *pIn)
+{
+    bool_t valid = FALSE;
+    p256Int_t zInv, zInv2, coord;
+    const p256Int_t plainOne = {{1U, 0U, 0U, 0U, 0U, 0U, 0U, 0U}};
+
+    if (P256_PointIsInfinity(pIn) == FALSE)
+    {
+        P256_ModInv(&zInv, &pIn->z, &mP256FieldP);
+        P256_MontMul(&zInv2, &zInv, &zInv, &mP256FieldP);
+
+        pOut[0] = 0x04U;
+        P256_MontMul(&coord, &pIn->x, &zInv2, &mP256FieldP);
+        P256_MontMul(&coord, &coord, &plainOne, &mP256FieldP);
+        P256_ScalarToBytes(&pOut[1], &coord);
+
+        P256_MontMul(&coord, &pIn->y, &zInv2, &mP256FieldP);
+        P256_MontMul(&coord, &coord, &zInv, &mP256FieldP);
+        P256_MontMul(&coord, &coord, &plainOne, &mP256FieldP);
+        P256_ScalarToBytes(&pOut[1U + gP256ScalarSize_c], &coord);
+        valid = TRUE;
+    }
+    return valid;
+}
+
+/*! *********************************************************************************
+* \brief        Returns TRUE if the point is the point at infinity.
+********************************************************************************** */
+bool_t P256_PointIsInfinity(const p256Point_t *pP)
+{
+    return (bool_t)(P256_IsZeroMask(&pP->z) != 0U);
+}
+
+/*! *********************************************************************************
+* \brief        R = -P.
+********************************************************************************** */
+void P256_PointNegate(p256Point_t *pOut, const p256Point_t *pIn)
+{
+    const p256Int_t zero = {{0U}};
+
+    pOut->x = pIn->x;
+    pOut->z = pIn->z;
+    P256_ModSub(&pOut->y, &zero, &pIn->y, &mP256FieldP);
+}
+
+/*! *********************************************************************************
+* \brief        R = P + Q, for any P and Q (infinity and P == Q handled).
+********************************************************************************** */
+void P256_PointAdd(p256Point_t *pOut, const p256Point_t *pP, const p256Point_t *pQ)
+{
+    p256Point_t sum, dbl;
+    p256Int_t h, r;
+    uint32_t sameMask;
+
+    P256_PointAddUnchecked(&sum, pP, pQ, &h, &r);
+    P256_PointDouble(&dbl, pP);
+
+    /* H == 0 and r == 0 with both points finite: P == Q */
+    sameMask = P256_IsZeroMask(&h) & P256_IsZeroMask(&r) &
+               ~P256_IsZeroMask(&pP->z) & ~P256_IsZeroMask(&pQ->z);
+    P256_PointSelect(&sum, &dbl, &sum, sameMask);
+
+    /* Infinity operands */
+    P256_PointSelect(&sum, pQ, &sum, P256_IsZeroMask(&pP->z));
+    P256_PointSelect(pOut, pP, &sum, P256_IsZeroMask(&pQ->z));
+}
+
+/*! *********************************************************************************
+* \brief        Builds the window table i*P, i = 0..15, of a variable point.
+*
+* \param[out]   pTable      Table.
+* \param[in]    pP          Point.
+********************************************************************************** */
+void P256_PrepareTable(p256PointTable_t *pTable, const p256Point_t *pP)
+{
+    uint32_t i;
+
+    FLib_MemSet(&pTable->entry[0], 0x00, sizeof(p256Point_t));
+    pTable->entry[1] = *pP;
+    for (i = 2U; i < gP256WindowSize_c; i++)
+    {
+        if ((i & 1U) == 0U)
+        {
+            P256_PointDouble(&pTable->entry[i], &pTable->entry[i / 2U]);
+        }
+        else
+        {
+            P256_PointAdd(&pTable->entry[i], &pTable->entry[i - 1U], pP);
+        }
+    }
+}
+
+/*! *********************************************************************************
+* \brief        R = k*P, P given by its window table. Constant time in k.
+*
+* \param[out]   pOut        Result.
+* \param[in]    pK          Scalar, 0 <= k < n.
+* \param[in]    pTable      Window table of P.
+********************************************************************************** */
+void P256_MulTable(p256Point_t *pOut, const p256Int_t *pK, const p256PointTable_t *pTable)
+{
+    p256Point_t acc, t, sum;
+    p256Int_t h, r;
+    uint32_t window, digit, i;
+
+    FLib_MemSet(&acc, 0x00, sizeof(acc));
+    for (window = (256U / gP256WindowBits_c); window-- > 0U;)
+    {
+        for (i = 0U; i < gP256WindowBits_c; i++)
+        {
+            P256_PointDouble(&acc, &acc);
+        }
+
+        digit = P256_ScalarDigit(pK, window);
+        FLib_MemSet(&t, 0x00, sizeof(t));
+        for (i = 0U; i < gP256WindowSize_c; i++)
+        {
+            P256_PointSelect(&t, &pTable->entry[i], &t, mcP256Mask(i == digit));
+        }
+
+        /* acc and t can only be equal when both are infinity: the window
+           prefix is always a multiple of 16 larger than the digit */
+        P256_PointAddUnchecked(&sum, &acc, &t, &h, &r);
+        P256_PointSelect(&sum, &t, &sum, P256_IsZeroMask(&acc.z));
+        P256_PointSelect(&acc, &acc, &sum, P256_IsZeroMask(&t.z));
+    }
+    *pOut = acc;
+}
+
+/*! *********************************************************************************
+* \brief        R = k*P, P given by a precomputed affine window table (G, M, N).
+*               Constant time in k.
+*
+* \param[out]   pOut        Result.
+* \param[in]    pK          Scalar, 0 <= k < n.
+* \param[in]    pTable      gP256WindowSize_c affine entries, entry 0 unused.
+********************************************************************************** */
+void P256_MulFixed(p256Point_t *pOut, const p256Int_t *pK, const p256AffinePoint_t *pTable)
+{
+    p256Point_t acc, t, sum;
+    p256Int_t h, r;
+    uint32_t window, digit, i, mask;
+
+    FLib_MemSet(&acc, 0x00, sizeof(acc));
+    for (window = (256U / gP256WindowBits_c); window-- > 0U;)
+    {
+        for (i = 0U; i < gP256WindowBits_c; i++)
+        {
+            P256_PointDouble(&acc, &acc);
+        }
+
+        digit = P256_ScalarDigit(pK, window);
+        FLib_MemSet(&t, 0x00, sizeof(t));
+        for (i = 1U; i < gP256WindowSize_c; i++)
+        {
+            mask = mcP256Mask(i == digit);
+            P256_Select(&t.x, &pTable[i].x, &t.x, mask);
+            P256_Select(&t.y, &pTable[i].y, &t.y, mask);
+        }
+        P256_Select(&t.z, &mP256FieldP.one, &t.z, ~mcP256Mask(digit == 0U));
+
+        P256_PointAddUnchecked(&sum, &acc, &t, &h, &r);
+        P256_PointSelect(&sum, &t, &sum, P256_IsZeroMask(&acc.z));
+        P256_PointSelect(&acc, &acc, &sum, P256_IsZeroMask(&t.z));
+    }
+    *pOut = acc;
+}
+
+/*! *********************************************************************************
+* \brief        R = k*G using the fixed-base comb (gP256CombSpacing_c doublings and
+*               additions). Constant time in k.
+*
+* \param[out]   pOut        Result.
+* \param[in]    pK          Scalar, 0 <= k < n.
+********************************************************************************** */
+void P256_MulBaseComb(p256Point_t *pOut, const p256Int_t *pK)
+{
+    p256Point_t acc, t, sum;
+    p256Int_t h, r;
+    uint32_t column, digit, i, mask;
+
+    FLib_MemSet(&acc, 0x00, sizeof(acc));
+    for (column = gP256CombSpacing_c; column-- > 0U;)
+    {
+        P256_PointDouble(&acc, &acc);
+
+        digit = P256_CombDigit(pK, column);
+        FLib_MemSet(&t, 0x00, sizeof(t));
+        for (i = 1U; i < gP256CombSize_c; i++)
+        {
+            mask = mcP256Mask(i == digit);
+            P256_Select(&t.x, &gaP256CombG[i].x, &t.x, mask);
+            P256_Select(&t.y, &gaP256CombG[i].y, &t.y, mask);
+        }
+        P256_Select(&t.z, &mP256FieldP.one, &t.z, ~mcP256Mask(digit == 0U));
+
+        /* acc == t would need a scalar relation of negligible probability for
+           k < n; only the infinity operands are handled */
+        P256_PointAddUnchecked(&sum, &acc, &t, &h, &r);
+        P256_PointSelect(&sum, &t, &sum, P256_IsZeroMask(&acc.z));
+        P256_PointSelect(&acc, &acc, &sum, P256_IsZeroMask(&t.z));
+    }
+    *pOut = acc;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        R = A + B, returns the carry.
+********************************************************************************** */
+static uint32_t P256_AddWords(p256Int_t *pR, const p256Int_t *pA, const p256Int_t *pB)
+{
+    uint64_t acc = 0U;
+    uint32_t i;
+
+    for (i = 0U; i < gP256Words_c; i++)
+    {
+        acc += (uint64_t)pA->w[i] + pB->w[i];
+        pR->w[i] = (uint32_t)acc;
+        acc >>= 32;
+    }
+    return (uint32_t)acc;
+}
+
+/*! *********************************************************************************
+* \brief        R = A - B, returns the borrow.
+********************************************************************************** */
+static uint32_t P256_SubWords(p256Int_t *pR, const p256Int_t *pA, const p256Int_t *pB)
+{
+    int64_t acc = 0;
+    uint32_t i;
+
+    for (i = 0U; i < gP256Words_c; i++)
+    {
+        acc += (int64_t)pA->w[i] - (int64_t)pB->w[i];
+        pR->w[i] = (uint32_t)acc;
+        acc >>= 32;
+    }
+    return (uint32_t)(acc & 1);
+}
+
+/*! *********************************************************************************
+* \brief        R = mask ? A : B, mask being all ones or all zeros.
+********************************************************************************** */
+static void P256_Select(p256Int_t *pR, const p256Int_t *pA, const p256Int_t *pB, uint32_t mask)
+{
+    uint32_t i;
+
+    for (i = 0U; i < gP256Words_c; i++)
+    {
+        pR->w[i] = (pA->w[i] & mask) | (pB->w[i] & ~mask);
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Returns all ones if A == 0, zero otherwise.
+********************************************************************************** */
+static uint32_t P256_IsZeroMask(const p256Int_t *pA)
+{
+    uint32_t acc = 0U;
+    uint32_t i;
+
+    for (i = 0U; i < gP256Words_c; i++)
+    {
+        acc |= pA->w[i];
+    }
+    /* MSB of (acc | -acc) is set iff acc != 0 */
+    return ((acc | ((uint32_t)0U - acc)) >> 31) - 1U;
+}
+
+/*! *********************************************************************************
+* \brief        R = A + B mod m, with A, B < m.
+********************************************************************************** */
+static void P256_ModAdd(p256Int_t *pR, const p256Int_t *pA, const p256Int_t *pB, const p256Modulus_t *pMod)
+{
+    p256Int_t sum, red;
+    uint32_t carry = P256_AddWords(&sum, pA, pB);
+    uint32_t borrow = P256_SubWords(&red, &sum, &pMod->m);
+
+    /* Keep the reduced value if the sum overflowed or is >= m */
+    P256_Select(pR, &red, &sum, mcP256Mask(carry | (borrow ^ 1U)));
+}
+
+/*! *********************************************************************************
+* \brief        R = A - B mod m, with A, B < m.
+********************************************************************************** */
+static void P256_ModSub(p256Int_t *pR, const p256Int_t *pA, const p256Int_t *pB, const p256Modulus_t *pMod)
+{
+    p256Int_t diff, fix;
+    uint32_t borrow = P256_SubWords(&diff, pA, pB);
+
+    (void)P256_AddWords(&fix, &diff, &pMod->m);
+    P256_Select(pR, &fix, &diff, mcP256Mask(borrow));
+}
+
+/*! *********************************************************************************
+* \brief        R = A * B / 2^256 mod m (Montgomery, CIOS), with A, B < m.
+********************************************************************************** */
+static void P256_MontMul(p256Int_t *pR, const p256Int_t *pA, const p256Int_t *pB, const p256Modulus_t *pMod)
+{
+    uint32_t t[gP256Words_c + 2U] = {0U};
+    uint64_t acc;
+    uint32_t i, j, q;
+    p256Int_t res, red;
+    uint32_t borrow;
+
+    for (i = 0U; i < gP256Words_c; i++)
+    {
+        acc = 0U;
+        for (j = 0U; j < gP256Words_c; j++)
+        {
+            acc += (uint64_t)t[j] + ((uint64_t)pA->w[j] * pB->w[i]);
+            t[j] = (uint32_t)acc;
+            acc >>= 32;
+        }
+        acc += t[gP256Words_c];
+        t[gP256Words_c] = (uint32_t)acc;
+        t[gP256Words_c + 1U] = (uint32_t)(acc >> 32);
+
+        q = t[0] * pMod->m0inv;
+        acc = (uint64_t)t[0] + ((uint64_t)q * pMod->m.w[0]);
+        acc >>= 32;
+        for (j = 1U; j < gP256Words_c; j++)
+        {
+            acc += (uint64_t)t[j] + ((uint64_t)q * pMod->m.w[j]);
+            t[j - 1U] = (uint32_t)acc;
+            acc >>= 32;
+        }
+        acc += t[gP256Words_c];
+        t[gP256Words_c - 1U] = (uint32_t)acc;
+        t[gP256Words_c] = t[gP256Words_c + 1U] + (uint32_t)(acc >> 32);
+    }
+
+    FLib_MemCpy(res.w, t, sizeof(res.w));
+    borrow = P256_SubWords(&red, &res, &pMod->m);
+    P256_Select(pR, &red, &res, mcP256Mask(t[gP256Words_c] | (borrow ^ 1U)));
+}
+
+/*! *********************************************************************************
+* \brief        R = A^-1 mod m (Fermat, A^(m-2)), Montgomery domain in and out.
+*               The exponent is public; the run time does not depend on A.
+********************************************************************************** */
+static void P256_ModInv(p256Int_t *pR, const p256Int_t *pA, const p256Modulus_t *pMod)
+{
+    p256Int_t exp = pMod->m;
+    p256Int_t acc = pMod->one;
+    int32_t bit;
+
+    /* m is odd and > 2: no borrow past the first word */
+    exp.w[0] -= 2U;
+    for (bit = 255; bit >= 0; bit--)
+    {
+        P256_MontMul(&acc, &acc, &acc, pMod);
+        if (((exp.w[(uint32_t)bit >> 5] >> ((uint32_t)bit & 31U)) & 1U) != 0U)
+        {
+            P256_MontMul(&acc, &acc, pA, pMod);
+        }
+    }
+    *pR = acc;
+}
+
+/*! *********************************************************************************
+* \brief        R = mask ? A : B for points.
+********************************************************************************** */
+static void P256_PointSelect(p256Point_t *pR, const p256Point_t *pA, const p256Point_t *pB, uint32_t mask)
+{
+    P256_Select(&pR->x, &pA->x, &pB->x, mask);
+    P256_Select(&pR->y, &pA->y, &pB->y, mask);
+    P256_Select(&pR->z, &pA->z, &pB->z, mask);
+}
+
+/*! *********************************************************************************
+* \brief        R = 2P (dbl-2001-b, a = -3). Infinity stays infinity. R may alias P.
+********************************************************************************** */
+static void P256_PointDouble(p256Point_t *pR, const p256Point_t *pP)
+{
+    const p256Modulus_t *pF = &mP256FieldP;
+    p256Int_t delta, gamma, beta, alpha, t1, t2;
+
+    P256_MontMul(&delta, &pP->z, &pP->z, pF);
+    P256_MontMul(&gamma, &pP->y, &pP->y, pF);
+    P256_MontMul(&beta, &pP->x, &gamma, pF);
+
+    /* alpha = 3 * (X - delta) * (X + delta) */
+    P256_ModSub(&t1, &pP->x, &delta, pF);
+    P256_ModAdd(&t2, &pP->x, &delta, pF);
+    P256_MontMul(&alpha, &t1, &t2, pF);
+    P256_ModAdd(&t1, &alpha, &alpha, pF);
+    P256_ModAdd(&alpha, &t1, &alpha, pF);
+
+    /* Z3 = (Y + Z)^2 - gamma - delta */
+    P256_ModAdd(&t1, &pP->y, &pP->z, pF);
+    P256_MontMul(&t1, &t1, &t1, pF);
+    P256_ModSub(&t1, &t1, &gamma, pF);
+    P256_ModSub(&pR->z, &t1, &delta, pF);
+
+    /* X3 = alpha^2 - 8 * beta */
+    P256_ModAdd(&beta, &beta, &beta, pF);
+    P256_ModAdd(&beta, &beta, &beta, pF);           /* 4 * beta */
+    P256_MontMul(&t1, &alpha, &alpha, pF);
+    P256_ModAdd(&t2, &beta, &beta, pF);
+    P256_ModSub(&pR->x, &t1, &t2, pF);
+
+    /* Y3 = alpha * (4 * beta - X3) - 8 * gamma^2 */
+    P256_ModSub(&t1, &beta, &pR->x, pF);
+    P256_MontMul(&t1, &alpha, &t1, pF);
+    P256_MontMul(&gamma, &gamma, &gamma, pF);
+    P256_ModAdd(&gamma, &gamma, &gamma, pF);
+    P256_ModAdd(&gamma, &gamma, &gamma, pF);
+    P256_ModAdd(&gamma, &gamma, &gamma, pF);
+    P256_ModSub(&pR->y, &t1, &gamma, pF);
+}
+
+/*! *********************************************************************************
+* \brief        R = P + Q (add-2007-bl) without special cases. The caller handles
+*               infinity operands and P == Q using the returned H and r.
+********************************************************************************** */
+static void P256_PointAddUnchecked(p256Point_t *pR, const p256Point_t *pP, const p256Point_t *pQ, p256Int_t *pH, p256Int_t *pRr)
+{
+    const p256Modulus_t *pF = &mP256FieldP;
+    p256Int_t z1z1, z2z2, u1, u2, s1, s2, i, j, v, t;
+
+    P256_MontMul(&z1z1, &pP->z, &pP->z, pF);
+    P256_MontMul(&z2z2, &pQ->z, &pQ->z, pF);
+    P256_MontMul(&u1, &pP->x, &z2z2, pF);
+    P256_MontMul(&u2, &pQ->x, &z1z1, pF);
+    P256_MontMul(&s1, &pP->y, &pQ->z, pF);
+    P256_MontMul(&s1, &s1, &z2z2, pF);
+    P256_MontMul(&s2, &pQ->y, &pP->z, pF);
+    P256_MontMul(&s2, &s2, &z1z1, pF);
+
+    P256_ModSub(pH, &u2, &u1, pF);
+    P256_ModSub(pRr, &s2, &s1, pF);
+
+    /* Z3 = ((Z1 + Z2)^2 - Z1Z1 - Z2Z2) * H, computed before X/Y in case R aliases P or Q */
+    P256_ModAdd(&t, &pP->z, &pQ->z, pF);
+    P256_MontMul(&t, &t, &t, pF);
+    P256_ModSub(&t, &t, &z1z1, pF);
+    P256_ModSub(&t, &t, &z2z2, pF);
+    P256_MontMul(&z1z1, &t, pH, pF);
+
+    P256_ModAdd(&i, pH, pH, pF);
+    P256_MontMul(&i, &i, &i, pF);                   /* I = (2H)^2 */
+    P256_MontMul(&j, pH, &i, pF);                   /* J = H * I */
+    P256_ModAdd(&t, pRr, pRr, pF);                  /* r = 2 * (S2 - S1) */
+    P256_MontMul(&v, &u1, &i, pF);                  /* V = U1 * I */
+
+    /* X3 = r^2 - J - 2V */
+    P256_MontMul(&u2, &t, &t, pF);
+    P256_ModSub(&u2, &u2, &j, pF);
+    P256_ModSub(&u2, &u2, &v, pF);
+    P256_ModSub(&u2, &u2, &v, pF);
+
+    /* Y3 = r * (V - X3) - 2 * S1 * J */
+    P256_ModSub(&v, &v, &u2, pF);
+    P256_MontMul(&v, &t, &v, pF);
+    P256_MontMul(&s1, &s1, &j, pF);
+    P256_ModAdd(&s1, &s1, &s1, pF);
+    P256_ModSub(&pR->y, &v, &s1, pF);
+
+    pR->x = u2;
+    pR->z = z1z1;
+}
+
+/*! *********************************************************************************
+* \brief        Returns the 4-bit digit of k at the given window index.
+********************************************************************************** */
+static uint32_t P256_ScalarDigit(const p256Int_t *pK, uint32_t window)
+{
+    uint32_t bitPos = window * gP256WindowBits_c;
+
+    return (pK->w[bitPos >> 5] >> (bitPos & 31U)) & (gP256WindowSize_c - 1U);
+}
+
+/*! *********************************************************************************
+* \brief        Returns the comb digit of k for a column: bit i is bit
+*               (i * gP256CombSpacing_c + column) of k.
+********************************************************************************** */
+static uint32_t P256_CombDigit(const p256Int_t *pK, uint32_t column)
+{
+    uint32_t digit = 0U;
+    uint32_t bitPos;
+    uint32_t i;
+
+    for (i = 0U; i < gP256CombTeeth_c; i++)
+    {
+        bitPos = (i * gP256CombSpacing_c) + column;
+        if (bitPos < 256U)
+        {
+            digit |= ((pK->w[bitPos >> 5] >> (bitPos & 31U)) & 1U) << i;
+        }
+    }
+    return digit;
+}
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
@@ -0,0 +1,129 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file ccc_p256.h
+*
+* NIST P-256 field, scalar and point arithmetic used by the CCC owner pairing
+* (SPAKE2+) and RKE signing. All operations on secret scalars run in constant
+* time: fixed 4-bit windows, full table scans and masked selects.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef CCC_P256_H
+#define CCC_P256_H
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+/*! Time the SPAKE2+ steps and the RKE signature and log the durations at debug
+    trace level (TM time base). Redefine it in the app_preinclude.h file */
+#ifndef gAppCccStepTimes_d
+#define gAppCccStepTimes_d           0
+#endif
+
+#define gP256Words_c                 (8U)     /* 32-bit words per field element / scalar */
+#define gP256ScalarSize_c            (32U)    /* Big-endian scalar / coordinate size */
+#define gP256PointSize_c             (65U)    /* Uncompressed SEC1 point: 0x04 || X || Y */
+#define gP256WindowBits_c            (4U)
+#define gP256WindowSize_c            (1U << gP256WindowBits_c)
+#define gP256CombTeeth_c             (6U)
+#define gP256CombSpacing_c           (43U)    /* ceil(256 / gP256CombTeeth_c) */
+#define gP256CombSize_c              (1U << gP256CombTeeth_c)
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+/*! \brief  256-bit integer, little-endian 32-bit words. */
+typedef struct p256Int_tag
+{
+    uint32_t w[gP256Words_c];
+}p256Int_t;
+
+/*! \brief  Point in Jacobian coordinates, Montgomery domain. Z = 0 is infinity. */
+typedef struct p256Point_tag
+{
+    p256Int_t x;
+    p256Int_t y;
+    p256Int_t z;
+}p256Point_t;
+
+/*! \brief  Point in affine coordinates, Montgomery domain. */
+typedef struct p256AffinePoint_tag
+{
+    p256Int_t x;
+    p256Int_t y;
+}p256AffinePoint_t;
+
+/*! \brief  Window table of a point P: entry i holds i*P, entry 0 is infinity. */
+typedef struct p256PointTable_tag
+{
+    p256Point_t entry[gP256WindowSize_c];
+}p256PointTable_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public memory declarations
+*************************************************************************************
+************************************************************************************/
+/* Precomputed window tables (i*P, i = 0..15, affine, Montgomery domain) */
+extern const p256AffinePoint_t gaP256TableG[gP256WindowSize_c];
+extern const p256AffinePoint_t gaP256TableM[gP256WindowSize_c];   /* SPAKE2+ M (RFC 9382) */
+extern const p256AffinePoint_t gaP256TableN[gP256WindowSize_c];   /* SPAKE2+ N (RFC 9382) */
+
+/* Fixed-base comb for G: entry b = sum of bit i of b times 2^(i * gP256CombSpacing_c) * G */
+extern const p256AffinePoint_t gaP256CombG[gP256CombSize_c];
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Scalars (mod n) */
+void P256_ScalarFromBytes(p256Int_t *pOut, const uint8_t *pIn);
+void P256_ScalarToBytes(uint8_t *pOut, const p256Int_t *pIn);
+bool_t P256_ScalarIsValid(const p256Int_t *pK);
+void P256_ScalarReduce(p256Int_t *pK);
+void P256_ScalarAddMod(p256Int_t *pOut, const p256Int_t *pA, const p256Int_t *pB);
+void P256_ScalarMulMod(p256Int_t *pOut, const p256Int_t *pA, const p256Int_t *pB);
+void P256_ScalarInvMod(p256Int_t *pOut, const p256Int_t *pA);
+
+/* Points */
+bool_t P256_PointDecode(p256Point_t *pOut, const uint8_t *pIn);
+bool_t P256_PointEncode(uint8_t *pOut, const p256Point_t *pIn);
+bool_t P256_PointIsInfinity(const p256Point_t *pP);
+void P256_PointNegate(p256Point_t *pOut, const p256Point_t *pIn);
+void P256_PointAdd(p256Point_t *pOut, const p256Point_t *pP, const p256Point_t *pQ);
+
+/* Scalar multiplication */
+void P256_PrepareTable(p256PointTable_t *pTable, const p256Point_t *pP);
+void P256_MulTable(p256Point_t *pOut, const p256Int_t *pK, const p256PointTable_t *pTable);
+void P256_MulFixed(p256Point_t *pOut, const p256Int_t *pK, const p256AffinePoint_t *pTable);
+void P256_MulBaseComb(p256Point_t *pOut, const p256Int_t *pK);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CCC_P256_H */
+
+/*! *********************************************************************************
+ * @}
+ ********************************************************************************** */
@@ -0,0 +1,375 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file ccc_p256_tables.c
+*
+* Precomputed 4-bit window tables (i*P, i = 1..15) for the fixed P-256 points:
+* the generator G and the SPAKE2+ points M and N (RFC 9382, P-256 suite), and the
+* 6-teeth comb of G used for signing.
+* Affine coordinates, Montgomery domain (x * 2^256 mod p). Entry 0 is unused.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "ccc_p256.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public memory declarations
+*************************************************************************************
+************************************************************************************/
+const p256AffinePoint_t gaP256TableG[gP256WindowSize_c] =
+{
+    {{{0U}}, {{0U}}},
+    /*  1G */
+    {{{0x18A9143CU, 0x79E730D4U, 0x5FEDB601U, 0x75BA95FCU, 0x77622510U, 0x79FB732BU, 0xA53755C6U, 0x18905F76U}},
+     {{0xCE95560AU, 0xDDF25357U, 0xBA19E45CU, 0x8B4AB8E4U, 0xDD21F325U, 0xD2E88688U, 0x25885D85U, 0x8571FF18U}}},
+    /*  2G */
+    {{{0x10DDD64DU, 0x850046D4U, 0xA433827DU, 0xAA6AE3C1U, 0x8D1490D9U, 0x73220503U, 0x3DCF3A3BU, 0xF6BB32E4U}},
+     {{0x61BEE1A5U, 0x2F3648D3U, 0xEB236FF8U, 0x152CD7CBU, 0x92042DBEU, 0x19A8FB0EU, 0x0A5B8A3BU, 0x78C57751U}}},
+    /*  3G */
+    {{{0x4EEBC127U, 0xFFAC3F90U, 0x087D81FBU, 0xB027F84AU, 0x87CBBC98U, 0x66AD77DDU, 0xB6FF747EU, 0x26936A3FU}},
+     {{0xC983A7EBU, 0xB04C5C1FU, 0x0861FE1AU, 0x583E47ADU, 0x1A2EE98EU, 0x78820831U, 0xE587CC07U, 0xD5F06A29U}}},
+    /*  4G */
+    {{{0x46918DCCU, 0x74B0B50DU, 0xC623C173U, 0x4650A6EDU, 0xE8100AF2U, 0x0CDAACACU, 0x41B0176BU, 0x577362F5U}},
+     {{0xE4CBABA6U, 0x2D96F24CU, 0xFAD6F447U, 0x17628471U, 0xE5DDD22EU, 0x6B6C36DEU, 0x4C5AB863U, 0x84B14C39U}}},
+    /*  5G */
+    {{{0xC45C61F5U, 0xBE1B8AAEU, 0x94B9537DU, 0x90EC649AU, 0xD076C20CU, 0x941CB5AAU, 0x890523C8U, 0xC9079605U}},
+     {{0xE7BA4F10U, 0xEB309B4AU, 0xE5EB882BU, 0x73C568EFU, 0x7E7A1F68U, 0x3540A987U, 0x2DD1E916U, 0x73A076BBU}}},
+    /*  6G */
+    {{{0x3E77664AU, 0x40394737U, 0x346CEE3EU, 0x55AE744FU, 0x5B17A3ADU, 0xD50A961AU, 0x54213673U, 0x13074B59U}},
+     {{0xD377E44BU, 0x93D36220U, 0xADFF14B5U, 0x299C2B53U, 0xEF639F11U, 0xF424D44CU, 0x4A07F75FU, 0xA4C9916DU}}},
+    /*  7G */
+    {{{0xA0173B4FU, 0x0746354EU, 0xD23C00F7U, 0x2BD20213U, 0x0C23BB08U, 0xF43EAAB5U, 0xC3123E03U, 0x13BA5119U}},
+     {{0x3F5B9D4DU, 0x2847D030U, 0x5DA67BDDU, 0x6742F2F2U, 0x77C94195U, 0xEF933BDCU, 0x6E240867U, 0xEAEDD915U}}},
+    /*  8G */
+    {{{0x9499A78FU, 0x27F14CD1U, 0x6F9B3455U, 0x462AB5C5U, 0xF02CFC6BU, 0x8F90F02AU, 0xB265230DU, 0xB763891EU}},
+     {{0x532D4977U, 0xF59DA3A9U, 0xCF9EBA15U, 0x21E3327DU, 0xBE60BBF0U, 0x123C7B84U, 0x7706DF76U, 0x56EC12F2U}}},
+    /*  9G */
+    {{{0x264E20E8U, 0x75C96E8FU, 0x59A7A841U, 0xABE6BFEDU, 0x44C8EB00U, 0x2CC09C04U, 0xF0C4E16BU, 0xE05B3080U}},
+     {{0xA45F3314U, 0x1EB7777AU, 0xCE5D45E3U, 0x56AF7BEDU, 0x88B12F1AU, 0x2B6E019AU, 0xFD835F9BU, 0x086659CDU}}},
+    /* 10G */
+    {{{0x9DC21EC8U, 0x2C18DBD1U, 0x0FCF8139U, 0x98F9868AU, 0x48250B49U, 0x737D2CD6U, 0x24B3428FU, 0xCC61C947U}},
+     {{0x80DD9E76U, 0x0C2B4078U, 0x383FBE08U, 0xC43A8991U, 0x779BE5D2U, 0x5F7D2D65U, 0xEB3B4AB5U, 0x78719A54U}}},
+    /* 11G */
+    {{{0x6245E404U, 0xEA7D260AU, 0x6E7FDFE0U, 0x9DE40795U, 0x8DAC1AB5U, 0x1FF3A415U, 0x649C9073U, 0x3E7090F1U}},
+     {{0x2B944E88U, 0x1A768561U, 0xE57F61C8U, 0x250F939EU, 0x1EAD643DU, 0x0C0DAA89U, 0xE125B88EU, 0x68930023U}}},
+    /* 12G */
+    {{{0xD2697768U, 0x04B71AA7U, 0xCA345A33U, 0xABDEDEF5U, 0xEE37385EU, 0x2409D29DU, 0xCB83E156U, 0x4EE1DF77U}},
+     {{0x1CBB5B43U, 0x0CAC12D9U, 0xCA895637U, 0x170ED2F6U, 0x8ADE6D66U, 0x28228CFAU, 0x53238ACAU, 0x7FF57C95U}}},
+    /* 13G */
+    {{{0x4B2ED709U, 0xCCC42563U, 0x856FD30DU, 0x0E356769U, 0x559E9811U, 0xBCBCD43FU, 0x5395B759U, 0x738477ACU}},
+     {{0xC00EE17FU, 0x35752B90U, 0x742ED2E3U, 0x68748390U, 0xBD1F5BC1U, 0x7CD06422U, 0xC9E7B797U, 0xFBC08769U}}},
+    /* 14G */
+    {{{0xB0CF664AU, 0xA242A35BU, 0x7F9707E3U, 0x126E48F7U, 0xC6832660U, 0x1717BF54U, 0xFD12C72EU, 0xFAAE7332U}},
+     {{0x995D586BU, 0x27B52DB7U, 0x832237C2U, 0xBE29569EU, 0x2A65E7DBU, 0xE8E4193EU, 0x2EAA1BBBU, 0x152706DCU}}},
+    /* 15G */
+    {{{0xBC60055BU, 0x72BCD8B7U, 0x56E27E4BU, 0x03CC23EEU, 0xE4819370U, 0xEE337424U, 0x0AD3DA09U, 0xE2AA0E43U}},
+     {{0x6383C45DU, 0x40B8524FU, 0x42A41B25U, 0xD7663554U, 0x778A4797U, 0x64EFA6DEU, 0x7079ADF4U, 0x2042170AU}}}
+};
+
+const p256AffinePoint_t gaP256TableM[gP256WindowSize_c] =
+{
+    {{{0U}}, {{0U}}},
+    /*  1M */
+    {{{0x25031EE1U, 0x8E46DB1EU, 0x3F5117F2U, 0x06891739U, 0xC962BF07U, 0x28312D86U, 0xE4C348F2U, 0xC780D935U}},
+     {{0x83B540CBU, 0xF8D72509U, 0x8A0134D5U, 0x3992291EU, 0xF44340D4U, 0x024DA7B1U, 0x5D3A7884U, 0xFDB70AFAU}}},
+    /*  2M */
+    {{{0xBC3BB92FU, 0xC42A3FE4U, 0x30CEF50BU, 0x0FF74412U, 0x6C64E6FCU, 0x4244803CU, 0x2C17CAE8U, 0x98E2DC3EU}},
+     {{0x70FB2D2CU, 0x99B5D725U, 0x5D56B3B6U, 0x6984A919U, 0xE581ADB5U, 0x5F071E57U, 0x10A1875CU, 0x00BBAEFAU}}},
+    /*  3M */
+    {{{0x8386F9D0U, 0x07E4F5ACU, 0x2B1141C8U, 0x99F473E1U, 0x11275F95U, 0x5DB87328U, 0x7CFBB74DU, 0x57462791U}},
+     {{0x2A62ECAEU, 0xB9C1F5D8U, 0xB4403E8AU, 0x16E97CB9U, 0xD7AAF179U, 0x9D1A65F0U, 0xE1CCC6DCU, 0x64B9BF10U}}},
+    /*  4M */
+    {{{0x8E119B5CU, 0x79896EB6U, 0x0F3D16F0U, 0x214C626AU, 0x9BD12C99U, 0xD413E4E5U, 0x5C4B5A26U, 0x1635653FU}},
+     {{0x10A4C384U, 0x9A5C5984U, 0x21289229U, 0xCDF039EBU, 0xCC972B41U, 0x363763DDU, 0x4C0E56EEU, 0x86EFBB16U}}},
+    /*  5M */
+    {{{0xB366424AU, 0x2B31B9D1U, 0x19C5FCB3U, 0xDE32D95CU, 0x64549645U, 0x715AA011U, 0xA17225A8U, 0x912C566DU}},
+     {{0xFECFACB2U, 0xEDB3C47EU, 0x18AF771BU, 0x2AD0D037U, 0x6D82C307U, 0xB50A7C16U, 0xE7D1D5E0U, 0x6F6F9A77U}}},
+    /*  6M */
+    {{{0x14671F2EU, 0x03E5CAD3U, 0xB68524A7U, 0x5BCEA648U, 0x20408F18U, 0x06E91FE9U, 0xEE32E1B1U, 0x0ED66986U}},
+     {{0x54B24888U, 0xEDB31D81U, 0xB355FA54U, 0xFC450B27U, 0x57437087U, 0x83A9A4B7U, 0xC668853CU, 0xB742004BU}}},
+    /*  7M */
+    {{{0xE6BCB0F2U, 0x116B3CCDU, 0x4DE87DB6U, 0xF8EB7D36U, 0x4827F34DU, 0x6F5E62EBU, 0x3157893EU, 0xDCA7599DU}},
+     {{0xEE51B12EU, 0x78CFA390U, 0xA648E826U, 0x39A41561U, 0xC8CCAA65U, 0xBF45DED0U, 0xB3110124U, 0x8230968DU}}},
+    /*  8M */
+    {{{0x57C9C358U, 0x2FE7751EU, 0x051F6C15U, 0xD884FBB0U, 0xB9806251U, 0x21470885U, 0x47427095U, 0x71F14457U}},
+     {{0x7BD46692U, 0x5B5754BFU, 0xCEDA7F74U, 0x6B30B497U, 0x737D3A7FU, 0x7F2F3FD7U, 0x2F28FAF0U, 0x9DF8B044U}}},
+    /*  9M */
+    {{{0xD5D18632U, 0xDD2EDE96U, 0x75628E16U, 0xB84284C3U, 0x4C607DD1U, 0xFFF25035U, 0x197F7F48U, 0x2C0A1B7AU}},
+     {{0xC2F4E703U, 0x81310631U, 0xAB5E3BD6U, 0x1A0B8F5DU, 0x50ACF15EU, 0x2E3F8757U, 0x384B525CU, 0x10159ADFU}}},
+    /* 10M */
+    {{{0x4AC634F5U, 0x017B69C5U, 0xC2D1DA98U, 0xC79BD23CU, 0xFBDEBB34U, 0x444084DCU, 0xE445717CU, 0x2BEE7CAFU}},
+     {{0x26F5156DU, 0x45C4B746U, 0xB1919017U, 0xF9682895U, 0xBF0372F6U, 0x6FDC1B63U, 0x3C87FAE3U, 0x20A77E01U}}},
+    /* 11M */
+    {{{0xC93E31EAU, 0x95A6CE08U, 0x84CC9CF4U, 0x9002618EU, 0xA31D091CU, 0x365CCE90U, 0xFFE73773U, 0xBCCCE941U}},
+     {{0x853CFDD6U, 0x8F510EAAU, 0xE042B2C2U, 0x548EBAA5U, 0x848631B5U, 0xFF97CC13U, 0x6ABB5BF6U, 0x10F18E93U}}},
+    /* 12M */
+    {{{0x7648BB7CU, 0x6A835058U, 0x2D04B662U, 0xC5B99043U, 0x0E044E98U, 0x990BC669U, 0xE794CDB9U, 0xBD56700AU}},
+     {{0x75A023E1U, 0x0F97933AU, 0x76136445U, 0xAB7160E1U, 0x73E7DCA8U, 0x4B8EEBF5U, 0xE9D97C40U, 0x2678A111U}}},
+    /* 13M */
+    {{{0x301CD75AU, 0xB3752E7EU, 0xE2F3A21CU, 0xF2E2A6D2U, 0xCC57BA5FU, 0x9D65F2FCU, 0xDEBD12E4U, 0x0B0732D8U}},
+     {{0x61D3DCBFU, 0xC0E53F3DU, 0xF9389156U, 0x7E19D84DU, 0xE80E1DEDU, 0xCCAAFC3EU, 0x8859BD77U, 0x913A4F7EU}}},
+    /* 14M */
+    {{{0xE8FE16EAU, 0x3F07E07CU, 0x13F3CB79U, 0x0B50D651U, 0xFA562FF8U, 0xA794320DU, 0x1D120B6DU, 0xC68BC11BU}},
+     {{0x717053DEU, 0xD372B87CU, 0x0303B341U, 0xB06E9904U, 0x3B13B568U, 0x2C8700DBU, 0x1468F87DU, 0x1E751396U}}},
+    /* 15M */
+    {{{0x4BCAEE20U, 0x71D0EC31U, 0x9C37E9C2U, 0x721D5CDEU, 0x7E777209U, 0xCAB57AF8U, 0xC287A009U, 0x4113195EU}},
+     {{0x0634E6FCU, 0x77B2570CU, 0xBAF84C08U, 0xE8E2988CU, 0x353C0856U, 0xD8C411ECU, 0xCF775A64U, 0xA43FDDDEU}}}
+};
+
+const p256AffinePoint_t gaP256TableN[gP256WindowSize_c] =
+{
+    {{{0U}}, {{0U}}},
+    /*  1N */
+    {{{0xAFDB6071U, 0x5109D1D8U, 0x5843D9FBU, 0x902C406EU, 0xBF4B67E6U, 0x91CFE8BAU, 0x229EFEADU, 0x27382BA0U}},
+     {{0x3476905BU, 0x494E0A03U, 0xB1F23B0BU, 0xD0F2BCD4U, 0x36D38A4FU, 0x1661DF78U, 0x8DA4116CU, 0x72DCFCABU}}},
+    /*  2N */
+    {{{0xB1EFBC65U, 0x808E5A5FU, 0x29796875U, 0xAC420B0DU, 0x35FB6AF1U, 0x530FE902U, 0x1230DC51U, 0x9218675DU}},
+     {{0x52E7E7EAU, 0xBB305FFFU, 0xA0379447U, 0x8858293BU, 0x4A598EC6U, 0x4561131BU, 0xB0094DA2U, 0xB4BF663DU}}},
+    /*  3N */
+    {{{0xF0945673U, 0x93FB5E1EU, 0x0D27BAB2U, 0x357D136DU, 0x79AC4FAFU, 0x0E0F4DA9U, 0x132E0518U, 0xA12CD360U}},
+     {{0xF5FD30D5U, 0x8E34D4F8U, 0x6306AA0CU, 0x652DCAADU, 0x095E67FCU, 0x3F79A418U, 0x180DEA29U, 0x1C092B61U}}},
+    /*  4N */
+    {{{0xD25E5875U, 0x205E3AECU, 0x9CB0D86BU, 0x06D6F349U, 0x0B97912DU, 0xF4ABCB9BU, 0xD4E55D9AU, 0x72B6D6DEU}},
+     {{0x90096F8BU, 0x3BFBFF5CU, 0x3C09E95CU, 0xDE53037FU, 0xD74D7B13U, 0xAEEA242EU, 0xB8B8A702U, 0xA5F7CFD6U}}},
+    /*  5N */
+    {{{0x5D125A04U, 0x924AB2A3U, 0x2CADA3F2U, 0xD775ADE5U, 0x95F95B80U, 0x85F8ED10U, 0xC91B3B7BU, 0x1944C9DDU}},
+     {{0x6C977CB4U, 0x1A2F8354U, 0xD21EE0E0U, 0x4C39B39AU, 0x98338730U, 0x598CE589U, 0xE7030860U, 0x06D64BDBU}}},
+    /*  6N */
+    {{{0xC174CD7AU, 0xE662E4B9U, 0xD8FA56C5U, 0x14E8A6D5U, 0xDFDA512FU, 0xB988EA35U, 0x8AB6BFBCU, 0x8946CDABU}},
+     {{0x55C05C6BU, 0x06C8725EU, 0xA01AA269U, 0xFADB7ABCU, 0xE6F90408U, 0xA1F4B738U, 0x4F7AAF63U, 0xE933D40BU}}},
+    /*  7N */
+    {{{0x16829D46U, 0x609956D3U, 0x5AE1A564U, 0xAE286CEAU, 0x697DBDCEU, 0xB9F54EFEU, 0x37F291F7U, 0x6BB056EDU}},
+     {{0x8B1051D2U, 0x631C8E84U, 0x72B87E04U, 0x6DC9D230U, 0x0EB8B40DU, 0xBDDDC183U, 0x389C33B3U, 0x393A4FE4U}}},
+    /*  8N */
+    {{{0xC4A82F27U, 0x53806D7AU, 0x29EDC7D7U, 0x8F8BCDEDU, 0xA24A497CU, 0x904EB900U, 0x7174FA01U, 0xADB6B9AAU}},
+     {{0x69CA7CD1U, 0x72B5D1E3U, 0x2F182889U, 0x3EDCF0A3U, 0x1D69D34CU, 0xF4E8CBFEU, 0x071E8038U, 0xB624C5A4U}}},
+    /*  9N */
+    {{{0x2534847BU, 0x8142DA94U, 0xEC9BE6DBU, 0x8F702E48U, 0x1AD4C1F3U, 0x960D2E56U, 0xC8BB698AU, 0x07DB0322U}},
+     {{0x770E8A2CU, 0x0FC596ACU, 0x82A73E68U, 0xF8917D3AU, 0x4DDAEA6DU, 0x780216BEU, 0x6730AA20U, 0x3F8C4258U}}},
+    /* 10N */
+    {{{0xBDA6F5A3U, 0xFFE61402U, 0xD97525D3U, 0xFD2FA52FU, 0x0CFE2733U, 0xE68D397AU, 0x1A6891C9U, 0x9C583D02U}},
+     {{0xBF66F74BU, 0x53197C1BU, 0x98340172U, 0x78521F7BU, 0xB9B24951U, 0x022DD0E4U, 0xFC883585U, 0x8E1739DDU}}},
+    /* 11N */
+    {{{0xDCEC3D00U, 0x2B17953CU, 0x949B0164U, 0xBBCF0B01U, 0x3D430EB6U, 0x2F37C378U, 0xDF70A144U, 0x1824F003U}},
+     {{0x6D121F60U, 0x057F0696U, 0x8D662B9AU, 0x0F97477CU, 0x8C8DCD0EU, 0xC28F6467U, 0x231A85C6U, 0x65F533F3U}}},
+    /* 12N */
+    {{{0x33CEDEB8U, 0x3C969FC8U, 0x99DE3477U, 0x7DA7C2A0U, 0xF92138BDU, 0x57DE50D5U, 0xC319B1B5U, 0xEDE7450FU}},
+     {{0x49C93D52U, 0xFD54C9BBU, 0x5A92E563U, 0x4FAE9199U, 0x0A82D2D0U, 0xB22FC1EEU, 0x431E172BU, 0x5D309F8BU}}},
+    /* 13N */
+    {{{0xA3619307U, 0xDF325F54U, 0xBD99E333U, 0x4116A325U, 0x4A136C22U, 0x14814FB6U, 0xAB083043U, 0x8F060291U}},
+     {{0x6C4E31C4U, 0xDA0C6363U, 0x39E7BFFEU, 0x0CDDBA19U, 0x7CD26489U, 0xC34E136DU, 0x19BC1E1EU, 0xE0FDB374U}}},
+    /* 14N */
+    {{{0x1412EEE2U, 0xFE6E14D1U, 0x9A8DDE6AU, 0x41B464C7U, 0xB01C8FA0U, 0xC89CD9A6U, 0xC8419BF1U, 0xB28FC533U}},
+     {{0xE7AF9839U, 0x9BA5D0C1U, 0x31EBF003U, 0xE5497CDCU, 0xA826945CU, 0x63384B70U, 0x0CE2AB44U, 0xFB382C68U}}},
+    /* 15N */
+    {{{0x3FF9131CU, 0xB79062D9U, 0x0D0F9DE7U, 0xD8A85280U, 0x42D8AB9DU, 0x3ADA00ADU, 0xEC54B5AFU, 0x23E9294EU}},
+     {{0x7D8F970BU, 0x5356CC02U, 0x354F3A54U, 0xC3361165U, 0x2C139C1EU, 0x98725E03U, 0x31A26454U, 0xDF7B38C3U}}}
+};
+
+const p256AffinePoint_t gaP256CombG[gP256CombSize_c] =
+{
+    {{{0U}}, {{0U}}},
+    /* 0x01 */
+    {{{0x18A9143CU, 0x79E730D4U, 0x5FEDB601U, 0x75BA95FCU, 0x77622510U, 0x79FB732BU, 0xA53755C6U, 0x18905F76U}},
+     {{0xCE95560AU, 0xDDF25357U, 0xBA19E45CU, 0x8B4AB8E4U, 0xDD21F325U, 0xD2E88688U, 0x25885D85U, 0x8571FF18U}}},
+    /* 0x02 */
+    {{{0x03605C39U, 0x89105079U, 0xA142C96CU, 0xF0843D9EU, 0x16923684U, 0xF3744934U, 0xFA0A2893U, 0x732CAA2FU}},
+     {{0x61160170U, 0xB2E8C270U, 0x437FBAA3U, 0xC32788CCU, 0xA6EDA3ACU, 0x39CD818EU, 0x9E2B2E07U, 0xE2E94239U}}},
+    /* 0x03 */
+    {{{0xABC3E190U, 0xB9C0D276U, 0xCB55B9CAU, 0x610E3D4DU, 0x5720F50AU, 0xD16DBD02U, 0xA607DE84U, 0xD0ED73DCU}},
+     {{0x49219FB5U, 0x3BBDE5BFU, 0x57771843U, 0x698E12C0U, 0x63470A5EU, 0xDB606A97U, 0x853635D5U, 0x61C71975U}}},
+    /* 0x04 */
+    {{{0xEC7FAE9FU, 0xEB5DDCB6U, 0xEFB66E5AU, 0x995F2714U, 0x69445D52U, 0xDEE95D8EU, 0x09E27620U, 0x1B6C2D46U}},
+     {{0x8129D716U, 0x32621C31U, 0x0958C1AAU, 0xB03909F1U, 0x1AF4AF63U, 0x8C468EF9U, 0xFBA5CDF6U, 0x162C429FU}}},
+    /* 0x05 */
+    {{{0xC1D85F12U, 0x4615D912U, 0xE1F4E302U, 0x1F0880B0U, 0x6F1FCA13U, 0x336BCC89U, 0xC70DEDBCU, 0xDA59AD0DU}},
+     {{0xB0F62ECEU, 0x3897EFAEU, 0xF4990CFDU, 0xBAED81CDU, 0x60321BBBU, 0xA3B1C2F2U, 0xDDC84F79U, 0x2AEFD95AU}}},
+    /* 0x06 */
+    {{{0xEE9E92E6U, 0x2D427E3CU, 0x437FE629U, 0x43D40DA0U, 0x6AB72B31U, 0x0006E4E0U, 0x6F5C8E02U, 0x21CCFBB4U}},
+     {{0x53E821ECU, 0x53A2F1A7U, 0xE209D591U, 0x5D72D201U, 0x45E8AD41U, 0xFD84A264U, 0x4059CC6EU, 0x86EE0E68U}}},
+    /* 0x07 */
+    {{{0x9248FCE2U, 0x3D8242D0U, 0x7F49F33DU, 0x32D4BF82U, 0x29D41FD1U, 0x78807BEBU, 0xF8F562CBU, 0xFCE48B99U}},
+     {{0x9F38F097U, 0x72A7D484U, 0xA37059ADU, 0x1B482C10U, 0x472E5ED3U, 0xC1AA8284U, 0xEF23E9C9U, 0xC5D6F3BBU}}},
+    /* 0x08 */
+    {{{0xB8A24A20U, 0x23F949FEU, 0xF52CA53FU, 0x17EBFED1U, 0xBCFB4853U, 0x9B691BBEU, 0x6278A05DU, 0x5617FF6BU}},
+     {{0xE3C99EBDU, 0x241B34C5U, 0x1784156AU, 0xFC64242EU, 0x695D67DFU, 0x4206482FU, 0xEE27C011U, 0xB967CE0EU}}},
+    /* 0x09 */
+    {{{0x9FC3DF19U, 0x569AACDFU, 0xC34C6FB2U, 0x0C6782C7U, 0xC4EC873DU, 0xBB5F98B2U, 0x9FE9E475U, 0x5578433BU}},
+     {{0x9CA84821U, 0xFA14F386U, 0x39589501U, 0xB8EF658DU, 0x07127B8EU, 0x4022C48EU, 0x5402EA12U, 0xCBC4DFE3U}}},
+    /* 0x0A */
+    {{{0x2AD408A3U, 0x092EF96AU, 0xCFBC45A3U, 0xF1E1A4C4U, 0xEFEECDEEU, 0x966B2676U, 0x3A6216C5U, 0xA0E2C671U}},
+     {{0x92C4BF61U, 0xCD6E22A2U, 0xD830DFC7U, 0x56D99A11U, 0x259DE547U, 0xB8C612BDU, 0xE91F8FF7U, 0x3D8E9A72U}}},
+    /* 0x0B */
+    {{{0x2352B4FFU, 0x0B885E96U, 0xA6545766U, 0x6BE320D2U, 0xB9A59E72U, 0xBD22A444U, 0xCCC55D7DU, 0x2F2D32D6U}},
+     {{0xDDCEC70BU, 0xD86E4C4CU, 0x7A25C934U, 0x19CDB0E9U, 0x9CA97E28U, 0x542ADE06U, 0x746517F7U, 0x58C5927CU}}},
+    /* 0x0C */
+    {{{0x8D087091U, 0x24ABB0F0U, 0x51ADD8DEU, 0x6AA2C2EFU, 0xCC2A2134U, 0xC3E1CB4CU, 0x95589212U, 0x35631128U}},
+     {{0x7984344BU, 0x3BF17D2AU, 0xF8A142CCU, 0xBCB6F7B2U, 0x08EC9266U, 0xD6057D8AU, 0x2852405AU, 0x75C150D2U}}},
+    /* 0x0D */
+    {{{0xA9FEE73EU, 0xA8F88EB5U, 0x576EA39BU, 0x72A84174U, 0xE2692E7DU, 0x671FA0ADU, 0x96769F9EU, 0x25562885U}},
+     {{0xE850A6B0U, 0x254323BCU, 0xFFF6C89AU, 0x74B61C18U, 0xCFAE2690U, 0x2E7C563FU, 0x164AFB0FU, 0x2CF454B7U}}},
+    /* 0x0E */
+    {{{0x8F10F423U, 0xE312A561U, 0xF2B85DF4U, 0x59A1F1FFU, 0x41C48122U, 0x56C59919U, 0xAE3D175FU, 0x74953C1EU}},
+     {{0x8859244CU, 0x4D767FC7U, 0x719A4CC1U, 0xC486BC00U, 0xDF1C1787U, 0xDD282985U, 0xAE93C719U, 0x1143301AU}}},
+    /* 0x0F */
+    {{{0x1FAB7D71U, 0x7201A1D6U, 0x32CBBEE8U, 0x65931F54U, 0xDCB387EEU, 0x202955D3U, 0xC4678432U, 0xA5045BA5U}},
+     {{0xDCA85FF6U, 0xCFB5EE87U, 0xDFEC0F67U, 0xDD25A7C6U, 0x356A87C6U, 0xFEE47169U, 0xC3D7ECE9U, 0x20A8F159U}}},
+    /* 0x10 */
+    {{{0x070D3AABU, 0xE4AC8B33U, 0x9A2CD5E5U, 0x2643672BU, 0x1CFC9173U, 0x52EFF79BU, 0x90A7C13FU, 0x665CA49BU}},
+     {{0xB3EFB998U, 0x5A8DDA59U, 0x052F1341U, 0x8A5B922DU, 0x3CF9A530U, 0xAE9EBBABU, 0xF56DA4D7U, 0x35986E7BU}}},
+    /* 0x11 */
+    {{{0xBC0A70C0U, 0x21E07F9AU, 0x989A0182U, 0xECFDB3A2U, 0xE40E8125U, 0x360682C0U, 0x2F837F32U, 0x73A63795U}},
+     {{0x9C0D326BU, 0xF4EB8CEFU, 0xEBF4C7A5U, 0xEFB97FECU, 0xAF3D5D7EU, 0xF9352123U, 0x34E22AB1U, 0xB71EF4EFU}}},
+    /* 0x12 */
+    {{{0x0D488032U, 0xD6BD0D81U, 0x71F0B92EU, 0x1676DF99U, 0xB6D215ACU, 0xA7ACDCFCU, 0xCD0FF939U, 0x82461A26U}},
+     {{0xB635D2E5U, 0x827189C0U, 0xA92F1622U, 0x18F3B6DDU, 0x05CEF325U, 0x10D738AAU, 0x39BB0AA6U, 0x12C2A13FU}}},
+    /* 0x13 */
+    {{{0xB50B4E82U, 0x5F94D8DEU, 0x34BD93E9U, 0xBCD9144EU, 0x07C08623U, 0x61C33921U, 0x7E3DE8EEU, 0xEDEC947EU}},
+     {{0x2F21B202U, 0x9D2DA51DU, 0x96692A89U, 0xC0C885CDU, 0xA5E7309CU, 0x4A613462U, 0x0F28DEE6U, 0x22778855U}}},
+    /* 0x14 */
+    {{{0x7695447AU, 0x1FF0BD52U, 0x42AE2627U, 0x63534A4AU, 0xD0CC09F2U, 0xD96AF0DAU, 0x412D3E1AU, 0xB59EA545U}},
+     {{0x6A759072U, 0xD10518CFU, 0x10475DFDU, 0xFFEEC37CU, 0xB25089C4U, 0xACBC29CCU, 0x21B6D4EEU, 0xBF3DFC85U}}},
+    /* 0x15 */
+    {{{0x49388995U, 0x8F2EACFEU, 0x841BE9EDU, 0x000FC8D4U, 0x6955C290U, 0x2ED8085AU, 0x6D8E176FU, 0x1929CF60U}},
+     {{0xFD1A09DBU, 0x2EFD26A5U, 0x6CB626CDU, 0x58D767ADU, 0xB26C6E05U, 0x13A81B95U, 0x8F61832BU, 0x68FE6107U}}},
+    /* 0x16 */
+    {{{0x2D85C2F6U, 0x4AD7DE2EU, 0x510101A1U, 0xCD552FCBU, 0x02ACDABFU, 0x638D122BU, 0x50BFD921U, 0x117221E8U}},
+     {{0x99A99129U, 0x08571EE1U, 0xBA2F03A9U, 0xEBD046D1U, 0xA6F8A181U, 0x035ED7BAU, 0x3187C6F3U, 0x8AABF98DU}}},
+    /* 0x17 */
+    {{{0xE3AB5F4EU, 0xAF8E65CAU, 0x7561A69CU, 0x8B0B8B89U, 0xB17C1E66U, 0x37E83AA0U, 0xF8D80EDCU, 0xE894D84CU}},
+     {{0xCE514E22U, 0xF1E465E7U, 0xA72340EFU, 0xC7FA324CU, 0xE7370673U, 0x08297FCAU, 0xB119AE5EU, 0x4F799682U}}},
+    /* 0x18 */
+    {{{0xF180F206U, 0x014D6BD8U, 0x7AB44F55U, 0x56640C8BU, 0x93F9A5B8U, 0x9A39660DU, 0x959B68F1U, 0xCAC069E9U}},
+     {{0x208D9918U, 0x2BF6B65EU, 0x3F943291U, 0xB7E45DFBU, 0xD439C712U, 0xAD5770F0U, 0x7654D805U, 0xFEC635E1U}}},
+    /* 0x19 */
+    {{{0x3F031A88U, 0x37221CD1U, 0x0B5558D4U, 0xE4D53D2FU, 0xDAFC51CDU, 0x2EDE8E8FU, 0xA8A883EAU, 0xB587284CU}},
+     {{0x44FA5251U, 0xFA376740U, 0x5C5E3528U, 0x5E5E18F9U, 0x6E10B958U, 0x8AF51FACU, 0x2C429B30U, 0x09BE7903U}}},
+    /* 0x1A */
+    {{{0x7F29936DU, 0x7A468BA4U, 0x7CFB8176U, 0xACBBE365U, 0x4DB9CD5DU, 0xE892C10AU, 0xA1AADE8BU, 0xCB2F29D7U}},
+     {{0xEFFFCB14U, 0x3087EEF4U, 0x2AFE8F2EU, 0x92A7F3ECU, 0x136F29D2U, 0x199D89B8U, 0xB4836623U, 0x3131604EU}}},
+    /* 0x1B */
+    {{{0x31B5DF76U, 0xF5CCA5DAU, 0x76A4ABC0U, 0x94313186U, 0x1877C7C7U, 0x5DB8E6F7U, 0x6031AC99U, 0x3CE3F5F9U}},
+     {{0x7E7CEF80U, 0x585961D0U, 0xD424F16AU, 0x5ED6E841U, 0x56B16A49U, 0x18289CD0U, 0x2E5770FAU, 0x8008D03BU}}},
+    /* 0x1C */
+    {{{0x254E39DEU, 0xC8C2AF64U, 0x8582571CU, 0x783CEA73U, 0xA6EDD971U, 0x2F2F55F1U, 0xC86BF30AU, 0x7E00CC92U}},
+     {{0x47D7491FU, 0xA0DB7354U, 0xA5B12260U, 0xB3EB751CU, 0x297FB234U, 0x3BC39A23U, 0xB8B4BFE4U, 0xD1330C20U}}},
+    /* 0x1D */
+    {{{0x7824D53AU, 0xFB776AF0U, 0x422DEA35U, 0x04709096U, 0x5FEC3AC7U, 0x6F480B6BU, 0xE27EDDA4U, 0xDB2B1B62U}},
+     {{0xDA78B494U, 0x0BBA904CU, 0x91A147F7U, 0x37EF59B6U, 0x26A4730AU, 0xF8805177U, 0xA8AB368EU, 0xECC9D79AU}}},
+    /* 0x1E */
+    {{{0x85A4BD0EU, 0x628E05C1U, 0x00E244E8U, 0xEBF7B678U, 0x8B176EEBU, 0xF645947BU, 0x1641AB35U, 0xC92BF830U}},
+     {{0x21BE7A6FU, 0x7A039C1AU, 0x2FD4BD92U, 0x11E4354DU, 0x886FD224U, 0x42552422U, 0xC44CED37U, 0xDBF3194CU}}},
+    /* 0x1F */
+    {{{0xC56F6B04U, 0x832DA983U, 0x8EF098AEU, 0x7AAA84EBU, 0xA6A616A2U, 0x602E3EEFU, 0xB7B717A3U, 0xC2824DDCU}},
+     {{0xDDB0A2E9U, 0x19F50324U, 0x5BEDFBBDU, 0x04553A28U, 0xAA1AEE0AU, 0x37EA8B12U, 0x945959A1U, 0xC1844E79U}}},
+    /* 0x20 */
+    {{{0xE0F222C2U, 0x5043DEA7U, 0x72E65142U, 0x309D42ACU, 0x9216CD30U, 0x94FE9DDDU, 0x0F87FEECU, 0xD6539C7DU}},
+     {{0x432AC7D7U, 0x03C5A57CU, 0x327FDA10U, 0x72692CF0U, 0x280698DEU, 0xEC28C85FU, 0x7EC283B1U, 0x2331FB46U}}},
+    /* 0x21 */
+    {{{0x43248E67U, 0x651CFDEBU, 0xEE561DE8U, 0x2C3D72CEU, 0x443DAC8BU, 0xA48B8F33U, 0x7991F986U, 0xE6B042FEU}},
+     {{0xE810BCD2U, 0xD091636DU, 0xA97416D7U, 0xFC1E96AEU, 0x2892694DU, 0x2B6087CBU, 0x9985A628U, 0x0F8AC245U}}},
+    /* 0x22 */
+    {{{0x7F2326A2U, 0x54E90874U, 0xFA9E1131U, 0xCE43DD44U, 0xD3D2D948U, 0x4B2C740CU, 0xA86E8B07U, 0x9B0B126AU}},
+     {{0xB77F5AF2U, 0x228EF320U, 0xCA07661CU, 0x14FC8A01U, 0xD34F1A3AU, 0x1D72509EU, 0x29D9086EU, 0xD1690317U}}},
+    /* 0x23 */
+    {{{0x03C5FE33U, 0x13E44ACCU, 0x0105BBC6U, 0x13F4374EU, 0xCB4451B8U, 0x0CBA5018U, 0xFA29A4E1U, 0xA1A38E4AU}},
+     {{0xF4403917U, 0x063FB9A8U, 0x996EA7F2U, 0x7AFE108FU, 0xF93A1F87U, 0xEC252363U, 0x7E432609U, 0xC029C811U}}},
+    /* 0x24 */
+    {{{0x486E548EU, 0x25080C29U, 0x7868AB32U, 0xDAA41132U, 0xD61D1A3AU, 0x46891511U, 0x3EFC8FACU, 0xC87F3F53U}},
+     {{0xF3E31393U, 0x984F613FU, 0x7648F5D2U, 0x10BB15F6U, 0xDEFAA440U, 0xE4990F2BU, 0xDD51C31DU, 0xCE647F03U}}},
+    /* 0x25 */
+    {{{0x9C2C0ABFU, 0x3161EBDDU, 0xF497CF35U, 0x48B7EE7BU, 0x94DD9C97U, 0x9233E31DU, 0xC5D2988FU, 0x4AEF9A62U}},
+     {{0xA03E6456U, 0x89A54161U, 0xC1F02B47U, 0x9D25E003U, 0xC1857782U, 0x8784CDBFU, 0x0222B49CU, 0x7928CAFDU}}},
+    /* 0x26 */
+    {{{0xECF4EA23U, 0x5A591ABDU, 0x80BD9B8AU, 0xB2725E8AU, 0x29FF348BU, 0xF569679FU, 0x6F22536AU, 0xA28163D3U}},
+     {{0x21C43971U, 0x89E7A8F6U, 0xC4A09567U, 0x60CBE4A1U, 0x5928B03DU, 0x41046C8FU, 0xEF74A95AU, 0x646FEDA7U}}},
+    /* 0x27 */
+    {{{0x5D75D310U, 0x3AEF6BC0U, 0x82476E5CU, 0xF3E7F03CU, 0x8419B8A0U, 0x9DCF3D50U, 0xEAF07F07U, 0x221A3885U}},
+     {{0x37BDCB7DU, 0x16D533F3U, 0xBB49550DU, 0xD778066BU, 0x36C2600CU, 0xF6F45409U, 0xC1C61709U, 0x7544396FU}}},
+    /* 0x28 */
+    {{{0xDE08CD42U, 0xF79F556FU, 0xE13CADC8U, 0x7D0ABA1EU, 0xD4D81FEFU, 0x841D9DF6U, 0x602D2043U, 0x8F7AE1F2U}},
+     {{0xB57EE181U, 0x950C4DE4U, 0xC55CF490U, 0xFE51E045U, 0x1EFDD0A8U, 0xDB60B56AU, 0xBF0FA497U, 0x276BCCB3U}}},
+    /* 0x29 */
+    {{{0x19E5A603U, 0x7926625BU, 0xE1BF712BU, 0xF1B98E93U, 0xE33ABECCU, 0x933ECB52U, 0xF826619BU, 0x9EBFC506U}},
+     {{0xA1692C52U, 0xD2965F67U, 0xFC4F9564U, 0x8AC4012DU, 0x6739F003U, 0xA8AF5703U, 0xBC715E13U, 0x7DD2282DU}}},
+    /* 0x2A */
+    {{{0xCF2BB490U, 0x3EC01587U, 0x3F1EA428U, 0x5346082CU, 0x6739E506U, 0xF2C679E2U, 0x930C28E4U, 0xEAB710D6U}},
+     {{0xE043249AU, 0xE9947FF8U, 0xAD54B0E6U, 0x63640678U, 0x1854EAAFU, 0x8CDE4259U, 0x6B25BDCEU, 0xF1FEEAECU}}},
+    /* 0x2B */
+    {{{0x1BDD2AA2U, 0x49F7E899U, 0x34E3CAE9U, 0x88FD2735U, 0x82CBFEA2U, 0x5AC05101U, 0x4CF84578U, 0x324C9D41U}},
+     {{0x19F13061U, 0xA2423117U, 0x5F3B9932U, 0x69D67CF1U, 0xDDE2DFADU, 0x32ECDB3CU, 0xB916F7A6U, 0x2F74D995U}}},
+    /* 0x2C */
+    {{{0x3D14BC68U, 0x35F7ED42U, 0x45574F91U, 0x32F63A04U, 0x5E8801E7U, 0xD0410833U, 0x1C9C1462U, 0x63B6F13CU}},
+     {{0x9DC7201FU, 0x180DCBCDU, 0x360350DFU, 0xA07B5B2CU, 0x4236F5CCU, 0x2582B277U, 0xA7AB06B9U, 0x90163924U}}},
+    /* 0x2D */
+    {{{0x0767CDF2U, 0x35E751B5U, 0x9D8E2838U, 0x808372E6U, 0x646914D7U, 0xCBAD6B30U, 0x6C7B3CABU, 0x4EEEB1DEU}},
+     {{0x8C965004U, 0x3EF3AF96U, 0xD281920BU, 0xD162290FU, 0x181F811BU, 0x4626C313U, 0xBE61DD14U, 0x5FA42F4FU}}},
+    /* 0x2E */
+    {{{0xA185E98EU, 0x1F5A9C53U, 0xEA9E83C3U, 0x13C28277U, 0xB693A226U, 0xB566E4C0U, 0x01533E9EU, 0x2EA3F1C0U}},
+     {{0x6215A21FU, 0xB4DBCC33U, 0xCB4E98F0U, 0x7DF608C3U, 0xB4DD95DDU, 0x677DF928U, 0xEEED2934U, 0x4C1D7142U}}},
+    /* 0x2F */
+    {{{0x86A2EE12U, 0x30BF236CU, 0x05ECB4C0U, 0x74D5A127U, 0x1601CCA9U, 0x9EF43B0FU, 0xAC4DD202U, 0xBE1B1BF9U}},
+     {{0x17B6F93BU, 0x84943E47U, 0xCD5214B3U, 0x6F789757U, 0x7F313DFAU, 0x5E0DB1A9U, 0xECE0B72BU, 0x0515EFACU}}},
+    /* 0x30 */
+    {{{0xA78C3F8BU, 0x433A677CU, 0xF376A9C1U, 0x204A9FEAU, 0x44BAEADFU, 0xB6BFBEA4U, 0x2B48A3F4U, 0x5A43CAFDU}},
+     {{0x67D1D226U, 0xE25A7D0BU, 0xF6837985U, 0xB2115844U, 0xD87C2B88U, 0x8C9CCA3EU, 0x894772E1U, 0xECD4BC73U}}},
+    /* 0x31 */
+    {{{0x783490E7U, 0x368ABEC6U, 0xD925C359U, 0xF26DA8BDU, 0xE8FB0679U, 0xF9B643E5U, 0xB555D175U, 0x7AB803D9U}},
+     {{0x4EBAE595U, 0x1B405999U, 0xBA417A49U, 0x07FBBF25U, 0xC617957AU, 0x02D7CF1CU, 0x565C1FBBU, 0x79070EA5U}}},
+    /* 0x32 */
+    {{{0xD9B028FAU, 0x70194602U, 0x9FF06760U, 0x9C49969DU, 0x6AD27B42U, 0xBF4ADD81U, 0x8651524EU, 0x7D1F226DU}},
+     {{0xEECD7724U, 0xB0779B40U, 0x65938707U, 0xD3560772U, 0xD054B903U, 0xE3A61FE5U, 0x3365136BU, 0xD6F5A343U}}},
+    /* 0x33 */
+    {{{0xD2970FCFU, 0x25C87C76U, 0x4D5546A8U, 0x7C9F60A0U, 0x8DD8BF8CU, 0x7DAB072FU, 0xE8FF9F28U, 0x3D10907CU}},
+     {{0x34BB2A29U, 0xB08D6D0EU, 0xC3FCFDAFU, 0x5DFD4907U, 0x47123BA6U, 0xE4A2D4B1U, 0x42DE6D8DU, 0x6E9EEF0BU}}},
+    /* 0x34 */
+    {{{0xCBB55F9DU, 0x81255AF5U, 0x5328D39EU, 0x579F2705U, 0x3E5AE663U, 0xA7BFC917U, 0xA1246E42U, 0xE9B55D57U}},
+     {{0x75629188U, 0x240ECD94U, 0x457BD3C0U, 0x8748D297U, 0x373C361CU, 0x50E215EFU, 0x18C967B9U, 0xAF9D8A86U}}},
+    /* 0x35 */
+    {{{0x0A04143FU, 0x79A04104U, 0xC700C616U, 0x03F7410FU, 0x91108CA6U, 0xE8F2A3F2U, 0xF5AC679AU, 0xA26D67E8U}},
+     {{0xB83FBD9AU, 0xA15DBFEBU, 0x3A0B5587U, 0xF1AAEBD2U, 0xCE0EAD44U, 0x639A97DDU, 0x71D12EE0U, 0xF253B00CU}}},
+    /* 0x36 */
+    {{{0x9E35E57CU, 0x7BAECF4CU, 0x6786E3A5U, 0x522E26A1U, 0x8AF829A2U, 0x600B538BU, 0x2C6DE44AU, 0x19FA80B7U}},
+     {{0xAAF0FF52U, 0xB52364F0U, 0x6714587FU, 0x2E4BC21AU, 0xC245967DU, 0x401377A3U, 0xA23CF3EBU, 0x65178766U}}},
+    /* 0x37 */
+    {{{0x923AC000U, 0xC1C81838U, 0xC4ABC0EEU, 0x42021F02U, 0x47132A20U, 0xCDE3BC9AU, 0xC69F55FBU, 0x6F52A864U}},
+     {{0xDF89FF6AU, 0x0BDFD3E4U, 0xC88BD74EU, 0x244C943BU, 0x2612998BU, 0x649E0B53U, 0xD3413D4AU, 0xCE61EBC3U}}},
+    /* 0x38 */
+    {{{0x2CBA5A90U, 0xE3162904U, 0xDB6C224EU, 0xA72710AEU, 0xD87E44DBU, 0x51831390U, 0x48FE2EF3U, 0xA687DC98U}},
+     {{0x16A21CA9U, 0x857E9855U, 0xC9A7BC12U, 0xE3428D8EU, 0x12B044A2U, 0x16D3BCD0U, 0xE85F6704U, 0xE6FA0C69U}}},
+    /* 0x39 */
+    {{{0x8FD42692U, 0xE4CCA34BU, 0xE15F3ACFU, 0xC86D49A6U, 0xA6B18392U, 0xBFE1F263U, 0xDCD266F6U, 0x0664C933U}},
+     {{0x19399D88U, 0x86738CF5U, 0x749CE6BCU, 0x1CBCC8C3U, 0xC773B884U, 0x28171F7BU, 0x01ACF19EU, 0x306FC957U}}},
+    /* 0x3A */
+    {{{0xAFB6A419U, 0x0DA7A737U, 0x195FBC40U, 0x637FC26AU, 0x9C64E8E7U, 0x0FC8F876U, 0x208C0626U, 0x2A68579BU}},
+     {{0x8628ABC3U, 0x82E82310U, 0xAB23AE94U, 0xE4E09313U, 0xE5155CF1U, 0x66BF9ADBU, 0xE8A2DD0CU, 0x17909F6CU}}},
+    /* 0x3B */
+    {{{0x43D7AD31U, 0x767C3596U, 0x49CCEF62U, 0x7BA3A1AAU, 0x0242BF5AU, 0x5261C316U, 0x9EB82DFBU, 0x85F45219U}},
+     {{0x37B42E47U, 0x554CB382U, 0x4CF66133U, 0xC9771EC1U, 0x153905A3U, 0xDE70617AU, 0xBC61316DU, 0x2CAB26FCU}}},
+    /* 0x3C */
+    {{{0x75C10315U, 0x7DABABBDU, 0xA48DF64EU, 0x9A8FBE88U, 0xE1B8F912U, 0x2B076FE5U, 0xCCBD50DCU, 0x1A530CE9U}},
+     {{0x6647D225U, 0x47361AB7U, 0x4D636A15U, 0xF84E73BEU, 0x5904A2FAU, 0xD58FCAAFU, 0x38523A19U, 0x73747D4BU}}},
+    /* 0x3D */
+    {{{0xB6864CC0U, 0x6E6B0FB8U, 0xAB3B623CU, 0x5D8A0027U, 0x9A1CFC9CU, 0x5E666538U, 0x521E4FF3U, 0x816B19DEU}},
+     {{0x0BC447F8U, 0x56709AD0U, 0x8F1464D7U, 0x1D46CB1CU, 0xA949873DU, 0x49CEF820U, 0xD9D3E65FU, 0x02804692U}}},
+    /* 0x3E */
+    {{{0xAD8B5976U, 0x1AE0EA28U, 0x869458FBU, 0x4E9AD48EU, 0x96CFEDF8U, 0xE9437EC9U, 0x2AFA74D9U, 0xA4F924A2U}},
+     {{0xAAF797C0U, 0xCB5B1845U, 0xBA6F557FU, 0xE5D6DD0EU, 0x91DC2E7CU, 0xA1496FE6U, 0x8C179FC7U, 0xAD31EDACU}}},
+    /* 0x3F */
+    {{{0x44B06ED7U, 0xF9C5E9DEU, 0x4A597159U, 0x6CE7C4F7U, 0x833ACCB5U, 0xD02EC441U, 0x6296E8FCU, 0xF3020599U}},
+     {{0xC2AFBE06U, 0x7DF6C5C6U, 0x9C849B09U, 0xFF429DDAU, 0xF5DD78D6U, 0x42170166U, 0x830C388BU, 0x2403EA21U}}}
+};
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
@@ -0,0 +1,540 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file ccc_spake2p.c
+*
+* SPAKE2+ prover side of the CCC owner pairing certificate exchange, P-256.
+*
+*   Request: X  = x*G + w0*M
+*   Verify:  Y' = Y - w0*N,  Z = x*Y',  V = w1*Y'
+*            K  = SHA256(TT), Ka || Ke = K, K1 || K2 = HKDF(Ka, "ConfirmationKeys")
+*            M1 = CMAC(K1, X) is checked, M2 = CMAC(K2, Y) is returned
+*
+* w0/w1 are the scrypt outputs of the pairing password. scrypt is not run on the
+* keyfob; the verifier is provisioned in NVM with the "setcred" shell command
+* and applied by ccc_credentials, and the Request is answered with 6A80 until
+* it is (gAppCccDevCredentials_d aside).
+* With gAppCccStepTimes_d, each step logs its duration (TM time base) at debug
+* trace level.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "fsl_component_timer_manager.h"
+#include "FunctionLib.h"
+#include "RNG_Interface.h"
+#include "SecLib.h"
+#include "ble_general.h"
+#include "trace.h"
+#include "ccc_p256.h"
+#include "ccc_spake2p.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mcSpake2pInsRequest_c           (0x30U)
+#define mcSpake2pInsVerify_c            (0x32U)
+#define mcSpake2pApduHeaderSize_c       (5U)    /* CLA INS P1 P2 Lc */
+
+#define mcSpake2pTagX_c                 (0x50U)
+#define mcSpake2pTagY_c                 (0x52U)
+#define mcSpake2pTagM1_c                (0x57U)
+#define mcSpake2pTagM2_c                (0x58U)
+
+#define mcSpake2pSw1_c                  (0x90U)
+#define mcSpake2pSw2_c                  (0x00U)
+
+#define mcSpake2pMaxRngRetries_c        (8U)
+#define mcSpake2pLenFieldSize_c         (8U)
+
+#define mcSpake2pContext_c              "CCC-DK-SPAKE2+"
+#define mcSpake2pConfirmInfo_c          "ConfirmationKeys"
+
+/* len || data for Context, A, B, M, N, X, Y, Z, V, w0 */
+#define mcSpake2pTranscriptSize_c       ((10U * mcSpake2pLenFieldSize_c) + (sizeof(mcSpake2pContext_c) - 1U) + \
+                                         (6U * gP256PointSize_c) + gP256ScalarSize_c)
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+typedef struct spake2pContext_tag
+{
+    p256Int_t   x;                              /* Ephemeral scalar */
+    uint8_t     X[gP256PointSize_c];            /* Prover share, encoded */
+    uint8_t     Ke[gSpake2pKeySize_c];          /* Shared key, valid once confirmed */
+    bool_t      requestDone;
+    bool_t      confirmed;
+}spake2pContext_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static spake2pContext_t maSpake2pCtx[gAppMaxConnections_c];
+
+/* Scratch transcript, all steps run in the BLE application task */
+static uint8_t maSpake2pTranscript[mcSpake2pTranscriptSize_c];
+
+static p256Int_t mSpake2pW0;
+static p256Int_t mSpake2pW1;
+
+/* RFC 9382 P-256 M and N, uncompressed, for the transcript */
+static const uint8_t maSpake2pM[gP256PointSize_c] =
+{
+    0x04, 0x88, 0x6E, 0x2F, 0x97, 0xAC, 0xE4, 0x6E, 0x55, 0xBA, 0x9D, 0xD7, 0x24, 0x25, 0x79, 0xF2,
+    0x99, 0x3B, 0x64, 0xE1, 0x6E, 0xF3, 0xDC, 0xAB, 0x95, 0xAF, 0xD4, 0x97, 0x33, 0x3D, 0x8F, 0xA1,
+    0x2F, 0x5F, 0xF3, 0x55, 0x16, 0x3E, 0x43, 0xCE, 0x22, 0x4E, 0x0B, 0x0E, 0x65, 0xFF, 0x02, 0xAC,
+    0x8E, 0x5C, 0x7B, 0xE0, 0x94, 0x19, 0xC7, 0x85, 0xE0, 0xCA, 0x54, 0x7D, 0x55, 0xA1, 0x2E, 0x2D,
+    0x20,
+};
+
+static const uint8_t maSpake2pN[gP256PointSize_c] =
+{
+    0x04, 0xD8, 0xBB, 0xD6, 0xC6, 0x39, 0xC6, 0x29, 0x37, 0xB0, 0x4D, 0x99, 0x7F, 0x38, 0xC3, 0x77,
+    0x07, 0x19, 0xC6, 0x29, 0xD7, 0x01, 0x4D, 0x49, 0xA2, 0x4B, 0x4F, 0x98, 0xBA, 0xA1, 0x29, 0x2B,
+    0x49, 0x07, 0xD6, 0x0A, 0xA6, 0xBF, 0xAD, 0xE4, 0x50, 0x08, 0xA6, 0x36, 0x33, 0x7F, 0x51, 0x68,
+    0xC6, 0x4D, 0x9B, 0xD3, 0x60, 0x34, 0x80, 0x8C, 0xD5, 0x64, 0x49, 0x0B, 0x1E, 0x65, 0x6E, 0xDB,
+    0xE7,
+};
+
+static bool_t mSpake2pVerifierLoaded = FALSE;
+
+#if (gAppCccDevCredentials_d == 1)
+/* Development verifier, bench builds only */
+static const uint8_t maSpake2pDefaultW0[gP256ScalarSize_c] =
+{
+    0x81, 0x12, 0xE4, 0xD3, 0xCC, 0x93, 0x27, 0x91, 0xAA, 0x75, 0x69, 0x65, 0x2A, 0x0D, 0xF5, 0xAA,
+    0xDF, 0x57, 0x5F, 0x71, 0x93, 0xD6, 0xA7, 0xC1, 0xEC, 0x80, 0x74, 0xB8, 0xCB, 0xD0, 0xAF, 0x9B,
+};
+
+static const uint8_t maSpake2pDefaultW1[gP256ScalarSize_c] =
+{
+    0x97, 0x45, 0x71, 0x66, 0xB4, 0xBD, 0x11, 0x96, 0xF7, 0x3A, 0x05, 0x23, 0x8E, 0xDB, 0x95, 0xB7,
+    0x90, 0x4E, 0x6E, 0x04, 0x9B, 0x41, 0x94, 0xD9, 0xA2, 0xEC, 0xED, 0xAD, 0x67, 0xDE, 0xA2, 0xEB,
+};
+#endif /* gAppCccDevCredentials_d */
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static bool_t CCC_Spake2pVerifierReady(void);
+static uint32_t CCC_Spake2pAppend(uint32_t offset, const uint8_t *pData, uint32_t len);
+static void CCC_Spake2pHkdf(const uint8_t *pIkm, uint32_t ikmLen, uint8_t *pOkm);
+static bool_t CCC_Spake2pConstTimeEqual(const uint8_t *pA, const uint8_t *pB, uint32_t len);
+static const uint8_t* CCC_Spake2pFindTlv(const uint8_t *pData, uint16_t len, uint8_t tag, uint8_t valueLen);
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Provisions the SPAKE2+ verifier (w0, w1), big-endian, already reduced
+*               modulo the group order. Called by CCC_CredentialsLoad() at boot and
+*               by CCC_CredentialsSet(): the Request is rejected until then.
+*
+* \param[in]    pW0         w0, 32 bytes.
+* \param[in]    pW1         w1, 32 bytes.
+*
+* \return       gSpake2pSuccess_c or gSpake2pInvalidParameter_c.
+********************************************************************************** */
+spake2pResult_t CCC_Spake2pSetVerifier(const uint8_t *pW0, const uint8_t *pW1)
+{
+    spake2pResult_t result = gSpake2pInvalidParameter_c;
+    p256Int_t w0, w1;
+
+    if ((pW0 != NULL) && (pW1 != NULL))
+    {
+        P256_ScalarFromBytes(&w0, pW0);
+        P256_ScalarFromBytes(&w1, pW1);
+        if ((P256_ScalarIsValid(&w0) == TRUE) && (P256_ScalarIsValid(&w1) == TRUE))
+        {
+            mSpake2pW0 = w0;
+            mSpake2pW1 = w1;
+            mSpake2pVerifierLoaded = TRUE;
+            result = gSpake2pSuccess_c;
+        }
+    }
+    FLib_MemSet(&w0, 0x00, sizeof(w0));
+    FLib_MemSet(&w1, 0x00, sizeof(w1));
+    return result;
+}
+
+/*! *********************************************************************************
+* \brief        Handles the SPAKE2+ Request command and builds its response (X).
+*
+* \param[in]    deviceId    Peer device ID.
+* \param[in]    pApdu       Command APDU.
+* \param[in]    apduLen     Command APDU length.
+* \param[out]   pRsp        Response buffer, at least gSpake2pResponseSize_c bytes.
+* \param[out]   pRspLen     Response length.
+*
+* \return       gSpake2pSuccess_c or an error.
+********************************************************************************** */
+spake2pResult_t CCC_Spake2pHandleRequest(deviceId_t deviceId, const uint8_t *pApdu, uint16_t apduLen,
+                                         uint8_t *pRsp, uint16_t *pRspLen)
+{
+    spake2pResult_t result = gSpake2pSuccess_c;
+#if defined(gAppCccStepTimes_d) && (gAppCccStepTimes_d == 1)
+    uint64_t startTs = TM_GetTimestamp();
+#endif
+    spake2pContext_t *pCtx;
+    uint8_t rnd[gP256ScalarSize_c];
+    p256Point_t xG, w0M;
+    uint32_t retry;
+
+    if ((deviceId >= (deviceId_t)gAppMaxConnections_c) || (pApdu == NULL) || (pRsp == NULL) ||
+        (pRspLen == NULL) || (apduLen < 4U) || (pApdu[1] != mcSpake2pInsRequest_c))
+    {
+        result = gSpake2pInvalidParameter_c;
+    }
+    else if (CCC_Spake2pVerifierReady() == FALSE)
+    {
+        CCC_Spake2pReset(deviceId);
+        result = gSpake2pNoVerifier_c;
+    }
+    else
+    {
+        pCtx = &maSpake2pCtx[deviceId];
+        CCC_Spake2pReset(deviceId);
+
+        /* x uniform in [1, n-1]: reject out of range draws, stop on an RNG failure */
+        result = gSpake2pRngError_c;
+        for (retry = 0U; retry < mcSpake2pMaxRngRetries_c; retry++)
+        {
+            if (RNG_GetPseudoRandomData(rnd, (uint8_t)gP256ScalarSize_c, NULL) != (int16_t)gP256ScalarSize_c)
+            {
+                break;
+            }
+            P256_ScalarFromBytes(&pCtx->x, rnd);
+            if (P256_ScalarIsValid(&pCtx->x) == TRUE)
+            {
+                result = gSpake2pSuccess_c;
+                break;
+            }
+        }
+        FLib_MemSet(rnd, 0x00, sizeof(rnd));
+        if (result != gSpake2pSuccess_c)
+        {
+            CCC_Spake2pReset(deviceId);
+        }
+    }
+
+    if (result == gSpake2pSuccess_c)
+    {
+        P256_MulFixed(&xG, &pCtx->x, gaP256TableG);
+        P256_MulFixed(&w0M, &mSpake2pW0, gaP256TableM);
+        P256_PointAdd(&xG, &xG, &w0M);
+
+        if (P256_PointEncode(pCtx->X, &xG) == TRUE)
+        {
+            pRsp[0] = mcSpake2pTagX_c;
+            pRsp[1] = (uint8_t)gP256PointSize_c;
+            FLib_MemCpy(&pRsp[2], pCtx->X, gP256PointSize_c);
+            pRsp[2U + gP256PointSize_c] = mcSpake2pSw1_c;
+            pRsp[3U + gP256PointSize_c] = mcSpake2pSw2_c;
+            *pRspLen = (uint16_t)gSpake2pResponseSize_c;
+            pCtx->requestDone = TRUE;
+        }
+        else
+        {
+            result = gSpake2pRngError_c;
+        }
+#if defined(gAppCccStepTimes_d) && (gAppCccStepTimes_d == 1)
+        TRACE_DEBUG("SPAKE2+ Request: %u us", (uint32_t)(TM_GetTimestamp() - startTs));
+#endif
+    }
+    return result;
+}
+
+/*! *********************************************************************************
+* \brief        Handles the SPAKE2+ Verify command: derives the keys, checks the
+*               vehicle evidence and builds the response (M2).
+*
+* \param[in]    deviceId    Peer device ID.
+* \param[in]    pApdu       Command APDU.
+* \param[in]    apduLen     Command APDU length.
+* \param[out]   pRsp        Response buffer, at least gSpake2pVerifyRspSize_c bytes.
+* \param[out]   pRspLen     Response length.
+*
+* \return       gSpake2pSuccess_c or an error. The context is cleared on error.
+********************************************************************************** */
+spake2pResult_t CCC_Spake2pHandleVerify(deviceId_t deviceId, const uint8_t *pApdu, uint16_t apduLen,
+                                        uint8_t *pRsp, uint16_t *pRspLen)
+{
+    spake2pResult_t result = gSpake2pSuccess_c;
+#if defined(gAppCccStepTimes_d) && (gAppCccStepTimes_d == 1)
+    uint64_t startTs = TM_GetTimestamp();
+    uint64_t pointsTs = 0U;
+#endif
+    spake2pContext_t *pCtx = NULL;
+    const uint8_t *pY = NULL;
+    const uint8_t *pM1 = NULL;
+    p256Point_t Y, w0N;
+    p256PointTable_t table;
+    uint8_t Z[gP256PointSize_c];
+    uint8_t V[gP256PointSize_c];
+    uint8_t w0[gP256ScalarSize_c];
+    uint8_t K[SHA256_HASH_SIZE];
+    uint8_t confirmKeys[SHA256_HASH_SIZE];
+    uint8_t mac[gSpake2pKeySize_c];
+    uint32_t offset;
+
+    if ((deviceId >= (deviceId_t)gAppMaxConnections_c) || (pApdu == NULL) || (pRsp == NULL) ||
+        (pRspLen == NULL) || (apduLen <= mcSpake2pApduHeaderSize_c) || (pApdu[1] != mcSpake2pInsVerify_c))
+    {
+        result = gSpake2pInvalidParameter_c;
+    }
+    else if (maSpake2pCtx[deviceId].requestDone == FALSE)
+    {
+        result = gSpake2pInvalidState_c;
+    }
+    else
+    {
+        pCtx = &maSpake2pCtx[deviceId];
+        pY = CCC_Spake2pFindTlv(&pApdu[mcSpake2pApduHeaderSize_c], apduLen - mcSpake2pApduHeaderSize_c,
+                                mcSpake2pTagY_c, (uint8_t)gP256PointSize_c);
+        pM1 = CCC_Spake2pFindTlv(&pApdu[mcSpake2pApduHeaderSize_c], apduLen - mcSpake2pApduHeaderSize_c,
+                                 mcSpake2pTagM1_c, (uint8_t)gSpake2pKeySize_c);
+        if ((pY == NULL) || (pM1 == NULL))
+        {
+            result = gSpake2pInvalidParameter_c;
+        }
+        else if (P256_PointDecode(&Y, pY) == FALSE)
+        {
+            result = gSpake2pInvalidPoint_c;
+        }
+        else
+        {
+            /* Y' = Y - w0*N */
+            P256_MulFixed(&w0N, &mSpake2pW0, gaP256TableN);
+            P256_PointNegate(&w0N, &w0N);
+            P256_PointAdd(&Y, &Y, &w0N);
+
+            /* Z = x*Y', V = w1*Y', sharing the window table of Y' */
+            P256_PrepareTable(&table, &Y);
+            P256_MulTable(&w0N, &pCtx->x, &table);
+            if (P256_PointEncode(Z, &w0N) == FALSE)
+            {
+                result = gSpake2pInvalidPoint_c;
+            }
+            P256_MulTable(&w0N, &mSpake2pW1, &table);
+            if (P256_PointEncode(V, &w0N) == FALSE)
+            {
+                result = gSpake2pInvalidPoint_c;
+            }
+#if defined(gAppCccStepTimes_d) && (gAppCccStepTimes_d == 1)
+            pointsTs = TM_GetTimestamp();
+#endif
+        }
+    }
+
+    if ((result == gSpake2pSuccess_c) && (pCtx != NULL))
+    {
+        /* TT = Context || A || B || M || N || X || Y || Z || V || w0 */
+        P256_ScalarToBytes(w0, &mSpake2pW0);
+        offset = CCC_Spake2pAppend(0U, (const uint8_t *)mcSpake2pContext_c, sizeof(mcSpake2pContext_c) - 1U);
+        offset = CCC_Spake2pAppend(offset, NULL, 0U);
+        offset = CCC_Spake2pAppend(offset, NULL, 0U);
+        offset = CCC_Spake2pAppend(offset, maSpake2pM, gP256PointSize_c);
+        offset = CCC_Spake2pAppend(offset, maSpake2pN, gP256PointSize_c);
+        offset = CCC_Spake2pAppend(offset, pCtx->X, gP256PointSize_c);
+        offset = CCC_Spake2pAppend(offset, pY, gP256PointSize_c);
+        offset = CCC_Spake2pAppend(offset, Z, gP256PointSize_c);
+        offset = CCC_Spake2pAppend(offset, V, gP256PointSize_c);
+        offset = CCC_Spake2pAppend(offset, w0, gP256ScalarSize_c);
+        SHA256_Hash(maSpake2pTranscript, offset, K);
+
+        /* Ka = K[0..15], Ke = K[16..31]; K1 || K2 = HKDF(Ka) */
+        CCC_Spake2pHkdf(K, gSpake2pKeySize_c, confirmKeys);
+
+        AES_128_CMAC(pCtx->X, gP256PointSize_c, confirmKeys, mac);
+        if (CCC_Spake2pConstTimeEqual(mac, pM1, gSpake2pKeySize_c) == FALSE)
+        {
+            result = gSpake2pVerifyFailed_c;
+        }
+        else
+        {
+            pRsp[0] = mcSpake2pTagM2_c;
+            pRsp[1] = (uint8_t)gSpake2pKeySize_c;
+            AES_128_CMAC(pY, gP256PointSize_c, &confirmKeys[gSpake2pKeySize_c], &pRsp[2]);
+            pRsp[2U + gSpake2pKeySize_c] = mcSpake2pSw1_c;
+            pRsp[3U + gSpake2pKeySize_c] = mcSpake2pSw2_c;
+            *pRspLen = (uint16_t)gSpake2pVerifyRspSize_c;
+
+            FLib_MemCpy(pCtx->Ke, &K[gSpake2pKeySize_c], gSpake2pKeySize_c);
+            pCtx->confirmed = TRUE;
+        }
+#if defined(gAppCccStepTimes_d) && (gAppCccStepTimes_d == 1)
+        TRACE_DEBUG("SPAKE2+ Verify: points %u us, keys %u us",
+                    (uint32_t)(pointsTs - startTs), (uint32_t)(TM_GetTimestamp() - pointsTs));
+#endif
+
+        FLib_MemSet(maSpake2pTranscript, 0x00, sizeof(maSpake2pTranscript));
+        FLib_MemSet(w0, 0x00, sizeof(w0));
+        FLib_MemSet(K, 0x00, sizeof(K));
+        FLib_MemSet(confirmKeys, 0x00, sizeof(confirmKeys));
+        FLib_MemSet(&table, 0x00, sizeof(table));
+    }
+
+    if ((result != gSpake2pSuccess_c) && (pCtx != NULL))
+    {
+        CCC_Spake2pReset(deviceId);
+    }
+    return result;
+}
+
+/*! *********************************************************************************
+* \brief        Returns the confirmed session key Ke of a peer.
+*
+* \param[in]    deviceId    Peer device ID.
+*
+* \return       gSpake2pKeySize_c bytes, NULL if the exchange is not confirmed.
+********************************************************************************** */
+const uint8_t* CCC_Spake2pGetSessionKey(deviceId_t deviceId)
+{
+    const uint8_t *pKey = NULL;
+
+    if ((deviceId < (deviceId_t)gAppMaxConnections_c) && (maSpake2pCtx[deviceId].confirmed == TRUE))
+    {
+        pKey = maSpake2pCtx[deviceId].Ke;
+    }
+    return pKey;
+}
+
+/*! *********************************************************************************
+* \brief        Wipes the SPAKE2+ state of a peer (disconnection, failure).
+*
+* \param[in]    deviceId    Peer device ID.
+********************************************************************************** */
+void CCC_Spake2pReset(deviceId_t deviceId)
+{
+    if (deviceId < (deviceId_t)gAppMaxConnections_c)
+    {
+        FLib_MemSet(&maSpake2pCtx[deviceId], 0x00, sizeof(spake2pContext_t));
+    }
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Tells whether a verifier is provisioned, loading the development one
+*               in bench builds.
+********************************************************************************** */
+static bool_t CCC_Spake2pVerifierReady(void)
+{
+#if (gAppCccDevCredentials_d == 1)
+    if (mSpake2pVerifierLoaded == FALSE)
+    {
+        TRACE_WARNING("SPAKE2+: development verifier in use.");
+        (void)CCC_Spake2pSetVerifier(maSpake2pDefaultW0, maSpake2pDefaultW1);
+    }
+#endif /* gAppCccDevCredentials_d */
+    return mSpake2pVerifierLoaded;
+}
+
+/*! *********************************************************************************
+* \brief        Appends len (8 bytes, little-endian) || data to the transcript.
+*
+* \return       New transcript length.
+********************************************************************************** */
+static uint32_t CCC_Spake2pAppend(uint32_t offset, const uint8_t *pData, uint32_t len)
+{
+    uint32_t i;
+
+    for (i = 0U; i < mcSpake2pLenFieldSize_c; i++)
+    {
+        maSpake2pTranscript[offset + i] = (i < 4U) ? (uint8_t)(len >> (8U * i)) : 0U;
+    }
+    offset += mcSpake2pLenFieldSize_c;
+    if (len != 0U)
+    {
+        FLib_MemCpy(&maSpake2pTranscript[offset], pData, len);
+    }
+    return offset + len;
+}
+
+/*! *********************************************************************************
+* \brief        HKDF-SHA256 with empty salt and "ConfirmationKeys" info, 32 bytes out.
+********************************************************************************** */
+static void CCC_Spake2pHkdf(const uint8_t *pIkm, uint32_t ikmLen, uint8_t *pOkm)
+{
+    const uint8_t salt[SHA256_HASH_SIZE] = {0U};
+    uint8_t prk[SHA256_HASH_SIZE];
+    uint8_t info[sizeof(mcSpake2pConfirmInfo_c)];
+
+    /* Extract */
+    HMAC_SHA256(salt, SHA256_HASH_SIZE, pIkm, ikmLen, prk);
+
+    /* Expand, one block: T(1) = HMAC(PRK, info || 0x01) */
+    FLib_MemCpy(info, mcSpake2pConfirmInfo_c, sizeof(mcSpake2pConfirmInfo_c) - 1U);
+    info[sizeof(mcSpake2pConfirmInfo_c) - 1U] = 0x01U;
+    HMAC_SHA256(prk, SHA256_HASH_SIZE, info, sizeof(info), pOkm);
+
+    FLib_MemSet(prk, 0x00, sizeof(prk));
+}
+
+/*! *********************************************************************************
+* \brief        Compares two buffers without early exit.
+********************************************************************************** */
+static bool_t CCC_Spake2pConstTimeEqual(const uint8_t *pA, const uint8_t *pB, uint32_t len)
+{
+    uint8_t diff = 0U;
+    uint32_t i;
+
+    for (i = 0U; i < len; i++)
+    {
+        diff |= pA[i] ^ pB[i];
+    }
+    return (bool_t)(diff == 0U);
+}
+
+/*! *********************************************************************************
+* \brief        Finds a one-byte tag, one-byte length TLV with the expected length.
+*
+* \return       Pointer to the value, NULL if not found.
+********************************************************************************** */
+static const uint8_t* CCC_Spake2pFindTlv(const uint8_t *pData, uint16_t len, uint8_t tag, uint8_t valueLen)
+{
+    const uint8_t *pValue = NULL;
+    uint16_t offset = 0U;
+
+    while (((uint32_t)offset + 2U) <= len)
+    {
+        uint8_t tlvLen = pData[offset + 1U];
+
+        if (((uint32_t)offset + 2U + tlvLen) > len)
+        {
+            break;
+        }
+        if ((pData[offset] == tag) && (tlvLen == valueLen))
+        {
+            pValue = &pData[offset + 2U];
+            break;
+        }
+        offset += (uint16_t)(2U + tlvLen);
+    }
+    return pValue;
+}
+
+/*! *********************************************************************************
+* @}
+********************************************************************************** */
@@ -0,0 +1,86 @@
+/*! *********************************************************************************
+* \addtogroup Digital Key Device Application
+* @{
+********************************************************************************** */
+/*! *********************************************************************************
+* \file ccc_spake2p.h
+*
+* SPAKE2+ (P-256, SHA-256, HKDF, CMAC) prover side of the CCC owner pairing
+* certificate exchange.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef CCC_SPAKE2P_H
+#define CCC_SPAKE2P_H
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "ble_general.h"
+#include "ccc_p256.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+/*! Use the development verifier when none was provisioned with "setcred w0"
+    and "setcred w1" (see ccc_credentials.h), for bench builds only: the
+    SPAKE2+ Request is rejected otherwise. Redefine it in the app_preinclude.h file */
+#ifndef gAppCccDevCredentials_d
+#define gAppCccDevCredentials_d         0
+#endif
+
+#define gSpake2pKeySize_c               (16U)   /* Ke, K1, K2, CMAC */
+
+/* SPAKE2+ Response: 50 41 X[65] 90 00 */
+#define gSpake2pResponseSize_c          (2U + gP256PointSize_c + 2U)
+/* SPAKE2+ Verify response: 58 10 M2[16] 90 00 */
+#define gSpake2pVerifyRspSize_c         (2U + gSpake2pKeySize_c + 2U)
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+typedef enum spake2pResult_tag
+{
+    gSpake2pSuccess_c = 0,
+    gSpake2pInvalidParameter_c,     /*!< Bad device ID, length or APDU format */
+    gSpake2pInvalidState_c,         /*!< Verify received before Request */
+    gSpake2pInvalidPoint_c,         /*!< Y not on the curve */
+    gSpake2pRngError_c,             /*!< Ephemeral scalar could not be drawn */
+    gSpake2pVerifyFailed_c,         /*!< Vehicle evidence M1 mismatch */
+    gSpake2pNoVerifier_c,           /*!< No verifier provisioned */
+}spake2pResult_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+spake2pResult_t CCC_Spake2pSetVerifier(const uint8_t *pW0, const uint8_t *pW1);
+spake2pResult_t CCC_Spake2pHandleRequest(deviceId_t deviceId, const uint8_t *pApdu, uint16_t apduLen,
+                                         uint8_t *pRsp, uint16_t *pRspLen);
+spake2pResult_t CCC_Spake2pHandleVerify(deviceId_t deviceId, const uint8_t *pApdu, uint16_t apduLen,
+                                        uint8_t *pRsp, uint16_t *pRspLen);
+const uint8_t* CCC_Spake2pGetSessionKey(deviceId_t deviceId);
+void CCC_Spake2pReset(deviceId_t deviceId);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CCC_SPAKE2P_H */
+
+/*! *********************************************************************************
+ * @}
+ ********************************************************************************** */
@@ -132,7 +132,7 @@ static void App_AdvertisingCallback (gapAdvertisingEvent_t* pAdvertisingEvent)
 {
     appMsgFromHost_t *pMsgIn = NULL;
 
-    pMsgIn = MSG_Alloc(sizeof(uint32_t) + sizeof(gapAdvertisingEvent_t));
+    pMsgIn = MSG_Alloc((uint32_t)&(pMsgIn->msgData) + sizeof(gapAdvertisingEvent_t));
 
     if (pMsgIn == NULL)
     {
@@ -144,10 +144,7 @@ static void App_AdvertisingCallback (gapAdvertisingEvent_t* pAdvertisingEvent)
     pMsgIn->msgData.advMsg.eventData = pAdvertisingEvent->eventData;
 
     /* Put message in the Host Stack to App queue */
-    (void)MSG_Queue(&mHostAppInputQueue, pMsgIn);
-
-    /* Signal application */
-    (void)OSA_EventSet(mAppEvent, gAppEvtMsgFromHostStack_c);
+    App_PostHostMessage(pMsgIn);
 }
 
 /*! *********************************************************************************
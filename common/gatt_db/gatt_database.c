@@ -43,6 +43,7 @@
 #include "gatt_db_macros.h"
 #include "gatt_db_x_macros.h"
 #include "gatt_db_handles.h"
+#include <stddef.h>
 #endif /* gGattDbDynamic_d */
 
 /************************************************************************************
@@ -74,6 +75,13 @@ typedef struct sizeCounterStruct_tag {
 #define localGattDbAttributeCount_d  ((sizeof(sizeCounterStruct_t))/4U)
 uint16_t gGattDbAttributeCount_c;
 
+/*! Handle to index table, built at compile time: the entry of a handle is the
+    index of its attribute plus one, 0 if no attribute has it. Handles are the
+    gatt_db.h line numbers, so the table holds one entry per line. */
+static const uint16_t static_gattDbHandleIndex[] = {
+#include "gatt_index_x.h"
+};
+
 #else /* gGattDbDynamic_d */
 gattDbAttribute_t*  gattDatabase;
 uint16_t            gGattDbAttributeCount_c;
@@ -157,9 +165,21 @@ bleResult_t GattDb_Deinit(void)
 *
 *\return        uint16_t    The index of the given attribute in the database or
 *                           gGattDbInvalidHandleIndex_d.
+*
+*\remarks       One table read for the static database, a backward scan for the
+*               dynamic one.
 ********************************************************************************** */
 uint16_t GattDb_GetIndexOfHandle(uint16_t handle)
 {
+#if !gGattDbDynamic_d
+    uint16_t result = gGattDbInvalidHandleIndex_d;
+
+    if ((handle < NumberOfElements(static_gattDbHandleIndex)) && (static_gattDbHandleIndex[handle] != 0U))
+    {
+        result = static_gattDbHandleIndex[handle] - 1U;
+    }
+    return result;
+#else /* gGattDbDynamic_d */
     uint16_t init = (handle >= gGattDbAttributeCount_c) ?
                     (gGattDbAttributeCount_c - 1U) : handle;
     for (uint16_t j = init; j != 0xFFFFU && gattDatabase[j].handle >= handle; j--)
@@ -170,6 +190,7 @@ uint16_t GattDb_GetIndexOfHandle(uint16_t handle)
         }
     }
     return gGattDbInvalidHandleIndex_d;
+#endif /* gGattDbDynamic_d */
 }
 
 /*! *********************************************************************************
@@ -222,29 +243,25 @@ bleResult_t GattDb_FindServiceRange
 )
 {
     bleResult_t result = gGattDbInvalidHandle_c;
+    uint32_t j = GattDb_GetIndexOfHandle(serviceHandle);
 
-    for (uint32_t j = 0U; j < gGattDbAttributeCount_c; j++)
+    /* Only the service's own attributes are scanned, up to the next declaration */
+    if ((j != gGattDbInvalidHandleIndex_d) &&
+        (gattDatabase[j].uuidType == (uint16_t)gBleUuidType16_c) &&
+        BleSig_IsServiceDeclarationUuid16(gattDatabase[j].uuid))
     {
-        if (gattDatabase[j].handle == serviceHandle)
+        *pOutStartIndex = (uint16_t)j;
+        uint32_t k;
+        for (k = j + 1U; k < gGattDbAttributeCount_c; k++)
         {
-            if ((gattDatabase[j].uuidType == (uint16_t)gBleUuidType16_c) &&
-                BleSig_IsServiceDeclarationUuid16(gattDatabase[j].uuid))
+            if ((gattDatabase[k].uuidType == (uint16_t)gBleUuidType16_c) &&
+                BleSig_IsServiceDeclarationUuid16(gattDatabase[k].uuid))
             {
-                *pOutStartIndex = (uint16_t)j;
-                uint32_t k;
-                for (k = j + 1U; k < gGattDbAttributeCount_c; k++)
-                {
-                    if ((gattDatabase[k].uuidType == (uint16_t)gBleUuidType16_c) &&
-                        BleSig_IsServiceDeclarationUuid16(gattDatabase[k].uuid))
-                    {
-                        break;
-                    }
-                }
-                *pOutAttributeCount = (uint16_t)(k - j);
-                result = gBleSuccess_c;
                 break;
             }
         }
+        *pOutAttributeCount = (uint16_t)(k - j);
+        result = gBleSuccess_c;
     }
     return result;
 }
@@ -475,6 +475,31 @@
 
 #define INCLUDE_MACRO_ENUM(name) TOKEN_PASTE_LAYER_2(name,__LINE__) = HANDLE,
 
+
+/*
+* Macros for the handle to index table
+*  - the offset of an attribute in the size counting structure is its index
+*  - the index is stored plus one, 0 marks a handle without attribute
+*/
+
+#define UNIVERSAL_MACRO_INDEX(name) \
+    [name] = (uint16_t)((offsetof(sizeCounterStruct_t, name##_long) / 4U) + 1U),
+
+#define INCLUDE_MACRO_INDEX(name) \
+    [TOKEN_PASTE_LAYER_2(name,__LINE__)] = \
+        (uint16_t)((offsetof(sizeCounterStruct_t, TOKEN_PASTE_LAYER_2(name##_long,__LINE__)) / 4U) + 1U),
+
+/*
+* Application write bindings, after a VALUE on its gatt_db.h line (handles are
+* line numbers): what a client write of the value sets. Empty in every
+* expansion but gatt_write_x.h.
+*/
+#define GATT_WRITE_PARAM(name, id)
+#define GATT_WRITE_COUNTER(name, id)
+#define GATT_WRITE_KEY(name, id, size)
+#define GATT_WRITE_RESET(name)
+#define GATT_WRITE_PARAMS_TLV(name)
+
 #endif /* GATT_DB_MACROS_H */
 
 /*! *********************************************************************************
@@ -108,4 +108,27 @@
 #define XENUM_DESCRIPTOR_UUID128(name, uuid, permissions, size, ...)                    UNIVERSAL_MACRO_ENUM(name)
 #define XENUM_CHARACTERISTIC_AGGREGATE(name, uuid, permissions, size, ...)              UNIVERSAL_MACRO_ENUM(name)
 
+#define XINDEX_PRIMARY_SERVICE(name, uuid)                                              UNIVERSAL_MACRO_INDEX(name)
+#define XINDEX_PRIMARY_SERVICE_UUID32(name, uuid32)                                     UNIVERSAL_MACRO_INDEX(name)
+#define XINDEX_PRIMARY_SERVICE_UUID128(name, uuid128)                                   UNIVERSAL_MACRO_INDEX(name)
+#define XINDEX_SECONDARY_SERVICE(name, uuid)                                            UNIVERSAL_MACRO_INDEX(name)
+#define XINDEX_SECONDARY_SERVICE_UUID32(name, uuid32)                                   UNIVERSAL_MACRO_INDEX(name)
+#define XINDEX_SECONDARY_SERVICE_UUID128(name, uuid128)                                 UNIVERSAL_MACRO_INDEX(name)
+#define XINDEX_INCLUDE(service_attribute_handle)                                        INCLUDE_MACRO_INDEX(include##service_attribute_handle)
+#define XINDEX_INCLUDE_CUSTOM(service_attribute_handle)                                 INCLUDE_MACRO_INDEX(include##service_attribute_handle)
+#define XINDEX_CHARACTERISTIC(name, uuid, properties)                                   UNIVERSAL_MACRO_INDEX(name)
+#define XINDEX_CHARACTERISTIC_UUID32(name, uuid32, properties)                          UNIVERSAL_MACRO_INDEX(name)
+#define XINDEX_CHARACTERISTIC_UUID128(name, uuid128, properties)                        UNIVERSAL_MACRO_INDEX(name)
+#define XINDEX_VALUE(name, uuid, permissions, size, ...)                                UNIVERSAL_MACRO_INDEX(name)
+#define XINDEX_VALUE_UUID32(name, uuid32, permissions, size, ...)                       UNIVERSAL_MACRO_INDEX(name)
+#define XINDEX_VALUE_UUID128(name, uuid128, permissions, size, ...)                     UNIVERSAL_MACRO_INDEX(name)
+#define XINDEX_VALUE_VARLEN(name, uuid, permissions, maxSize, initSize, ...)            UNIVERSAL_MACRO_INDEX(name)
+#define XINDEX_VALUE_UUID32_VARLEN(name, uuid32, permissions, maxSize, initSize, ...)   UNIVERSAL_MACRO_INDEX(name)
+#define XINDEX_VALUE_UUID128_VARLEN(name, uuid128, permissions, maxSize, initSize, ...) UNIVERSAL_MACRO_INDEX(name)
+#define XINDEX_CCCD(name)                                                               UNIVERSAL_MACRO_INDEX(name)
+#define XINDEX_DESCRIPTOR(name, uuid, permissions, size, ...)                           UNIVERSAL_MACRO_INDEX(name)
+#define XINDEX_DESCRIPTOR_UUID32(name, uuid, permissions, size, ...)                    UNIVERSAL_MACRO_INDEX(name)
+#define XINDEX_DESCRIPTOR_UUID128(name, uuid, permissions, size, ...)                   UNIVERSAL_MACRO_INDEX(name)
+#define XINDEX_CHARACTERISTIC_AGGREGATE(name, uuid, permissions, size, ...)             UNIVERSAL_MACRO_INDEX(name)
+
 #endif /* GATT_DB_X_MACROS_H */
@@ -0,0 +1,62 @@
+/*! *********************************************************************************
+* Copyright (c) 2014, Freescale Semiconductor, Inc.
+* Copyright 2016-2020 NXP
+* All rights reserved.
+*
+* \file
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef GATT_INDEX_X_H
+#define GATT_INDEX_X_H
+
+#define PRIMARY_SERVICE                         XINDEX_PRIMARY_SERVICE
+#define PRIMARY_SERVICE_UUID32                  XINDEX_PRIMARY_SERVICE_UUID32
+#define PRIMARY_SERVICE_UUID128                 XINDEX_PRIMARY_SERVICE_UUID128
+#define SECONDARY_SERVICE                       XINDEX_SECONDARY_SERVICE
+#define SECONDARY_SERVICE_UUID32                XINDEX_SECONDARY_SERVICE_UUID32
+#define SECONDARY_SERVICE_UUID128               XINDEX_SECONDARY_SERVICE_UUID128
+#define INCLUDE                                 XINDEX_INCLUDE
+#define INCLUDE_CUSTOM                          XINDEX_INCLUDE_CUSTOM
+#define CHARACTERISTIC                          XINDEX_CHARACTERISTIC
+#define CHARACTERISTIC_UUID32                   XINDEX_CHARACTERISTIC_UUID32
+#define CHARACTERISTIC_UUID128                  XINDEX_CHARACTERISTIC_UUID128
+#define VALUE                                   XINDEX_VALUE
+#define VALUE_UUID32                            XINDEX_VALUE_UUID32
+#define VALUE_UUID128                           XINDEX_VALUE_UUID128
+#define VALUE_VARLEN                            XINDEX_VALUE_VARLEN
+#define VALUE_UUID32_VARLEN                     XINDEX_VALUE_UUID32_VARLEN
+#define VALUE_UUID128_VARLEN                    XINDEX_VALUE_UUID128_VARLEN
+#define CCCD                                    XINDEX_CCCD
+#define DESCRIPTOR                              XINDEX_DESCRIPTOR
+#define DESCRIPTOR_UUID32                       XINDEX_DESCRIPTOR
+#define DESCRIPTOR_UUID128                      XINDEX_DESCRIPTOR
+#define CHARACTERISTIC_AGGREGATE                XINDEX_CHARACTERISTIC_AGGREGATE
+
+#include "gatt_db.h"
+
+#undef PRIMARY_SERVICE
+#undef PRIMARY_SERVICE_UUID32
+#undef PRIMARY_SERVICE_UUID128
+#undef SECONDARY_SERVICE
+#undef SECONDARY_SERVICE_UUID32
+#undef SECONDARY_SERVICE_UUID128
+#undef INCLUDE
+#undef INCLUDE_CUSTOM
+#undef CHARACTERISTIC
+#undef CHARACTERISTIC_UUID32
+#undef CHARACTERISTIC_UUID128
+#undef VALUE
+#undef VALUE_UUID32
+#undef VALUE_UUID128
+#undef VALUE_VARLEN
+#undef VALUE_UUID32_VARLEN
+#undef VALUE_UUID128_VARLEN
+#undef CCCD
+#undef DESCRIPTOR
+#undef DESCRIPTOR_UUID32
+#undef DESCRIPTOR_UUID128
+#undef CHARACTERISTIC_AGGREGATE
+
+#endif /* GATT_INDEX_X_H */
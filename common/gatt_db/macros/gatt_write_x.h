@@ -0,0 +1,87 @@
+/*! *********************************************************************************
+* Copyright (c) 2014, Freescale Semiconductor, Inc.
+* Copyright 2016-2020 NXP
+* All rights reserved.
+*
+* \file
+*
+* Expands the application write bindings of gatt_db.h (GATT_WRITE_*) into the
+* XWRITE_* macros of the includer, one designated initializer per bound value.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef GATT_WRITE_X_H
+#define GATT_WRITE_X_H
+
+#define PRIMARY_SERVICE(name, uuid)
+#define PRIMARY_SERVICE_UUID32(name, uuid32)
+#define PRIMARY_SERVICE_UUID128(name, uuid128)
+#define SECONDARY_SERVICE(name, uuid)
+#define SECONDARY_SERVICE_UUID32(name, uuid32)
+#define SECONDARY_SERVICE_UUID128(name, uuid128)
+#define INCLUDE(service_attribute_handle)
+#define INCLUDE_CUSTOM(service_attribute_handle)
+#define CHARACTERISTIC(name, uuid, properties)
+#define CHARACTERISTIC_UUID32(name, uuid32, properties)
+#define CHARACTERISTIC_UUID128(name, uuid128, properties)
+#define VALUE(name, uuid, permissions, size, ...)
+#define VALUE_UUID32(name, uuid32, permissions, size, ...)
+#define VALUE_UUID128(name, uuid128, permissions, size, ...)
+#define VALUE_VARLEN(name, uuid, permissions, maxSize, initSize, ...)
+#define VALUE_UUID32_VARLEN(name, uuid32, permissions, maxSize, initSize, ...)
+#define VALUE_UUID128_VARLEN(name, uuid128, permissions, maxSize, initSize, ...)
+#define CCCD(name)
+#define DESCRIPTOR(name, uuid, permissions, size, ...)
+#define DESCRIPTOR_UUID32(name, uuid32, permissions, size, ...)
+#define DESCRIPTOR_UUID128(name, uuid128, permissions, size, ...)
+#define CHARACTERISTIC_AGGREGATE(name, uuid, permissions, size, ...)
+
+#undef GATT_WRITE_PARAM
+#undef GATT_WRITE_COUNTER
+#undef GATT_WRITE_KEY
+#undef GATT_WRITE_RESET
+#undef GATT_WRITE_PARAMS_TLV
+#define GATT_WRITE_PARAM(name, id)              XWRITE_PARAM(name, id)
+#define GATT_WRITE_COUNTER(name, id)            XWRITE_COUNTER(name, id)
+#define GATT_WRITE_KEY(name, id, size)          XWRITE_KEY(name, id, size)
+#define GATT_WRITE_RESET(name)                  XWRITE_RESET(name)
+#define GATT_WRITE_PARAMS_TLV(name)             XWRITE_PARAMS_TLV(name)
+
+#include "gatt_db.h"
+
+#undef PRIMARY_SERVICE
+#undef PRIMARY_SERVICE_UUID32
+#undef PRIMARY_SERVICE_UUID128
+#undef SECONDARY_SERVICE
+#undef SECONDARY_SERVICE_UUID32
+#undef SECONDARY_SERVICE_UUID128
+#undef INCLUDE
+#undef INCLUDE_CUSTOM
+#undef CHARACTERISTIC
+#undef CHARACTERISTIC_UUID32
+#undef CHARACTERISTIC_UUID128
+#undef VALUE
+#undef VALUE_UUID32
+#undef VALUE_UUID128
+#undef VALUE_VARLEN
+#undef VALUE_UUID32_VARLEN
+#undef VALUE_UUID128_VARLEN
+#undef CCCD
+#undef DESCRIPTOR
+#undef DESCRIPTOR_UUID32
+#undef DESCRIPTOR_UUID128
+#undef CHARACTERISTIC_AGGREGATE
+
+#undef GATT_WRITE_PARAM
+#undef GATT_WRITE_COUNTER
+#undef GATT_WRITE_KEY
+#undef GATT_WRITE_RESET
+#undef GATT_WRITE_PARAMS_TLV
+#define GATT_WRITE_PARAM(name, id)
+#define GATT_WRITE_COUNTER(name, id)
+#define GATT_WRITE_KEY(name, id, size)
+#define GATT_WRITE_RESET(name)
+#define GATT_WRITE_PARAMS_TLV(name)
+
+#endif /* GATT_WRITE_X_H */
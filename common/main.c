@@ -28,6 +28,7 @@
 #include "uwb_manager.h"
 #include "phscaEseDal.h"
 #include "command.h"
+#include "app_trace.h"
 #include <phscaEseDal_Gpio.h>
 #include <phscaEseTypes.h>
 #include <phscaEseDal_Uart.h>
@@ -80,6 +81,8 @@ static OSA_TASK_DEFINE(uwb_task, gMainThreadPriority_c, 1, gMainThreadStackSize_
 
 static void ble_task(void *argument)
 {
+    App_TraceSetTask(gAppTraceTaskBle_c);
+
     /* Start BLE Platform related resources such as clocks, Link layer and HCI transport to Link Layer */
     (void)APP_InitBle();
 
@@ -94,11 +97,13 @@ static void ble_task(void *argument)
 
 static void keyfob_task(void *argument)
 {
+    App_TraceSetTask(gAppTraceTaskKeyfob_c);
     KEYFOB_MGR_run();
 }
 
 static void uwb_task(void *argument)
 {
+    App_TraceSetTask(gAppTraceTaskUwb_c);
     UWB_MGR_run();
 }
 
@@ -133,6 +138,7 @@ int main(void)
     OSA_Init();
 
     BOARD_InitHardware();
+    App_TraceInit();
 
     /* Start Application services (timers, serial manager, low power, led, button, etc..) */
 #if (defined(gDebugConsoleEnable_d) && (gDebugConsoleEnable_d > 0))
@@ -69,6 +69,16 @@
 
 #include "keyfob_manager.h"
 
+#include "app_latency.h"
+#include "app_event_pool.h"
+#include "app_trace.h"
+#include "app_counters.h"
+#include "app_gatt_write.h"
+#include "app_params_tlv.h"
+#include "app_diag.h"
+#include "app_gatt_cache.h"
+#include "ccc_credentials.h"
+
 /************************************************************************************
 *************************************************************************************
 * Extern variables
@@ -119,65 +129,15 @@ uint16_t mSystemParamsValuesHandles[] = {(uint16_t)value_scanning_interval,
 										 (uint16_t)value_battery_level,
                                          (uint16_t)value_number_of_anchors,
                                          (uint16_t)value_commands_reset,
+                                         (uint16_t)value_params_tlv,
                                          (uint16_t)value_keys_IRK,
                                          (uint16_t)value_keys_LTK,
                                          (uint16_t)value_BD_ADDR};
-typedef struct
-{
-    uint16_t u16Handle;
-    void (*pcfCharWriteCb)(int32_t, int32_t);
-    int32_t arg;
-}app_ble_chars_metadata;
-
-typedef struct
-{
-    uint16_t u16Handle;
-    void (*pcfCharWriteCb)(int32_t, uint8_t*, uint16_t);
-    int32_t arg;
-    int32_t max_value;
-}app_keys_chars_metadata;
-
-static void BleApp_PerformReset(int32_t arg, int32_t value);
-static void BleApp_SetParam(int32_t arg, int32_t value);
-static void BleApp_SetKey(int32_t arg, uint8_t *key_bytes, uint16_t Key_size);
-
-static const app_ble_chars_metadata mCharRegistry[] =
-{
-    {(uint16_t)value_scanning_interval,               BleApp_SetParam, SlowScanIntervalID},
-    {(uint16_t)value_scan_windows,                    BleApp_SetParam, SlowScanWindowID},
-    {(uint16_t)value_connection_interval,             BleApp_SetParam, ConnectionIntervalID},
-    {(uint16_t)value_ble_power_output,                BleApp_SetParam, BlePowerOutputID},
-    {(uint16_t)value_ble_scan_on_step,                BleApp_SetParam, BleScanOnStepID},
-    {(uint16_t)value_ble_disc_during_still,           BleApp_SetParam, BleDiscDuringStillID},
-    {(uint16_t)value_delta_rssi_low,                  BleApp_SetParam, DeltaRssiLowID},
-    {(uint16_t)value_delta_rssi_medium,               BleApp_SetParam, DeltaRssiMediumID},
-    {(uint16_t)value_delta_rssi_high,                 BleApp_SetParam, DeltaRssiHighID},
-    {(uint16_t)value_rssi_intent_high,                BleApp_SetParam, RssiIntentHighID},
-    {(uint16_t)value_timeout_between_same_intents,    BleApp_SetParam, TimeoutBetweenSameIntentsID},
-    {(uint16_t)value_rssi_on_duration,                BleApp_SetParam, RssiOnDurationID},
-    {(uint16_t)value_ms_threshold_no_motion_detected, BleApp_SetParam, MsThresholdNoMotionDetectionID},
-    {(uint16_t)value_ms_osr,                          BleApp_SetParam, MsOsrID},
-    {(uint16_t)value_ms_odr,                          BleApp_SetParam, MsOdrID},
-    {(uint16_t)value_ms_accuracy_range,               BleApp_SetParam, MsAccuracyRangeID},
-    {(uint16_t)value_ms_motion_still_duration,        BleApp_SetParam, MsMotionStillDurationID},
-	{(uint16_t)value_ms_wrist_mode,                   BleApp_SetParam, MsWristModeID},
-	{(uint16_t)value_ms_step_in_scan,                 BleApp_SetParam, MsStepInScanID},
-	{(uint16_t)value_ms_step_out_scan,                BleApp_SetParam, MsStepOutScanID},
-	{(uint16_t)value_ms_total_step,                   BleApp_SetParam, MsTotalStepID},
-	{(uint16_t)value_ms_still_detected,               BleApp_SetParam, MsStillDetectedID},
-	{(uint16_t)value_temperature,                     BleApp_SetParam, TemperatureID},
-	{(uint16_t)value_battery_level,                   BleApp_SetParam, BatteryLevelID},
-	{(uint16_t)value_number_of_anchors,               BleApp_SetParam, NumberOfAnchorsID},
-    {(uint16_t)value_commands_reset,                  BleApp_PerformReset, 0},
-};
-
-static const app_keys_chars_metadata mKeysCharRegistry[] =
-{
-	{(uint16_t)value_keys_IRK,        BleApp_SetKey,      IrkKeyID,       KEY_MAX_SIZE},
-	{(uint16_t)value_keys_LTK,        BleApp_SetKey,      LtkKeyID,       KEY_MAX_SIZE},
-	{(uint16_t)value_BD_ADDR,         BleApp_SetKey,      BdAddrKeyID,    BD_ADDR_MAX_SIZE},
-};
 
+/* Values the application sees read: params_tlv is rebuilt, a Database Hash
+   read makes the client change-aware, a counter is set to its count */
+static uint16_t mReadNotificationsHandles[] = {(uint16_t)value_params_tlv, (uint16_t)value_database_hash,
+                                              (uint16_t)value_ms_total_step};
 static appScanningParams_t appScanParams = {
     &gScanParams,
     gGapDuplicateFilteringEnable_c,
@@ -205,6 +165,9 @@ pfBleCallback_t mpfBleEventHandler = NULL;
 
 /* This global will be TRUE if the user adds or removes a bond */
 bool_t gPrivacyStateChangedByUser = FALSE;
+
+/* Host stack initialized, us since the timer manager started at boot */
+static uint32_t mHostInitializedUs = 0U;
 /************************************************************************************
 *************************************************************************************
 * Private functions prototypes
@@ -265,6 +228,7 @@ static void BleApp_GenericCallback_HandlePrivacyEvents(gapGenericEvent_t* pGener
 static void ScanningTimeoutTimerCallback(void* pParam);
 #endif
 static void BluetoothLEHost_Initialized(void);
+static appQueueId_t BleApp_EventQueue(appCallbackParam_t param);
 
 #if (defined(gAppButtonCnt_c) && (gAppButtonCnt_c > 0))
 button_status_t BleApp_HandleKeys0(void *buttonHandle, button_callback_message_t *message,void *callbackParam);
@@ -300,6 +264,9 @@ void BluetoothLEHost_AppInit(void)
     
     uint8_t mPeerId = 0;
 
+    /* Before anything can post an event */
+    App_EventPoolInit();
+
     for (mPeerId = 0; mPeerId < (uint8_t)gAppMaxConnections_c; mPeerId++)
     {
         maPeerInformation[mPeerId].deviceId = gInvalidDeviceId_c;
@@ -327,7 +294,7 @@ void BluetoothLEHost_AppInit(void)
     /* Initialize Bluetooth Host Stack */
     BluetoothLEHost_Init(BluetoothLEHost_Initialized);
 
-    (void)Gap_ControllerEnhancedNotification(((uint32_t)gNotifConnCreated_c | (uint32_t)gNotifPhyUpdateInd_c), 0U);
+    (void)Gap_ControllerEnhancedNotification(gAppCtrlNotifDefault_c, 0U);
     
     /* UI */
 #if (defined(gDebugConsoleEnable_d) && (gDebugConsoleEnable_d > 0))
@@ -358,6 +325,7 @@ void BleApp_Connect(void)
 void BleApp_RegisterEventHandler(pfBleCallback_t pfBleEventHandler)
 {
     mpfBleEventHandler = pfBleEventHandler;
+    App_RegisterCallbackClassifier(pfBleEventHandler, BleApp_EventQueue);
 }
 
 /*! *********************************************************************************
@@ -414,13 +382,13 @@ button_status_t  BleApp_HandleKeys0(void *buttonHandle, button_callback_message_
         {
             if(mpfBleEventHandler != NULL)
             {
-                appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+                appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
                 if(pEventData != NULL)
                 {
                     pEventData->appEvent = mAppEvt_KBD_EventPressPB1_c;
                     if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                     {
-                        (void)MEM_BufferFree(pEventData);
+                        App_EventFree(pEventData);
                     }
                 }
             }
@@ -432,13 +400,13 @@ button_status_t  BleApp_HandleKeys0(void *buttonHandle, button_callback_message_
         {
             if(mpfBleEventHandler != NULL)
             {
-                appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+                appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
                 if(pEventData != NULL)
                 {
                     pEventData->appEvent = mAppEvt_KBD_EventLongPB1_c;
                     if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                     {
-                        (void)MEM_BufferFree(pEventData);
+                        App_EventFree(pEventData);
                     }
                 }
             }
@@ -450,13 +418,13 @@ button_status_t  BleApp_HandleKeys0(void *buttonHandle, button_callback_message_
         {
             if(mpfBleEventHandler != NULL)
             {
-                appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+                appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
                 if(pEventData != NULL)
                 {
                     pEventData->appEvent = mAppEvt_KBD_EventVeryLongPB1_c;
                     if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                     {
-                        (void)MEM_BufferFree(pEventData);
+                        App_EventFree(pEventData);
                     }
                 }
             }
@@ -491,13 +459,13 @@ button_status_t BleApp_HandleKeys1(void *buttonHandle, button_callback_message_t
         {
             if(mpfBleEventHandler != NULL)
             {
-                appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+                appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
                 if(pEventData != NULL)
                 {
                     pEventData->appEvent = mAppEvt_KBD_EventPressPB2_c;
                     if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                     {
-                        (void)MEM_BufferFree(pEventData);
+                        App_EventFree(pEventData);
                     }
                 }
             }
@@ -508,13 +476,13 @@ button_status_t BleApp_HandleKeys1(void *buttonHandle, button_callback_message_t
         {
             if(mpfBleEventHandler != NULL)
             {
-                appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+                appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
                 if(pEventData != NULL)
                 {
                     pEventData->appEvent = mAppEvt_KBD_EventLongPB2_c;
                     if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                     {
-                        (void)MEM_BufferFree(pEventData);
+                        App_EventFree(pEventData);
                     }
                 }
             }
@@ -549,13 +517,13 @@ button_status_t BleApp_HandleKeys2(void *buttonHandle, button_callback_message_t
         {
             if(mpfBleEventHandler != NULL)
             {
-                appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+                appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
                 if(pEventData != NULL)
                 {
                     pEventData->appEvent = mAppEvt_KBD_EventPressPB3_c;
                     if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                     {
-                        (void)MEM_BufferFree(pEventData);
+                        App_EventFree(pEventData);
                     }
                 }
             }
@@ -589,7 +557,7 @@ void BleApp_GenericCallback (gapGenericEvent_t* pGenericEvent)
             {
                 if(mpfBleEventHandler != NULL)
                 {
-                    appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t) + sizeof(gapPhyEvent_t));
+                    appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t) + sizeof(gapPhyEvent_t));
                     if(pEventData != NULL)
                     {
                         pEventData->appEvent = mAppEvt_GenericCallback_LePhyEvent_c;
@@ -597,7 +565,7 @@ void BleApp_GenericCallback (gapGenericEvent_t* pGenericEvent)
                         FLib_MemCpy(pEventData->eventData.pData, &pGenericEvent->eventData.phyEvent, sizeof(gapPhyEvent_t));
                         if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                         {
-                            (void)MEM_BufferFree(pEventData);
+                            App_EventFree(pEventData);
                         }
                     }
                 }
@@ -607,7 +575,7 @@ void BleApp_GenericCallback (gapGenericEvent_t* pGenericEvent)
             {
                 if(mpfBleEventHandler != NULL)
                 {
-                    appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t) + sizeof(gapLeScOobData_t));
+                    appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t) + sizeof(gapLeScOobData_t));
                     if(pEventData != NULL)
                     {
                         pEventData->appEvent = mAppEvt_GenericCallback_LeScLocalOobData_c;
@@ -615,7 +583,7 @@ void BleApp_GenericCallback (gapGenericEvent_t* pGenericEvent)
                         FLib_MemCpy(pEventData->eventData.pData, &pGenericEvent->eventData.localOobData, sizeof(gapLeScOobData_t));
                         if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                         {
-                            (void)MEM_BufferFree(pEventData);
+                            App_EventFree(pEventData);
                         }
                     }
                 }
@@ -626,7 +594,7 @@ void BleApp_GenericCallback (gapGenericEvent_t* pGenericEvent)
             {
                 if(mpfBleEventHandler != NULL)
                 {
-                    appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t) + sizeof(gcBleDeviceAddressSize_c));
+                    appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t) + sizeof(gcBleDeviceAddressSize_c));
                     if(pEventData != NULL)
                     {
                         pEventData->appEvent = mAppEvt_GenericCallback_RandomAddressReady_c;
@@ -634,7 +602,7 @@ void BleApp_GenericCallback (gapGenericEvent_t* pGenericEvent)
                         FLib_MemCpy(pEventData->eventData.pData, pGenericEvent->eventData.addrReady.aAddress, sizeof(gcBleDeviceAddressSize_c));
                         if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                         {
-                            (void)MEM_BufferFree(pEventData);
+                            App_EventFree(pEventData);
                         }
                     }
                 }
@@ -643,9 +611,18 @@ void BleApp_GenericCallback (gapGenericEvent_t* pGenericEvent)
          
         case gControllerNotificationEvent_c:
         {
-            if(mpfBleEventHandler != NULL)
+            /* Connection event RSSI goes to the filter in place, this callback
+               already runs on the application task: no buffer, no second hop */
+            if ((pGenericEvent->eventData.notifEvent.eventType & (uint16_t)gNotifConnRxPdu_c) != 0U)
             {
-                appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t) + sizeof(bleNotificationEvent_t));
+                BleApp_HandleConnEventRssi(pGenericEvent->eventData.notifEvent.deviceId,
+                                           pGenericEvent->eventData.notifEvent.rssi,
+                                           pGenericEvent->eventData.notifEvent.ce_counter);
+            }
+            if((mpfBleEventHandler != NULL) &&
+               ((pGenericEvent->eventData.notifEvent.eventType & (uint16_t)gAppCtrlNotifDefault_c) != 0U))
+            {
+                appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t) + sizeof(bleNotificationEvent_t));
                 if(pEventData != NULL)
                 {
                     pEventData->appEvent = mAppEvt_GenericCallback_CtrlNotifEvent_c;
@@ -653,7 +630,7 @@ void BleApp_GenericCallback (gapGenericEvent_t* pGenericEvent)
                     FLib_MemCpy(pEventData->eventData.pData, &pGenericEvent->eventData.notifEvent, sizeof(bleNotificationEvent_t));  
                     if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                     {
-                        (void)MEM_BufferFree(pEventData);
+                        App_EventFree(pEventData);
                     }
                 }
             }
@@ -664,7 +641,7 @@ void BleApp_GenericCallback (gapGenericEvent_t* pGenericEvent)
         {
             if(mpfBleEventHandler != NULL)
             {
-                appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t) + sizeof(bleBondCreatedEvent_t));
+                appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t) + sizeof(bleBondCreatedEvent_t));
                 if(pEventData != NULL)
                 {
                     pEventData->appEvent = mAppEvt_GenericCallback_BondCreatedEvent_c;
@@ -672,7 +649,7 @@ void BleApp_GenericCallback (gapGenericEvent_t* pGenericEvent)
                     FLib_MemCpy(pEventData->eventData.pData, &pGenericEvent->eventData.bondCreatedEvent, sizeof(bleBondCreatedEvent_t));  
                     if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                     {
-                        (void)MEM_BufferFree(pEventData);
+                        App_EventFree(pEventData);
                     }
                 }
             }
@@ -693,6 +670,15 @@ void BleApp_GenericCallback (gapGenericEvent_t* pGenericEvent)
     }
 }
 
+/*! *********************************************************************************
+* \brief        Boot time: host stack initialized, us after the application
+*               services started the timer manager.
+********************************************************************************** */
+uint32_t BleApp_GetHostInitializedUs(void)
+{
+    return mHostInitializedUs;
+}
+
 /*! *********************************************************************************
 * \brief        Handles Shell_Factory Reset Command event.
 ********************************************************************************** */
@@ -837,6 +823,7 @@ static void BleApp_ScanningCallback (gapScanningEvent_t* pScanningEvent)
                 if (mFoundDeviceToConnect || (pScanningEvent->eventData.scannedDevice.advertisingAddressResolved == TRUE))
                 {
                 	mFoundDeviceToConnect = TRUE;
+                    App_LatencyMark(gInvalidDeviceId_c, mLatencyScanMatch_c);
                     /* Set connection parameters and stop scanning. Connect on gScanStateChanged_c. */
                     gConnReqParams.peerAddressType = pScanningEvent->eventData.scannedDevice.addressType;
                     FLib_MemCpy(gConnReqParams.peerAddress,
@@ -867,6 +854,7 @@ static void BleApp_ScanningCallback (gapScanningEvent_t* pScanningEvent)
                 if (mFoundDeviceToConnect || (pScanningEvent->eventData.extScannedDevice.advertisingAddressResolved == TRUE))
                 {
                     mFoundDeviceToConnect = TRUE;
+                    App_LatencyMark(gInvalidDeviceId_c, mLatencyScanMatch_c);
                     /* Set connection parameters and stop scanning. Connect on gScanStateChanged_c. */
                     gConnReqParams.peerAddressType = pScanningEvent->eventData.extScannedDevice.addressType;
                     FLib_MemCpy(gConnReqParams.peerAddress,
@@ -969,9 +957,10 @@ static void BleApp_ConnectionCallback (deviceId_t peerDeviceId, gapConnectionEve
     {
         case gConnEvtConnected_c:
         {
+            App_GattCacheConnected(peerDeviceId);
             if(mpfBleEventHandler != NULL)
             {
-                appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t) + sizeof(appConnectionCallbackEventData_t));
+                appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t) + sizeof(appConnectionCallbackEventData_t));
                 if(pEventData != NULL)
                 {
                     pEventData->appEvent = mAppEvt_ConnectionCallback_ConnEvtConnected_c;
@@ -982,7 +971,7 @@ static void BleApp_ConnectionCallback (deviceId_t peerDeviceId, gapConnectionEve
                     pConnectionCallbackEventData = NULL;
                     if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                     {
-                        (void)MEM_BufferFree(pEventData);
+                        App_EventFree(pEventData);
                     }
                 }
             }
@@ -991,6 +980,8 @@ static void BleApp_ConnectionCallback (deviceId_t peerDeviceId, gapConnectionEve
 
         case gConnEvtDisconnected_c:
         {
+            App_GattCacheDisconnected(peerDeviceId);
+            App_ParamsTlvDisconnected(peerDeviceId);
             BleApp_ConnectionCallback_SignalSimpleEvents(peerDeviceId, mAppEvt_ConnectionCallback_ConnEvtDisconnected_c);
         }
         break;
@@ -1007,6 +998,11 @@ static void BleApp_ConnectionCallback (deviceId_t peerDeviceId, gapConnectionEve
             /* Notify state machine handler on pairing complete */
             if (pConnectionEvent->eventData.pairingCompleteEvent.pairingSuccessful)
             {
+                if (pConnectionEvent->eventData.pairingCompleteEvent.pairingCompleteData.withBonding)
+                {
+                    /* Discovers the current database */
+                    App_GattCacheLinkSecured(peerDeviceId, TRUE);
+                }
                 BleApp_ConnectionCallback_SignalSimpleEvents(peerDeviceId, mAppEvt_ConnectionCallback_ConnEvtPairingComplete_c);
             }
         }
@@ -1017,6 +1013,8 @@ static void BleApp_ConnectionCallback (deviceId_t peerDeviceId, gapConnectionEve
         {
             if( pConnectionEvent->eventData.encryptionChangedEvent.newEncryptionState )
             {
+                /* Bonded client reconnected: Service Changed if its cache is stale */
+                App_GattCacheLinkSecured(peerDeviceId, FALSE);
                 BleApp_ConnectionCallback_SignalSimpleEvents(peerDeviceId, mAppEvt_ConnectionCallback_ConnEvtEncryptionChanged_c);
             }
         }
@@ -1034,7 +1032,7 @@ static void BleApp_ConnectionCallback (deviceId_t peerDeviceId, gapConnectionEve
         {
             if(mpfBleEventHandler != NULL)
             {
-                appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t) + sizeof(appRssiReadCallbackEventData_t));
+                appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t) + sizeof(appRssiReadCallbackEventData_t));
                 if(pEventData != NULL)
                 {
                     pEventData->appEvent = mAppEvt_ConnectionCallback_ReadRssiEvtConnected_c;
@@ -1045,7 +1043,7 @@ static void BleApp_ConnectionCallback (deviceId_t peerDeviceId, gapConnectionEve
                     pReadRssiCallbackEventData = NULL;
                     if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                     {
-                        (void)MEM_BufferFree(pEventData);
+                        App_EventFree(pEventData);
                     }
                 }
             }
@@ -1079,14 +1077,14 @@ static void BleApp_ConnectionCallback_SignalSimpleEvents
 {
     if(mpfBleEventHandler != NULL)
     {
-        appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+        appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
         if(pEventData != NULL)
         {
             pEventData->appEvent = connectionCallbackEvent;
             pEventData->eventData.peerDeviceId = peerDeviceId;
             if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
             {
-                (void)MEM_BufferFree(pEventData);
+                App_EventFree(pEventData);
             }
         }
     }
@@ -1116,14 +1114,14 @@ static void BleApp_ServiceDiscoveryCallback(deviceId_t peerDeviceId, servDiscEve
             {
                 if(mpfBleEventHandler != NULL)
                 {
-                    appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+                    appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
                     if(pEventData != NULL)
                     {
                         pEventData->appEvent = mAppEvt_ServiceDiscoveryCallback_DiscoveryFinishedWithSuccess_c;
                         pEventData->eventData.peerDeviceId = peerDeviceId;
                         if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                         {
-                            (void)MEM_BufferFree(pEventData);
+                            App_EventFree(pEventData);
                         }
                     }
                 }
@@ -1132,14 +1130,14 @@ static void BleApp_ServiceDiscoveryCallback(deviceId_t peerDeviceId, servDiscEve
             {
                 if(mpfBleEventHandler != NULL)
                 {
-                    appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+                    appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
                     if(pEventData != NULL)
                     {
                         pEventData->appEvent = mAppEvt_ServiceDiscoveryCallback_DiscoveryFinishedFailed_c;
                         pEventData->eventData.peerDeviceId = peerDeviceId;
                         if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                         {
-                            (void)MEM_BufferFree(pEventData);
+                            App_EventFree(pEventData);
                         }
                     }
                 }
@@ -1253,14 +1251,14 @@ static void BleApp_GattClientCallback(
 
         if(mpfBleEventHandler != NULL)
         {
-            appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+            appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
             if(pEventData != NULL)
             {
                 pEventData->appEvent = mAppEvt_GattClientCallback_GattProcError_c;
                 pEventData->eventData.peerDeviceId = serverDeviceId;
                 if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                 {
-                    (void)MEM_BufferFree(pEventData);
+                    App_EventFree(pEventData);
                 }
             }
         }
@@ -1275,14 +1273,14 @@ static void BleApp_GattClientCallback(
                 {
                     if(mpfBleEventHandler != NULL)
                     {
-                        appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+                        appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
                         if(pEventData != NULL)
                         {
                             pEventData->appEvent = mAppEvt_GattClientCallback_GattProcReadCharacteristicValue_c;
                             pEventData->eventData.peerDeviceId = serverDeviceId;
                             if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                             {
-                                (void)MEM_BufferFree(pEventData);
+                                App_EventFree(pEventData);
                             }
                         }
                     }
@@ -1293,14 +1291,14 @@ static void BleApp_GattClientCallback(
                 {
                     if(mpfBleEventHandler != NULL)
                     {
-                        appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+                        appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
                         if(pEventData != NULL)
                         {
                             pEventData->appEvent = mAppEvt_GattClientCallback_GattProcReadUsingCharacteristicUuid_c;
                             pEventData->eventData.peerDeviceId = serverDeviceId;
                             if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                             {
-                                (void)MEM_BufferFree(pEventData);
+                                App_EventFree(pEventData);
                             }
                         }
                     }
@@ -1311,14 +1309,14 @@ static void BleApp_GattClientCallback(
                 {
                     if(mpfBleEventHandler != NULL)
                     {
-                        appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+                        appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
                         if(pEventData != NULL)
                         {
                             pEventData->appEvent = mAppEvt_GattClientCallback_GattProcComplete_c;
                             pEventData->eventData.peerDeviceId = serverDeviceId;
                             if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                             {
-                                (void)MEM_BufferFree(pEventData);
+                                App_EventFree(pEventData);
                             }
                         }
                     }
@@ -1345,73 +1343,64 @@ static void BleApp_GattServerCallback
 )
 {
     uint16_t tempMtu = 0;
-    uint8_t i;
-    int32_t newCaracteristicValue;
-    //uint8_t newArrayBytes[KEY_MAX_SIZE];
-    bleResult_t result;
+    attErrorCode_t status;
 
     switch (pServerEvent->eventType)
     {
         case gEvtAttributeWritten_c:
         {
-            for(i=0; i<(sizeof(mCharRegistry)/sizeof(app_ble_chars_metadata)); i++)
+            /* Handles of mSystemParamsValuesHandles */
+            status = App_GattWrite(pServerEvent->eventData.attributeWrittenEvent.handle,
+                                   pServerEvent->eventData.attributeWrittenEvent.aValue,
+                                   pServerEvent->eventData.attributeWrittenEvent.cValueLength);
+            (void)GattServer_SendAttributeWrittenStatus(deviceId,
+                                                        pServerEvent->eventData.attributeWrittenEvent.handle,
+                                                        (uint8_t)status);
+        }
+        break;
+
+        case gEvtLongCharacteristicWritten_c:
+        {
+            /* Executed prepared writes, answered by the stack: the outcome is
+               in params_tlv_status */
+            (void)App_GattWrite(pServerEvent->eventData.longCharWrittenEvent.handle,
+                                pServerEvent->eventData.longCharWrittenEvent.aValue,
+                                pServerEvent->eventData.longCharWrittenEvent.cValueLength);
+        }
+        break;
+
+        case gEvtAttributeRead_c:
+        {
+            if (pServerEvent->eventData.attributeReadEvent.handle == (uint16_t)value_params_tlv)
             {
-                if(mCharRegistry[i].u16Handle == pServerEvent->eventData.attributeWrittenEvent.handle)
-                {
-                    /*if(mCharRegistry[i].u16Handle != (uint16_t)value_commands_reset)
-                    {*/
-                    	switch(pServerEvent->eventData.attributeWrittenEvent.cValueLength)
-                        {
-                        case sizeof(int8_t):
-                            newCaracteristicValue = (int32_t) *((int8_t*)pServerEvent->eventData.attributeWrittenEvent.aValue);
-                            break;
-                        case sizeof(int16_t):
-                            newCaracteristicValue = (int32_t) *((int16_t*)pServerEvent->eventData.attributeWrittenEvent.aValue);
-                            break;
-                        case sizeof(int32_t):
-                            newCaracteristicValue = (int32_t) *((int32_t*)pServerEvent->eventData.attributeWrittenEvent.aValue);
-                            break;
-                        default:
-                            break;
-                        }
-                        mCharRegistry[i].pcfCharWriteCb(mCharRegistry[i].arg, newCaracteristicValue);
-                        newCaracteristicValue = ((newCaracteristicValue>>24)&0xff) | // move byte 3 to byte 0
-                                                ((newCaracteristicValue<<8)&0xff0000) | // move byte 1 to byte 2
-                                                ((newCaracteristicValue>>8)&0xff00) | // move byte 2 to byte 1
-                                                ((newCaracteristicValue<<24)&0xff000000); // byte 0 to byte 3
-                        result = GattDb_WriteAttribute(pServerEvent->eventData.attributeWrittenEvent.handle,
-                                                       pServerEvent->eventData.attributeWrittenEvent.cValueLength,
-                                                       (uint8_t *)&newCaracteristicValue);
-                    /*}
-                    else
-                    {
-                    	mCharRegistry[i].pcfCharWriteCb(mCharRegistry[i].arg, (int32_t)&pServerEvent->eventData.attributeWrittenEvent.aValue);
-                    }*/
-                    GattServer_SendAttributeWrittenStatus(deviceId,
-                                                          pServerEvent->eventData.attributeWrittenEvent.handle,
-                                                          result);
-                    break;
-                }
+                App_ParamsTlvRead(deviceId);
             }
+            else if (pServerEvent->eventData.attributeReadEvent.handle == (uint16_t)value_database_hash)
+            {
+                App_GattCacheHashRead(deviceId);
+            }
+            else
+            {
+                App_GattWriteRefresh(pServerEvent->eventData.attributeReadEvent.handle);
+            }
+            (void)GattServer_SendAttributeReadStatus(deviceId,
+                                                     pServerEvent->eventData.attributeReadEvent.handle,
+                                                     (uint8_t)gAttErrCodeNoError_c);
+        }
+        break;
+
+        case gEvtHandleValueConfirmation_c:
+        {
+            App_GattCacheConfirmed(deviceId);
+        }
+        break;
 
-            for(i=0; i<(sizeof(mKeysCharRegistry)/sizeof(app_keys_chars_metadata)); i++)
+        case gEvtCharacteristicCccdWritten_c:
+        {
+            if ((pServerEvent->eventData.charCccdWrittenEvent.handle == (uint16_t)cccd_diagnostics) &&
+                ((pServerEvent->eventData.charCccdWrittenEvent.newCccd & gCccdNotification_c) != 0U))
             {
-                if(mKeysCharRegistry[i].u16Handle == pServerEvent->eventData.attributeWrittenEvent.handle)
-                {
-                    uint8_t newArrayBytes[mKeysCharRegistry[i].max_value];
-                	FLib_MemCpy(newArrayBytes, pServerEvent->eventData.attributeWrittenEvent.aValue,
-                			    pServerEvent->eventData.attributeWrittenEvent.cValueLength);
-                	mKeysCharRegistry[i].pcfCharWriteCb(mKeysCharRegistry[i].arg,
-                			                            newArrayBytes,
-														pServerEvent->eventData.attributeWrittenEvent.cValueLength);
-                    result = GattDb_WriteAttribute(pServerEvent->eventData.attributeWrittenEvent.handle,
-                                                   pServerEvent->eventData.attributeWrittenEvent.cValueLength,
-												   newArrayBytes);
-                    GattServer_SendAttributeWrittenStatus(deviceId,
-                                                          pServerEvent->eventData.attributeWrittenEvent.handle,
-                                                          result);
-                    break;
-                }
+                App_DiagSubscribed(deviceId);
             }
         }
         break;
@@ -1432,24 +1421,6 @@ static void BleApp_GattServerCallback
     }
 }
 
-static void BleApp_PerformReset(int32_t arg, int32_t value)
-{
-    (void)arg;
-    (void)value;
-
-    HAL_ResetMCU();
-}
-
-static void BleApp_SetParam(int32_t arg, int32_t value)
-{
-    App_NvmWriteSystemParam(arg, value);
-}
-
-static void BleApp_SetKey(int32_t arg, uint8_t *key_bytes, uint16_t key_size)
-{
-    App_NvmWriteBleKey(arg, key_bytes, key_size);
-}
-
 /*! *********************************************************************************
 * \brief        Process scanning events to search for the DK Ranging Service.
 *               This function is called from the scanning callback.
@@ -1561,9 +1532,13 @@ static void BleApp_L2capPsmDataCallback (deviceId_t     deviceId,
                                          uint8_t*       pPacket,
                                          uint16_t       packetLength)
 {
+    App_TraceEvent(gAppTraceL2capRx_c, ((uint32_t)deviceId << 24) | (uint32_t)packetLength,
+                   (packetLength >= 4U) ? (((uint32_t)pPacket[0] << 24) | ((uint32_t)pPacket[1] << 16) |
+                                           ((uint32_t)pPacket[2] << 8) | (uint32_t)pPacket[3]) : 0U);
+
     if(mpfBleEventHandler != NULL)
     {
-        appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t) + sizeof(appEventL2capPsmData_t) + (uint32_t)packetLength);
+        appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t) + sizeof(appEventL2capPsmData_t) + (uint32_t)packetLength);
         if(pEventData != NULL)
         {
             pEventData->appEvent = mAppEvt_L2capPsmDataCallback_c;
@@ -1577,7 +1552,7 @@ static void BleApp_L2capPsmDataCallback (deviceId_t     deviceId,
             pL2capPsmDataEvent = NULL;
             if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
             {
-                (void)MEM_BufferFree(pEventData);
+                App_EventFree(pEventData);
             }
         }
     }
@@ -1602,7 +1577,7 @@ static void BleApp_L2capPsmControlCallback(l2capControlMessage_t* pMessage)
         {
             if(mpfBleEventHandler != NULL)
             {
-                appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t) + sizeof(l2caLeCbConnectionComplete_t));
+                appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t) + sizeof(l2caLeCbConnectionComplete_t));
                 if(pEventData != NULL)
                 {
                     pEventData->appEvent = mAppEvt_L2capPsmControlCallback_LePsmConnectionComplete_c;
@@ -1610,7 +1585,7 @@ static void BleApp_L2capPsmControlCallback(l2capControlMessage_t* pMessage)
                     FLib_MemCpy(pEventData->eventData.pData, &pMessage->messageData.connectionComplete, sizeof(l2caLeCbConnectionComplete_t));
                     if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                     {
-                        (void)MEM_BufferFree(pEventData);
+                        App_EventFree(pEventData);
                     }
                 }
             }
@@ -1620,14 +1595,15 @@ static void BleApp_L2capPsmControlCallback(l2capControlMessage_t* pMessage)
         {
             if(mpfBleEventHandler != NULL)
             {
-                appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+                appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t) + sizeof(l2caLeCbDisconnection_t));
                 if(pEventData != NULL)
                 {
                     pEventData->appEvent = mAppEvt_L2capPsmControlCallback_LePsmDisconnectNotification_c;
-                    pEventData->eventData.peerDeviceId = pMessage->messageData.disconnection.deviceId;
+                    pEventData->eventData.pData = pEventData + 1;
+                    FLib_MemCpy(pEventData->eventData.pData, &pMessage->messageData.disconnection, sizeof(l2caLeCbDisconnection_t));
                     if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                     {
-                        (void)MEM_BufferFree(pEventData);
+                        App_EventFree(pEventData);
                     }
                 }
             }
@@ -1637,7 +1613,7 @@ static void BleApp_L2capPsmControlCallback(l2capControlMessage_t* pMessage)
         {
             if(mpfBleEventHandler != NULL)
             {
-                appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t) + sizeof(l2caLeCbNoPeerCredits_t));
+                appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t) + sizeof(l2caLeCbNoPeerCredits_t));
                 if(pEventData != NULL)
                 {
                     pEventData->appEvent = mAppEvt_L2capPsmControlCallback_NoPeerCredits_c;
@@ -1645,7 +1621,7 @@ static void BleApp_L2capPsmControlCallback(l2capControlMessage_t* pMessage)
                     FLib_MemCpy(pEventData->eventData.pData, &pMessage->messageData.noPeerCredits, sizeof(l2caLeCbNoPeerCredits_t));
                     if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                     {
-                        (void)MEM_BufferFree(pEventData);
+                        App_EventFree(pEventData);
                     }
                 }
             }
@@ -1669,12 +1645,20 @@ static void BluetoothLEHost_Initialized(void)
 {
     uint8_t mPeerId = 0;
 
+    mHostInitializedUs = (uint32_t)TM_GetTimestamp();
+    TRACE_INFO("Host initialized at %u us, system parameters loaded in %u us",
+               mHostInitializedUs, App_NvmGetParamStats()->loadUs);
+
     /* Common GAP configuration */
     BleConnManager_GapCommonConfig();
 
     /* Register for callbacks*/
     (void)App_RegisterGattServerCallback(BleApp_GattServerCallback);
     (void)GattServer_RegisterHandlesForWriteNotifications(NumberOfElements(mSystemParamsValuesHandles), mSystemParamsValuesHandles);
+    (void)GattServer_RegisterHandlesForReadNotifications(NumberOfElements(mReadNotificationsHandles), mReadNotificationsHandles);
+    App_ParamsTlvRefresh();
+    App_GattCacheInit();
+    CCC_CredentialsLoad();
     (void)App_RegisterGattClientProcedureCallback(BleApp_GattClientCallback);
     BleServDisc_RegisterCallback(BleApp_ServiceDiscoveryCallback);
 
@@ -1707,6 +1691,70 @@ static void BluetoothLEHost_Initialized(void)
     /* Register stack callbacks */
     (void)App_RegisterLeCbCallbacks(BleApp_L2capPsmDataCallback, BleApp_L2capPsmControlCallback);
 }
+
+/*! *********************************************************************************
+* \brief        Priority class of an application event: CCC messages and the key
+*               presses that start them ahead of connection management, RSSI and
+*               diagnostics behind it. The connection lifecycle and pairing events
+*               share the class of the CCC messages: a peer's disconnection is
+*               never handled before its last L2CAP data, nor its data before its
+*               connection and encryption.
+*
+* \param[in]    param           appEventData_t posted to mpfBleEventHandler.
+********************************************************************************** */
+static appQueueId_t BleApp_EventQueue(appCallbackParam_t param)
+{
+    appQueueId_t queueId = gAppQueueConnection_c;
+
+    switch (((appEventData_t *)param)->appEvent)
+    {
+        case mAppEvt_KBD_EventPressPB1_c:
+        case mAppEvt_KBD_EventLongPB1_c:
+        case mAppEvt_KBD_EventVeryLongPB1_c:
+        case mAppEvt_KBD_EventPressPB2_c:
+        case mAppEvt_KBD_EventLongPB2_c:
+        case mAppEvt_KBD_EventPressPB3_c:
+        case mAppEvt_L2capPsmDataCallback_c:
+        case mAppEvt_L2capPsmControlCallback_LePsmConnectionComplete_c:
+        case mAppEvt_L2capPsmControlCallback_LePsmDisconnectNotification_c:
+        case mAppEvt_L2capPsmControlCallback_NoPeerCredits_c:
+        case mAppEvt_Shell_RKELock_Command_c:
+        case mAppEvt_Shell_RKEUnlock_Command_c:
+        case mAppEvt_Shell_RKERelease_Command_c:
+        case mAppEvt_Rke_Timeout_c:
+        case mAppEvt_GenericCallback_PeerDisconnected_c:
+        case mAppEvt_GenericCallback_LeScLocalOobData_c:
+        case mAppEvt_GenericCallback_BondCreatedEvent_c:
+        case mAppEvt_ConnectionCallback_ConnEvtConnected_c:
+        case mAppEvt_ConnectionCallback_ConnEvtDisconnected_c:
+        case mAppEvt_ConnectionCallback_ConnEvtLeScOobDataRequest_c:
+        case mAppEvt_ConnectionCallback_ConnEvtPairingComplete_c:
+        case mAppEvt_ConnectionCallback_ConnEvtEncryptionChanged_c:
+        case mAppEvt_ConnectionCallback_ConnEvtAuthenticationRejected_c:
+        {
+            queueId = gAppQueueControl_c;
+        }
+        break;
+
+        case mAppEvt_GenericCallback_CtrlNotifEvent_c:
+        case mAppEvt_ConnectionCallback_ReadRssiEvtConnected_c:
+        case mAppEvt_Read_Rssi_c:
+        case mAppEvt_Shell_ListBondedDev_Command_c:
+        case mAppEvt_Shell_SetGetBLEParams_Command_c:
+        {
+            queueId = gAppQueueHousekeeping_c;
+        }
+        break;
+
+        default:
+        {
+            ; /* Connection management */
+        }
+        break;
+    }
+
+    return queueId;
+}
 /*! *********************************************************************************
 * @}
 ********************************************************************************** */
@@ -44,6 +44,16 @@
 #define gUseControllerNotificationsCallback_c 0
 #endif
 
+/* Controller notifications enabled for the whole session: connection created
+   and PHY update, both time stamp the UWB clock */
+#define gAppCtrlNotifDefault_c        ((uint32_t)gNotifConnCreated_c | (uint32_t)gNotifPhyUpdateInd_c)
+
+/* RSSI of the vehicle taken from the packets received in each connection event
+   (controller notification) instead of a Gap_ReadRssi every RSSI timer tick */
+#ifndef gAppRssiFromConnEvents_d
+#define gAppRssiFromConnEvents_d      1
+#endif
+
 #if (defined(gAppButtonCnt_c) && (gAppButtonCnt_c == 1))
   /* switch press timer timeout */
   #ifndef gSwitchPressTimeout_c
@@ -104,6 +114,7 @@ typedef enum appEvent_tag{
     mAppEvt_Shell_SetGetBLEParams_Command_c,
     mAppEvt_Shell_ResetAfterDisconnection_Command_c,
     mAppEvt_Shell_SwitchGAPRole_Command_c,
+    mAppEvt_Shell_SetCredential_Command_c,
     mAppEvt_PeerConnected_c,
     mAppEvt_PeerDisconnected_c,
     mAppEvt_EncryptionChanged_c,
@@ -122,7 +133,8 @@ typedef enum appEvent_tag{
     mAppEvt_ReceivedSPAKEVerify_c,
     mAppEvt_ReceivedPairingReady_c,
     mAppEvt_AuthenticationRejected_c,
-    mAppEvt_Read_Rssi_c
+    mAppEvt_Read_Rssi_c,
+    mAppEvt_Rke_Timeout_c
 } appEvent_t;
 
 typedef struct appEventL2capPsmData_tag
@@ -186,6 +198,7 @@ void BleApp_Start(gapRole_t gapRole, uint32_t scannnigInterval, uint32_t scanWin
 void BleApp_GenericCallback (gapGenericEvent_t* pGenericEvent);
 void BleApp_RegisterEventHandler(pfBleCallback_t pfBleEventHandler);
 void BleApp_FactoryReset(void);
+uint32_t BleApp_GetHostInitializedUs(void);
 #if defined(gAppUseShellInApplication_d) && (gAppUseShellInApplication_d == 1)
 void BleApp_PrintHex(uint8_t *pHex, uint8_t len);
 void BleApp_PrintHexLe(uint8_t *pHex, uint8_t len);
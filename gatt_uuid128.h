@@ -123,6 +123,15 @@ UUID128(uuid_desc_commands_version, 0xF9, 0x27, 0x2A, 0xA6, 0xB1, 0x61, 0x4D, 0x
 UUID128(uuid_char_commands_reset, 0xF9, 0x27, 0x2A, 0xA6, 0xB1, 0x61, 0x4D, 0xBE, 0xAE, 0xDB, 0xE3, 0x64, 0x02, 0x00, 0xA4, 0x7E)
 UUID128(uuid_desc_commands_reset, 0xF9, 0x27, 0x2A, 0xA6, 0xB1, 0x61, 0x4D, 0xBE, 0xAE, 0xDB, 0xE3, 0x64, 0x02, 0x01, 0xA4, 0x7E)
 
+UUID128(uuid_char_params_tlv, 0xF9, 0x27, 0x2A, 0xA6, 0xB1, 0x61, 0x4D, 0xBE, 0xAE, 0xDB, 0xE3, 0x64, 0x03, 0x00, 0xA4, 0x7E)
+UUID128(uuid_desc_params_tlv, 0xF9, 0x27, 0x2A, 0xA6, 0xB1, 0x61, 0x4D, 0xBE, 0xAE, 0xDB, 0xE3, 0x64, 0x03, 0x01, 0xA4, 0x7E)
+
+UUID128(uuid_char_params_tlv_status, 0xF9, 0x27, 0x2A, 0xA6, 0xB1, 0x61, 0x4D, 0xBE, 0xAE, 0xDB, 0xE3, 0x64, 0x04, 0x00, 0xA4, 0x7E)
+UUID128(uuid_desc_params_tlv_status, 0xF9, 0x27, 0x2A, 0xA6, 0xB1, 0x61, 0x4D, 0xBE, 0xAE, 0xDB, 0xE3, 0x64, 0x04, 0x01, 0xA4, 0x7E)
+
+UUID128(uuid_char_diagnostics, 0xF9, 0x27, 0x2A, 0xA6, 0xB1, 0x61, 0x4D, 0xBE, 0xAE, 0xDB, 0xE3, 0x64, 0x05, 0x00, 0xA4, 0x7E)
+UUID128(uuid_desc_diagnostics, 0xF9, 0x27, 0x2A, 0xA6, 0xB1, 0x61, 0x4D, 0xBE, 0xAE, 0xDB, 0xE3, 0x64, 0x05, 0x01, 0xA4, 0x7E)
+
 /************************************************************************************
 *************************************************************************************
 * Ble keys service and characteristics UUIDs
@@ -31,6 +31,7 @@
 #include "pin_mux.h"
 #include "motion_sensor.h"
 #include "app_preinclude.h"
+#include "app_counters.h"
 
 /************************************************************************************
 *************************************************************************************
@@ -474,6 +475,7 @@ static void _keyfob_on_init_finished(void)
     else
     {
         TRACE_WARNING("Battery level is under threshold! Start a timer to re-check the VBat.");
+        App_CountersCompact(gAppCounterCompactLowBattery_c);
         _keyfob_start_timer(s_KeyfobTimerHandle, KEYFOB_VBAT_CHECK_TIMEOUT_MS);
 #if (defined(gDebugConsoleEnable_d) && (gDebugConsoleEnable_d > 0))
         Led3Blinking();
@@ -19,6 +19,7 @@
 #include "app_digital_key_device.h"
 #include "fsl_os_abstraction.h"
 #include "gap_types.h"
+#include "app_counters.h"
 
 /*******************************************************************************
  * Private macros
@@ -271,6 +272,7 @@ void MS_INT_1_HANDLER(void *GpioHandle)
     	    	step++;
     	    	step_while_scan++;
     	    	total_step_count++;
+    	    	App_CounterAdd(gAppCounterSteps_c, 1U);
     	    	u32DelayLoop_Max = 100000;
     	    	Led5On();
                 Blink_led_ms();
@@ -285,6 +287,7 @@ void MS_INT_1_HANDLER(void *GpioHandle)
     	    		Led5On();
     	    		step_without_scan++;
     	    		total_step_count++;
+    	    		App_CounterAdd(gAppCounterSteps_c, 1U);
     	    		step++;
     	    		PRINTF("step count while scanning %d \r\n",step_while_scan);
     	            PRINTF("step count whithout scanning %d \r\n",step_without_scan);
@@ -22,12 +22,14 @@
 /* Framework / Drivers */
 #include "EmbeddedTypes.h"
 #include "app_preinclude.h"
+#include "FunctionLib.h"
 #if defined(gAppUseShellInApplication_d) && (gAppUseShellInApplication_d == 1)
 #include "fsl_shell.h"
 #endif
 #include "fsl_adapter_reset.h"
 #include "fsl_component_mem_manager.h"
 #include "fsl_component_timer_manager.h"
+#include "fsl_device_registers.h"
 
 #include "app.h"
 
@@ -44,6 +46,21 @@
 
 #include "keyfob_manager.h"
 
+#include "app_latency.h"
+#include "ccc_ecdsa.h"
+#include "ccc_credentials.h"
+#include "app_rke.h"
+#include "app_dk_channels.h"
+#include "app_event_pool.h"
+#include "app_trace.h"
+#include "app_counters.h"
+#include "app_diag.h"
+#include "app_gatt_cache.h"
+#include "app_params_tlv.h"
+#include "app_shell_batch.h"
+#include "gatt_db_app_interface.h"
+#include "gatt_db_handles.h"
+
 /************************************************************************************
 *************************************************************************************
 * Private macros
@@ -88,6 +105,40 @@ static shell_status_t ShellTriggerMotionSensor_Command(shell_handle_t shellHandl
 static shell_status_t ShellResetAfterDisconnection_Command(shell_handle_t shellHandle, int32_t argc,char* argv[]);
 static shell_status_t ShellSwitchGAPRole_Command(shell_handle_t shellHandle, int32_t argc,char* argv[]);
 static shell_status_t ShellListBleKeys_Command(shell_handle_t shellHandle, int32_t argc, char * argv[]);
+static shell_status_t ShellEcdsaSelfTest_Command(shell_handle_t shellHandle, int32_t argc, char * argv[]);
+static shell_status_t ShellSetCredential_Command(shell_handle_t shellHandle, int32_t argc, char * argv[]);
+static shell_status_t ShellRkeStats_Command(shell_handle_t shellHandle, int32_t argc, char * argv[]);
+static shell_status_t ShellDkChannels_Command(shell_handle_t shellHandle, int32_t argc, char * argv[]);
+static shell_status_t ShellEventPool_Command(shell_handle_t shellHandle, int32_t argc, char * argv[]);
+static shell_status_t ShellAppQueue_Command(shell_handle_t shellHandle, int32_t argc, char * argv[]);
+static shell_status_t ShellNvmStats_Command(shell_handle_t shellHandle, int32_t argc, char * argv[]);
+static shell_status_t ShellCounters_Command(shell_handle_t shellHandle, int32_t argc, char * argv[]);
+#if defined(gAppDiagStream_d) && (gAppDiagStream_d == 1)
+static shell_status_t ShellDiag_Command(shell_handle_t shellHandle, int32_t argc, char * argv[]);
+#endif
+#if defined(gGattCaching_d) && (gGattCaching_d == 1)
+static shell_status_t ShellGattCache_Command(shell_handle_t shellHandle, int32_t argc, char * argv[]);
+#endif
+#if defined(gAppShellBatch_d) && (gAppShellBatch_d == 1)
+static shell_status_t ShellBatch_Command(shell_handle_t shellHandle, int32_t argc, char * argv[]);
+static appShellBatchStatus_t ShellBatchVersion(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult);
+static appShellBatchStatus_t ShellBatchGetParam(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult);
+static appShellBatchStatus_t ShellBatchSetParam(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult);
+static appShellBatchStatus_t ShellBatchGetParams(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult);
+static appShellBatchStatus_t ShellBatchSetParams(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult);
+static appShellBatchStatus_t ShellBatchRkeLock(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult);
+static appShellBatchStatus_t ShellBatchRkeUnlock(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult);
+static appShellBatchStatus_t ShellBatchRkeRelease(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult);
+static appShellBatchStatus_t ShellBatchDisconnect(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult);
+static appShellBatchStatus_t ShellBatchPostEvent(appEvent_t event, uint8_t argsLength);
+#endif
+#if defined(gAppLatencyRecorder_d) && (gAppLatencyRecorder_d == 1)
+static shell_status_t ShellLatency_Command(shell_handle_t shellHandle, int32_t argc, char * argv[]);
+static void ShellLatencyPrintStats(const char *pName, const appLatencyStats_t *pStats);
+#endif
+#if defined(gAppTrace_d) && (gAppTrace_d == 1)
+static shell_status_t ShellTrace_Command(shell_handle_t shellHandle, int32_t argc, char * argv[]);
+#endif
 
 
 static uint8_t BleApp_ParseHexValue(char* pInput);
@@ -247,6 +298,120 @@ static shell_command_t mListBleKeysCmd =
     .pcHelpString = "\r\n\"listbk\": List Ble keys (IRK/LTK) from non-volatile memory.\r\n",
 };
 
+static shell_command_t mEcdsaSelfTestCmd =
+{
+    .pcCommand = "ecdsa",
+    .cExpectedNumberOfParameters = 0,
+    .pFuncCallBack = ShellEcdsaSelfTest_Command,
+    .pcHelpString = "\r\n\"ecdsa\": Run the RKE ECDSA P-256 known answer test and print the signing time.\r\n",
+};
+
+static shell_command_t mSetCredentialCmd =
+{
+    .pcCommand = "setcred",
+    .cExpectedNumberOfParameters = SHELL_IGNORE_PARAMETER_COUNT,
+    .pFuncCallBack = ShellSetCredential_Command,
+    .pcHelpString = "\r\n\"setcred <w0|w1|rke> <64 hex digits>\": Provision a CCC credential into non-volatile memory.\r\n",
+};
+
+static shell_command_t mRkeStatsCmd =
+{
+    .pcCommand = "rkestat",
+    .cExpectedNumberOfParameters = SHELL_IGNORE_PARAMETER_COUNT,
+    .pFuncCallBack = ShellRkeStats_Command,
+    .pcHelpString = "\r\n\"rkestat [reset]\": RKE queue counters and press to vehicle status latency (us).\r\n",
+};
+
+static shell_command_t mDkChannelsCmd =
+{
+    .pcCommand = "dkch",
+    .cExpectedNumberOfParameters = 0,
+    .pFuncCallBack = ShellDkChannels_Command,
+    .pcHelpString = "\r\n\"dkch\": DK L2CAP channels of each peer and traffic per class.\r\n",
+};
+
+static shell_command_t mEventPoolCmd =
+{
+    .pcCommand = "evpool",
+    .cExpectedNumberOfParameters = 0,
+    .pFuncCallBack = ShellEventPool_Command,
+    .pcHelpString = "\r\n\"evpool\": Application event block pools: use, high-water mark and failures.\r\n",
+};
+
+static shell_command_t mAppQueueCmd =
+{
+    .pcCommand = "appq",
+    .cExpectedNumberOfParameters = SHELL_IGNORE_PARAMETER_COUNT,
+    .pFuncCallBack = ShellAppQueue_Command,
+    .pcHelpString = "\r\n\"appq [reset]\": Application task queues: depth, messages per wake, queueing latency (us).\r\n",
+};
+
+static shell_command_t mNvmStatsCmd =
+{
+    .pcCommand = "nvmstat",
+    .cExpectedNumberOfParameters = SHELL_IGNORE_PARAMETER_COUNT,
+    .pFuncCallBack = ShellNvmStats_Command,
+    .pcHelpString = "\r\n\"nvmstat [flush]\": System parameter records saved and avoided by write coalescing, boot load time.\r\n",
+};
+
+static shell_command_t mCountersCmd =
+{
+    .pcCommand = "counters",
+    .cExpectedNumberOfParameters = SHELL_IGNORE_PARAMETER_COUNT,
+    .pFuncCallBack = ShellCounters_Command,
+    .pcHelpString = "\r\n\"counters [checkpoint|compact]\": Lifetime counters and their NVM journal.\r\n",
+};
+
+#if defined(gAppDiagStream_d) && (gAppDiagStream_d == 1)
+static shell_command_t mDiagCmd =
+{
+    .pcCommand = "diag",
+    .cExpectedNumberOfParameters = 0,
+    .pFuncCallBack = ShellDiag_Command,
+    .pcHelpString = "\r\n\"diag\": Diagnostics stream: changes, frames, rate limited frames, notifications and bytes.\r\n",
+};
+#endif
+
+#if defined(gGattCaching_d) && (gGattCaching_d == 1)
+static shell_command_t mGattCacheCmd =
+{
+    .pcCommand = "gattcache",
+    .cExpectedNumberOfParameters = 0,
+    .pFuncCallBack = ShellGattCache_Command,
+    .pcHelpString = "\r\n\"gattcache\": Database Hash computation, change-unaware bonds and Service Changed indications.\r\n",
+};
+#endif
+
+#if defined(gAppShellBatch_d) && (gAppShellBatch_d == 1)
+static shell_command_t mBatchCmd =
+{
+    .pcCommand = "batch",
+    .cExpectedNumberOfParameters = 0,
+    .pFuncCallBack = ShellBatch_Command,
+    .pcHelpString = "\r\n\"batch\": Binary batch commands: frames, commands, failures and frames dropped.\r\n",
+};
+#endif
+
+#if defined(gAppLatencyRecorder_d) && (gAppLatencyRecorder_d == 1)
+static shell_command_t mLatencyCmd =
+{
+    .pcCommand = "lat",
+    .cExpectedNumberOfParameters = SHELL_IGNORE_PARAMETER_COUNT,
+    .pFuncCallBack = ShellLatency_Command,
+    .pcHelpString = "\r\n\"lat [reset]\": Dump CCC phase latencies per peer and min/avg/max statistics (us).\r\n",
+};
+#endif
+
+#if defined(gAppTrace_d) && (gAppTrace_d == 1)
+static shell_command_t mTraceCmd =
+{
+    .pcCommand = "trace",
+    .cExpectedNumberOfParameters = SHELL_IGNORE_PARAMETER_COUNT,
+    .pFuncCallBack = ShellTrace_Command,
+    .pcHelpString = "\r\n\"trace [on|off|clear]\": Dump the event trace ring for tools/trace_decode, or control it.\r\n",
+};
+#endif
+
 #endif
 /************************************************************************************
 *************************************************************************************
@@ -317,6 +482,54 @@ void AppShellInit(char *prompt)
     assert(kStatus_SHELL_Success == status);
     status = SHELL_RegisterCommand((shell_handle_t)g_shellHandle, &mListBleKeysCmd);
     assert(kStatus_SHELL_Success == status);
+    status = SHELL_RegisterCommand((shell_handle_t)g_shellHandle, &mEcdsaSelfTestCmd);
+    assert(kStatus_SHELL_Success == status);
+    status = SHELL_RegisterCommand((shell_handle_t)g_shellHandle, &mSetCredentialCmd);
+    assert(kStatus_SHELL_Success == status);
+    status = SHELL_RegisterCommand((shell_handle_t)g_shellHandle, &mRkeStatsCmd);
+    assert(kStatus_SHELL_Success == status);
+    status = SHELL_RegisterCommand((shell_handle_t)g_shellHandle, &mDkChannelsCmd);
+    assert(kStatus_SHELL_Success == status);
+    status = SHELL_RegisterCommand((shell_handle_t)g_shellHandle, &mEventPoolCmd);
+    assert(kStatus_SHELL_Success == status);
+    status = SHELL_RegisterCommand((shell_handle_t)g_shellHandle, &mAppQueueCmd);
+    assert(kStatus_SHELL_Success == status);
+    status = SHELL_RegisterCommand((shell_handle_t)g_shellHandle, &mNvmStatsCmd);
+    assert(kStatus_SHELL_Success == status);
+    status = SHELL_RegisterCommand((shell_handle_t)g_shellHandle, &mCountersCmd);
+    assert(kStatus_SHELL_Success == status);
+#if defined(gAppDiagStream_d) && (gAppDiagStream_d == 1)
+    status = SHELL_RegisterCommand((shell_handle_t)g_shellHandle, &mDiagCmd);
+    assert(kStatus_SHELL_Success == status);
+#endif
+#if defined(gGattCaching_d) && (gGattCaching_d == 1)
+    status = SHELL_RegisterCommand((shell_handle_t)g_shellHandle, &mGattCacheCmd);
+    assert(kStatus_SHELL_Success == status);
+#endif
+#if defined(gAppShellBatch_d) && (gAppShellBatch_d == 1)
+    status = SHELL_RegisterCommand((shell_handle_t)g_shellHandle, &mBatchCmd);
+    assert(kStatus_SHELL_Success == status);
+
+    /* Binary batch commands, on the second serial manager instance */
+    App_ShellBatchRegister((uint8_t)gAppShellBatchVersion_c, ShellBatchVersion);
+    App_ShellBatchRegister((uint8_t)gAppShellBatchGetParam_c, ShellBatchGetParam);
+    App_ShellBatchRegister((uint8_t)gAppShellBatchSetParam_c, ShellBatchSetParam);
+    App_ShellBatchRegister((uint8_t)gAppShellBatchGetParams_c, ShellBatchGetParams);
+    App_ShellBatchRegister((uint8_t)gAppShellBatchSetParams_c, ShellBatchSetParams);
+    App_ShellBatchRegister((uint8_t)gAppShellBatchRkeLock_c, ShellBatchRkeLock);
+    App_ShellBatchRegister((uint8_t)gAppShellBatchRkeUnlock_c, ShellBatchRkeUnlock);
+    App_ShellBatchRegister((uint8_t)gAppShellBatchRkeRelease_c, ShellBatchRkeRelease);
+    App_ShellBatchRegister((uint8_t)gAppShellBatchDisconnect_c, ShellBatchDisconnect);
+    App_ShellBatchInit();
+#endif
+#if defined(gAppLatencyRecorder_d) && (gAppLatencyRecorder_d == 1)
+    status = SHELL_RegisterCommand((shell_handle_t)g_shellHandle, &mLatencyCmd);
+    assert(kStatus_SHELL_Success == status);
+#endif
+#if defined(gAppTrace_d) && (gAppTrace_d == 1)
+    status = SHELL_RegisterCommand((shell_handle_t)g_shellHandle, &mTraceCmd);
+    assert(kStatus_SHELL_Success == status);
+#endif
 #endif
 }
 
@@ -370,7 +583,7 @@ static shell_status_t ShellSetBondingData_Command(shell_handle_t shellHandle, in
     {
         if(mpfBleEventHandler != NULL)
         {
-            appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t) + sizeof(appBondingData_t));
+            appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t) + sizeof(appBondingData_t));
             if(pEventData != NULL)
             {
                 pEventData->appEvent = mAppEvt_Shell_SetBondingData_Command_c;
@@ -403,7 +616,7 @@ static shell_status_t ShellSetBondingData_Command(shell_handle_t shellHandle, in
 
                 if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                 {
-                    (void)MEM_BufferFree(pEventData);
+                    App_EventFree(pEventData);
                 }
             }
         }
@@ -429,13 +642,13 @@ static shell_status_t ShellListBondedDev_Command(shell_handle_t shellHandle, int
 {
     if(mpfBleEventHandler != NULL)
     {
-        appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+        appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
         if(pEventData != NULL)
         {
             pEventData->appEvent = mAppEvt_Shell_ListBondedDev_Command_c;
             if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
             {
-                (void)MEM_BufferFree(pEventData);
+                App_EventFree(pEventData);
             }
         }
     }
@@ -456,7 +669,7 @@ static shell_status_t ShellRemoveBondedDev_Command(shell_handle_t shellHandle, i
     {
         if(mpfBleEventHandler != NULL)
         {
-            appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+            appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
             if(pEventData != NULL)
             {
                 pEventData->appEvent = mAppEvt_Shell_RemoveBondedDev_Command_c;
@@ -466,7 +679,7 @@ static shell_status_t ShellRemoveBondedDev_Command(shell_handle_t shellHandle, i
                     pEventData->eventData.peerDeviceId = (uint8_t)*argv[1];
                     if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
                     {
-                        (void)MEM_BufferFree(pEventData);
+                        App_EventFree(pEventData);
                     }
                 }
             }
@@ -519,13 +732,13 @@ static void ShellResetTimeoutTimerCallback(void* pParam)
 {
     if(mpfBleEventHandler != NULL)
     {
-        appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+        appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
         if(pEventData != NULL)
         {
             pEventData->appEvent = mAppEvt_Shell_Reset_Command_c;
             if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
             {
-                (void)MEM_BufferFree(pEventData);
+                App_EventFree(pEventData);
             }
         }
     }
@@ -539,13 +752,13 @@ static shell_status_t ShellFactoryReset_Command(shell_handle_t shellHandle, int3
 {
     if(mpfBleEventHandler != NULL)
     {
-        appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+        appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
         if(pEventData != NULL)
         {
             pEventData->appEvent = mAppEvt_Shell_FactoryReset_Command_c;
             if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
             {
-                (void)MEM_BufferFree(pEventData);
+                App_EventFree(pEventData);
             }
         }
     }
@@ -560,13 +773,13 @@ static shell_status_t ShellStartDiscovery_Command(shell_handle_t shellHandle, in
 {
     if(mpfBleEventHandler != NULL)
     {
-        appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+        appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
         if(pEventData != NULL)
         {
             pEventData->appEvent = mAppEvt_Shell_ShellStartDiscovery_Command_c;
             if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
             {
-                (void)MEM_BufferFree(pEventData);
+                App_EventFree(pEventData);
             }
         }
     }
@@ -581,13 +794,13 @@ static shell_status_t ShellStopDiscovery_Command(shell_handle_t shellHandle, int
 {
     if(mpfBleEventHandler != NULL)
     {
-        appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+        appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
         if(pEventData != NULL)
         {
             pEventData->appEvent = mAppEvt_Shell_StopDiscovery_Command_c;
             if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
             {
-                (void)MEM_BufferFree(pEventData);
+                App_EventFree(pEventData);
             }
         }
     }
@@ -602,13 +815,13 @@ static shell_status_t ShellDisconnect_Command(shell_handle_t shellHandle, int32_
 {
     if(mpfBleEventHandler != NULL)
     {
-        appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+        appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
         if(pEventData != NULL)
         {
             pEventData->appEvent = mAppEvt_Shell_Disconnect_Command_c;
             if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
             {
-                (void)MEM_BufferFree(pEventData);
+                App_EventFree(pEventData);
             }
         }
     }
@@ -624,13 +837,13 @@ static shell_status_t ShellRKELock_Command(shell_handle_t shellHandle, int32_t a
 {
     if(mpfBleEventHandler != NULL)
     {
-        appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+        appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
         if(pEventData != NULL)
         {
             pEventData->appEvent = mAppEvt_Shell_RKELock_Command_c;
             if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
             {
-                (void)MEM_BufferFree(pEventData);
+                App_EventFree(pEventData);
             }
         }
     }
@@ -646,13 +859,13 @@ static shell_status_t ShellRKEUnlock_Command(shell_handle_t shellHandle, int32_t
 {
     if(mpfBleEventHandler != NULL)
     {
-        appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+        appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
         if(pEventData != NULL)
         {
             pEventData->appEvent = mAppEvt_Shell_RKEUnlock_Command_c;
             if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
             {
-                (void)MEM_BufferFree(pEventData);
+                App_EventFree(pEventData);
             }
         }
     }
@@ -667,13 +880,13 @@ static shell_status_t ShellRKERelease_Command(shell_handle_t shellHandle, int32_
 {
     if(mpfBleEventHandler != NULL)
     {
-        appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+        appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
         if(pEventData != NULL)
         {
             pEventData->appEvent = mAppEvt_Shell_RKERelease_Command_c;
             if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
             {
-                (void)MEM_BufferFree(pEventData);
+                App_EventFree(pEventData);
             }
         }
     }
@@ -834,6 +1047,548 @@ static shell_status_t ShellGetSoftwareVersion_Command(shell_handle_t shellHandle
     return kStatus_SHELL_Success;
 }
 
+/*! *********************************************************************************
+ * \brief        RKE ECDSA known answer test (RFC 6979) and signing time.
+ *
+ ********************************************************************************** */
+static shell_status_t ShellEcdsaSelfTest_Command(shell_handle_t shellHandle, int32_t argc, char * argv[])
+{
+    uint32_t durationUs = 0U;
+    bool_t passed = CCC_EcdsaSelfTest(&durationUs);
+
+    SHELL_Printf((shell_handle_t)g_shellHandle, "ECDSA P-256 KAT %s, sign %u us\r\n",
+                 (passed == TRUE) ? "PASS" : "FAIL", durationUs);
+    return (passed == TRUE) ? kStatus_SHELL_Success : kStatus_SHELL_Error;
+}
+
+/*! *********************************************************************************
+ * \brief        Provision a CCC credential, SPAKE2+ w0 or w1 or the RKE key, 32
+ *               bytes big-endian. Saved and used from the application task.
+ *
+ ********************************************************************************** */
+static shell_status_t ShellSetCredential_Command(shell_handle_t shellHandle, int32_t argc, char * argv[])
+{
+    shell_status_t retval = kStatus_SHELL_Error;
+    uint8_t id = (uint8_t)gCccCredentialCount_c;
+    appEventData_t *pEventData;
+    cccCredentialData_t *pCredential;
+
+    if (argc == 3)
+    {
+        if (SHELL_CHECK_EQUAL_STRINGS(argv[1], "w0"))
+        {
+            id = (uint8_t)gCccCredentialW0_c;
+        }
+        else if (SHELL_CHECK_EQUAL_STRINGS(argv[1], "w1"))
+        {
+            id = (uint8_t)gCccCredentialW1_c;
+        }
+        else if (SHELL_CHECK_EQUAL_STRINGS(argv[1], "rke"))
+        {
+            id = (uint8_t)gCccCredentialRkeKey_c;
+        }
+        else
+        {
+            ; /* Usage */
+        }
+    }
+
+    if ((id < (uint8_t)gCccCredentialCount_c) && (strlen(argv[2]) == (2U * gP256ScalarSize_c)) &&
+        (BleApp_ParseHexValue(argv[2]) == gP256ScalarSize_c) && (mpfBleEventHandler != NULL))
+    {
+        pEventData = App_EventAlloc(sizeof(appEventData_t) + sizeof(cccCredentialData_t));
+        if (pEventData != NULL)
+        {
+            pEventData->appEvent = mAppEvt_Shell_SetCredential_Command_c;
+            pEventData->eventData.pData = pEventData + 1;
+            pCredential = pEventData->eventData.pData;
+            pCredential->id = id;
+            FLib_MemCpy(pCredential->aValue, argv[2], gP256ScalarSize_c);
+            if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
+            {
+                App_EventFree(pEventData);
+            }
+            else
+            {
+                retval = kStatus_SHELL_Success;
+            }
+        }
+    }
+    else
+    {
+        shell_write("\r\nUsage: \
+                    \r\nsetcred <w0|w1|rke> <64 hex digits, big-endian> \
+                    \r\n");
+    }
+    return retval;
+}
+
+/*! *********************************************************************************
+ * \brief        Dump the RKE queue counters. "rkestat reset" clears them.
+ *
+ ********************************************************************************** */
+static shell_status_t ShellRkeStats_Command(shell_handle_t shellHandle, int32_t argc, char * argv[])
+{
+    shell_status_t retval = kStatus_SHELL_Success;
+    const appRkeStats_t *pStats = App_RkeGetStats();
+
+    if ((argc == 2) && SHELL_CHECK_EQUAL_STRINGS(argv[1], "reset"))
+    {
+        App_RkeResetStats();
+    }
+    else if (argc == 1)
+    {
+        SHELL_Printf((shell_handle_t)g_shellHandle, "presses %u coalesced %u superseded %u dropped %u\r\n",
+                     pStats->presses, pStats->coalesced, pStats->superseded, pStats->dropped);
+        SHELL_Printf((shell_handle_t)g_shellHandle, "sent %u retries %u timeouts %u acked %u\r\n",
+                     pStats->sent, pStats->retries, pStats->timeouts, pStats->acked);
+        if (pStats->acked != 0U)
+        {
+            SHELL_Printf((shell_handle_t)g_shellHandle, "latency min %u avg %u max %u\r\n",
+                         pStats->latencyMin, (uint32_t)(pStats->latencySum / pStats->acked), pStats->latencyMax);
+        }
+    }
+    else
+    {
+        retval = kStatus_SHELL_Error;
+    }
+    if(kStatus_SHELL_Error == retval)
+    {
+        shell_write("ERROR\n\r");
+    }
+    return retval;
+}
+
+/*! *********************************************************************************
+ * \brief        Dump the DK L2CAP channels and the traffic of each class.
+ *
+ ********************************************************************************** */
+static shell_status_t ShellDkChannels_Command(shell_handle_t shellHandle, int32_t argc, char * argv[])
+{
+    static const char * const aClassName[gAppDkClassCount_c] = {"control", "bulk"};
+    const appDkChannelStats_t *pStats;
+    deviceId_t peerId;
+    uint8_t i;
+
+    for (peerId = 0U; peerId < (deviceId_t)gAppMaxConnections_c; peerId++)
+    {
+        SHELL_Printf((shell_handle_t)g_shellHandle, "peer %d cid:", peerId);
+        for (i = 0U; i < gAppDkChannelsPerPeer_c; i++)
+        {
+            SHELL_Printf((shell_handle_t)g_shellHandle, " 0x%04x", App_DkChannelGetCid(peerId, i));
+        }
+        shell_write("\r\n");
+        for (i = 0U; i < (uint8_t)gAppDkClassCount_c; i++)
+        {
+            pStats = App_DkChannelGetStats(peerId, (appDkChannelClass_t)i);
+            SHELL_Printf((shell_handle_t)g_shellHandle, "  %-8s msg %u bytes %u fallback %u\r\n",
+                         aClassName[i], pStats->messages, pStats->bytes, pStats->fallbacks);
+        }
+    }
+    return kStatus_SHELL_Success;
+}
+
+/*! *********************************************************************************
+ * \brief        Dump the application event block pools.
+ *
+ ********************************************************************************** */
+static shell_status_t ShellEventPool_Command(shell_handle_t shellHandle, int32_t argc, char * argv[])
+{
+    const appEventPoolStats_t *pStats;
+    uint8_t i;
+
+    for (i = 0U; i < gAppEventPoolClasses_c; i++)
+    {
+        pStats = App_EventPoolGetStats(i);
+        SHELL_Printf((shell_handle_t)g_shellHandle, "%3u B x%-3u in use %u high %u allocs %u failures %u\r\n",
+                     pStats->blockSize, pStats->blockCount, pStats->inUse, pStats->highWater,
+                     pStats->allocs, pStats->failures);
+    }
+    SHELL_Printf((shell_handle_t)g_shellHandle, "heap allocs %u\r\n", App_EventPoolGetHeapAllocs());
+    return kStatus_SHELL_Success;
+}
+
+/*! *********************************************************************************
+ * \brief        Dump the application task queue counters. "appq reset" clears them.
+ *
+ ********************************************************************************** */
+static shell_status_t ShellAppQueue_Command(shell_handle_t shellHandle, int32_t argc, char * argv[])
+{
+    static const char * const aQueueName[gAppQueueCount_c] = {"host", "control", "conn", "house"};
+    shell_status_t retval = kStatus_SHELL_Success;
+    const appQueueStats_t *pStats;
+    uint32_t i;
+    uint32_t j;
+
+    if ((argc == 2) && SHELL_CHECK_EQUAL_STRINGS(argv[1], "reset"))
+    {
+        App_ResetQueueStats();
+    }
+    else if (argc == 1)
+    {
+        for (i = 0U; i < (uint32_t)gAppQueueCount_c; i++)
+        {
+            pStats = App_GetQueueStats((appQueueId_t)i);
+            SHELL_Printf((shell_handle_t)g_shellHandle, "%-8s msg %u wakes %u depth %u max %u latency max %u promoted %u\r\n",
+                         aQueueName[i], pStats->messages, pStats->wakes, pStats->depth, pStats->maxDepth,
+                         pStats->maxLatencyUs, pStats->promoted);
+            for (j = 0U; j < gAppQueueLatencyBuckets_c; j++)
+            {
+                if (pStats->aLatency[j] != 0U)
+                {
+                    if (j < (gAppQueueLatencyBuckets_c - 1U))
+                    {
+                        SHELL_Printf((shell_handle_t)g_shellHandle, "  <%-7u %u\r\n",
+                                     gAppQueueLatencyFirstUs_c << j, pStats->aLatency[j]);
+                    }
+                    else
+                    {
+                        SHELL_Printf((shell_handle_t)g_shellHandle, "  >=%-6u %u\r\n",
+                                     gAppQueueLatencyFirstUs_c << (j - 1U), pStats->aLatency[j]);
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        retval = kStatus_SHELL_Error;
+    }
+    if(kStatus_SHELL_Error == retval)
+    {
+        shell_write("ERROR\n\r");
+    }
+    return retval;
+}
+
+/*! *********************************************************************************
+ * \brief        Dump the system parameter persistence counters. "nvmstat flush"
+ *               saves the pending changes now.
+ *
+ ********************************************************************************** */
+static shell_status_t ShellNvmStats_Command(shell_handle_t shellHandle, int32_t argc, char * argv[])
+{
+    shell_status_t retval = kStatus_SHELL_Success;
+    const appNvmParamStats_t *pStats = App_NvmGetParamStats();
+
+    if ((argc == 2) && SHELL_CHECK_EQUAL_STRINGS(argv[1], "flush"))
+    {
+        if (gBleSuccess_c != App_NvmFlushSystemParams(FALSE))
+        {
+            retval = kStatus_SHELL_Error;
+        }
+    }
+    else if (argc == 1)
+    {
+        SHELL_Printf((shell_handle_t)g_shellHandle, "changes %u flushes %u saved %u avoided %u errors %u\r\n",
+                     pStats->changes, pStats->flushes, pStats->recordsSaved, pStats->recordsAvoided, pStats->errors);
+        SHELL_Printf((shell_handle_t)g_shellHandle, "boot: layout %u defaults %u load %u us host init %u us\r\n",
+                     pStats->loadVersion, pStats->loadDefaults, pStats->loadUs, BleApp_GetHostInitializedUs());
+    }
+    else
+    {
+        retval = kStatus_SHELL_Error;
+    }
+    if(kStatus_SHELL_Error == retval)
+    {
+        shell_write("ERROR\n\r");
+    }
+    return retval;
+}
+
+/*! *********************************************************************************
+ * \brief        Dump the lifetime counters and their journal. "counters checkpoint"
+ *               writes a delta record now, "counters compact" a base record.
+ *
+ ********************************************************************************** */
+static shell_status_t ShellCounters_Command(shell_handle_t shellHandle, int32_t argc, char * argv[])
+{
+    shell_status_t retval = kStatus_SHELL_Success;
+    const appCounterStats_t *pStats = App_CountersGetStats();
+
+    if ((argc == 2) && SHELL_CHECK_EQUAL_STRINGS(argv[1], "checkpoint"))
+    {
+        App_CountersCheckpoint();
+    }
+    else if ((argc == 2) && SHELL_CHECK_EQUAL_STRINGS(argv[1], "compact"))
+    {
+        App_CountersCompact(gAppCounterCompactUser_c);
+    }
+    else if (argc == 1)
+    {
+        SHELL_Printf((shell_handle_t)g_shellHandle, "steps %u rke %u connections %u ranging %u\r\n",
+                     App_CounterGet(gAppCounterSteps_c), App_CounterGet(gAppCounterRke_c),
+                     App_CounterGet(gAppCounterConnections_c), App_CounterGet(gAppCounterRanging_c));
+        SHELL_Printf((shell_handle_t)g_shellHandle, "checkpoints %u compactions %u (last reason %u) replayed %u errors %u\r\n",
+                     pStats->checkpoints, pStats->compactions, pStats->lastCompactReason, pStats->replayed, pStats->errors);
+    }
+    else
+    {
+        retval = kStatus_SHELL_Error;
+    }
+    if(kStatus_SHELL_Error == retval)
+    {
+        shell_write("ERROR\n\r");
+    }
+    return retval;
+}
+
+#if defined(gAppDiagStream_d) && (gAppDiagStream_d == 1)
+/*! *********************************************************************************
+ * \brief        Dump the diagnostics stream counters.
+ *
+ ********************************************************************************** */
+static shell_status_t ShellDiag_Command(shell_handle_t shellHandle, int32_t argc, char * argv[])
+{
+    const appDiagStats_t *pStats = App_DiagGetStats();
+
+    SHELL_Printf((shell_handle_t)g_shellHandle, "updates %u changes %u frames %u deferred %u\r\n",
+                 pStats->updates, pStats->changes, pStats->frames, pStats->deferred);
+    SHELL_Printf((shell_handle_t)g_shellHandle, "notifications %u bytes %u\r\n",
+                 pStats->notifications, pStats->bytes);
+    return kStatus_SHELL_Success;
+}
+#endif /* gAppDiagStream_d */
+
+#if defined(gGattCaching_d) && (gGattCaching_d == 1)
+/*! *********************************************************************************
+ * \brief        Dump the GATT caching state of the bonds.
+ *
+ ********************************************************************************** */
+static shell_status_t ShellGattCache_Command(shell_handle_t shellHandle, int32_t argc, char * argv[])
+{
+    const appGattCacheStats_t *pStats = App_GattCacheGetStats();
+
+    SHELL_Printf((shell_handle_t)g_shellHandle, "hash %u us changed %u change-unaware bonds 0x%x\r\n",
+                 pStats->hashUs, pStats->dbChanged, App_GattCacheChangeUnaware());
+    SHELL_Printf((shell_handle_t)g_shellHandle, "service changed %u confirmed %u hash reads %u errors %u\r\n",
+                 pStats->indications, pStats->confirmations, pStats->hashReads, pStats->errors);
+    return kStatus_SHELL_Success;
+}
+#endif /* gGattCaching_d */
+
+#if defined(gAppShellBatch_d) && (gAppShellBatch_d == 1)
+/*! *********************************************************************************
+ * \brief        Dump the binary batch commands counters.
+ *
+ ********************************************************************************** */
+static shell_status_t ShellBatch_Command(shell_handle_t shellHandle, int32_t argc, char * argv[])
+{
+    const appShellBatchStats_t *pStats = App_ShellBatchGetStats();
+
+    SHELL_Printf((shell_handle_t)g_shellHandle, "frames %u replayed %u commands %u failed %u\r\n",
+                 pStats->frames, pStats->replays, pStats->commands, pStats->failed);
+    SHELL_Printf((shell_handle_t)g_shellHandle, "dropped: crc %u length %u timeout %u busy bytes %u\r\n",
+                 pStats->crcErrors, pStats->badLengths, pStats->timeouts, pStats->busy);
+    return kStatus_SHELL_Success;
+}
+
+/*! *********************************************************************************
+ * \brief        Batch: the software version.
+ *
+ ********************************************************************************** */
+static appShellBatchStatus_t ShellBatchVersion(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult)
+{
+    appShellBatchStatus_t status = gAppShellBatchOk_c;
+    uint8_t length = (uint8_t)(sizeof(SOFTWARE_VERSION) - 1U);
+
+    (void)pArgs;
+    if (argsLength != 0U)
+    {
+        status = gAppShellBatchBadArgs_c;
+    }
+    else if (length > pResult->size)
+    {
+        status = gAppShellBatchNoRoom_c;
+    }
+    else
+    {
+        FLib_MemCpy(pResult->pValue, SOFTWARE_VERSION, length);
+        pResult->type = (uint8_t)gAppShellBatchString_c;
+        pResult->length = length;
+    }
+    return status;
+}
+
+/*! *********************************************************************************
+ * \brief        Batch: parameter ID, its value.
+ *
+ ********************************************************************************** */
+static appShellBatchStatus_t ShellBatchGetParam(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult)
+{
+    appShellBatchStatus_t status = gAppShellBatchOk_c;
+    systemParameters_t *pSysParams = NULL;
+    uint32_t value;
+
+    if ((argsLength != 1U) || (pArgs[0] >= (uint8_t)ParamMaxID))
+    {
+        status = gAppShellBatchBadArgs_c;
+    }
+    else if (pResult->size < sizeof(int32_t))
+    {
+        status = gAppShellBatchNoRoom_c;
+    }
+    else if (gBleSuccess_c != App_NvmReadSystemParams(&pSysParams))
+    {
+        status = gAppShellBatchFailed_c;
+    }
+    else
+    {
+        value = pSysParams->system_params.buffer[pArgs[0]];
+        pResult->pValue[0] = (uint8_t)value;
+        pResult->pValue[1] = (uint8_t)(value >> 8U);
+        pResult->pValue[2] = (uint8_t)(value >> 16U);
+        pResult->pValue[3] = (uint8_t)(value >> 24U);
+        pResult->type = (uint8_t)gAppShellBatchInt32_c;
+        pResult->length = (uint8_t)sizeof(int32_t);
+    }
+    return status;
+}
+
+/*! *********************************************************************************
+ * \brief        Batch: parameter ID and value, set and saved as the set shell
+ *               command does. Out of the parameter bounds: Failed.
+ *
+ ********************************************************************************** */
+static appShellBatchStatus_t ShellBatchSetParam(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult)
+{
+    appShellBatchStatus_t status = gAppShellBatchOk_c;
+    uint32_t value;
+
+    (void)pResult;
+    if ((argsLength != (1U + sizeof(int32_t))) || (pArgs[0] >= (uint8_t)ParamMaxID))
+    {
+        status = gAppShellBatchBadArgs_c;
+    }
+    else
+    {
+        value = (uint32_t)pArgs[1] | ((uint32_t)pArgs[2] << 8U) | ((uint32_t)pArgs[3] << 16U) | ((uint32_t)pArgs[4] << 24U);
+        if (gBleSuccess_c != App_NvmWriteSystemParam((systemParamID_t)pArgs[0], (int32_t)value))
+        {
+            status = gAppShellBatchFailed_c;
+        }
+    }
+    return status;
+}
+
+/*! *********************************************************************************
+ * \brief        Batch: every parameter, the params_tlv record.
+ *
+ ********************************************************************************** */
+static appShellBatchStatus_t ShellBatchGetParams(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult)
+{
+    appShellBatchStatus_t status = gAppShellBatchOk_c;
+    uint16_t length;
+
+    (void)pArgs;
+    if (argsLength != 0U)
+    {
+        status = gAppShellBatchBadArgs_c;
+    }
+    else
+    {
+        length = App_ParamsTlvEncode(pResult->pValue, pResult->size);
+        if (length == 0U)
+        {
+            status = gAppShellBatchNoRoom_c;
+        }
+        else
+        {
+            pResult->type = (uint8_t)gAppShellBatchBytes_c;
+            pResult->length = (uint8_t)length;
+        }
+    }
+    return status;
+}
+
+/*! *********************************************************************************
+ * \brief        Batch: a params_tlv record, applied whole or not at all, with
+ *               one NVM save. The params_tlv_status record is the result.
+ *
+ ********************************************************************************** */
+static appShellBatchStatus_t ShellBatchSetParams(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult)
+{
+    appShellBatchStatus_t status = gAppShellBatchOk_c;
+    uint16_t length = 0U;
+
+    if (gAttErrCodeNoError_c != App_ParamsTlvWrite(pArgs, argsLength))
+    {
+        status = gAppShellBatchFailed_c;
+    }
+    if (gBleSuccess_c == GattDb_ReadAttribute((uint16_t)value_params_tlv_status, pResult->size, pResult->pValue, &length))
+    {
+        pResult->type = (uint8_t)gAppShellBatchBytes_c;
+        pResult->length = (uint8_t)length;
+    }
+    return status;
+}
+
+/*! *********************************************************************************
+ * \brief        Batch: the RKE and connection commands, posted to the
+ *               application as the text ones are.
+ *
+ ********************************************************************************** */
+static appShellBatchStatus_t ShellBatchRkeLock(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult)
+{
+    (void)pArgs;
+    (void)pResult;
+    return ShellBatchPostEvent(mAppEvt_Shell_RKELock_Command_c, argsLength);
+}
+
+static appShellBatchStatus_t ShellBatchRkeUnlock(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult)
+{
+    (void)pArgs;
+    (void)pResult;
+    return ShellBatchPostEvent(mAppEvt_Shell_RKEUnlock_Command_c, argsLength);
+}
+
+static appShellBatchStatus_t ShellBatchRkeRelease(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult)
+{
+    (void)pArgs;
+    (void)pResult;
+    return ShellBatchPostEvent(mAppEvt_Shell_RKERelease_Command_c, argsLength);
+}
+
+static appShellBatchStatus_t ShellBatchDisconnect(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult)
+{
+    (void)pArgs;
+    (void)pResult;
+    return ShellBatchPostEvent(mAppEvt_Shell_Disconnect_Command_c, argsLength);
+}
+
+static appShellBatchStatus_t ShellBatchPostEvent(appEvent_t event, uint8_t argsLength)
+{
+    appShellBatchStatus_t status = gAppShellBatchFailed_c;
+    appEventData_t *pEventData;
+
+    if (argsLength != 0U)
+    {
+        status = gAppShellBatchBadArgs_c;
+    }
+    else if (mpfBleEventHandler != NULL)
+    {
+        pEventData = App_EventAlloc(sizeof(appEventData_t));
+        if (pEventData != NULL)
+        {
+            pEventData->appEvent = event;
+            if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
+            {
+                App_EventFree(pEventData);
+            }
+            else
+            {
+                status = gAppShellBatchOk_c;
+            }
+        }
+    }
+    else
+    {
+        ; /* No action required */
+    }
+    return status;
+}
+#endif /* gAppShellBatch_d */
+
 /*! *********************************************************************************
  * \brief        Trigger simulated motion sensor events.
  *
@@ -918,13 +1673,13 @@ static shell_status_t ShellResetAfterDisconnection_Command(shell_handle_t shellH
 {
     if(mpfBleEventHandler != NULL)
     {
-        appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+        appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
         if(pEventData != NULL)
         {
             pEventData->appEvent = mAppEvt_Shell_ResetAfterDisconnection_Command_c;
             if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
             {
-                (void)MEM_BufferFree(pEventData);
+                App_EventFree(pEventData);
             }
         }
     }
@@ -939,13 +1694,13 @@ static shell_status_t ShellSwitchGAPRole_Command(shell_handle_t shellHandle, int
 {
     if(mpfBleEventHandler != NULL)
     {
-        appEventData_t *pEventData = MEM_BufferAlloc(sizeof(appEventData_t));
+        appEventData_t *pEventData = App_EventAlloc(sizeof(appEventData_t));
         if(pEventData != NULL)
         {
             pEventData->appEvent = mAppEvt_Shell_SwitchGAPRole_Command_c;
             if (gBleSuccess_c != App_PostCallbackMessage(mpfBleEventHandler, pEventData))
             {
-                (void)MEM_BufferFree(pEventData);
+                App_EventFree(pEventData);
             }
         }
     }
@@ -994,6 +1749,148 @@ static shell_status_t ShellListBleKeys_Command(shell_handle_t shellHandle, int32
     return retval;
 }
 
+#if defined(gAppLatencyRecorder_d) && (gAppLatencyRecorder_d == 1)
+/*! *********************************************************************************
+ * \brief        Dump the CCC latency milestones of each peer and the aggregated
+ *               phase statistics. "lat reset" clears the statistics.
+ *
+ ********************************************************************************** */
+static shell_status_t ShellLatency_Command(shell_handle_t shellHandle, int32_t argc, char * argv[])
+{
+    shell_status_t retval = kStatus_SHELL_Success;
+    const appLatencyRecord_t *pRecord;
+    appLatencyMilestone_t milestone;
+    appLatencyMilestone_t prev;
+    deviceId_t peerId;
+    uint32_t m;
+
+    if ((argc == 2) && SHELL_CHECK_EQUAL_STRINGS(argv[1], "reset"))
+    {
+        App_LatencyResetStats();
+    }
+    else if (argc == 1)
+    {
+        for (peerId = 0U; peerId < (deviceId_t)gAppMaxConnections_c; peerId++)
+        {
+            pRecord = App_LatencyGetRecord(peerId);
+            if ((pRecord != NULL) && (pRecord->reachedMask != 0U))
+            {
+                SHELL_Printf((shell_handle_t)g_shellHandle, "peer %d:\r\n", peerId);
+                /* In the order reached, each against the previous one */
+                prev = mLatencyMilestoneMax_c;
+                for (milestone = App_LatencyGetNext(pRecord, mLatencyMilestoneMax_c); milestone < mLatencyMilestoneMax_c;
+                     milestone = App_LatencyGetNext(pRecord, milestone))
+                {
+                    SHELL_Printf((shell_handle_t)g_shellHandle, "  %-18s +%u\r\n",
+                                 App_LatencyGetName(milestone),
+                                 (prev == mLatencyMilestoneMax_c) ? 0U :
+                                 (uint32_t)(pRecord->aTimestamp[milestone] - pRecord->aTimestamp[prev]));
+                    prev = milestone;
+                }
+            }
+        }
+
+        SHELL_Printf((shell_handle_t)g_shellHandle, "%-18s %6s %9s %9s %9s  hist(<ms:", "phase", "n", "min", "avg", "max");
+        for (m = 0U; m < (gAppLatencyHistBuckets_c - 1U); m++)
+        {
+            SHELL_Printf((shell_handle_t)g_shellHandle, " %u", App_LatencyGetBucketLimitMs((uint8_t)m));
+        }
+        shell_write(" inf)\r\n");
+        for (m = 1U; m < (uint32_t)mLatencyMilestoneMax_c; m++)
+        {
+            ShellLatencyPrintStats(App_LatencyGetName((appLatencyMilestone_t)m), App_LatencyGetStats((appLatencyMilestone_t)m));
+        }
+        ShellLatencyPrintStats("total", App_LatencyGetTotalStats());
+    }
+    else
+    {
+        retval = kStatus_SHELL_Error;
+    }
+    if(kStatus_SHELL_Error == retval)
+    {
+        shell_write("ERROR\n\r");
+    }
+    return retval;
+}
+
+/*! *********************************************************************************
+ * \brief        Print one line of phase statistics.
+ *
+ ********************************************************************************** */
+static void ShellLatencyPrintStats(const char *pName, const appLatencyStats_t *pStats)
+{
+    uint8_t i;
+
+    if ((pStats != NULL) && (pStats->count != 0U))
+    {
+        SHELL_Printf((shell_handle_t)g_shellHandle, "%-18s %6u %9u %9u %9u ",
+                     pName, pStats->count, pStats->min,
+                     (uint32_t)(pStats->sum / pStats->count), pStats->max);
+        for (i = 0U; i < gAppLatencyHistBuckets_c; i++)
+        {
+            SHELL_Printf((shell_handle_t)g_shellHandle, " %u", pStats->aHistogram[i]);
+        }
+        shell_write("\r\n");
+    }
+}
+#endif /* gAppLatencyRecorder_d */
+
+#if defined(gAppTrace_d) && (gAppTrace_d == 1)
+/*! *********************************************************************************
+ * \brief        Dump the event trace ring, oldest entry first, one "T" line per
+ *               entry. Tracing is paused during the dump.
+ *
+ ********************************************************************************** */
+static shell_status_t ShellTrace_Command(shell_handle_t shellHandle, int32_t argc, char * argv[])
+{
+    shell_status_t retval = kStatus_SHELL_Success;
+    const appTraceEntry_t *pEntry;
+    bool_t wasEnabled;
+    uint32_t count;
+    uint32_t i;
+
+    if ((argc == 2) && SHELL_CHECK_EQUAL_STRINGS(argv[1], "on"))
+    {
+        App_TraceEnable(TRUE);
+    }
+    else if ((argc == 2) && SHELL_CHECK_EQUAL_STRINGS(argv[1], "off"))
+    {
+        App_TraceEnable(FALSE);
+    }
+    else if ((argc == 2) && SHELL_CHECK_EQUAL_STRINGS(argv[1], "clear"))
+    {
+        wasEnabled = App_TraceIsEnabled();
+        App_TraceEnable(FALSE);
+        App_TraceClear();
+        App_TraceEnable(wasEnabled);
+    }
+    else if (argc == 1)
+    {
+        wasEnabled = App_TraceIsEnabled();
+        App_TraceEnable(FALSE);
+        count = App_TraceGetCount();
+        SHELL_Printf((shell_handle_t)g_shellHandle, "trace hz %u count %u\r\n", SystemCoreClock, count);
+        for (i = 0U; i < count; i++)
+        {
+            pEntry = App_TraceGetEntry(i);
+            SHELL_Printf((shell_handle_t)g_shellHandle, "T %08x %02x %04x %08x %08x\r\n",
+                         pEntry->cycles, pEntry->task, pEntry->event, pEntry->arg0, pEntry->arg1);
+        }
+        shell_write("trace end\r\n");
+        App_TraceEnable(wasEnabled);
+    }
+    else
+    {
+        retval = kStatus_SHELL_Error;
+    }
+    if(kStatus_SHELL_Error == retval)
+    {
+        shell_write("ERROR\n\r");
+    }
+    return retval;
+}
+#endif /* gAppTrace_d */
+
 /*!*************************************************************************************************
  *  \brief  Converts a string into hex.
  *
@@ -0,0 +1,766 @@
+/*! *********************************************************************************
+* \file ccc_crypto_bench.c
+*
+* Known answer tests and host benchmark of the CCC crypto: ccc_p256.c, the
+* SPAKE2+ prover of ccc_spake2p.c (owner pairing) and the ECDSA signing of
+* ccc_ecdsa.c (RKE), with the SecLib primitives of seclib_host.c, themselves
+* checked first against their standards (FIPS 180-4, RFC 4231, RFC 4493).
+*
+* The SPAKE2+ vectors, for a fixed verifier and fixed x and y, were computed
+* with an independent reference (affine P-256 in Python, OpenSSL CMAC). The
+* exchange is then run against a vehicle side built here from the P-256 API,
+* for random scalars, and the failure paths are checked: no verifier, RNG
+* failure, wrong M1. The RNG is the tool's.
+*
+* ECDSA is checked against RFC 6979 A.2.5 (P-256, SHA-256, "sample" and
+* "test"), its signatures of random digests are verified here, and signing
+* must fail before a key is provisioned.
+*
+* The benchmark gives the time of each step of the Request and the Verify,
+* and of a signature.
+* These are host times: on target, the same steps are timed by the debug
+* traces of ccc_spake2p.c and of the RKE signature (TM time base) when
+* gAppCccStepTimes_d is set.
+*
+* Build, from the repository root:
+*   gcc -O2 -Itools/host -I. -include app_preinclude.h tools/ccc_crypto_bench/ccc_crypto_bench.c \
+*       tools/ccc_crypto_bench/seclib_host.c ccc_p256.c ccc_p256_tables.c ccc_spake2p.c ccc_ecdsa.c \
+*       -o ccc_crypto_bench
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include <stdio.h>
+#include <string.h>
+
+#include "EmbeddedTypes.h"
+#include "fsl_component_timer_manager.h"
+#include "RNG_Interface.h"
+#include "SecLib.h"
+#include "ccc_p256.h"
+#include "ccc_spake2p.h"
+#include "ccc_ecdsa.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mcInteropRounds_c           50U
+#define mcSignRounds_c              50U
+#define mcBenchRounds_c             200U
+
+#define mcApduHeaderSize_c          5U
+#define mcVerifyApduSize_c          (mcApduHeaderSize_c + 2U + gP256PointSize_c + 2U + gSpake2pKeySize_c)
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+/*! \brief  RNG of the tool: fixed bytes, failures, or a PRNG. */
+typedef struct benchRng_tag
+{
+    const uint8_t   *pFixed;            /*!< Returned once, then the PRNG */
+    uint32_t        failures;           /*!< Calls left to fail */
+    uint64_t        state;
+}benchRng_t;
+
+/*! \brief  Vehicle side of the exchange. */
+typedef struct benchVehicle_tag
+{
+    uint8_t     apdu[mcVerifyApduSize_c];
+    uint8_t     M2[gSpake2pKeySize_c];
+    uint8_t     Ke[gSpake2pKeySize_c];
+}benchVehicle_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static uint32_t Bench_Check(const char *pName, const uint8_t *pValue, const uint8_t *pExpected, uint32_t length);
+static uint32_t Bench_CheckSecLib(void);
+static uint32_t Bench_CheckP256(void);
+static uint32_t Bench_CheckSpake2p(void);
+static uint32_t Bench_CheckInterop(void);
+static uint32_t Bench_CheckEcdsa(void);
+static bool_t Bench_EcdsaVerify(const uint8_t *pPublicKey, const uint8_t *pHash, const uint8_t *pSignature);
+static void Bench_Vehicle(benchVehicle_t *pVehicle, const uint8_t *pX, const uint8_t *pY);
+static void Bench_RandomScalar(uint8_t *pScalar);
+static uint32_t Bench_Transcript(uint8_t *pOut, const uint8_t *pData, uint32_t length);
+static void Bench_Report(void);
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static benchRng_t mRng = {NULL, 0U, 0x9E3779B97F4A7C15U};
+
+static const uint8_t maRequestApdu[] = {0x80U, 0x30U, 0x00U, 0x00U};
+
+/* Verifier, x and y of the SPAKE2+ vectors */
+static const uint8_t maKatW0[gP256ScalarSize_c] =
+{
+    0x81, 0x12, 0xE4, 0xD3, 0xCC, 0x93, 0x27, 0x91, 0xAA, 0x75, 0x69, 0x65, 0x2A, 0x0D, 0xF5, 0xAA,
+    0xDF, 0x57, 0x5F, 0x71, 0x93, 0xD6, 0xA7, 0xC1, 0xEC, 0x80, 0x74, 0xB8, 0xCB, 0xD0, 0xAF, 0x9B,
+};
+
+static const uint8_t maKatW1[gP256ScalarSize_c] =
+{
+    0x97, 0x45, 0x71, 0x66, 0xB4, 0xBD, 0x11, 0x96, 0xF7, 0x3A, 0x05, 0x23, 0x8E, 0xDB, 0x95, 0xB7,
+    0x90, 0x4E, 0x6E, 0x04, 0x9B, 0x41, 0x94, 0xD9, 0xA2, 0xEC, 0xED, 0xAD, 0x67, 0xDE, 0xA2, 0xEB,
+};
+
+static const uint8_t maKatX[gP256ScalarSize_c] =
+{
+    0x1F, 0x0E, 0x2D, 0x3C, 0x4B, 0x5A, 0x69, 0x78, 0x87, 0x96, 0xA5, 0xB4, 0xC3, 0xD2, 0xE1, 0xF0,
+    0x01, 0x12, 0x23, 0x34, 0x45, 0x56, 0x67, 0x78, 0x89, 0x9A, 0xAB, 0xBC, 0xCD, 0xDE, 0xEF, 0xF0,
+};
+
+static const uint8_t maKatY[gP256ScalarSize_c] =
+{
+    0x0F, 0x1E, 0x2D, 0x3C, 0x4B, 0x5A, 0x69, 0x78, 0x87, 0x96, 0xA5, 0xB4, 0xC3, 0xD2, 0xE1, 0xF0,
+    0xFF, 0xEE, 0xDD, 0xCC, 0xBB, 0xAA, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00,
+};
+
+/* X = x*G + w0*M */
+static const uint8_t maKatShareX[gP256PointSize_c] =
+{
+    0x04, 0x81, 0xCD, 0x05, 0x7F, 0x32, 0x4E, 0xBD, 0xC9, 0x31, 0xF8, 0x22, 0x42, 0x11, 0xD0, 0x2D,
+    0x65, 0xFC, 0xA1, 0x9C, 0x15, 0x3C, 0x8C, 0x73, 0x07, 0x36, 0x8B, 0x90, 0x26, 0xCA, 0x5A, 0x30,
+    0x98, 0xA9, 0x38, 0x94, 0xFF, 0x4B, 0xCC, 0x7D, 0x72, 0xA6, 0xCC, 0x67, 0xA4, 0x42, 0x27, 0xC6,
+    0x29, 0x08, 0x5A, 0x05, 0x92, 0x21, 0xE9, 0x0F, 0x4D, 0x0F, 0xF4, 0x4A, 0x37, 0x70, 0x6A, 0x6F,
+    0x55,
+};
+
+/* Y = y*G + w0*N */
+static const uint8_t maKatShareY[gP256PointSize_c] =
+{
+    0x04, 0xF1, 0x62, 0xBC, 0x73, 0x54, 0x21, 0x00, 0x99, 0xE1, 0x41, 0xA3, 0x0E, 0x5E, 0x1C, 0x01,
+    0x85, 0x6D, 0x25, 0x3A, 0xC6, 0x48, 0xDC, 0x31, 0x06, 0x66, 0x25, 0x04, 0x73, 0x03, 0x2B, 0x47,
+    0xCD, 0x5F, 0xFB, 0xEC, 0xB3, 0x33, 0x1F, 0xEB, 0x8C, 0x15, 0x0D, 0xCC, 0xBD, 0x96, 0x2A, 0xB3,
+    0x2A, 0x05, 0xCF, 0x6E, 0xAF, 0x98, 0x57, 0xB1, 0x00, 0x43, 0x6D, 0x9B, 0x95, 0xD4, 0x74, 0x03,
+    0x12,
+};
+
+static const uint8_t maKatM1[gSpake2pKeySize_c] =
+{
+    0x48, 0x43, 0xD6, 0x7D, 0x76, 0x07, 0x52, 0xD8, 0xBA, 0x4A, 0x6D, 0xDF, 0xA3, 0x36, 0xF5, 0x9A,
+};
+
+static const uint8_t maKatM2[gSpake2pKeySize_c] =
+{
+    0x0A, 0x43, 0x86, 0x53, 0xA6, 0x42, 0xC1, 0xD7, 0x5D, 0x1F, 0x8B, 0x56, 0x15, 0x32, 0x3A, 0xB6,
+};
+
+static const uint8_t maKatKe[gSpake2pKeySize_c] =
+{
+    0xA4, 0x31, 0x9B, 0x5E, 0xF2, 0xBE, 0xF6, 0xD7, 0x1A, 0x85, 0x2F, 0x7A, 0xF0, 0xDF, 0x04, 0xF9,
+};
+
+/* RFC 6979 A.2.5: key, public key, signatures of SHA-256("sample") and SHA-256("test") */
+static const uint8_t maKatEcdsaKey[gP256ScalarSize_c] =
+{
+    0xC9, 0xAF, 0xA9, 0xD8, 0x45, 0xBA, 0x75, 0x16, 0x6B, 0x5C, 0x21, 0x57, 0x67, 0xB1, 0xD6, 0x93,
+    0x4E, 0x50, 0xC3, 0xDB, 0x36, 0xE8, 0x9B, 0x12, 0x7B, 0x8A, 0x62, 0x2B, 0x12, 0x0F, 0x67, 0x21,
+};
+
+static const uint8_t maKatEcdsaPublic[gP256PointSize_c] =
+{
+    0x04, 0x60, 0xFE, 0xD4, 0xBA, 0x25, 0x5A, 0x9D, 0x31, 0xC9, 0x61, 0xEB, 0x74, 0xC6, 0x35, 0x6D,
+    0x68, 0xC0, 0x49, 0xB8, 0x92, 0x3B, 0x61, 0xFA, 0x6C, 0xE6, 0x69, 0x62, 0x2E, 0x60, 0xF2, 0x9F,
+    0xB6, 0x79, 0x03, 0xFE, 0x10, 0x08, 0xB8, 0xBC, 0x99, 0xA4, 0x1A, 0xE9, 0xE9, 0x56, 0x28, 0xBC,
+    0x64, 0xF2, 0xF1, 0xB2, 0x0C, 0x2D, 0x7E, 0x9F, 0x51, 0x77, 0xA3, 0xC2, 0x94, 0xD4, 0x46, 0x22,
+    0x99,
+};
+
+static const uint8_t maKatEcdsaSample[gEcdsaSignatureSize_c] =
+{
+    0xEF, 0xD4, 0x8B, 0x2A, 0xAC, 0xB6, 0xA8, 0xFD, 0x11, 0x40, 0xDD, 0x9C, 0xD4, 0x5E, 0x81, 0xD6,
+    0x9D, 0x2C, 0x87, 0x7B, 0x56, 0xAA, 0xF9, 0x91, 0xC3, 0x4D, 0x0E, 0xA8, 0x4E, 0xAF, 0x37, 0x16,
+    0xF7, 0xCB, 0x1C, 0x94, 0x2D, 0x65, 0x7C, 0x41, 0xD4, 0x36, 0xC7, 0xA1, 0xB6, 0xE2, 0x9F, 0x65,
+    0xF3, 0xE9, 0x00, 0xDB, 0xB9, 0xAF, 0xF4, 0x06, 0x4D, 0xC4, 0xAB, 0x2F, 0x84, 0x3A, 0xCD, 0xA8,
+};
+
+static const uint8_t maKatEcdsaTest[gEcdsaSignatureSize_c] =
+{
+    0xF1, 0xAB, 0xB0, 0x23, 0x51, 0x83, 0x51, 0xCD, 0x71, 0xD8, 0x81, 0x56, 0x7B, 0x1E, 0xA6, 0x63,
+    0xED, 0x3E, 0xFC, 0xF6, 0xC5, 0x13, 0x2B, 0x35, 0x4F, 0x28, 0xD3, 0xB0, 0xB7, 0xD3, 0x83, 0x67,
+    0x01, 0x9F, 0x41, 0x13, 0x74, 0x2A, 0x2B, 0x14, 0xBD, 0x25, 0x92, 0x6B, 0x49, 0xC6, 0x49, 0x15,
+    0x5F, 0x26, 0x7E, 0x60, 0xD3, 0x81, 0x4B, 0x4C, 0x0C, 0xC8, 0x42, 0x50, 0xE4, 0x6F, 0x00, 0x83,
+};
+
+/* G and 2G, SEC 2 */
+static const uint8_t maKatG[gP256PointSize_c] =
+{
+    0x04, 0x6B, 0x17, 0xD1, 0xF2, 0xE1, 0x2C, 0x42, 0x47, 0xF8, 0xBC, 0xE6, 0xE5, 0x63, 0xA4, 0x40,
+    0xF2, 0x77, 0x03, 0x7D, 0x81, 0x2D, 0xEB, 0x33, 0xA0, 0xF4, 0xA1, 0x39, 0x45, 0xD8, 0x98, 0xC2,
+    0x96, 0x4F, 0xE3, 0x42, 0xE2, 0xFE, 0x1A, 0x7F, 0x9B, 0x8E, 0xE7, 0xEB, 0x4A, 0x7C, 0x0F, 0x9E,
+    0x16, 0x2B, 0xCE, 0x33, 0x57, 0x6B, 0x31, 0x5E, 0xCE, 0xCB, 0xB6, 0x40, 0x68, 0x37, 0xBF, 0x51,
+    0xF5,
+};
+
+static const uint8_t maKat2G[gP256PointSize_c] =
+{
+    0x04, 0x7C, 0xF2, 0x7B, 0x18, 0x8D, 0x03, 0x4F, 0x7E, 0x8A, 0x52, 0x38, 0x03, 0x04, 0xB5, 0x1A,
+    0xC3, 0xC0, 0x89, 0x69, 0xE2, 0x77, 0xF2, 0x1B, 0x35, 0xA6, 0x0B, 0x48, 0xFC, 0x47, 0x66, 0x99,
+    0x78, 0x07, 0x77, 0x55, 0x10, 0xDB, 0x8E, 0xD0, 0x40, 0x29, 0x3D, 0x9A, 0xC6, 0x9F, 0x74, 0x30,
+    0xDB, 0xBA, 0x7D, 0xAD, 0xE6, 0x3C, 0xE9, 0x82, 0x29, 0x9E, 0x04, 0xB7, 0x9D, 0x22, 0x78, 0x73,
+    0xD1,
+};
+
+/* FIPS 180-4: SHA-256("abc") */
+static const uint8_t maKatSha256Abc[gP256ScalarSize_c] =
+{
+    0xBA, 0x78, 0x16, 0xBF, 0x8F, 0x01, 0xCF, 0xEA, 0x41, 0x41, 0x40, 0xDE, 0x5D, 0xAE, 0x22, 0x23,
+    0xB0, 0x03, 0x61, 0xA3, 0x96, 0x17, 0x7A, 0x9C, 0xB4, 0x10, 0xFF, 0x61, 0xF2, 0x00, 0x15, 0xAD,
+};
+
+/* RFC 4231 test case 2 */
+static const uint8_t maKatHmac[gP256ScalarSize_c] =
+{
+    0x5B, 0xDC, 0xC1, 0x46, 0xBF, 0x60, 0x75, 0x4E, 0x6A, 0x04, 0x24, 0x26, 0x08, 0x95, 0x75, 0xC7,
+    0x5A, 0x00, 0x3F, 0x08, 0x9D, 0x27, 0x39, 0x83, 0x9D, 0xEC, 0x58, 0xB9, 0x64, 0xEC, 0x38, 0x43,
+};
+
+/* RFC 4493: key, empty and one block messages */
+static const uint8_t maKatCmacKey[16] =
+{
+    0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C,
+};
+
+static const uint8_t maKatCmacBlock[16] =
+{
+    0x6B, 0xC1, 0xBE, 0xE2, 0x2E, 0x40, 0x9F, 0x96, 0xE9, 0x3D, 0x7E, 0x11, 0x73, 0x93, 0x17, 0x2A,
+};
+
+static const uint8_t maKatCmacEmpty[16] =
+{
+    0xBB, 0x1D, 0x69, 0x29, 0xE9, 0x59, 0x37, 0x28, 0x7F, 0xA3, 0x7D, 0x12, 0x9B, 0x75, 0x67, 0x46,
+};
+
+static const uint8_t maKatCmacOne[16] =
+{
+    0x07, 0x0A, 0x16, 0xB4, 0x6B, 0x4D, 0x41, 0x44, 0xF7, 0x9B, 0xDD, 0x9D, 0xD0, 0x4A, 0x28, 0x7C,
+};
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main(void)
+{
+    uint32_t failures = 0U;
+
+    failures += Bench_CheckSecLib();
+    failures += Bench_CheckP256();
+    failures += Bench_CheckSpake2p();
+    failures += Bench_CheckInterop();
+    failures += Bench_CheckEcdsa();
+    Bench_Report();
+    printf("%u failures\n", failures);
+
+    return (failures == 0U) ? 0 : 1;
+}
+
+/* RNG: the fixed bytes once, then xorshift64*; fails while failures are set */
+int16_t RNG_GetPseudoRandomData(uint8_t *pOut, uint8_t outBytes, uint8_t *pSeed)
+{
+    int16_t result = (int16_t)outBytes;
+    uint32_t i;
+
+    (void)pSeed;
+    if (mRng.failures != 0U)
+    {
+        mRng.failures--;
+        result = -1;
+    }
+    else if (mRng.pFixed != NULL)
+    {
+        (void)memcpy(pOut, mRng.pFixed, outBytes);
+        mRng.pFixed = NULL;
+    }
+    else
+    {
+        for (i = 0U; i < outBytes; i++)
+        {
+            mRng.state ^= mRng.state >> 12U;
+            mRng.state ^= mRng.state << 25U;
+            mRng.state ^= mRng.state >> 27U;
+            pOut[i] = (uint8_t)((mRng.state * 0x2545F4914F6CDD1DU) >> 56U);
+        }
+    }
+    return result;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+static uint32_t Bench_Check(const char *pName, const uint8_t *pValue, const uint8_t *pExpected, uint32_t length)
+{
+    uint32_t failed = (memcmp(pValue, pExpected, length) == 0) ? 0U : 1U;
+
+    printf("%-32s %s\n", pName, (failed == 0U) ? "ok" : "FAILED");
+    return failed;
+}
+
+static uint32_t Bench_CheckSecLib(void)
+{
+    static const char aJefe[] = "Jefe";
+    static const char aData[] = "what do ya want for nothing?";
+    uint8_t aOut[SHA256_HASH_SIZE];
+    uint32_t failures = 0U;
+
+    SHA256_Hash((const uint8_t *)"abc", 3U, aOut);
+    failures += Bench_Check("SHA-256", aOut, maKatSha256Abc, SHA256_HASH_SIZE);
+    HMAC_SHA256((const uint8_t *)aJefe, sizeof(aJefe) - 1U, (const uint8_t *)aData, sizeof(aData) - 1U, aOut);
+    failures += Bench_Check("HMAC-SHA256", aOut, maKatHmac, SHA256_HASH_SIZE);
+    AES_128_CMAC(maKatCmacBlock, 0U, maKatCmacKey, aOut);
+    failures += Bench_Check("AES-CMAC, empty", aOut, maKatCmacEmpty, 16U);
+    AES_128_CMAC(maKatCmacBlock, 16U, maKatCmacKey, aOut);
+    failures += Bench_Check("AES-CMAC, one block", aOut, maKatCmacOne, 16U);
+    return failures;
+}
+
+/* 1*G, 2*G by each multiplication, G + G, (n-1)*G = -G */
+static uint32_t Bench_CheckP256(void)
+{
+    static const uint8_t aNMinus1[gP256ScalarSize_c] =
+    {
+        0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xBC, 0xE6, 0xFA, 0xAD, 0xA7, 0x17, 0x9E, 0x84, 0xF3, 0xB9, 0xCA, 0xC2, 0xFC, 0x63, 0x25, 0x50,
+    };
+    uint8_t aScalar[gP256ScalarSize_c] = {0U};
+    uint8_t aOut[gP256PointSize_c];
+    p256PointTable_t table;
+    p256Point_t G;
+    p256Point_t P;
+    p256Int_t k;
+    uint32_t failures = 0U;
+
+    (void)P256_PointDecode(&G, maKatG);
+    aScalar[gP256ScalarSize_c - 1U] = 1U;
+    P256_ScalarFromBytes(&k, aScalar);
+    P256_MulFixed(&P, &k, gaP256TableG);
+    (void)P256_PointEncode(aOut, &P);
+    failures += Bench_Check("P-256 1*G, fixed window", aOut, maKatG, gP256PointSize_c);
+
+    aScalar[gP256ScalarSize_c - 1U] = 2U;
+    P256_ScalarFromBytes(&k, aScalar);
+    P256_MulFixed(&P, &k, gaP256TableG);
+    (void)P256_PointEncode(aOut, &P);
+    failures += Bench_Check("P-256 2*G, fixed window", aOut, maKat2G, gP256PointSize_c);
+    P256_MulBaseComb(&P, &k);
+    (void)P256_PointEncode(aOut, &P);
+    failures += Bench_Check("P-256 2*G, comb", aOut, maKat2G, gP256PointSize_c);
+    P256_PrepareTable(&table, &G);
+    P256_MulTable(&P, &k, &table);
+    (void)P256_PointEncode(aOut, &P);
+    failures += Bench_Check("P-256 2*G, variable base", aOut, maKat2G, gP256PointSize_c);
+    P256_PointAdd(&P, &G, &G);
+    (void)P256_PointEncode(aOut, &P);
+    failures += Bench_Check("P-256 G + G", aOut, maKat2G, gP256PointSize_c);
+
+    P256_ScalarFromBytes(&k, aNMinus1);
+    P256_MulBaseComb(&P, &k);
+    P256_PointAdd(&P, &P, &G);
+    printf("%-32s %s\n", "P-256 (n-1)*G + G = infinity", (P256_PointIsInfinity(&P) == TRUE) ? "ok" : "FAILED");
+    failures += (P256_PointIsInfinity(&P) == TRUE) ? 0U : 1U;
+    return failures;
+}
+
+static uint32_t Bench_CheckSpake2p(void)
+{
+    benchVehicle_t vehicle;
+    uint8_t aRsp[gSpake2pResponseSize_c];
+    uint16_t rspLength = 0U;
+    const uint8_t *pKe;
+    uint32_t failures = 0U;
+    spake2pResult_t result;
+
+    /* No verifier provisioned: rejected */
+    result = CCC_Spake2pHandleRequest(0U, maRequestApdu, sizeof(maRequestApdu), aRsp, &rspLength);
+    printf("%-32s %s\n", "SPAKE2+ no verifier", (result == gSpake2pNoVerifier_c) ? "ok" : "FAILED");
+    failures += (result == gSpake2pNoVerifier_c) ? 0U : 1U;
+
+    failures += (CCC_Spake2pSetVerifier(maKatW0, maKatW1) == gSpake2pSuccess_c) ? 0U : 1U;
+
+    /* RNG failure: rejected, no Verify after it */
+    mRng.failures = 1U;
+    result = CCC_Spake2pHandleRequest(0U, maRequestApdu, sizeof(maRequestApdu), aRsp, &rspLength);
+    Bench_Vehicle(&vehicle, maKatShareX, maKatY);
+    result = ((result == gSpake2pRngError_c) &&
+              (CCC_Spake2pHandleVerify(0U, vehicle.apdu, sizeof(vehicle.apdu), aRsp, &rspLength) ==
+               gSpake2pInvalidState_c)) ? gSpake2pSuccess_c : gSpake2pRngError_c;
+    printf("%-32s %s\n", "SPAKE2+ RNG failure", (result == gSpake2pSuccess_c) ? "ok" : "FAILED");
+    failures += (result == gSpake2pSuccess_c) ? 0U : 1U;
+
+    /* Vectors */
+    mRng.pFixed = maKatX;
+    result = CCC_Spake2pHandleRequest(0U, maRequestApdu, sizeof(maRequestApdu), aRsp, &rspLength);
+    failures += ((result == gSpake2pSuccess_c) && (rspLength == gSpake2pResponseSize_c)) ? 0U : 1U;
+    failures += Bench_Check("SPAKE2+ X", &aRsp[2], maKatShareX, gP256PointSize_c);
+    failures += Bench_Check("SPAKE2+ Y (vehicle)", &vehicle.apdu[mcApduHeaderSize_c + 2U], maKatShareY,
+                            gP256PointSize_c);
+    failures += Bench_Check("SPAKE2+ M1 (vehicle)", &vehicle.apdu[mcVerifyApduSize_c - gSpake2pKeySize_c],
+                            maKatM1, gSpake2pKeySize_c);
+    result = CCC_Spake2pHandleVerify(0U, vehicle.apdu, sizeof(vehicle.apdu), aRsp, &rspLength);
+    failures += ((result == gSpake2pSuccess_c) && (rspLength == gSpake2pVerifyRspSize_c)) ? 0U : 1U;
+    failures += Bench_Check("SPAKE2+ M2", &aRsp[2], maKatM2, gSpake2pKeySize_c);
+    pKe = CCC_Spake2pGetSessionKey(0U);
+    failures += (pKe != NULL) ? Bench_Check("SPAKE2+ Ke", pKe, maKatKe, gSpake2pKeySize_c) : 1U;
+
+    /* Wrong M1: rejected, the exchange is over */
+    mRng.pFixed = maKatX;
+    (void)CCC_Spake2pHandleRequest(0U, maRequestApdu, sizeof(maRequestApdu), aRsp, &rspLength);
+    vehicle.apdu[mcVerifyApduSize_c - 1U] ^= 0x01U;
+    result = CCC_Spake2pHandleVerify(0U, vehicle.apdu, sizeof(vehicle.apdu), aRsp, &rspLength);
+    result = ((result == gSpake2pVerifyFailed_c) && (CCC_Spake2pGetSessionKey(0U) == NULL) &&
+              (CCC_Spake2pHandleVerify(0U, vehicle.apdu, sizeof(vehicle.apdu), aRsp, &rspLength) ==
+               gSpake2pInvalidState_c)) ? gSpake2pSuccess_c : gSpake2pVerifyFailed_c;
+    printf("%-32s %s\n", "SPAKE2+ wrong M1", (result == gSpake2pSuccess_c) ? "ok" : "FAILED");
+    failures += (result == gSpake2pSuccess_c) ? 0U : 1U;
+    return failures;
+}
+
+/* Random x and y, both peers: the vehicle must accept M2 and agree on Ke */
+static uint32_t Bench_CheckInterop(void)
+{
+    benchVehicle_t vehicle;
+    uint8_t aRsp[gSpake2pResponseSize_c];
+    uint8_t aY[gP256ScalarSize_c];
+    uint8_t aX[gP256PointSize_c];
+    uint16_t rspLength = 0U;
+    const uint8_t *pKe;
+    uint32_t failures = 0U;
+    uint32_t round;
+
+    for (round = 0U; round < mcInteropRounds_c; round++)
+    {
+        if (CCC_Spake2pHandleRequest((deviceId_t)(round % 2U), maRequestApdu, sizeof(maRequestApdu), aRsp,
+                                     &rspLength) != gSpake2pSuccess_c)
+        {
+            failures++;
+            continue;
+        }
+        (void)memcpy(aX, &aRsp[2], sizeof(aX));
+        Bench_RandomScalar(aY);
+        Bench_Vehicle(&vehicle, aX, aY);
+        pKe = NULL;
+        if (CCC_Spake2pHandleVerify((deviceId_t)(round % 2U), vehicle.apdu, sizeof(vehicle.apdu), aRsp,
+                                    &rspLength) == gSpake2pSuccess_c)
+        {
+            pKe = CCC_Spake2pGetSessionKey((deviceId_t)(round % 2U));
+        }
+        if ((pKe == NULL) || (memcmp(&aRsp[2], vehicle.M2, gSpake2pKeySize_c) != 0) ||
+            (memcmp(pKe, vehicle.Ke, gSpake2pKeySize_c) != 0))
+        {
+            failures++;
+        }
+    }
+    printf("%-32s %u/%u ok\n", "SPAKE2+ random exchanges", mcInteropRounds_c - failures, mcInteropRounds_c);
+    return failures;
+}
+
+static uint32_t Bench_CheckEcdsa(void)
+{
+    uint8_t aHash[gEcdsaHashSize_c];
+    uint8_t aSignature[gEcdsaSignatureSize_c];
+    uint8_t aPublic[gP256PointSize_c];
+    uint32_t failures = 0U;
+    uint32_t verified = 0U;
+    uint32_t round;
+    bool_t ok;
+
+    /* No key provisioned, or a zero key refused: no signature, no public key */
+    ok = ((CCC_EcdsaSign(maKatSha256Abc, aSignature) == FALSE) && (CCC_EcdsaGetPublicKey(aPublic) == FALSE)) ?
+         TRUE : FALSE;
+    (void)memset(aHash, 0, sizeof(aHash));
+    ok = ((ok == TRUE) && (CCC_EcdsaSetPrivateKey(aHash) == FALSE) &&
+          (CCC_EcdsaSign(maKatSha256Abc, aSignature) == FALSE)) ? TRUE : FALSE;
+    printf("%-32s %s\n", "ECDSA no key", (ok == TRUE) ? "ok" : "FAILED");
+    failures += (ok == TRUE) ? 0U : 1U;
+
+    ok = CCC_EcdsaSelfTest(NULL);
+    printf("%-32s %s\n", "ECDSA self test", (ok == TRUE) ? "ok" : "FAILED");
+    failures += (ok == TRUE) ? 0U : 1U;
+
+    failures += (CCC_EcdsaSetPrivateKey(maKatEcdsaKey) == TRUE) ? 0U : 1U;
+    failures += (CCC_EcdsaGetPublicKey(aPublic) == TRUE) ? 0U : 1U;
+    failures += Bench_Check("ECDSA public key", aPublic, maKatEcdsaPublic, gP256PointSize_c);
+    SHA256_Hash((const uint8_t *)"sample", 6U, aHash);
+    failures += (CCC_EcdsaSign(aHash, aSignature) == TRUE) ? 0U : 1U;
+    failures += Bench_Check("ECDSA \"sample\"", aSignature, maKatEcdsaSample, gEcdsaSignatureSize_c);
+    SHA256_Hash((const uint8_t *)"test", 4U, aHash);
+    failures += (CCC_EcdsaSign(aHash, aSignature) == TRUE) ? 0U : 1U;
+    failures += Bench_Check("ECDSA \"test\"", aSignature, maKatEcdsaTest, gEcdsaSignatureSize_c);
+
+    /* Random digests, verified */
+    for (round = 0U; round < mcSignRounds_c; round++)
+    {
+        (void)RNG_GetPseudoRandomData(aHash, (uint8_t)sizeof(aHash), NULL);
+        if ((CCC_EcdsaSign(aHash, aSignature) == TRUE) && (Bench_EcdsaVerify(aPublic, aHash, aSignature) == TRUE))
+        {
+            verified++;
+        }
+    }
+    aSignature[gEcdsaSignatureSize_c - 1U] ^= 0x01U;
+    ok = Bench_EcdsaVerify(aPublic, aHash, aSignature);
+    printf("%-32s %u/%u ok%s\n", "ECDSA random digests", verified, mcSignRounds_c,
+           (ok == FALSE) ? "" : ", altered signature verified");
+    failures += (mcSignRounds_c - verified) + ((ok == FALSE) ? 0U : 1U);
+    return failures;
+}
+
+/* x(u1*G + u2*Q) mod n == r, u1 = e/s, u2 = r/s */
+static bool_t Bench_EcdsaVerify(const uint8_t *pPublicKey, const uint8_t *pHash, const uint8_t *pSignature)
+{
+    uint8_t aPoint[gP256PointSize_c];
+    p256PointTable_t table;
+    p256Point_t R;
+    p256Point_t T;
+    p256Int_t r;
+    p256Int_t s;
+    p256Int_t e;
+    p256Int_t x;
+    bool_t result = FALSE;
+
+    P256_ScalarFromBytes(&r, pSignature);
+    P256_ScalarFromBytes(&s, &pSignature[gP256ScalarSize_c]);
+    if ((P256_ScalarIsValid(&r) == TRUE) && (P256_ScalarIsValid(&s) == TRUE) &&
+        (P256_PointDecode(&T, pPublicKey) == TRUE))
+    {
+        P256_ScalarFromBytes(&e, pHash);
+        P256_ScalarReduce(&e);
+        P256_ScalarInvMod(&s, &s);
+        P256_ScalarMulMod(&e, &e, &s);
+        P256_ScalarMulMod(&s, &r, &s);
+        P256_PrepareTable(&table, &T);
+        P256_MulTable(&T, &s, &table);
+        P256_MulBaseComb(&R, &e);
+        P256_PointAdd(&R, &R, &T);
+        if (P256_PointEncode(aPoint, &R) == TRUE)
+        {
+            P256_ScalarFromBytes(&x, &aPoint[1]);
+            P256_ScalarReduce(&x);
+            result = (memcmp(&x, &r, sizeof(x)) == 0) ? TRUE : FALSE;
+        }
+    }
+    return result;
+}
+
+/* Vehicle: Y = y*G + w0*N, Z = y*(X - w0*M), V = y*L with L = w1*G, M1, then
+   the Verify APDU and the M2 and Ke it expects */
+static void Bench_Vehicle(benchVehicle_t *pVehicle, const uint8_t *pX, const uint8_t *pY)
+{
+    static const char aContext[] = "CCC-DK-SPAKE2+";
+    static const char aInfo[] = "ConfirmationKeys\x01";
+    static uint8_t aTranscript[1024];
+    const uint8_t aSalt[SHA256_HASH_SIZE] = {0U};
+    uint8_t aM[gP256PointSize_c];
+    uint8_t aN[gP256PointSize_c];
+    uint8_t aZ[gP256PointSize_c];
+    uint8_t aV[gP256PointSize_c];
+    uint8_t aW0[gP256ScalarSize_c];
+    uint8_t aK[SHA256_HASH_SIZE];
+    uint8_t aPrk[SHA256_HASH_SIZE];
+    uint8_t aConfirm[SHA256_HASH_SIZE];
+    uint8_t *pYOut = &pVehicle->apdu[mcApduHeaderSize_c + 2U];
+    uint8_t *pM1 = &pVehicle->apdu[mcVerifyApduSize_c - gSpake2pKeySize_c];
+    p256PointTable_t table;
+    p256Point_t P;
+    p256Point_t T;
+    p256Int_t y;
+    p256Int_t w0;
+    p256Int_t w1;
+    uint32_t offset = 0U;
+
+    P256_ScalarFromBytes(&y, pY);
+    P256_ScalarFromBytes(&w0, maKatW0);
+    P256_ScalarFromBytes(&w1, maKatW1);
+
+    P256_MulBaseComb(&P, &y);
+    P256_MulFixed(&T, &w0, gaP256TableN);
+    P256_PointAdd(&P, &P, &T);
+    (void)P256_PointEncode(pYOut, &P);
+
+    (void)P256_PointDecode(&P, pX);
+    P256_MulFixed(&T, &w0, gaP256TableM);
+    P256_PointNegate(&T, &T);
+    P256_PointAdd(&P, &P, &T);
+    P256_PrepareTable(&table, &P);
+    P256_MulTable(&T, &y, &table);
+    (void)P256_PointEncode(aZ, &T);
+    P256_MulBaseComb(&P, &w1);
+    P256_PrepareTable(&table, &P);
+    P256_MulTable(&T, &y, &table);
+    (void)P256_PointEncode(aV, &T);
+
+    /* M and N from their tables: 1*M, 1*N */
+    (void)memset(aW0, 0, sizeof(aW0));
+    aW0[gP256ScalarSize_c - 1U] = 1U;
+    P256_ScalarFromBytes(&y, aW0);
+    P256_MulFixed(&P, &y, gaP256TableM);
+    (void)P256_PointEncode(aM, &P);
+    P256_MulFixed(&P, &y, gaP256TableN);
+    (void)P256_PointEncode(aN, &P);
+    (void)memcpy(aW0, maKatW0, sizeof(aW0));
+
+    /* TT = Context || A || B || M || N || X || Y || Z || V || w0 */
+    offset += Bench_Transcript(&aTranscript[offset], (const uint8_t *)aContext, sizeof(aContext) - 1U);
+    offset += Bench_Transcript(&aTranscript[offset], NULL, 0U);
+    offset += Bench_Transcript(&aTranscript[offset], NULL, 0U);
+    offset += Bench_Transcript(&aTranscript[offset], aM, gP256PointSize_c);
+    offset += Bench_Transcript(&aTranscript[offset], aN, gP256PointSize_c);
+    offset += Bench_Transcript(&aTranscript[offset], pX, gP256PointSize_c);
+    offset += Bench_Transcript(&aTranscript[offset], pYOut, gP256PointSize_c);
+    offset += Bench_Transcript(&aTranscript[offset], aZ, gP256PointSize_c);
+    offset += Bench_Transcript(&aTranscript[offset], aV, gP256PointSize_c);
+    offset += Bench_Transcript(&aTranscript[offset], aW0, gP256ScalarSize_c);
+    SHA256_Hash(aTranscript, offset, aK);
+    HMAC_SHA256(aSalt, SHA256_HASH_SIZE, aK, gSpake2pKeySize_c, aPrk);
+    HMAC_SHA256(aPrk, SHA256_HASH_SIZE, (const uint8_t *)aInfo, sizeof(aInfo) - 1U, aConfirm);
+
+    pVehicle->apdu[0] = 0x80U;
+    pVehicle->apdu[1] = 0x32U;
+    pVehicle->apdu[2] = 0x00U;
+    pVehicle->apdu[3] = 0x00U;
+    pVehicle->apdu[4] = (uint8_t)(mcVerifyApduSize_c - mcApduHeaderSize_c);
+    pVehicle->apdu[mcApduHeaderSize_c] = 0x52U;
+    pVehicle->apdu[mcApduHeaderSize_c + 1U] = (uint8_t)gP256PointSize_c;
+    pM1[-2] = 0x57U;
+    pM1[-1] = (uint8_t)gSpake2pKeySize_c;
+    AES_128_CMAC(pX, gP256PointSize_c, aConfirm, pM1);
+    AES_128_CMAC(pYOut, gP256PointSize_c, &aConfirm[gSpake2pKeySize_c], pVehicle->M2);
+    (void)memcpy(pVehicle->Ke, &aK[gSpake2pKeySize_c], gSpake2pKeySize_c);
+}
+
+/* Uniform scalar in [1, n-1] */
+static void Bench_RandomScalar(uint8_t *pScalar)
+{
+    p256Int_t k;
+
+    do
+    {
+        (void)RNG_GetPseudoRandomData(pScalar, (uint8_t)gP256ScalarSize_c, NULL);
+        P256_ScalarFromBytes(&k, pScalar);
+    } while (P256_ScalarIsValid(&k) == FALSE);
+}
+
+/* len (8 bytes, little-endian) || data */
+static uint32_t Bench_Transcript(uint8_t *pOut, const uint8_t *pData, uint32_t length)
+{
+    uint32_t i;
+
+    for (i = 0U; i < 8U; i++)
+    {
+        pOut[i] = (i < 4U) ? (uint8_t)(length >> (8U * i)) : 0U;
+    }
+    if (length != 0U)
+    {
+        (void)memcpy(&pOut[8], pData, length);
+    }
+    return 8U + length;
+}
+
+/* Time of each step, mcBenchRounds_c runs */
+static void Bench_Report(void)
+{
+    static uint8_t aTranscript[600];
+    benchVehicle_t vehicle;
+    uint8_t aRsp[gSpake2pResponseSize_c];
+    uint8_t aScalar[gP256ScalarSize_c];
+    uint8_t aOut[gP256PointSize_c];
+    uint8_t aMac[SHA256_HASH_SIZE];
+    uint16_t rspLength = 0U;
+    p256PointTable_t table;
+    p256Point_t P;
+    p256Point_t T;
+    p256Int_t k;
+    uint8_t aSignature[gEcdsaSignatureSize_c];
+    uint64_t aUs[13] = {0U};
+    uint64_t startTs;
+    uint32_t round;
+
+    static const char *const aSteps[] =
+    {
+        "Request: x*G, fixed window", "Request: x*G, comb", "Request: w0*M", "Request: add, encode",
+        "Request, total", "Verify: decode Y", "Verify: Y - w0*N", "Verify: table of Y'",
+        "Verify: x*Y' or w1*Y'", "Verify: transcript hash", "Verify: HKDF, 2 CMAC", "Verify, total",
+        "ECDSA sign",
+    };
+
+    for (round = 0U; round < mcBenchRounds_c; round++)
+    {
+        Bench_RandomScalar(aScalar);
+        P256_ScalarFromBytes(&k, aScalar);
+
+        startTs = TM_GetTimestamp();
+        P256_MulFixed(&P, &k, gaP256TableG);
+        aUs[0] += TM_GetTimestamp() - startTs;
+        startTs = TM_GetTimestamp();
+        P256_MulBaseComb(&P, &k);
+        aUs[1] += TM_GetTimestamp() - startTs;
+        startTs = TM_GetTimestamp();
+        P256_MulFixed(&T, &k, gaP256TableM);
+        aUs[2] += TM_GetTimestamp() - startTs;
+        startTs = TM_GetTimestamp();
+        P256_PointAdd(&P, &P, &T);
+        (void)P256_PointEncode(aOut, &P);
+        aUs[3] += TM_GetTimestamp() - startTs;
+
+        startTs = TM_GetTimestamp();
+        (void)CCC_Spake2pHandleRequest(0U, maRequestApdu, sizeof(maRequestApdu), aRsp, &rspLength);
+        aUs[4] += TM_GetTimestamp() - startTs;
+        Bench_Vehicle(&vehicle, &aRsp[2], aScalar);
+
+        startTs = TM_GetTimestamp();
+        (void)P256_PointDecode(&P, &vehicle.apdu[mcApduHeaderSize_c + 2U]);
+        aUs[5] += TM_GetTimestamp() - startTs;
+        startTs = TM_GetTimestamp();
+        P256_MulFixed(&T, &k, gaP256TableN);
+        P256_PointNegate(&T, &T);
+        P256_PointAdd(&P, &P, &T);
+        aUs[6] += TM_GetTimestamp() - startTs;
+        startTs = TM_GetTimestamp();
+        P256_PrepareTable(&table, &P);
+        aUs[7] += TM_GetTimestamp() - startTs;
+        startTs = TM_GetTimestamp();
+        P256_MulTable(&T, &k, &table);
+        (void)P256_PointEncode(aOut, &T);
+        aUs[8] += TM_GetTimestamp() - startTs;
+        startTs = TM_GetTimestamp();
+        SHA256_Hash(aTranscript, sizeof(aTranscript), aMac);
+        aUs[9] += TM_GetTimestamp() - startTs;
+        startTs = TM_GetTimestamp();
+        HMAC_SHA256(aTranscript, SHA256_HASH_SIZE, aMac, gSpake2pKeySize_c, aMac);
+        HMAC_SHA256(aMac, SHA256_HASH_SIZE, aTranscript, 17U, aMac);
+        AES_128_CMAC(aOut, gP256PointSize_c, aMac, aMac);
+        AES_128_CMAC(aOut, gP256PointSize_c, aMac, aMac);
+        aUs[10] += TM_GetTimestamp() - startTs;
+
+        startTs = TM_GetTimestamp();
+        (void)CCC_Spake2pHandleVerify(0U, vehicle.apdu, sizeof(vehicle.apdu), aRsp, &rspLength);
+        aUs[11] += TM_GetTimestamp() - startTs;
+
+        startTs = TM_GetTimestamp();
+        (void)CCC_EcdsaSign(aMac, aSignature);
+        aUs[12] += TM_GetTimestamp() - startTs;
+    }
+
+    printf("host time per step, average of %u runs\n", mcBenchRounds_c);
+    for (round = 0U; round < (sizeof(aSteps) / sizeof(aSteps[0])); round++)
+    {
+        printf("  %-30s %8.1f us\n", aSteps[round], (double)aUs[round] / (double)mcBenchRounds_c);
+    }
+}
@@ -0,0 +1,374 @@
+/*! *********************************************************************************
+* \file seclib_host.c
+*
+* Host builds of application modules (tools/): the SecLib primitives declared
+* by tools/host/SecLib.h, portable C, for the CCC crypto known answer tests
+* and benchmark. Not constant time: host use only.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include <string.h>
+
+#include "SecLib.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mcRotr32(x, n)          (((x) >> (n)) | ((x) << (32U - (n))))
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+typedef struct hostSha256_tag
+{
+    uint32_t    h[8];
+    uint8_t     block[SHA256_BLOCK_SIZE];
+    uint32_t    used;
+    uint64_t    length;
+}hostSha256_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static void Host_Aes128(const uint8_t *pKey, const uint8_t *pIn, uint8_t *pOut);
+static void Host_Sha256Init(hostSha256_t *pCtx);
+static void Host_Sha256Update(hostSha256_t *pCtx, const uint8_t *pData, uint32_t numBytes);
+static void Host_Sha256Final(hostSha256_t *pCtx, uint8_t *pOutput);
+static void Host_Sha256Block(hostSha256_t *pCtx, const uint8_t *pBlock);
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static const uint8_t maSbox[256] =
+{
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16
+};
+
+static const uint32_t maSha256K[64] =
+{
+    0x428a2f98U, 0x71374491U, 0xb5c0fbcfU, 0xe9b5dba5U, 0x3956c25bU, 0x59f111f1U, 0x923f82a4U, 0xab1c5ed5U,
+    0xd807aa98U, 0x12835b01U, 0x243185beU, 0x550c7dc3U, 0x72be5d74U, 0x80deb1feU, 0x9bdc06a7U, 0xc19bf174U,
+    0xe49b69c1U, 0xefbe4786U, 0x0fc19dc6U, 0x240ca1ccU, 0x2de92c6fU, 0x4a7484aaU, 0x5cb0a9dcU, 0x76f988daU,
+    0x983e5152U, 0xa831c66dU, 0xb00327c8U, 0xbf597fc7U, 0xc6e00bf3U, 0xd5a79147U, 0x06ca6351U, 0x14292967U,
+    0x27b70a85U, 0x2e1b2138U, 0x4d2c6dfcU, 0x53380d13U, 0x650a7354U, 0x766a0abbU, 0x81c2c92eU, 0x92722c85U,
+    0xa2bfe8a1U, 0xa81a664bU, 0xc24b8b70U, 0xc76c51a3U, 0xd192e819U, 0xd6990624U, 0xf40e3585U, 0x106aa070U,
+    0x19a4c116U, 0x1e376c08U, 0x2748774cU, 0x34b0bcb5U, 0x391c0cb3U, 0x4ed8aa4aU, 0x5b9cca4fU, 0x682e6ff3U,
+    0x748f82eeU, 0x78a5636fU, 0x84c87814U, 0x8cc70208U, 0x90befffaU, 0xa4506cebU, 0xbef9a3f7U, 0xc67178f2U
+};
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/* SecLib: AES-CMAC, RFC 4493 */
+void AES_128_CMAC(const uint8_t *pInput, const uint32_t inputLen, const uint8_t *pKey, uint8_t *pOutput)
+{
+    uint8_t aZero[16] = {0U};
+    uint8_t aL[16];
+    uint8_t aSubkey[16];
+    uint8_t aBlock[16];
+    uint8_t aX[16] = {0U};
+    uint32_t blocks = (inputLen + 15U) / 16U;
+    uint32_t last;
+    uint32_t i;
+    uint32_t j;
+    uint8_t carry;
+
+    /* K1 = L.x, K2 = L.x^2 in GF(2^128) */
+    Host_Aes128(pKey, aZero, aL);
+    (void)memcpy(aSubkey, aL, sizeof(aSubkey));
+    for (j = 0U; j < (((inputLen != 0U) && ((inputLen % 16U) == 0U)) ? 1U : 2U); j++)
+    {
+        carry = aSubkey[0] & 0x80U;
+        for (i = 0U; i < 15U; i++)
+        {
+            aSubkey[i] = (uint8_t)((aSubkey[i] << 1U) | (aSubkey[i + 1U] >> 7U));
+        }
+        aSubkey[15] = (uint8_t)(aSubkey[15] << 1U);
+        if (carry != 0U)
+        {
+            aSubkey[15] ^= 0x87U;
+        }
+    }
+
+    if (blocks == 0U)
+    {
+        blocks = 1U;
+    }
+    for (i = 0U; i < blocks; i++)
+    {
+        (void)memset(aBlock, 0, sizeof(aBlock));
+        last = ((i + 1U) == blocks) ? (inputLen - (16U * i)) : 16U;
+        (void)memcpy(aBlock, &pInput[16U * i], last);
+        if ((i + 1U) == blocks)
+        {
+            if (last < 16U)
+            {
+                aBlock[last] = 0x80U;
+            }
+            for (j = 0U; j < 16U; j++)
+            {
+                aBlock[j] ^= aSubkey[j];
+            }
+        }
+        for (j = 0U; j < 16U; j++)
+        {
+            aBlock[j] ^= aX[j];
+        }
+        Host_Aes128(pKey, aBlock, aX);
+    }
+    (void)memcpy(pOutput, aX, sizeof(aX));
+}
+
+/* SecLib: SHA-256, FIPS 180-4 */
+void SHA256_Hash(const uint8_t *pData, uint32_t numBytes, uint8_t *pOutput)
+{
+    hostSha256_t ctx;
+
+    Host_Sha256Init(&ctx);
+    Host_Sha256Update(&ctx, pData, numBytes);
+    Host_Sha256Final(&ctx, pOutput);
+}
+
+/* SecLib: HMAC-SHA256, RFC 2104 */
+void HMAC_SHA256(const uint8_t *pKey, uint32_t keyLen, const uint8_t *pData, uint32_t numBytes, uint8_t *pOutput)
+{
+    hostSha256_t ctx;
+    uint8_t aKey[SHA256_BLOCK_SIZE] = {0U};
+    uint8_t aPad[SHA256_BLOCK_SIZE];
+    uint8_t aInner[SHA256_HASH_SIZE];
+    uint32_t i;
+
+    if (keyLen > SHA256_BLOCK_SIZE)
+    {
+        SHA256_Hash(pKey, keyLen, aKey);
+    }
+    else
+    {
+        (void)memcpy(aKey, pKey, keyLen);
+    }
+
+    for (i = 0U; i < SHA256_BLOCK_SIZE; i++)
+    {
+        aPad[i] = aKey[i] ^ 0x36U;
+    }
+    Host_Sha256Init(&ctx);
+    Host_Sha256Update(&ctx, aPad, SHA256_BLOCK_SIZE);
+    Host_Sha256Update(&ctx, pData, numBytes);
+    Host_Sha256Final(&ctx, aInner);
+
+    for (i = 0U; i < SHA256_BLOCK_SIZE; i++)
+    {
+        aPad[i] = aKey[i] ^ 0x5CU;
+    }
+    Host_Sha256Init(&ctx);
+    Host_Sha256Update(&ctx, aPad, SHA256_BLOCK_SIZE);
+    Host_Sha256Update(&ctx, aInner, SHA256_HASH_SIZE);
+    Host_Sha256Final(&ctx, pOutput);
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+/* FIPS-197 encryption of one block */
+static void Host_Aes128(const uint8_t *pKey, const uint8_t *pIn, uint8_t *pOut)
+{
+    uint8_t aRoundKeys[176];
+    uint8_t aState[16];
+    uint8_t aTemp[4];
+    uint8_t rcon = 0x01U;
+    uint8_t t;
+    uint32_t round;
+    uint32_t i;
+    uint32_t c;
+
+    (void)memcpy(aRoundKeys, pKey, 16U);
+    for (i = 16U; i < 176U; i += 4U)
+    {
+        (void)memcpy(aTemp, &aRoundKeys[i - 4U], 4U);
+        if ((i % 16U) == 0U)
+        {
+            t = aTemp[0];
+            aTemp[0] = (uint8_t)(maSbox[aTemp[1]] ^ rcon);
+            aTemp[1] = maSbox[aTemp[2]];
+            aTemp[2] = maSbox[aTemp[3]];
+            aTemp[3] = maSbox[t];
+            rcon = (uint8_t)((rcon << 1U) ^ (((rcon & 0x80U) != 0U) ? 0x1BU : 0x00U));
+        }
+        for (c = 0U; c < 4U; c++)
+        {
+            aRoundKeys[i + c] = aRoundKeys[i + c - 16U] ^ aTemp[c];
+        }
+    }
+
+    for (i = 0U; i < 16U; i++)
+    {
+        aState[i] = pIn[i] ^ aRoundKeys[i];
+    }
+    for (round = 1U; round <= 10U; round++)
+    {
+        /* SubBytes, ShiftRows */
+        for (i = 0U; i < 16U; i++)
+        {
+            aState[i] = maSbox[aState[i]];
+        }
+        t = aState[1]; aState[1] = aState[5]; aState[5] = aState[9]; aState[9] = aState[13]; aState[13] = t;
+        t = aState[2]; aState[2] = aState[10]; aState[10] = t;
+        t = aState[6]; aState[6] = aState[14]; aState[14] = t;
+        t = aState[15]; aState[15] = aState[11]; aState[11] = aState[7]; aState[7] = aState[3]; aState[3] = t;
+        /* MixColumns */
+        if (round != 10U)
+        {
+            for (c = 0U; c < 16U; c += 4U)
+            {
+                for (i = 0U; i < 4U; i++)
+                {
+                    aTemp[i] = aState[c + i];
+                }
+                t = aTemp[0] ^ aTemp[1] ^ aTemp[2] ^ aTemp[3];
+                for (i = 0U; i < 4U; i++)
+                {
+                    uint8_t x = aTemp[i] ^ aTemp[(i + 1U) % 4U];
+
+                    x = (uint8_t)((x << 1U) ^ (((x & 0x80U) != 0U) ? 0x1BU : 0x00U));
+                    aState[c + i] = aTemp[i] ^ t ^ x;
+                }
+            }
+        }
+        for (i = 0U; i < 16U; i++)
+        {
+            aState[i] ^= aRoundKeys[(16U * round) + i];
+        }
+    }
+    (void)memcpy(pOut, aState, sizeof(aState));
+}
+
+static void Host_Sha256Init(hostSha256_t *pCtx)
+{
+    static const uint32_t aInit[8] =
+    {
+        0x6a09e667U, 0xbb67ae85U, 0x3c6ef372U, 0xa54ff53aU, 0x510e527fU, 0x9b05688cU, 0x1f83d9abU, 0x5be0cd19U
+    };
+
+    (void)memcpy(pCtx->h, aInit, sizeof(aInit));
+    pCtx->used = 0U;
+    pCtx->length = 0U;
+}
+
+static void Host_Sha256Update(hostSha256_t *pCtx, const uint8_t *pData, uint32_t numBytes)
+{
+    uint32_t i;
+
+    for (i = 0U; i < numBytes; i++)
+    {
+        pCtx->block[pCtx->used] = pData[i];
+        pCtx->used++;
+        if (pCtx->used == SHA256_BLOCK_SIZE)
+        {
+            Host_Sha256Block(pCtx, pCtx->block);
+            pCtx->used = 0U;
+        }
+    }
+    pCtx->length += numBytes;
+}
+
+static void Host_Sha256Final(hostSha256_t *pCtx, uint8_t *pOutput)
+{
+    uint64_t bits = pCtx->length * 8U;
+    uint8_t aTail[8];
+    uint8_t pad = 0x80U;
+    uint32_t i;
+
+    for (i = 0U; i < 8U; i++)
+    {
+        aTail[i] = (uint8_t)(bits >> (56U - (8U * i)));
+    }
+    Host_Sha256Update(pCtx, &pad, 1U);
+    pad = 0x00U;
+    while (pCtx->used != (SHA256_BLOCK_SIZE - 8U))
+    {
+        Host_Sha256Update(pCtx, &pad, 1U);
+    }
+    Host_Sha256Update(pCtx, aTail, 8U);
+
+    for (i = 0U; i < 8U; i++)
+    {
+        pOutput[4U * i] = (uint8_t)(pCtx->h[i] >> 24U);
+        pOutput[(4U * i) + 1U] = (uint8_t)(pCtx->h[i] >> 16U);
+        pOutput[(4U * i) + 2U] = (uint8_t)(pCtx->h[i] >> 8U);
+        pOutput[(4U * i) + 3U] = (uint8_t)pCtx->h[i];
+    }
+}
+
+static void Host_Sha256Block(hostSha256_t *pCtx, const uint8_t *pBlock)
+{
+    uint32_t w[64];
+    uint32_t v[8];
+    uint32_t t1;
+    uint32_t t2;
+    uint32_t i;
+
+    for (i = 0U; i < 16U; i++)
+    {
+        w[i] = ((uint32_t)pBlock[4U * i] << 24U) | ((uint32_t)pBlock[(4U * i) + 1U] << 16U) |
+               ((uint32_t)pBlock[(4U * i) + 2U] << 8U) | (uint32_t)pBlock[(4U * i) + 3U];
+    }
+    for (i = 16U; i < 64U; i++)
+    {
+        w[i] = (mcRotr32(w[i - 2U], 17U) ^ mcRotr32(w[i - 2U], 19U) ^ (w[i - 2U] >> 10U)) + w[i - 7U] +
+               (mcRotr32(w[i - 15U], 7U) ^ mcRotr32(w[i - 15U], 18U) ^ (w[i - 15U] >> 3U)) + w[i - 16U];
+    }
+
+    (void)memcpy(v, pCtx->h, sizeof(v));
+    for (i = 0U; i < 64U; i++)
+    {
+        t1 = v[7] + (mcRotr32(v[4], 6U) ^ mcRotr32(v[4], 11U) ^ mcRotr32(v[4], 25U)) +
+             ((v[4] & v[5]) ^ (~v[4] & v[6])) + maSha256K[i] + w[i];
+        t2 = (mcRotr32(v[0], 2U) ^ mcRotr32(v[0], 13U) ^ mcRotr32(v[0], 22U)) +
+             ((v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]));
+        v[7] = v[6];
+        v[6] = v[5];
+        v[5] = v[4];
+        v[4] = v[3] + t1;
+        v[3] = v[2];
+        v[2] = v[1];
+        v[1] = v[0];
+        v[0] = t1 + t2;
+    }
+    for (i = 0U; i < 8U; i++)
+    {
+        pCtx->h[i] += v[i];
+    }
+}
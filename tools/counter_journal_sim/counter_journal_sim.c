@@ -0,0 +1,213 @@
+/*! *********************************************************************************
+* \file counter_journal_sim.c
+*
+* Host power loss simulation of the counter journal (app_counters.c,
+* unchanged). The NVM record storage is replaced by an in-memory store whose
+* writes are atomic, as the NVM records are. Each life counts random events,
+* checkpoints every period, compacts now and then (low battery, reset) and is
+* cut at a random record write: that write and all later ones are lost. The
+* next life boots from the store and must recover exactly the counts held by
+* the records written, in write order. The counts lost per cut are reported.
+*
+* Build, from the repository root:
+*   gcc -O2 -Itools/host -I. -include tools/host/app_conn.h \
+*       tools/counter_journal_sim/counter_journal_sim.c app_counters.c -o counter_journal_sim
+*
+* Usage:
+*   counter_journal_sim [lives] [seed]
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "EmbeddedTypes.h"
+#include "app_conn.h"
+#include "app_counters.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mcTicksPerCheckpoint_c      10U     /* Event ticks per checkpoint period */
+#define mcMaxTicksPerLife_c         2000U
+#define mcCompactPercent_c          1U      /* Per tick, low battery or reset */
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+/* The store */
+static appCounterBase_t mStoreBase;
+static bool_t mStoreBaseValid = FALSE;
+static appCounterDelta_t maStoreDelta[gAppCounterJournalSlots_c];
+static bool_t maStoreDeltaValid[gAppCounterJournalSlots_c];
+
+/* Power: writes left before the cut, the cut write included */
+static uint32_t mWritesBeforeCut = 0U;
+static bool_t mPowerOn = TRUE;
+
+/* Reference model */
+static uint32_t maTruth[gAppCounterCount_c];
+static uint32_t maDurable[gAppCounterCount_c];
+static uint32_t mTicksSinceDurable = 0U;
+
+static uint32_t mWrites = 0U;
+static uint32_t mBaseWrites = 0U;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+static bool_t Sim_WriteAllowed(void)
+{
+    if ((mPowerOn == TRUE) && (mWritesBeforeCut != 0U))
+    {
+        mWritesBeforeCut--;
+        if (mWritesBeforeCut == 0U)
+        {
+            mPowerOn = FALSE;
+        }
+    }
+    return mPowerOn;
+}
+
+/* A record reaches the store: in write order, what a boot must recover */
+static void Sim_Durable(const appCounterBase_t *pBase, const appCounterDelta_t *pDelta)
+{
+    uint8_t i;
+
+    for (i = 0U; i < (uint8_t)gAppCounterCount_c; i++)
+    {
+        maDurable[i] = (pBase != NULL) ? pBase->values[i] : (maDurable[i] + pDelta->deltas[i]);
+    }
+    mTicksSinceDurable = 0U;
+    mWrites++;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/* The checkpoint timer never fires here: each life checkpoints itself */
+bleResult_t App_PostCallbackMessageToQueue(appCallbackHandler_t handler, appCallbackParam_t param,
+                                           appQueueId_t queueId)
+{
+    (void)queueId;
+    handler(param);
+    return gBleSuccess_c;
+}
+
+bool_t App_NvmReadCounterBase(appCounterBase_t *pBase)
+{
+    *pBase = mStoreBase;
+    return mStoreBaseValid;
+}
+
+bool_t App_NvmWriteCounterBase(const appCounterBase_t *pBase)
+{
+    bool_t written = Sim_WriteAllowed();
+
+    if (written == TRUE)
+    {
+        mStoreBase = *pBase;
+        mStoreBaseValid = TRUE;
+        mBaseWrites++;
+        Sim_Durable(pBase, NULL);
+    }
+    return written;
+}
+
+bool_t App_NvmReadCounterDelta(uint8_t slot, appCounterDelta_t *pDelta)
+{
+    *pDelta = maStoreDelta[slot];
+    return maStoreDeltaValid[slot];
+}
+
+bool_t App_NvmWriteCounterDelta(uint8_t slot, const appCounterDelta_t *pDelta)
+{
+    bool_t written = Sim_WriteAllowed();
+
+    if (written == TRUE)
+    {
+        maStoreDelta[slot] = *pDelta;
+        maStoreDeltaValid[slot] = TRUE;
+        Sim_Durable(NULL, pDelta);
+    }
+    return written;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t lives = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 100000U;
+    uint32_t seed = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 1U;
+    uint32_t failures = 0U;
+    uint32_t maxLostTicks = 0U;
+    uint64_t lost = 0U;
+    uint32_t life;
+    uint32_t tick;
+    uint32_t n;
+    uint8_t i;
+
+    srand(seed);
+    for (life = 0U; life < lives; life++)
+    {
+        /* Boot */
+        mPowerOn = TRUE;
+        App_CountersInit();
+        for (i = 0U; i < (uint8_t)gAppCounterCount_c; i++)
+        {
+            if (App_CounterGet((appCounterId_t)i) != maDurable[i])
+            {
+                printf("life %u: counter %u recovered %u, last record held %u\n", life, i,
+                       App_CounterGet((appCounterId_t)i), maDurable[i]);
+                failures++;
+            }
+            lost += (uint64_t)(maTruth[i] - maDurable[i]);
+            /* The device restarts from what it recovered */
+            maTruth[i] = App_CounterGet((appCounterId_t)i);
+        }
+        if (mTicksSinceDurable > maxLostTicks)
+        {
+            maxLostTicks = mTicksSinceDurable;
+        }
+        mTicksSinceDurable = 0U;
+
+        /* Run until the power cut */
+        mWritesBeforeCut = 1U + ((uint32_t)rand() % (2U * gAppCounterJournalSlots_c + 3U));
+        for (tick = 1U; (tick <= mcMaxTicksPerLife_c) && (mPowerOn == TRUE); tick++)
+        {
+            i = (uint8_t)((uint32_t)rand() % gAppCounterCount_c);
+            /* Mostly single events, now and then a burst past a delta record */
+            n = (((uint32_t)rand() % 1000U) == 0U) ? (70000U + ((uint32_t)rand() % 70000U)) : 1U;
+            App_CounterAdd((appCounterId_t)i, n);
+            maTruth[i] += n;
+            mTicksSinceDurable++;
+
+            if ((tick % mcTicksPerCheckpoint_c) == 0U)
+            {
+                App_CountersCheckpoint();
+            }
+            if (((uint32_t)rand() % 100U) < mcCompactPercent_c)
+            {
+                App_CountersCompact(gAppCounterCompactShutdown_c);
+            }
+        }
+    }
+
+    printf("%u lives, %u record writes (%u base), %u recovery failures\n", lives, mWrites, mBaseWrites, failures);
+    printf("lost per power cut: %.1f counts on average, at most %u ticks (checkpoint every %u)\n",
+           (double)lost / (double)lives, maxLostTicks, mcTicksPerCheckpoint_c);
+    return (failures == 0U) ? 0 : 1;
+}
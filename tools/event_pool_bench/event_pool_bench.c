@@ -0,0 +1,124 @@
+/*! *********************************************************************************
+* \file event_pool_bench.c
+*
+* Host benchmark of app_event_pool.c against the heap it falls back to. The
+* load mimics the application queue: bursts of events of the sizes the BLE
+* callbacks post, allocated in order and released in order.
+*
+* On the host the heap is the C library malloc, not MEM_BufferAlloc: the
+* numbers compare the O(1) free lists with a general purpose allocator, the
+* ratio on target has to be measured there.
+*
+* Build, from the repository root:
+*   gcc -O2 -Itools/host -I. tools/event_pool_bench/event_pool_bench.c \
+*       app_event_pool.c -o event_pool_bench
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "EmbeddedTypes.h"
+#include "fsl_component_mem_manager.h"
+#include "app_event_pool.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mcBurstLength_c             12U
+#define mcBursts_c                  2000000U
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+/* appEventData_t alone, + RSSI / notification, + connected event, + bonding data */
+static const uint32_t maEventSizes[] = {8U, 8U, 8U, 12U, 24U, 8U, 48U, 8U, 12U, 8U, 24U, 140U};
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+static double Bench_Now(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + ((double)now.tv_nsec * 1e-9);
+}
+
+static void *Bench_HeapAlloc(uint32_t size)
+{
+    return MEM_BufferAlloc(size);
+}
+
+static void Bench_HeapFree(void *pBuffer)
+{
+    (void)MEM_BufferFree(pBuffer);
+}
+
+static double Bench_Run(const char *pName, void *(*pfAlloc)(uint32_t), void (*pfFree)(void *))
+{
+    void *aBurst[mcBurstLength_c];
+    double start = Bench_Now();
+    double seconds;
+    uint32_t i;
+    uint32_t j;
+
+    for (i = 0U; i < mcBursts_c; i++)
+    {
+        for (j = 0U; j < mcBurstLength_c; j++)
+        {
+            aBurst[j] = pfAlloc(maEventSizes[j]);
+            /* Touch it as the producer does */
+            *(volatile uint8_t *)aBurst[j] = (uint8_t)j;
+        }
+        for (j = 0U; j < mcBurstLength_c; j++)
+        {
+            pfFree(aBurst[j]);
+        }
+    }
+    seconds = Bench_Now() - start;
+    printf("%-6s %8.1f M alloc+free/s  %6.1f ns each\n", pName,
+           ((double)mcBursts_c * mcBurstLength_c) / seconds / 1e6,
+           (seconds * 1e9) / ((double)mcBursts_c * mcBurstLength_c));
+    return seconds;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main(void)
+{
+    const appEventPoolStats_t *pStats;
+    double heap;
+    double pool;
+    uint8_t i;
+
+    App_EventPoolInit();
+    heap = Bench_Run("heap", Bench_HeapAlloc, Bench_HeapFree);
+    pool = Bench_Run("pool", App_EventAlloc, App_EventFree);
+    printf("pool speedup %.2fx\n", heap / pool);
+
+    for (i = 0U; i < gAppEventPoolClasses_c; i++)
+    {
+        pStats = App_EventPoolGetStats(i);
+        printf("class %3u B x%-3u high %u allocs %u failures %u\n", pStats->blockSize, pStats->blockCount,
+               pStats->highWater, pStats->allocs, pStats->failures);
+    }
+    printf("heap fallbacks %u\n", App_EventPoolGetHeapAllocs());
+    return 0;
+}
@@ -0,0 +1,682 @@
+/*! *********************************************************************************
+* \file gatt_cache_bench.c
+*
+* Host measurement of the GATT caching of the keyfob database: the ATT traffic
+* of a client reconnecting to the keyfob, with a full discovery (no caching,
+* or Service Changed) against a Database Hash read (robust caching, cache
+* valid). An ATT server stub answers the discovery requests from the
+* application database, the ATT client stub discovers all primary services,
+* their characteristics and descriptors as a central does, and both count the
+* exchanges and bytes on air, with the L2CAP header, for the default and the
+* largest MTU. Each exchange takes a connection event at least: the time is
+* given for the default connection_interval.
+*
+* The Database Hash is computed by GattDb_ComputeDatabaseHash
+* (common/gatt_db/gatt_database.c) with the AES-CMAC defined here, checked
+* against RFC 4493, and printed: it is the one a vehicle reads from this
+* build. The change-aware state of app_gatt_cache.c is then taken through
+* boots and reconnections of a bond: first boot of a new database, same
+* database, changed database; Service Changed confirmed, or the hash read
+* instead, also before the link is encrypted. GAP, the indication and NVM are stubs.
+*
+* Build, from the repository root:
+*   gcc -O2 -Itools/host -Icommon/gatt_db -Icommon/gatt_db/macros -I. -include app_preinclude.h \
+*       tools/gatt_cache_bench/gatt_cache_bench.c app_gatt_cache.c -o gatt_cache_bench
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gatt_db_macros.h"
+
+#undef VALUE_UUID128_DECL
+#define VALUE_UUID128_DECL(name, size, uuid128, permissions)\
+    {\
+        HANDLE,\
+        (uint16_t)permissions,\
+        0U,\
+        name##_valueArray,\
+        (uint16_t)size, \
+        (uint16_t)gBleUuidType128_c, \
+        0, \
+    },
+
+#undef VALUE_UUID128_VARLEN_DECL
+#define VALUE_UUID128_VARLEN_DECL(name, maxSize, initSize, uuid128, permissions)\
+    {\
+        HANDLE,\
+        (uint16_t)permissions,\
+        0U,\
+        name##_valueArray,\
+        (uint16_t)initSize, \
+        (uint16_t)gBleUuidType128_c, \
+        (uint16_t)maxSize, \
+    },
+
+#include "gatt_database.c"
+
+#include "gap_interface.h"
+#include "gatt_server_interface.h"
+#include "gatt_db_handles.h"
+#include "app_nvm.h"
+#include "app_gatt_cache.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mcL2capHeader_c             (4U)
+#define mcAttReqLength_c            (7U)    /* Read By (Group) Type, 16-bit type */
+#define mcAttFindInfoReqLength_c    (5U)
+#define mcAttErrorRspLength_c       (5U)
+#define mcAttIndicationLength_c     (3U + 4U)
+#define mcAttConfirmationLength_c   (1U)
+
+#define mcBondIndex_c               (0U)
+#define mcPeer_c                    (0U)
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+typedef struct
+{
+    uint32_t exchanges;
+    uint32_t bytes;
+}benchTraffic_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static void Bench_Aes128(const uint8_t *pKey, const uint8_t *pIn, uint8_t *pOut);
+static void Bench_Exchange(benchTraffic_t *pTraffic, uint32_t reqLength, uint32_t rspLength);
+static uint16_t Bench_GroupEnd(uint16_t index);
+static void Bench_Discover(uint16_t mtu, benchTraffic_t *pTraffic);
+static void Bench_ReadHash(benchTraffic_t *pTraffic);
+static void Bench_Report(uint16_t mtu);
+static uint32_t Bench_CheckHash(void);
+static uint32_t Bench_CheckCache(void);
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+/* Host stack: the database attributes the hash computation found */
+uint32_t mServerDatabaseHashIndex = gGattDbInvalidHandleIndex_d;
+uint32_t mServerClientSupportedFeatureIndex = gGattDbInvalidHandleIndex_d;
+
+static const uint8_t maSbox[256] =
+{
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16
+};
+
+/* Stubs state: the bond, its Service Changed CCCD, the NVM record */
+static bool_t mBonded = TRUE;
+static bool_t mIndicationsOn = TRUE;
+static uint32_t mIndicationsSent = 0U;
+static appGattCacheRecord_t mNvmRecord;
+static bool_t mNvmRecordValid = FALSE;
+static uint32_t mNvmWrites = 0U;
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main(void)
+{
+    uint32_t failures = 0U;
+
+    (void)GattDb_Init();
+    failures += Bench_CheckHash();
+    failures += Bench_CheckCache();
+
+    printf("%u attributes, handles %u..%u\n", (unsigned)gGattDbAttributeCount_c,
+           gattDatabase[0].handle, gattDatabase[gGattDbAttributeCount_c - 1U].handle);
+    Bench_Report(gAttDefaultMtu_c);
+    Bench_Report(gAttMaxMtu_c);
+    printf("%u failures\n", failures);
+
+    return (failures == 0U) ? 0 : 1;
+}
+
+/* SecLib: AES-CMAC, RFC 4493 */
+void AES_128_CMAC(const uint8_t *pInput, const uint32_t inputLen, const uint8_t *pKey, uint8_t *pOutput)
+{
+    uint8_t aZero[16] = {0U};
+    uint8_t aL[16];
+    uint8_t aSubkey[16];
+    uint8_t aBlock[16];
+    uint8_t aX[16] = {0U};
+    uint32_t blocks = (inputLen + 15U) / 16U;
+    uint32_t last;
+    uint32_t i;
+    uint32_t j;
+    uint8_t carry;
+
+    /* K1 = L.x, K2 = L.x^2 in GF(2^128) */
+    Bench_Aes128(pKey, aZero, aL);
+    (void)memcpy(aSubkey, aL, sizeof(aSubkey));
+    for (j = 0U; j < (((inputLen != 0U) && ((inputLen % 16U) == 0U)) ? 1U : 2U); j++)
+    {
+        carry = aSubkey[0] & 0x80U;
+        for (i = 0U; i < 15U; i++)
+        {
+            aSubkey[i] = (uint8_t)((aSubkey[i] << 1U) | (aSubkey[i + 1U] >> 7U));
+        }
+        aSubkey[15] = (uint8_t)(aSubkey[15] << 1U);
+        if (carry != 0U)
+        {
+            aSubkey[15] ^= 0x87U;
+        }
+    }
+
+    if (blocks == 0U)
+    {
+        blocks = 1U;
+    }
+    for (i = 0U; i < blocks; i++)
+    {
+        (void)memset(aBlock, 0, sizeof(aBlock));
+        last = ((i + 1U) == blocks) ? (inputLen - (16U * i)) : 16U;
+        (void)memcpy(aBlock, &pInput[16U * i], last);
+        if ((i + 1U) == blocks)
+        {
+            if (last < 16U)
+            {
+                aBlock[last] = 0x80U;
+            }
+            for (j = 0U; j < 16U; j++)
+            {
+                aBlock[j] ^= aSubkey[j];
+            }
+        }
+        for (j = 0U; j < 16U; j++)
+        {
+            aBlock[j] ^= aX[j];
+        }
+        Bench_Aes128(pKey, aBlock, aX);
+    }
+    (void)memcpy(pOutput, aX, sizeof(aX));
+}
+
+/* Host stack: the value of an attribute */
+bleResult_t GattDb_ReadAttribute(uint16_t handle, uint16_t maxBytes, uint8_t *aOutValue, uint16_t *pOutValueLength)
+{
+    uint16_t index = GattDb_GetIndexOfHandle(handle);
+    bleResult_t result = gGattDbInvalidHandle_c;
+
+    if (index != gGattDbInvalidHandleIndex_d)
+    {
+        *pOutValueLength = (gattDatabase[index].valueLength < maxBytes) ? gattDatabase[index].valueLength : maxBytes;
+        (void)memcpy(aOutValue, gattDatabase[index].pValue, *pOutValueLength);
+        result = gBleSuccess_c;
+    }
+    return result;
+}
+
+/* Host stack: one bond, NVM index mcBondIndex_c */
+bleResult_t Gap_CheckIfBonded(deviceId_t deviceId, bool_t *pOutIsBonded, uint8_t *pOutNvmIndex)
+{
+    (void)deviceId;
+    *pOutIsBonded = mBonded;
+    *pOutNvmIndex = (mBonded == TRUE) ? mcBondIndex_c : gInvalidNvmIndex_c;
+    return gBleSuccess_c;
+}
+
+bleResult_t Gap_CheckIndicationStatus(deviceId_t deviceId, uint16_t handle, bool_t *pOutIsActive)
+{
+    (void)deviceId;
+    *pOutIsActive = ((handle == (uint16_t)cccd_service_changed) && (mIndicationsOn == TRUE)) ? TRUE : FALSE;
+    return gBleSuccess_c;
+}
+
+bleResult_t GattServer_SendInstantValueIndication(deviceId_t deviceId, uint16_t handle, uint16_t valueLength,
+                                                 const uint8_t *aValue)
+{
+    (void)deviceId;
+    (void)aValue;
+    if ((handle == (uint16_t)value_service_changed) && (valueLength == 4U))
+    {
+        mIndicationsSent++;
+    }
+    return gBleSuccess_c;
+}
+
+/* app_nvm.c */
+bool_t App_NvmReadGattCache(appGattCacheRecord_t *pRecord)
+{
+    (void)memcpy(pRecord, &mNvmRecord, sizeof(mNvmRecord));
+    return mNvmRecordValid;
+}
+
+bool_t App_NvmWriteGattCache(const appGattCacheRecord_t *pRecord)
+{
+    (void)memcpy(&mNvmRecord, pRecord, sizeof(mNvmRecord));
+    mNvmRecordValid = TRUE;
+    mNvmWrites++;
+    return TRUE;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+/* FIPS-197 encryption of one block */
+static void Bench_Aes128(const uint8_t *pKey, const uint8_t *pIn, uint8_t *pOut)
+{
+    uint8_t aRoundKeys[176];
+    uint8_t aState[16];
+    uint8_t aTemp[4];
+    uint8_t rcon = 0x01U;
+    uint8_t t;
+    uint32_t round;
+    uint32_t i;
+    uint32_t c;
+
+    (void)memcpy(aRoundKeys, pKey, 16U);
+    for (i = 16U; i < 176U; i += 4U)
+    {
+        (void)memcpy(aTemp, &aRoundKeys[i - 4U], 4U);
+        if ((i % 16U) == 0U)
+        {
+            t = aTemp[0];
+            aTemp[0] = (uint8_t)(maSbox[aTemp[1]] ^ rcon);
+            aTemp[1] = maSbox[aTemp[2]];
+            aTemp[2] = maSbox[aTemp[3]];
+            aTemp[3] = maSbox[t];
+            rcon = (uint8_t)((rcon << 1U) ^ (((rcon & 0x80U) != 0U) ? 0x1BU : 0x00U));
+        }
+        for (c = 0U; c < 4U; c++)
+        {
+            aRoundKeys[i + c] = aRoundKeys[i + c - 16U] ^ aTemp[c];
+        }
+    }
+
+    for (i = 0U; i < 16U; i++)
+    {
+        aState[i] = pIn[i] ^ aRoundKeys[i];
+    }
+    for (round = 1U; round <= 10U; round++)
+    {
+        /* SubBytes, ShiftRows */
+        for (i = 0U; i < 16U; i++)
+        {
+            aState[i] = maSbox[aState[i]];
+        }
+        t = aState[1]; aState[1] = aState[5]; aState[5] = aState[9]; aState[9] = aState[13]; aState[13] = t;
+        t = aState[2]; aState[2] = aState[10]; aState[10] = t;
+        t = aState[6]; aState[6] = aState[14]; aState[14] = t;
+        t = aState[15]; aState[15] = aState[11]; aState[11] = aState[7]; aState[7] = aState[3]; aState[3] = t;
+        /* MixColumns */
+        if (round != 10U)
+        {
+            for (c = 0U; c < 16U; c += 4U)
+            {
+                for (i = 0U; i < 4U; i++)
+                {
+                    aTemp[i] = aState[c + i];
+                }
+                t = aTemp[0] ^ aTemp[1] ^ aTemp[2] ^ aTemp[3];
+                for (i = 0U; i < 4U; i++)
+                {
+                    uint8_t x = aTemp[i] ^ aTemp[(i + 1U) % 4U];
+
+                    x = (uint8_t)((x << 1U) ^ (((x & 0x80U) != 0U) ? 0x1BU : 0x00U));
+                    aState[c + i] = aTemp[i] ^ t ^ x;
+                }
+            }
+        }
+        for (i = 0U; i < 16U; i++)
+        {
+            aState[i] ^= aRoundKeys[(16U * round) + i];
+        }
+    }
+    (void)memcpy(pOut, aState, sizeof(aState));
+}
+
+static void Bench_Exchange(benchTraffic_t *pTraffic, uint32_t reqLength, uint32_t rspLength)
+{
+    pTraffic->exchanges++;
+    pTraffic->bytes += reqLength + rspLength + (2U * mcL2capHeader_c);
+}
+
+/* Index of the last attribute of the group (service or characteristic) of
+   the declaration at index */
+static uint16_t Bench_GroupEnd(uint16_t index)
+{
+    bool_t service = (gattDatabase[index].uuid == gBleSig_PrimaryService_d) ? TRUE : FALSE;
+    uint16_t i = index + 1U;
+
+    while ((i < gGattDbAttributeCount_c) &&
+           !((gattDatabase[i].uuidType == (uint16_t)gBleUuidType16_c) &&
+             ((gattDatabase[i].uuid == gBleSig_PrimaryService_d) ||
+              ((service == FALSE) && (gattDatabase[i].uuid == gBleSig_Characteristic_d)))))
+    {
+        i++;
+    }
+    return i - 1U;
+}
+
+/* Full discovery as a central runs it: Read By Group Type of the primary
+   services, Read By Type of the characteristics of each service, Find
+   Information of the descriptors of each characteristic. A response holds
+   as many entries of the length of the first as the MTU allows, a request
+   past the last entry is answered with an error. */
+static void Bench_Discover(uint16_t mtu, benchTraffic_t *pTraffic)
+{
+    uint16_t i = 0U;
+    uint16_t end;
+    uint16_t first;
+    uint16_t entries;
+    uint16_t entryLength;
+    uint16_t limit;
+    uint16_t j;
+
+    /* Primary services */
+    while (i < gGattDbAttributeCount_c)
+    {
+        while ((i < gGattDbAttributeCount_c) &&
+               !((gattDatabase[i].uuidType == (uint16_t)gBleUuidType16_c) &&
+                 (gattDatabase[i].uuid == gBleSig_PrimaryService_d)))
+        {
+            i++;
+        }
+        if (i == gGattDbAttributeCount_c)
+        {
+            break;
+        }
+        entryLength = (uint16_t)(4U + gattDatabase[i].valueLength);
+        entries = 0U;
+        while ((i < gGattDbAttributeCount_c) && (entries < ((mtu - 2U) / entryLength)))
+        {
+            if ((gattDatabase[i].uuidType == (uint16_t)gBleUuidType16_c) &&
+                (gattDatabase[i].uuid == gBleSig_PrimaryService_d))
+            {
+                if ((4U + gattDatabase[i].valueLength) != entryLength)
+                {
+                    break;
+                }
+                entries++;
+            }
+            i++;
+        }
+        Bench_Exchange(pTraffic, mcAttReqLength_c, 2U + (entries * entryLength));
+    }
+    Bench_Exchange(pTraffic, mcAttReqLength_c, mcAttErrorRspLength_c);
+
+    /* Characteristics of each service, then their descriptors */
+    for (i = 0U; i < gGattDbAttributeCount_c; i++)
+    {
+        if ((gattDatabase[i].uuidType != (uint16_t)gBleUuidType16_c) ||
+            (gattDatabase[i].uuid != gBleSig_PrimaryService_d))
+        {
+            continue;
+        }
+        end = Bench_GroupEnd(i);
+        j = i + 1U;
+        while (j <= end)
+        {
+            entries = 0U;
+            entryLength = 0U;
+            while ((j <= end) && ((entryLength == 0U) || (entries < ((mtu - 2U) / entryLength))))
+            {
+                if (gattDatabase[j].uuid == gBleSig_Characteristic_d)
+                {
+                    if ((entryLength != 0U) && ((2U + gattDatabase[j].valueLength) != entryLength))
+                    {
+                        break;
+                    }
+                    entryLength = (uint16_t)(2U + gattDatabase[j].valueLength);
+                    entries++;
+                }
+                j++;
+            }
+            Bench_Exchange(pTraffic, mcAttReqLength_c,
+                           (entries != 0U) ? (2U + (entries * entryLength)) : mcAttErrorRspLength_c);
+            if (entries == 0U)
+            {
+                break;
+            }
+        }
+        if (gattDatabase[end].uuid == gBleSig_Characteristic_d)
+        {
+            ; /* Last handle is a declaration, no request past it */
+        }
+        else if (j > end)
+        {
+            /* The client does not know the last characteristic ended the
+               service: one more request, answered with an error */
+            Bench_Exchange(pTraffic, mcAttReqLength_c, mcAttErrorRspLength_c);
+        }
+        else
+        {
+            ;
+        }
+
+        /* Descriptors: the handles between a value and the next declaration */
+        for (j = i + 1U; j <= end; j++)
+        {
+            if (gattDatabase[j].uuid != gBleSig_Characteristic_d)
+            {
+                continue;
+            }
+            limit = Bench_GroupEnd(j);
+            if (limit > end)
+            {
+                limit = end;
+            }
+            first = j + 2U;
+            while (first <= limit)
+            {
+                entryLength = (gattDatabase[first].uuidType == (uint16_t)gBleUuidType16_c) ? 4U : 18U;
+                entries = 0U;
+                while ((first <= limit) && (entries < ((mtu - 2U) / entryLength)) &&
+                       (((gattDatabase[first].uuidType == (uint16_t)gBleUuidType16_c) ? 4U : 18U) == entryLength))
+                {
+                    entries++;
+                    first++;
+                }
+                Bench_Exchange(pTraffic, mcAttFindInfoReqLength_c, 2U + (entries * entryLength));
+            }
+        }
+    }
+}
+
+/* Robust caching: Read By Type of the Database Hash over all handles */
+static void Bench_ReadHash(benchTraffic_t *pTraffic)
+{
+    Bench_Exchange(pTraffic, mcAttReqLength_c, 2U + 2U + gGattDatabaseHashSize_c);
+}
+
+static void Bench_Report(uint16_t mtu)
+{
+    benchTraffic_t full = {0U, 0U};
+    benchTraffic_t cached = {0U, 0U};
+    benchTraffic_t changed = {0U, 0U};
+    uint32_t intervalMs = (uint32_t)SystemParamsRegistry[ConnectionIntervalID].default_value;
+
+    Bench_Discover(mtu, &full);
+    Bench_ReadHash(&cached);
+    /* Service Changed indication and confirmation, then the full discovery */
+    changed.exchanges = 1U;
+    changed.bytes = mcAttIndicationLength_c + mcAttConfirmationLength_c + (2U * mcL2capHeader_c);
+    Bench_Discover(mtu, &changed);
+
+    printf("MTU %3u, no caching      : %3u exchanges %5u bytes >= %4u ms\n",
+           mtu, full.exchanges, full.bytes, full.exchanges * intervalMs);
+    printf("MTU %3u, cache valid     : %3u exchanges %5u bytes >= %4u ms\n",
+           mtu, cached.exchanges, cached.bytes, cached.exchanges * intervalMs);
+    printf("MTU %3u, service changed : %3u exchanges %5u bytes >= %4u ms\n",
+           mtu, changed.exchanges, changed.bytes, changed.exchanges * intervalMs);
+    printf("MTU %3u, saved per reconnection: %u exchanges, %u bytes, %u ms at %u ms interval\n",
+           mtu, full.exchanges - cached.exchanges, full.bytes - cached.bytes,
+           (full.exchanges - cached.exchanges) * intervalMs, intervalMs);
+}
+
+/* RFC 4493 example 2, then the Database Hash of this build */
+static uint32_t Bench_CheckHash(void)
+{
+    static const uint8_t aKey[16] =
+        {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+    static const uint8_t aMessage[16] =
+        {0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a};
+    static const uint8_t aExpected[16] =
+        {0x07, 0x0a, 0x16, 0xb4, 0x6b, 0x4d, 0x41, 0x44, 0xf7, 0x9b, 0xdd, 0x9d, 0xd0, 0x4a, 0x28, 0x7c};
+    static const uint8_t aExpectedEmpty[16] =
+        {0xbb, 0x1d, 0x69, 0x29, 0xe9, 0x59, 0x37, 0x28, 0x7f, 0xa3, 0x7d, 0x12, 0x9b, 0x75, 0x67, 0x46};
+    uint8_t aMac[16];
+    uint8_t aHash[gGattDatabaseHashSize_c];
+    uint16_t length = 0U;
+    uint32_t failures = 0U;
+    uint32_t i;
+
+    AES_128_CMAC(aMessage, sizeof(aMessage), aKey, aMac);
+    failures += (memcmp(aMac, aExpected, sizeof(aMac)) != 0) ? 1U : 0U;
+    AES_128_CMAC(aMessage, 0U, aKey, aMac);
+    failures += (memcmp(aMac, aExpectedEmpty, sizeof(aMac)) != 0) ? 1U : 0U;
+    if (failures != 0U)
+    {
+        printf("FAIL: AES-CMAC RFC 4493 vectors\n");
+    }
+
+    if ((GattDb_ComputeDatabaseHash() != gBleSuccess_c) ||
+        (GattDb_ReadAttribute((uint16_t)value_database_hash, (uint16_t)sizeof(aHash), aHash, &length) != gBleSuccess_c))
+    {
+        printf("FAIL: Database Hash\n");
+        failures++;
+    }
+    else
+    {
+        printf("Database Hash (as read):");
+        for (i = 0U; i < length; i++)
+        {
+            printf(" %02x", aHash[i]);
+        }
+        printf("\n");
+    }
+    return failures;
+}
+
+/* Boots and reconnections of one bond through app_gatt_cache.c */
+static uint32_t Bench_CheckCache(void)
+{
+    uint32_t failures = 0U;
+    uint16_t index = GattDb_GetIndexOfHandle((uint16_t)char_params_tlv);
+
+    /* First boot of this database: the bond cached another one */
+    App_GattCacheInit();
+    App_GattCacheLinkSecured(mcPeer_c, FALSE);
+    if ((App_GattCacheGetStats()->dbChanged != 1U) || (mIndicationsSent != 1U) ||
+        (App_GattCacheChangeUnaware() != 0x3U) || (mNvmWrites != 1U))
+    {
+        printf("FAIL: first boot, Service Changed not sent\n");
+        failures++;
+    }
+    App_GattCacheConfirmed(mcPeer_c);
+    App_GattCacheDisconnected(mcPeer_c);
+    if ((App_GattCacheChangeUnaware() != 0x2U) || (mNvmWrites != 2U))
+    {
+        printf("FAIL: confirmed, bond still change-unaware\n");
+        failures++;
+    }
+
+    /* Same database: nothing sent, nothing written */
+    App_GattCacheInit();
+    App_GattCacheLinkSecured(mcPeer_c, FALSE);
+    App_GattCacheHashRead(mcPeer_c);
+    App_GattCacheDisconnected(mcPeer_c);
+    if ((mIndicationsSent != 1U) || (mNvmWrites != 2U))
+    {
+        printf("FAIL: same database, Service Changed sent or record written\n");
+        failures++;
+    }
+
+    /* Changed database, Service Changed indications off: the bond reads
+       the hash instead */
+    gattDatabase[index].pValue[0] |= (uint8_t)gGattCharPropNotify_c;
+    mIndicationsOn = FALSE;
+    App_GattCacheInit();
+    App_GattCacheLinkSecured(mcPeer_c, FALSE);
+    if ((mIndicationsSent != 1U) || (App_GattCacheChangeUnaware() != 0x3U) || (mNvmWrites != 3U))
+    {
+        printf("FAIL: changed database not detected\n");
+        failures++;
+    }
+    App_GattCacheHashRead(mcPeer_c);
+    App_GattCacheDisconnected(mcPeer_c);
+    if ((App_GattCacheChangeUnaware() != 0x2U) || (App_GattCacheGetStats()->hashReads != 1U))
+    {
+        printf("FAIL: hash read, bond still change-unaware\n");
+        failures++;
+    }
+
+    /* Changed database: the bond reads the hash as it connects, before the
+       link is encrypted */
+    gattDatabase[index].pValue[0] &= (uint8_t)~gGattCharPropNotify_c;
+    App_GattCacheInit();
+    App_GattCacheConnected(mcPeer_c);
+    App_GattCacheHashRead(mcPeer_c);
+    App_GattCacheLinkSecured(mcPeer_c, FALSE);
+    App_GattCacheDisconnected(mcPeer_c);
+    if ((mIndicationsSent != 1U) || (App_GattCacheChangeUnaware() != 0x2U) ||
+        (App_GattCacheGetStats()->hashReads != 2U))
+    {
+        printf("FAIL: hash read before encryption, bond still change-unaware\n");
+        failures++;
+    }
+
+    /* Unconfirmed indication: sent again on the next connection; a new bond
+       is change-aware */
+    gattDatabase[index].pValue[0] |= (uint8_t)gGattCharPropNotify_c;
+    mIndicationsOn = TRUE;
+    App_GattCacheInit();
+    App_GattCacheLinkSecured(mcPeer_c, FALSE);
+    App_GattCacheDisconnected(mcPeer_c);
+    App_GattCacheLinkSecured(mcPeer_c, FALSE);
+    App_GattCacheConfirmed(mcPeer_c);
+    if ((mIndicationsSent != 3U) || (App_GattCacheChangeUnaware() != 0x2U))
+    {
+        printf("FAIL: unconfirmed Service Changed not sent again\n");
+        failures++;
+    }
+    App_GattCacheDisconnected(mcPeer_c);
+    App_GattCacheLinkSecured(1U, TRUE);
+    if (App_GattCacheChangeUnaware() != 0x2U)
+    {
+        printf("FAIL: new bond change-unaware\n");
+        failures++;
+    }
+    printf("change-aware state: %u Service Changed, %u NVM writes over 5 boots\n",
+           mIndicationsSent, mNvmWrites);
+    return failures;
+}
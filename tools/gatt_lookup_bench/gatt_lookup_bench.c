@@ -0,0 +1,242 @@
+/*! *********************************************************************************
+* \file gatt_lookup_bench.c
+*
+* Host benchmark of the GATT database lookups of common/gatt_db/gatt_database.c,
+* built with the application gatt_db.h: GattDb_GetIndexOfHandle from the handle
+* to index table against the backward scan it replaces, and
+* GattDb_FindServiceRange against the full scan it replaces. Every handle and
+* service of the database is looked up both ways first, the results must
+* agree.
+*
+* The database holds a 32-bit pointer for each 128-bit UUID on target, not a
+* constant on a 64-bit host: the bench leaves it 0, no lookup reads it.
+*
+* Build, from the repository root, for the application database:
+*   gcc -O2 -Itools/host -Icommon/gatt_db -Icommon/gatt_db/macros -I. \
+*       tools/gatt_lookup_bench/gatt_lookup_bench.c -o gatt_lookup_bench
+*
+* and for one 4 times larger, every attribute renamed 4 times over:
+*   mkdir -p x4 && for i in 1 2 3 4; do \
+*       sed -E "s/\b(service|char|value|desc|cccd)_/\1${i}_/g" gatt_db.h; done > x4/gatt_db.h
+*   gcc -O2 -Itools/host -Icommon/gatt_db -Icommon/gatt_db/macros -Ix4 -I. \
+*       tools/gatt_lookup_bench/gatt_lookup_bench.c -o gatt_lookup_bench_x4
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "gatt_db_macros.h"
+
+#undef VALUE_UUID128_DECL
+#define VALUE_UUID128_DECL(name, size, uuid128, permissions)\
+    {\
+        HANDLE,\
+        (uint16_t)permissions,\
+        0U,\
+        name##_valueArray,\
+        (uint16_t)size, \
+        (uint16_t)gBleUuidType128_c, \
+        0, \
+    },
+
+#undef VALUE_UUID128_VARLEN_DECL
+#define VALUE_UUID128_VARLEN_DECL(name, maxSize, initSize, uuid128, permissions)\
+    {\
+        HANDLE,\
+        (uint16_t)permissions,\
+        0U,\
+        name##_valueArray,\
+        (uint16_t)initSize, \
+        (uint16_t)gBleUuidType128_c, \
+        (uint16_t)maxSize, \
+    },
+
+#include "gatt_database.c"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mcLookups_c                 20000000U
+#define mcRangeLookups_c            2000000U
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static uint16_t maServiceHandles[64];
+static uint32_t mServices = 0U;
+static volatile uint32_t mSink;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+static double Bench_Now(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + ((double)now.tv_nsec * 1e-9);
+}
+
+/* GattDb_GetIndexOfHandle before the handle to index table */
+static uint16_t Bench_ScanIndexOfHandle(uint16_t handle)
+{
+    uint16_t init = (handle >= gGattDbAttributeCount_c) ?
+                    (gGattDbAttributeCount_c - 1U) : handle;
+    for (uint16_t j = init; j != 0xFFFFU && gattDatabase[j].handle >= handle; j--)
+    {
+        if (gattDatabase[j].handle == handle)
+        {
+            return j;
+        }
+    }
+    return gGattDbInvalidHandleIndex_d;
+}
+
+/* GattDb_FindServiceRange before it used the table */
+static bleResult_t Bench_ScanServiceRange(uint16_t serviceHandle, uint16_t *pOutStartIndex,
+                                          uint16_t *pOutAttributeCount)
+{
+    bleResult_t result = gGattDbInvalidHandle_c;
+
+    for (uint32_t j = 0U; j < gGattDbAttributeCount_c; j++)
+    {
+        if (gattDatabase[j].handle == serviceHandle)
+        {
+            if ((gattDatabase[j].uuidType == (uint16_t)gBleUuidType16_c) &&
+                BleSig_IsServiceDeclarationUuid16(gattDatabase[j].uuid))
+            {
+                *pOutStartIndex = (uint16_t)j;
+                uint32_t k;
+                for (k = j + 1U; k < gGattDbAttributeCount_c; k++)
+                {
+                    if ((gattDatabase[k].uuidType == (uint16_t)gBleUuidType16_c) &&
+                        BleSig_IsServiceDeclarationUuid16(gattDatabase[k].uuid))
+                    {
+                        break;
+                    }
+                }
+                *pOutAttributeCount = (uint16_t)(k - j);
+                result = gBleSuccess_c;
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+/* Both ways agree on every handle up to past the last one, and on every
+   handle as a service */
+static uint32_t Bench_Check(void)
+{
+    uint16_t lastHandle = gattDatabase[gGattDbAttributeCount_c - 1U].handle;
+    uint16_t start[2];
+    uint16_t count[2];
+    bleResult_t result[2];
+    uint32_t mismatches = 0U;
+    uint16_t handle;
+
+    for (handle = 0U; handle <= (uint16_t)(lastHandle + 8U); handle++)
+    {
+        if (GattDb_GetIndexOfHandle(handle) != Bench_ScanIndexOfHandle(handle))
+        {
+            printf("handle %u: index %u, scan %u\n", handle, GattDb_GetIndexOfHandle(handle),
+                   Bench_ScanIndexOfHandle(handle));
+            mismatches++;
+        }
+        start[0] = start[1] = count[0] = count[1] = 0U;
+        result[0] = GattDb_FindServiceRange(handle, &start[0], &count[0]);
+        result[1] = Bench_ScanServiceRange(handle, &start[1], &count[1]);
+        if ((result[0] != result[1]) || (start[0] != start[1]) || (count[0] != count[1]))
+        {
+            printf("service %u: range %u+%u, scan %u+%u\n", handle, start[0], count[0], start[1], count[1]);
+            mismatches++;
+        }
+        if ((result[1] == gBleSuccess_c) && (mServices < NumberOfElements(maServiceHandles)))
+        {
+            maServiceHandles[mServices] = handle;
+            mServices++;
+        }
+    }
+    return mismatches;
+}
+
+/* Lookups of the attributes in turn, as reads, writes and notifications
+   reach them */
+static double Bench_Lookups(const char *pName, uint16_t (*pfLookup)(uint16_t))
+{
+    double start = Bench_Now();
+    double ns;
+    uint32_t sum = 0U;
+    uint32_t i;
+
+    for (i = 0U; i < mcLookups_c; i++)
+    {
+        sum += pfLookup(gattDatabase[(i * 7U) % gGattDbAttributeCount_c].handle);
+    }
+    mSink = sum;
+    ns = ((Bench_Now() - start) * 1e9) / (double)mcLookups_c;
+    printf("%-28s %8.2f ns\n", pName, ns);
+    return ns;
+}
+
+static double Bench_Ranges(const char *pName, bleResult_t (*pfRange)(uint16_t, uint16_t *, uint16_t *))
+{
+    double start = Bench_Now();
+    double ns;
+    uint16_t first = 0U;
+    uint16_t count = 0U;
+    uint32_t sum = 0U;
+    uint32_t i;
+
+    for (i = 0U; i < mcRangeLookups_c; i++)
+    {
+        (void)pfRange(maServiceHandles[i % mServices], &first, &count);
+        sum += (uint32_t)first + count;
+    }
+    mSink = sum;
+    ns = ((Bench_Now() - start) * 1e9) / (double)mcRangeLookups_c;
+    printf("%-28s %8.2f ns\n", pName, ns);
+    return ns;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main(void)
+{
+    uint32_t mismatches;
+    double scan;
+    double table;
+
+    (void)GattDb_Init();
+    mismatches = Bench_Check();
+    printf("%u attributes in %u services, handles 1..%u, table %u bytes, %u mismatches\n",
+           gGattDbAttributeCount_c, mServices, gattDatabase[gGattDbAttributeCount_c - 1U].handle,
+           (uint32_t)sizeof(static_gattDbHandleIndex), mismatches);
+
+    scan = Bench_Lookups("index of handle, scan", Bench_ScanIndexOfHandle);
+    table = Bench_Lookups("index of handle, table", GattDb_GetIndexOfHandle);
+    printf("speedup %.1fx\n", scan / table);
+
+    scan = Bench_Ranges("service range, scan", Bench_ScanServiceRange);
+    table = Bench_Ranges("service range, table", GattDb_FindServiceRange);
+    printf("speedup %.1fx\n", scan / table);
+
+    return (mismatches == 0U) ? 0 : 1;
+}
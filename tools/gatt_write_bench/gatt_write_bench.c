@@ -0,0 +1,831 @@
+/*! *********************************************************************************
+* \file gatt_write_bench.c
+*
+* Host benchmark of the client writes of the application characteristic
+* values: App_GattWrite (app_gatt_write.c), one descriptor read at the index of
+* the handle, against the write path it replaces, the scans of the parameter
+* and key registries of digital_key_device.c and the parameter ID loop of
+* App_NvmWriteSystemParam, both kept here. A tuning session is replayed: bursts
+* writing every system parameter in turn.
+*
+* The GATT database is that of the application gatt_db.h, built as in
+* tools/gatt_lookup_bench. GattDb_WriteAttribute, part of the host stack, is
+* defined here over GattDb_GetIndexOfHandle. The NVM calls only keep the
+* values: parameters are saved once quiet, a write only marks them.
+*
+* Both ways are checked first: 4 byte values in range set the same parameter
+* and the same GATT value, but for ms_total_step: a lifetime counter now, not
+* written, its count set before a read. App_GattWrite also rejects values out of bounds and
+* keys of a wrong length, and reads 1 and 2 byte values signed. A params_tlv
+* record (app_params_tlv.c) of every parameter is applied with one save, one
+* with a bad field, the read-only step count or cut short is not applied at
+* all, and the blob reads of a long read get the record built for its first
+* read, even across a write; a long read given up ends after its timeout,
+* shortened for the bench. The ATT exchanges of a
+* full sync, one characteristic per parameter against params_tlv, are counted
+* for the default and the largest MTU.
+*
+* Build, from the repository root:
+*   gcc -O2 -Itools/host -Icommon/gatt_db -Icommon/gatt_db/macros -I. -DgAppMaxConnections_c=2U \
+*       -DgAppParamsTlvBlobTimeoutMs_c=50U tools/gatt_write_bench/gatt_write_bench.c app_gatt_write.c app_params_tlv.c \
+*       -o gatt_write_bench
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "gatt_db_macros.h"
+
+#undef VALUE_UUID128_DECL
+#define VALUE_UUID128_DECL(name, size, uuid128, permissions)\
+    {\
+        HANDLE,\
+        (uint16_t)permissions,\
+        0U,\
+        name##_valueArray,\
+        (uint16_t)size, \
+        (uint16_t)gBleUuidType128_c, \
+        0, \
+    },
+
+#undef VALUE_UUID128_VARLEN_DECL
+#define VALUE_UUID128_VARLEN_DECL(name, maxSize, initSize, uuid128, permissions)\
+    {\
+        HANDLE,\
+        (uint16_t)permissions,\
+        0U,\
+        name##_valueArray,\
+        (uint16_t)initSize, \
+        (uint16_t)gBleUuidType128_c, \
+        (uint16_t)maxSize, \
+    },
+
+#include "gatt_database.c"
+
+#include "gatt_db_handles.h"
+#include "app_nvm.h"
+#include "app_counters.h"
+#include "app_gatt_write.h"
+#include "app_params_tlv.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mcBursts_c                  400000U
+#define mcParamWrites_c             25U
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+/* digital_key_device.c registries before the write descriptors */
+typedef struct
+{
+    uint16_t u16Handle;
+    void (*pcfCharWriteCb)(int32_t, int32_t);
+    int32_t arg;
+}app_ble_chars_metadata;
+
+typedef struct
+{
+    uint16_t u16Handle;
+    void (*pcfCharWriteCb)(int32_t, uint8_t*, uint16_t);
+    int32_t arg;
+    int32_t max_value;
+}app_keys_chars_metadata;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static void Bench_LegacyPerformReset(int32_t arg, int32_t value);
+static void Bench_LegacySetParam(int32_t arg, int32_t value);
+static void Bench_LegacySetKey(int32_t arg, uint8_t *key_bytes, uint16_t key_size);
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static const app_ble_chars_metadata mCharRegistry[] =
+{
+    {(uint16_t)value_scanning_interval,               Bench_LegacySetParam, SlowScanIntervalID},
+    {(uint16_t)value_scan_windows,                    Bench_LegacySetParam, SlowScanWindowID},
+    {(uint16_t)value_connection_interval,             Bench_LegacySetParam, ConnectionIntervalID},
+    {(uint16_t)value_ble_power_output,                Bench_LegacySetParam, BlePowerOutputID},
+    {(uint16_t)value_ble_scan_on_step,                Bench_LegacySetParam, BleScanOnStepID},
+    {(uint16_t)value_ble_disc_during_still,           Bench_LegacySetParam, BleDiscDuringStillID},
+    {(uint16_t)value_delta_rssi_low,                  Bench_LegacySetParam, DeltaRssiLowID},
+    {(uint16_t)value_delta_rssi_medium,               Bench_LegacySetParam, DeltaRssiMediumID},
+    {(uint16_t)value_delta_rssi_high,                 Bench_LegacySetParam, DeltaRssiHighID},
+    {(uint16_t)value_rssi_intent_high,                Bench_LegacySetParam, RssiIntentHighID},
+    {(uint16_t)value_timeout_between_same_intents,    Bench_LegacySetParam, TimeoutBetweenSameIntentsID},
+    {(uint16_t)value_rssi_on_duration,                Bench_LegacySetParam, RssiOnDurationID},
+    {(uint16_t)value_ms_threshold_no_motion_detected, Bench_LegacySetParam, MsThresholdNoMotionDetectionID},
+    {(uint16_t)value_ms_osr,                          Bench_LegacySetParam, MsOsrID},
+    {(uint16_t)value_ms_odr,                          Bench_LegacySetParam, MsOdrID},
+    {(uint16_t)value_ms_accuracy_range,               Bench_LegacySetParam, MsAccuracyRangeID},
+    {(uint16_t)value_ms_motion_still_duration,        Bench_LegacySetParam, MsMotionStillDurationID},
+    {(uint16_t)value_ms_wrist_mode,                   Bench_LegacySetParam, MsWristModeID},
+    {(uint16_t)value_ms_step_in_scan,                 Bench_LegacySetParam, MsStepInScanID},
+    {(uint16_t)value_ms_step_out_scan,                Bench_LegacySetParam, MsStepOutScanID},
+    {(uint16_t)value_ms_total_step,                   Bench_LegacySetParam, MsTotalStepID},
+    {(uint16_t)value_ms_still_detected,               Bench_LegacySetParam, MsStillDetectedID},
+    {(uint16_t)value_temperature,                     Bench_LegacySetParam, TemperatureID},
+    {(uint16_t)value_battery_level,                   Bench_LegacySetParam, BatteryLevelID},
+    {(uint16_t)value_number_of_anchors,               Bench_LegacySetParam, NumberOfAnchorsID},
+    {(uint16_t)value_commands_reset,                  Bench_LegacyPerformReset, 0},
+};
+
+static const app_keys_chars_metadata mKeysCharRegistry[] =
+{
+    {(uint16_t)value_keys_IRK,        Bench_LegacySetKey,      IrkKeyID,       KEY_MAX_SIZE},
+    {(uint16_t)value_keys_LTK,        Bench_LegacySetKey,      LtkKeyID,       KEY_MAX_SIZE},
+    {(uint16_t)value_BD_ADDR,         Bench_LegacySetKey,      BdAddrKeyID,    BD_ADDR_MAX_SIZE},
+};
+
+/* What the NVM calls keep */
+static int32_t maParams[ParamMaxID];
+static uint8_t maKeys[KeyMaxID][KEY_MAX_SIZE];
+static uint32_t mDirtyMarks = 0U;
+static uint32_t mResets = 0U;
+static uint32_t mFlushes = 0U;
+static uint32_t mSteps = 0U;
+static uint16_t mMtu = gAttDefaultMtu_c;
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/* Host stack: the value of an attribute, its length when variable */
+bleResult_t GattDb_WriteAttribute(uint16_t handle, uint16_t valueLength, const uint8_t *aValue)
+{
+    uint16_t index = GattDb_GetIndexOfHandle(handle);
+    bleResult_t result = gBleSuccess_c;
+
+    if (index == gGattDbInvalidHandleIndex_d)
+    {
+        result = gGattDbInvalidHandle_c;
+    }
+    else if (((gattDatabase[index].maxVariableValueLength == 0U) && (valueLength != gattDatabase[index].valueLength)) ||
+             ((gattDatabase[index].maxVariableValueLength != 0U) && (valueLength > gattDatabase[index].maxVariableValueLength)))
+    {
+        result = gBleInvalidParameter_c;
+    }
+    else
+    {
+        (void)memcpy(gattDatabase[index].pValue, aValue, valueLength);
+        gattDatabase[index].valueLength = valueLength;
+    }
+    return result;
+}
+
+/* Host stack: the MTU of every peer */
+bleResult_t Gatt_GetMtu(deviceId_t deviceId, uint16_t *pOutMtu)
+{
+    (void)deviceId;
+    *pOutMtu = mMtu;
+    return gBleSuccess_c;
+}
+
+/* app_nvm.c, the value kept and marked dirty */
+bleResult_t App_NvmWriteSystemParam(systemParamID_t id, int32_t value)
+{
+    bleResult_t status = gBleNVMError_c;
+
+    if ((id < ParamMaxID) &&
+        (value >= SystemParamsRegistry[id].min_value) && (value <= SystemParamsRegistry[id].max_value))
+    {
+        if (maParams[id] != value)
+        {
+            maParams[id] = value;
+            mDirtyMarks++;
+        }
+        status = gBleSuccess_c;
+    }
+    return status;
+}
+
+bleResult_t App_NvmWriteBleKey(bleKeysID_t id, uint8_t *key_bytes, uint16_t key_size)
+{
+    bleResult_t status = gBleNVMError_c;
+
+    if ((id < KeyMaxID) && (key_size == BleKeysRegistry[id].max_size))
+    {
+        (void)memcpy(maKeys[id], key_bytes, key_size);
+        status = gBleSuccess_c;
+    }
+    return status;
+}
+
+bleResult_t App_NvmReadSystemParams(systemParameters_t **pSysParams)
+{
+    static systemParameters_t params;
+    uint32_t i;
+
+    for (i = 0U; i < (uint32_t)ParamMaxID; i++)
+    {
+        params.system_params.buffer[i] = (uint32_t)maParams[i];
+    }
+    *pSysParams = &params;
+    return gBleSuccess_c;
+}
+
+bleResult_t App_NvmFlushSystemParams(bool_t sync)
+{
+    (void)sync;
+    mFlushes++;
+    return gBleSuccess_c;
+}
+
+void App_CountersCompact(appCounterCompactReason_t reason)
+{
+    (void)reason;
+}
+
+uint32_t App_CounterGet(appCounterId_t id)
+{
+    return (id == gAppCounterSteps_c) ? mSteps : 0U;
+}
+
+void HAL_ResetMCU(void)
+{
+    mResets++;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+static double Bench_Now(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + ((double)now.tv_nsec * 1e-9);
+}
+
+static uint64_t Bench_Cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0U;
+#endif
+}
+
+/* App_NvmWriteSystemParam before the direct index */
+static bleResult_t Bench_LegacyWriteSystemParam(systemParamID_t id, int32_t value)
+{
+    bleResult_t status;
+    systemParamID_t eId;
+
+    status = gBleNVMError_c;
+    for (eId = 0; eId < ParamMaxID; eId++)
+    {
+        if (eId == id)
+        {
+            if ((value >= SystemParamsRegistry[eId].min_value) && (value <= SystemParamsRegistry[eId].max_value))
+            {
+                if (maParams[eId] != value)
+                {
+                    maParams[eId] = value;
+                    mDirtyMarks++;
+                }
+                status = gBleSuccess_c;
+                break;
+            }
+        }
+    }
+    return status;
+}
+
+static void Bench_LegacyPerformReset(int32_t arg, int32_t value)
+{
+    (void)arg;
+    (void)value;
+    mResets++;
+}
+
+static void Bench_LegacySetParam(int32_t arg, int32_t value)
+{
+    (void)Bench_LegacyWriteSystemParam((systemParamID_t)arg, value);
+}
+
+static void Bench_LegacySetKey(int32_t arg, uint8_t *key_bytes, uint16_t key_size)
+{
+    (void)App_NvmWriteBleKey((bleKeysID_t)arg, key_bytes, key_size);
+}
+
+/* gEvtAttributeWritten_c of BleApp_GattServerCallback before the write
+   descriptors, the status it sent */
+static bleResult_t Bench_LegacyWrite(uint16_t handle, const uint8_t *aValue, uint16_t cValueLength)
+{
+    int32_t newCaracteristicValue = 0;
+    bleResult_t result = gBleSuccess_c;
+    uint8_t i;
+
+    for (i = 0; i < (sizeof(mCharRegistry) / sizeof(app_ble_chars_metadata)); i++)
+    {
+        if (mCharRegistry[i].u16Handle == handle)
+        {
+            switch (cValueLength)
+            {
+            case sizeof(int8_t):
+                newCaracteristicValue = (int32_t) *((const int8_t*)aValue);
+                break;
+            case sizeof(int16_t):
+                newCaracteristicValue = (int32_t) *((const int16_t*)aValue);
+                break;
+            case sizeof(int32_t):
+                newCaracteristicValue = (int32_t) *((const int32_t*)aValue);
+                break;
+            default:
+                break;
+            }
+            mCharRegistry[i].pcfCharWriteCb(mCharRegistry[i].arg, newCaracteristicValue);
+            newCaracteristicValue = (int32_t)((((uint32_t)newCaracteristicValue >> 24) & 0xffU) |
+                                              (((uint32_t)newCaracteristicValue << 8) & 0xff0000U) |
+                                              (((uint32_t)newCaracteristicValue >> 8) & 0xff00U) |
+                                              (((uint32_t)newCaracteristicValue << 24) & 0xff000000U));
+            result = GattDb_WriteAttribute(handle, cValueLength, (uint8_t *)&newCaracteristicValue);
+            break;
+        }
+    }
+
+    for (i = 0; i < (sizeof(mKeysCharRegistry) / sizeof(app_keys_chars_metadata)); i++)
+    {
+        if (mKeysCharRegistry[i].u16Handle == handle)
+        {
+            uint8_t newArrayBytes[mKeysCharRegistry[i].max_value];
+            (void)memcpy(newArrayBytes, aValue, cValueLength);
+            mKeysCharRegistry[i].pcfCharWriteCb(mKeysCharRegistry[i].arg, newArrayBytes, cValueLength);
+            result = GattDb_WriteAttribute(handle, cValueLength, newArrayBytes);
+            break;
+        }
+    }
+    return result;
+}
+
+static void Bench_Le32(uint8_t *pOut, int32_t value)
+{
+    pOut[0] = (uint8_t)value;
+    pOut[1] = (uint8_t)((uint32_t)value >> 8);
+    pOut[2] = (uint8_t)((uint32_t)value >> 16);
+    pOut[3] = (uint8_t)((uint32_t)value >> 24);
+}
+
+/* The GATT value of a handle, length and bytes */
+static uint32_t Bench_GattValue(uint16_t handle, uint8_t *pOut)
+{
+    uint16_t index = GattDb_GetIndexOfHandle(handle);
+
+    (void)memcpy(pOut, gattDatabase[index].pValue, gattDatabase[index].valueLength);
+    return gattDatabase[index].valueLength;
+}
+
+static uint32_t Bench_Check(void)
+{
+    uint8_t aValue[KEY_MAX_SIZE];
+    uint8_t aGatt[2][gAttMaxMtu_c];
+    uint32_t gattLength[2];
+    int32_t param[2];
+    uint32_t errors = 0U;
+    uint32_t i;
+    uint32_t way;
+
+    for (i = 0U; i < mcParamWrites_c; i++)
+    {
+        uint16_t handle = mCharRegistry[i].u16Handle;
+        systemParamID_t id = (systemParamID_t)mCharRegistry[i].arg;
+        int32_t value = (SystemParamsRegistry[id].min_value + SystemParamsRegistry[id].max_value) / 2;
+
+        if (id == MsTotalStepID)
+        {
+            /* The step counter: the write refused, the count read */
+            mSteps = 0x00012345U;
+            Bench_Le32(aValue, value);
+            App_GattWriteRefresh(handle);
+            if ((App_GattWrite(handle, aValue, 4U) != gAttErrCodeWriteNotPermitted_c) ||
+                (Bench_GattValue(handle, aGatt[0]) != 4U) || (aGatt[0][0] != 0x00U) || (aGatt[0][1] != 0x01U) ||
+                (aGatt[0][2] != 0x23U) || (aGatt[0][3] != 0x45U))
+            {
+                printf("%s: not the step count\n", SystemParamsRegistry[id].name);
+                errors++;
+            }
+            continue;
+        }
+
+        for (way = 0U; way < 2U; way++)
+        {
+            maParams[id] = SystemParamsRegistry[id].default_value;
+            Bench_Le32(aValue, value);
+            if (way == 0U)
+            {
+                (void)Bench_LegacyWrite(handle, aValue, 4U);
+            }
+            else if (App_GattWrite(handle, aValue, 4U) != gAttErrCodeNoError_c)
+            {
+                printf("%s: %d rejected\n", SystemParamsRegistry[id].name, value);
+                errors++;
+            }
+            param[way] = maParams[id];
+            gattLength[way] = Bench_GattValue(handle, aGatt[way]);
+        }
+        if ((param[0] != param[1]) || (gattLength[0] != gattLength[1]) ||
+            (memcmp(aGatt[0], aGatt[1], gattLength[0]) != 0))
+        {
+            printf("%s: scan %d, table %d\n", SystemParamsRegistry[id].name, param[0], param[1]);
+            errors++;
+        }
+
+        /* Out of bounds: rejected, nothing changed */
+        Bench_Le32(aValue, SystemParamsRegistry[id].max_value + 1);
+        if ((App_GattWrite(handle, aValue, 4U) != gAttErrCodeOutOfRange_c) || (maParams[id] != value) ||
+            (Bench_GattValue(handle, aGatt[0]) != gattLength[1]) || (memcmp(aGatt[0], aGatt[1], gattLength[1]) != 0))
+        {
+            printf("%s: %d not rejected\n", SystemParamsRegistry[id].name, SystemParamsRegistry[id].max_value + 1);
+            errors++;
+        }
+    }
+
+    /* 1 and 2 byte values, signed, kept big endian on their width */
+    aValue[0] = (uint8_t)-50;
+    if ((App_GattWrite((uint16_t)value_rssi_intent_high, aValue, 1U) != gAttErrCodeNoError_c) ||
+        (maParams[RssiIntentHighID] != -50) || (Bench_GattValue((uint16_t)value_rssi_intent_high, aGatt[0]) != 1U) ||
+        (aGatt[0][0] != (uint8_t)-50))
+    {
+        printf("rssi_intent_high: 1 byte -50 not set\n");
+        errors++;
+    }
+    aValue[0] = 0xDCU;
+    aValue[1] = 0x05U;
+    if ((App_GattWrite((uint16_t)value_scanning_interval, aValue, 2U) != gAttErrCodeNoError_c) ||
+        (maParams[SlowScanIntervalID] != 1500) || (Bench_GattValue((uint16_t)value_scanning_interval, aGatt[0]) != 2U) ||
+        (aGatt[0][0] != 0x05U) || (aGatt[0][1] != 0xDCU))
+    {
+        printf("scanning_interval: 2 byte 1500 not set\n");
+        errors++;
+    }
+    if (App_GattWrite((uint16_t)value_scanning_interval, aValue, 3U) != gAttErrCodeInvalidAttributeValueLength_c)
+    {
+        printf("scanning_interval: 3 byte value not rejected\n");
+        errors++;
+    }
+
+    /* Keys: as written, of their size only */
+    for (i = 0U; i < NumberOfElements(mKeysCharRegistry); i++)
+    {
+        uint16_t handle = mKeysCharRegistry[i].u16Handle;
+        uint16_t size = (uint16_t)mKeysCharRegistry[i].max_value;
+
+        for (way = 0U; way < 2U; way++)
+        {
+            (void)memset(aValue, (int)(0x40U + i), sizeof(aValue));
+            if (way == 0U)
+            {
+                (void)Bench_LegacyWrite(handle, aValue, size);
+            }
+            else if (App_GattWrite(handle, aValue, size) != gAttErrCodeNoError_c)
+            {
+                printf("key %u rejected\n", i);
+                errors++;
+            }
+            gattLength[way] = Bench_GattValue(handle, aGatt[way]);
+        }
+        if ((gattLength[0] != gattLength[1]) || (memcmp(aGatt[0], aGatt[1], gattLength[0]) != 0) ||
+            (memcmp(maKeys[i], aValue, size) != 0))
+        {
+            printf("key %u: scan and table differ\n", i);
+            errors++;
+        }
+        if (App_GattWrite(handle, aValue, (uint16_t)(size - 1U)) != gAttErrCodeInvalidAttributeValueLength_c)
+        {
+            printf("key %u: %u bytes not rejected\n", i, size - 1U);
+            errors++;
+        }
+    }
+
+    if ((App_GattWrite((uint16_t)service_BLE_params, aValue, 1U) != gAttErrCodeInvalidHandle_c) ||
+        (App_GattWrite(0xFFFFU, aValue, 1U) != gAttErrCodeInvalidHandle_c))
+    {
+        printf("handle without descriptor not rejected\n");
+        errors++;
+    }
+    if (App_GattWrite((uint16_t)value_commands_reset, aValue, 1U) != gAttErrCodeNoError_c || (mResets != 1U))
+    {
+        printf("reset not done\n");
+        errors++;
+    }
+    return errors;
+}
+
+/* Bursts writing every parameter, 4 bytes, each value other than the last */
+static double Bench_Bursts(const char *pName, uint32_t table)
+{
+    uint8_t aValues[2][mcParamWrites_c][sizeof(int32_t)];
+    uint16_t aHandles[mcParamWrites_c];
+    uint32_t marks = mDirtyMarks;
+    double start;
+    double ns;
+    uint64_t cycles;
+    uint32_t burst;
+    uint32_t i;
+
+    for (i = 0U; i < mcParamWrites_c; i++)
+    {
+        systemParamID_t id = (systemParamID_t)mCharRegistry[i].arg;
+
+        aHandles[i] = mCharRegistry[i].u16Handle;
+        Bench_Le32(aValues[0][i], SystemParamsRegistry[id].min_value);
+        Bench_Le32(aValues[1][i], SystemParamsRegistry[id].max_value);
+    }
+
+    start = Bench_Now();
+    cycles = Bench_Cycles();
+    for (burst = 0U; burst < mcBursts_c; burst++)
+    {
+        for (i = 0U; i < mcParamWrites_c; i++)
+        {
+            if (table != 0U)
+            {
+                (void)App_GattWrite(aHandles[i], aValues[burst & 1U][i], 4U);
+            }
+            else
+            {
+                (void)Bench_LegacyWrite(aHandles[i], aValues[burst & 1U][i], 4U);
+            }
+        }
+    }
+    cycles = Bench_Cycles() - cycles;
+    ns = ((Bench_Now() - start) * 1e9) / ((double)mcBursts_c * mcParamWrites_c);
+    printf("%-28s %8.2f ns %8.1f cycles, %u values set\n", pName, ns,
+           (double)cycles / ((double)mcBursts_c * mcParamWrites_c), mDirtyMarks - marks);
+    return ns;
+}
+
+/* The params_tlv_status value: result, then the first rejected field */
+static uint32_t Bench_TlvStatus(uint8_t *pFirstId, uint8_t *pFirstResult)
+{
+    uint8_t aStatus[gAttMaxMtu_c];
+    uint32_t length = Bench_GattValue((uint16_t)value_params_tlv_status, aStatus);
+
+    *pFirstId = (length > 4U) ? aStatus[3] : 0xFFU;
+    *pFirstResult = (length > 4U) ? aStatus[4] : 0xFFU;
+    return aStatus[1];
+}
+
+/* Offset of the value of a parameter in a record, 0 if not in it */
+static uint32_t Bench_TlvValue(const uint8_t *pRecord, uint8_t id)
+{
+    uint32_t offset = 0U;
+    uint32_t i;
+
+    for (i = 0U; i < pRecord[1]; i++)
+    {
+        if (pRecord[gAppParamsTlvHeaderSize_c + (i * 6U)] == id)
+        {
+            offset = gAppParamsTlvHeaderSize_c + (i * 6U) + 2U;
+        }
+    }
+    return offset;
+}
+
+static void Bench_Sleep(uint32_t ms)
+{
+    struct timespec delay = {(time_t)(ms / 1000U), (long)(ms % 1000U) * 1000000L};
+
+    (void)nanosleep(&delay, NULL);
+}
+
+static uint32_t Bench_CheckTlv(uint16_t *pRecordLength)
+{
+    uint8_t aRecord[gAttMaxMtu_c];
+    uint8_t aGatt[gAttMaxMtu_c];
+    uint16_t length;
+    uint32_t flushes;
+    uint32_t errors = 0U;
+    uint8_t firstId;
+    uint8_t firstResult;
+    uint32_t i;
+
+    /* Every parameter to its minimum: one save, read back as written */
+    for (i = 0U; i < (uint32_t)ParamMaxID; i++)
+    {
+        maParams[i] = SystemParamsRegistry[i].default_value;
+    }
+    length = App_ParamsTlvEncode(aRecord, (uint16_t)sizeof(aRecord));
+    if ((aRecord[1] != ((uint32_t)ParamMaxID - 1U)) || (Bench_TlvValue(aRecord, (uint8_t)MsTotalStepID) != 0U))
+    {
+        printf("params_tlv: read record of %u fields, with the step count\n", aRecord[1]);
+        errors++;
+    }
+    for (i = 0U; i < aRecord[1]; i++)
+    {
+        Bench_Le32(&aRecord[gAppParamsTlvHeaderSize_c + (i * 6U) + 2U],
+                   SystemParamsRegistry[aRecord[gAppParamsTlvHeaderSize_c + (i * 6U)]].min_value);
+    }
+    flushes = mFlushes;
+    if ((App_GattWrite((uint16_t)value_params_tlv, aRecord, length) != gAttErrCodeNoError_c) ||
+        (mFlushes != (flushes + 1U)) || (Bench_TlvStatus(&firstId, &firstResult) != gAppParamsTlvOk_c) ||
+        (Bench_GattValue((uint16_t)value_params_tlv, aGatt) != length) || (memcmp(aGatt, aRecord, length) != 0))
+    {
+        printf("params_tlv: record of %u bytes not applied\n", length);
+        errors++;
+    }
+    for (i = 0U; i < (uint32_t)ParamMaxID; i++)
+    {
+        if (maParams[i] != SystemParamsRegistry[i].min_value)
+        {
+            printf("params_tlv: %s %d\n", SystemParamsRegistry[i].name, maParams[i]);
+            errors++;
+        }
+    }
+    *pRecordLength = length;
+
+    /* One field out of bounds: nothing applied, the field reported */
+    for (i = 0U; i < aRecord[1]; i++)
+    {
+        Bench_Le32(&aRecord[gAppParamsTlvHeaderSize_c + (i * 6U) + 2U],
+                   SystemParamsRegistry[aRecord[gAppParamsTlvHeaderSize_c + (i * 6U)]].max_value);
+    }
+    Bench_Le32(&aRecord[Bench_TlvValue(aRecord, (uint8_t)MsOdrID)], SystemParamsRegistry[MsOdrID].max_value + 1);
+    if ((App_GattWrite((uint16_t)value_params_tlv, aRecord, length) != gAppParamsTlvAttError_c) ||
+        (Bench_TlvStatus(&firstId, &firstResult) != gAppParamsTlvFieldsRejected_c) ||
+        (firstId != (uint8_t)MsOdrID) || (firstResult != gAppParamsTlvOutOfRange_c) ||
+        (maParams[SlowScanIntervalID] != SystemParamsRegistry[SlowScanIntervalID].min_value))
+    {
+        printf("params_tlv: out of bounds field not rejected\n");
+        errors++;
+    }
+
+    /* A long write cut short: nothing applied */
+    Bench_Le32(&aRecord[Bench_TlvValue(aRecord, (uint8_t)MsOdrID)], SystemParamsRegistry[MsOdrID].max_value);
+    if ((App_GattWrite((uint16_t)value_params_tlv, aRecord, (uint16_t)(length - 18U)) != gAppParamsTlvAttError_c) ||
+        (Bench_TlvStatus(&firstId, &firstResult) != gAppParamsTlvBadFormat_c) ||
+        (maParams[SlowScanIntervalID] != SystemParamsRegistry[SlowScanIntervalID].min_value))
+    {
+        printf("params_tlv: cut record not rejected\n");
+        errors++;
+    }
+
+    /* A subset, 1 and 2 byte values */
+    aRecord[0] = gAppParamsTlvVersion_c;
+    aRecord[1] = 2U;
+    aRecord[2] = (uint8_t)RssiIntentHighID;
+    aRecord[3] = 1U;
+    aRecord[4] = (uint8_t)-60;
+    aRecord[5] = (uint8_t)SlowScanIntervalID;
+    aRecord[6] = 2U;
+    aRecord[7] = 0xDCU;
+    aRecord[8] = 0x05U;
+    if ((App_GattWrite((uint16_t)value_params_tlv, aRecord, 9U) != gAttErrCodeNoError_c) ||
+        (maParams[RssiIntentHighID] != -60) || (maParams[SlowScanIntervalID] != 1500))
+    {
+        printf("params_tlv: subset not applied\n");
+        errors++;
+    }
+
+    /* The step count is read only */
+    aRecord[0] = gAppParamsTlvVersion_c;
+    aRecord[1] = 1U;
+    aRecord[2] = (uint8_t)MsTotalStepID;
+    aRecord[3] = 1U;
+    aRecord[4] = 7U;
+    if ((App_GattWrite((uint16_t)value_params_tlv, aRecord, 5U) != gAppParamsTlvAttError_c) ||
+        (Bench_TlvStatus(&firstId, &firstResult) != gAppParamsTlvFieldsRejected_c) ||
+        (firstId != (uint8_t)MsTotalStepID) || (firstResult != gAppParamsTlvReadOnly_c))
+    {
+        printf("params_tlv: step count written\n");
+        errors++;
+    }
+
+    /* A parameter set within a long read, by a write or not: its blob reads,
+       and a read of the other peer, get the record built for its first read */
+    App_ParamsTlvRead(0U);
+    length = (uint16_t)Bench_GattValue((uint16_t)value_params_tlv, aRecord);
+    aGatt[0] = gAppParamsTlvVersion_c;
+    aGatt[1] = 1U;
+    aGatt[2] = (uint8_t)DeltaRssiLowID;
+    aGatt[3] = 1U;
+    aGatt[4] = 9U;
+    if ((App_GattWrite((uint16_t)value_params_tlv, aGatt, 5U) != gAttErrCodeNoError_c) ||
+        (maParams[DeltaRssiLowID] != 9))
+    {
+        printf("params_tlv: write within a long read not applied\n");
+        errors++;
+    }
+    maParams[RssiIntentHighID] = -55;
+    App_ParamsTlvRead(1U);
+    App_ParamsTlvDisconnected(1U);
+    for (i = 0U; i < (length / gAttMaxReadDataSize_d(mMtu)); i++)
+    {
+        App_ParamsTlvRead(0U);
+        if ((Bench_GattValue((uint16_t)value_params_tlv, aGatt) != length) || (memcmp(aGatt, aRecord, length) != 0))
+        {
+            printf("params_tlv: record rebuilt at blob read %u\n", i + 1U);
+            errors++;
+        }
+    }
+    /* The next read is a new long read */
+    App_ParamsTlvRead(0U);
+    (void)Bench_GattValue((uint16_t)value_params_tlv, aGatt);
+    if ((aGatt[Bench_TlvValue(aGatt, (uint8_t)RssiIntentHighID)] != (uint8_t)-55) ||
+        (aGatt[Bench_TlvValue(aGatt, (uint8_t)DeltaRssiLowID)] != 9U))
+    {
+        printf("params_tlv: record not rebuilt after the long read\n");
+        errors++;
+    }
+
+    /* That long read is given up after its first read: a read past the
+       timeout is a new long read, and is rebuilt */
+    maParams[RssiIntentHighID] = -65;
+    Bench_Sleep(gAppParamsTlvBlobTimeoutMs_c + 20U);
+    App_ParamsTlvRead(0U);
+    App_ParamsTlvDisconnected(0U);
+    (void)Bench_GattValue((uint16_t)value_params_tlv, aGatt);
+    if (aGatt[Bench_TlvValue(aGatt, (uint8_t)RssiIntentHighID)] != (uint8_t)-65)
+    {
+        printf("params_tlv: record not rebuilt after a long read given up\n");
+        errors++;
+    }
+    return errors;
+}
+
+/* ATT exchanges of a value of length bytes: read, then read blobs; write
+   request, or prepare writes and the execute */
+static void Bench_SyncExchanges(uint16_t recordLength)
+{
+    static const uint16_t aMtu[] = {gAttDefaultMtu_c, gAttMaxMtu_c};
+    uint32_t reads;
+    uint32_t writes;
+    uint32_t i;
+
+    for (i = 0U; i < NumberOfElements(aMtu); i++)
+    {
+        reads = 1U;
+        if (recordLength > gAttMaxReadDataSize_d(aMtu[i]))
+        {
+            reads += ((recordLength - gAttMaxReadDataSize_d(aMtu[i])) + (aMtu[i] - 2U)) / (aMtu[i] - 1U);
+        }
+        writes = 1U;
+        if (recordLength > gAttMaxWriteDataSize_d(aMtu[i]))
+        {
+            writes = ((recordLength + (aMtu[i] - 6U)) / (aMtu[i] - 5U)) + 1U;
+        }
+        printf("full sync, MTU %3u: %u reads, %u writes per characteristic, %u reads, %u writes of params_tlv\n",
+               aMtu[i], mcParamWrites_c, mcParamWrites_c, reads, writes);
+    }
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main(void)
+{
+    uint32_t errors;
+    uint16_t recordLength = 0U;
+    uint32_t described = 0U;
+    uint32_t handle;
+    double scan;
+    double table;
+
+    (void)GattDb_Init();
+    for (handle = 0U; handle <= 0xFFFFU; handle++)
+    {
+        described += (App_GattWriteLookup((uint16_t)handle) != NULL) ? 1U : 0U;
+    }
+    errors = Bench_Check();
+    errors += Bench_CheckTlv(&recordLength);
+    printf("%u writable values, handles 1..%u, %u errors\n", described,
+           gattDatabase[gGattDbAttributeCount_c - 1U].handle, errors);
+
+    scan = Bench_Bursts("parameter write, scan", 0U);
+    table = Bench_Bursts("parameter write, table", 1U);
+    printf("speedup %.1fx\n", scan / table);
+
+    printf("params_tlv record %u bytes\n", recordLength);
+    Bench_SyncExchanges(recordLength);
+
+    return (errors == 0U) ? 0 : 1;
+}
@@ -0,0 +1,30 @@
+/*! *********************************************************************************
+* \file EmbeddedTypes.h
+*
+* Host builds of application modules (tools/): the few SDK types they use.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef EMBEDDED_TYPES_H
+#define EMBEDDED_TYPES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef uint8_t bool_t;
+typedef uint8_t uintn8_t;
+
+#ifndef TRUE
+#define TRUE                1
+#endif
+#ifndef FALSE
+#define FALSE               0
+#endif
+
+#define PACKED_STRUCT       struct __attribute__((packed))
+
+#define NumberOfElements(x) (sizeof(x) / sizeof((x)[0]))
+
+#endif /* EMBEDDED_TYPES_H */
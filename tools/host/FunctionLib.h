@@ -0,0 +1,21 @@
+/*! *********************************************************************************
+* \file FunctionLib.h
+*
+* Host builds of application modules (tools/): FLib memory helpers on the C
+* library.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef FUNCTION_LIB_H
+#define FUNCTION_LIB_H
+
+#include <string.h>
+
+#include "EmbeddedTypes.h"
+
+#define FLib_MemCpy(pDst, pSrc, cBytes)     ((void)memcpy((pDst), (pSrc), (cBytes)))
+#define FLib_MemSet(pDst, value, cBytes)    ((void)memset((pDst), (value), (cBytes)))
+#define FLib_MemCmp(pData1, pData2, cBytes) ((memcmp((pData1), (pData2), (cBytes)) == 0) ? TRUE : FALSE)
+
+#endif /* FUNCTION_LIB_H */
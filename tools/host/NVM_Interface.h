@@ -0,0 +1,62 @@
+/*! *********************************************************************************
+* \file NVM_Interface.h
+*
+* Host builds of application modules (tools/): the NVM framework API, served
+* by tools/nvm_flash_bench/nvm_emu.c. Datasets are registered in the
+* nvm_table section, as the framework registers them in NVM_TABLE_RW.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef NVM_INTERFACE_H
+#define NVM_INTERFACE_H
+
+#include "EmbeddedTypes.h"
+
+typedef enum NVM_Status_tag
+{
+    gNVM_OK_c = 0,
+    gNVM_Error_c,
+    gNVM_InvalidPointer_c,
+    gNVM_NullPointer_c,
+    gNVM_PointerOutOfRange_c,
+    gNVM_FormatFailure_c,
+    gNVM_NoMemory_c,
+    gNVM_SaveRequestRejected_c,
+    gNVM_ModuleNotInitialized_c,
+    gNVM_ModuleAlreadyInitialized_c,
+    gNVM_MetaNotFound_c,
+    gNVM_PageCopyPending_c
+}NVM_Status_t;
+
+typedef enum NVM_DataEntryType_tag
+{
+    gNVM_MirroredInRam_c = 0,
+    gNVM_NotMirroredInRam_c,
+    gNVM_NotMirroredInRamAutoRestore_c
+}NVM_DataEntryType_t;
+
+typedef struct NVM_DataEntry_tag
+{
+    void        *pData;
+    uint16_t    ElementsCount;
+    uint16_t    ElementSize;
+    uint16_t    DataEntryID;
+    uint16_t    DataEntryType;
+}NVM_DataEntry_t;
+
+#define NVM_RegisterDataSet(Data, Elements, ElementSize, DataEntryID, DataEntryType)                \
+    static const NVM_DataEntry_t Data##_NvmEntry                                                    \
+        __attribute__((used, section("nvm_table"), aligned(sizeof(void *)))) =                     \
+        {(void *)(Data), (uint16_t)(Elements), (uint16_t)(ElementSize), (uint16_t)(DataEntryID),   \
+         (uint16_t)(DataEntryType)}
+
+NVM_Status_t NvModuleInit(void);
+NVM_Status_t NvMoveToRam(void **ppData);
+NVM_Status_t NvSaveOnIdle(void *ptrData, bool_t saveAll);
+NVM_Status_t NvSyncSave(void *ptrData, bool_t saveAll);
+NVM_Status_t NvErase(void **ppData);
+NVM_Status_t NvRestoreDataSet(void *ptrData, bool_t restoreAll);
+void NvIdle(void);
+
+#endif /* NVM_INTERFACE_H */
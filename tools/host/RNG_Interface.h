@@ -0,0 +1,18 @@
+/*! *********************************************************************************
+* \file RNG_Interface.h
+*
+* Host builds of application modules (tools/): the random numbers are given
+* by the tool, which can make them fail. As on target, the number of bytes
+* written is returned, negative on error.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef RNG_INTERFACE_H
+#define RNG_INTERFACE_H
+
+#include "EmbeddedTypes.h"
+
+int16_t RNG_GetPseudoRandomData(uint8_t *pOut, uint8_t outBytes, uint8_t *pSeed);
+
+#endif /* RNG_INTERFACE_H */
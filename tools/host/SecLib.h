@@ -0,0 +1,23 @@
+/*! *********************************************************************************
+* \file SecLib.h
+*
+* Host builds of application modules (tools/): the SecLib primitives the
+* application uses, defined by the tool (gatt_cache_bench) or by
+* tools/ccc_crypto_bench/seclib_host.c.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef SECLIB_H
+#define SECLIB_H
+
+#include "EmbeddedTypes.h"
+
+#define SHA256_HASH_SIZE        (32U)
+#define SHA256_BLOCK_SIZE       (64U)
+
+void AES_128_CMAC(const uint8_t *pInput, const uint32_t inputLen, const uint8_t *pKey, uint8_t *pOutput);
+void SHA256_Hash(const uint8_t *pData, uint32_t numBytes, uint8_t *pOutput);
+void HMAC_SHA256(const uint8_t *pKey, uint32_t keyLen, const uint8_t *pData, uint32_t numBytes, uint8_t *pOutput);
+
+#endif /* SECLIB_H */
@@ -0,0 +1,31 @@
+/*! *********************************************************************************
+* \file app_conn.h
+*
+* Host builds of application modules (tools/): the application task callback
+* queues only. App_PostCallbackMessageToQueue is defined by each tool.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef APP_CONN_H
+#define APP_CONN_H
+
+#include "EmbeddedTypes.h"
+#include "ble_general.h"
+
+typedef void *appCallbackParam_t;
+typedef void (*appCallbackHandler_t)(appCallbackParam_t param);
+
+typedef enum appQueueId_tag
+{
+    gAppQueueHost_c = 0,
+    gAppQueueControl_c,
+    gAppQueueConnection_c,
+    gAppQueueHousekeeping_c,
+    gAppQueueCount_c
+}appQueueId_t;
+
+bleResult_t App_PostCallbackMessageToQueue(appCallbackHandler_t handler, appCallbackParam_t param,
+                                           appQueueId_t queueId);
+
+#endif /* APP_CONN_H */
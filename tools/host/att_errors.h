@@ -0,0 +1,38 @@
+/*! *********************************************************************************
+* \file att_errors.h
+*
+* Host builds of application modules (tools/): the ATT error codes the
+* application answers writes with.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef ATT_ERRORS_H
+#define ATT_ERRORS_H
+
+typedef enum
+{
+    gAttErrCodeNoError_c                        = 0x00U,
+    gAttErrCodeInvalidHandle_c                  = 0x01U,
+    gAttErrCodeReadNotPermitted_c               = 0x02U,
+    gAttErrCodeWriteNotPermitted_c              = 0x03U,
+    gAttErrCodeInvalidPdu_c                     = 0x04U,
+    gAttErrCodeInsufficientAuthentication_c     = 0x05U,
+    gAttErrCodeRequestNotSupported_c            = 0x06U,
+    gAttErrCodeInvalidOffset_c                  = 0x07U,
+    gAttErrCodeInsufficientAuthorization_c      = 0x08U,
+    gAttErrCodePrepareQueueFull_c               = 0x09U,
+    gAttErrCodeAttributeNotFound_c              = 0x0AU,
+    gAttErrCodeAttributeNotLong_c               = 0x0BU,
+    gAttErrCodeInsufficientEncryptionKeySize_c  = 0x0CU,
+    gAttErrCodeInvalidAttributeValueLength_c    = 0x0DU,
+    gAttErrCodeUnlikelyError_c                  = 0x0EU,
+    gAttErrCodeInsufficientEncryption_c         = 0x0FU,
+    gAttErrCodeUnsupportedGroupType_c           = 0x10U,
+    gAttErrCodeInsufficientResources_c          = 0x11U,
+    gAttErrCodeDatabaseOutOfSync_c              = 0x12U,
+    gAttErrCodeValueNotAllowed_c                = 0x13U,
+    gAttErrCodeOutOfRange_c                     = 0xFFU
+}attErrorCode_t;
+
+#endif /* ATT_ERRORS_H */
@@ -0,0 +1,21 @@
+/*! *********************************************************************************
+* \file ble_config.h
+*
+* Host builds of application modules (tools/): the BLE host stack limits they
+* use, at the SDK defaults.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef BLE_CONFIG_H
+#define BLE_CONFIG_H
+
+#ifndef gcGapMaximumSavedCccds_c
+#define gcGapMaximumSavedCccds_c            (16U)
+#endif
+
+#ifndef gAppMaxConnections_c
+#define gAppMaxConnections_c                (1U)
+#endif
+
+#endif /* BLE_CONFIG_H */
@@ -0,0 +1,70 @@
+/*! *********************************************************************************
+* \file ble_general.h
+*
+* Host builds of application modules (tools/): the result codes, UUID types,
+* bonding blob sizes and types of the BLE host stack, and the App_Nvm* functions it calls.
+* Keep the blob sizes in step with the SDK when comparing with a target.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef BLE_GENERAL_H
+#define BLE_GENERAL_H
+
+#include "EmbeddedTypes.h"
+#include "ble_config.h"
+
+typedef enum bleResult_tag
+{
+    gBleSuccess_c = 0,
+    gBleInvalidParameter_c,
+    gBleOverflow_c,
+    gBleUnavailable_c,
+    gBleFeatureNotSupported_c,
+    gBleOutOfMemory_c,
+    gBleAlreadyInitialized_c,
+    gBleOsError_c,
+    gBleUnexpectedError_c,
+    gBleInvalidState_c,
+    gBleTimerError_c,
+    gBleNVMError_c,
+    gGattDbInvalidHandle_c
+}bleResult_t;
+
+#define gcBleLongUuidSize_c                 (16U)
+
+typedef uint8_t deviceId_t;
+#define gInvalidDeviceId_c                  (0xFFU)
+
+typedef enum
+{
+    gBleUuidType16_c    = 0x01U,
+    gBleUuidType128_c   = 0x02U,
+    gBleUuidType32_c    = 0x04U
+}bleUuidType_t;
+
+#ifndef gBleBondIdentityHeaderSize_c
+#define gBleBondIdentityHeaderSize_c        (56U)
+#endif
+#define gBleBondDataDynamicSize_c           (16U)
+#define gBleBondDataStaticSize_c            (88U)
+#define gBleBondDataLegacySize_c            (8U)
+#define gBleBondDataDeviceInfoSize_c        (60U)
+#define gBleBondDataDescriptorSize_c        (8U)
+
+typedef struct { uint8_t raw[gBleBondIdentityHeaderSize_c]; } bleBondIdentityHeaderBlob_t;
+typedef struct { uint8_t raw[gBleBondDataDynamicSize_c]; } bleBondDataDynamicBlob_t;
+typedef struct { uint8_t raw[gBleBondDataStaticSize_c]; } bleBondDataStaticBlob_t;
+typedef struct { uint8_t raw[gBleBondDataLegacySize_c]; } bleBondDataLegacyBlob_t;
+typedef struct { uint8_t raw[gBleBondDataDeviceInfoSize_c]; } bleBondDataDeviceInfoBlob_t;
+typedef struct { uint8_t raw[gBleBondDataDescriptorSize_c]; } bleBondDataDescriptorBlob_t;
+
+bleResult_t App_NvmErase(uint8_t mEntryIdx);
+bleResult_t App_NvmWrite(uint8_t mEntryIdx, void *pBondHeader, void *pBondDataDynamic, void *pBondDataStatic,
+                         void *pBondDataLegacy, void *pBondDataDeviceInfo, void *pBondDataDescriptor,
+                         uint8_t mDescriptorIndex);
+bleResult_t App_NvmRead(uint8_t mEntryIdx, void *pBondHeader, void *pBondDataDynamic, void *pBondDataStatic,
+                        void *pBondDataLegacy, void *pBondDataDeviceInfo, void *pBondDataDescriptor,
+                        uint8_t mDescriptorIndex);
+
+#endif /* BLE_GENERAL_H */
@@ -0,0 +1,35 @@
+/*! *********************************************************************************
+* \file ble_sig_defines.h
+*
+* Host builds of application modules (tools/): the Bluetooth SIG 16-bit UUIDs
+* the application database uses.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef BLE_SIG_DEFINES_H
+#define BLE_SIG_DEFINES_H
+
+#define gBleSig_GenericAccessProfile_d          (0x1800U)
+#define gBleSig_GenericAttributeProfile_d       (0x1801U)
+
+#define gBleSig_PrimaryService_d                (0x2800U)
+#define gBleSig_SecondaryService_d              (0x2801U)
+#define gBleSig_Include_d                       (0x2802U)
+#define gBleSig_Characteristic_d                (0x2803U)
+
+#define gBleSig_CharExtendedProperties_d        (0x2900U)
+#define gBleSig_CharUserDescription_d           (0x2901U)
+#define gBleSig_CCCD_d                          (0x2902U)
+#define gBleSig_SCCD_d                          (0x2903U)
+#define gBleSig_CharPresFormatDescriptor_d      (0x2904U)
+#define gBleSig_CharAggregateFormat_d           (0x2905U)
+
+#define gBleSig_GapDeviceName_d                 (0x2A00U)
+#define gBleSig_GattServiceChanged_d            (0x2A05U)
+#define gBleSig_GattClientSupportedFeatures_d   (0x2B29U)
+#define gBleSig_GattDatabaseHash_d              (0x2B2AU)
+#define gBleSig_GattServerSupportedFeatures_d   (0x2B3AU)
+#define gBleSig_GattSecurityLevels_d            (0x2BF5U)
+
+#endif /* BLE_SIG_DEFINES_H */
@@ -0,0 +1,35 @@
+/*! *********************************************************************************
+* \file ble_utils.h
+*
+* Host builds of application modules (tools/): the BLE host utility macros.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef BLE_UTILS_H
+#define BLE_UTILS_H
+
+#include "EmbeddedTypes.h"
+#include "FunctionLib.h"
+#include "ble_sig_defines.h"
+
+#define BleSig_IsServiceDeclarationUuid16(uuid) \
+    (((uuid) == gBleSig_PrimaryService_d) || ((uuid) == gBleSig_SecondaryService_d))
+
+#define Utils_PackTwoByteValue(value, pBuff) \
+    do { (pBuff)[0] = (uint8_t)(value); (pBuff)[1] = (uint8_t)((value) >> 8); } while (0)
+
+static inline void Utils_RevertByteArray(uint8_t *pBuff, uint32_t length)
+{
+    uint8_t temp;
+    uint32_t i;
+
+    for (i = 0U; i < (length / 2U); i++)
+    {
+        temp = pBuff[i];
+        pBuff[i] = pBuff[length - 1U - i];
+        pBuff[length - 1U - i] = temp;
+    }
+}
+
+#endif /* BLE_UTILS_H */
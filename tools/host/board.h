@@ -0,0 +1,12 @@
+/*! *********************************************************************************
+* \file board.h
+*
+* Host builds of application modules (tools/): the board configuration, nothing the tools need.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef BOARD_H
+#define BOARD_H
+
+#endif /* BOARD_H */
@@ -0,0 +1,15 @@
+/*! *********************************************************************************
+* \file fsl_adapter_reset.h
+*
+* Host builds of application modules (tools/): the MCU reset, defined by the
+* tool.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef FSL_ADAPTER_RESET_H
+#define FSL_ADAPTER_RESET_H
+
+void HAL_ResetMCU(void);
+
+#endif /* FSL_ADAPTER_RESET_H */
@@ -0,0 +1,23 @@
+/*! *********************************************************************************
+* \file fsl_component_mem_manager.h
+*
+* Host builds of application modules (tools/): the memory manager is the C
+* library heap.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef FSL_COMPONENT_MEM_MANAGER_H
+#define FSL_COMPONENT_MEM_MANAGER_H
+
+#include <stdlib.h>
+
+#define MEM_BufferAlloc(size)       malloc(size)
+
+static inline int MEM_BufferFree(void *pBuffer)
+{
+    free(pBuffer);
+    return 0;
+}
+
+#endif /* FSL_COMPONENT_MEM_MANAGER_H */
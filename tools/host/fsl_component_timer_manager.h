@@ -0,0 +1,37 @@
+/*! *********************************************************************************
+* \file fsl_component_timer_manager.h
+*
+* Host builds of application modules (tools/): timers never fire, the tools
+* call the timer callbacks' work themselves. TM_GetTimestamp is the
+* monotonic clock, in us.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef FSL_COMPONENT_TIMER_MANAGER_H
+#define FSL_COMPONENT_TIMER_MANAGER_H
+
+#include <stdint.h>
+#include <time.h>
+
+typedef void *timer_handle_t;
+
+#define kStatus_TimerSuccess                0
+#define kTimerModeSingleShot                0x01U
+#define kTimerModeIntervalTimer             0x02U
+#define TIMER_MANAGER_HANDLE_DEFINE(name)   uint32_t name[1]
+
+#define TM_Open(handle)                     ((void)(handle), kStatus_TimerSuccess)
+#define TM_InstallCallback(handle, cb, p)   ((void)(handle), (void)(cb), (void)(p), kStatus_TimerSuccess)
+#define TM_Start(handle, mode, ms)          ((void)(handle), (void)(mode), (void)(ms), kStatus_TimerSuccess)
+#define TM_Stop(handle)                     ((void)(handle), kStatus_TimerSuccess)
+
+static inline uint64_t TM_GetTimestamp(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000U) + ((uint64_t)now.tv_nsec / 1000U);
+}
+
+#endif /* FSL_COMPONENT_TIMER_MANAGER_H */
@@ -0,0 +1,24 @@
+/*! *********************************************************************************
+* \file fsl_os_abstraction.h
+*
+* Host builds of application modules (tools/): single threaded, critical
+* sections and mutexes are empty.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef FSL_OS_ABSTRACTION_H
+#define FSL_OS_ABSTRACTION_H
+
+#define OSA_InterruptDisable()
+#define OSA_InterruptEnable()
+
+typedef void *osa_mutex_handle_t;
+#define KOSA_StatusSuccess                  0
+#define osaWaitForever_c                    0xFFFFFFFFU
+#define OSA_MUTEX_HANDLE_DEFINE(name)       uint32_t name[1]
+#define OSA_MutexCreate(handle)             ((void)(handle), KOSA_StatusSuccess)
+#define OSA_MutexLock(handle, millisec)     ((void)(handle), KOSA_StatusSuccess)
+#define OSA_MutexUnlock(handle)             ((void)(handle), KOSA_StatusSuccess)
+
+#endif /* FSL_OS_ABSTRACTION_H */
@@ -0,0 +1,20 @@
+/*! *********************************************************************************
+* \file gap_interface.h
+*
+* Host builds of application modules (tools/): the GAP bond and CCCD
+* queries, defined by the tool.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef GAP_INTERFACE_H
+#define GAP_INTERFACE_H
+
+#include "EmbeddedTypes.h"
+#include "ble_general.h"
+#include "gap_types.h"
+
+bleResult_t Gap_CheckIfBonded(deviceId_t deviceId, bool_t *pOutIsBonded, uint8_t *pOutNvmIndex);
+bleResult_t Gap_CheckIndicationStatus(deviceId_t deviceId, uint16_t handle, bool_t *pOutIsActive);
+
+#endif /* GAP_INTERFACE_H */
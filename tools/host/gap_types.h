@@ -0,0 +1,14 @@
+/*! *********************************************************************************
+* \file gap_types.h
+*
+* Host builds of application modules (tools/): the GAP types the tools need.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef GAP_TYPES_H
+#define GAP_TYPES_H
+
+#define gInvalidNvmIndex_c                  (0xFFU)
+
+#endif /* GAP_TYPES_H */
@@ -0,0 +1,55 @@
+/*! *********************************************************************************
+* \file gatt_database.h
+*
+* Host builds of application modules (tools/): the GATT database attribute
+* and the calls common/gatt_db/gatt_database.c implements.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef GATT_DATABASE_H
+#define GATT_DATABASE_H
+
+#include "EmbeddedTypes.h"
+#include "ble_general.h"
+#include "ble_sig_defines.h"
+#include "gatt_types.h"
+
+#define gGattDbInvalidHandleIndex_d         (0xFFFFU)
+
+typedef enum
+{
+    gPermissionNone_c                   = 0x00U,
+    gPermissionFlagReadable_c           = 0x01U,
+    gPermissionFlagReadWithEncryption_c = 0x02U,
+    gPermissionFlagReadWithAuthentication_c = 0x04U,
+    gPermissionFlagReadWithAuthorization_c  = 0x08U,
+    gPermissionFlagWritable_c           = 0x10U,
+    gPermissionFlagWriteWithEncryption_c = 0x20U,
+    gPermissionFlagWriteWithAuthentication_c = 0x40U,
+    gPermissionFlagWriteWithAuthorization_c  = 0x80U
+}gattAttributePermissionsBitFields_t;
+
+typedef struct gattDbAttribute_tag
+{
+    uint16_t    handle;
+    uint16_t    permissions;
+    uint32_t    uuid;
+    uint8_t     *pValue;
+    uint16_t    valueLength;
+    uint16_t    uuidType;
+    uint16_t    maxVariableValueLength;
+}gattDbAttribute_t;
+
+extern gattDbAttribute_t *gattDatabase;
+extern uint16_t gGattDbAttributeCount_c;
+
+bleResult_t GattDb_Init(void);
+bleResult_t GattDb_Deinit(void);
+uint16_t GattDb_GetIndexOfHandle(uint16_t handle);
+uint16_t GattDb_GetAttributeValueSize(uint16_t handle);
+bleResult_t GattDb_FindServiceRange(uint16_t serviceHandle, uint16_t *pOutStartIndex, uint16_t *pOutAttributeCount);
+uint16_t GattDb_ServiceStartHandle(uint16_t handle);
+bleResult_t GattDb_ComputeDatabaseHash(void);
+
+#endif /* GATT_DATABASE_H */
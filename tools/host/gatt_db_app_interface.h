@@ -0,0 +1,20 @@
+/*! *********************************************************************************
+* \file gatt_db_app_interface.h
+*
+* Host builds of application modules (tools/): the GATT database application
+* interface, the attribute value write and read. They are part of the host
+* stack, the tool defines them.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef GATT_DB_APP_INTERFACE_H
+#define GATT_DB_APP_INTERFACE_H
+
+#include "EmbeddedTypes.h"
+#include "ble_general.h"
+
+bleResult_t GattDb_WriteAttribute(uint16_t handle, uint16_t valueLength, const uint8_t *aValue);
+bleResult_t GattDb_ReadAttribute(uint16_t handle, uint16_t maxBytes, uint8_t *aOutValue, uint16_t *pOutValueLength);
+
+#endif /* GATT_DB_APP_INTERFACE_H */
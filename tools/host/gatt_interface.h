@@ -0,0 +1,19 @@
+/*! *********************************************************************************
+* \file gatt_interface.h
+*
+* Host builds of application modules (tools/): the ATT MTU of a peer,
+* defined by the tool.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef GATT_INTERFACE_H
+#define GATT_INTERFACE_H
+
+#include "EmbeddedTypes.h"
+#include "ble_general.h"
+#include "gatt_types.h"
+
+bleResult_t Gatt_GetMtu(deviceId_t deviceId, uint16_t *pOutMtu);
+
+#endif /* GATT_INTERFACE_H */
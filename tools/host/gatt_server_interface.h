@@ -0,0 +1,19 @@
+/*! *********************************************************************************
+* \file gatt_server_interface.h
+*
+* Host builds of application modules (tools/): the GATT server
+* indication, defined by the tool.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef GATT_SERVER_INTERFACE_H
+#define GATT_SERVER_INTERFACE_H
+
+#include "EmbeddedTypes.h"
+#include "ble_general.h"
+
+bleResult_t GattServer_SendInstantValueIndication(deviceId_t deviceId, uint16_t handle, uint16_t valueLength,
+                                                 const uint8_t *aValue);
+
+#endif /* GATT_SERVER_INTERFACE_H */
@@ -0,0 +1,45 @@
+/*! *********************************************************************************
+* \file gatt_types.h
+*
+* Host builds of application modules (tools/): characteristic properties, CCCD
+* values and ATT sizes used by gatt_db.h.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef GATT_TYPES_H
+#define GATT_TYPES_H
+
+#include "EmbeddedTypes.h"
+
+#define gAttDefaultMtu_c                    (23U)
+#ifndef gAttMaxMtu_c
+#define gAttMaxMtu_c                        (247U)
+#endif
+#define gAttMaxWriteDataSize_d(mtu)         ((mtu) - 3U)
+#define gAttMaxReadDataSize_d(mtu)          ((mtu) - 1U)
+#define gAttMaxNotifIndDataSize_d(mtu)      ((mtu) - 3U)
+
+#define gGattDatabaseHashSize_c             (16U)
+
+typedef enum
+{
+    gGattCharPropNoProperty_c           = 0x00U,
+    gGattCharPropBroadcast_c            = 0x01U,
+    gGattCharPropRead_c                 = 0x02U,
+    gGattCharPropWriteWithoutRsp_c      = 0x04U,
+    gGattCharPropWrite_c                = 0x08U,
+    gGattCharPropNotify_c               = 0x10U,
+    gGattCharPropIndicate_c             = 0x20U,
+    gGattCharPropAuthSignedWrites_c     = 0x40U,
+    gGattCharPropExtendedProperties_c   = 0x80U
+}gattCharacteristicPropertiesBitFields_t;
+
+typedef enum
+{
+    gCccdEmpty_c        = 0x0000U,
+    gCccdNotification_c = 0x0001U,
+    gCccdIndication_c   = 0x0002U
+}gattCccdFlags_t;
+
+#endif /* GATT_TYPES_H */
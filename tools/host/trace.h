@@ -0,0 +1,17 @@
+/*! *********************************************************************************
+* \file trace.h
+*
+* Host builds of application modules (tools/): the console traces are dropped.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#define TRACE_DEBUG(...)
+#define TRACE_INFO(...)
+#define TRACE_WARNING(...)
+#define TRACE_ERROR(...)
+
+#endif /* TRACE_H */
@@ -0,0 +1,306 @@
+/*! *********************************************************************************
+* \file flash_emu.c
+*
+* Internal flash emulator, see flash_emu.h. The file holds the flash image
+* followed by a trailer with the erase count of each sector.
+*
+* An interrupted erase leaves a random part of the sector's bits set, an
+* interrupted program a random part of the phrase's bits cleared: readers
+* must not trust either.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "flash_emu.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mcFlashEmuMagic_c           0x464C4531U     /* "FLE1" */
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+typedef struct flashEmuTrailer_tag
+{
+    uint32_t    magic;
+    uint32_t    sectors;
+    uint32_t    sectorSize;
+    uint32_t    phraseSize;
+    uint32_t    wear[];         /* Erase count per sector */
+}flashEmuTrailer_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static uint8_t *mpFlash = NULL;
+static flashEmuTrailer_t *mpTrailer = NULL;
+static size_t mMapSize = 0U;
+static uint32_t mFlashSize = 0U;
+
+static uint32_t mEraseUs = gFlashEmuEraseUs_c;
+static uint32_t mProgramUs = gFlashEmuProgramUs_c;
+
+static uint64_t mStep = 0U;
+static uint64_t mCutStep = 0U;
+static flashEmuPowerLoss_t mpfPowerLoss = NULL;
+
+static flashEmuStats_t mStats;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+/* Counts an erase or program step. At the cut step, leaves the partial
+   effect and loses power. */
+static void FlashEmu_Step(uint8_t *pDst, const uint8_t *pData, uint32_t length)
+{
+    flashEmuPowerLoss_t pfPowerLoss = mpfPowerLoss;
+    uint32_t i;
+
+    mStep++;
+    if ((mCutStep != 0U) && (mStep == mCutStep) && (pfPowerLoss != NULL))
+    {
+        for (i = 0U; i < length; i++)
+        {
+            pDst[i] = (pData != NULL) ? (uint8_t)(pDst[i] & (pData[i] | (uint8_t)rand()))
+                                      : (uint8_t)(pDst[i] | (uint8_t)rand());
+        }
+        mCutStep = 0U;
+        mpfPowerLoss = NULL;
+        pfPowerLoss();
+    }
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Maps the flash file, created erased when missing or of another
+*               geometry.
+*
+* \param[in]    pPath           Flash file.
+* \param[in]    sectors         Flash size, in sectors.
+*
+* \return       FALSE if the file cannot be mapped.
+********************************************************************************** */
+bool_t FlashEmu_Open(const char *pPath, uint32_t sectors)
+{
+    struct stat st;
+    bool_t fresh;
+    int fd;
+
+    mFlashSize = sectors * gFlashEmuSectorSize_c;
+    mMapSize = (size_t)mFlashSize + sizeof(flashEmuTrailer_t) + ((size_t)sectors * sizeof(uint32_t));
+
+    fd = open(pPath, O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+    {
+        perror(pPath);
+        return FALSE;
+    }
+    fresh = ((fstat(fd, &st) != 0) || ((size_t)st.st_size != mMapSize)) ? TRUE : FALSE;
+    if ((fresh == TRUE) && (ftruncate(fd, (off_t)mMapSize) != 0))
+    {
+        perror(pPath);
+        (void)close(fd);
+        return FALSE;
+    }
+
+    mpFlash = mmap(NULL, mMapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (mpFlash == MAP_FAILED)
+    {
+        perror(pPath);
+        mpFlash = NULL;
+        return FALSE;
+    }
+    mpTrailer = (flashEmuTrailer_t *)(void *)&mpFlash[mFlashSize];
+
+    if ((fresh == TRUE) || (mpTrailer->magic != mcFlashEmuMagic_c) || (mpTrailer->sectors != sectors) ||
+        (mpTrailer->sectorSize != gFlashEmuSectorSize_c) || (mpTrailer->phraseSize != gFlashEmuPhraseSize_c))
+    {
+        (void)memset(mpFlash, gFlashEmuErasedByte_c, mFlashSize);
+        (void)memset(mpTrailer, 0, mMapSize - mFlashSize);
+        mpTrailer->magic = mcFlashEmuMagic_c;
+        mpTrailer->sectors = sectors;
+        mpTrailer->sectorSize = gFlashEmuSectorSize_c;
+        mpTrailer->phraseSize = gFlashEmuPhraseSize_c;
+    }
+
+    FlashEmu_ResetStats();
+    return TRUE;
+}
+
+/*! *********************************************************************************
+* \brief        Unmaps the flash file, its content and wear are kept.
+********************************************************************************** */
+void FlashEmu_Close(void)
+{
+    if (mpFlash != NULL)
+    {
+        (void)msync(mpFlash, mMapSize, MS_SYNC);
+        (void)munmap(mpFlash, mMapSize);
+        mpFlash = NULL;
+        mpTrailer = NULL;
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Flash content, read directly as on target.
+********************************************************************************** */
+const uint8_t *FlashEmu_Base(void)
+{
+    return mpFlash;
+}
+
+uint32_t FlashEmu_Size(void)
+{
+    return mFlashSize;
+}
+
+/*! *********************************************************************************
+* \brief        Erases a sector.
+********************************************************************************** */
+flashEmuStatus_t FlashEmu_Erase(uint32_t sector)
+{
+    uint8_t *pSector;
+
+    if ((mpFlash == NULL) || (sector >= mpTrailer->sectors))
+    {
+        mStats.rejected++;
+        return gFlashEmuRange_c;
+    }
+
+    pSector = &mpFlash[sector * gFlashEmuSectorSize_c];
+    mpTrailer->wear[sector]++;
+    mStats.erases++;
+    mStats.busyUs += mEraseUs;
+    FlashEmu_Step(pSector, NULL, gFlashEmuSectorSize_c);
+    (void)memset(pSector, gFlashEmuErasedByte_c, gFlashEmuSectorSize_c);
+    return gFlashEmuOk_c;
+}
+
+/*! *********************************************************************************
+* \brief        Programs whole phrases, one step each. Nothing is programmed
+*               unless all of them are erased.
+*
+* \param[in]    offset          Phrase aligned.
+* \param[in]    pData           Data.
+* \param[in]    length          Phrase multiple.
+********************************************************************************** */
+flashEmuStatus_t FlashEmu_Program(uint32_t offset, const void *pData, uint32_t length)
+{
+    const uint8_t *pSrc = (const uint8_t *)pData;
+    uint32_t done;
+
+    if (((offset % gFlashEmuPhraseSize_c) != 0U) || ((length % gFlashEmuPhraseSize_c) != 0U))
+    {
+        mStats.rejected++;
+        return gFlashEmuAlignment_c;
+    }
+    if ((mpFlash == NULL) || (offset > mFlashSize) || (length > (mFlashSize - offset)))
+    {
+        mStats.rejected++;
+        return gFlashEmuRange_c;
+    }
+    if (FlashEmu_IsErased(offset, length) == FALSE)
+    {
+        mStats.rejected++;
+        return gFlashEmuNotErased_c;
+    }
+
+    for (done = 0U; done < length; done += gFlashEmuPhraseSize_c)
+    {
+        mStats.programs++;
+        mStats.busyUs += mProgramUs;
+        FlashEmu_Step(&mpFlash[offset + done], &pSrc[done], gFlashEmuPhraseSize_c);
+        (void)memcpy(&mpFlash[offset + done], &pSrc[done], gFlashEmuPhraseSize_c);
+    }
+    return gFlashEmuOk_c;
+}
+
+/*! *********************************************************************************
+* \brief        TRUE if the range reads erased.
+********************************************************************************** */
+bool_t FlashEmu_IsErased(uint32_t offset, uint32_t length)
+{
+    uint32_t i;
+
+    for (i = 0U; i < length; i++)
+    {
+        if (mpFlash[offset + i] != gFlashEmuErasedByte_c)
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/*! *********************************************************************************
+* \brief        Sector erase and phrase program times, us.
+********************************************************************************** */
+void FlashEmu_SetTiming(uint32_t eraseUs, uint32_t programUs)
+{
+    mEraseUs = eraseUs;
+    mProgramUs = programUs;
+}
+
+/*! *********************************************************************************
+* \brief        Cuts power at an erase or program step, counted from
+*               FlashEmu_Open. One shot.
+*
+* \param[in]    step            FlashEmu_GetStep() + n cuts the n-th step from
+*                               now. 0 cancels.
+* \param[in]    pfPowerLoss     Called at the cut, must not return.
+********************************************************************************** */
+void FlashEmu_CutAtStep(uint64_t step, flashEmuPowerLoss_t pfPowerLoss)
+{
+    mCutStep = step;
+    mpfPowerLoss = pfPowerLoss;
+}
+
+uint64_t FlashEmu_GetStep(void)
+{
+    return mStep;
+}
+
+const flashEmuStats_t *FlashEmu_GetStats(void)
+{
+    return &mStats;
+}
+
+void FlashEmu_ResetStats(void)
+{
+    (void)memset(&mStats, 0, sizeof(mStats));
+}
+
+/*! *********************************************************************************
+* \brief        Erases of a sector over the life of the flash file.
+********************************************************************************** */
+uint32_t FlashEmu_GetSectorWear(uint32_t sector)
+{
+    return ((mpTrailer != NULL) && (sector < mpTrailer->sectors)) ? mpTrailer->wear[sector] : 0U;
+}
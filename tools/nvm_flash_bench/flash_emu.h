@@ -0,0 +1,85 @@
+/*! *********************************************************************************
+* \file flash_emu.h
+*
+* Internal flash emulator for host builds, backed by a memory mapped file so
+* its content and wear survive the process. It keeps the rules of the target
+* flash: erase by sector, program by phrase, a phrase is programmed once
+* between two erases. Operations are timed on a simulated clock and counted,
+* and power can be cut at any erase or phrase program step.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef FLASH_EMU_H
+#define FLASH_EMU_H
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+#define gFlashEmuSectorSize_c               (8192U)     /* Erase unit */
+#define gFlashEmuPhraseSize_c               (16U)       /* Program unit */
+#define gFlashEmuErasedByte_c               (0xFFU)
+
+/* Default timing, us: in the range of an embedded NOR flash. Set the target's
+   datasheet figures with FlashEmu_SetTiming when comparing with a board. */
+#define gFlashEmuEraseUs_c                  (15000U)
+#define gFlashEmuProgramUs_c                (50U)
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+typedef enum flashEmuStatus_tag
+{
+    gFlashEmuOk_c = 0,
+    gFlashEmuAlignment_c,           /* Not on a sector / phrase boundary */
+    gFlashEmuRange_c,               /* Past the end of the flash */
+    gFlashEmuNotErased_c            /* Phrase programmed since the last erase */
+}flashEmuStatus_t;
+
+/*! \brief  Counters since FlashEmu_Open or the last FlashEmu_ResetStats. */
+typedef struct flashEmuStats_tag
+{
+    uint64_t    busyUs;             /* Simulated erase and program time */
+    uint32_t    erases;             /* Sectors erased */
+    uint32_t    programs;           /* Phrases programmed */
+    uint32_t    rejected;           /* Operations refused, see flashEmuStatus_t */
+}flashEmuStats_t;
+
+/*! \brief  Called at the cut step, after the interrupted operation left its
+            partial effect. Must not return, e.g. longjmp to the test loop. */
+typedef void (*flashEmuPowerLoss_t)(void);
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+bool_t FlashEmu_Open(const char *pPath, uint32_t sectors);
+void FlashEmu_Close(void);
+const uint8_t *FlashEmu_Base(void);
+uint32_t FlashEmu_Size(void);
+
+flashEmuStatus_t FlashEmu_Erase(uint32_t sector);
+flashEmuStatus_t FlashEmu_Program(uint32_t offset, const void *pData, uint32_t length);
+bool_t FlashEmu_IsErased(uint32_t offset, uint32_t length);
+
+void FlashEmu_SetTiming(uint32_t eraseUs, uint32_t programUs);
+void FlashEmu_CutAtStep(uint64_t step, flashEmuPowerLoss_t pfPowerLoss);
+uint64_t FlashEmu_GetStep(void);
+
+const flashEmuStats_t *FlashEmu_GetStats(void);
+void FlashEmu_ResetStats(void);
+uint32_t FlashEmu_GetSectorWear(uint32_t sector);
+
+#endif /* FLASH_EMU_H */
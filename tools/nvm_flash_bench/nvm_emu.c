@@ -0,0 +1,760 @@
+/*! *********************************************************************************
+* \file nvm_emu.c
+*
+* Host NVM framework on the flash emulator. Like the SDK's, it logs records to
+* one of two virtual pages and, when the page is full, copies the latest
+* record of each element to the other page and erases the full one. Record
+* and page formats are its own: the numbers it gives are those of this
+* scheme, close to but not identical with the SDK's.
+*
+* Record: one header phrase (dataset ID, element index, size, flags, data CRC,
+* header CRC), then the data padded to whole phrases. The header is programmed
+* first, so a power loss leaves either a valid header whose data CRC fails or
+* an unreadable phrase after the last record; mount skips both and the
+* element keeps its previous record.
+*
+* Page: a header phrase with a copy counter, programmed once all records are
+* copied. Mount uses the valid page with the highest counter.
+*
+* Datasets come from the nvm_table section (NVM_RegisterDataSet). Not
+* mirrored datasets point to their records in flash, NvMoveToRam gives them a
+* heap copy, a save writes it and points back to flash. Mirrored datasets are
+* restored to RAM at mount.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+
+#include "flash_emu.h"
+#include "nvm_emu.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mcNvPageMagic_c             0x4E565047U     /* "NVPG" */
+#define mcNvNoRecord_c              0xFFFFFFFFU
+#define mcNvRecordData_c            0x0000U
+#define mcNvRecordErased_c          0x0001U         /* Element erased, no data */
+#define mcNvMaxElementSize_c        1024U
+
+#define mcNvPhraseRound(size)       ((((size) + gFlashEmuPhraseSize_c) - 1U) & ~(gFlashEmuPhraseSize_c - 1U))
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+typedef struct nvRecordHeader_tag
+{
+    uint16_t    id;
+    uint16_t    index;
+    uint16_t    size;
+    uint16_t    flags;
+    uint32_t    dataCrc;
+    uint32_t    headerCrc;          /* Of the fields above */
+}nvRecordHeader_t;
+
+typedef struct nvPageHeader_tag
+{
+    uint32_t    magic;
+    uint32_t    counter;
+    uint32_t    reserved;
+    uint32_t    crc;                /* Of the fields above */
+}nvPageHeader_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+extern const NVM_DataEntry_t __start_nvm_table[];
+extern const NVM_DataEntry_t __stop_nvm_table[];
+
+static uint32_t mNvPageSize = 0U;
+static uint32_t mNvActivePage = 0U;
+static uint32_t mNvPageCounter = 0U;
+static uint32_t mNvWriteOffset = 0U;
+static bool_t mNvInitialized = FALSE;
+
+/* Per element, in table order */
+static uint32_t mNvElements = 0U;
+static uint32_t *maNvRecord = NULL;         /* Flash offset of the latest record */
+static bool_t *maNvRamOwned = NULL;         /* Heap copy made by NvMoveToRam */
+static bool_t *maNvPending = NULL;          /* NvSaveOnIdle requested */
+static uint32_t mNvRejectSaves = 0U;        /* Save requests still to reject */
+
+static nvEmuStats_t mNvStats;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+static uint32_t Nv_Crc32(uint32_t crc, const uint8_t *pData, uint32_t length)
+{
+    uint32_t i;
+    uint8_t bit;
+
+    for (i = 0U; i < length; i++)
+    {
+        crc ^= pData[i];
+        for (bit = 0U; bit < 8U; bit++)
+        {
+            crc = ((crc & 1U) != 0U) ? ((crc >> 1) ^ 0xEDB88320U) : (crc >> 1);
+        }
+    }
+    return crc;
+}
+
+static uint32_t Nv_TableCount(void)
+{
+    return (uint32_t)(__stop_nvm_table - __start_nvm_table);
+}
+
+static bool_t Nv_IsMirrored(const NVM_DataEntry_t *pEntry)
+{
+    return (pEntry->DataEntryType == (uint16_t)gNVM_MirroredInRam_c) ? TRUE : FALSE;
+}
+
+/* Address an application passes for an element: its pointer slot, or its RAM
+   copy when mirrored */
+static uint8_t *Nv_Slot(const NVM_DataEntry_t *pEntry, uint32_t index)
+{
+    uint32_t stride = (Nv_IsMirrored(pEntry) == TRUE) ? pEntry->ElementSize : (uint32_t)sizeof(void *);
+
+    return &((uint8_t *)pEntry->pData)[index * stride];
+}
+
+/* Finds the element of an application address. *pCount elements from *pFirst
+   are selected: the whole dataset if all is TRUE and the address is the
+   first element. */
+static bool_t Nv_Find(const void *ptrData, bool_t all, uint32_t *pFirst, uint32_t *pCount,
+                      const NVM_DataEntry_t **ppEntry)
+{
+    const NVM_DataEntry_t *pEntry;
+    uint32_t base = 0U;
+    uint32_t stride;
+    uintptr_t start;
+    uintptr_t addr = (uintptr_t)ptrData;
+
+    for (pEntry = __start_nvm_table; pEntry < __stop_nvm_table; pEntry++)
+    {
+        stride = (Nv_IsMirrored(pEntry) == TRUE) ? pEntry->ElementSize : (uint32_t)sizeof(void *);
+        start = (uintptr_t)pEntry->pData;
+        if ((addr >= start) && (addr < (start + ((uintptr_t)pEntry->ElementsCount * stride))) &&
+            (((addr - start) % stride) == 0U))
+        {
+            *ppEntry = pEntry;
+            if ((all == TRUE) && (addr == start))
+            {
+                *pFirst = base;
+                *pCount = pEntry->ElementsCount;
+            }
+            else
+            {
+                *pFirst = base + (uint32_t)((addr - start) / stride);
+                *pCount = 1U;
+            }
+            return TRUE;
+        }
+        base += pEntry->ElementsCount;
+    }
+    return FALSE;
+}
+
+/* Dataset and index of an element number */
+static const NVM_DataEntry_t *Nv_Entry(uint32_t element, uint32_t *pIndex)
+{
+    const NVM_DataEntry_t *pEntry;
+
+    for (pEntry = __start_nvm_table; pEntry < __stop_nvm_table; pEntry++)
+    {
+        if (element < pEntry->ElementsCount)
+        {
+            *pIndex = element;
+            return pEntry;
+        }
+        element -= pEntry->ElementsCount;
+    }
+    return NULL;
+}
+
+static bool_t Nv_InFlash(const void *ptr)
+{
+    const uint8_t *pFlash = FlashEmu_Base();
+
+    return (((const uint8_t *)ptr >= pFlash) && ((const uint8_t *)ptr < &pFlash[FlashEmu_Size()])) ? TRUE : FALSE;
+}
+
+static uint32_t Nv_PageBase(uint32_t page)
+{
+    return page * mNvPageSize;
+}
+
+static bool_t Nv_PageHeaderValid(uint32_t page, uint32_t *pCounter)
+{
+    nvPageHeader_t header;
+
+    (void)memcpy(&header, &FlashEmu_Base()[Nv_PageBase(page)], sizeof(header));
+    *pCounter = header.counter;
+    return ((header.magic == mcNvPageMagic_c) &&
+            (header.crc == Nv_Crc32(0xFFFFFFFFU, (const uint8_t *)&header, offsetof(nvPageHeader_t, crc))))
+           ? TRUE : FALSE;
+}
+
+static bool_t Nv_ErasePage(uint32_t page)
+{
+    uint32_t sector;
+
+    for (sector = Nv_PageBase(page) / gFlashEmuSectorSize_c;
+         sector < (Nv_PageBase(page) + mNvPageSize) / gFlashEmuSectorSize_c; sector++)
+    {
+        if ((FlashEmu_IsErased(sector * gFlashEmuSectorSize_c, gFlashEmuSectorSize_c) == FALSE) &&
+            (FlashEmu_Erase(sector) != gFlashEmuOk_c))
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static bool_t Nv_WritePageHeader(uint32_t page, uint32_t counter)
+{
+    nvPageHeader_t header;
+
+    header.magic = mcNvPageMagic_c;
+    header.counter = counter;
+    header.reserved = 0U;
+    header.crc = Nv_Crc32(0xFFFFFFFFU, (const uint8_t *)&header, offsetof(nvPageHeader_t, crc));
+    return (FlashEmu_Program(Nv_PageBase(page), &header, sizeof(header)) == gFlashEmuOk_c) ? TRUE : FALSE;
+}
+
+/* Points a not mirrored element to its record, unless the application holds
+   it in RAM */
+static void Nv_PointToRecord(uint32_t element)
+{
+    const NVM_DataEntry_t *pEntry;
+    uint32_t index;
+    void **ppSlot;
+
+    pEntry = Nv_Entry(element, &index);
+    if ((pEntry != NULL) && (Nv_IsMirrored(pEntry) == FALSE))
+    {
+        ppSlot = (void **)(void *)Nv_Slot(pEntry, index);
+        if ((*ppSlot == NULL) || (Nv_InFlash(*ppSlot) == TRUE))
+        {
+            *ppSlot = (maNvRecord[element] != mcNvNoRecord_c)
+                      ? (void *)&FlashEmu_Base()[maNvRecord[element] + sizeof(nvRecordHeader_t)] : NULL;
+        }
+    }
+}
+
+/* Moves the latest record of each element to the other page, then erases
+   this one */
+static bool_t Nv_CopyPage(void)
+{
+    uint8_t buffer[sizeof(nvRecordHeader_t) + mcNvMaxElementSize_c];
+    nvRecordHeader_t header;
+    uint32_t target = 1U - mNvActivePage;
+    uint32_t offset = Nv_PageBase(target) + sizeof(nvPageHeader_t);
+    uint32_t element;
+    uint32_t length;
+
+    if (Nv_ErasePage(target) == FALSE)
+    {
+        return FALSE;
+    }
+    for (element = 0U; element < mNvElements; element++)
+    {
+        if (maNvRecord[element] != mcNvNoRecord_c)
+        {
+            (void)memcpy(&header, &FlashEmu_Base()[maNvRecord[element]], sizeof(header));
+            length = sizeof(header) + mcNvPhraseRound((uint32_t)header.size);
+            (void)memcpy(buffer, &FlashEmu_Base()[maNvRecord[element]], length);
+            if (FlashEmu_Program(offset, buffer, length) != gFlashEmuOk_c)
+            {
+                return FALSE;
+            }
+            maNvRecord[element] = offset;
+            offset += length;
+        }
+    }
+    if ((Nv_WritePageHeader(target, mNvPageCounter + 1U) == FALSE) || (Nv_ErasePage(mNvActivePage) == FALSE))
+    {
+        return FALSE;
+    }
+
+    mNvActivePage = target;
+    mNvPageCounter++;
+    mNvWriteOffset = offset;
+    mNvStats.pageCopies++;
+    for (element = 0U; element < mNvElements; element++)
+    {
+        Nv_PointToRecord(element);
+    }
+    return TRUE;
+}
+
+/* Logs the element's data, or its erasure when pData is NULL */
+static NVM_Status_t Nv_WriteRecord(uint32_t element, const void *pData)
+{
+    uint8_t buffer[sizeof(nvRecordHeader_t) + mcNvMaxElementSize_c];
+    nvRecordHeader_t header;
+    const NVM_DataEntry_t *pEntry;
+    uint32_t index;
+    uint32_t length;
+
+    pEntry = Nv_Entry(element, &index);
+    if ((pEntry == NULL) || (pEntry->ElementSize > mcNvMaxElementSize_c))
+    {
+        return gNVM_Error_c;
+    }
+
+    /* Data first: it may sit in the page a copy erases */
+    header.id = pEntry->DataEntryID;
+    header.index = (uint16_t)index;
+    header.size = (pData != NULL) ? pEntry->ElementSize : 0U;
+    header.flags = (pData != NULL) ? mcNvRecordData_c : mcNvRecordErased_c;
+    (void)memset(buffer, gFlashEmuErasedByte_c, sizeof(buffer));
+    if (pData != NULL)
+    {
+        (void)memcpy(&buffer[sizeof(header)], pData, header.size);
+    }
+    header.dataCrc = Nv_Crc32(0xFFFFFFFFU, &buffer[sizeof(header)], header.size);
+    header.headerCrc = Nv_Crc32(0xFFFFFFFFU, (const uint8_t *)&header, offsetof(nvRecordHeader_t, headerCrc));
+    (void)memcpy(buffer, &header, sizeof(header));
+    length = sizeof(header) + mcNvPhraseRound((uint32_t)header.size);
+
+    if (((mNvWriteOffset + length) > (Nv_PageBase(mNvActivePage) + mNvPageSize)) &&
+        ((Nv_CopyPage() == FALSE) || ((mNvWriteOffset + length) > (Nv_PageBase(mNvActivePage) + mNvPageSize))))
+    {
+        return gNVM_Error_c;
+    }
+    if (FlashEmu_Program(mNvWriteOffset, buffer, length) != gFlashEmuOk_c)
+    {
+        return gNVM_Error_c;
+    }
+
+    maNvRecord[element] = (pData != NULL) ? mNvWriteOffset : mcNvNoRecord_c;
+    mNvWriteOffset += length;
+    mNvStats.records++;
+    mNvStats.recordBytes += length;
+    return gNVM_OK_c;
+}
+
+/* Saves an element from its RAM copy, or from wherever it points */
+static NVM_Status_t Nv_SaveElement(uint32_t element)
+{
+    const NVM_DataEntry_t *pEntry;
+    NVM_Status_t status;
+    uint32_t index;
+    void **ppSlot;
+
+    pEntry = Nv_Entry(element, &index);
+    if (Nv_IsMirrored(pEntry) == TRUE)
+    {
+        status = Nv_WriteRecord(element, Nv_Slot(pEntry, index));
+    }
+    else
+    {
+        ppSlot = (void **)(void *)Nv_Slot(pEntry, index);
+        if (*ppSlot == NULL)
+        {
+            return gNVM_NullPointer_c;
+        }
+        status = Nv_WriteRecord(element, *ppSlot);
+        if (status == gNVM_OK_c)
+        {
+            if (maNvRamOwned[element] == TRUE)
+            {
+                free(*ppSlot);
+                maNvRamOwned[element] = FALSE;
+            }
+            *ppSlot = NULL;
+            Nv_PointToRecord(element);
+        }
+    }
+    if (status == gNVM_OK_c)
+    {
+        maNvPending[element] = FALSE;
+    }
+    return status;
+}
+
+/* Mount: finds the active page and the latest record of each element */
+static void Nv_Mount(void)
+{
+    const uint8_t *pFlash = FlashEmu_Base();
+    nvRecordHeader_t header;
+    const NVM_DataEntry_t *pEntry;
+    uint32_t counters[2];
+    bool_t valid[2];
+    uint32_t end;
+    uint32_t offset;
+    uint32_t element;
+    uint32_t length;
+    uint32_t first;
+    uint32_t index;
+
+    valid[0] = Nv_PageHeaderValid(0U, &counters[0]);
+    valid[1] = Nv_PageHeaderValid(1U, &counters[1]);
+    if ((valid[0] == FALSE) && (valid[1] == FALSE))
+    {
+        /* Blank or unreadable: format */
+        (void)Nv_ErasePage(0U);
+        (void)Nv_ErasePage(1U);
+        (void)Nv_WritePageHeader(0U, 1U);
+        mNvActivePage = 0U;
+        mNvPageCounter = 1U;
+    }
+    else
+    {
+        mNvActivePage = ((valid[1] == TRUE) && ((valid[0] == FALSE) || (counters[1] > counters[0]))) ? 1U : 0U;
+        mNvPageCounter = counters[mNvActivePage];
+    }
+
+    for (element = 0U; element < mNvElements; element++)
+    {
+        maNvRecord[element] = mcNvNoRecord_c;
+    }
+
+    end = Nv_PageBase(mNvActivePage) + mNvPageSize;
+    offset = Nv_PageBase(mNvActivePage) + sizeof(nvPageHeader_t);
+    while ((offset + sizeof(header)) <= end)
+    {
+        if (FlashEmu_IsErased(offset, sizeof(header)) == TRUE)
+        {
+            break;
+        }
+        (void)memcpy(&header, &pFlash[offset], sizeof(header));
+        length = sizeof(header) + mcNvPhraseRound((uint32_t)header.size);
+        if ((header.headerCrc != Nv_Crc32(0xFFFFFFFFU, (const uint8_t *)&header, offsetof(nvRecordHeader_t, headerCrc))) ||
+            ((offset + length) > end))
+        {
+            /* Header cut while programmed: its data was not started, the
+               next record follows */
+            mNvStats.badRecords++;
+            length = gFlashEmuPhraseSize_c;
+        }
+        else if (header.dataCrc != Nv_Crc32(0xFFFFFFFFU, &pFlash[offset + sizeof(header)], header.size))
+        {
+            /* Data cut while programmed: the previous record stands */
+            mNvStats.badRecords++;
+        }
+        else
+        {
+            for (pEntry = __start_nvm_table, first = 0U; pEntry < __stop_nvm_table; pEntry++)
+            {
+                if ((pEntry->DataEntryID == header.id) && (header.index < pEntry->ElementsCount) &&
+                    ((header.flags == mcNvRecordErased_c) || (header.size == pEntry->ElementSize)))
+                {
+                    maNvRecord[first + header.index] = (header.flags == mcNvRecordErased_c) ? mcNvNoRecord_c : offset;
+                    break;
+                }
+                first += pEntry->ElementsCount;
+            }
+        }
+        offset += length;
+    }
+    mNvWriteOffset = offset;
+
+    /* Restore */
+    for (element = 0U; element < mNvElements; element++)
+    {
+        pEntry = Nv_Entry(element, &index);
+        if (Nv_IsMirrored(pEntry) == TRUE)
+        {
+            (void)NvRestoreDataSet(Nv_Slot(pEntry, index), FALSE);
+        }
+        else
+        {
+            *(void **)(void *)Nv_Slot(pEntry, index) = NULL;
+            Nv_PointToRecord(element);
+        }
+    }
+    mNvStats.mounts++;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Opens the flash file: two virtual pages of pageSectors sectors.
+********************************************************************************** */
+bool_t NvEmu_Open(const char *pPath, uint32_t pageSectors)
+{
+    const NVM_DataEntry_t *pEntry;
+
+    mNvPageSize = pageSectors * gFlashEmuSectorSize_c;
+    mNvElements = 0U;
+    for (pEntry = __start_nvm_table; pEntry < __stop_nvm_table; pEntry++)
+    {
+        mNvElements += pEntry->ElementsCount;
+    }
+    maNvRecord = calloc(mNvElements, sizeof(uint32_t));
+    maNvRamOwned = calloc(mNvElements, sizeof(bool_t));
+    maNvPending = calloc(mNvElements, sizeof(bool_t));
+    mNvInitialized = FALSE;
+    NvEmu_ResetStats();
+
+    return ((maNvRecord != NULL) && (maNvRamOwned != NULL) && (maNvPending != NULL) &&
+            (Nv_TableCount() != 0U) && (FlashEmu_Open(pPath, 2U * pageSectors) == TRUE)) ? TRUE : FALSE;
+}
+
+void NvEmu_Close(void)
+{
+    NvEmu_PowerCycle();
+    FlashEmu_Close();
+    free(maNvRecord);
+    free(maNvRamOwned);
+    free(maNvPending);
+    maNvRecord = NULL;
+    maNvRamOwned = NULL;
+    maNvPending = NULL;
+}
+
+/*! *********************************************************************************
+* \brief        Loses what a reset loses: the heap copies and the saves not
+*               done yet. The next NvModuleInit mounts the flash again.
+********************************************************************************** */
+void NvEmu_PowerCycle(void)
+{
+    const NVM_DataEntry_t *pEntry;
+    uint32_t element;
+    uint32_t index;
+
+    for (element = 0U; element < mNvElements; element++)
+    {
+        if (maNvRamOwned[element] == TRUE)
+        {
+            pEntry = Nv_Entry(element, &index);
+            free(*(void **)(void *)Nv_Slot(pEntry, index));
+            *(void **)(void *)Nv_Slot(pEntry, index) = NULL;
+            maNvRamOwned[element] = FALSE;
+        }
+        maNvPending[element] = FALSE;
+    }
+    mNvInitialized = FALSE;
+}
+
+/*! *********************************************************************************
+* \brief        Room left in the active page before the next page copy.
+********************************************************************************** */
+uint32_t NvEmu_GetFreeBytes(void)
+{
+    return (Nv_PageBase(mNvActivePage) + mNvPageSize) - mNvWriteOffset;
+}
+
+const nvEmuStats_t *NvEmu_GetStats(void)
+{
+    return &mNvStats;
+}
+
+void NvEmu_ResetStats(void)
+{
+    (void)memset(&mNvStats, 0, sizeof(mNvStats));
+}
+
+NVM_Status_t NvModuleInit(void)
+{
+    if (mNvInitialized == TRUE)
+    {
+        return gNVM_ModuleAlreadyInitialized_c;
+    }
+    Nv_Mount();
+    mNvInitialized = TRUE;
+    return gNVM_OK_c;
+}
+
+NVM_Status_t NvMoveToRam(void **ppData)
+{
+    const NVM_DataEntry_t *pEntry;
+    uint32_t element;
+    uint32_t count;
+    void *pCopy;
+
+    if (mNvInitialized == FALSE)
+    {
+        return gNVM_ModuleNotInitialized_c;
+    }
+    if ((Nv_Find(ppData, FALSE, &element, &count, &pEntry) == FALSE) || (Nv_IsMirrored(pEntry) == TRUE))
+    {
+        return gNVM_InvalidPointer_c;
+    }
+    if (*ppData == NULL)
+    {
+        return gNVM_NullPointer_c;
+    }
+    if (Nv_InFlash(*ppData) == TRUE)
+    {
+        pCopy = malloc(pEntry->ElementSize);
+        if (pCopy == NULL)
+        {
+            return gNVM_NoMemory_c;
+        }
+        (void)memcpy(pCopy, *ppData, pEntry->ElementSize);
+        *ppData = pCopy;
+        maNvRamOwned[element] = TRUE;
+    }
+    return gNVM_OK_c;
+}
+
+/*! *********************************************************************************
+* \brief        Rejects the next save requests, NvSaveOnIdle or NvSyncSave, with
+*               gNVM_SaveRequestRejected_c.
+********************************************************************************** */
+void NvEmu_RejectSaves(uint32_t saves)
+{
+    mNvRejectSaves = saves;
+}
+
+NVM_Status_t NvSaveOnIdle(void *ptrData, bool_t saveAll)
+{
+    const NVM_DataEntry_t *pEntry;
+    uint32_t first;
+    uint32_t count;
+
+    if (mNvInitialized == FALSE)
+    {
+        return gNVM_ModuleNotInitialized_c;
+    }
+    if (mNvRejectSaves != 0U)
+    {
+        mNvRejectSaves--;
+        return gNVM_SaveRequestRejected_c;
+    }
+    if (Nv_Find(ptrData, saveAll, &first, &count, &pEntry) == FALSE)
+    {
+        return gNVM_InvalidPointer_c;
+    }
+    for (; count > 0U; count--, first++)
+    {
+        maNvPending[first] = TRUE;
+    }
+    return gNVM_OK_c;
+}
+
+NVM_Status_t NvSyncSave(void *ptrData, bool_t saveAll)
+{
+    const NVM_DataEntry_t *pEntry;
+    NVM_Status_t status = gNVM_OK_c;
+    uint32_t first;
+    uint32_t count;
+
+    if (mNvInitialized == FALSE)
+    {
+        return gNVM_ModuleNotInitialized_c;
+    }
+    if (mNvRejectSaves != 0U)
+    {
+        mNvRejectSaves--;
+        return gNVM_SaveRequestRejected_c;
+    }
+    if (Nv_Find(ptrData, saveAll, &first, &count, &pEntry) == FALSE)
+    {
+        return gNVM_InvalidPointer_c;
+    }
+    for (; (count > 0U) && (status == gNVM_OK_c); count--, first++)
+    {
+        status = Nv_SaveElement(first);
+    }
+    return status;
+}
+
+/*! *********************************************************************************
+* \brief        Erases a not mirrored element. An element without record is
+*               left as is.
+********************************************************************************** */
+NVM_Status_t NvErase(void **ppData)
+{
+    const NVM_DataEntry_t *pEntry;
+    NVM_Status_t status = gNVM_OK_c;
+    uint32_t element;
+    uint32_t count;
+
+    if (mNvInitialized == FALSE)
+    {
+        return gNVM_ModuleNotInitialized_c;
+    }
+    if ((Nv_Find(ppData, FALSE, &element, &count, &pEntry) == FALSE) || (Nv_IsMirrored(pEntry) == TRUE))
+    {
+        return gNVM_InvalidPointer_c;
+    }
+    if (maNvRecord[element] != mcNvNoRecord_c)
+    {
+        status = Nv_WriteRecord(element, NULL);
+    }
+    if (status == gNVM_OK_c)
+    {
+        if (maNvRamOwned[element] == TRUE)
+        {
+            free(*ppData);
+            maNvRamOwned[element] = FALSE;
+        }
+        *ppData = NULL;
+        maNvPending[element] = FALSE;
+    }
+    return status;
+}
+
+NVM_Status_t NvRestoreDataSet(void *ptrData, bool_t restoreAll)
+{
+    const NVM_DataEntry_t *pEntry;
+    NVM_Status_t status = gNVM_OK_c;
+    uint32_t first;
+    uint32_t count;
+    uint32_t index = 0U;
+
+    if (Nv_Find(ptrData, restoreAll, &first, &count, &pEntry) == FALSE)
+    {
+        return gNVM_InvalidPointer_c;
+    }
+    for (; count > 0U; count--, first++)
+    {
+        if (maNvRecord[first] == mcNvNoRecord_c)
+        {
+            status = gNVM_MetaNotFound_c;
+        }
+        else if (Nv_IsMirrored(pEntry) == TRUE)
+        {
+            (void)Nv_Entry(first, &index);
+            (void)memcpy(Nv_Slot(pEntry, index), &FlashEmu_Base()[maNvRecord[first] + sizeof(nvRecordHeader_t)],
+                         pEntry->ElementSize);
+        }
+        else
+        {
+            Nv_PointToRecord(first);
+        }
+    }
+    return status;
+}
+
+/*! *********************************************************************************
+* \brief        Idle task: runs the saves requested by NvSaveOnIdle.
+********************************************************************************** */
+void NvIdle(void)
+{
+    uint32_t element;
+
+    if (mNvInitialized == TRUE)
+    {
+        for (element = 0U; element < mNvElements; element++)
+        {
+            if (maNvPending[element] == TRUE)
+            {
+                (void)Nv_SaveElement(element);
+            }
+        }
+    }
+}
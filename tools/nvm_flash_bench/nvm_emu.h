@@ -0,0 +1,50 @@
+/*! *********************************************************************************
+* \file nvm_emu.h
+*
+* Host NVM framework (NVM_Interface.h) on the flash emulator, and the few
+* host-only calls a test loop needs: open the flash, lose the RAM state as a
+* reset does, read the counters.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef NVM_EMU_H
+#define NVM_EMU_H
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "NVM_Interface.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+/*! \brief  Counters since NvEmu_Open or the last NvEmu_ResetStats. */
+typedef struct nvEmuStats_tag
+{
+    uint32_t    records;            /* Records written, erase records included */
+    uint32_t    recordBytes;        /* Flash used by them, headers and padding included */
+    uint32_t    pageCopies;         /* Live records moved to the other virtual page */
+    uint32_t    mounts;             /* NvModuleInit scans */
+    uint32_t    badRecords;         /* Records found corrupt at mount, e.g. after a power loss */
+}nvEmuStats_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+bool_t NvEmu_Open(const char *pPath, uint32_t pageSectors);
+void NvEmu_Close(void);
+void NvEmu_PowerCycle(void);
+uint32_t NvEmu_GetFreeBytes(void);
+const nvEmuStats_t *NvEmu_GetStats(void);
+void NvEmu_ResetStats(void);
+void NvEmu_RejectSaves(uint32_t saves);
+
+#endif /* NVM_EMU_H */
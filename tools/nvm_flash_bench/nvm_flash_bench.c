@@ -0,0 +1,624 @@
+/*! *********************************************************************************
+* \file nvm_flash_bench.c
+*
+* Host benchmark of app_nvm.c, built unchanged with the application
+* configuration, on an emulated internal flash kept in a file (flash_emu.c)
+* under a log-structured NVM (nvm_emu.c).
+*
+* Each workload reports, per operation, the simulated flash busy time (mean
+* and worst), the records and bytes written and the sector erases, and the
+* operations the flash lasts at the given erase endurance:
+*   bond            App_NvmWrite of a whole bond and two CCCDs
+*   unbond          App_NvmErase
+*   params          5 system parameters changed, one flush (log timer)
+*   params/change   the same changes, a flush after each one
+*   ble key         App_NvmWriteBleKey
+*
+* A parameter save rejected by the NVM is then checked to stay pending: the
+* next flush saves it and it reads back after a boot.
+*
+* With -c, power is then cut at random erase or program steps of a random mix
+* of these operations. After each cut the application boots again and every
+* bond part, the parameters and the IRK must read either their value before
+* the interrupted operation or after it.
+*
+* Build, from the repository root:
+*   gcc -O2 -Itools/host -I. -include tools/nvm_flash_bench/nvm_host_preinclude.h \
+*       tools/nvm_flash_bench/nvm_flash_bench.c tools/nvm_flash_bench/nvm_emu.c \
+*       tools/nvm_flash_bench/flash_emu.c app_nvm.c -o nvm_flash_bench
+*
+* Usage:
+*   nvm_flash_bench [-f file] [-s sectors] [-n ops] [-e us] [-p us] [-E cycles]
+*                   [-c cuts] [-r seed]
+*     -f  flash file, kept between runs with its wear
+*         ($TMPDIR/nvm_flash.bin, /tmp if TMPDIR is not set)
+*     -s  sectors per virtual page (2)
+*     -n  operations per workload (1000)
+*     -e  sector erase time, us
+*     -p  phrase program time, us
+*     -E  erase endurance, cycles (10000)
+*     -c  power cuts (0)
+*     -r  random seed (1)
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "EmbeddedTypes.h"
+#include "fsl_component_timer_manager.h"
+#include "app_nvm.h"
+#include "app_counters.h"
+#include "flash_emu.h"
+#include "nvm_emu.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mcBondParts_c               7U      /* 5 blobs and 2 CCCDs */
+#define mcBondCccds_c               2U
+#define mcBondHeaderBytes_c         (gBleBondIdentityHeaderSize_c - 24U)  /* As stored without Secure Mode */
+#define mcChurnParams_c             5U
+#define mcCutWindow_c               2000U   /* Steps from a boot to its cut, at most */
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+typedef enum benchOp_tag
+{
+    mBenchBond_c = 0,
+    mBenchUnbond_c,
+    mBenchParams_c,
+    mBenchParamsPerChange_c,
+    mBenchBleKey_c
+}benchOp_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static const uint16_t maBondPartSize[mcBondParts_c] =
+{
+    mcBondHeaderBytes_c, gBleBondDataDynamicSize_c, gBleBondDataStaticSize_c, gBleBondDataLegacySize_c,
+    gBleBondDataDeviceInfoSize_c, gBleBondDataDescriptorSize_c, gBleBondDataDescriptorSize_c
+};
+
+static const systemParamID_t maChurnParams[mcChurnParams_c] =
+{
+    MsStepInScanID, MsStepOutScanID, MsStillDetectedID, TemperatureID, BatteryLevelID
+};
+
+/* What the flash holds, and what the operation in progress writes: a cut
+   leaves either. Bond parts and the IRK are generations, 0 is none / the
+   default; parameters are rounds, 0 is the defaults. */
+static uint32_t maBondGen[gMaxBondedDevices_c][mcBondParts_c];
+static uint32_t maBondNext[gMaxBondedDevices_c][mcBondParts_c];
+static uint32_t mParamRound = 0U;
+static uint32_t mParamNext = 0U;
+static uint32_t mIrkGen = 0U;
+static uint32_t mIrkNext = 0U;
+static uint32_t mGen = 0U;
+
+static jmp_buf mPowerLossJmp;
+static uint32_t mFailures = 0U;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+static void Bench_Pattern(uint8_t *pData, uint32_t length, uint32_t gen, uint32_t salt)
+{
+    uint32_t i;
+
+    for (i = 0U; i < length; i++)
+    {
+        pData[i] = (uint8_t)((gen * 13U) + (salt * 7U) + i);
+    }
+}
+
+static int32_t Bench_ParamValue(uint32_t round, uint8_t param)
+{
+    static const int32_t aScale[mcChurnParams_c] = {1, 3, 7, 0, 0};
+    int32_t value;
+
+    if (round == 0U)
+    {
+        value = SystemParamsRegistry[maChurnParams[param]].default_value;
+    }
+    else if (maChurnParams[param] == TemperatureID)
+    {
+        value = (int32_t)(round % 121U) - 40;
+    }
+    else if (maChurnParams[param] == BatteryLevelID)
+    {
+        value = (int32_t)(round % 101U);
+    }
+    else
+    {
+        value = (int32_t)((round * (uint32_t)aScale[param]) % 200000U);
+    }
+    return value;
+}
+
+static void Bench_Boot(void)
+{
+    NvEmu_PowerCycle();
+    (void)App_NvmLoadSystemParams();
+    (void)App_NvmLoadBleKeys();
+}
+
+static void Bench_Bond(uint8_t entry)
+{
+    uint8_t aParts[mcBondParts_c][gBleBondDataStaticSize_c];
+    uint8_t part;
+
+    mGen++;
+    for (part = 0U; part < mcBondParts_c; part++)
+    {
+        Bench_Pattern(aParts[part], maBondPartSize[part], mGen, ((uint32_t)entry * mcBondParts_c) + part);
+        maBondNext[entry][part] = mGen;
+    }
+    (void)App_NvmWrite(entry, aParts[0], aParts[1], aParts[2], aParts[3], aParts[4], aParts[5], 0U);
+    (void)App_NvmWrite(entry, NULL, NULL, NULL, NULL, NULL, aParts[6], 1U);
+    NvIdle();
+}
+
+static void Bench_Unbond(uint8_t entry)
+{
+    uint8_t part;
+
+    for (part = 0U; part < mcBondParts_c; part++)
+    {
+        maBondNext[entry][part] = 0U;
+    }
+    (void)App_NvmErase(entry);
+    NvIdle();
+}
+
+static void Bench_Params(bool_t flushEach)
+{
+    uint8_t param;
+
+    mParamNext = mParamRound + 1U;
+    for (param = 0U; param < mcChurnParams_c; param++)
+    {
+        (void)App_NvmWriteSystemParam(maChurnParams[param], Bench_ParamValue(mParamNext, param));
+        if (flushEach == TRUE)
+        {
+            (void)App_NvmFlushSystemParams(FALSE);
+            NvIdle();
+        }
+    }
+    (void)App_NvmFlushSystemParams(FALSE);
+    NvIdle();
+}
+
+static void Bench_BleKey(void)
+{
+    uint8_t aKey[KEY_MAX_SIZE];
+
+    mGen++;
+    mIrkNext = mGen;
+    Bench_Pattern(aKey, sizeof(aKey), mIrkNext, 0xFFU);
+    (void)App_NvmWriteBleKey(IrkKeyID, aKey, KEY_MAX_SIZE);
+    NvIdle();
+}
+
+static void Bench_Run(benchOp_t op, uint8_t entry)
+{
+    uint8_t part;
+
+    switch (op)
+    {
+        case mBenchBond_c:
+            Bench_Bond(entry);
+            break;
+        case mBenchUnbond_c:
+            Bench_Unbond(entry);
+            break;
+        case mBenchParams_c:
+        case mBenchParamsPerChange_c:
+            Bench_Params((op == mBenchParamsPerChange_c) ? TRUE : FALSE);
+            break;
+        default:
+            Bench_BleKey();
+            break;
+    }
+
+    /* Done: the new values are the flash content */
+    for (part = 0U; part < mcBondParts_c; part++)
+    {
+        maBondGen[entry][part] = maBondNext[entry][part];
+    }
+    mParamRound = mParamNext;
+    mIrkGen = mIrkNext;
+}
+
+/* Generation a read matches, of two candidates. FALSE if neither. 0 is never
+   written: the pattern repeats every 256 generations, it would match. */
+static bool_t Bench_Match(const uint8_t *pData, uint32_t length, uint32_t salt, uint32_t gen1, uint32_t gen2,
+                          uint32_t *pGen)
+{
+    uint8_t expected[gBleBondDataStaticSize_c];
+
+    Bench_Pattern(expected, length, gen1, salt);
+    if ((gen1 != 0U) && (memcmp(pData, expected, length) == 0))
+    {
+        *pGen = gen1;
+        return TRUE;
+    }
+    Bench_Pattern(expected, length, gen2, salt);
+    if ((gen2 != 0U) && (memcmp(pData, expected, length) == 0))
+    {
+        *pGen = gen2;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static void Bench_Fail(uint32_t cut, const char *pWhat)
+{
+    if (mFailures < 10U)
+    {
+        printf("cut %u: %s\n", cut, pWhat);
+    }
+    mFailures++;
+}
+
+/* After a cut and a boot: everything reads as before or after the
+   interrupted operation, which becomes the reference */
+static void Bench_Verify(uint32_t cut)
+{
+    uint8_t aData[gBleBondDataStaticSize_c];
+    void *apParts[mcBondParts_c];
+    systemParameters_t *pParams = NULL;
+    IrkLtkKeys_t *pKeys = NULL;
+    uint32_t gen = 0U;
+    uint8_t entry;
+    uint8_t part;
+    uint8_t param;
+    bool_t before = TRUE;
+    bool_t after = TRUE;
+
+    for (entry = 0U; entry < (uint8_t)gMaxBondedDevices_c; entry++)
+    {
+        for (part = 0U; part < mcBondParts_c; part++)
+        {
+            (void)memset(apParts, 0, sizeof(apParts));
+            apParts[(part < 5U) ? part : 5U] = aData;
+            if (App_NvmRead(entry, apParts[0], apParts[1], apParts[2], apParts[3], apParts[4], apParts[5],
+                            (part < 5U) ? 0U : (uint8_t)(part - 5U)) != gBleSuccess_c)
+            {
+                gen = 0U;
+                if ((maBondGen[entry][part] != 0U) && (maBondNext[entry][part] != 0U))
+                {
+                    Bench_Fail(cut, "bond part lost");
+                }
+            }
+            else if (((maBondGen[entry][part] == 0U) && (maBondNext[entry][part] == 0U)) ||
+                     (Bench_Match(aData, maBondPartSize[part], ((uint32_t)entry * mcBondParts_c) + part,
+                                  maBondGen[entry][part], maBondNext[entry][part], &gen) == FALSE))
+            {
+                Bench_Fail(cut, "bond part corrupt");
+                gen = maBondGen[entry][part];
+            }
+            else
+            {
+                ; /* Before or after */
+            }
+            maBondGen[entry][part] = gen;
+            maBondNext[entry][part] = gen;
+        }
+    }
+
+    (void)App_NvmReadSystemParams(&pParams);
+    for (param = 0U; param < mcChurnParams_c; param++)
+    {
+        if ((int32_t)pParams->system_params.buffer[maChurnParams[param]] != Bench_ParamValue(mParamRound, param))
+        {
+            before = FALSE;
+        }
+        if ((int32_t)pParams->system_params.buffer[maChurnParams[param]] != Bench_ParamValue(mParamNext, param))
+        {
+            after = FALSE;
+        }
+    }
+    if ((before == FALSE) && (after == FALSE))
+    {
+        Bench_Fail(cut, "system parameters neither before nor after");
+    }
+    else if ((App_NvmGetParamStats()->loadDefaults != 0U) && (mParamRound != 0U))
+    {
+        Bench_Fail(cut, "system parameter record lost");
+    }
+    else
+    {
+        mParamRound = (after == TRUE) ? mParamNext : mParamRound;
+    }
+    mParamNext = mParamRound;
+
+    (void)App_NvmReadBleKeys(&pKeys);
+    if (((mIrkGen == 0U) || (mIrkNext == 0U)) &&
+        (memcmp(pKeys->ble_keys.vkeys.IRK, IRK_default_value, KEY_MAX_SIZE) == 0))
+    {
+        gen = 0U;
+    }
+    else if (Bench_Match(pKeys->ble_keys.vkeys.IRK, KEY_MAX_SIZE, 0xFFU, mIrkGen, mIrkNext, &gen) == FALSE)
+    {
+        Bench_Fail(cut, "IRK corrupt");
+        gen = mIrkGen;
+    }
+    else
+    {
+        ; /* Before or after */
+    }
+    mIrkGen = gen;
+    mIrkNext = gen;
+}
+
+static void Bench_PowerLoss(void)
+{
+    longjmp(mPowerLossJmp, 1);
+}
+
+static void Bench_Workload(const char *pName, benchOp_t op, uint32_t ops, uint32_t endurance)
+{
+    const flashEmuStats_t *pFlash = FlashEmu_GetStats();
+    const nvEmuStats_t *pNv = NvEmu_GetStats();
+    flashEmuStats_t flash;
+    nvEmuStats_t nv;
+    uint64_t busyUs = 0U;
+    uint64_t maxUs = 0U;
+    uint64_t hostUs = 0U;
+    uint64_t startUs;
+    uint32_t erases = 0U;
+    uint32_t records = 0U;
+    uint32_t bytes = 0U;
+    uint32_t erasesPer1k;
+    uint32_t i;
+    uint8_t entry;
+
+    for (i = 0U; i < ops; i++)
+    {
+        entry = (uint8_t)(i % gMaxBondedDevices_c);
+        if (op == mBenchUnbond_c)
+        {
+            /* Something to unbond, not counted */
+            Bench_Run(mBenchBond_c, entry);
+        }
+
+        flash = *pFlash;
+        nv = *pNv;
+        startUs = TM_GetTimestamp();
+        Bench_Run(op, entry);
+        hostUs += TM_GetTimestamp() - startUs;
+
+        busyUs += pFlash->busyUs - flash.busyUs;
+        maxUs = ((pFlash->busyUs - flash.busyUs) > maxUs) ? (pFlash->busyUs - flash.busyUs) : maxUs;
+        erases += pFlash->erases - flash.erases;
+        records += pNv->records - nv.records;
+        bytes += pNv->recordBytes - nv.recordBytes;
+    }
+
+    erasesPer1k = (uint32_t)(((uint64_t)erases * 1000U) / ops);
+    printf("%-14s %7u %9.2f %8.2f %9.1f %9.1f %8u %12.3g %8.2f\n", pName, ops,
+           ((double)busyUs / 1000.0) / (double)ops, (double)maxUs / 1000.0,
+           (double)records / (double)ops, (double)bytes / (double)ops, erasesPer1k,
+           (erasesPer1k != 0U) ? ((double)endurance * (double)(FlashEmu_Size() / gFlashEmuSectorSize_c) * 1000.0) /
+                                 (double)erasesPer1k : 0.0,
+           (double)hostUs / (double)ops);
+}
+
+/* A rejected save leaves the changes pending for the next flush */
+static void Bench_RejectedSave(void)
+{
+    systemParameters_t *pParams = NULL;
+    uint32_t errors = App_NvmGetParamStats()->errors;
+    uint32_t failures = mFailures;
+    bleResult_t status;
+    uint8_t param;
+
+    mParamNext = mParamRound + 1U;
+    for (param = 0U; param < mcChurnParams_c; param++)
+    {
+        (void)App_NvmWriteSystemParam(maChurnParams[param], Bench_ParamValue(mParamNext, param));
+    }
+    NvEmu_RejectSaves(1U);
+    status = App_NvmFlushSystemParams(FALSE);
+    if ((status == gBleSuccess_c) || (App_NvmGetParamStats()->errors != (errors + 1U)))
+    {
+        printf("rejected parameter save not reported\n");
+        mFailures++;
+    }
+    (void)App_NvmFlushSystemParams(FALSE);
+    NvIdle();
+
+    Bench_Boot();
+    (void)App_NvmReadSystemParams(&pParams);
+    for (param = 0U; param < mcChurnParams_c; param++)
+    {
+        if ((int32_t)pParams->system_params.buffer[maChurnParams[param]] != Bench_ParamValue(mParamNext, param))
+        {
+            printf("parameters lost after a rejected save\n");
+            mFailures++;
+            break;
+        }
+    }
+    mParamRound = mParamNext;
+    printf("rejected save: %u failures\n", mFailures - failures);
+}
+
+static void Bench_PowerCuts(uint32_t cuts)
+{
+    static const benchOp_t aMix[] =
+    {
+        mBenchBond_c, mBenchBond_c, mBenchUnbond_c, mBenchParams_c, mBenchParams_c, mBenchBleKey_c
+    };
+    const nvEmuStats_t *pNv = NvEmu_GetStats();
+    volatile uint32_t cut;
+
+    NvEmu_ResetStats();
+    for (cut = 0U; cut < cuts; cut++)
+    {
+        if (setjmp(mPowerLossJmp) == 0)
+        {
+            FlashEmu_CutAtStep(FlashEmu_GetStep() + 1U + ((uint64_t)rand() % mcCutWindow_c), Bench_PowerLoss);
+            for (;;)
+            {
+                Bench_Run(aMix[(uint32_t)rand() % (sizeof(aMix) / sizeof(aMix[0]))],
+                          (uint8_t)((uint32_t)rand() % gMaxBondedDevices_c));
+            }
+        }
+        Bench_Boot();
+        Bench_Verify(cut);
+    }
+    printf("power loss: %u cuts, %u page copies, %u corrupt records skipped at boot, %u failures\n",
+           cuts, pNv->pageCopies, pNv->badRecords, mFailures);
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/* Calls of app_nvm.c to the application, see nvm_host_preinclude.h. The
+   quiet window timer never fires here: the workloads flush themselves. */
+bleResult_t App_PostCallbackMessageToQueue(appCallbackHandler_t handler, appCallbackParam_t param,
+                                           appQueueId_t queueId)
+{
+    (void)queueId;
+    handler(param);
+    return gBleSuccess_c;
+}
+
+uint32_t App_CounterGet(appCounterId_t id)
+{
+    (void)id;
+    return 0U;
+}
+
+void Update_Ms_register_0x1A(int32_t ms_accuracy_range, int32_t ms_osr, int32_t ms_odr)
+{
+    (void)ms_accuracy_range;
+    (void)ms_osr;
+    (void)ms_odr;
+}
+
+void Update_Ms_register_0x41(int32_t ms_threshold_activity_change)
+{
+    (void)ms_threshold_activity_change;
+}
+
+void Update_Ms_register_0x42(int32_t ms_motion_still_duration)
+{
+    (void)ms_motion_still_duration;
+}
+
+void Ms_wrist_mode_on(void)
+{
+}
+
+void Ms_wrist_mode_off(void)
+{
+}
+
+int main(int argc, char *argv[])
+{
+    static char aDefaultPath[512];
+    const char *pTmpDir = getenv("TMPDIR");
+    const char *pPath = aDefaultPath;
+    uint32_t pageSectors = 2U;
+    uint32_t ops = 1000U;
+    uint32_t eraseUs = gFlashEmuEraseUs_c;
+    uint32_t programUs = gFlashEmuProgramUs_c;
+    uint32_t endurance = 10000U;
+    uint32_t cuts = 0U;
+    uint32_t seed = 1U;
+    uint32_t sector;
+    uint32_t minWear = 0xFFFFFFFFU;
+    uint32_t maxWear = 0U;
+    uint8_t entry;
+    int opt;
+
+    /* Out of the source tree by default */
+    (void)snprintf(aDefaultPath, sizeof(aDefaultPath), "%s/nvm_flash.bin",
+                   ((pTmpDir != NULL) && (pTmpDir[0] != '\0')) ? pTmpDir : "/tmp");
+
+    while ((opt = getopt(argc, argv, "f:s:n:e:p:E:c:r:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'f': pPath = optarg; break;
+            case 's': pageSectors = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'n': ops = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'e': eraseUs = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'p': programUs = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'E': endurance = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'c': cuts = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'r': seed = (uint32_t)strtoul(optarg, NULL, 0); break;
+            default:
+                fprintf(stderr, "usage: %s [-f file] [-s sectors] [-n ops] [-e us] [-p us] [-E cycles] "
+                        "[-c cuts] [-r seed]\n", argv[0]);
+                return 2;
+        }
+    }
+    if ((pageSectors == 0U) || (ops == 0U) || (NvEmu_Open(pPath, pageSectors) == FALSE))
+    {
+        return 2;
+    }
+    srand(seed);
+    FlashEmu_SetTiming(eraseUs, programUs);
+    printf("flash: 2 pages x %u sectors of %u bytes, phrase %u, erase %u us, program %u us\n",
+           pageSectors, gFlashEmuSectorSize_c, gFlashEmuPhraseSize_c, eraseUs, programUs);
+
+    /* Whatever the file holds, start from a known content */
+    Bench_Boot();
+    for (entry = 0U; entry < (uint8_t)gMaxBondedDevices_c; entry++)
+    {
+        (void)App_NvmErase(entry);
+    }
+    Bench_Run(mBenchParams_c, 0U);
+    Bench_Run(mBenchBleKey_c, 0U);
+
+    printf("%-14s %7s %9s %8s %9s %9s %8s %12s %8s\n", "workload", "ops", "flash ms", "max ms",
+           "records", "bytes", "erases", "lifetime", "host us");
+    printf("%-14s %7s %9s %8s %9s %9s %8s %12s %8s\n", "", "", "per op", "", "per op", "per op",
+           "per 1k", "ops", "per op");
+    Bench_Workload("bond", mBenchBond_c, ops, endurance);
+    Bench_Workload("unbond", mBenchUnbond_c, ops, endurance);
+    Bench_Workload("params", mBenchParams_c, ops, endurance);
+    Bench_Workload("params/change", mBenchParamsPerChange_c, ops, endurance);
+    Bench_Workload("ble key", mBenchBleKey_c, ops, endurance);
+
+    Bench_RejectedSave();
+
+    if (cuts != 0U)
+    {
+        Bench_PowerCuts(cuts);
+    }
+
+    for (sector = 0U; sector < (FlashEmu_Size() / gFlashEmuSectorSize_c); sector++)
+    {
+        minWear = (FlashEmu_GetSectorWear(sector) < minWear) ? FlashEmu_GetSectorWear(sector) : minWear;
+        maxWear = (FlashEmu_GetSectorWear(sector) > maxWear) ? FlashEmu_GetSectorWear(sector) : maxWear;
+    }
+    printf("wear: %u to %u erases per sector over the life of %s\n", minWear, maxWear, pPath);
+
+    NvEmu_Close();
+    return (mFailures == 0U) ? 0 : 1;
+}
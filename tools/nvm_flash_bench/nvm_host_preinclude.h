@@ -0,0 +1,33 @@
+/*! *********************************************************************************
+* \file nvm_host_preinclude.h
+*
+* Preinclude of the host build of app_nvm.c: the application configuration
+* (app_preinclude.h) with NVM, unmirrored datasets and bonding as on target.
+* The application task and motion sensor headers app_nvm.c includes need the
+* whole SDK: they are skipped and the few calls it makes declared here,
+* nvm_flash_bench.c defines them.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef NVM_HOST_PREINCLUDE_H
+#define NVM_HOST_PREINCLUDE_H
+
+#include "app_preinclude.h"
+
+#include "EmbeddedTypes.h"
+#include "FunctionLib.h"
+#include "ble_general.h"
+
+/* tools/host/app_conn.h, ahead of the application one */
+#include "app_conn.h"
+
+/* motion_sensor.h */
+#define MOTION_SENSOR_H_
+void Update_Ms_register_0x1A(int32_t ms_accuracy_range, int32_t ms_osr, int32_t ms_odr);
+void Update_Ms_register_0x41(int32_t ms_threshold_activity_change);
+void Update_Ms_register_0x42(int32_t ms_motion_still_duration);
+void Ms_wrist_mode_on(void);
+void Ms_wrist_mode_off(void);
+
+#endif /* NVM_HOST_PREINCLUDE_H */
@@ -0,0 +1,222 @@
+/*! *********************************************************************************
+* \file rke_queue_sim.c
+*
+* Host test of the RKE action queue (app_rke.c, unchanged) driven as
+* app_digital_key_device.c drives it: a press dispatches the RKE Request, a
+* supervision tick resends or drops late actions, Vehicle Status Changed
+* acknowledges and dispatches the next pending action. The RKE Request send
+* is a stub that fails on the scripted attempts. Each scenario checks the
+* actions end acknowledged or dropped, never stuck in flight.
+*
+* The acknowledgement timeout is shortened for the host (see the build line),
+* the supervision tick is its tenth.
+*
+* Build, from the repository root:
+*   gcc -O2 -Itools/host -I. -include app_preinclude.h -DgAppRkeAckTimeoutMs_c=20U \
+*       tools/rke_queue_sim/rke_queue_sim.c app_rke.c -o rke_queue_sim
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "EmbeddedTypes.h"
+#include "app_rke.h"
+#include "app_counters.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mcTickUs_c                  (gAppRkeAckTimeoutMs_c * 100U)
+#define mcMaxTicks_c                1000U
+
+#define mcLock_c                    0x01U
+#define mcUnlock_c                  0x02U
+#define mcCentralLocking_c          0x0001U
+#define mcTrunk_c                   0x0002U
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+/*! \brief  Vehicle stub: sends, scripted failures, acknowledgement of what it received. */
+typedef struct simVehicle_tag
+{
+    uint32_t    failMask;           /*!< Bit n set: send attempt n fails */
+    uint32_t    attempts;
+    uint32_t    received;           /*!< Sends that succeeded */
+    bool_t      acks;               /*!< Acknowledges a received request on the next tick */
+    bool_t      pendingAck;
+    uint16_t    lastFunction;
+}simVehicle_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static void Sim_SendInFlight(simVehicle_t *pVehicle);
+static void Sim_Tick(simVehicle_t *pVehicle);
+static uint32_t Sim_Run(simVehicle_t *pVehicle);
+static uint32_t Sim_Expect(const char *pName, bool_t passed);
+static void Sim_Sleep(uint32_t us);
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main(void)
+{
+    simVehicle_t vehicle;
+    const appRkeStats_t *pStats = App_RkeGetStats();
+    uint32_t failures = 0U;
+    uint32_t ticks;
+
+    /* First send fails: resent on the next tick, then acknowledged */
+    (void)memset(&vehicle, 0, sizeof(vehicle));
+    vehicle.failMask = 0x1U;
+    vehicle.acks = TRUE;
+    App_RkeResetStats();
+    if (App_RkePress(0U, mcCentralLocking_c, mcLock_c) == gAppRkeDispatch_c)
+    {
+        Sim_SendInFlight(&vehicle);
+    }
+    ticks = Sim_Run(&vehicle);
+    failures += Sim_Expect("first send fails", (ticks < mcMaxTicks_c) && (pStats->acked == 1U) &&
+                           (pStats->retries == 1U) && (vehicle.attempts == 2U));
+
+    /* Next action dispatched on acknowledgement, its send fails: not stalled */
+    (void)memset(&vehicle, 0, sizeof(vehicle));
+    vehicle.failMask = 0x2U;
+    vehicle.acks = TRUE;
+    App_RkeResetStats();
+    if (App_RkePress(0U, mcCentralLocking_c, mcUnlock_c) == gAppRkeDispatch_c)
+    {
+        Sim_SendInFlight(&vehicle);
+    }
+    (void)App_RkePress(0U, mcTrunk_c, mcUnlock_c);
+    ticks = Sim_Run(&vehicle);
+    failures += Sim_Expect("queued send fails", (ticks < mcMaxTicks_c) && (pStats->acked == 2U) &&
+                           (pStats->retries == 1U) && (vehicle.attempts == 3U));
+
+    /* Every send fails: dropped after the retries, the pending one still runs */
+    (void)memset(&vehicle, 0, sizeof(vehicle));
+    vehicle.failMask = (1UL << (gAppRkeMaxRetries_c + 1U)) - 1UL;
+    vehicle.acks = TRUE;
+    App_RkeResetStats();
+    if (App_RkePress(0U, mcCentralLocking_c, mcLock_c) == gAppRkeDispatch_c)
+    {
+        Sim_SendInFlight(&vehicle);
+    }
+    (void)App_RkePress(0U, mcTrunk_c, mcUnlock_c);
+    ticks = Sim_Run(&vehicle);
+    failures += Sim_Expect("sends keep failing", (ticks < mcMaxTicks_c) && (pStats->timeouts == 1U) &&
+                           (pStats->acked == 1U) && (vehicle.attempts == (gAppRkeMaxRetries_c + 2U)));
+
+    /* Sent, never acknowledged: resent after the timeout, then dropped */
+    (void)memset(&vehicle, 0, sizeof(vehicle));
+    App_RkeResetStats();
+    if (App_RkePress(0U, mcCentralLocking_c, mcLock_c) == gAppRkeDispatch_c)
+    {
+        Sim_SendInFlight(&vehicle);
+    }
+    ticks = Sim_Run(&vehicle);
+    failures += Sim_Expect("no acknowledgement", (ticks < mcMaxTicks_c) && (pStats->timeouts == 1U) &&
+                           (vehicle.received == (gAppRkeMaxRetries_c + 1U)));
+
+    printf("%u failures\n", failures);
+    return (failures == 0U) ? 0 : 1;
+}
+
+/* app_counters.c */
+void App_CounterAdd(appCounterId_t id, uint32_t increment)
+{
+    (void)id;
+    (void)increment;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+/* As BleApp_RkeSendInFlight: the deadline is armed only by a successful send */
+static void Sim_SendInFlight(simVehicle_t *pVehicle)
+{
+    uint16_t function;
+    uint8_t action;
+
+    if (App_RkeGetInFlight(0U, &function, &action) == TRUE)
+    {
+        if ((pVehicle->failMask & (1UL << pVehicle->attempts)) == 0U)
+        {
+            pVehicle->received++;
+            pVehicle->pendingAck = pVehicle->acks;
+            pVehicle->lastFunction = function;
+            App_RkeMarkSent(0U);
+        }
+        pVehicle->attempts++;
+    }
+}
+
+/* As BleApp_RkeHandleTimeout, and the vehicle answering the last request */
+static void Sim_Tick(simVehicle_t *pVehicle)
+{
+    appRkeStatus_t status;
+
+    if (pVehicle->pendingAck == TRUE)
+    {
+        pVehicle->pendingAck = FALSE;
+        if (App_RkeAcknowledge(0U, pVehicle->lastFunction) == gAppRkeDispatch_c)
+        {
+            Sim_SendInFlight(pVehicle);
+        }
+    }
+
+    status = App_RkeCheckTimeout(0U);
+    if ((status == gAppRkeResend_c) || (status == gAppRkeDispatch_c))
+    {
+        Sim_SendInFlight(pVehicle);
+    }
+}
+
+/* Ticks until the queue is idle, mcMaxTicks_c if it never is */
+static uint32_t Sim_Run(simVehicle_t *pVehicle)
+{
+    uint32_t ticks = 0U;
+
+    while ((App_RkeIsBusy() == TRUE) && (ticks < mcMaxTicks_c))
+    {
+        Sim_Sleep(mcTickUs_c);
+        Sim_Tick(pVehicle);
+        ticks++;
+    }
+    return ticks;
+}
+
+static uint32_t Sim_Expect(const char *pName, bool_t passed)
+{
+    const appRkeStats_t *pStats = App_RkeGetStats();
+
+    printf("%-22s %s: sent %u, retries %u, timeouts %u, acked %u\n", pName, (passed == TRUE) ? "ok" : "FAILED",
+           pStats->sent, pStats->retries, pStats->timeouts, pStats->acked);
+    return (passed == TRUE) ? 0U : 1U;
+}
+
+static void Sim_Sleep(uint32_t us)
+{
+    struct timespec delay = {0, (long)us * 1000L};
+
+    (void)nanosleep(&delay, NULL);
+}
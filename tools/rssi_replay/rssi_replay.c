@@ -0,0 +1,729 @@
+/*! *********************************************************************************
+* \file rssi_replay.c
+*
+* Host replay of RSSI logs through the firmware RSSI filter and intent logic
+* (app_rssi_filter.c, app_rssi_intent.c, app_rssi_motion.c, unchanged), sweeping
+* the filter kind, the delta_rssi_low / medium / high thresholds and, with -M,
+* the motion fusion on and off.
+*
+* Build, from the repository root:
+*   gcc -O2 -Itools/host -I. tools/rssi_replay/rssi_replay.c \
+*       app_rssi_filter.c app_rssi_intent.c app_rssi_motion.c -lpthread -o rssi_replay
+*
+* Log format, one sample per line, '#' lines and a header line are skipped:
+*   t_ms,rssi_dbm[,approach[,walking,steps]]
+* approach is 1 while the user walks to the vehicle, 0 otherwise (default 0).
+* walking is the motion sensor state (1 after a walk event, 0 after a still
+* event) and steps the step counter, both as seen by the firmware.
+*
+* For each configuration the tool reports, over all logs:
+*   - detection delay: first target intent sent minus start of the approach,
+*   - missed approaches: no target intent before the approach ends,
+*   - false triggers: logs where the target intent is sent outside an approach.
+*
+* With -p, and no log, it runs self checks on synthetic RSSI instead:
+*   - two vehicles: RSSI of a vehicle approached and of one left behind, fed
+*     interleaved sample by sample as from two connections, must give each
+*     the intents it gives alone, for every filter kind, fusion off and on,
+*   - motion estimator: the approach hint ends once RSSI and steps stop, and
+*     a stationary user holds intents near the vehicle only,
+*   - Hampel filter: a spike on a steady signal is rejected.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "EmbeddedTypes.h"
+#include "app_rssi_filter.h"
+#include "app_rssi_intent.h"
+#include "app_rssi_motion.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mcMaxLineLength_c           128U
+#define mcMaxThreads_c              64U
+#define mcNoTime_c                  0xFFFFFFFFU
+
+/* Two-peer check: samples per peer, one per connection interval */
+#define mcPeerSamples_c             600U
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+typedef struct replaySample_tag
+{
+    uint32_t    tMs;
+    uint32_t    steps;
+    int8_t      rssi;
+    uint8_t     approach;
+    uint8_t     walking;
+}replaySample_t;
+
+typedef struct replayLog_tag
+{
+    const char      *pName;
+    replaySample_t  *pSamples;
+    uint32_t        count;
+}replayLog_t;
+
+typedef struct replayConfig_tag
+{
+    appRssiFilterKind_t kind;
+    int8_t              deltaLow;
+    int8_t              deltaMedium;
+    int8_t              deltaHigh;
+    bool_t              motion;
+    /* Results */
+    uint32_t            approaches;
+    uint32_t            detected;
+    uint32_t            falseTriggers;
+    uint64_t            delaySumMs;
+    uint32_t            delayMaxMs;
+}replayConfig_t;
+
+typedef struct replayRange_tag
+{
+    int8_t  min;
+    int8_t  max;
+}replayRange_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static const char *maFilterNames[gAppRssiFilterKindCount_c] = {"ema", "median", "hampel", "kalman"};
+
+static replayLog_t *maLogs;
+static uint32_t mLogCount;
+static replayConfig_t *maConfigs;
+static uint32_t mConfigCount;
+static uint32_t mNextConfig;
+static pthread_mutex_t mNextConfigLock = PTHREAD_MUTEX_INITIALIZER;
+
+static int8_t mRssiIntentHigh = -45;
+static appIntent_t mTargetIntent = App_HighIntent;
+
+static uint32_t mRandState = 1U;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+/*! *********************************************************************************
+* \brief        Loads a CSV log. Returns 0 on success.
+********************************************************************************** */
+static int Replay_LoadLog(const char *pPath, replayLog_t *pLog)
+{
+    char aLine[mcMaxLineLength_c];
+    uint32_t capacity = 256U;
+    FILE *pFile = fopen(pPath, "r");
+
+    if (pFile == NULL)
+    {
+        perror(pPath);
+        return -1;
+    }
+    pLog->pName = pPath;
+    pLog->count = 0U;
+    pLog->pSamples = malloc(capacity * sizeof(replaySample_t));
+
+    while ((pLog->pSamples != NULL) && (fgets(aLine, sizeof(aLine), pFile) != NULL))
+    {
+        char *pField = aLine;
+        char *pEnd;
+        long tMs;
+        long rssi;
+        long approach = 0;
+        long walking = 0;
+        long steps = 0;
+
+        if ((aLine[0] == '#') || (aLine[0] < '0') || (aLine[0] > '9'))
+        {
+            continue;
+        }
+        tMs = strtol(pField, &pEnd, 10);
+        if (*pEnd != ',')
+        {
+            continue;
+        }
+        pField = pEnd + 1;
+        rssi = strtol(pField, &pEnd, 10);
+        if (pEnd == pField)
+        {
+            continue;
+        }
+        if (*pEnd == ',')
+        {
+            pField = pEnd + 1;
+            approach = strtol(pField, &pEnd, 10);
+        }
+        if (*pEnd == ',')
+        {
+            pField = pEnd + 1;
+            walking = strtol(pField, &pEnd, 10);
+        }
+        if (*pEnd == ',')
+        {
+            steps = strtol(pEnd + 1, NULL, 10);
+        }
+        if ((rssi < -128) || (rssi > 127))
+        {
+            continue;
+        }
+
+        if (pLog->count == capacity)
+        {
+            capacity *= 2U;
+            pLog->pSamples = realloc(pLog->pSamples, capacity * sizeof(replaySample_t));
+            if (pLog->pSamples == NULL)
+            {
+                break;
+            }
+        }
+        pLog->pSamples[pLog->count].tMs = (uint32_t)tMs;
+        pLog->pSamples[pLog->count].rssi = (int8_t)rssi;
+        pLog->pSamples[pLog->count].approach = (approach != 0) ? 1U : 0U;
+        pLog->pSamples[pLog->count].walking = (walking != 0) ? 1U : 0U;
+        pLog->pSamples[pLog->count].steps = (uint32_t)steps;
+        pLog->count++;
+    }
+    (void)fclose(pFile);
+
+    if (pLog->pSamples == NULL)
+    {
+        fprintf(stderr, "%s: out of memory\n", pPath);
+        return -1;
+    }
+    return 0;
+}
+
+/*! *********************************************************************************
+* \brief        Replays every log through one configuration.
+********************************************************************************** */
+static void Replay_RunConfig(replayConfig_t *pConfig)
+{
+    appRssiIntentParams_t params;
+    appRssiMotionInput_t motion;
+    appRssiIntent_t state;
+    uint32_t logIdx;
+    uint32_t i;
+
+    params.rssiIntentHigh = mRssiIntentHigh;
+    params.deltaLow = pConfig->deltaLow;
+    params.deltaMedium = pConfig->deltaMedium;
+    params.deltaHigh = pConfig->deltaHigh;
+    params.repeatSameIntent = FALSE;
+    params.sameIntentSamples = 0U;
+
+    for (logIdx = 0U; logIdx < mLogCount; logIdx++)
+    {
+        const replayLog_t *pLog = &maLogs[logIdx];
+        uint32_t approachStartMs = mcNoTime_c;
+        bool_t detected = FALSE;
+        bool_t falseTrigger = FALSE;
+
+        App_RssiIntentReset(&state, pConfig->kind);
+        for (i = 0U; i < pLog->count; i++)
+        {
+            const replaySample_t *pSample = &pLog->pSamples[i];
+            appIntent_t intent;
+
+            motion.walking = pSample->walking;
+            motion.stepCount = pSample->steps;
+            intent = App_RssiIntentUpdate(&state, pSample->rssi, &params, (pConfig->motion == TRUE) ? &motion : NULL);
+            bool_t triggered = ((intent != App_Undefined) && (intent >= mTargetIntent)) ? TRUE : FALSE;
+
+            if (pSample->approach != 0U)
+            {
+                if (approachStartMs == mcNoTime_c)
+                {
+                    approachStartMs = pSample->tMs;
+                    detected = FALSE;
+                    pConfig->approaches++;
+                }
+                if ((triggered == TRUE) && (detected == FALSE))
+                {
+                    uint32_t delayMs = pSample->tMs - approachStartMs;
+
+                    detected = TRUE;
+                    pConfig->detected++;
+                    pConfig->delaySumMs += delayMs;
+                    if (delayMs > pConfig->delayMaxMs)
+                    {
+                        pConfig->delayMaxMs = delayMs;
+                    }
+                }
+            }
+            else
+            {
+                /* Approach over, the next one is counted again */
+                approachStartMs = mcNoTime_c;
+                if (triggered == TRUE)
+                {
+                    falseTrigger = TRUE;
+                }
+            }
+        }
+        if (falseTrigger == TRUE)
+        {
+            pConfig->falseTriggers++;
+        }
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Worker thread: takes configurations until none is left.
+********************************************************************************** */
+static void *Replay_Worker(void *pParam)
+{
+    uint32_t idx;
+
+    (void)pParam;
+    for (;;)
+    {
+        (void)pthread_mutex_lock(&mNextConfigLock);
+        idx = mNextConfig++;
+        (void)pthread_mutex_unlock(&mNextConfigLock);
+        if (idx >= mConfigCount)
+        {
+            break;
+        }
+        Replay_RunConfig(&maConfigs[idx]);
+    }
+    return NULL;
+}
+
+/*! *********************************************************************************
+* \brief        Parses "min:max" (or a single value) in dB.
+********************************************************************************** */
+static int Replay_ParseRange(const char *pArg, replayRange_t *pRange)
+{
+    char *pEnd;
+    long min = strtol(pArg, &pEnd, 10);
+    long max = min;
+
+    if (*pEnd == ':')
+    {
+        max = strtol(pEnd + 1, &pEnd, 10);
+    }
+    if ((*pEnd != '\0') || (min > max) || (min < 0) || (max > 60))
+    {
+        return -1;
+    }
+    pRange->min = (int8_t)min;
+    pRange->max = (int8_t)max;
+    return 0;
+}
+
+/*! *********************************************************************************
+* \brief        Noise for the synthetic logs, -4..+4 dB.
+********************************************************************************** */
+static int32_t Replay_Noise(void)
+{
+    mRandState = (mRandState * 1103515245U) + 12345U;
+    return (int32_t)((mRandState >> 16U) % 9U) - 4;
+}
+
+/*! *********************************************************************************
+* \brief        Synthetic log of one peer. The approached vehicle goes from -85 to
+*               -50 dBm from the first third on, the user walking; the other stays
+*               near -70 dBm, the user standing once the approach is over.
+********************************************************************************** */
+static void Replay_SyntheticPeer(replaySample_t *pSamples, bool_t approached)
+{
+    uint32_t i;
+    int32_t rssi;
+
+    for (i = 0U; i < mcPeerSamples_c; i++)
+    {
+        if (approached == TRUE)
+        {
+            rssi = (i < (mcPeerSamples_c / 3U)) ? -85 :
+                   -85 + (int32_t)((35U * (i - (mcPeerSamples_c / 3U))) / (mcPeerSamples_c / 3U));
+            rssi = (rssi > -50) ? -50 : rssi;
+        }
+        else
+        {
+            rssi = -70;
+        }
+        pSamples[i].tMs = i * 50U;
+        pSamples[i].rssi = (int8_t)(rssi + Replay_Noise());
+        pSamples[i].approach = 0U;
+        pSamples[i].walking = ((i >= (mcPeerSamples_c / 3U)) && (i < ((2U * mcPeerSamples_c) / 3U))) ? 1U : 0U;
+        pSamples[i].steps = (pSamples[i].walking != 0U) ? ((i - (mcPeerSamples_c / 3U)) / 10U) : 0U;
+    }
+}
+
+/*! *********************************************************************************
+* \brief        Two peers interleaved, against each peer alone. Returns the failures.
+********************************************************************************** */
+static uint32_t Replay_TwoPeerCheck(void)
+{
+    static replaySample_t aSamples[2][mcPeerSamples_c];
+    static appIntent_t aAlone[2][mcPeerSamples_c];
+    appRssiIntentParams_t params = {-45, 3, 8, 14, FALSE, 0U};
+    appRssiIntent_t aState[2];
+    appRssiMotionInput_t motion;
+    appIntent_t intent;
+    uint32_t failures = 0U;
+    uint32_t aHigh[2];
+    uint32_t peer;
+    uint32_t i;
+    int kind;
+    int fusion;
+
+    Replay_SyntheticPeer(aSamples[0], TRUE);
+    Replay_SyntheticPeer(aSamples[1], FALSE);
+
+    for (kind = 0; kind < (int)gAppRssiFilterKindCount_c; kind++)
+    {
+        for (fusion = 0; fusion <= 1; fusion++)
+        {
+            /* Each peer alone */
+            for (peer = 0U; peer < 2U; peer++)
+            {
+                App_RssiIntentReset(&aState[0], (appRssiFilterKind_t)kind);
+                for (i = 0U; i < mcPeerSamples_c; i++)
+                {
+                    motion.walking = aSamples[peer][i].walking;
+                    motion.stepCount = aSamples[peer][i].steps;
+                    aAlone[peer][i] = App_RssiIntentUpdate(&aState[0], aSamples[peer][i].rssi, &params,
+                                                           (fusion != 0) ? &motion : NULL);
+                }
+            }
+
+            /* Interleaved, as from two connections. The motion sensor is
+               shared: both peers see the same walking state and steps */
+            App_RssiIntentReset(&aState[0], (appRssiFilterKind_t)kind);
+            App_RssiIntentReset(&aState[1], (appRssiFilterKind_t)kind);
+            aHigh[0] = 0U;
+            aHigh[1] = 0U;
+            for (i = 0U; i < mcPeerSamples_c; i++)
+            {
+                for (peer = 0U; peer < 2U; peer++)
+                {
+                    motion.walking = aSamples[peer][i].walking;
+                    motion.stepCount = aSamples[peer][i].steps;
+                    intent = App_RssiIntentUpdate(&aState[peer], aSamples[peer][i].rssi, &params,
+                                                  (fusion != 0) ? &motion : NULL);
+                    if (intent != aAlone[peer][i])
+                    {
+                        printf("FAIL %s motion %d peer %u sample %u: intent %d interleaved, %d alone\n",
+                               maFilterNames[kind], fusion, peer, i, (int)intent, (int)aAlone[peer][i]);
+                        failures++;
+                        break;
+                    }
+                    if (intent == App_HighIntent)
+                    {
+                        aHigh[peer]++;
+                    }
+                }
+            }
+
+            /* The approached vehicle only */
+            if ((aHigh[0] == 0U) || (aHigh[1] != 0U))
+            {
+                printf("FAIL %s motion %d: high intent %u times approached, %u times left behind\n",
+                       maFilterNames[kind], fusion, aHigh[0], aHigh[1]);
+                failures++;
+            }
+        }
+    }
+    printf("two peers interleaved: %u failures\n", failures);
+    return failures;
+}
+
+/*! *********************************************************************************
+* \brief        Motion estimator decay and stationary hold. Returns the failures.
+********************************************************************************** */
+static uint32_t Replay_MotionCheck(void)
+{
+    appRssiIntentParams_t params = {-45, 3, 8, 14, FALSE, 0U};
+    appRssiMotionInput_t input = {TRUE, 0U};
+    appRssiMotionHint_t hint = gAppRssiMotionNeutral_c;
+    appRssiMotion_t motion;
+    appRssiIntent_t state;
+    appIntent_t intent;
+    uint32_t failures = 0U;
+    uint32_t aSent[2];
+    uint32_t pass;
+    uint32_t i;
+    int32_t rssi = -90;
+
+    /* Walking to the vehicle, 1 dB and 1 step per sample */
+    App_RssiMotionReset(&motion);
+    for (i = 0U; i < 60U; i++)
+    {
+        input.stepCount++;
+        hint = App_RssiMotionUpdate(&motion, (int8_t)rssi++, &input);
+    }
+    if (hint != gAppRssiMotionApproach_c)
+    {
+        printf("FAIL motion: no approach hint while walking to the vehicle\n");
+        failures++;
+    }
+    /* Walk state still set, no step and RSSI flat: the slope and cadence
+       averages decay below their thresholds */
+    for (i = 0U; i < 300U; i++)
+    {
+        hint = App_RssiMotionUpdate(&motion, (int8_t)rssi, &input);
+    }
+    if (hint != gAppRssiMotionNeutral_c)
+    {
+        printf("FAIL motion: hint %d after 300 flat samples, slope %d cadence %d (Q16)\n",
+               (int)hint, (int)motion.slopeQ16, (int)motion.cadenceQ16);
+        failures++;
+    }
+
+    /* Standing still from -50 dBm, then RSSI rises to -35 dBm: medium and
+       high intents are held past rssi_intent_high only */
+    input.walking = FALSE;
+    for (pass = 0U; pass < 2U; pass++)
+    {
+        params.rssiIntentHigh = (pass == 0U) ? (int8_t)-45 : (int8_t)-20;
+        App_RssiIntentReset(&state, gAppRssiFilterEma_c);
+        aSent[pass] = 0U;
+        for (i = 0U; i < 400U; i++)
+        {
+            intent = App_RssiIntentUpdate(&state, (i < 200U) ? (int8_t)-50 : (int8_t)-35, &params, &input);
+            if ((intent == App_MediumIntent) || (intent == App_HighIntent))
+            {
+                aSent[pass]++;
+            }
+        }
+    }
+    if ((aSent[0] != 0U) || (aSent[1] != 2U))
+    {
+        printf("FAIL motion: stationary, %u medium / high intents near, %u further away (2 expected)\n",
+               aSent[0], aSent[1]);
+        failures++;
+    }
+
+    printf("motion estimator: %u failures\n", failures);
+    return failures;
+}
+
+/*! *********************************************************************************
+* \brief        Hampel filter on a steady signal with one spike. Returns the failures.
+********************************************************************************** */
+static uint32_t Replay_HampelCheck(void)
+{
+    appRssiFilter_t filter;
+    uint32_t failures = 0U;
+    int8_t estimate = 0;
+    uint32_t i;
+
+    App_RssiFilterInit(&filter, gAppRssiFilterHampel_c);
+    for (i = 0U; i < 20U; i++)
+    {
+        estimate = App_RssiFilterUpdate(&filter, (i == 10U) ? (int8_t)-40 : (int8_t)-70);
+        if (estimate != -70)
+        {
+            printf("FAIL hampel: %d dBm after sample %u, -70 dBm steady with a -40 dBm spike\n",
+                   (int)estimate, i);
+            failures++;
+        }
+    }
+
+    printf("hampel filter: %u failures\n", failures);
+    return failures;
+}
+
+static void Replay_Usage(const char *pName)
+{
+    fprintf(stderr,
+            "usage: %s [-l min:max] [-m min:max] [-H min:max] [-f kind] [-r dBm]\n"
+            "          [-t low|medium|high] [-j threads] [-M] log.csv...\n"
+            "       %s -p\n"
+            "  -l -m -H  delta_rssi_low / medium / high sweep, dB (default 1:8, 4:12, 8:20)\n"
+            "  -f        ema, median, hampel, kalman or all (default all)\n"
+            "  -r        rssi_intent_high, dBm (default -45)\n"
+            "  -t        intent counted as a detection (default high)\n"
+            "  -j        worker threads (default: online CPUs)\n"
+            "  -M        each configuration also with motion fusion\n"
+            "  -p        self checks on synthetic RSSI: two peers, motion estimator, hampel\n",
+            pName, pName);
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main(int argc, char *argv[])
+{
+    replayRange_t low = {1, 8};
+    replayRange_t medium = {4, 12};
+    replayRange_t high = {8, 20};
+    int firstKind = 0;
+    int lastKind = (int)gAppRssiFilterKindCount_c - 1;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    int lastMotion = 0;
+    pthread_t aThreads[mcMaxThreads_c];
+    const replayConfig_t *pBest = NULL;
+    uint32_t started;
+    uint32_t i;
+    int err;
+    int opt;
+    int k;
+    int l;
+    int m;
+    int h;
+    int f;
+
+    while ((opt = getopt(argc, argv, "l:m:H:f:r:t:j:Mp")) != -1)
+    {
+        switch (opt)
+        {
+            case 'l': if (Replay_ParseRange(optarg, &low) != 0) { Replay_Usage(argv[0]); return 1; } break;
+            case 'm': if (Replay_ParseRange(optarg, &medium) != 0) { Replay_Usage(argv[0]); return 1; } break;
+            case 'H': if (Replay_ParseRange(optarg, &high) != 0) { Replay_Usage(argv[0]); return 1; } break;
+            case 'r': mRssiIntentHigh = (int8_t)strtol(optarg, NULL, 10); break;
+            case 'j': threads = strtol(optarg, NULL, 10); break;
+            case 'M': lastMotion = 1; break;
+            case 'p': return (int)(Replay_TwoPeerCheck() + Replay_MotionCheck() + Replay_HampelCheck());
+            case 'f':
+            {
+                if (strcmp(optarg, "all") != 0)
+                {
+                    for (k = 0; k < (int)gAppRssiFilterKindCount_c; k++)
+                    {
+                        if (strcmp(optarg, maFilterNames[k]) == 0)
+                        {
+                            break;
+                        }
+                    }
+                    if (k == (int)gAppRssiFilterKindCount_c)
+                    {
+                        Replay_Usage(argv[0]);
+                        return 1;
+                    }
+                    firstKind = k;
+                    lastKind = k;
+                }
+            }
+            break;
+            case 't':
+            {
+                mTargetIntent = (strcmp(optarg, "low") == 0) ? App_LowIntent :
+                                (strcmp(optarg, "medium") == 0) ? App_MediumIntent : App_HighIntent;
+            }
+            break;
+            default: Replay_Usage(argv[0]); return 1;
+        }
+    }
+    if (optind >= argc)
+    {
+        Replay_Usage(argv[0]);
+        return 1;
+    }
+
+    mLogCount = (uint32_t)(argc - optind);
+    maLogs = calloc(mLogCount, sizeof(replayLog_t));
+    for (i = 0U; (maLogs != NULL) && (i < mLogCount); i++)
+    {
+        if (Replay_LoadLog(argv[optind + (int)i], &maLogs[i]) != 0)
+        {
+            return 1;
+        }
+    }
+
+    /* Grid: every filter kind, low < medium < high, motion fusion off / on */
+    maConfigs = calloc((size_t)(lastMotion + 1) * (size_t)(lastKind - firstKind + 1) * (size_t)(low.max - low.min + 1) *
+                       (size_t)(medium.max - medium.min + 1) * (size_t)(high.max - high.min + 1),
+                       sizeof(replayConfig_t));
+    if ((maLogs == NULL) || (maConfigs == NULL))
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    for (k = firstKind; k <= lastKind; k++)
+    {
+        for (l = low.min; l <= low.max; l++)
+        {
+            for (m = (medium.min > l) ? medium.min : (l + 1); m <= medium.max; m++)
+            {
+                for (h = (high.min > m) ? high.min : (m + 1); h <= high.max; h++)
+                {
+                    for (f = 0; f <= lastMotion; f++)
+                    {
+                        maConfigs[mConfigCount].kind = (appRssiFilterKind_t)k;
+                        maConfigs[mConfigCount].deltaLow = (int8_t)l;
+                        maConfigs[mConfigCount].deltaMedium = (int8_t)m;
+                        maConfigs[mConfigCount].deltaHigh = (int8_t)h;
+                        maConfigs[mConfigCount].motion = (f != 0) ? TRUE : FALSE;
+                        mConfigCount++;
+                    }
+                }
+            }
+        }
+    }
+
+    threads = (threads < 1) ? 1 : ((threads > (long)mcMaxThreads_c) ? (long)mcMaxThreads_c : threads);
+    for (started = 0U; started < (uint32_t)threads; started++)
+    {
+        err = pthread_create(&aThreads[started], NULL, Replay_Worker, NULL);
+        if (err != 0)
+        {
+            fprintf(stderr, "pthread_create: %s, %u worker threads\n", strerror(err), started);
+            break;
+        }
+    }
+    if (started == 0U)
+    {
+        /* No worker: run the configurations on this thread */
+        (void)Replay_Worker(NULL);
+    }
+    for (i = 0U; i < started; i++)
+    {
+        (void)pthread_join(aThreads[i], NULL);
+    }
+
+    printf("filter,motion,delta_low,delta_medium,delta_high,approaches,detected,missed,false_triggers,mean_delay_ms,max_delay_ms\n");
+    for (i = 0U; i < mConfigCount; i++)
+    {
+        const replayConfig_t *pConfig = &maConfigs[i];
+        uint32_t meanMs = (pConfig->detected != 0U) ? (uint32_t)(pConfig->delaySumMs / pConfig->detected) : 0U;
+
+        printf("%s,%d,%d,%d,%d,%u,%u,%u,%u,%u,%u\n", maFilterNames[pConfig->kind], pConfig->motion,
+               pConfig->deltaLow, pConfig->deltaMedium, pConfig->deltaHigh,
+               pConfig->approaches, pConfig->detected, pConfig->approaches - pConfig->detected,
+               pConfig->falseTriggers, meanMs, pConfig->delayMaxMs);
+
+        /* Safe: no false trigger, no missed approach. Then fastest on average */
+        if ((pConfig->falseTriggers == 0U) && (pConfig->detected == pConfig->approaches) &&
+            ((pBest == NULL) || ((pConfig->delaySumMs * pBest->detected) < (pBest->delaySumMs * pConfig->detected))))
+        {
+            pBest = pConfig;
+        }
+    }
+
+    if (pBest != NULL)
+    {
+        fprintf(stderr, "fastest safe: filter %s, motion %s, delta_rssi_low %d, delta_rssi_medium %d, delta_rssi_high %d\n",
+                maFilterNames[pBest->kind], (pBest->motion == TRUE) ? "on" : "off",
+                pBest->deltaLow, pBest->deltaMedium, pBest->deltaHigh);
+    }
+    else
+    {
+        fprintf(stderr, "no configuration without false trigger and missed approach\n");
+    }
+    return 0;
+}
@@ -0,0 +1,467 @@
+/*! *********************************************************************************
+* \file shell_batch_bench.c
+*
+* Host check and measurement of the binary batch commands. The client library
+* (shell_batch_client.c) talks over a socket pair to a keyfob stand-in thread
+* running the firmware receiver and dispatch of app_shell_batch.c, with
+* version, getparam and setparam handlers over the system parameter registry
+* of app_nvm.h (bounds included) in place of shell_digital_key_device.c.
+*
+* Checked first: values set in a batch read back, a value out of bounds, an
+* unknown opcode and a command cut short fail alone or stop the request as
+* documented, a full response stops, a request corrupted on the way is
+* dropped for its CRC and sent again, a request whose response is lost is
+* sent again and answered without its commands run twice.
+*
+* Then a regression step of a test rig is timed on the UART: set 10
+* parameters, read every parameter back and the version. The text shell takes
+* one exchange per command, a line sent, echoed, answered and followed by the
+* prompt; the batch commands one exchange per frame. The time of an exchange
+* is its bytes at 10 bits each (the echo overlaps the line sent) plus one
+* host turnaround, given for a USB serial adapter answering in 1 ms and for
+* the 16 ms latency timer of FTDI adapters.
+*
+* Build, from the repository root:
+*   gcc -O2 -Itools/host -I. tools/shell_batch/shell_batch_bench.c \
+*       tools/shell_batch/shell_batch_client.c app_shell_batch.c -lpthread -o shell_batch_bench
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "app_nvm.h"
+#include "app_shell_batch.h"
+#include "shell_batch_client.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mcBaud_c                    (115200U)
+#define mcBitsPerByte_c             (10U)
+#define mcStepSets_c                (10U)
+#define mcTextPrompt_c              "\r\nDevice>"
+#define mcTextVersion_c             "BMW Keyfob PoC - Device  v0.15.2\r\n"
+#define mcVersion_c                 "0.15.2"
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+typedef struct benchLink_tag
+{
+    uint32_t exchanges;
+    uint32_t sent;
+    uint32_t received;
+    uint32_t overlapped;            /* Received while sending: the echo */
+}benchLink_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static appShellBatchStatus_t Bench_Version(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult);
+static appShellBatchStatus_t Bench_GetParam(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult);
+static appShellBatchStatus_t Bench_SetParam(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult);
+static void *Bench_Keyfob(void *pParam);
+static int32_t Bench_StepValue(uint32_t id);
+static uint32_t Bench_Check(shellBatchClient_t *pClient);
+static uint32_t Bench_StepBatch(shellBatchClient_t *pClient, benchLink_t *pLink);
+static void Bench_StepText(benchLink_t *pLink);
+static void Bench_Report(const char *pName, const benchLink_t *pLink);
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static int32_t maParams[ParamMaxID];
+static int mKeyfobFd = -1;
+
+/* Requests the stand-in corrupts, responses it drops, counted down */
+static volatile uint32_t mCorruptRequest = 0U;
+static volatile uint32_t mDropResponse = 0U;
+
+/* Set commands run */
+static volatile uint32_t mSets = 0U;
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main(void)
+{
+    int aFds[2];
+    pthread_t keyfob;
+    shellBatchClient_t client;
+    benchLink_t text = {0U, 0U, 0U, 0U};
+    benchLink_t batch = {0U, 0U, 0U, 0U};
+    uint32_t failures = 0U;
+    uint32_t i;
+
+    for (i = 0U; i < (uint32_t)ParamMaxID; i++)
+    {
+        maParams[i] = SystemParamsRegistry[i].default_value;
+    }
+    App_ShellBatchRegister((uint8_t)gAppShellBatchVersion_c, Bench_Version);
+    App_ShellBatchRegister((uint8_t)gAppShellBatchGetParam_c, Bench_GetParam);
+    App_ShellBatchRegister((uint8_t)gAppShellBatchSetParam_c, Bench_SetParam);
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, aFds) != 0)
+    {
+        perror("socketpair");
+        return 1;
+    }
+    mKeyfobFd = aFds[1];
+    (void)pthread_create(&keyfob, NULL, Bench_Keyfob, NULL);
+    ShellBatch_Attach(&client, aFds[0]);
+    client.timeoutMs = 20U;
+
+    failures += Bench_Check(&client);
+    failures += Bench_StepBatch(&client, &batch);
+    Bench_StepText(&text);
+
+    printf("regression step: set %u parameters, get %u, version; %u baud\n",
+           mcStepSets_c, (unsigned)ParamMaxID, mcBaud_c);
+    Bench_Report("text shell", &text);
+    Bench_Report("batch", &batch);
+    printf("%u failures\n", failures);
+
+    ShellBatch_Close(&client);
+    (void)pthread_join(keyfob, NULL);
+    return (failures == 0U) ? 0 : 1;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+static appShellBatchStatus_t Bench_Version(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult)
+{
+    appShellBatchStatus_t status = gAppShellBatchOk_c;
+
+    (void)pArgs;
+    if (argsLength != 0U)
+    {
+        status = gAppShellBatchBadArgs_c;
+    }
+    else if ((sizeof(mcVersion_c) - 1U) > pResult->size)
+    {
+        status = gAppShellBatchNoRoom_c;
+    }
+    else
+    {
+        (void)memcpy(pResult->pValue, mcVersion_c, sizeof(mcVersion_c) - 1U);
+        pResult->type = (uint8_t)gAppShellBatchString_c;
+        pResult->length = (uint8_t)(sizeof(mcVersion_c) - 1U);
+    }
+    return status;
+}
+
+static appShellBatchStatus_t Bench_GetParam(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult)
+{
+    appShellBatchStatus_t status = gAppShellBatchOk_c;
+    uint32_t value;
+
+    if ((argsLength != 1U) || (pArgs[0] >= (uint8_t)ParamMaxID))
+    {
+        status = gAppShellBatchBadArgs_c;
+    }
+    else if (pResult->size < 4U)
+    {
+        status = gAppShellBatchNoRoom_c;
+    }
+    else
+    {
+        value = (uint32_t)maParams[pArgs[0]];
+        pResult->pValue[0] = (uint8_t)value;
+        pResult->pValue[1] = (uint8_t)(value >> 8U);
+        pResult->pValue[2] = (uint8_t)(value >> 16U);
+        pResult->pValue[3] = (uint8_t)(value >> 24U);
+        pResult->type = (uint8_t)gAppShellBatchInt32_c;
+        pResult->length = 4U;
+    }
+    return status;
+}
+
+static appShellBatchStatus_t Bench_SetParam(const uint8_t *pArgs, uint8_t argsLength, appShellBatchResult_t *pResult)
+{
+    appShellBatchStatus_t status = gAppShellBatchOk_c;
+    int32_t value;
+
+    (void)pResult;
+    mSets++;
+    if ((argsLength != 5U) || (pArgs[0] >= (uint8_t)ParamMaxID))
+    {
+        status = gAppShellBatchBadArgs_c;
+    }
+    else
+    {
+        value = (int32_t)((uint32_t)pArgs[1] | ((uint32_t)pArgs[2] << 8U) |
+                          ((uint32_t)pArgs[3] << 16U) | ((uint32_t)pArgs[4] << 24U));
+        if ((value < SystemParamsRegistry[pArgs[0]].min_value) || (value > SystemParamsRegistry[pArgs[0]].max_value))
+        {
+            status = gAppShellBatchFailed_c;
+        }
+        else
+        {
+            maParams[pArgs[0]] = value;
+        }
+    }
+    return status;
+}
+
+/* Keyfob stand-in: the firmware receiver, dispatch and response */
+static void *Bench_Keyfob(void *pParam)
+{
+    static uint8_t aRxFrame[gAppShellBatchFrameSize_c];
+    static uint8_t aTxFrame[gAppShellBatchFrameSize_c];
+    appShellBatchRx_t rx = {aRxFrame, 0U, 0U, 0U, 0U};
+    appShellBatchStats_t stats;
+    uint8_t aBytes[64];
+    ssize_t count;
+    ssize_t i;
+    uint16_t length;
+
+    (void)pParam;
+    (void)memset(&stats, 0, sizeof(stats));
+    while ((count = read(mKeyfobFd, aBytes, sizeof(aBytes))) > 0)
+    {
+        if ((mCorruptRequest != 0U) && (aBytes[0] == gAppShellBatchSync_c))
+        {
+            mCorruptRequest--;
+            aBytes[count - 1] ^= 0x01U;
+        }
+        for (i = 0; i < count; i++)
+        {
+            if (App_ShellBatchRxByte(&rx, aBytes[i]) == TRUE)
+            {
+                length = App_ShellBatchProcess(&aRxFrame[gAppShellBatchHeaderSize_c], rx.payloadLength, aTxFrame, &stats);
+                if (mDropResponse != 0U)
+                {
+                    mDropResponse--;
+                }
+                else
+                {
+                    (void)write(mKeyfobFd, aTxFrame, length);
+                }
+            }
+        }
+    }
+    return NULL;
+}
+
+/* Value the step sets: within the bounds, other than the default */
+static int32_t Bench_StepValue(uint32_t id)
+{
+    return (SystemParamsRegistry[id].default_value != SystemParamsRegistry[id].max_value) ?
+           SystemParamsRegistry[id].max_value : SystemParamsRegistry[id].min_value;
+}
+
+static uint32_t Bench_Check(shellBatchClient_t *pClient)
+{
+    static const uint8_t aCutShort[2] = {(uint8_t)gAppShellBatchGetParam_c, 4U};
+    shellBatchReply_t reply;
+    uint32_t failures = 0U;
+    uint32_t sets;
+    uint32_t i;
+    int results;
+
+    /* Out of bounds, unknown, then a good one: each its own result */
+    ShellBatch_Begin(pClient);
+    (void)ShellBatch_AddSetParam(pClient, (uint8_t)ConnectionIntervalID, 3001);
+    (void)ShellBatch_Add(pClient, 0x7FU, NULL, 0U);
+    (void)ShellBatch_AddSetParam(pClient, (uint8_t)ConnectionIntervalID, 45);
+    (void)ShellBatch_AddGetParam(pClient, (uint8_t)ConnectionIntervalID);
+    (void)ShellBatch_Add(pClient, (uint8_t)gAppShellBatchVersion_c, NULL, 0U);
+    results = ShellBatch_Run(pClient);
+    if ((results != 5) ||
+        (ShellBatch_Result(pClient, 0U, &reply) != 0) || (reply.status != (uint8_t)gAppShellBatchFailed_c) ||
+        (ShellBatch_Result(pClient, 1U, &reply) != 0) || (reply.status != (uint8_t)gAppShellBatchUnknownCommand_c) ||
+        (ShellBatch_Result(pClient, 2U, &reply) != 0) || (reply.status != (uint8_t)gAppShellBatchOk_c) ||
+        (ShellBatch_Result(pClient, 3U, &reply) != 0) || (ShellBatch_Int32(&reply) != 45) ||
+        (ShellBatch_Result(pClient, 4U, &reply) != 0) || (reply.type != (uint8_t)gAppShellBatchString_c) ||
+        (reply.length != (sizeof(mcVersion_c) - 1U)) || (memcmp(reply.pValue, mcVersion_c, reply.length) != 0))
+    {
+        printf("FAIL: typed results of a mixed request (%d results)\n", results);
+        failures++;
+    }
+
+    /* A command cut short stops the request */
+    ShellBatch_Begin(pClient);
+    (void)ShellBatch_AddGetParam(pClient, (uint8_t)ConnectionIntervalID);
+    (void)memcpy(&pClient->aRequest[gAppShellBatchHeaderSize_c + pClient->requestLength], aCutShort, sizeof(aCutShort));
+    pClient->requestLength += (uint16_t)sizeof(aCutShort);
+    results = ShellBatch_Run(pClient);
+    if ((results != 2) || (ShellBatch_Result(pClient, 1U, &reply) != 0) ||
+        (reply.status != (uint8_t)gAppShellBatchBadArgs_c))
+    {
+        printf("FAIL: command cut short (%d results)\n", results);
+        failures++;
+    }
+
+    /* As many reads as the request holds: the response fills first */
+    ShellBatch_Begin(pClient);
+    i = 0U;
+    while (ShellBatch_AddGetParam(pClient, (uint8_t)(i % (uint32_t)ParamMaxID)) == 0)
+    {
+        i++;
+    }
+    results = ShellBatch_Run(pClient);
+    if ((results <= 0) || ((uint32_t)results >= i) ||
+        (ShellBatch_Result(pClient, (uint32_t)results - 1U, &reply) != 0) ||
+        (reply.status != (uint8_t)gAppShellBatchNoRoom_c))
+    {
+        printf("FAIL: full response (%d results of %u)\n", results, i);
+        failures++;
+    }
+
+    /* Corrupted on the way: dropped, sent again */
+    mCorruptRequest = 1U;
+    ShellBatch_Begin(pClient);
+    (void)ShellBatch_AddGetParam(pClient, (uint8_t)ConnectionIntervalID);
+    results = ShellBatch_Run(pClient);
+    if ((results != 1) || (pClient->resends != 1U) ||
+        (ShellBatch_Result(pClient, 0U, &reply) != 0) || (ShellBatch_Int32(&reply) != 45))
+    {
+        printf("FAIL: corrupted request not sent again (%d results, %u resends)\n", results, pClient->resends);
+        failures++;
+    }
+
+    /* Response lost: sent again, the set answered, not run twice */
+    mDropResponse = 1U;
+    sets = mSets;
+    ShellBatch_Begin(pClient);
+    (void)ShellBatch_AddSetParam(pClient, (uint8_t)ConnectionIntervalID, 50);
+    results = ShellBatch_Run(pClient);
+    if ((results != 1) || (pClient->resends != 2U) || (mSets != (sets + 1U)) ||
+        (ShellBatch_Result(pClient, 0U, &reply) != 0) || (reply.status != (uint8_t)gAppShellBatchOk_c))
+    {
+        printf("FAIL: request sent again run %u times (%d results)\n", mSets - sets, results);
+        failures++;
+    }
+    return failures;
+}
+
+/* The step in as few frames as hold it; checks the values read back */
+static uint32_t Bench_StepBatch(shellBatchClient_t *pClient, benchLink_t *pLink)
+{
+    shellBatchReply_t reply;
+    uint32_t failures = 0U;
+    uint32_t next = 0U;         /* Commands: the sets, the gets, the version */
+    uint32_t total = mcStepSets_c + (uint32_t)ParamMaxID + 1U;
+    uint32_t first;
+    uint32_t i;
+    int results;
+    int added;
+
+    while (next < total)
+    {
+        ShellBatch_Begin(pClient);
+        first = next;
+        /* Stop adding before the response would fill: 10 bytes a command
+           covers a read result */
+        do
+        {
+            if (next < mcStepSets_c)
+            {
+                added = ShellBatch_AddSetParam(pClient, (uint8_t)next, Bench_StepValue(next));
+            }
+            else if (next < (total - 1U))
+            {
+                added = ShellBatch_AddGetParam(pClient, (uint8_t)(next - mcStepSets_c));
+            }
+            else
+            {
+                added = ShellBatch_Add(pClient, (uint8_t)gAppShellBatchVersion_c, NULL, 0U);
+            }
+            if (added == 0)
+            {
+                next++;
+            }
+        } while ((added == 0) && (next < total) &&
+                 ((1U + ((next - first + 1U) * 10U)) <= gAppShellBatchMaxPayload_c));
+
+        results = ShellBatch_Run(pClient);
+        pLink->exchanges++;
+        pLink->sent += (uint32_t)gAppShellBatchHeaderSize_c + pClient->requestLength + gAppShellBatchCrcSize_c;
+        pLink->received += (uint32_t)gAppShellBatchHeaderSize_c + pClient->responseLength + gAppShellBatchCrcSize_c;
+        if ((results < 0) || ((uint32_t)results != (next - first)))
+        {
+            printf("FAIL: step frame of %u commands, %d results\n", next - first, results);
+            failures++;
+            break;
+        }
+        for (i = first; i < next; i++)
+        {
+            if ((ShellBatch_Result(pClient, i - first, &reply) != 0) || (reply.status != (uint8_t)gAppShellBatchOk_c) ||
+                ((i >= mcStepSets_c) && (i < (total - 1U)) &&
+                 (ShellBatch_Int32(&reply) != (((i - mcStepSets_c) < mcStepSets_c) ?
+                                                Bench_StepValue(i - mcStepSets_c) : maParams[i - mcStepSets_c]))))
+            {
+                printf("FAIL: step command %u\n", i);
+                failures++;
+            }
+        }
+    }
+    return failures;
+}
+
+/* The step on the text shell: "set", "get" and "version" lines */
+static void Bench_StepText(benchLink_t *pLink)
+{
+    char aLine[96];
+    char aReply[96];
+    uint32_t i;
+    int lineLength;
+    int replyLength;
+
+    for (i = 0U; i < (mcStepSets_c + (uint32_t)ParamMaxID + 1U); i++)
+    {
+        if (i < mcStepSets_c)
+        {
+            lineLength = snprintf(aLine, sizeof(aLine), "set %s %d", SystemParamsRegistry[i].name, (int)Bench_StepValue(i));
+            replyLength = snprintf(aReply, sizeof(aReply), "Set %s to %d", SystemParamsRegistry[i].name,
+                                   (int)Bench_StepValue(i));
+        }
+        else if (i < (mcStepSets_c + (uint32_t)ParamMaxID))
+        {
+            lineLength = snprintf(aLine, sizeof(aLine), "get %s", SystemParamsRegistry[i - mcStepSets_c].name);
+            replyLength = snprintf(aReply, sizeof(aReply), "%d\r\n", (int)maParams[i - mcStepSets_c]);
+        }
+        else
+        {
+            lineLength = snprintf(aLine, sizeof(aLine), "version");
+            replyLength = (int)strlen(mcTextVersion_c);
+        }
+        pLink->exchanges++;
+        pLink->sent += (uint32_t)lineLength + 1U;
+        pLink->overlapped += (uint32_t)lineLength;
+        pLink->received += (uint32_t)lineLength + 2U + (uint32_t)replyLength + (uint32_t)strlen(mcTextPrompt_c);
+    }
+}
+
+static void Bench_Report(const char *pName, const benchLink_t *pLink)
+{
+    double wireMs = ((double)(pLink->sent + pLink->received - pLink->overlapped) * mcBitsPerByte_c * 1000.0) / mcBaud_c;
+
+    printf("%-10s: %3u exchanges, %5u bytes sent, %5u received, %7.1f ms (1 ms turnaround), %7.1f ms (16 ms)\n",
+           pName, pLink->exchanges, pLink->sent, pLink->received, wireMs + (double)pLink->exchanges,
+           wireMs + (16.0 * pLink->exchanges));
+}
@@ -0,0 +1,345 @@
+/*! *********************************************************************************
+* \file shell_batch_client.c
+*
+* Linux client of the keyfob binary batch commands, see shell_batch_client.h.
+*
+* Build with the firmware framing, from the repository root:
+*   gcc -O2 -Itools/host -I. -c tools/shell_batch/shell_batch_client.c app_shell_batch.c
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "shell_batch_client.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private functions prototypes
+*************************************************************************************
+************************************************************************************/
+static speed_t Client_Speed(uint32_t baud);
+static uint64_t Client_NowMs(void);
+static int Client_Send(shellBatchClient_t *pClient, uint16_t frameLength);
+static int Client_Receive(shellBatchClient_t *pClient);
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+/* Opens the batch UART raw, 8N1, no flow control. -1 and errno on failure. */
+int ShellBatch_Open(shellBatchClient_t *pClient, const char *pDevice, uint32_t baud)
+{
+    struct termios tio;
+    int fd = open(pDevice, O_RDWR | O_NOCTTY);
+    int result = -1;
+
+    if (fd >= 0)
+    {
+        if ((tcgetattr(fd, &tio) == 0) && (Client_Speed(baud) != B0))
+        {
+            cfmakeraw(&tio);
+            tio.c_cflag |= CLOCAL | CREAD;
+            tio.c_cflag &= ~(tcflag_t)(CSTOPB | CRTSCTS);
+            tio.c_cc[VMIN] = 0;
+            tio.c_cc[VTIME] = 0;
+            (void)cfsetispeed(&tio, Client_Speed(baud));
+            (void)cfsetospeed(&tio, Client_Speed(baud));
+            if (tcsetattr(fd, TCSANOW, &tio) == 0)
+            {
+                (void)tcflush(fd, TCIOFLUSH);
+                ShellBatch_Attach(pClient, fd);
+                result = 0;
+            }
+        }
+        else if (Client_Speed(baud) == B0)
+        {
+            errno = EINVAL;
+        }
+        else
+        {
+            ; /* errno from tcgetattr */
+        }
+        if (result != 0)
+        {
+            (void)close(fd);
+        }
+    }
+    return result;
+}
+
+/* Uses a descriptor already open: a pty, a socket to a keyfob simulator.
+   Sequence numbers start at random: the first request of a new client is
+   not taken for the last one of a previous run and answered from it. */
+void ShellBatch_Attach(shellBatchClient_t *pClient, int fd)
+{
+    (void)memset(pClient, 0, sizeof(*pClient));
+    pClient->fd = fd;
+    pClient->seq = (uint8_t)(Client_NowMs() ^ (uint64_t)getpid());
+    pClient->timeoutMs = gShellBatchTimeoutMs_c;
+    pClient->attempts = gShellBatchAttempts_c;
+    pClient->rx.pFrame = pClient->aResponse;
+}
+
+void ShellBatch_Close(shellBatchClient_t *pClient)
+{
+    if (pClient->fd >= 0)
+    {
+        (void)close(pClient->fd);
+        pClient->fd = -1;
+    }
+}
+
+/* Starts a request, with a new sequence number. */
+void ShellBatch_Begin(shellBatchClient_t *pClient)
+{
+    pClient->seq++;
+    pClient->aRequest[gAppShellBatchHeaderSize_c] = pClient->seq;
+    pClient->requestLength = 1U;
+    pClient->commands = 0U;
+    pClient->responseLength = 0U;
+}
+
+/* Adds a command to the request. -1 when the request is full: run it and
+   begin another. */
+int ShellBatch_Add(shellBatchClient_t *pClient, uint8_t opcode, const uint8_t *pArgs, uint8_t argsLength)
+{
+    uint8_t *pOut = &pClient->aRequest[gAppShellBatchHeaderSize_c + pClient->requestLength];
+    int result = -1;
+
+    if (((uint32_t)pClient->requestLength + gAppShellBatchCmdHeaderSize_c + argsLength) <= gAppShellBatchMaxPayload_c)
+    {
+        pOut[0] = opcode;
+        pOut[1] = argsLength;
+        if (argsLength != 0U)
+        {
+            (void)memcpy(&pOut[gAppShellBatchCmdHeaderSize_c], pArgs, argsLength);
+        }
+        pClient->requestLength += (uint16_t)(gAppShellBatchCmdHeaderSize_c + argsLength);
+        pClient->commands++;
+        result = 0;
+    }
+    return result;
+}
+
+int ShellBatch_AddGetParam(shellBatchClient_t *pClient, uint8_t id)
+{
+    return ShellBatch_Add(pClient, (uint8_t)gAppShellBatchGetParam_c, &id, 1U);
+}
+
+int ShellBatch_AddSetParam(shellBatchClient_t *pClient, uint8_t id, int32_t value)
+{
+    uint8_t aArgs[5];
+
+    aArgs[0] = id;
+    aArgs[1] = (uint8_t)value;
+    aArgs[2] = (uint8_t)((uint32_t)value >> 8U);
+    aArgs[3] = (uint8_t)((uint32_t)value >> 16U);
+    aArgs[4] = (uint8_t)((uint32_t)value >> 24U);
+    return ShellBatch_Add(pClient, (uint8_t)gAppShellBatchSetParam_c, aArgs, (uint8_t)sizeof(aArgs));
+}
+
+/* Sends the request and waits for its response, sending it again after a
+   timeout: with its sequence number, the keyfob answers it without running
+   its commands again. Returns the number of results, fewer than the commands when the
+   response was full, or -1: no response (errno ETIMEDOUT) or I/O error. */
+int ShellBatch_Run(shellBatchClient_t *pClient)
+{
+    uint16_t frameLength = App_ShellBatchFrame(pClient->aRequest, pClient->requestLength);
+    uint32_t attempt;
+    int results = -1;
+    int received = 0;
+    uint16_t offset;
+
+    for (attempt = 0U; (attempt < pClient->attempts) && (received == 0); attempt++)
+    {
+        if (attempt != 0U)
+        {
+            pClient->resends++;
+        }
+        if (Client_Send(pClient, frameLength) != 0)
+        {
+            received = -1;
+        }
+        else
+        {
+            received = Client_Receive(pClient);
+        }
+    }
+
+    if (received == 1)
+    {
+        /* Count the results, each checked to end within the payload */
+        results = 0;
+        offset = 1U;
+        while (((uint32_t)offset + gAppShellBatchResultHeaderSize_c) <= pClient->responseLength)
+        {
+            offset += (uint16_t)(gAppShellBatchResultHeaderSize_c +
+                                 pClient->aResponse[gAppShellBatchHeaderSize_c + offset + 3U]);
+            if (offset <= pClient->responseLength)
+            {
+                results++;
+            }
+        }
+    }
+    else if (received == 0)
+    {
+        errno = ETIMEDOUT;
+    }
+    else
+    {
+        ; /* errno from the I/O */
+    }
+    return results;
+}
+
+/* Result index of the last response. -1 past the last result. */
+int ShellBatch_Result(const shellBatchClient_t *pClient, uint32_t index, shellBatchReply_t *pReply)
+{
+    const uint8_t *pPayload = &pClient->aResponse[gAppShellBatchHeaderSize_c];
+    uint32_t offset = 1U;
+    uint32_t i = 0U;
+    int result = -1;
+
+    while (((offset + gAppShellBatchResultHeaderSize_c) <= pClient->responseLength) && (result != 0))
+    {
+        if ((offset + gAppShellBatchResultHeaderSize_c + pPayload[offset + 3U]) > pClient->responseLength)
+        {
+            break;
+        }
+        if (i == index)
+        {
+            pReply->opcode = pPayload[offset];
+            pReply->status = pPayload[offset + 1U];
+            pReply->type = pPayload[offset + 2U];
+            pReply->length = pPayload[offset + 3U];
+            pReply->pValue = &pPayload[offset + gAppShellBatchResultHeaderSize_c];
+            result = 0;
+        }
+        offset += gAppShellBatchResultHeaderSize_c + pPayload[offset + 3U];
+        i++;
+    }
+    return result;
+}
+
+/* Value of an int32 result, 0 otherwise. */
+int32_t ShellBatch_Int32(const shellBatchReply_t *pReply)
+{
+    uint32_t value = 0U;
+
+    if ((pReply->type == (uint8_t)gAppShellBatchInt32_c) && (pReply->length == 4U))
+    {
+        value = (uint32_t)pReply->pValue[0] | ((uint32_t)pReply->pValue[1] << 8U) |
+                ((uint32_t)pReply->pValue[2] << 16U) | ((uint32_t)pReply->pValue[3] << 24U);
+    }
+    return (int32_t)value;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+static speed_t Client_Speed(uint32_t baud)
+{
+    speed_t speed = B0;
+
+    switch (baud)
+    {
+        case 9600U:    speed = B9600;    break;
+        case 57600U:   speed = B57600;   break;
+        case 115200U:  speed = B115200;  break;
+        case 230400U:  speed = B230400;  break;
+        case 460800U:  speed = B460800;  break;
+        case 921600U:  speed = B921600;  break;
+        case 1000000U: speed = B1000000; break;
+        default:                         break;
+    }
+    return speed;
+}
+
+static uint64_t Client_NowMs(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000U) + ((uint64_t)ts.tv_nsec / 1000000U);
+}
+
+static int Client_Send(shellBatchClient_t *pClient, uint16_t frameLength)
+{
+    uint16_t sent = 0U;
+    ssize_t count;
+    int result = 0;
+
+    pClient->rx.received = 0U;
+    while ((sent < frameLength) && (result == 0))
+    {
+        count = write(pClient->fd, &pClient->aRequest[sent], frameLength - sent);
+        if (count > 0)
+        {
+            sent += (uint16_t)count;
+        }
+        else if ((count < 0) && (errno != EINTR) && (errno != EAGAIN))
+        {
+            result = -1;
+        }
+        else
+        {
+            ; /* Again */
+        }
+    }
+    return result;
+}
+
+/* 1: response of the request received, 0: timeout, -1: I/O error. A frame
+   of another sequence number, answering an earlier attempt, is skipped. */
+static int Client_Receive(shellBatchClient_t *pClient)
+{
+    struct pollfd pfd = {pClient->fd, POLLIN, 0};
+    uint64_t deadline = Client_NowMs() + pClient->timeoutMs;
+    uint64_t now;
+    uint8_t aBytes[64];
+    ssize_t count;
+    ssize_t i;
+    int result = 0;
+
+    while (result == 0)
+    {
+        now = Client_NowMs();
+        if (now >= deadline)
+        {
+            break;
+        }
+        if (poll(&pfd, 1, (int)(deadline - now)) > 0)
+        {
+            count = read(pClient->fd, aBytes, sizeof(aBytes));
+            if ((count < 0) && (errno != EINTR) && (errno != EAGAIN))
+            {
+                result = -1;
+            }
+            for (i = 0; (i < count) && (result == 0); i++)
+            {
+                if ((App_ShellBatchRxByte(&pClient->rx, aBytes[i]) == TRUE) &&
+                    (pClient->aResponse[gAppShellBatchHeaderSize_c] == pClient->seq))
+                {
+                    pClient->responseLength = pClient->rx.payloadLength;
+                    result = 1;
+                }
+            }
+        }
+    }
+    return result;
+}
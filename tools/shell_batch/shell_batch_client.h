@@ -0,0 +1,76 @@
+/*! *********************************************************************************
+* \file shell_batch_client.h
+*
+* Linux client of the keyfob binary batch commands (app_shell_batch.h), for
+* scripted regression runs: commands are added to a request, the request is
+* sent in one frame and its typed results read back from the response.
+*
+*   shellBatchClient_t client;
+*   shellBatchReply_t reply;
+*
+*   ShellBatch_Open(&client, "/dev/ttyUSB1", 115200U);
+*   ShellBatch_Begin(&client);
+*   ShellBatch_AddSetParam(&client, ConnectionIntervalID, 50);
+*   ShellBatch_AddGetParam(&client, ConnectionIntervalID);
+*   if ((ShellBatch_Run(&client) == 2) && (ShellBatch_Result(&client, 1U, &reply) == 0))
+*   {
+*       value = ShellBatch_Int32(&reply);
+*   }
+*
+* The framing is that of the firmware, app_shell_batch.c, built in the client.
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+#ifndef SHELL_BATCH_CLIENT_H
+#define SHELL_BATCH_CLIENT_H
+
+#include <stdint.h>
+
+#include "app_shell_batch.h"
+
+/* Response wait before the request is sent again, with its sequence number,
+   and sends of a request */
+#define gShellBatchTimeoutMs_c      (200U)
+#define gShellBatchAttempts_c       (3U)
+
+/*! \brief  Result of a command. */
+typedef struct shellBatchReply_tag
+{
+    uint8_t         opcode;
+    uint8_t         status;             /*!< appShellBatchStatus_t */
+    uint8_t         type;               /*!< appShellBatchType_t */
+    uint8_t         length;
+    const uint8_t   *pValue;            /*!< In the client response, until the next run */
+}shellBatchReply_t;
+
+/*! \brief  Connection to a keyfob. */
+typedef struct shellBatchClient_tag
+{
+    int             fd;
+    uint8_t         seq;
+    uint16_t        requestLength;      /*!< Payload */
+    uint16_t        responseLength;     /*!< Payload */
+    uint16_t        commands;           /*!< In the request */
+    uint32_t        timeoutMs;
+    uint32_t        attempts;
+    uint32_t        resends;            /*!< Requests sent again, since open */
+    appShellBatchRx_t rx;
+    uint8_t         aRequest[gAppShellBatchFrameSize_c];
+    uint8_t         aResponse[gAppShellBatchFrameSize_c];
+}shellBatchClient_t;
+
+int ShellBatch_Open(shellBatchClient_t *pClient, const char *pDevice, uint32_t baud);
+void ShellBatch_Attach(shellBatchClient_t *pClient, int fd);
+void ShellBatch_Close(shellBatchClient_t *pClient);
+
+void ShellBatch_Begin(shellBatchClient_t *pClient);
+int ShellBatch_Add(shellBatchClient_t *pClient, uint8_t opcode, const uint8_t *pArgs, uint8_t argsLength);
+int ShellBatch_AddGetParam(shellBatchClient_t *pClient, uint8_t id);
+int ShellBatch_AddSetParam(shellBatchClient_t *pClient, uint8_t id, int32_t value);
+int ShellBatch_Run(shellBatchClient_t *pClient);
+
+int ShellBatch_Result(const shellBatchClient_t *pClient, uint32_t index, shellBatchReply_t *pReply);
+int32_t ShellBatch_Int32(const shellBatchReply_t *pReply);
+
+#endif /* SHELL_BATCH_CLIENT_H */
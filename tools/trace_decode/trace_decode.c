@@ -0,0 +1,254 @@
+/*! *********************************************************************************
+* \file trace_decode.c
+*
+* Host decoder of the event trace ring dump (app_trace.c, shell "trace"). Reads
+* a console capture, keeps the lines between "trace hz .. count .." and
+* "trace end", and writes either a Chrome trace JSON timeline (chrome://tracing,
+* Perfetto) or a text timeline.
+*
+* The 32 bit cycle counter is unwrapped entry to entry, so dumps must not have
+* gaps longer than 2^31 cycles without an entry. The counter stops in low
+* power: the idle time reported by each low power exit entry is added back,
+* unless -n is given.
+*
+* Build, from the repository root:
+*   gcc -O2 -Itools/host -I. tools/trace_decode/trace_decode.c -o trace_decode
+*
+* Usage:
+*   trace_decode [-t] [-n] [capture.log] > trace.json
+*     -t  text timeline instead of JSON
+*     -n  no low power time compensation
+*
+* SPDX-License-Identifier: BSD-3-Clause
+********************************************************************************** */
+
+/************************************************************************************
+*************************************************************************************
+* Include
+*************************************************************************************
+************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "EmbeddedTypes.h"
+#include "app_trace.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mcMaxLineLength_c           256U
+#define mcCpuTrack_c                1000U
+#define mcLowPowerTrack_c           1001U
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static const char * const maTaskNames[] = {"other", "ble_task", "keyfob_task", "uwb_task"};
+
+static const char * const maEventNames[] =
+{
+    "?", "task_switch", "fsm", "queue_post", "queue_get", "uci_tx", "uci_rx",
+    "l2cap_tx", "l2cap_rx", "lowpower_enter", "lowpower_exit",
+};
+
+static bool_t mText = FALSE;
+static bool_t mCompensateSleep = TRUE;
+static bool_t mFirstEvent = TRUE;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+static const char *Decode_EventName(uint32_t event)
+{
+    return (event < (sizeof(maEventNames) / sizeof(maEventNames[0]))) ? maEventNames[event] : maEventNames[0];
+}
+
+static void Decode_TaskName(uint32_t task, char *pName, size_t size)
+{
+    if ((task & gAppTraceTaskIsr_c) != 0U)
+    {
+        (void)snprintf(pName, size, "exception %u", task & 0x7FU);
+    }
+    else if (task < (sizeof(maTaskNames) / sizeof(maTaskNames[0])))
+    {
+        (void)snprintf(pName, size, "%s", maTaskNames[task]);
+    }
+    else
+    {
+        (void)snprintf(pName, size, "task %u", task);
+    }
+}
+
+static void Decode_JsonEvent(const char *pName, const char *pPhase, double us, uint32_t tid,
+                             uint32_t arg0, uint32_t arg1)
+{
+    printf("%s\n  {\"name\":\"%s\",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":0,\"tid\":%u",
+           (mFirstEvent == TRUE) ? "" : ",", pName, pPhase, us, tid);
+    if (pPhase[0] == 'i')
+    {
+        printf(",\"s\":\"t\"");
+    }
+    printf(",\"args\":{\"arg0\":\"0x%08x\",\"arg1\":\"0x%08x\"}}", arg0, arg1);
+    mFirstEvent = FALSE;
+}
+
+static void Decode_JsonThreadName(uint32_t tid, const char *pName)
+{
+    printf("%s\n  {\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+           (mFirstEvent == TRUE) ? "" : ",", tid, pName);
+    mFirstEvent = FALSE;
+}
+
+static int Decode_Stream(FILE *pIn)
+{
+    char line[mcMaxLineLength_c];
+    char taskName[32];
+    bool_t inDump = FALSE;
+    bool_t haveFirst = FALSE;
+    bool_t cpuOpen = FALSE;
+    bool_t aTidNamed[256] = {FALSE};
+    unsigned int hz = 0U;
+    unsigned int count = 0U;
+    unsigned int cycles, task, event, arg0, arg1;
+    uint32_t prevCycles = 0U;
+    int64_t time = 0;
+    int64_t sleepCycles = 0;
+    uint32_t entries = 0U;
+    double us;
+
+    if (mText == FALSE)
+    {
+        printf("{\"traceEvents\":[");
+        Decode_JsonThreadName(mcCpuTrack_c, "cpu");
+        Decode_JsonThreadName(mcLowPowerTrack_c, "low power");
+    }
+
+    while (fgets(line, (int)sizeof(line), pIn) != NULL)
+    {
+        if (sscanf(line, "trace hz %u count %u", &hz, &count) == 2)
+        {
+            inDump = TRUE;
+            haveFirst = FALSE;
+            continue;
+        }
+        if (strncmp(line, "trace end", 9U) == 0)
+        {
+            inDump = FALSE;
+            continue;
+        }
+        if ((inDump == FALSE) || (hz == 0U) ||
+            (sscanf(line, "T %x %x %x %x %x", &cycles, &task, &event, &arg0, &arg1) != 5))
+        {
+            continue;
+        }
+
+        /* Unwrap, tolerating entries stamped slightly out of order */
+        time = (haveFirst == TRUE) ? (time + (int32_t)(cycles - prevCycles)) : 0;
+        prevCycles = cycles;
+        haveFirst = TRUE;
+        if ((event == (unsigned int)gAppTraceLowPowerExit_c) && (mCompensateSleep == TRUE))
+        {
+            sleepCycles += ((int64_t)arg0 * hz) / 1000000;
+        }
+        us = ((double)(time + sleepCycles) * 1e6) / (double)hz;
+        entries++;
+
+        Decode_TaskName(task & 0xFFU, taskName, sizeof(taskName));
+        if (mText == TRUE)
+        {
+            printf("%14.3f  %-12s %-15s %08x %08x\n", us, taskName, Decode_EventName(event), arg0, arg1);
+            continue;
+        }
+
+        if (aTidNamed[task & 0xFFU] == FALSE)
+        {
+            Decode_JsonThreadName(task & 0xFFU, taskName);
+            aTidNamed[task & 0xFFU] = TRUE;
+        }
+        switch (event)
+        {
+            case gAppTraceTaskSwitch_c:
+                if (cpuOpen == TRUE)
+                {
+                    Decode_JsonEvent("", "E", us, mcCpuTrack_c, 0U, 0U);
+                }
+                Decode_TaskName(arg0, taskName, sizeof(taskName));
+                Decode_JsonEvent(taskName, "B", us, mcCpuTrack_c, arg0, arg1);
+                cpuOpen = TRUE;
+                break;
+            case gAppTraceLowPowerEnter_c:
+                Decode_JsonEvent("low power", "B", us, mcLowPowerTrack_c, arg0, arg1);
+                break;
+            case gAppTraceLowPowerExit_c:
+                Decode_JsonEvent("low power", "E", us, mcLowPowerTrack_c, arg0, arg1);
+                break;
+            default:
+                Decode_JsonEvent(Decode_EventName(event), "i", us, task & 0xFFU, arg0, arg1);
+                break;
+        }
+    }
+
+    if (mText == FALSE)
+    {
+        if (cpuOpen == TRUE)
+        {
+            Decode_JsonEvent("", "E", ((double)(time + sleepCycles) * 1e6) / (double)((hz != 0U) ? hz : 1U),
+                             mcCpuTrack_c, 0U, 0U);
+        }
+        printf("\n],\"displayTimeUnit\":\"ns\"}\n");
+    }
+    fprintf(stderr, "%u entries\n", entries);
+    return (entries != 0U) ? 0 : 1;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main(int argc, char *argv[])
+{
+    FILE *pIn = stdin;
+    int opt;
+    int status;
+
+    while ((opt = getopt(argc, argv, "tn")) != -1)
+    {
+        switch (opt)
+        {
+            case 't':
+                mText = TRUE;
+                break;
+            case 'n':
+                mCompensateSleep = FALSE;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-t] [-n] [capture.log]\n", argv[0]);
+                return 2;
+        }
+    }
+    if (optind < argc)
+    {
+        pIn = fopen(argv[optind], "r");
+        if (pIn == NULL)
+        {
+            perror(argv[optind]);
+            return 2;
+        }
+    }
+
+    status = Decode_Stream(pIn);
+    if (pIn != stdin)
+    {
+        (void)fclose(pIn);
+    }
+    return status;
+}
@@ -45,6 +45,7 @@
 /* =============================================================================
  * External Includes
  * ========================================================================== */
+#include "app_trace.h"
 
 /* =============================================================================
  * Internal Includes
@@ -62,6 +63,10 @@
 /* =============================================================================
  * Private Function-like Macros
  * ========================================================================== */
+/* First four frame bytes, packed for the event trace */
+#define PHSCAUCI_u32_TRACE_HEADER(pu8_Frame)                   \
+	(((uint32_t)(pu8_Frame)[0u] << 24) | ((uint32_t)(pu8_Frame)[1u] << 16) | \
+	 ((uint32_t)(pu8_Frame)[2u] << 8) | (uint32_t)(pu8_Frame)[3u])
 
 /* =============================================================================
  * Private Type Definitions
@@ -98,6 +103,7 @@ static void phscaUci_RspNtfReceivedCallback(void)
 	    u32_UciResponseLength = phscaUci_GetResponse(m_u8arr_ResponseBuffer);
 
 		en_MessageType = (phscaUci_en_MessageType_t)(PHSCAUCI_u8_READ_BYTE_UCI_MESSAGE_TYPE(m_u8arr_ResponseBuffer[0u]));
+		App_TraceEvent(gAppTraceUciRx_c, PHSCAUCI_u32_TRACE_HEADER(m_u8arr_ResponseBuffer), (uint32_t)(u32_UciResponseLength - PHSCAUCI_u8_UCI_HEADER_SIZE_BYTES));
 		m_pf_RspNtfReceivedCallback(en_MessageType, m_u8arr_ResponseBuffer[0u], m_u8arr_ResponseBuffer[1u], (uint32_t)(u32_UciResponseLength - PHSCAUCI_u8_UCI_HEADER_SIZE_BYTES), m_u8arr_ResponseBuffer);
 	}
 	else
@@ -116,6 +122,7 @@ void phscaUci_SendCommand(const uint8_t u8_BytesToTransmit[], const uint32_t u32
 		m_u8arr_CommandBuffer[u32_ByteLoopIndex] = u8_BytesToTransmit[u32_ByteLoopIndex];
 	}
 
+	App_TraceEvent(gAppTraceUciTx_c, PHSCAUCI_u32_TRACE_HEADER(m_u8arr_CommandBuffer), u32_DataLengthBytes);
 	phscaUci_StartCommandTx();
 	phscaUci_Transceive((u32_DataLengthBytes + PHSCAUCI_u8_UCI_HEADER_SIZE_BYTES), m_u8arr_CommandBuffer, m_u8arr_ResponseBuffer);
 	phscaUci_StopCommandTx();
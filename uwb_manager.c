@@ -25,6 +25,7 @@
 #include "app_nvm.h"
 #include "phscaUwb.h"
 #include "sensors.h"
+#include "app_counters.h"
 
 /************************************************************************************
 *************************************************************************************
@@ -206,6 +207,7 @@ static void _uwb_on_start_ranging(void)
 {
     TRACE_DEBUG("Battery level : %d%%",SENSORS_GetBatteryLevel());
     TRACE_INFO("Start UWB Ranging.");
+    App_CounterAdd(gAppCounterRanging_c, 1U);
     phscaUwb_Init();
     s_u32uwbState = UWB_STATE_ACTIVE;
 }